@@ -1,9 +1,11 @@
 #!/bin/bash
 # Setup virtual CAN interface for development and testing
 #
-# Usage: ./scripts/setup-vcan.sh [interface_name]
+# Usage: ./scripts/setup-vcan.sh [--fd] [interface_name]
 # Default interface: vcan0
 #
+# --fd sets the CAN FD MTU (72) so 64-byte frames can be sent and received.
+#
 # Note: In dev containers, vcan0 should be created on the host first:
 #   sudo modprobe vcan
 #   sudo ip link add dev vcan0 type vcan
@@ -11,7 +13,16 @@
 
 set -e
 
-INTERFACE="${1:-vcan0}"
+INTERFACE="vcan0"
+CAN_FD=0
+CAN_FD_MTU=72
+
+for arg in "$@"; do
+    case "$arg" in
+        --fd) CAN_FD=1 ;;
+        *) INTERFACE="$arg" ;;
+    esac
+done
 
 echo "Setting up virtual CAN interface: $INTERFACE"
 
@@ -43,6 +54,17 @@ else
     sudo ip link set "$INTERFACE" up
 fi
 
+# Switch to the CAN FD MTU (only possible while the interface is down)
+if [ "$CAN_FD" -eq 1 ]; then
+    CURRENT_MTU=$(cat "/sys/class/net/$INTERFACE/mtu")
+    if [ "$CURRENT_MTU" != "$CAN_FD_MTU" ]; then
+        echo "Enabling CAN FD on $INTERFACE (MTU $CAN_FD_MTU)..."
+        sudo ip link set "$INTERFACE" down
+        sudo ip link set "$INTERFACE" mtu "$CAN_FD_MTU"
+        sudo ip link set "$INTERFACE" up
+    fi
+fi
+
 # Verify interface is up
 if ip link show "$INTERFACE" | grep -q "UP"; then
     echo "Virtual CAN interface $INTERFACE is ready"
@@ -50,6 +72,9 @@ if ip link show "$INTERFACE" | grep -q "UP"; then
     echo "Test with:"
     echo "  candump $INTERFACE"
     echo "  cansend $INTERFACE 360#0DAC01F400000000"
+    if [ "$CAN_FD" -eq 1 ]; then
+        echo "  cansend $INTERFACE 500##1$(printf '%0128d' 0)   # 64-byte FD frame with BRS"
+    fi
 else
     echo "ERROR: Failed to bring up $INTERFACE"
     exit 1
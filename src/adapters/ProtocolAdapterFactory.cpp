@@ -5,12 +5,18 @@
 
 #include "ProtocolAdapterFactory.h"
 
+#include "can/MultiCanAdapter.h"
+#include "dbc/DbcAdapter.h"
 #include "haltech/HaltechAdapter.h"
+#include "haltech/PD16Adapter.h"
+#include "obd2/Obd2Adapter.h"
+#include "simulator/SimulatorAdapter.h"
 
 #include <QDebug>
 #include <QDir>
 #include <QFile>
 #include <QFileInfo>
+#include <QJsonArray>
 #include <QJsonDocument>
 #include <QJsonParseError>
 
@@ -25,15 +31,27 @@ namespace {
 constexpr const char* CONFIG_KEY_ADAPTER = "adapter";
 constexpr const char* CONFIG_KEY_ADAPTER_CONFIG = "adapterConfig";
 constexpr const char* CONFIG_KEY_PROTOCOL_FILE = "protocolFile";
+constexpr const char* CONFIG_KEY_PD16_PROTOCOL_FILE = "pd16ProtocolFile";
+constexpr const char* CONFIG_KEY_DBC_FILE = "dbcFile";
+constexpr const char* CONFIG_KEY_DBC_FILES = "dbcFiles";
+constexpr const char* CONFIG_KEY_PD16_CHANNEL_MAPPING = "pd16ChannelMapping";
+constexpr const char* CONFIG_KEY_CHANNEL_MAPPINGS = "channelMappings";
+constexpr const char* CONFIG_KEY_PROTOCOL = "protocol";
+constexpr const char* CONFIG_KEY_REPLAY = "replay";
+constexpr const char* CONFIG_KEY_REPLAY_FILE = "file";
+constexpr const char* CONFIG_KEY_BUSES = "buses";
 
 //=============================================================================
 // Adapter Type Names
 //=============================================================================
 
 constexpr const char* ADAPTER_TYPE_HALTECH = "haltech";
-
-// Reserved for future OBD2 adapter implementation
-[[maybe_unused]] constexpr const char* ADAPTER_TYPE_OBD2 = "obd2";
+constexpr const char* ADAPTER_TYPE_DBC = "dbc";
+constexpr const char* ADAPTER_TYPE_PD16 = "pd16";
+constexpr const char* ADAPTER_TYPE_REPLAY = "replay";
+constexpr const char* ADAPTER_TYPE_SIMULATOR = "simulator";
+constexpr const char* ADAPTER_TYPE_OBD2 = "obd2";
+constexpr const char* ADAPTER_TYPE_MULTI = "multi";
 
 //=============================================================================
 // Adapter Creation Table
@@ -44,6 +62,8 @@ constexpr const char* ADAPTER_TYPE_HALTECH = "haltech";
  */
 using AdapterCreator = std::function<std::unique_ptr<IProtocolAdapter>(const QJsonObject&)>;
 
+std::unique_ptr<IProtocolAdapter> createReplayAdapter(const QJsonObject& config);
+
 /**
  * @brief Lookup table mapping adapter type names to creator functions.
  *
@@ -58,17 +78,49 @@ const QHash<QString, AdapterCreator>& getAdapterCreators() {
     static const QHash<QString, AdapterCreator> ADAPTER_CREATORS = {
         {ADAPTER_TYPE_HALTECH,
          [](const QJsonObject& config) { return std::make_unique<HaltechAdapter>(config); }},
-        // TODO: Add OBD2 adapter when needed
-        // {
-        //     ADAPTER_TYPE_OBD2,
-        //     [](const QJsonObject& config) {
-        //         return std::make_unique<OBD2Adapter>(config);
-        //     }
-        // },
+        {ADAPTER_TYPE_DBC,
+         [](const QJsonObject& config) { return std::make_unique<DbcAdapter>(config); }},
+        {ADAPTER_TYPE_PD16,
+         [](const QJsonObject& config) { return std::make_unique<PD16Adapter>(config); }},
+        {ADAPTER_TYPE_REPLAY, createReplayAdapter},
+        {ADAPTER_TYPE_SIMULATOR,
+         [](const QJsonObject& config) { return std::make_unique<SimulatorAdapter>(config); }},
+        {ADAPTER_TYPE_OBD2,
+         [](const QJsonObject& config) { return std::make_unique<Obd2Adapter>(config); }},
+        {ADAPTER_TYPE_MULTI,
+         [](const QJsonObject& config) { return std::make_unique<MultiCanAdapter>(config); }},
     };
     return ADAPTER_CREATORS;
 }
 
+/**
+ * @brief Create the adapter of a recorded session's protocol, reading the log.
+ *
+ * "protocol" names the adapter type that decodes the log (default
+ * "haltech"); the rest of the config, including "protocolFile" and the
+ * "replay" object, is passed to it unchanged. CanAdapter then reads
+ * frames from "replay.file" instead of the CAN interface.
+ *
+ * @param config Adapter configuration
+ * @return The protocol adapter, or nullptr without protocol or log file
+ */
+std::unique_ptr<IProtocolAdapter> createReplayAdapter(const QJsonObject& config) {
+    const QString protocol = config[CONFIG_KEY_PROTOCOL].toString(ADAPTER_TYPE_HALTECH);
+    const auto& creators = getAdapterCreators();
+    auto it = creators.find(protocol);
+    // The simulator generates its own frames and would ignore the log
+    if (it == creators.end() || protocol == ADAPTER_TYPE_REPLAY ||
+        protocol == ADAPTER_TYPE_SIMULATOR || protocol == ADAPTER_TYPE_MULTI) {
+        qWarning() << "ProtocolAdapterFactory: Unknown replay protocol:" << protocol;
+        return nullptr;
+    }
+    if (config[CONFIG_KEY_REPLAY].toObject()[CONFIG_KEY_REPLAY_FILE].toString().isEmpty()) {
+        qWarning() << "ProtocolAdapterFactory: Replay adapter needs replay.file";
+        return nullptr;
+    }
+    return it.value()(config);
+}
+
 /**
  * @brief Resolve a file path relative to a base directory.
  *
@@ -91,20 +143,50 @@ QString resolveFilePath(const QString& path, const QString& baseDir) {
 }
 
 /**
- * @brief Resolve protocol file path in adapter config relative to profile location.
+ * @brief Resolve protocol, DBC and replay file paths relative to the profile location.
+ *
+ * Entries of a multi-bus "buses" array are resolved the same way.
  *
  * @param adapterConfig Adapter configuration object (will be modified)
  * @param profileDir Directory containing the profile file
  */
 void resolveConfigPaths(QJsonObject& adapterConfig, const QString& profileDir) {
-    if (adapterConfig.contains(CONFIG_KEY_PROTOCOL_FILE)) {
-        QString protocolFile = adapterConfig[CONFIG_KEY_PROTOCOL_FILE].toString();
-        if (!protocolFile.isEmpty()) {
-            QString resolvedPath = resolveFilePath(protocolFile, profileDir);
-            adapterConfig[CONFIG_KEY_PROTOCOL_FILE] = resolvedPath;
-            qDebug() << "ProtocolAdapterFactory: Resolved protocol file path:"
-                     << protocolFile << "->" << resolvedPath;
+    for (const char* key :
+         {CONFIG_KEY_PROTOCOL_FILE, CONFIG_KEY_PD16_PROTOCOL_FILE, CONFIG_KEY_DBC_FILE}) {
+        QString configuredPath = adapterConfig[key].toString();
+        if (!configuredPath.isEmpty()) {
+            QString resolvedPath = resolveFilePath(configuredPath, profileDir);
+            adapterConfig[key] = resolvedPath;
+            qDebug() << "ProtocolAdapterFactory: Resolved" << key << "path:" << configuredPath
+                     << "->" << resolvedPath;
+        }
+    }
+
+    if (adapterConfig.contains(CONFIG_KEY_DBC_FILES)) {
+        QJsonArray resolvedFiles;
+        const QJsonArray dbcFiles = adapterConfig[CONFIG_KEY_DBC_FILES].toArray();
+        for (const auto& entry : dbcFiles) {
+            resolvedFiles.append(resolveFilePath(entry.toString(), profileDir));
+        }
+        adapterConfig[CONFIG_KEY_DBC_FILES] = resolvedFiles;
+    }
+
+    QJsonObject replay = adapterConfig[CONFIG_KEY_REPLAY].toObject();
+    const QString replayFile = replay[CONFIG_KEY_REPLAY_FILE].toString();
+    if (!replayFile.isEmpty()) {
+        replay[CONFIG_KEY_REPLAY_FILE] = resolveFilePath(replayFile, profileDir);
+        adapterConfig[CONFIG_KEY_REPLAY] = replay;
+    }
+
+    if (adapterConfig.contains(CONFIG_KEY_BUSES)) {
+        QJsonArray resolvedBuses;
+        const QJsonArray buses = adapterConfig[CONFIG_KEY_BUSES].toArray();
+        for (const auto& entry : buses) {
+            QJsonObject bus = entry.toObject();
+            resolveConfigPaths(bus, profileDir);
+            resolvedBuses.append(bus);
         }
+        adapterConfig[CONFIG_KEY_BUSES] = resolvedBuses;
     }
 }
 
@@ -155,6 +237,14 @@ ProtocolAdapterFactory::createFromConfig(const QJsonObject& config) {
     QString adapterType = config[CONFIG_KEY_ADAPTER].toString();
     QJsonObject adapterConfig = config[CONFIG_KEY_ADAPTER_CONFIG].toObject();
 
+    // PD16 IO names and the channel mappings (for kernel receive filters)
+    // live at the profile root
+    for (const char* key : {CONFIG_KEY_PD16_CHANNEL_MAPPING, CONFIG_KEY_CHANNEL_MAPPINGS}) {
+        if (config.contains(key) && !adapterConfig.contains(key)) {
+            adapterConfig[key] = config[key];
+        }
+    }
+
     if (adapterType.isEmpty()) {
         qWarning() << "ProtocolAdapterFactory: No adapter type specified in config";
         return nullptr;
@@ -38,7 +38,8 @@ class ProtocolAdapterFactory {
 
     /**
      * @brief Create a specific adapter type by name
-     * @param adapterType The adapter type name ("haltech", "obd2", "simulator")
+     * @param adapterType The adapter type name ("haltech", "pd16", "dbc", "replay", "obd2",
+     *                    "simulator", "multi")
      * @param config Adapter-specific configuration
      * @return The created adapter, or nullptr if type unknown
      */
@@ -0,0 +1,284 @@
+/**
+ * @file BusMonitor.cpp
+ * @brief Implementation of per-frame arrival statistics and bus-load estimation.
+ */
+
+#include "BusMonitor.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace devdash {
+
+namespace {
+
+//=============================================================================
+// Statistics Constants
+//=============================================================================
+
+constexpr double US_PER_SECOND = 1000000.0;
+constexpr double US_PER_MS = 1000.0;
+
+/// EWMA gain for mean interval and jitter (RFC 3550 uses 1/16)
+constexpr float EWMA_GAIN = 1.0F / 16.0F;
+
+/// Intervals averaged before gaps are judged against the measured mean
+constexpr quint64 MIN_INTERVALS_FOR_MEAN = 8;
+
+//=============================================================================
+// Frame Bit Counts
+//=============================================================================
+
+/// Classic frame bits besides payload and stuffing: SOF to IFS (11-bit / 29-bit ID)
+constexpr int CLASSIC_OVERHEAD_BITS_STANDARD = 47;
+constexpr int CLASSIC_OVERHEAD_BITS_EXTENDED = 67;
+
+/// Classic frame bits subject to bit stuffing besides the payload (11-bit / 29-bit ID)
+constexpr int CLASSIC_STUFFED_BITS_STANDARD = 34;
+constexpr int CLASSIC_STUFFED_BITS_EXTENDED = 54;
+
+/// At most one stuff bit per four bits (after the first five)
+constexpr int STUFF_BIT_PERIOD = 4;
+
+/// CAN FD arbitration phase, SOF to BRS (11-bit / 29-bit ID)
+constexpr int FD_ARBITRATION_BITS_STANDARD = 17;
+constexpr int FD_ARBITRATION_BITS_EXTENDED = 36;
+
+/// CAN FD ESI and DLC, sent at the data bitrate before the payload
+constexpr int FD_CONTROL_BITS = 5;
+
+/// CAN FD stuff count, CRC delimiter and CRC (CRC-17 up to 16 bytes, CRC-21 above)
+constexpr int FD_STUFF_COUNT_BITS = 4;
+constexpr int FD_CRC_DELIMITER_BITS = 1;
+constexpr int FD_CRC17_BITS = 17;
+constexpr int FD_CRC21_BITS = 21;
+constexpr int FD_CRC17_MAX_PAYLOAD = 16;
+
+/// ACK slot, ACK delimiter, EOF and IFS, back at the nominal bitrate
+constexpr int FD_TAIL_BITS = 12;
+
+constexpr int BITS_PER_BYTE = 8;
+
+int worstCaseStuffBits(int stuffedBits) {
+    return (stuffedBits - 1) / STUFF_BIT_PERIOD;
+}
+
+/**
+ * @brief Bus time of a frame in seconds, see BusMonitor::frameDuration()
+ */
+double frameBitTime(bool extended, bool flexibleDataRate, bool bitrateSwitch, int payloadBytes,
+                    int nominalBitrate, int dataBitrate) {
+    const double nominalRate = nominalBitrate > 0 ? nominalBitrate : BusMonitor::DEFAULT_BITRATE;
+    const int payloadBits = payloadBytes * BITS_PER_BYTE;
+
+    if (!flexibleDataRate) {
+        const int overhead =
+            extended ? CLASSIC_OVERHEAD_BITS_EXTENDED : CLASSIC_OVERHEAD_BITS_STANDARD;
+        const int stuffed =
+            (extended ? CLASSIC_STUFFED_BITS_EXTENDED : CLASSIC_STUFFED_BITS_STANDARD) +
+            payloadBits;
+        return (overhead + payloadBits + worstCaseStuffBits(stuffed)) / nominalRate;
+    }
+
+    const int arbitration =
+        extended ? FD_ARBITRATION_BITS_EXTENDED : FD_ARBITRATION_BITS_STANDARD;
+    const int crcBits = payloadBytes <= FD_CRC17_MAX_PAYLOAD ? FD_CRC17_BITS : FD_CRC21_BITS;
+    const int dataPhase = FD_CONTROL_BITS + payloadBits +
+                          worstCaseStuffBits(FD_CONTROL_BITS + payloadBits) +
+                          FD_STUFF_COUNT_BITS + crcBits + crcBits / STUFF_BIT_PERIOD +
+                          FD_CRC_DELIMITER_BITS;
+    const int nominalBits = arbitration + worstCaseStuffBits(arbitration) + FD_TAIL_BITS;
+
+    const double dataRate = bitrateSwitch && dataBitrate > 0 ? dataBitrate : nominalRate;
+    return nominalBits / nominalRate + dataPhase / dataRate;
+}
+
+} // anonymous namespace
+
+//=============================================================================
+// Configuration
+//=============================================================================
+
+void BusMonitor::setBitrate(int nominalBitrate, int dataBitrate) {
+    m_nominalBitrate = nominalBitrate > 0 ? nominalBitrate : DEFAULT_BITRATE;
+    m_dataBitrate = dataBitrate > 0 ? dataBitrate : 0;
+}
+
+void BusMonitor::setExpectedRate(const FrameKey& key, double hz) {
+    Tracker* entry = tracker(key, true);
+    if (entry != nullptr) {
+        entry->expectedIntervalUs = hz > 0.0 ? static_cast<float>(US_PER_SECOND / hz) : 0.0F;
+    }
+}
+
+void BusMonitor::reset() {
+    const auto resetKeepingRate = [](Tracker& entry) {
+        Tracker fresh;
+        fresh.expectedIntervalUs = entry.expectedIntervalUs;
+        entry = fresh;
+    };
+    std::for_each(m_standard.begin(), m_standard.end(), resetKeepingRate);
+    std::for_each(m_extended.begin(), m_extended.end(), resetKeepingRate);
+    m_totalFrames = 0;
+    m_windowFrames = 0;
+    m_windowGaps = 0;
+    m_windowBusSeconds = 0.0;
+}
+
+//=============================================================================
+// Recording
+//=============================================================================
+
+BusMonitor::Tracker* BusMonitor::tracker(const FrameKey& key, bool create) {
+    if (!key.extended && key.frameId < STANDARD_ID_COUNT) {
+        return &m_standard[key.frameId];
+    }
+    auto it = m_extended.find(key.frameId);
+    if (it != m_extended.end()) {
+        return &it.value();
+    }
+    if (!create || m_extended.size() >= MAX_TRACKED_EXTENDED_IDS) {
+        return nullptr;
+    }
+    return &m_extended.insert(key.frameId, Tracker{}).value();
+}
+
+void BusMonitor::recordFrame(const QCanBusFrame& frame, qint64 timestampUs) {
+    ++m_totalFrames;
+    ++m_windowFrames;
+    m_windowBusSeconds += frameDuration(frame, m_nominalBitrate, m_dataBitrate);
+
+    Tracker* entry = tracker({frame.frameId(), frame.hasExtendedFrameFormat()}, true);
+    if (entry == nullptr) {
+        return;
+    }
+
+    if (entry->count == 0) {
+        entry->firstUs = timestampUs;
+    } else {
+        recordInterval(*entry, timestampUs - entry->lastUs);
+    }
+    entry->lastUs = timestampUs;
+    ++entry->count;
+}
+
+void BusMonitor::recordInterval(Tracker& entry, qint64 intervalUs) {
+    const auto interval = static_cast<float>(std::max<qint64>(intervalUs, 0));
+    const quint64 intervals = entry.count - 1;
+
+    // Declared interval if known, else the running mean once it has settled
+    const bool hasMean = intervals >= MIN_INTERVALS_FOR_MEAN;
+    const float reference = entry.expectedIntervalUs > 0.0F ? entry.expectedIntervalUs
+                            : hasMean                       ? entry.meanIntervalUs
+                                                            : 0.0F;
+
+    if (reference > 0.0F && interval > static_cast<float>(GAP_FACTOR) * reference) {
+        ++entry.gaps;
+        ++m_windowGaps;
+        entry.longestGapUs = std::max(entry.longestGapUs, interval);
+        return;
+    }
+
+    if (intervals == 0) {
+        entry.meanIntervalUs = interval;
+    } else {
+        entry.meanIntervalUs += EWMA_GAIN * (interval - entry.meanIntervalUs);
+    }
+    if (reference > 0.0F) {
+        const float deviation = std::abs(interval - reference);
+        entry.jitterUs += EWMA_GAIN * (deviation - entry.jitterUs);
+        entry.maxJitterUs = std::max(entry.maxJitterUs, deviation);
+    }
+}
+
+//=============================================================================
+// Reporting
+//=============================================================================
+
+BusMonitor::BusStats BusMonitor::sample(qint64 windowUs) {
+    BusStats stats;
+    stats.frames = m_windowFrames;
+    stats.gaps = m_windowGaps;
+    if (windowUs > 0) {
+        const double windowSeconds = static_cast<double>(windowUs) / US_PER_SECOND;
+        stats.load = std::min(1.0, m_windowBusSeconds / windowSeconds);
+        stats.framesPerSecond = static_cast<double>(m_windowFrames) / windowSeconds;
+    }
+
+    float maxJitterUs = 0.0F;
+    for (const auto& entry : m_standard) {
+        maxJitterUs = std::max(maxJitterUs, entry.jitterUs);
+    }
+    for (const auto& entry : m_extended) {
+        maxJitterUs = std::max(maxJitterUs, entry.jitterUs);
+    }
+    stats.maxJitterMs = static_cast<double>(maxJitterUs) / US_PER_MS;
+
+    m_windowFrames = 0;
+    m_windowGaps = 0;
+    m_windowBusSeconds = 0.0;
+    return stats;
+}
+
+BusMonitor::FrameStats BusMonitor::toStats(const FrameKey& key, const Tracker& entry) {
+    FrameStats stats;
+    stats.key = key;
+    stats.count = entry.count;
+    if (entry.expectedIntervalUs > 0.0F) {
+        stats.declaredHz = US_PER_SECOND / static_cast<double>(entry.expectedIntervalUs);
+    }
+    if (entry.count >= 2 && entry.lastUs > entry.firstUs) {
+        stats.measuredHz = static_cast<double>(entry.count - 1) * US_PER_SECOND /
+                           static_cast<double>(entry.lastUs - entry.firstUs);
+    }
+    stats.jitterMs = static_cast<double>(entry.jitterUs) / US_PER_MS;
+    stats.maxJitterMs = static_cast<double>(entry.maxJitterUs) / US_PER_MS;
+    stats.gaps = entry.gaps;
+    stats.longestGapMs = static_cast<double>(entry.longestGapUs) / US_PER_MS;
+    return stats;
+}
+
+std::vector<BusMonitor::FrameStats> BusMonitor::frameStats() const {
+    std::vector<FrameStats> frames;
+    const auto isReported = [](const Tracker& entry) {
+        return entry.count > 0 || entry.expectedIntervalUs > 0.0F;
+    };
+
+    for (uint32_t frameId = 0; frameId < STANDARD_ID_COUNT; ++frameId) {
+        if (isReported(m_standard[frameId])) {
+            frames.push_back(toStats({frameId, false}, m_standard[frameId]));
+        }
+    }
+
+    std::vector<FrameStats> extended;
+    for (auto it = m_extended.cbegin(); it != m_extended.cend(); ++it) {
+        if (isReported(it.value())) {
+            extended.push_back(toStats({it.key(), true}, it.value()));
+        }
+    }
+    std::sort(extended.begin(), extended.end(), [](const FrameStats& lhs, const FrameStats& rhs) {
+        return lhs.key.frameId < rhs.key.frameId;
+    });
+    frames.insert(frames.end(), extended.begin(), extended.end());
+    return frames;
+}
+
+//=============================================================================
+// Bit Timing
+//=============================================================================
+
+double BusMonitor::frameDuration(const QCanBusFrame& frame, int nominalBitrate,
+                                 int dataBitrate) {
+    return frameBitTime(frame.hasExtendedFrameFormat(), frame.hasFlexibleDataRateFormat(),
+                        frame.hasBitrateSwitch(), static_cast<int>(frame.payload().size()),
+                        nominalBitrate, dataBitrate);
+}
+
+double BusMonitor::frameDuration(const RawCanFrame& frame, int nominalBitrate,
+                                 int dataBitrate) {
+    const int payloadBytes = frame.remote ? 0 : frame.length;
+    return frameBitTime(frame.extended, frame.flexibleDataRate, frame.bitrateSwitch,
+                        payloadBytes, nominalBitrate, dataBitrate);
+}
+
+} // namespace devdash
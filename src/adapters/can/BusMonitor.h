@@ -0,0 +1,191 @@
+/**
+ * @file BusMonitor.h
+ * @brief Per-frame-ID arrival statistics and bus-load estimate for CAN adapters.
+ */
+
+#pragma once
+
+#include "IFrameDecoder.h"
+#include "RawCanSocket.h"
+
+#include <QCanBusFrame>
+#include <QHash>
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+namespace devdash {
+
+/**
+ * @brief Per-frame-ID arrival statistics and bus-load estimate
+ *
+ * The protocol definitions declare how often each frame is broadcast
+ * ("rate_hz"). The monitor checks every received frame against that:
+ *
+ * - arrival count and measured rate per frame ID
+ * - inter-arrival jitter: EWMA (gain 1/16, as RFC 3550) and maximum of the
+ *   deviation from the declared interval, or from the running mean
+ *   interval for frames without a declared rate
+ * - gaps: an interval longer than GAP_FACTOR reference intervals is counted
+ *   as a gap (and excluded from the jitter figures)
+ * - bus load: bit time of every frame (header, payload, worst-case bit
+ *   stuffing, CAN FD data phase at the data bitrate) over the window length
+ *
+ * When the dash lags, these separate the ECU (declared rate not met, gaps),
+ * the bus (load near 100 %) and devdash itself (neither).
+ *
+ * Like FrameRouter, 11-bit IDs live in a direct-indexed array so recording
+ * a frame is one array access; 29-bit IDs use a hash.
+ *
+ * @code
+ * BusMonitor monitor;
+ * monitor.setBitrate(1000000, 0);
+ * monitor.setExpectedRate({0x360, false}, 50.0);
+ *
+ * monitor.recordFrame(frame, timestampUs);      // per frame
+ * auto bus = monitor.sample(windowUs);          // periodically
+ * @endcode
+ *
+ * @note Not thread-safe; owned and used by the adapter's receive path.
+ */
+class BusMonitor {
+  public:
+    /// Number of 11-bit CAN identifiers
+    static constexpr uint32_t STANDARD_ID_COUNT = 2048;
+
+    /// Distinct 29-bit IDs tracked individually (all still count toward the load)
+    static constexpr int MAX_TRACKED_EXTENDED_IDS = 256;
+
+    /// Interval, in reference intervals, above which an arrival counts as a gap
+    static constexpr double GAP_FACTOR = 3.0;
+
+    /// Nominal bitrate assumed for the load estimate when none is configured
+    static constexpr int DEFAULT_BITRATE = 500000;
+
+    /**
+     * @brief Arrival statistics of one frame ID
+     */
+    struct FrameStats {
+        FrameKey key;                ///< Frame identifier
+        quint64 count = 0;           ///< Frames received
+        double declaredHz = 0.0;     ///< Rate declared by the protocol (0 = unknown)
+        double measuredHz = 0.0;     ///< Mean arrival rate since the first frame
+        double jitterMs = 0.0;       ///< Smoothed deviation from the reference interval
+        double maxJitterMs = 0.0;    ///< Largest deviation outside gaps
+        quint64 gaps = 0;            ///< Intervals longer than GAP_FACTOR references
+        double longestGapMs = 0.0;   ///< Longest interval counted as a gap
+    };
+
+    /**
+     * @brief Bus-wide figures of one sampling window
+     */
+    struct BusStats {
+        double load = 0.0;            ///< Estimated bus utilisation (0.0 - 1.0)
+        double framesPerSecond = 0.0; ///< Frames received per second
+        quint64 frames = 0;           ///< Frames received in the window
+        quint64 gaps = 0;             ///< Gaps detected in the window, all IDs
+        double maxJitterMs = 0.0;     ///< Highest smoothed jitter of any frame ID
+    };
+
+    /**
+     * @brief Set the bitrates used for the load estimate
+     *
+     * @param nominalBitrate Arbitration (classic CAN) bitrate in bit/s, 0 = DEFAULT_BITRATE
+     * @param dataBitrate CAN FD data-phase bitrate in bit/s, 0 = nominal
+     */
+    void setBitrate(int nominalBitrate, int dataBitrate);
+
+    /**
+     * @brief Declare the expected broadcast rate of a frame
+     *
+     * @param key Frame identifier
+     * @param hz Declared rate; 0 or less uses the measured mean interval instead
+     */
+    void setExpectedRate(const FrameKey& key, double hz);
+
+    /**
+     * @brief Record one received frame
+     *
+     * @param frame Received frame (only ID, format, payload length and FD flags are used)
+     * @param timestampUs Arrival time in microseconds (ideally the kernel receive timestamp)
+     */
+    void recordFrame(const QCanBusFrame& frame, qint64 timestampUs);
+
+    /**
+     * @brief Close the current window and return its bus-wide figures
+     *
+     * @param windowUs Length of the window in microseconds
+     */
+    [[nodiscard]] BusStats sample(qint64 windowUs);
+
+    /**
+     * @brief Per-ID statistics for every frame received or declared, lowest ID first
+     *
+     * Declared frames that never arrived are included with a count of 0.
+     */
+    [[nodiscard]] std::vector<FrameStats> frameStats() const;
+
+    /**
+     * @brief Total frames recorded
+     */
+    [[nodiscard]] quint64 totalFrames() const { return m_totalFrames; }
+
+    /**
+     * @brief Forget all statistics (declared rates and bitrates are kept)
+     */
+    void reset();
+
+    /**
+     * @brief Estimate the bus time a frame occupies
+     *
+     * Worst-case bit stuffing, 3-bit interframe space. CAN FD frames with
+     * bit-rate switch send the data phase at dataBitrate.
+     *
+     * @return Duration in seconds
+     */
+    [[nodiscard]] static double frameDuration(const QCanBusFrame& frame, int nominalBitrate,
+                                              int dataBitrate);
+
+    /**
+     * @brief Estimate the bus time of a raw frame (remote frames carry no payload)
+     */
+    [[nodiscard]] static double frameDuration(const RawCanFrame& frame, int nominalBitrate,
+                                              int dataBitrate);
+
+  private:
+    /**
+     * @brief Arrival state of one frame ID (kept small: 2048 live in one array)
+     */
+    struct Tracker {
+        quint64 count = 0;
+        qint64 firstUs = 0;
+        qint64 lastUs = 0;
+        float expectedIntervalUs = 0.0F; ///< From the declared rate, 0 = unknown
+        float meanIntervalUs = 0.0F;     ///< EWMA of gap-free intervals
+        float jitterUs = 0.0F;
+        float maxJitterUs = 0.0F;
+        float longestGapUs = 0.0F;
+        uint32_t gaps = 0;
+    };
+
+    [[nodiscard]] Tracker* tracker(const FrameKey& key, bool create);
+    [[nodiscard]] static FrameStats toStats(const FrameKey& key, const Tracker& entry);
+    void recordInterval(Tracker& entry, qint64 intervalUs);
+
+    /// 11-bit ID → arrival state
+    std::array<Tracker, STANDARD_ID_COUNT> m_standard{};
+
+    /// 29-bit ID → arrival state
+    QHash<uint32_t, Tracker> m_extended;
+
+    int m_nominalBitrate = DEFAULT_BITRATE;
+    int m_dataBitrate = 0;
+
+    quint64 m_totalFrames = 0;
+    quint64 m_windowFrames = 0;
+    quint64 m_windowGaps = 0;
+    double m_windowBusSeconds = 0.0;
+};
+
+} // namespace devdash
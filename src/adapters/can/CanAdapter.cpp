@@ -0,0 +1,1412 @@
+/**
+ * @file CanAdapter.cpp
+ * @brief Implementation of the shared CAN bus I/O layer.
+ */
+
+#include "CanAdapter.h"
+
+#include "SlcanFrameSource.h"
+#include "VirtualCanEndpoint.h"
+
+#include "core/logging/LogCategories.h"
+#include "core/logging/LogMacros.h"
+
+#include <QDateTime>
+#include <QDebug>
+#include <QDir>
+#include <QJsonArray>
+#include <QJsonValue>
+#include <QMetaObject>
+#include <QThread>
+
+#include <linux/can/error.h>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+
+namespace devdash {
+
+namespace {
+
+//=============================================================================
+// Configuration Keys
+//=============================================================================
+
+constexpr const char* CONFIG_KEY_INTERFACE = "interface";
+constexpr const char* CONFIG_KEY_SKIP_UNCHANGED = "skipUnchangedPayloads";
+constexpr const char* CONFIG_KEY_CAN_FD = "canFd";
+constexpr const char* CONFIG_KEY_BIT_RATE_SWITCH = "bitRateSwitch";
+constexpr const char* CONFIG_KEY_BITRATE = "bitrate";
+constexpr const char* CONFIG_KEY_DATA_BITRATE = "dataBitrate";
+constexpr const char* CONFIG_KEY_RATE_LIMITS = "rateLimits";
+constexpr const char* CONFIG_KEY_RATE_LIMIT_FRAMES = "frames";
+constexpr const char* CONFIG_KEY_RATE_LIMIT_CHANNELS = "channels";
+constexpr const char* CONFIG_KEY_BUS_MONITOR = "busMonitor";
+constexpr const char* CONFIG_KEY_BACKEND = "backend";
+constexpr const char* CONFIG_KEY_CHANNEL_MAPPINGS = "channelMappings";
+constexpr const char* CONFIG_KEY_KERNEL_FILTER = "kernelFilter";
+constexpr const char* CONFIG_KEY_RECORD = "record";
+constexpr const char* CONFIG_KEY_RECORD_DIRECTORY = "directory";
+constexpr const char* CONFIG_KEY_RECORD_CANDUMP = "candump";
+constexpr const char* CONFIG_KEY_RECORD_FSYNC_INTERVAL = "fsyncIntervalMs";
+constexpr const char* CONFIG_KEY_RECORD_INDEX_INTERVAL = "indexIntervalMs";
+constexpr const char* CONFIG_KEY_SLCAN = "slcan";
+constexpr const char* CONFIG_KEY_SLCAN_BAUD_RATE = "baudRate";
+constexpr const char* CONFIG_KEY_SLCAN_LISTEN_ONLY = "listenOnly";
+constexpr const char* CONFIG_KEY_RECONNECT = "reconnect";
+constexpr const char* CONFIG_KEY_RECONNECT_INITIAL_DELAY = "initialDelayMs";
+constexpr const char* CONFIG_KEY_RECONNECT_MAX_DELAY = "maxDelayMs";
+constexpr const char* CONFIG_KEY_RECONNECT_BUS_OFF_RESTART = "busOffRestartMs";
+constexpr const char* CONFIG_KEY_REPLAY = "replay";
+constexpr const char* CONFIG_KEY_REPLAY_FILE = "file";
+constexpr const char* CONFIG_KEY_REPLAY_SPEED = "speed";
+constexpr const char* CONFIG_KEY_REPLAY_LOOP = "loop";
+constexpr const char* CONFIG_KEY_REPLAY_START = "startSeconds";
+constexpr const char* CONFIG_KEY_TRANSMIT = "transmit";
+constexpr const char* CONFIG_KEY_TRANSMIT_TOLERANCE = "toleranceMs";
+constexpr const char* CONFIG_KEY_TRANSMIT_FRAMES = "frames";
+constexpr const char* CONFIG_KEY_TRANSMIT_ID = "id";
+constexpr const char* CONFIG_KEY_TRANSMIT_EXTENDED = "extended";
+constexpr const char* CONFIG_KEY_TRANSMIT_PERIOD = "periodMs";
+constexpr const char* CONFIG_KEY_TRANSMIT_PHASE = "phaseMs";
+constexpr const char* CONFIG_KEY_TRANSMIT_DATA = "data";
+
+//=============================================================================
+// Default Values
+//=============================================================================
+
+constexpr const char* DEFAULT_CAN_INTERFACE = "vcan0";
+constexpr const char* CAN_PLUGIN_NAME = "socketcan";
+
+/// "backend" values
+constexpr const char* BACKEND_QT = "qt";
+constexpr const char* BACKEND_NATIVE = "native";
+constexpr const char* BACKEND_VIRTUAL = "virtual";
+constexpr const char* BACKEND_SLCAN = "slcan";
+
+/// "speed" value for playback as fast as possible
+constexpr const char* REPLAY_SPEED_MAX = "max";
+
+/// "transmit" frames sent later than this after their due time are deadline misses
+constexpr double DEFAULT_TRANSMIT_TOLERANCE_MS = 1.0;
+
+/// Highest 11-bit CAN identifier; larger IDs in the config are 29-bit
+constexpr uint32_t MAX_STANDARD_FRAME_ID = 0x7FF;
+
+/// Recording file name: <interface>-<start time>.ddcan
+constexpr const char* RECORD_TIME_FORMAT = "yyyyMMdd-HHmmss";
+constexpr const char* RECORD_FILE_SUFFIX = ".ddcan";
+
+//=============================================================================
+// Payload Limits
+//=============================================================================
+
+/// Largest classic CAN payload
+constexpr qsizetype CLASSIC_CAN_MAX_PAYLOAD = 8;
+
+//=============================================================================
+// Native Backend
+//=============================================================================
+
+/// Batches drained per socket notification before yielding to the event loop
+constexpr int MAX_BATCHES_PER_NOTIFICATION = 16;
+
+/// Error frames the native backend receives: bus-off and the controller restart after it
+constexpr can_err_mask_t NATIVE_ERROR_CLASSES = CAN_ERR_BUSOFF | CAN_ERR_RESTARTED;
+
+//=============================================================================
+// Reconnect
+//=============================================================================
+
+/// diagnostics() names of ReconnectSupervisor::State, in enum order
+constexpr std::array<const char*, 5> RECONNECT_STATE_NAMES = {
+    "stopped", "connecting", "connected", "backoff", "busOff"};
+
+constexpr qint64 US_PER_MS = 1000;
+constexpr double US_PER_MS_DOUBLE = 1000.0;
+
+//=============================================================================
+// Bus Monitor
+//=============================================================================
+
+/// Bus monitor window length (bus.* channels are published at this period)
+constexpr int BUS_STATS_INTERVAL_MS = 1000;
+
+constexpr qint64 US_PER_SECOND = 1000000;
+constexpr qint64 NS_PER_US = 1000;
+constexpr qint64 NS_PER_SECOND = 1000000000;
+constexpr double PERCENT = 100.0;
+
+/// Measured rate below this fraction of the declared rate is reported at stop
+constexpr double LOW_RATE_FRACTION = 0.9;
+
+//=============================================================================
+// Hot-Path Logging
+//=============================================================================
+
+/// Decoded channel values logged per second at debug level
+constexpr int CHANNEL_LOG_PER_SECOND = 20;
+
+/**
+ * @brief Copy a received QCanBusFrame into recorder form (no heap allocation)
+ */
+RawCanFrame toRawFrame(const QCanBusFrame& frame) {
+    RawCanFrame raw;
+    raw.frameId = frame.frameId();
+    raw.extended = frame.hasExtendedFrameFormat();
+    raw.remote = frame.frameType() == QCanBusFrame::RemoteRequestFrame;
+    raw.flexibleDataRate = frame.hasFlexibleDataRateFormat();
+    raw.bitrateSwitch = frame.hasBitrateSwitch();
+    const QByteArray& payload = frame.payload();
+    raw.length = static_cast<uint8_t>(
+        std::min<qsizetype>(payload.size(), RawCanFrame::MAX_PAYLOAD));
+    std::copy_n(payload.constData(), raw.length, raw.data.begin());
+    const QCanBusFrame::TimeStamp stamp = frame.timeStamp();
+    raw.timestampNs = stamp.seconds() * NS_PER_SECOND + stamp.microSeconds() * NS_PER_US;
+    return raw;
+}
+
+/**
+ * @brief Open @p socket with the receive and bus-off error filters
+ *
+ * Touches nothing of the adapter, so the reconnect worker thread runs it too.
+ */
+bool openNativeSocket(RawCanSocket& socket, const std::string& interface, bool canFd,
+                      const std::vector<can_filter>& filters) {
+    if (!socket.open(interface, canFd)) {
+        return false;
+    }
+    if (!filters.empty() && !socket.setFilters(filters)) {
+        qWarning() << "CanAdapter: Receiving all frames -"
+                   << QString::fromStdString(socket.errorString());
+    }
+    if (!socket.setErrorFilter(NATIVE_ERROR_CLASSES)) {
+        qWarning() << "CanAdapter: Bus-off not reported -"
+                   << QString::fromStdString(socket.errorString());
+    }
+    return true;
+}
+
+} // anonymous namespace
+
+//=============================================================================
+// Reconnect Worker
+//=============================================================================
+
+struct CanAdapter::OpenAttempt {
+    std::string interface;
+    bool canFd = false;
+    bool native = false;
+    std::vector<can_filter> filters;
+
+    bool opened = false;
+    std::string error;
+    std::unique_ptr<RawCanSocket> socket;  ///< Native backend: the opened socket
+
+    /**
+     * @brief Check the link and, for the native backend, open the socket
+     *
+     * Runs on the worker thread. A QCanBusDevice must live on the adapter's
+     * thread, so the Qt backend only checks that the interface is up here
+     * and creates the device in finishOpenAttempt(), on the adapter's I/O
+     * thread (see requiresIoThread()).
+     */
+    void run() {
+        const RawCanSocket::LinkState link = RawCanSocket::linkState(interface);
+        if (link != RawCanSocket::LinkState::Up) {
+            error = "CAN interface " + interface +
+                    (link == RawCanSocket::LinkState::Missing ? " not found" : " is down");
+            return;
+        }
+        if (!native) {
+            opened = true;
+            return;
+        }
+        socket = std::make_unique<RawCanSocket>();
+        opened = openNativeSocket(*socket, interface, canFd, filters);
+        if (!opened) {
+            error = socket->errorString();
+        }
+    }
+};
+
+//=============================================================================
+// Construction / Destruction
+//=============================================================================
+
+CanAdapter::CanAdapter(const QJsonObject& config, QObject* parent)
+    : IProtocolAdapter(parent),
+      m_interface(config[CONFIG_KEY_INTERFACE].toString(DEFAULT_CAN_INTERFACE)),
+      m_canFd(config[CONFIG_KEY_CAN_FD].toBool(false)),
+      m_bitRateSwitch(config[CONFIG_KEY_BIT_RATE_SWITCH].toBool(true)),
+      m_bitrate(config[CONFIG_KEY_BITRATE].toInt(0)),
+      m_dataBitrate(config[CONFIG_KEY_DATA_BITRATE].toInt(0)),
+      m_kernelFilterEnabled(config[CONFIG_KEY_KERNEL_FILTER].toBool(true)),
+      m_busMonitorEnabled(config[CONFIG_KEY_BUS_MONITOR].toBool(true)) {
+    const QJsonObject mappings = config[CONFIG_KEY_CHANNEL_MAPPINGS].toObject();
+    for (auto it = mappings.constBegin(); it != mappings.constEnd(); ++it) {
+        m_mappedChannels.insert(it.key());
+    }
+    const QString backend = config[CONFIG_KEY_BACKEND].toString(BACKEND_QT);
+    m_nativeBackend = backend == BACKEND_NATIVE;
+    const bool virtualBackend = backend == BACKEND_VIRTUAL;
+    const bool slcanBackend = backend == BACKEND_SLCAN;
+    if (!m_nativeBackend && !virtualBackend && !slcanBackend && backend != BACKEND_QT) {
+        qWarning() << "CanAdapter: Unknown backend" << backend << "- using" << BACKEND_QT;
+    }
+    if (m_dataBitrate > 0 && !m_canFd) {
+        qWarning() << "CanAdapter: dataBitrate ignored because canFd is disabled";
+        m_dataBitrate = 0;
+    }
+    m_busMonitor.setBitrate(m_bitrate, m_dataBitrate);
+
+    const QJsonObject record = config[CONFIG_KEY_RECORD].toObject();
+    m_recordDirectory = record[CONFIG_KEY_RECORD_DIRECTORY].toString();
+    if (!record.isEmpty() && m_recordDirectory.isEmpty()) {
+        qWarning() << "CanAdapter: record has no directory - recording disabled";
+    }
+    m_recordOptions.candump = record[CONFIG_KEY_RECORD_CANDUMP].toBool(false);
+    m_recordOptions.fsyncIntervalMs =
+        record[CONFIG_KEY_RECORD_FSYNC_INTERVAL].toInt(m_recordOptions.fsyncIntervalMs);
+    m_recordOptions.indexIntervalMs =
+        record[CONFIG_KEY_RECORD_INDEX_INTERVAL].toInt(m_recordOptions.indexIntervalMs);
+
+    const QJsonObject replay = config[CONFIG_KEY_REPLAY].toObject();
+    CanLogPlayer::Options replayOptions;
+    replayOptions.path = replay[CONFIG_KEY_REPLAY_FILE].toString();
+    if (!replay.isEmpty() && replayOptions.path.isEmpty()) {
+        qWarning() << "CanAdapter: replay has no file - reading" << m_interface;
+    }
+    const QJsonValue speed = replay[CONFIG_KEY_REPLAY_SPEED];
+    replayOptions.speed = speed.toString() == REPLAY_SPEED_MAX ? 0.0 : speed.toDouble(1.0);
+    if (replayOptions.speed < 0.0) {
+        qWarning() << "CanAdapter: Ignoring negative replay speed";
+        replayOptions.speed = 1.0;
+    }
+    replayOptions.loop = replay[CONFIG_KEY_REPLAY_LOOP].toBool(false);
+    replayOptions.startSeconds = replay[CONFIG_KEY_REPLAY_START].toDouble(0.0);
+    if (!replayOptions.path.isEmpty()) {
+        auto player = std::make_unique<CanLogPlayer>();
+        player->setOptions(replayOptions);
+        setFrameSource(std::move(player));
+        if (!m_recordDirectory.isEmpty()) {
+            qWarning() << "CanAdapter: Recording disabled while replaying";
+            m_recordDirectory.clear();
+        }
+    } else if (virtualBackend) {
+        auto bus = VirtualCanBus::get(m_interface.toStdString());
+        if (m_bitrate > 0) {
+            bus->setBitrate(m_bitrate, m_dataBitrate);
+        }
+        setFrameSource(std::make_unique<VirtualCanEndpoint>(std::move(bus)));
+    } else if (slcanBackend) {
+        const QJsonObject slcan = config[CONFIG_KEY_SLCAN].toObject();
+        SlcanFrameSource::Options slcanOptions;
+        slcanOptions.device = m_interface;
+        slcanOptions.bitrate = m_bitrate;
+        slcanOptions.baudRate = slcan[CONFIG_KEY_SLCAN_BAUD_RATE].toInt(slcanOptions.baudRate);
+        slcanOptions.listenOnly = slcan[CONFIG_KEY_SLCAN_LISTEN_ONLY].toBool(false);
+        setFrameSource(std::make_unique<SlcanFrameSource>(slcanOptions));
+    }
+
+    m_router.setPayloadCacheEnabled(config[CONFIG_KEY_SKIP_UNCHANGED].toBool(true));
+    loadRateLimits(config);
+    loadReconnectOptions(config[CONFIG_KEY_RECONNECT]);
+
+    // Parented so they follow the adapter when it is moved to an I/O thread
+    m_transmitter.setParent(this);
+    m_rateLimitTimer.setParent(this);
+    m_busStatsTimer.setParent(this);
+    m_reconnectTimer.setParent(this);
+    m_rateLimitTimer.setTimerType(Qt::PreciseTimer);
+    m_reconnectTimer.setSingleShot(true);
+    connect(&m_rateLimitTimer, &QTimer::timeout, this, &CanAdapter::onRateLimitTimeout);
+    connect(&m_busStatsTimer, &QTimer::timeout, this, &CanAdapter::onBusStatsTimeout);
+    connect(&m_reconnectTimer, &QTimer::timeout, this, &CanAdapter::onReconnectTimeout);
+
+    m_transmitter.setWriter(
+        [this](std::span<const RawCanFrame> frames) { return writePeriodicFrames(frames); });
+    loadTransmitFrames(config[CONFIG_KEY_TRANSMIT]);
+}
+
+CanAdapter::~CanAdapter() {
+    stop();
+}
+
+//=============================================================================
+// IProtocolAdapter Interface
+//=============================================================================
+
+bool CanAdapter::start() {
+    if (m_running) {
+        return true;
+    }
+
+    if (m_router.isEmpty()) {
+        qWarning() << "CanAdapter: Starting without protocol definition loaded";
+    }
+
+    m_clock.start();
+    bool opened = false;
+    if (m_frameSource) {
+        m_receiveFilters.clear();  // Sources deliver every frame they produce
+        opened = openFrameSource();
+    } else if (m_reconnectEnabled) {
+        // Opened on the worker thread; a missing interface is retried, not an error
+        buildReceiveFilters();
+        m_supervisor.start(supervisorNowUs());
+        startOpenAttempt();
+        opened = true;
+    } else {
+        buildReceiveFilters();
+        opened = m_nativeBackend ? openRawSocket() : openCanDevice();
+    }
+    if (!opened) {
+        return false;
+    }
+
+    // Re-emit every channel once after (re)connecting
+    m_router.invalidatePayloadCache();
+
+    applyFrameRateLimits();
+    if (m_router.hasRateLimits() || !m_channelLimiter.isEmpty()) {
+        const qint64 frameInterval = m_router.shortestRateLimitIntervalMs();
+        const qint64 channelInterval = m_channelLimiter.shortestIntervalMs();
+        const qint64 interval = frameInterval == 0   ? channelInterval
+                                : channelInterval == 0 ? frameInterval
+                                                       : std::min(frameInterval, channelInterval);
+        m_rateLimitTimer.start(static_cast<int>(interval));
+    }
+    if (m_busMonitorEnabled) {
+        startBusMonitor();
+    }
+    if (!m_recordDirectory.isEmpty()) {
+        startRecording();
+    }
+
+    m_running = true;
+    // Replayed logs and listen-only dongles take no frames
+    const bool canTransmit = !m_frameSource || m_frameSource->isWritable();
+    if (canTransmit && !m_transmitter.start()) {
+        qWarning() << "CanAdapter: Periodic transmit disabled -" << m_transmitter.errorString();
+    }
+    if (m_frameSource) {
+        qInfo() << "CanAdapter: Reading" << m_frameSource->sourceName() << "source"
+                << m_frameSource->description();
+        m_frameSource->start();
+        emit connectionStateChanged(true);
+        return true;
+    }
+    qInfo() << "CanAdapter: Started on interface" << m_interface << (m_canFd ? "(CAN FD)" : "")
+            << (m_nativeBackend ? "(native backend)" : "");
+    if (m_nativeBackend && !m_reconnectEnabled) {
+        emit connectionStateChanged(true);
+    }
+    return true;
+}
+
+void CanAdapter::stop() {
+    if (!m_running) {
+        return;
+    }
+
+    m_transmitter.stop();
+    m_reconnectTimer.stop();
+    joinOpenThread();
+    ++m_openGeneration;
+    if (m_supervisor.stats().recoveries > 0) {
+        const ReconnectSupervisor::Stats& stats = m_supervisor.stats();
+        qInfo() << "CanAdapter: Recovered from" << stats.recoveries << "outages, longest"
+                << static_cast<double>(stats.maxRecoveryUs) / US_PER_MS_DOUBLE << "ms";
+    }
+    m_supervisor.stop();
+    closeInterface(false);
+    if (m_frameSource) {
+        m_frameSource->stop();
+        qInfo() << "CanAdapter:" << m_frameSource->sourceName() << "source delivered"
+                << m_frameSource->framesDelivered() << "frames";
+    }
+    m_rateLimitTimer.stop();
+    m_busStatsTimer.stop();
+    stopRecording();
+
+    m_running = false;
+    if (m_router.unclaimedFrameCount() > 0) {
+        qInfo() << "CanAdapter: Ignored" << m_router.unclaimedFrameCount()
+                << "frames from" << m_router.unclaimedFrames().size() << "unclaimed IDs";
+    }
+    logPayloadCacheStats();
+    logRateLimitStats();
+    logBusMonitorStats();
+    logTransmitStats();
+    qInfo() << "CanAdapter: Stopped";
+    emit connectionStateChanged(false);
+}
+
+bool CanAdapter::isRunning() const {
+    return m_running;
+}
+
+bool CanAdapter::requiresIoThread() const {
+    // The native backend opens its socket on the reconnect worker thread
+    return m_reconnectEnabled && !m_frameSource && !m_nativeBackend;
+}
+
+std::optional<ChannelValue> CanAdapter::getChannel(const QString& channelName) const {
+    std::optional<ChannelValue> value;
+    runOnAdapterThread([this, &channelName, &value]() {
+        auto it = m_channels.constFind(channelName);
+        if (it != m_channels.constEnd()) {
+            value = it.value();
+        }
+    });
+    return value;
+}
+
+QStringList CanAdapter::availableChannels() const {
+    QStringList channels;
+    runOnAdapterThread([this, &channels]() { channels = m_channels.keys(); });
+    return channels;
+}
+
+void CanAdapter::runOnAdapterThread(const std::function<void()>& function) const {
+    // m_channels is written by publishChannels() on the adapter's thread; a
+    // thread that is not running cannot be writing it (or run the call)
+    QThread* adapterThread = thread();
+    if (adapterThread == QThread::currentThread() || !adapterThread->isRunning()) {
+        function();
+        return;
+    }
+    // invokeMethod() needs a mutable context object; function only reads
+    QMetaObject::invokeMethod(const_cast<CanAdapter*>(this), function,
+                              Qt::BlockingQueuedConnection);
+}
+
+QJsonObject CanAdapter::diagnostics() const {
+    QJsonObject result;
+    if (m_transmitter.schedule().size() > 0) {
+        result["transmit"] = m_transmitter.diagnostics();
+    }
+
+    QJsonArray payloadCache;
+    for (const auto& stats : m_router.payloadCacheStats()) {
+        QJsonObject entry;
+        entry["id"] = QStringLiteral("0x%1").arg(stats.key.frameId, 0, 16);
+        entry["extended"] = stats.key.extended;
+        entry["hits"] = static_cast<qint64>(stats.hits);
+        entry["misses"] = static_cast<qint64>(stats.misses);
+        entry["hitRate"] = stats.hitRate();
+        payloadCache.append(entry);
+    }
+    if (!payloadCache.isEmpty()) {
+        result["payloadCache"] = payloadCache;
+    }
+    if (!m_busMonitorEnabled) {
+        return result;
+    }
+
+    QJsonObject bus;
+    bus["interface"] = m_interface;
+    bus["backend"] = m_frameSource      ? m_frameSource->sourceName()
+                     : m_nativeBackend ? QString::fromLatin1(BACKEND_NATIVE)
+                                       : QString::fromLatin1(BACKEND_QT);
+    bus["load"] = m_lastBusStats.load;
+    bus["framesPerSecond"] = m_lastBusStats.framesPerSecond;
+    bus["gaps"] = static_cast<qint64>(m_lastBusStats.gaps);
+    bus["maxJitterMs"] = m_lastBusStats.maxJitterMs;
+    bus["totalFrames"] = static_cast<qint64>(m_busMonitor.totalFrames());
+    bus["unclaimedFrames"] = static_cast<qint64>(m_router.unclaimedFrameCount());
+    bus["receiveFilters"] = static_cast<qint64>(m_receiveFilters.size());
+    if (m_rawSocket) {
+        bus["kernelDrops"] = static_cast<qint64>(m_rawSocket->kernelDrops());
+    }
+    if (m_recorder && m_recorder->isRecording()) {
+        QJsonObject recording;
+        recording["path"] = QString::fromStdString(m_recorder->path());
+        recording["frames"] = static_cast<qint64>(m_recorder->recordedFrames());
+        recording["dropped"] = static_cast<qint64>(m_recorder->droppedFrames());
+        recording["lost"] = static_cast<qint64>(m_recorder->lostFrames());
+        recording["bytes"] = static_cast<qint64>(m_recorder->bytesWritten());
+        recording["writeError"] = m_recorder->hasWriteError();
+        bus["recording"] = recording;
+    }
+    if (m_frameSource) {
+        bus[m_frameSource->sourceName()] = m_frameSource->diagnostics();
+    }
+
+    QJsonArray frames;
+    for (const auto& stats : m_busMonitor.frameStats()) {
+        QJsonObject frame;
+        frame["id"] = QStringLiteral("0x%1").arg(stats.key.frameId, 0, 16);
+        frame["extended"] = stats.key.extended;
+        frame["count"] = static_cast<qint64>(stats.count);
+        frame["declaredHz"] = stats.declaredHz;
+        frame["measuredHz"] = stats.measuredHz;
+        frame["jitterMs"] = stats.jitterMs;
+        frame["maxJitterMs"] = stats.maxJitterMs;
+        frame["gaps"] = static_cast<qint64>(stats.gaps);
+        frame["longestGapMs"] = stats.longestGapMs;
+        frames.append(frame);
+    }
+
+    result["bus"] = bus;
+    result["frames"] = frames;
+    if (m_supervisor.state() != ReconnectSupervisor::State::Stopped) {
+        result["reconnect"] = reconnectDiagnostics();
+    }
+    return result;
+}
+
+bool CanAdapter::writeFrame(QCanBusFrame frame) {
+    const bool writableSource = m_frameSource && m_frameSource->isWritable();
+    const bool rawSocketOpen = m_rawSocket && m_rawSocket->isOpen();
+    if (!m_running || (!m_canDevice && !rawSocketOpen && !writableSource)) {
+        return false;  // Also while a lost interface is being reopened
+    }
+
+    RawCanFrame raw;
+    if (!prepareTransmitFrame(frame, raw)) {
+        return false;
+    }
+
+    if (rawSocketOpen || writableSource) {
+        const bool sent =
+            writableSource ? m_frameSource->writeFrame(raw) : m_rawSocket->write(raw);
+        if (!sent) {
+            qWarning() << "CanAdapter: Failed to send frame" << Qt::hex << frame.frameId();
+            return false;
+        }
+        return true;
+    }
+
+    if (!m_canDevice->writeFrame(frame)) {
+        qWarning() << "CanAdapter: Failed to send frame" << Qt::hex << frame.frameId() << "-"
+                   << m_canDevice->errorString();
+        return false;
+    }
+    return true;
+}
+
+int CanAdapter::addPeriodicFrame(const QCanBusFrame& frame, double periodMs, double phaseMs) {
+    QCanBusFrame transmitted = frame;
+    RawCanFrame raw;
+    if (!prepareTransmitFrame(transmitted, raw)) {
+        return -1;
+    }
+    const int64_t phaseUs = phaseMs < 0.0 ? TransmitSchedule::AUTO_PHASE
+                                          : std::llround(phaseMs * US_PER_MS_DOUBLE);
+    const int id = m_transmitter.add(raw, std::llround(periodMs * US_PER_MS_DOUBLE), phaseUs);
+    if (id < 0) {
+        qWarning() << "CanAdapter: Cannot send frame" << Qt::hex << frame.frameId() << Qt::dec
+                   << "every" << periodMs << "ms";
+    }
+    return id;
+}
+
+bool CanAdapter::setPeriodicPayload(int id, const QByteArray& payload) {
+    return m_transmitter.setPayload(
+        id, std::span(reinterpret_cast<const uint8_t*>(payload.constData()),
+                      static_cast<size_t>(payload.size())));
+}
+
+bool CanAdapter::removePeriodicFrame(int id) {
+    return m_transmitter.remove(id);
+}
+
+bool CanAdapter::prepareTransmitFrame(QCanBusFrame& frame, RawCanFrame& raw) const {
+    if (frame.payload().size() > CLASSIC_CAN_MAX_PAYLOAD) {
+        if (!m_canFd) {
+            qWarning() << "CanAdapter: Cannot send" << frame.payload().size()
+                       << "byte payload with CAN FD disabled";
+            return false;
+        }
+        frame.setFlexibleDataRateFormat(true);
+    }
+    if (frame.hasFlexibleDataRateFormat()) {
+        frame.setBitrateSwitch(m_bitRateSwitch);
+    }
+    if (frame.payload().size() > RawCanFrame::MAX_PAYLOAD) {
+        qWarning() << "CanAdapter: Cannot send" << frame.payload().size() << "byte payload";
+        return false;
+    }
+    raw = toRawFrame(frame);
+    return true;
+}
+
+size_t CanAdapter::writePeriodicFrames(std::span<const RawCanFrame> frames) {
+    if (!m_running) {
+        return 0;
+    }
+    if (m_rawSocket && m_rawSocket->isOpen()) {
+        return m_rawSocket->writeBatch(frames);
+    }
+
+    size_t sent = 0;
+    if (m_frameSource && m_frameSource->isWritable()) {
+        while (sent < frames.size() && m_frameSource->writeFrame(frames[sent])) {
+            ++sent;
+        }
+    } else if (m_canDevice) {
+        // The Qt backend has no batch write: one QCanBusFrame per frame
+        for (; sent < frames.size(); ++sent) {
+            const RawCanFrame& raw = frames[sent];
+            QCanBusFrame frame(raw.frameId,
+                               QByteArray(reinterpret_cast<const char*>(raw.data.data()),
+                                          raw.length));
+            frame.setExtendedFrameFormat(raw.extended);
+            frame.setFlexibleDataRateFormat(raw.flexibleDataRate);
+            frame.setBitrateSwitch(raw.bitrateSwitch);
+            if (raw.remote) {
+                frame.setFrameType(QCanBusFrame::RemoteRequestFrame);
+            }
+            if (!m_canDevice->writeFrame(frame)) {
+                break;
+            }
+        }
+    }
+    return sent;  // 0 while a lost interface is being reopened
+}
+
+bool CanAdapter::isReplaying() const {
+    return qobject_cast<const CanLogPlayer*>(m_frameSource.get()) != nullptr;
+}
+
+bool CanAdapter::seekReplay(double seconds) {
+    auto* player = qobject_cast<CanLogPlayer*>(m_frameSource.get());
+    if (!m_running || player == nullptr) {
+        return false;
+    }
+    player->seek(seconds);
+    // Re-emit every channel once after the jump
+    m_router.invalidatePayloadCache();
+    return true;
+}
+
+void CanAdapter::setFrameSource(std::unique_ptr<ICanFrameSource> source) {
+    stop();
+    m_frameSource = std::move(source);
+    if (m_frameSource) {
+        // Parented so it follows the adapter when it is moved to an I/O thread
+        m_frameSource->setParent(this);
+        m_frameSource->setFrameHandler(
+            [this](const RawCanFrame& raw) { processSourceFrame(raw); });
+    }
+}
+
+void CanAdapter::publishDecoded(const std::vector<std::pair<QString, ChannelValue>>& decoded) {
+    const qint64 now = m_channelLimiter.isEmpty() ? FrameRouter::CLOCK_NOW : m_clock.elapsed();
+    publishChannels(decoded, now);
+}
+
+//=============================================================================
+// Private Slots
+//=============================================================================
+
+void CanAdapter::onFramesReceived() {
+    while (m_canDevice->framesAvailable() > 0) {
+        const QCanBusFrame receivedFrame = m_canDevice->readFrame();
+        if (!receivedFrame.isValid()) {
+            continue;
+        }
+        if (receivedFrame.frameType() == QCanBusFrame::ErrorFrame) {
+            const QCanBusFrame::FrameErrors errors = receivedFrame.error();
+            handleErrorFrame(errors.testFlag(QCanBusFrame::BusOffError),
+                             errors.testFlag(QCanBusFrame::ControllerRestartError));
+            if (!m_canDevice) {
+                return;  // Closed by the error
+            }
+            continue;
+        }
+        if (m_recorder) {
+            m_recorder->record(toRawFrame(receivedFrame));
+        }
+        processFrame(receivedFrame);
+    }
+}
+
+void CanAdapter::onRawSocketReadable() {
+    // Bounded so a flooded bus cannot starve timers and the UI thread
+    for (int i = 0; i < MAX_BATCHES_PER_NOTIFICATION; ++i) {
+        const std::span<const RawCanFrame> batch = m_rawSocket->readBatch();
+        if (batch.empty()) {
+            break;
+        }
+        for (const RawCanFrame& raw : batch) {
+            processRawFrame(raw);
+        }
+    }
+
+    if (m_rawSocket->hasError()) {
+        // Interface down or gone (ENETDOWN, ENODEV)
+        handleInterfaceLost(QString::fromStdString(m_rawSocket->errorString()));
+    }
+}
+
+void CanAdapter::onErrorOccurred(QCanBusDevice::CanBusError error) {
+    if (error == QCanBusDevice::NoError || !m_canDevice) {
+        return;
+    }
+    const QString message = m_canDevice->errorString();
+    if (error == QCanBusDevice::ReadError || error == QCanBusDevice::ConnectionError) {
+        handleInterfaceLost(message);
+        return;
+    }
+    qWarning() << "CanAdapter: CAN bus error:" << message;
+    emit errorOccurred(message);
+}
+
+void CanAdapter::onStateChanged(QCanBusDevice::CanBusDeviceState state) {
+    if (state == QCanBusDevice::UnconnectedState && m_supervisor.isConnected()) {
+        handleInterfaceLost(QStringLiteral("CAN device disconnected"));
+        return;
+    }
+
+    bool connected = (state == QCanBusDevice::ConnectedState);
+    emit connectionStateChanged(connected);
+
+    if (connected) {
+        qDebug() << "CanAdapter: CAN device connected";
+    } else {
+        qDebug() << "CanAdapter: CAN device disconnected";
+    }
+}
+
+void CanAdapter::onRateLimitTimeout() {
+    const qint64 now = m_clock.elapsed();
+    publishChannels(m_router.flushPending(now), now);
+
+    for (const auto& [channelName, value] : m_channelLimiter.takeDue(now)) {
+        emit channelUpdated(channelName, value);
+    }
+}
+
+void CanAdapter::onBusStatsTimeout() {
+    m_lastBusStats = m_busMonitor.sample(m_busWindow.nsecsElapsed() / NS_PER_US);
+    m_busWindow.restart();
+
+    publishChannels(
+        {
+            {CHANNEL_BUS_LOAD, ChannelValue{m_lastBusStats.load * PERCENT, "%", true}},
+            {CHANNEL_BUS_FRAME_RATE, ChannelValue{m_lastBusStats.framesPerSecond, "Hz", true}},
+            {CHANNEL_BUS_GAPS, ChannelValue{static_cast<double>(m_lastBusStats.gaps), "", true}},
+            {CHANNEL_BUS_JITTER, ChannelValue{m_lastBusStats.maxJitterMs, "ms", true}},
+        },
+        m_clock.elapsed());
+}
+
+void CanAdapter::onReconnectTimeout() {
+    if (m_supervisor.state() == ReconnectSupervisor::State::BusOff) {
+        qWarning() << "CanAdapter: Controller on" << m_interface << "still bus-off - reopening";
+        closeInterface(false);
+    }
+    if (m_supervisor.beginAttempt(supervisorNowUs())) {
+        startOpenAttempt();
+        return;
+    }
+    scheduleReconnect();  // Timer fired early
+}
+
+//=============================================================================
+// Private Methods
+//=============================================================================
+
+bool CanAdapter::openCanDevice() {
+    QString errorString;
+    m_canDevice.reset(
+        QCanBus::instance()->createDevice(CAN_PLUGIN_NAME, m_interface, &errorString));
+
+    if (!m_canDevice) {
+        qCritical() << "CanAdapter: Failed to create CAN device:" << errorString;
+        emit errorOccurred(errorString);
+        return false;
+    }
+
+    connect(m_canDevice.get(), &QCanBusDevice::framesReceived, this,
+            &CanAdapter::onFramesReceived);
+    connect(m_canDevice.get(), &QCanBusDevice::errorOccurred, this, &CanAdapter::onErrorOccurred);
+    connect(m_canDevice.get(), &QCanBusDevice::stateChanged, this, &CanAdapter::onStateChanged);
+    configureDevice();
+
+    if (!m_canDevice->connectDevice()) {
+        qCritical() << "CanAdapter: Failed to connect CAN device:" << m_canDevice->errorString();
+        emit errorOccurred(m_canDevice->errorString());
+        m_canDevice.reset();
+        return false;
+    }
+    return true;
+}
+
+bool CanAdapter::openRawSocket() {
+    if (!m_rawSocket) {
+        m_rawSocket = std::make_unique<RawCanSocket>();
+    }
+    if (!openNativeSocket(*m_rawSocket, m_interface.toStdString(), m_canFd,
+                          nativeReceiveFilters())) {
+        const QString error = QString::fromStdString(m_rawSocket->errorString());
+        qCritical() << "CanAdapter: Failed to open CAN socket:" << error;
+        emit errorOccurred(error);
+        return false;
+    }
+    attachRawSocket();
+    return true;
+}
+
+void CanAdapter::attachRawSocket() {
+    if (m_bitrate > 0 || m_dataBitrate > 0) {
+        qWarning() << "CanAdapter: The native backend does not set bitrates;"
+                   << "configure" << m_interface << "with ip link";
+    }
+    if (m_rawSocket->timestampSource() == RawCanSocket::TimestampSource::None) {
+        qWarning() << "CanAdapter: No kernel receive timestamps on" << m_interface;
+    }
+
+    m_rawNotifier = std::make_unique<QSocketNotifier>(m_rawSocket->fd(), QSocketNotifier::Read);
+    connect(m_rawNotifier.get(), &QSocketNotifier::activated, this,
+            &CanAdapter::onRawSocketReadable);
+}
+
+void CanAdapter::closeInterface(bool deferDelete) {
+    // Deferred when called from one of the device's or notifier's own signals
+    if (m_canDevice) {
+        m_canDevice->disconnect(this);
+        m_canDevice->disconnectDevice();
+        if (deferDelete) {
+            m_canDevice.release()->deleteLater();
+        } else {
+            m_canDevice.reset();
+        }
+    }
+    if (m_rawNotifier) {
+        m_rawNotifier->setEnabled(false);
+        if (deferDelete) {
+            m_rawNotifier.release()->deleteLater();
+        } else {
+            m_rawNotifier.reset();
+        }
+    }
+    if (m_rawSocket && m_rawSocket->isOpen()) {
+        if (m_rawSocket->kernelDrops() > 0) {
+            qWarning() << "CanAdapter: Kernel dropped" << m_rawSocket->kernelDrops()
+                       << "frames (receive queue full)";
+        }
+        m_rawSocket->close();
+    }
+}
+
+void CanAdapter::loadReconnectOptions(const QJsonValue& config) {
+    if (config.isBool()) {
+        m_reconnectEnabled = config.toBool();
+        return;
+    }
+    const QJsonObject reconnect = config.toObject();
+    const auto delayUs = [&reconnect](const char* key, int64_t defaultUs) -> int64_t {
+        return reconnect[key].toInteger(defaultUs / US_PER_MS) * US_PER_MS;
+    };
+    ReconnectSupervisor::Options options;
+    options.initialDelayUs = delayUs(CONFIG_KEY_RECONNECT_INITIAL_DELAY, options.initialDelayUs);
+    options.maxDelayUs = delayUs(CONFIG_KEY_RECONNECT_MAX_DELAY, options.maxDelayUs);
+    options.busOffRestartUs =
+        delayUs(CONFIG_KEY_RECONNECT_BUS_OFF_RESTART, options.busOffRestartUs);
+    m_supervisor.setOptions(options);
+}
+
+void CanAdapter::startOpenAttempt() {
+    joinOpenThread();
+    auto attempt = std::make_shared<OpenAttempt>();
+    attempt->interface = m_interface.toStdString();
+    attempt->canFd = m_canFd;
+    attempt->native = m_nativeBackend;
+    if (m_nativeBackend) {
+        attempt->filters = nativeReceiveFilters();
+    }
+
+    // Opening can block on a misbehaving driver; the event loop keeps rendering
+    const uint64_t generation = m_openGeneration;
+    m_openThread = std::thread([this, attempt, generation]() {
+        attempt->run();
+        QMetaObject::invokeMethod(
+            this, [this, attempt, generation]() { finishOpenAttempt(*attempt, generation); },
+            Qt::QueuedConnection);
+    });
+}
+
+void CanAdapter::finishOpenAttempt(OpenAttempt& attempt, uint64_t generation) {
+    if (generation != m_openGeneration ||
+        m_supervisor.state() != ReconnectSupervisor::State::Connecting) {
+        return;  // Stopped meanwhile
+    }
+
+    bool opened = attempt.opened;
+    if (opened && attempt.native) {
+        m_rawSocket = std::move(attempt.socket);
+        attachRawSocket();
+    } else if (opened) {
+        opened = openCanDevice();
+    }
+
+    const int64_t now = supervisorNowUs();
+    if (!opened) {
+        m_supervisor.onAttemptFailed(now);
+        const QString error = QString::fromStdString(attempt.error);
+        if (m_supervisor.attemptsSinceConnected() == 1 && !error.isEmpty()) {
+            qWarning() << "CanAdapter:" << error << "- retrying";
+            emit errorOccurred(error);
+        } else if (!error.isEmpty()) {
+            qDebug() << "CanAdapter:" << error << "- retry in"
+                     << (m_supervisor.nextAttemptUs() - now) / US_PER_MS << "ms";
+        }
+        scheduleReconnect();
+        return;
+    }
+
+    const int attempts = m_supervisor.attemptsSinceConnected();
+    reportRecovery(m_supervisor.onConnected(now));
+    // Re-emit every channel once after (re)connecting
+    m_router.invalidatePayloadCache();
+    qInfo() << "CanAdapter: Connected to" << m_interface << "(attempt" << attempts << ")";
+    if (attempt.native) {
+        emit connectionStateChanged(true);  // The Qt backend reports it from onStateChanged()
+    }
+}
+
+void CanAdapter::joinOpenThread() {
+    if (m_openThread.joinable()) {
+        m_openThread.join();
+    }
+}
+
+void CanAdapter::scheduleReconnect() {
+    const int64_t next = m_supervisor.nextAttemptUs();
+    if (next == ReconnectSupervisor::NO_ATTEMPT) {
+        m_reconnectTimer.stop();
+        return;
+    }
+    const int64_t delayMs = std::max<int64_t>((next - supervisorNowUs()) / US_PER_MS, 0);
+    m_reconnectTimer.start(static_cast<int>(
+        std::min<int64_t>(delayMs + 1, std::numeric_limits<int>::max())));
+}
+
+void CanAdapter::handleInterfaceLost(const QString& reason) {
+    qWarning() << "CanAdapter: CAN bus error:" << reason;
+    emit errorOccurred(reason);
+    if (!m_supervisor.isConnected() &&
+        m_supervisor.state() != ReconnectSupervisor::State::BusOff) {
+        return;  // Not supervised, or already reconnecting
+    }
+
+    qWarning() << "CanAdapter: Lost" << m_interface << "- reconnecting";
+    closeInterface(true);
+    m_supervisor.onLinkLost(supervisorNowUs());
+    emit connectionStateChanged(false);
+    scheduleReconnect();
+}
+
+void CanAdapter::handleErrorFrame(bool busOff, bool restarted) {
+    if (busOff) {
+        handleBusOff();
+    } else if (restarted && m_supervisor.state() == ReconnectSupervisor::State::BusOff) {
+        handleBusRecovered();
+    }
+}
+
+void CanAdapter::handleBusOff() {
+    qWarning() << "CanAdapter: Controller on" << m_interface << "is bus-off";
+    emit errorOccurred(QStringLiteral("CAN controller bus-off"));
+    if (!m_supervisor.isConnected()) {
+        return;
+    }
+
+    m_supervisor.onBusOff(supervisorNowUs());
+    emit connectionStateChanged(false);
+    if (m_canDevice) {
+        // Works where the plugin can restart the controller; reopened otherwise
+        m_canDevice->resetController();
+    }
+    scheduleReconnect();
+}
+
+void CanAdapter::handleBusRecovered() {
+    m_reconnectTimer.stop();
+    reportRecovery(m_supervisor.onConnected(supervisorNowUs()));
+    m_router.invalidatePayloadCache();
+    emit connectionStateChanged(true);
+}
+
+void CanAdapter::reportRecovery(int64_t outageUs) {
+    if (outageUs <= 0) {
+        return;
+    }
+    const double outageMs = static_cast<double>(outageUs) / US_PER_MS_DOUBLE;
+    qInfo() << "CanAdapter:" << m_interface << "recovered after" << outageMs << "ms";
+    publishChannels({{CHANNEL_BUS_RECOVERY, ChannelValue{outageMs, "ms", true}}},
+                    m_clock.elapsed());
+}
+
+std::vector<can_filter> CanAdapter::nativeReceiveFilters() const {
+    std::vector<can_filter> filters;
+    filters.reserve(m_receiveFilters.size());
+    for (const CanIdFilter& filter : m_receiveFilters) {
+        // Data frames of the filter's format only
+        const canid_t format = filter.extended ? CAN_EFF_FLAG : 0U;
+        filters.push_back(
+            can_filter{filter.frameId | format, filter.mask | CAN_EFF_FLAG | CAN_RTR_FLAG});
+    }
+    return filters;
+}
+
+int64_t CanAdapter::supervisorNowUs() const {
+    return m_clock.nsecsElapsed() / NS_PER_US;
+}
+
+QJsonObject CanAdapter::reconnectDiagnostics() const {
+    const ReconnectSupervisor::Stats& stats = m_supervisor.stats();
+    const auto toMs = [](int64_t us) { return static_cast<double>(us) / US_PER_MS_DOUBLE; };
+
+    QJsonObject reconnect;
+    reconnect["state"] =
+        QString::fromLatin1(RECONNECT_STATE_NAMES[static_cast<size_t>(m_supervisor.state())]);
+    reconnect["linkLosses"] = static_cast<qint64>(stats.linkLosses);
+    reconnect["busOffs"] = static_cast<qint64>(stats.busOffs);
+    reconnect["attempts"] = static_cast<qint64>(stats.attempts);
+    reconnect["failedAttempts"] = static_cast<qint64>(stats.failedAttempts);
+    reconnect["recoveries"] = static_cast<qint64>(stats.recoveries);
+    reconnect["lastRecoveryMs"] = toMs(stats.lastRecoveryUs);
+    reconnect["maxRecoveryMs"] = toMs(stats.maxRecoveryUs);
+    reconnect["totalOutageMs"] = toMs(stats.totalOutageUs);
+    reconnect["outageMs"] = toMs(m_supervisor.outageUs(supervisorNowUs()));
+    return reconnect;
+}
+
+bool CanAdapter::openFrameSource() {
+    if (!m_frameSource->open()) {
+        qCritical() << "CanAdapter: Failed to open" << m_frameSource->sourceName()
+                    << "source:" << m_frameSource->errorString();
+        emit errorOccurred(m_frameSource->errorString());
+        return false;
+    }
+    return true;
+}
+
+void CanAdapter::configureDevice() {
+    // Must be set before connectDevice(); SocketCAN applies them on connect
+    m_canDevice->setConfigurationParameter(QCanBusDevice::CanFdKey, m_canFd);
+    if (m_bitrate > 0) {
+        m_canDevice->setConfigurationParameter(QCanBusDevice::BitRateKey, m_bitrate);
+    }
+    if (m_dataBitrate > 0) {
+        m_canDevice->setConfigurationParameter(QCanBusDevice::DataBitRateKey, m_dataBitrate);
+    }
+
+    if (!m_receiveFilters.empty()) {
+        QList<QCanBusDevice::Filter> filters;
+        for (const CanIdFilter& filter : m_receiveFilters) {
+            QCanBusDevice::Filter entry;
+            entry.frameId = filter.frameId;
+            entry.frameIdMask = filter.mask;
+            entry.type = QCanBusFrame::DataFrame;
+            entry.format = filter.extended ? QCanBusDevice::Filter::MatchExtendedFormat
+                                           : QCanBusDevice::Filter::MatchBaseFormat;
+            filters.append(entry);
+        }
+        m_canDevice->setConfigurationParameter(QCanBusDevice::RawFilterKey,
+                                               QVariant::fromValue(filters));
+    }
+}
+
+void CanAdapter::buildReceiveFilters() {
+    m_receiveFilters.clear();
+    if (!m_kernelFilterEnabled || m_mappedChannels.isEmpty()) {
+        return;
+    }
+
+    const std::vector<FrameKey> routed = m_router.routedFrames();
+    std::vector<FrameKey> wanted;
+    for (const FrameKey& key : routed) {
+        const IFrameDecoder* decoder = m_router.lookup(key.frameId, key.extended);
+        if (!decoder->channelsMappedByProfile()) {
+            wanted.push_back(key);
+            continue;
+        }
+        const QStringList channels = decoder->frameChannels(key);
+        const bool used = channels.isEmpty() ||
+                          std::any_of(channels.begin(), channels.end(),
+                                      [this](const QString& name) {
+                                          return m_mappedChannels.contains(name);
+                                      });
+        if (used) {
+            wanted.push_back(key);
+        }
+    }
+
+    if (wanted.empty()) {
+        qWarning() << "CanAdapter: No protocol frame carries a mapped channel -"
+                   << "kernel filter disabled";
+        return;
+    }
+
+    m_receiveFilters = CanIdFilter::compress(wanted);
+    qInfo() << "CanAdapter: Kernel filter passes" << wanted.size() << "of" << routed.size()
+            << "protocol frames with" << m_receiveFilters.size() << "filters";
+}
+
+bool CanAdapter::passesReceiveFilters(const FrameKey& key) const {
+    return m_receiveFilters.empty() ||
+           std::any_of(m_receiveFilters.begin(), m_receiveFilters.end(),
+                       [&key](const CanIdFilter& filter) { return filter.matches(key); });
+}
+
+void CanAdapter::loadRateLimits(const QJsonObject& config) {
+    const QJsonObject limits = config[CONFIG_KEY_RATE_LIMITS].toObject();
+
+    const QJsonObject frames = limits[CONFIG_KEY_RATE_LIMIT_FRAMES].toObject();
+    for (auto it = frames.constBegin(); it != frames.constEnd(); ++it) {
+        bool ok = false;
+        const uint32_t frameId = it.key().toUInt(&ok, 0);
+        const double maxHz = it.value().toDouble();
+        if (!ok || maxHz <= 0.0) {
+            qWarning() << "CanAdapter: Ignoring invalid frame rate limit" << it.key();
+            continue;
+        }
+        m_frameRateLimits.emplace_back(FrameKey{frameId, frameId > MAX_STANDARD_FRAME_ID},
+                                       maxHz);
+    }
+
+    const QJsonObject channels = limits[CONFIG_KEY_RATE_LIMIT_CHANNELS].toObject();
+    for (auto it = channels.constBegin(); it != channels.constEnd(); ++it) {
+        const double maxHz = it.value().toDouble();
+        if (maxHz <= 0.0) {
+            qWarning() << "CanAdapter: Ignoring invalid channel rate limit" << it.key();
+            continue;
+        }
+        m_channelLimiter.setLimit(it.key(), maxHz);
+    }
+}
+
+void CanAdapter::loadTransmitFrames(const QJsonValue& config) {
+    const QJsonObject transmit = config.toObject();
+    if (transmit.isEmpty()) {
+        return;
+    }
+
+    TransmitSchedule::Options options;
+    const double toleranceMs =
+        transmit[CONFIG_KEY_TRANSMIT_TOLERANCE].toDouble(DEFAULT_TRANSMIT_TOLERANCE_MS);
+    options.toleranceUs = std::llround(toleranceMs * US_PER_MS_DOUBLE);
+    m_transmitter.setOptions(options);
+
+    for (const QJsonValue& value : transmit[CONFIG_KEY_TRANSMIT_FRAMES].toArray()) {
+        const QJsonObject entry = value.toObject();
+        const QJsonValue id = entry[CONFIG_KEY_TRANSMIT_ID];
+        bool ok = id.isDouble();
+        const uint32_t frameId = ok ? static_cast<uint32_t>(id.toInteger())
+                                    : id.toString().toUInt(&ok, 0);
+        if (!ok) {
+            qWarning() << "CanAdapter: Ignoring transmit frame without a valid id";
+            continue;
+        }
+
+        const QByteArray data =
+            QByteArray::fromHex(entry[CONFIG_KEY_TRANSMIT_DATA].toString().toLatin1());
+        QCanBusFrame frame(frameId, data);
+        frame.setExtendedFrameFormat(
+            entry[CONFIG_KEY_TRANSMIT_EXTENDED].toBool(frameId > MAX_STANDARD_FRAME_ID));
+        const double periodMs = entry[CONFIG_KEY_TRANSMIT_PERIOD].toDouble();
+        const double phaseMs = entry[CONFIG_KEY_TRANSMIT_PHASE].toDouble(-1.0);
+        (void)addPeriodicFrame(frame, periodMs, phaseMs);
+    }
+}
+
+void CanAdapter::applyFrameRateLimits() {
+    for (const auto& [key, maxHz] : m_frameRateLimits) {
+        m_router.setFrameRateLimit(key, maxHz);
+    }
+}
+
+void CanAdapter::startBusMonitor() {
+    m_busMonitor.reset();
+    for (const FrameKey& key : m_router.routedFrames()) {
+        if (!passesReceiveFilters(key)) {
+            continue;  // Filtered out in the kernel, would only show as a gap
+        }
+        const IFrameDecoder* decoder = m_router.lookup(key.frameId, key.extended);
+        m_busMonitor.setExpectedRate(key, decoder->declaredRateHz(key));
+    }
+    m_lastBusStats = BusMonitor::BusStats{};
+    m_busWindow.start();
+    m_busStatsTimer.start(BUS_STATS_INTERVAL_MS);
+}
+
+void CanAdapter::startRecording() {
+    if (!QDir().mkpath(m_recordDirectory)) {
+        qWarning() << "CanAdapter: Cannot create recording directory" << m_recordDirectory;
+        return;
+    }
+    const QString fileName = m_interface + '-' +
+                             QDateTime::currentDateTime().toString(RECORD_TIME_FORMAT) +
+                             RECORD_FILE_SUFFIX;
+    m_recordOptions.path = QDir(m_recordDirectory).filePath(fileName).toStdString();
+    m_recordOptions.interfaceName = m_interface.toStdString();
+
+    auto recorder = std::make_unique<CanRecorder>();
+    if (!recorder->start(m_recordOptions)) {
+        qWarning() << "CanAdapter: Recording disabled -"
+                   << QString::fromStdString(recorder->errorString());
+        return;
+    }
+    m_recorder = std::move(recorder);
+    qInfo() << "CanAdapter: Recording to" << QString::fromStdString(m_recorder->path());
+}
+
+void CanAdapter::stopRecording() {
+    if (!m_recorder) {
+        return;
+    }
+    m_recorder->stop();
+    qInfo() << "CanAdapter: Recorded" << m_recorder->recordedFrames() << "frames to"
+            << QString::fromStdString(m_recorder->path());
+    if (m_recorder->droppedFrames() > 0) {
+        qWarning() << "CanAdapter: Recording dropped" << m_recorder->droppedFrames()
+                   << "frames (writer fell behind)";
+    }
+    if (m_recorder->hasWriteError()) {
+        qWarning() << "CanAdapter: Recording ended early, lost" << m_recorder->lostFrames()
+                   << "frames -" << QString::fromStdString(m_recorder->errorString());
+    }
+    m_recorder.reset();
+}
+
+qint64 CanAdapter::frameTimestampUs(const QCanBusFrame& frame) const {
+    // Kernel receive time when the plugin provides it, so devdash's own
+    // scheduling delays do not show up as bus jitter
+    const QCanBusFrame::TimeStamp stamp = frame.timeStamp();
+    const qint64 stampUs = stamp.seconds() * US_PER_SECOND + stamp.microSeconds();
+    return stampUs != 0 ? stampUs : m_clock.nsecsElapsed() / NS_PER_US;
+}
+
+void CanAdapter::processFrame(const QCanBusFrame& frame) {
+    if (m_supervisor.state() == ReconnectSupervisor::State::BusOff) {
+        handleBusRecovered();  // Traffic again: restarted without a restart error frame
+    }
+    if (m_busMonitorEnabled) {
+        m_busMonitor.recordFrame(frame, frameTimestampUs(frame));
+    }
+    if (interceptFrame(frame)) {
+        return;
+    }
+    const qint64 now = m_router.hasRateLimits() || !m_channelLimiter.isEmpty()
+                           ? m_clock.elapsed()
+                           : FrameRouter::CLOCK_NOW;
+    publishChannels(m_router.decode(frame, now), now);
+}
+
+void CanAdapter::processRawFrame(const RawCanFrame& raw) {
+    if (raw.error) {
+        handleErrorFrame((raw.frameId & CAN_ERR_BUSOFF) != 0,
+                         (raw.frameId & CAN_ERR_RESTARTED) != 0);
+        return;
+    }
+    if (m_recorder) {
+        m_recorder->record(raw);
+    }
+    if (raw.remote) {
+        return;
+    }
+
+    // Wraps the ring slot without copying: fromRawData() does not allocate,
+    // and FrameRouter copies the frames it holds back
+    QCanBusFrame frame(raw.frameId,
+                       QByteArray::fromRawData(reinterpret_cast<const char*>(raw.data.data()),
+                                               raw.length));
+    frame.setExtendedFrameFormat(raw.extended);
+    frame.setFlexibleDataRateFormat(raw.flexibleDataRate);
+    frame.setBitrateSwitch(raw.bitrateSwitch);
+    frame.setTimeStamp(QCanBusFrame::TimeStamp::fromMicroSeconds(raw.timestampNs / NS_PER_US));
+    processFrame(frame);
+}
+
+void CanAdapter::processSourceFrame(const RawCanFrame& raw) {
+    if (m_frameSource->hasArrivalTimestamps()) {
+        processRawFrame(raw);
+        return;
+    }
+    // Recorded receive times would show scaled playback (and every loop
+    // restart) as bus jitter; the bus monitor measures the delivery instead
+    RawCanFrame frame = raw;
+    frame.timestampNs = 0;
+    processRawFrame(frame);
+}
+
+void CanAdapter::publishChannels(const std::vector<std::pair<QString, ChannelValue>>& decoded,
+                                 qint64 nowMs) {
+    for (const auto& [channelName, value] : decoded) {
+        DEVDASH_CDEBUG_RATE(logAdapter, CHANNEL_LOG_PER_SECOND)
+            << "CanAdapter: Channel:" << channelName << "=" << value.value << value.unit
+            << "(valid:" << value.valid << ")";
+        m_channels[channelName] = value;
+        if (m_channelLimiter.isEmpty() || m_channelLimiter.admit(channelName, value, nowMs)) {
+            emit channelUpdated(channelName, value);
+        }
+    }
+}
+
+void CanAdapter::logPayloadCacheStats() const {
+    if (m_router.payloadCacheHits() == 0) {
+        return;
+    }
+    qInfo() << "CanAdapter: Skipped" << m_router.payloadCacheHits()
+            << "frames with unchanged payloads";
+    for (const auto& stats : m_router.payloadCacheStats()) {
+        if (stats.hits == 0) {
+            continue;
+        }
+        qInfo().nospace() << "CanAdapter: Frame 0x" << Qt::hex << stats.key.frameId << Qt::dec
+                          << " skipped " << stats.hits << " of " << stats.hits + stats.misses
+                          << " (" << stats.hitRate() * PERCENT << "%)";
+    }
+}
+
+void CanAdapter::logRateLimitStats() const {
+    for (const auto& stats : m_router.rateLimitStats()) {
+        qInfo().nospace() << "CanAdapter: Frame 0x" << Qt::hex << stats.key.frameId << Qt::dec
+                          << " declared " << stats.declaredHz << " Hz, received "
+                          << stats.receivedHz << " Hz, decoded " << stats.decodedHz
+                          << " Hz (cap " << stats.limitHz << " Hz)";
+    }
+    if (m_channelLimiter.droppedCount() > 0) {
+        qInfo() << "CanAdapter: Rate limits superseded" << m_channelLimiter.droppedCount()
+                << "channel values";
+    }
+}
+
+void CanAdapter::logBusMonitorStats() const {
+    if (!m_busMonitorEnabled || m_busMonitor.totalFrames() == 0) {
+        return;
+    }
+    for (const auto& stats : m_busMonitor.frameStats()) {
+        const bool belowDeclared =
+            stats.declaredHz > 0.0 && stats.measuredHz < stats.declaredHz * LOW_RATE_FRACTION;
+        if (stats.gaps == 0 && !belowDeclared) {
+            continue;
+        }
+        qInfo().nospace() << "CanAdapter: Frame 0x" << Qt::hex << stats.key.frameId << Qt::dec
+                          << " declared " << stats.declaredHz << " Hz, measured "
+                          << stats.measuredHz << " Hz, " << stats.gaps << " gaps (longest "
+                          << stats.longestGapMs << " ms), jitter " << stats.jitterMs
+                          << " ms (max " << stats.maxJitterMs << " ms)";
+    }
+}
+
+void CanAdapter::logTransmitStats() const {
+    const TransmitSchedule::Stats& stats = m_transmitter.schedule().stats();
+    if (stats.sent == 0 && stats.writeFailures == 0) {
+        return;
+    }
+    qInfo() << "CanAdapter: Sent" << stats.sent << "periodic frames," << stats.deadlineMisses
+            << "deadline misses," << stats.skipped << "skipped," << stats.writeFailures
+            << "write failures, lateness mean" << stats.meanLatenessUs << "us, max"
+            << stats.maxLatenessUs << "us";
+}
+
+} // namespace devdash
@@ -0,0 +1,356 @@
+#pragma once
+
+#include "BusMonitor.h"
+#include "CanIdFilter.h"
+#include "CanLogPlayer.h"
+#include "CanRecorder.h"
+#include "ChannelRateLimiter.h"
+#include "FrameRouter.h"
+#include "ICanFrameSource.h"
+#include "PeriodicTransmitter.h"
+#include "RawCanSocket.h"
+#include "ReconnectSupervisor.h"
+#include "core/interfaces/IProtocolAdapter.h"
+
+#include <QCanBus>
+#include <QCanBusDevice>
+#include <QCanBusFrame>
+#include <QElapsedTimer>
+#include <QHash>
+#include <QJsonObject>
+#include <QSet>
+#include <QSocketNotifier>
+#include <QTimer>
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <span>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace devdash {
+
+/**
+ * @brief Common base for protocol adapters that read a SocketCAN interface
+ *
+ * Owns the CAN socket (QCanBusDevice or the native RawCanSocket), the frame
+ * receive loop, the FrameRouter and the latest-value channel cache.
+ * Subclasses only register their protocol decoders with the router, so
+ * Haltech, PD16, DBC and future CAN protocols share one I/O path and one
+ * dispatch table.
+ *
+ * Single Responsibility: CAN bus I/O only, decoding is delegated.
+ */
+class CanAdapter : public IProtocolAdapter {
+    Q_OBJECT
+
+  public:
+    ~CanAdapter() override;
+
+    // QObject-based classes are not copyable or movable
+    CanAdapter(const CanAdapter&) = delete;
+    CanAdapter& operator=(const CanAdapter&) = delete;
+    CanAdapter(CanAdapter&&) = delete;
+    CanAdapter& operator=(CanAdapter&&) = delete;
+
+    // IProtocolAdapter interface
+    [[nodiscard]] bool start() override;
+    void stop() override;
+    [[nodiscard]] bool isRunning() const override;
+
+    /**
+     * @brief Last value of a channel
+     *
+     * Channels are updated on the adapter's thread; callers on another
+     * thread (the GUI, while the adapter runs on the DataBroker I/O
+     * thread) block until the adapter thread has read the value.
+     */
+    [[nodiscard]] std::optional<ChannelValue> getChannel(const QString& channelName) const override;
+
+    /**
+     * @brief Names of all channels decoded so far (same threading as getChannel())
+     */
+    [[nodiscard]] QStringList availableChannels() const override;
+
+    /**
+     * @brief Bus load and per-frame arrival statistics
+     *
+     * "bus": figures of the last one-second window; "frames": per-ID count,
+     * declared and measured rate, jitter and gaps (see BusMonitor);
+     * "reconnect": connection state, outages and recovery times of a
+     * supervised live interface (see ReconnectSupervisor); "transmit":
+     * periodic frames sent, deadline misses and lateness histogram (see
+     * PeriodicTransmitter); "payloadCache": per-ID frames skipped for an
+     * unchanged payload and the hit rate (see FrameRouter), also reported
+     * without the bus monitor.
+     */
+    [[nodiscard]] QJsonObject diagnostics() const override;
+
+    /**
+     * @brief True for a supervised "qt" backend interface
+     *
+     * Its QCanBusDevice is created and connected on the adapter's thread
+     * on every reconnect attempt, which must not be the GUI thread.
+     */
+    [[nodiscard]] bool requiresIoThread() const override;
+
+    /**
+     * @brief Check whether frames come from a replayed log instead of the bus
+     */
+    [[nodiscard]] bool isReplaying() const;
+
+    /**
+     * @brief Jump to @p seconds after the start of the replayed log
+     * @return false if the adapter is not running a replay
+     */
+    bool seekReplay(double seconds);
+
+    /// Internal channels published once per second while the bus monitor is enabled
+    static constexpr const char* CHANNEL_BUS_LOAD = "bus.load";
+    static constexpr const char* CHANNEL_BUS_FRAME_RATE = "bus.frameRate";
+    static constexpr const char* CHANNEL_BUS_GAPS = "bus.gaps";
+    static constexpr const char* CHANNEL_BUS_JITTER = "bus.jitter";
+
+    /// Internal channel published when the interface is back after an outage (ms)
+    static constexpr const char* CHANNEL_BUS_RECOVERY = "bus.recoveryMs";
+
+  protected:
+    /**
+     * @brief Construct the CAN I/O layer
+     *
+     * Reads the shared CAN keys of the adapter config: "interface" and
+     * "backend" (qt, native, virtual, slcan), "canFd" and bitrates,
+     * "skipUnchangedPayloads", "rateLimits", "busMonitor", "kernelFilter",
+     * "record", "replay", "reconnect" and "transmit". See
+     * docs/02-api-reference/can-adapter-config.md for every key and its
+     * default.
+     *
+     * @param config Adapter configuration
+     * @param parent Qt parent object
+     */
+    explicit CanAdapter(const QJsonObject& config, QObject* parent = nullptr);
+
+    /**
+     * @brief Get the frame router subclasses register their decoders with
+     *
+     * Register decoders from the constructor; the router is not modified
+     * while frames are being received.
+     */
+    [[nodiscard]] FrameRouter& router() { return m_router; }
+
+    /**
+     * @brief Get the frame router (read-only, e.g. for statistics)
+     */
+    [[nodiscard]] const FrameRouter& router() const { return m_router; }
+
+    /**
+     * @brief Get the configured CAN interface name (e.g., "can0")
+     */
+    [[nodiscard]] const QString& interfaceName() const { return m_interface; }
+
+    /**
+     * @brief Check whether CAN FD frames are enabled
+     */
+    [[nodiscard]] bool canFdEnabled() const { return m_canFd; }
+
+    /**
+     * @brief Send a frame on the bus
+     *
+     * Payloads over 8 bytes are sent as CAN FD frames (with bit-rate switch
+     * if configured); they are rejected when CAN FD is disabled.
+     *
+     * @return false if the adapter is not running or the frame was rejected
+     */
+    bool writeFrame(QCanBusFrame frame);
+
+    /**
+     * @brief Send @p frame every @p periodMs from the adapter's I/O thread
+     *
+     * For output control, keypad emulation and keepalives. Frames are sent
+     * by a PeriodicTransmitter: on a fixed time grid, @p phaseMs into each
+     * period (staggered automatically when negative), all frames due at
+     * once in one batch. Lateness and deadline misses are reported under
+     * "transmit" in diagnostics(). Frames configured under "transmit" are
+     * added the same way. May be called before or while running; sending
+     * stops in stop() and resumes in start().
+     *
+     * @return Handle for setPeriodicPayload() / removePeriodicFrame(), -1 if
+     *         the period is under 1 ms or the payload needs CAN FD while it is disabled
+     */
+    [[nodiscard]] int addPeriodicFrame(const QCanBusFrame& frame, double periodMs,
+                                       double phaseMs = -1.0);
+
+    /**
+     * @brief Replace the payload of a periodic frame from its next period on
+     *
+     * The frame format is fixed by addPeriodicFrame(): a classic frame
+     * takes at most 8 bytes.
+     */
+    bool setPeriodicPayload(int id, const QByteArray& payload);
+
+    /**
+     * @brief Stop sending a periodic frame
+     */
+    bool removePeriodicFrame(int id);
+
+    /**
+     * @brief Read frames from @p source instead of the CAN interface
+     *
+     * Call from the constructor. The adapter takes ownership, opens and
+     * starts the source in start() and stops it in stop(); frames take the
+     * normal decode path and writeFrame() sends through writable sources.
+     * Replaces the "replay", "virtual" or "slcan" source set up from the config.
+     * Kernel filters are not installed while a source is set.
+     */
+    void setFrameSource(std::unique_ptr<ICanFrameSource> source);
+
+    /**
+     * @brief Get the frame source, or nullptr when reading the interface
+     */
+    [[nodiscard]] ICanFrameSource* frameSource() const { return m_frameSource.get(); }
+
+    /**
+     * @brief Compute the kernel receive filters from the registered decoders
+     *
+     * Called by start(); leaves the filters empty (every frame received)
+     * when "kernelFilter" is false or no channel is mapped.
+     */
+    void buildReceiveFilters();
+
+    /**
+     * @brief Get the kernel receive filters (empty = every frame received)
+     */
+    [[nodiscard]] const std::vector<CanIdFilter>& receiveFilters() const {
+        return m_receiveFilters;
+    }
+
+    /**
+     * @brief Take a received frame before the router decodes it
+     *
+     * For request/response protocols (OBD-II) that must see every response
+     * frame in order: the router's unchanged-payload cache and frame rate
+     * limits would swallow repeated answers. The bus monitor and recorder
+     * have already seen the frame.
+     *
+     * @return true if the frame was handled and is not passed to the router
+     */
+    [[nodiscard]] virtual bool interceptFrame(const QCanBusFrame& /*frame*/) { return false; }
+
+    /**
+     * @brief Publish channels decoded outside the router (channel rate limits apply)
+     */
+    void publishDecoded(const std::vector<std::pair<QString, ChannelValue>>& decoded);
+
+  private slots:
+    void onFramesReceived();
+    void onErrorOccurred(QCanBusDevice::CanBusError error);
+    void onStateChanged(QCanBusDevice::CanBusDeviceState state);
+    void onRateLimitTimeout();
+    void onBusStatsTimeout();
+    void onRawSocketReadable();
+    void onReconnectTimeout();
+
+  private:  // NOLINT(readability-redundant-access-specifiers) - Required for MOC
+    /// Inputs and result of one open attempt on the reconnect worker thread
+    struct OpenAttempt;
+
+    [[nodiscard]] bool openCanDevice();
+    [[nodiscard]] bool openRawSocket();
+    void attachRawSocket();
+    void closeInterface(bool deferDelete);
+    void loadReconnectOptions(const QJsonValue& config);
+    void startOpenAttempt();
+    void finishOpenAttempt(OpenAttempt& attempt, uint64_t generation);
+    void joinOpenThread();
+    void scheduleReconnect();
+    void handleInterfaceLost(const QString& reason);
+    void handleErrorFrame(bool busOff, bool restarted);
+    void handleBusOff();
+    void handleBusRecovered();
+    void reportRecovery(int64_t outageUs);
+    [[nodiscard]] std::vector<can_filter> nativeReceiveFilters() const;
+    [[nodiscard]] int64_t supervisorNowUs() const;
+    [[nodiscard]] QJsonObject reconnectDiagnostics() const;
+    [[nodiscard]] bool openFrameSource();
+    void configureDevice();
+    [[nodiscard]] bool passesReceiveFilters(const FrameKey& key) const;
+    void loadRateLimits(const QJsonObject& config);
+    void loadTransmitFrames(const QJsonValue& config);
+    [[nodiscard]] bool prepareTransmitFrame(QCanBusFrame& frame, RawCanFrame& raw) const;
+    [[nodiscard]] size_t writePeriodicFrames(std::span<const RawCanFrame> frames);
+    void applyFrameRateLimits();
+    void startBusMonitor();
+    void startRecording();
+    void stopRecording();
+    [[nodiscard]] qint64 frameTimestampUs(const QCanBusFrame& frame) const;
+    void processFrame(const QCanBusFrame& frame);
+    void processRawFrame(const RawCanFrame& raw);
+    void processSourceFrame(const RawCanFrame& raw);
+    void publishChannels(const std::vector<std::pair<QString, ChannelValue>>& decoded,
+                         qint64 nowMs);
+    void logPayloadCacheStats() const;
+    void logRateLimitStats() const;
+    void logBusMonitorStats() const;
+    void logTransmitStats() const;
+
+    /**
+     * @brief Run @p function on the adapter's thread, blocking until done
+     */
+    void runOnAdapterThread(const std::function<void()>& function) const;
+
+    QString m_interface;
+    bool m_canFd{false};
+    bool m_bitRateSwitch{true};
+    int m_bitrate{0};       ///< Nominal bitrate in bit/s, 0 = keep interface setting
+    int m_dataBitrate{0};   ///< CAN FD data-phase bitrate in bit/s, 0 = keep interface setting
+    bool m_nativeBackend{false};
+    std::unique_ptr<QCanBusDevice> m_canDevice;
+    std::unique_ptr<RawCanSocket> m_rawSocket;
+    std::unique_ptr<QSocketNotifier> m_rawNotifier;
+    FrameRouter m_router;
+    QHash<QString, ChannelValue> m_channels;
+    bool m_running{false};
+
+    /// Frame caps from the config, applied once subclasses have registered decoders
+    std::vector<std::pair<FrameKey, double>> m_frameRateLimits;
+    ChannelRateLimiter m_channelLimiter;
+    QElapsedTimer m_clock;
+    QTimer m_rateLimitTimer;  ///< Releases held-back frames and channels
+
+    /// Protocol channel names mapped by the profile
+    QSet<QString> m_mappedChannels;
+    bool m_kernelFilterEnabled{true};
+    /// Installed kernel receive filters (empty = receive everything)
+    std::vector<CanIdFilter> m_receiveFilters;
+
+    bool m_busMonitorEnabled{true};
+    BusMonitor m_busMonitor;
+    BusMonitor::BusStats m_lastBusStats;
+    QElapsedTimer m_busWindow;
+    QTimer m_busStatsTimer;   ///< Closes a bus monitor window and publishes bus.* channels
+
+    /// Directory for session recordings, empty = recording disabled
+    QString m_recordDirectory;
+    CanRecorder::Options m_recordOptions;
+    std::unique_ptr<CanRecorder> m_recorder;
+
+    /// Replay log, simulator, virtual bus or SLCAN dongle read instead of the
+    /// interface, null = live bus
+    std::unique_ptr<ICanFrameSource> m_frameSource;
+
+    /// Periodic frames ("transmit" and addPeriodicFrame()), timed on the adapter's thread
+    PeriodicTransmitter m_transmitter;
+
+    /// Reopen a lost live interface; false = open synchronously in start(), fail if absent
+    bool m_reconnectEnabled{true};
+    ReconnectSupervisor m_supervisor;
+    QTimer m_reconnectTimer;  ///< Fires when the next open attempt is due
+    /// Opens the interface off the adapter's thread; joined before the next attempt
+    std::thread m_openThread;
+    /// Bumped by stop(), so a late attempt result is discarded
+    uint64_t m_openGeneration{0};
+};
+
+} // namespace devdash
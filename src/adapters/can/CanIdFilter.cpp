@@ -0,0 +1,128 @@
+/**
+ * @file CanIdFilter.cpp
+ * @brief Implementation of kernel receive filter compression.
+ */
+
+#include "CanIdFilter.h"
+
+#include <algorithm>
+#include <bit>
+#include <limits>
+
+namespace devdash {
+
+namespace {
+
+//=============================================================================
+// Identifier Widths
+//=============================================================================
+
+constexpr int STANDARD_ID_BITS = 11;
+constexpr int EXTENDED_ID_BITS = 29;
+constexpr uint32_t STANDARD_ID_MASK = 0x7FF;
+constexpr uint32_t EXTENDED_ID_MASK = 0x1FFFFFFF;
+
+uint32_t fullMask(bool extended) {
+    return extended ? EXTENDED_ID_MASK : STANDARD_ID_MASK;
+}
+
+/// Smallest filter accepting everything both filters accept
+CanIdFilter merged(const CanIdFilter& lhs, const CanIdFilter& rhs) {
+    CanIdFilter result;
+    result.extended = lhs.extended;
+    result.mask = lhs.mask & rhs.mask & ~(lhs.frameId ^ rhs.frameId);
+    result.frameId = lhs.frameId & result.mask;
+    return result;
+}
+
+bool covers(const CanIdFilter& outer, const CanIdFilter& inner) {
+    return outer.extended == inner.extended && (inner.mask & outer.mask) == outer.mask &&
+           (inner.frameId & outer.mask) == outer.frameId;
+}
+
+} // anonymous namespace
+
+//=============================================================================
+// Matching
+//=============================================================================
+
+bool CanIdFilter::matches(const FrameKey& key) const {
+    return key.extended == extended && (key.frameId & mask) == frameId;
+}
+
+uint64_t CanIdFilter::coveredIdCount() const {
+    const int idBits = extended ? EXTENDED_ID_BITS : STANDARD_ID_BITS;
+    const int freeBits = idBits - std::popcount(mask & fullMask(extended));
+    return uint64_t{1} << freeBits;
+}
+
+//=============================================================================
+// Compression
+//=============================================================================
+
+std::vector<CanIdFilter> CanIdFilter::compress(const std::vector<FrameKey>& frames,
+                                               int maxFilters) {
+    std::vector<CanIdFilter> filters;
+    filters.reserve(frames.size());
+    for (const FrameKey& key : frames) {
+        const uint32_t mask = fullMask(key.extended);
+        filters.push_back(CanIdFilter{key.frameId & mask, mask, key.extended});
+    }
+    std::sort(filters.begin(), filters.end(), [](const CanIdFilter& lhs, const CanIdFilter& rhs) {
+        return lhs.extended != rhs.extended ? !lhs.extended : lhs.frameId < rhs.frameId;
+    });
+    filters.erase(std::unique(filters.begin(), filters.end(),
+                              [](const CanIdFilter& lhs, const CanIdFilter& rhs) {
+                                  return lhs.extended == rhs.extended &&
+                                         lhs.frameId == rhs.frameId;
+                              }),
+                  filters.end());
+
+    // Greedy: merge the pair admitting the fewest extra IDs. Free merges
+    // (e.g. 0x360 + 0x361) are always worth it; costly ones only while over
+    // the limit. Each merge removes at least one filter, so this terminates.
+    const auto limit = static_cast<size_t>(std::max(maxFilters, 1));
+    while (filters.size() > 1) {
+        size_t bestLhs = 0;
+        size_t bestRhs = 0;
+        auto bestCost = std::numeric_limits<int64_t>::max();
+        for (size_t i = 0; i < filters.size(); ++i) {
+            for (size_t j = i + 1; j < filters.size(); ++j) {
+                if (filters[i].extended != filters[j].extended) {
+                    continue;
+                }
+                // Negative when one filter already contains the other
+                const int64_t cost =
+                    static_cast<int64_t>(merged(filters[i], filters[j]).coveredIdCount()) -
+                    static_cast<int64_t>(filters[i].coveredIdCount()) -
+                    static_cast<int64_t>(filters[j].coveredIdCount());
+                if (cost < bestCost) {
+                    bestCost = cost;
+                    bestLhs = i;
+                    bestRhs = j;
+                }
+            }
+        }
+        const bool found = bestCost != std::numeric_limits<int64_t>::max();
+        if (!found || (bestCost > 0 && filters.size() <= limit)) {
+            break;
+        }
+
+        const CanIdFilter combined = merged(filters[bestLhs], filters[bestRhs]);
+        filters.erase(std::remove_if(filters.begin(), filters.end(),
+                                     [&combined](const CanIdFilter& filter) {
+                                         return covers(combined, filter);
+                                     }),
+                      filters.end());
+        const auto position = std::find_if(
+            filters.begin(), filters.end(), [&combined](const CanIdFilter& filter) {
+                return filter.extended == combined.extended
+                           ? filter.frameId > combined.frameId
+                           : filter.extended;
+            });
+        filters.insert(position, combined);
+    }
+    return filters;
+}
+
+} // namespace devdash
@@ -0,0 +1,57 @@
+#pragma once
+
+#include "IFrameDecoder.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace devdash {
+
+/**
+ * @brief One kernel receive filter: an identifier and the bits that must match
+ *
+ * A frame passes when (frameId & mask) == (filter.frameId & mask) and its
+ * format matches. SocketCAN evaluates every filter for every frame in the
+ * receive softirq, so a short list of masks is cheaper than one exact filter
+ * per ID; compress() trades a few unused IDs for fewer filters.
+ *
+ * @code
+ * auto filters = CanIdFilter::compress({{0x360, false}, {0x361, false}});
+ * // one filter: frameId 0x360, mask 0x7FE
+ * @endcode
+ */
+struct CanIdFilter {
+    /// Filters kept by default; neighbouring IDs are merged beyond this
+    static constexpr int DEFAULT_MAX_FILTERS = 16;
+
+    uint32_t frameId = 0;  ///< Identifier bits (only those set in mask are compared)
+    uint32_t mask = 0;     ///< Bits that must match (0x7FF / 0x1FFFFFFF = exact)
+    bool extended = false; ///< Matches 29-bit frames instead of 11-bit frames
+
+    /**
+     * @brief Check whether a frame passes this filter
+     */
+    [[nodiscard]] bool matches(const FrameKey& key) const;
+
+    /**
+     * @brief Number of identifiers this filter lets through
+     */
+    [[nodiscard]] uint64_t coveredIdCount() const;
+
+    /**
+     * @brief Build filters accepting every given frame
+     *
+     * Starts from one exact filter per frame and repeatedly merges the pair
+     * of same-format filters that admits the fewest extra IDs. Merges that
+     * admit none are always taken; others only until at most maxFilters
+     * remain. Every input frame is guaranteed to pass.
+     *
+     * @param frames Frames to receive (duplicates are fine)
+     * @param maxFilters Upper bound on the result size (at least one per format used)
+     * @return Filters, standard format first, lowest ID first; empty if frames is empty
+     */
+    [[nodiscard]] static std::vector<CanIdFilter>
+    compress(const std::vector<FrameKey>& frames, int maxFilters = DEFAULT_MAX_FILTERS);
+};
+
+} // namespace devdash
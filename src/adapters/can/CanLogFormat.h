@@ -0,0 +1,60 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace devdash {
+
+/**
+ * @brief Layout of devdash binary CAN logs (".ddcan")
+ *
+ * Written by CanRecorder, read by CanLogReader. All integers are
+ * little-endian and records are packed without padding:
+ *
+ * @code
+ * File header   32 bytes   magic "DDCANLOG", version, header size, flags,
+ *                          interface name (NUL-padded, 16 bytes)
+ * Record        14 + n     int64 timestampNs, uint32 frameId, uint8 flags,
+ *                          uint8 length, n = length payload bytes
+ * ...
+ * Index entry   16 bytes   int64 timestampNs, uint64 file offset of a record
+ * ...
+ * Footer        24 bytes   magic "DDCANIDX", uint64 offset of the first
+ *                          index entry, uint64 index entry count
+ * @endcode
+ *
+ * The index and footer are appended when recording stops. A log cut short
+ * (power loss, crash) has neither; readers then rebuild the index by
+ * scanning the records and ignore a truncated last record.
+ */
+struct CanLogFormat {
+    static constexpr std::array<char, 8> FILE_MAGIC = {'D', 'D', 'C', 'A', 'N', 'L', 'O', 'G'};
+    static constexpr std::array<char, 8> INDEX_MAGIC = {'D', 'D', 'C', 'A', 'N', 'I', 'D', 'X'};
+    static constexpr uint16_t VERSION = 1;
+
+    static constexpr size_t FILE_HEADER_SIZE = 32;
+    static constexpr size_t INTERFACE_NAME_SIZE = 16;
+    static constexpr size_t RECORD_HEADER_SIZE = 14;
+    static constexpr size_t INDEX_ENTRY_SIZE = 16;
+    static constexpr size_t FOOTER_SIZE = 24;
+
+    /// Largest payload a record may carry (CAN FD)
+    static constexpr uint8_t MAX_PAYLOAD = 64;
+
+    /// Record flag bits
+    static constexpr uint8_t FLAG_EXTENDED = 0x01;
+    static constexpr uint8_t FLAG_REMOTE = 0x02;
+    static constexpr uint8_t FLAG_FLEXIBLE_DATA_RATE = 0x04;
+    static constexpr uint8_t FLAG_BITRATE_SWITCH = 0x08;
+
+    /**
+     * @brief One entry of the time index
+     */
+    struct IndexEntry {
+        int64_t timestampNs = 0;  ///< Timestamp of the record at offset
+        uint64_t offset = 0;      ///< File offset of the first record at or after timestampNs
+    };
+};
+
+} // namespace devdash
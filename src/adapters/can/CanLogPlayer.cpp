@@ -0,0 +1,255 @@
+/**
+ * @file CanLogPlayer.cpp
+ * @brief Implementation of CAN log playback.
+ */
+
+#include "CanLogPlayer.h"
+
+#include "CanLogFormat.h"
+#include "CanLogReader.h"
+#include "CandumpLogReader.h"
+
+#include <QDebug>
+#include <QFile>
+#include <QJsonObject>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace devdash {
+
+namespace {
+
+//=============================================================================
+// Timing
+//=============================================================================
+
+constexpr double NS_PER_SECOND = 1e9;
+constexpr int64_t NS_PER_MS = 1000000;
+
+/// Due time at speed 0: every frame is due at once
+constexpr int64_t ALL_FRAMES_DUE = std::numeric_limits<int64_t>::max();
+
+/// Reported as source name and adapter backend
+constexpr const char* SOURCE_NAME = "replay";
+
+/**
+ * @brief Check for the binary log magic (anything else is read as candump text)
+ */
+bool isBinaryLog(const QString& path) {
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+    const QByteArray magic = file.read(static_cast<qint64>(CanLogFormat::FILE_MAGIC.size()));
+    return magic == QByteArray(CanLogFormat::FILE_MAGIC.data(),
+                               static_cast<qsizetype>(CanLogFormat::FILE_MAGIC.size()));
+}
+
+} // anonymous namespace
+
+//=============================================================================
+// Construction / Destruction
+//=============================================================================
+
+CanLogPlayer::CanLogPlayer(QObject* parent) : ICanFrameSource(parent) {
+    // Parented so it follows the player when it is moved to an I/O thread
+    m_timer.setParent(this);
+    m_timer.setSingleShot(true);
+    m_timer.setTimerType(Qt::PreciseTimer);
+    connect(&m_timer, &QTimer::timeout, this, &CanLogPlayer::onPlaybackTimeout);
+}
+
+CanLogPlayer::~CanLogPlayer() {
+    stop();
+}
+
+//=============================================================================
+// Playback Control
+//=============================================================================
+
+bool CanLogPlayer::open(const Options& options) {
+    stop();
+    m_reader.reset();
+    m_errorString.clear();
+    m_options = options;
+    m_hasPending = false;
+    m_framesPlayed = 0;
+    m_framesSinceRewind = 0;
+    m_loopCount = 0;
+
+    const std::string path = options.path.toStdString();
+    if (isBinaryLog(options.path)) {
+        auto reader = std::make_unique<CanLogReader>();
+        if (!reader->open(path)) {
+            m_errorString = QString::fromStdString(reader->errorString());
+            return false;
+        }
+        m_reader = std::move(reader);
+    } else {
+        auto reader = std::make_unique<CandumpLogReader>();
+        if (!reader->open(path)) {
+            m_errorString = QString::fromStdString(reader->errorString());
+            return false;
+        }
+        if (reader->invalidLines() > 0) {
+            qWarning() << "CanLogPlayer: Skipping" << reader->invalidLines()
+                       << "unreadable lines in" << options.path;
+        }
+        m_reader = std::move(reader);
+    }
+
+    seek(options.startSeconds);
+    return true;
+}
+
+bool CanLogPlayer::open() {
+    const Options options = m_options;
+    return open(options);
+}
+
+void CanLogPlayer::start() {
+    if (!m_reader || m_playing) {
+        return;
+    }
+    m_playing = true;
+    resetClock(m_positionNs);
+    m_timer.start(0);
+}
+
+void CanLogPlayer::stop() {
+    m_playing = false;
+    m_timer.stop();
+}
+
+void CanLogPlayer::seek(double seconds) {
+    if (!m_reader) {
+        return;
+    }
+    const auto offsetNs = static_cast<int64_t>(std::max(seconds, 0.0) * NS_PER_SECOND);
+    const int64_t target = m_reader->firstTimestampNs() + offsetNs;
+    m_reader->seek(target);
+    m_hasPending = false;
+    m_positionNs = target;
+    resetClock(target);
+    if (m_playing) {
+        m_timer.start(0);
+    }
+}
+
+double CanLogPlayer::positionSeconds() const {
+    if (!m_reader) {
+        return 0.0;
+    }
+    return static_cast<double>(m_positionNs - m_reader->firstTimestampNs()) / NS_PER_SECOND;
+}
+
+//=============================================================================
+// Source Description
+//=============================================================================
+
+QString CanLogPlayer::sourceName() const {
+    return QString::fromLatin1(SOURCE_NAME);
+}
+
+QString CanLogPlayer::description() const {
+    return m_options.path + " at " +
+           (m_options.speed > 0.0 ? QString::number(m_options.speed) + 'x'
+                                  : QStringLiteral("maximum speed"));
+}
+
+QJsonObject CanLogPlayer::diagnostics() const {
+    QJsonObject replay;
+    replay["file"] = m_options.path;
+    replay["speed"] = m_options.speed;
+    replay["positionSeconds"] = positionSeconds();
+    replay["frames"] = static_cast<qint64>(m_framesPlayed);
+    replay["loops"] = m_loopCount;
+    replay["playing"] = m_playing;
+    return replay;
+}
+
+//=============================================================================
+// Private Slots
+//=============================================================================
+
+void CanLogPlayer::onPlaybackTimeout() {
+    const int64_t dueNs = dueTimestampNs();
+    int delivered = 0;
+    while (m_playing && delivered < MAX_FRAMES_PER_PASS) {
+        if (!m_hasPending) {
+            if (!m_reader->next(m_pending)) {
+                if (restartOrFinish()) {
+                    scheduleNextPass(true);
+                }
+                return;
+            }
+            m_hasPending = true;
+        }
+        if (m_pending.timestampNs > dueNs) {
+            scheduleNextPass(false);
+            return;
+        }
+
+        m_hasPending = false;
+        m_positionNs = m_pending.timestampNs;
+        ++m_framesPlayed;
+        ++m_framesSinceRewind;
+        ++delivered;
+        deliver(m_pending);
+    }
+    if (m_playing) {
+        scheduleNextPass(true);
+    }
+}
+
+//=============================================================================
+// Private Methods
+//=============================================================================
+
+int64_t CanLogPlayer::dueTimestampNs() const {
+    if (m_options.speed <= 0.0) {
+        return ALL_FRAMES_DUE;
+    }
+    return m_clockStartNs +
+           static_cast<int64_t>(static_cast<double>(m_clock.nsecsElapsed()) * m_options.speed);
+}
+
+void CanLogPlayer::resetClock(int64_t timestampNs) {
+    m_clockStartNs = timestampNs;
+    m_clock.start();
+}
+
+bool CanLogPlayer::restartOrFinish() {
+    // An empty pass would loop forever without delivering anything
+    if (m_options.loop && m_framesSinceRewind > 0) {
+        m_reader->rewind();
+        m_framesSinceRewind = 0;
+        ++m_loopCount;
+        m_positionNs = m_reader->firstTimestampNs();
+        resetClock(m_positionNs);
+        return true;
+    }
+
+    m_playing = false;
+    qInfo() << "CanLogPlayer: Finished" << m_options.path << "after" << m_framesPlayed
+            << "frames";
+    emit finished();
+    return false;
+}
+
+void CanLogPlayer::scheduleNextPass(bool yieldOnly) {
+    if (yieldOnly || m_options.speed <= 0.0) {
+        m_timer.start(0);
+        return;
+    }
+    // Wall time until the pending frame is due, rounded up to whole milliseconds
+    const double waitNs =
+        static_cast<double>(m_pending.timestampNs - dueTimestampNs()) / m_options.speed;
+    const double waitMs = std::ceil(waitNs / static_cast<double>(NS_PER_MS));
+    m_timer.start(static_cast<int>(
+        std::clamp(waitMs, 0.0, static_cast<double>(std::numeric_limits<int>::max()))));
+}
+
+} // namespace devdash
@@ -0,0 +1,156 @@
+#pragma once
+
+#include "ICanFrameSource.h"
+#include "ICanLogReader.h"
+
+#include <QElapsedTimer>
+#include <QString>
+#include <QTimer>
+
+#include <cstdint>
+#include <memory>
+
+namespace devdash {
+
+/**
+ * @brief Plays a recorded CAN log back in real time, scaled or as fast as possible
+ *
+ * Reads binary logs (CanLogReader) and candump -L text (CandumpLogReader);
+ * the format is detected from the file. Frames are handed to the frame
+ * handler in log order, paced by their recorded timestamps divided by
+ * "speed". Speed 0 plays as fast as the handler consumes frames, in
+ * batches of MAX_FRAMES_PER_PASS so the event loop keeps running.
+ * finished() is emitted when the end of the log is reached without looping.
+ *
+ * Pacing follows a playback clock rather than sleeping between frames, so
+ * timer latency never accumulates: every pass delivers all frames that are
+ * due and then sleeps until the next one.
+ *
+ * @code
+ * CanLogPlayer player;
+ * player.setFrameHandler([](const RawCanFrame& frame) { ... });
+ * CanLogPlayer::Options options;
+ * options.path = "can0-20250101-120000.ddcan";
+ * options.speed = 2.0;
+ * if (player.open(options)) {
+ *     player.start();
+ * }
+ * @endcode
+ */
+class CanLogPlayer : public ICanFrameSource {
+    Q_OBJECT
+
+  public:
+    /// Frames delivered per event loop pass before yielding
+    static constexpr int MAX_FRAMES_PER_PASS = 1024;
+
+    /**
+     * @brief Playback settings
+     */
+    struct Options {
+        QString path;                ///< Binary log or candump -L text
+        double speed = 1.0;          ///< Playback speed factor, 0 = as fast as possible
+        bool loop = false;           ///< Start over from the first frame at the end
+        double startSeconds = 0.0;   ///< Offset into the log to start from
+    };
+
+    explicit CanLogPlayer(QObject* parent = nullptr);
+    ~CanLogPlayer() override;
+
+    // QObject-based classes are not copyable or movable
+    CanLogPlayer(const CanLogPlayer&) = delete;
+    CanLogPlayer& operator=(const CanLogPlayer&) = delete;
+    CanLogPlayer(CanLogPlayer&&) = delete;
+    CanLogPlayer& operator=(CanLogPlayer&&) = delete;
+
+    /**
+     * @brief Set the options used by open()
+     */
+    void setOptions(const Options& options) { m_options = options; }
+
+    /**
+     * @brief Open a log and position it at Options::startSeconds
+     * @return false if the file is missing or not a CAN log, see errorString()
+     */
+    [[nodiscard]] bool open(const Options& options);
+
+    /**
+     * @brief Open the log of the current options()
+     */
+    [[nodiscard]] bool open() override;
+
+    /**
+     * @brief Start (or resume) playback from the current position
+     */
+    void start() override;
+
+    /**
+     * @brief Pause playback; start() resumes at the same position
+     */
+    void stop() override;
+
+    /** @brief "replay" */
+    [[nodiscard]] QString sourceName() const override;
+
+    /** @brief Log path and playback speed */
+    [[nodiscard]] QString description() const override;
+
+    /**
+     * @brief File, speed, position, frames played, loops and playing state
+     */
+    [[nodiscard]] QJsonObject diagnostics() const override;
+
+    [[nodiscard]] bool isPlaying() const { return m_playing; }
+
+    /**
+     * @brief Jump to @p seconds after the first frame of the log
+     *
+     * Uses the reader's time index, so seeking does not replay or scan the
+     * frames in between.
+     */
+    void seek(double seconds);
+
+    /** @brief Offset of the playback position from the first frame, in seconds */
+    [[nodiscard]] double positionSeconds() const;
+
+    /** @brief Frames delivered to the handler */
+    [[nodiscard]] uint64_t framesPlayed() const { return m_framesPlayed; }
+    [[nodiscard]] uint64_t framesDelivered() const override { return m_framesPlayed; }
+
+    /** @brief Times the log was started over */
+    [[nodiscard]] int loopCount() const { return m_loopCount; }
+
+    [[nodiscard]] const Options& options() const { return m_options; }
+
+    [[nodiscard]] QString errorString() const override { return m_errorString; }
+
+  private slots:
+    void onPlaybackTimeout();
+
+  private:  // NOLINT(readability-redundant-access-specifiers) - Required for MOC
+    /// Log time that is due now
+    [[nodiscard]] int64_t dueTimestampNs() const;
+    /// Restart the playback clock at @p timestampNs
+    void resetClock(int64_t timestampNs);
+    /// Handle the end of the log; false when playback is over
+    bool restartOrFinish();
+    void scheduleNextPass(bool yieldOnly);
+
+    Options m_options;
+    std::unique_ptr<ICanLogReader> m_reader;
+    QString m_errorString;
+
+    QTimer m_timer;
+    QElapsedTimer m_clock;
+    int64_t m_clockStartNs{0};   ///< Log time at which the playback clock started
+    int64_t m_positionNs{0};     ///< Log time of the last delivered (or sought) frame
+
+    RawCanFrame m_pending;       ///< Next frame, read but not yet due
+    bool m_hasPending{false};
+    bool m_playing{false};
+    uint64_t m_framesPlayed{0};
+    uint64_t m_framesSinceRewind{0};
+    int m_loopCount{0};
+};
+
+} // namespace devdash
@@ -0,0 +1,257 @@
+/**
+ * @file CanLogReader.cpp
+ * @brief Implementation of the binary CAN log reader.
+ */
+
+#include "CanLogReader.h"
+
+#include <sys/types.h>
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <cstring>
+#include <iterator>
+
+namespace devdash {
+
+namespace {
+
+//=============================================================================
+// Decoding
+//=============================================================================
+
+constexpr int BITS_PER_BYTE = 8;
+
+/// Offsets inside the file header
+constexpr size_t HEADER_VERSION_OFFSET = 8;
+constexpr size_t HEADER_SIZE_OFFSET = 10;
+constexpr size_t HEADER_INTERFACE_OFFSET = 16;
+
+/// Offsets inside a record header
+constexpr size_t RECORD_ID_OFFSET = 8;
+constexpr size_t RECORD_FLAGS_OFFSET = 12;
+constexpr size_t RECORD_LENGTH_OFFSET = 13;
+
+/// Offsets inside the footer
+constexpr size_t FOOTER_INDEX_OFFSET = 8;
+constexpr size_t FOOTER_COUNT_OFFSET = 16;
+
+template <typename T> T readLittleEndian(const uint8_t* bytes) {
+    uint64_t bits = 0;
+    for (size_t i = 0; i < sizeof(T); ++i) {
+        bits |= static_cast<uint64_t>(bytes[i]) << (i * BITS_PER_BYTE);
+    }
+    return static_cast<T>(bits);
+}
+
+} // anonymous namespace
+
+//=============================================================================
+// Lifecycle
+//=============================================================================
+
+CanLogReader::~CanLogReader() {
+    close();
+}
+
+bool CanLogReader::open(const std::string& path) {
+    close();
+    m_errorString.clear();
+
+    m_file = std::fopen(path.c_str(), "rbe");
+    if (m_file == nullptr) {
+        m_errorString = "Cannot open " + path + ": " + std::strerror(errno);
+        return false;
+    }
+    if (!readHeader()) {
+        close();
+        return false;
+    }
+
+    std::fseek(m_file, 0, SEEK_END);
+    const auto fileSize = static_cast<uint64_t>(ftello(m_file));
+    if (!loadStoredIndex(fileSize)) {
+        rebuildIndex(fileSize);
+    }
+    rewind();
+    return true;
+}
+
+void CanLogReader::close() {
+    if (m_file != nullptr) {
+        std::fclose(m_file);
+        m_file = nullptr;
+    }
+    m_interfaceName.clear();
+    m_index.clear();
+    m_hasStoredIndex = false;
+    m_recordsEnd = 0;
+    m_position = 0;
+}
+
+//=============================================================================
+// Reading
+//=============================================================================
+
+bool CanLogReader::next(RawCanFrame& frame) {
+    if (m_file == nullptr || m_position >= m_recordsEnd) {
+        return false;
+    }
+    uint64_t recordSize = 0;
+    if (!readRecord(frame, recordSize)) {
+        m_position = m_recordsEnd;
+        return false;
+    }
+    m_position += recordSize;
+    return true;
+}
+
+void CanLogReader::seek(int64_t timestampNs) {
+    if (m_file == nullptr) {
+        return;
+    }
+
+    // Last index entry at or before the target
+    const auto after = std::upper_bound(
+        m_index.begin(), m_index.end(), timestampNs,
+        [](int64_t value, const CanLogFormat::IndexEntry& entry) {
+            return value < entry.timestampNs;
+        });
+    m_position = after == m_index.begin() ? CanLogFormat::FILE_HEADER_SIZE
+                                          : std::prev(after)->offset;
+    seekFile(m_position);
+
+    RawCanFrame frame;
+    while (m_position < m_recordsEnd) {
+        uint64_t recordSize = 0;
+        if (!readRecord(frame, recordSize)) {
+            m_position = m_recordsEnd;
+            return;
+        }
+        if (frame.timestampNs >= timestampNs) {
+            seekFile(m_position);
+            return;
+        }
+        m_position += recordSize;
+    }
+}
+
+void CanLogReader::rewind() {
+    m_position = CanLogFormat::FILE_HEADER_SIZE;
+    seekFile(m_position);
+}
+
+//=============================================================================
+// File Structure
+//=============================================================================
+
+bool CanLogReader::readHeader() {
+    std::array<uint8_t, CanLogFormat::FILE_HEADER_SIZE> header{};
+    if (std::fread(header.data(), 1, header.size(), m_file) != header.size() ||
+        !std::equal(CanLogFormat::FILE_MAGIC.begin(), CanLogFormat::FILE_MAGIC.end(),
+                    header.begin())) {
+        m_errorString = "Not a devdash CAN log";
+        return false;
+    }
+
+    const auto version = readLittleEndian<uint16_t>(&header[HEADER_VERSION_OFFSET]);
+    const auto headerSize = readLittleEndian<uint16_t>(&header[HEADER_SIZE_OFFSET]);
+    if (version != CanLogFormat::VERSION || headerSize != CanLogFormat::FILE_HEADER_SIZE) {
+        m_errorString = "Unsupported CAN log version " + std::to_string(version);
+        return false;
+    }
+
+    const auto* name = reinterpret_cast<const char*>(&header[HEADER_INTERFACE_OFFSET]);
+    m_interfaceName.assign(name, strnlen(name, CanLogFormat::INTERFACE_NAME_SIZE));
+    return true;
+}
+
+bool CanLogReader::loadStoredIndex(uint64_t fileSize) {
+    if (fileSize < CanLogFormat::FILE_HEADER_SIZE + CanLogFormat::FOOTER_SIZE) {
+        return false;
+    }
+
+    std::array<uint8_t, CanLogFormat::FOOTER_SIZE> footer{};
+    if (!seekFile(fileSize - CanLogFormat::FOOTER_SIZE) ||
+        std::fread(footer.data(), 1, footer.size(), m_file) != footer.size() ||
+        !std::equal(CanLogFormat::INDEX_MAGIC.begin(), CanLogFormat::INDEX_MAGIC.end(),
+                    footer.begin())) {
+        return false;
+    }
+
+    const auto indexOffset = readLittleEndian<uint64_t>(&footer[FOOTER_INDEX_OFFSET]);
+    const auto count = readLittleEndian<uint64_t>(&footer[FOOTER_COUNT_OFFSET]);
+    if (indexOffset < CanLogFormat::FILE_HEADER_SIZE || indexOffset > fileSize ||
+        count > fileSize / CanLogFormat::INDEX_ENTRY_SIZE ||
+        indexOffset + count * CanLogFormat::INDEX_ENTRY_SIZE + CanLogFormat::FOOTER_SIZE !=
+            fileSize) {
+        return false;
+    }
+
+    std::vector<uint8_t> entries(count * CanLogFormat::INDEX_ENTRY_SIZE);
+    if (!seekFile(indexOffset) ||
+        std::fread(entries.data(), 1, entries.size(), m_file) != entries.size()) {
+        return false;
+    }
+    m_index.resize(count);
+    for (size_t i = 0; i < count; ++i) {
+        const uint8_t* entry = &entries[i * CanLogFormat::INDEX_ENTRY_SIZE];
+        m_index[i].timestampNs = readLittleEndian<int64_t>(entry);
+        m_index[i].offset = readLittleEndian<uint64_t>(entry + sizeof(int64_t));
+    }
+    m_recordsEnd = indexOffset;
+    m_hasStoredIndex = true;
+    return true;
+}
+
+void CanLogReader::rebuildIndex(uint64_t fileSize) {
+    m_index.clear();
+    m_recordsEnd = fileSize;
+    m_position = CanLogFormat::FILE_HEADER_SIZE;
+    seekFile(m_position);
+
+    RawCanFrame frame;
+    int64_t nextIndexNs = 0;
+    bool first = true;
+    uint64_t recordSize = 0;
+    while (m_position < fileSize && readRecord(frame, recordSize)) {
+        if (first || frame.timestampNs >= nextIndexNs) {
+            m_index.push_back({frame.timestampNs, m_position});
+            nextIndexNs = frame.timestampNs + REBUILT_INDEX_INTERVAL_NS;
+            first = false;
+        }
+        m_position += recordSize;
+    }
+    // Anything after the last complete record was cut off mid-write
+    m_recordsEnd = m_position;
+}
+
+bool CanLogReader::readRecord(RawCanFrame& frame, uint64_t& recordSize) {
+    std::array<uint8_t, CanLogFormat::RECORD_HEADER_SIZE> header{};
+    if (std::fread(header.data(), 1, header.size(), m_file) != header.size()) {
+        return false;
+    }
+    const uint8_t flags = header[RECORD_FLAGS_OFFSET];
+    const uint8_t length = header[RECORD_LENGTH_OFFSET];
+    if (length > CanLogFormat::MAX_PAYLOAD ||
+        std::fread(frame.data.data(), 1, length, m_file) != length) {
+        return false;
+    }
+
+    frame.timestampNs = readLittleEndian<int64_t>(header.data());
+    frame.frameId = readLittleEndian<uint32_t>(&header[RECORD_ID_OFFSET]);
+    frame.extended = (flags & CanLogFormat::FLAG_EXTENDED) != 0;
+    frame.remote = (flags & CanLogFormat::FLAG_REMOTE) != 0;
+    frame.flexibleDataRate = (flags & CanLogFormat::FLAG_FLEXIBLE_DATA_RATE) != 0;
+    frame.bitrateSwitch = (flags & CanLogFormat::FLAG_BITRATE_SWITCH) != 0;
+    frame.length = length;
+    recordSize = CanLogFormat::RECORD_HEADER_SIZE + length;
+    return true;
+}
+
+bool CanLogReader::seekFile(uint64_t offset) {
+    return fseeko(m_file, static_cast<off_t>(offset), SEEK_SET) == 0;
+}
+
+} // namespace devdash
@@ -0,0 +1,119 @@
+#pragma once
+
+#include "CanLogFormat.h"
+#include "ICanLogReader.h"
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace devdash {
+
+/**
+ * @brief Sequential reader with time-based seeking for binary CAN logs
+ *
+ * Reads files written by CanRecorder (CanLogFormat). The time index from the
+ * footer is loaded on open(); logs that were not closed cleanly have none,
+ * so the reader rebuilds it with one scan and stops at the last complete
+ * record.
+ *
+ * @code
+ * CanLogReader reader;
+ * if (!reader.open("session.ddcan")) {
+ *     qWarning() << reader.errorString().c_str();
+ * }
+ * reader.seek(reader.firstTimestampNs() + 60 * NS_PER_SECOND);  // one minute in
+ * RawCanFrame frame;
+ * while (reader.next(frame)) { ... }
+ * @endcode
+ *
+ * @note Not thread-safe.
+ */
+class CanLogReader : public ICanLogReader {
+  public:
+    /// Spacing of index entries rebuilt for logs without a stored index
+    static constexpr int64_t REBUILT_INDEX_INTERVAL_NS = 1000000000;
+
+    CanLogReader() = default;
+    ~CanLogReader() override;
+
+    // Owns a file handle
+    CanLogReader(const CanLogReader&) = delete;
+    CanLogReader& operator=(const CanLogReader&) = delete;
+    CanLogReader(CanLogReader&&) = delete;
+    CanLogReader& operator=(CanLogReader&&) = delete;
+
+    /**
+     * @brief Open a log and load (or rebuild) its index
+     * @return false if the file is missing or not a devdash CAN log, see errorString()
+     */
+    [[nodiscard]] bool open(const std::string& path);
+
+    void close();
+
+    [[nodiscard]] bool isOpen() const { return m_file != nullptr; }
+
+    [[nodiscard]] const std::string& errorString() const { return m_errorString; }
+
+    /**
+     * @brief Interface the log was recorded on
+     */
+    [[nodiscard]] const std::string& interfaceName() const override { return m_interfaceName; }
+
+    /**
+     * @brief Read the next record
+     * @return false at the end of the log (or at a damaged record)
+     */
+    [[nodiscard]] bool next(RawCanFrame& frame) override;
+
+    /**
+     * @brief Position before the first record at or after @p timestampNs
+     *
+     * Jumps to the nearest index entry and reads forward from there.
+     * Timestamps before the log start rewind, past the end reach the end.
+     */
+    void seek(int64_t timestampNs) override;
+
+    /**
+     * @brief Position before the first record
+     */
+    void rewind() override;
+
+    /**
+     * @brief Time index (stored or rebuilt), ascending by timestamp
+     */
+    [[nodiscard]] const std::vector<CanLogFormat::IndexEntry>& index() const { return m_index; }
+
+    /**
+     * @brief Whether the index came from the footer (false: log was cut short)
+     */
+    [[nodiscard]] bool hasStoredIndex() const { return m_hasStoredIndex; }
+
+    /**
+     * @brief Timestamp of the first record, 0 for an empty log
+     */
+    [[nodiscard]] int64_t firstTimestampNs() const override {
+        return m_index.empty() ? 0 : m_index.front().timestampNs;
+    }
+
+  private:
+    bool readHeader();
+    bool loadStoredIndex(uint64_t fileSize);
+    void rebuildIndex(uint64_t fileSize);
+    /// Reads the record at the file position; false at end of file or damage
+    bool readRecord(RawCanFrame& frame, uint64_t& recordSize);
+    bool seekFile(uint64_t offset);
+
+    std::FILE* m_file{nullptr};
+    std::string m_errorString;
+    std::string m_interfaceName;
+
+    std::vector<CanLogFormat::IndexEntry> m_index;
+    bool m_hasStoredIndex{false};
+
+    uint64_t m_recordsEnd{0};  ///< Offset just past the last complete record
+    uint64_t m_position{0};    ///< Offset of the record next() returns
+};
+
+} // namespace devdash
@@ -0,0 +1,384 @@
+/**
+ * @file CanRecorder.cpp
+ * @brief Implementation of the binary CAN log recorder.
+ */
+
+#include "CanRecorder.h"
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cinttypes>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+
+namespace devdash {
+
+namespace {
+
+//=============================================================================
+// Encoding
+//=============================================================================
+
+/// New logs replace an existing file of the same name; rw-r--r--
+constexpr int LOG_OPEN_FLAGS = O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC;
+constexpr mode_t LOG_FILE_MODE = 0644;
+
+constexpr int64_t NS_PER_MS = 1000000;
+constexpr int64_t NS_PER_US = 1000;
+constexpr int64_t NS_PER_SECOND = 1000000000;
+
+constexpr int BITS_PER_BYTE = 8;
+constexpr uint32_t BYTE_MASK = 0xFF;
+
+/// Appends @p value little-endian
+template <typename T> void appendLittleEndian(std::vector<uint8_t>& buffer, T value) {
+    const auto bits = static_cast<uint64_t>(value);
+    for (size_t i = 0; i < sizeof(T); ++i) {
+        buffer.push_back(static_cast<uint8_t>((bits >> (i * BITS_PER_BYTE)) & BYTE_MASK));
+    }
+}
+
+uint8_t recordFlags(const RawCanFrame& frame) {
+    uint8_t flags = 0;
+    flags |= frame.extended ? CanLogFormat::FLAG_EXTENDED : 0;
+    flags |= frame.remote ? CanLogFormat::FLAG_REMOTE : 0;
+    flags |= frame.flexibleDataRate ? CanLogFormat::FLAG_FLEXIBLE_DATA_RATE : 0;
+    flags |= frame.bitrateSwitch ? CanLogFormat::FLAG_BITRATE_SWITCH : 0;
+    return flags;
+}
+
+int64_t realtimeNowNs() {
+    timespec now{};
+    clock_gettime(CLOCK_REALTIME, &now);
+    return static_cast<int64_t>(now.tv_sec) * NS_PER_SECOND + now.tv_nsec;
+}
+
+//=============================================================================
+// candump -L Text
+//=============================================================================
+
+/// Longest line: timestamp, interface, 29-bit ID, "##", flags and 64 data bytes
+constexpr size_t MAX_CANDUMP_LINE = 256;
+
+/// Hex digits of an identifier, as candump prints them
+constexpr int STANDARD_ID_DIGITS = 3;
+constexpr int EXTENDED_ID_DIGITS = 8;
+
+/// candump CAN FD flag nibble for a bit rate switched frame
+constexpr unsigned CANDUMP_FD_FLAG_BRS = 0x1;
+
+constexpr const char* HEX_DIGITS = "0123456789ABCDEF";
+constexpr unsigned NIBBLE_BITS = 4;
+constexpr unsigned NIBBLE_MASK = 0xF;
+
+} // anonymous namespace
+
+//=============================================================================
+// Lifecycle
+//=============================================================================
+
+CanRecorder::~CanRecorder() {
+    stop();
+}
+
+bool CanRecorder::start(const Options& options) {
+    if (isRecording()) {
+        return true;
+    }
+
+    m_options = options;
+    m_errorString.clear();
+    m_writeError.store(false, std::memory_order_relaxed);
+
+    m_logFd = ::open(options.path.c_str(), LOG_OPEN_FLAGS, LOG_FILE_MODE);
+    if (m_logFd < 0) {
+        setError("Cannot create " + options.path, errno);
+        return false;
+    }
+    if (options.candump) {
+        const std::string textPath = options.path + ".log";
+        m_textFd = ::open(textPath.c_str(), LOG_OPEN_FLAGS, LOG_FILE_MODE);
+        if (m_textFd < 0) {
+            setError("Cannot create " + textPath, errno);
+            ::close(m_logFd);
+            m_logFd = -1;
+            return false;
+        }
+    }
+
+    m_ring = std::make_unique<SpscRing<RawCanFrame>>(options.ringCapacity);
+    m_drained.resize(DRAIN_BATCH);
+    m_logBuffer.clear();
+    m_logBuffer.reserve(WRITE_BUFFER_BYTES + CanLogFormat::RECORD_HEADER_SIZE +
+                        CanLogFormat::MAX_PAYLOAD);
+    m_textBuffer.clear();
+    m_index.clear();
+    m_nextIndexNs = 0;
+    m_bufferedFrames = 0;
+    m_logFailed = false;
+    m_logIntact = true;
+    m_recordedFrames.store(0, std::memory_order_relaxed);
+    m_droppedFrames.store(0, std::memory_order_relaxed);
+    m_bytesWritten.store(0, std::memory_order_relaxed);
+    m_lostFrames.store(0, std::memory_order_relaxed);
+
+    // File header
+    m_logBuffer.insert(m_logBuffer.end(), CanLogFormat::FILE_MAGIC.begin(),
+                       CanLogFormat::FILE_MAGIC.end());
+    appendLittleEndian(m_logBuffer, CanLogFormat::VERSION);
+    appendLittleEndian(m_logBuffer, static_cast<uint16_t>(CanLogFormat::FILE_HEADER_SIZE));
+    appendLittleEndian(m_logBuffer, uint32_t{0});
+    std::array<char, CanLogFormat::INTERFACE_NAME_SIZE> name{};
+    std::copy_n(options.interfaceName.begin(),
+                std::min(options.interfaceName.size(), name.size() - 1), name.begin());
+    m_logBuffer.insert(m_logBuffer.end(), name.begin(), name.end());
+    m_fileOffset = m_logBuffer.size();
+
+    {
+        const std::lock_guard lock(m_wakeMutex);
+        m_stopRequested = false;
+    }
+    m_writer = std::thread(&CanRecorder::writerLoop, this);
+    return true;
+}
+
+void CanRecorder::stop() {
+    if (!isRecording()) {
+        return;
+    }
+
+    {
+        const std::lock_guard lock(m_wakeMutex);
+        m_stopRequested = true;
+    }
+    m_wake.notify_one();
+    m_writer.join();
+
+    // The producer is quiet now: pick up frames queued after the last pass
+    drainRing();
+    flushBuffers();
+    // Without a complete header on disk there is nothing to index
+    if (m_logIntact &&
+        m_bytesWritten.load(std::memory_order_relaxed) >= CanLogFormat::FILE_HEADER_SIZE) {
+        writeIndex();
+    }
+    if (!m_logFailed && ::fdatasync(m_logFd) != 0) {
+        setWriteError("fdatasync failed", errno);
+    }
+    ::close(m_logFd);
+    m_logFd = -1;
+    if (m_textFd >= 0) {
+        ::close(m_textFd);
+        m_textFd = -1;
+    }
+    m_ring.reset();
+}
+
+//=============================================================================
+// Receive Path
+//=============================================================================
+
+bool CanRecorder::record(const RawCanFrame& frame) noexcept {
+    if (!m_ring) {
+        return false;
+    }
+    bool queued = false;
+    if (frame.timestampNs != 0) {
+        queued = m_ring->tryPush(frame);
+    } else {
+        RawCanFrame stamped = frame;
+        stamped.timestampNs = realtimeNowNs();
+        queued = m_ring->tryPush(stamped);
+    }
+    if (!queued) {
+        m_droppedFrames.fetch_add(1, std::memory_order_relaxed);
+    }
+    return queued;
+}
+
+//=============================================================================
+// Writer Thread
+//=============================================================================
+
+void CanRecorder::writerLoop() {
+    const auto flushInterval = std::chrono::milliseconds(std::max(m_options.flushIntervalMs, 1));
+    const auto fsyncInterval = std::chrono::milliseconds(m_options.fsyncIntervalMs);
+    auto lastSync = std::chrono::steady_clock::now();
+
+    for (;;) {
+        bool stopping = false;
+        {
+            std::unique_lock lock(m_wakeMutex);
+            m_wake.wait_for(lock, flushInterval, [this] { return m_stopRequested; });
+            stopping = m_stopRequested;
+        }
+
+        drainRing();
+        flushBuffers();
+        if (stopping) {
+            return;
+        }
+
+        const auto now = std::chrono::steady_clock::now();
+        if (!m_logFailed && m_options.fsyncIntervalMs > 0 && now - lastSync >= fsyncInterval) {
+            if (::fdatasync(m_logFd) != 0) {
+                setWriteError("fdatasync failed", errno);
+            }
+            lastSync = now;
+        }
+    }
+}
+
+void CanRecorder::drainRing() {
+    for (;;) {
+        const size_t count = m_ring->popBulk(m_drained.data(), m_drained.size());
+        if (count == 0) {
+            return;
+        }
+        if (m_logFailed) {
+            m_lostFrames.fetch_add(count, std::memory_order_relaxed);
+            continue;
+        }
+        for (size_t i = 0; i < count; ++i) {
+            encode(m_drained[i]);
+            if (m_textFd >= 0) {
+                appendCandumpLine(m_drained[i]);
+            }
+        }
+        m_bufferedFrames += count;
+        if (m_logBuffer.size() >= WRITE_BUFFER_BYTES) {
+            flushBuffers();
+        }
+    }
+}
+
+void CanRecorder::encode(const RawCanFrame& frame) {
+    if (frame.timestampNs >= m_nextIndexNs) {
+        m_index.push_back({frame.timestampNs, m_fileOffset});
+        m_nextIndexNs = frame.timestampNs + m_options.indexIntervalMs * NS_PER_MS;
+    }
+
+    const uint8_t length = std::min(frame.length, CanLogFormat::MAX_PAYLOAD);
+    const size_t before = m_logBuffer.size();
+    appendLittleEndian(m_logBuffer, frame.timestampNs);
+    appendLittleEndian(m_logBuffer, frame.frameId);
+    m_logBuffer.push_back(recordFlags(frame));
+    m_logBuffer.push_back(length);
+    m_logBuffer.insert(m_logBuffer.end(), frame.data.begin(), frame.data.begin() + length);
+    m_fileOffset += m_logBuffer.size() - before;
+}
+
+void CanRecorder::appendCandumpLine(const RawCanFrame& frame) {
+    // (1436509052.249713) can0 360#0102030405060708
+    std::array<char, MAX_CANDUMP_LINE> line{};
+    const int used = std::snprintf(
+        line.data(), line.size(), "(%" PRId64 ".%06" PRId64 ") %s %0*" PRIX32,
+        frame.timestampNs / NS_PER_SECOND, (frame.timestampNs % NS_PER_SECOND) / NS_PER_US,
+        m_options.interfaceName.c_str(), frame.extended ? EXTENDED_ID_DIGITS : STANDARD_ID_DIGITS,
+        frame.frameId);
+    if (used <= 0) {
+        return;
+    }
+    auto position = std::min(static_cast<size_t>(used), line.size() - 1);
+    const auto put = [&line, &position](char character) {
+        if (position < line.size() - 1) {
+            line[position++] = character;
+        }
+    };
+
+    put('#');
+    if (frame.remote) {
+        put('R');
+    } else {
+        if (frame.flexibleDataRate) {
+            put('#');
+            put(HEX_DIGITS[frame.bitrateSwitch ? CANDUMP_FD_FLAG_BRS : 0]);
+        }
+        const uint8_t length = std::min(frame.length, CanLogFormat::MAX_PAYLOAD);
+        for (uint8_t i = 0; i < length; ++i) {
+            put(HEX_DIGITS[(frame.data[i] >> NIBBLE_BITS) & NIBBLE_MASK]);
+            put(HEX_DIGITS[frame.data[i] & NIBBLE_MASK]);
+        }
+    }
+    put('\n');
+    m_textBuffer.append(line.data(), position);
+}
+
+void CanRecorder::flushBuffers() {
+    if (!m_logBuffer.empty()) {
+        if (writeAll(m_logFd, m_logBuffer.data(), m_logBuffer.size())) {
+            m_bytesWritten.fetch_add(m_logBuffer.size(), std::memory_order_relaxed);
+            m_recordedFrames.fetch_add(m_bufferedFrames, std::memory_order_relaxed);
+        } else {
+            abandonLog();
+        }
+        m_logBuffer.clear();
+        m_bufferedFrames = 0;
+    }
+    if (!m_textBuffer.empty()) {
+        writeAll(m_textFd, m_textBuffer.data(), m_textBuffer.size());
+        m_textBuffer.clear();
+    }
+}
+
+void CanRecorder::abandonLog() {
+    // Cut a partly written buffer so the log ends after its last complete
+    // record, and forget index entries that would point past it
+    const uint64_t committed = m_bytesWritten.load(std::memory_order_relaxed);
+    if (::ftruncate(m_logFd, static_cast<off_t>(committed)) != 0 ||
+        ::lseek(m_logFd, static_cast<off_t>(committed), SEEK_SET) < 0) {
+        m_logIntact = false;  // No footer: the reader rebuilds the index from the records
+    }
+    m_fileOffset = committed;
+    std::erase_if(m_index, [committed](const CanLogFormat::IndexEntry& entry) {
+        return entry.offset >= committed;
+    });
+    m_lostFrames.fetch_add(m_bufferedFrames, std::memory_order_relaxed);
+    m_logFailed = true;
+}
+
+void CanRecorder::writeIndex() {
+    const uint64_t indexOffset = m_fileOffset;
+    for (const CanLogFormat::IndexEntry& entry : m_index) {
+        appendLittleEndian(m_logBuffer, entry.timestampNs);
+        appendLittleEndian(m_logBuffer, entry.offset);
+    }
+    m_logBuffer.insert(m_logBuffer.end(), CanLogFormat::INDEX_MAGIC.begin(),
+                       CanLogFormat::INDEX_MAGIC.end());
+    appendLittleEndian(m_logBuffer, indexOffset);
+    appendLittleEndian(m_logBuffer, static_cast<uint64_t>(m_index.size()));
+    flushBuffers();
+}
+
+bool CanRecorder::writeAll(int fd, const void* data, size_t size) {
+    const auto* bytes = static_cast<const uint8_t*>(data);
+    while (size > 0) {
+        const ssize_t written = ::write(fd, bytes, size);
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            setWriteError("write failed", errno);
+            return false;
+        }
+        bytes += written;
+        size -= static_cast<size_t>(written);
+    }
+    return true;
+}
+
+void CanRecorder::setError(const std::string& what, int error) {
+    m_errorString = what + ": " + std::strerror(error);
+}
+
+void CanRecorder::setWriteError(const std::string& what, int error) {
+    m_writeError.store(true, std::memory_order_relaxed);
+    setError(what, error);
+}
+
+} // namespace devdash
@@ -0,0 +1,181 @@
+#pragma once
+
+#include "CanLogFormat.h"
+#include "RawCanSocket.h"
+
+#include "core/threading/SpscRing.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace devdash {
+
+/**
+ * @brief Records received CAN frames to a binary log without slowing the receive path
+ *
+ * record() runs on the adapter's receive path and only copies the frame into
+ * a preallocated lock-free ring (SpscRing). A writer thread wakes every
+ * flushIntervalMs, drains the ring and appends the frames to the log in
+ * large write() calls; fdatasync() runs at most every fsyncIntervalMs.
+ * If the writer falls behind and the ring fills up, frames are dropped and
+ * counted rather than blocking reception.
+ *
+ * A failed write to the binary log ends the recording: the file is cut
+ * back to the last complete write, and stop() still appends the index and
+ * footer for what is on disk, so it stays readable and seekable up to the
+ * failure. Frames received after it are counted as lost.
+ *
+ * Logs use the CanLogFormat layout with a time index every indexIntervalMs
+ * of bus time, which CanLogReader uses to seek. Optionally a candump -L
+ * text copy (".log") is written alongside, readable by can-utils.
+ *
+ * @code
+ * CanRecorder recorder;
+ * CanRecorder::Options options;
+ * options.path = "/var/log/devdash/can0-20250101-120000.ddcan";
+ * options.interfaceName = "can0";
+ * recorder.start(options);
+ * // receive path:
+ * recorder.record(frame);
+ * // on shutdown (index and footer are written here):
+ * recorder.stop();
+ * @endcode
+ *
+ * @note record() must always be called from the same thread, and not
+ *       concurrently with start() or stop().
+ */
+class CanRecorder {
+  public:
+    /// Frames the ring holds (about 0.6 s of a saturated 1 Mbit/s bus per 4096)
+    static constexpr size_t DEFAULT_RING_CAPACITY = 8192;
+
+    /**
+     * @brief Recording settings
+     */
+    struct Options {
+        std::string path;                ///< Binary log to create (truncated if present)
+        std::string interfaceName;       ///< Stored in the header and the candump text
+        bool candump = false;            ///< Also write path + ".log" in candump -L format
+        int flushIntervalMs = 100;       ///< Writer wake-up period
+        int fsyncIntervalMs = 1000;      ///< fdatasync() period, 0 = only when stopping
+        int indexIntervalMs = 1000;      ///< Bus time between index entries
+        size_t ringCapacity = DEFAULT_RING_CAPACITY;
+    };
+
+    CanRecorder() = default;
+    ~CanRecorder();
+
+    // Owns a thread and file descriptors
+    CanRecorder(const CanRecorder&) = delete;
+    CanRecorder& operator=(const CanRecorder&) = delete;
+    CanRecorder(CanRecorder&&) = delete;
+    CanRecorder& operator=(CanRecorder&&) = delete;
+
+    /**
+     * @brief Create the log files and start the writer thread
+     * @return false if a file could not be created, see errorString()
+     */
+    [[nodiscard]] bool start(const Options& options);
+
+    /**
+     * @brief Write everything still queued, append the index and close the files
+     */
+    void stop();
+
+    [[nodiscard]] bool isRecording() const { return m_writer.joinable(); }
+
+    /**
+     * @brief Queue one frame for the log (receive path, never blocks)
+     *
+     * Frames without a timestamp are stamped with the current time.
+     *
+     * @return false if the ring was full and the frame was dropped
+     */
+    bool record(const RawCanFrame& frame) noexcept;
+
+    /** @brief Frames written to the log (stable once stop() returned) */
+    [[nodiscard]] uint64_t recordedFrames() const {
+        return m_recordedFrames.load(std::memory_order_relaxed);
+    }
+
+    /** @brief Frames lost because the ring was full */
+    [[nodiscard]] uint64_t droppedFrames() const {
+        return m_droppedFrames.load(std::memory_order_relaxed);
+    }
+
+    /** @brief Bytes written to the binary log */
+    [[nodiscard]] uint64_t bytesWritten() const {
+        return m_bytesWritten.load(std::memory_order_relaxed);
+    }
+
+    /** @brief Frames not in the log because a write failed */
+    [[nodiscard]] uint64_t lostFrames() const {
+        return m_lostFrames.load(std::memory_order_relaxed);
+    }
+
+    /** @brief Whether a write to the log failed (recording ended there, see lostFrames()) */
+    [[nodiscard]] bool hasWriteError() const {
+        return m_writeError.load(std::memory_order_relaxed);
+    }
+
+    [[nodiscard]] const std::string& path() const { return m_options.path; }
+
+    /**
+     * @brief Description of the last failure (stable once stop() returned)
+     */
+    [[nodiscard]] const std::string& errorString() const { return m_errorString; }
+
+  private:
+    /// Frames popped from the ring per pass
+    static constexpr size_t DRAIN_BATCH = 256;
+    /// Encoded bytes buffered before a write()
+    static constexpr size_t WRITE_BUFFER_BYTES = 64 * 1024;
+
+    void writerLoop();
+    void drainRing();
+    void encode(const RawCanFrame& frame);
+    void appendCandumpLine(const RawCanFrame& frame);
+    void flushBuffers();
+    void abandonLog();
+    void writeIndex();
+    bool writeAll(int fd, const void* data, size_t size);
+    void setError(const std::string& what, int error);
+    void setWriteError(const std::string& what, int error);
+
+    Options m_options;
+    std::unique_ptr<SpscRing<RawCanFrame>> m_ring;
+
+    int m_logFd{-1};
+    int m_textFd{-1};
+    std::thread m_writer;
+
+    std::mutex m_wakeMutex;
+    std::condition_variable m_wake;
+    bool m_stopRequested{false};
+
+    // Writer thread state
+    std::vector<RawCanFrame> m_drained;
+    std::vector<uint8_t> m_logBuffer;
+    std::string m_textBuffer;
+    uint64_t m_fileOffset{0};  ///< Offset of the next record, buffered bytes included
+    uint64_t m_bufferedFrames{0};  ///< Frames in m_logBuffer
+    bool m_logFailed{false};       ///< A log write failed; frames are no longer encoded
+    bool m_logIntact{true};        ///< Log ends on a record boundary (cut back after a failure)
+    std::vector<CanLogFormat::IndexEntry> m_index;
+    int64_t m_nextIndexNs{0};
+
+    std::atomic<uint64_t> m_recordedFrames{0};
+    std::atomic<uint64_t> m_droppedFrames{0};
+    std::atomic<uint64_t> m_bytesWritten{0};
+    std::atomic<uint64_t> m_lostFrames{0};
+    std::atomic<bool> m_writeError{false};
+    std::string m_errorString;
+};
+
+} // namespace devdash
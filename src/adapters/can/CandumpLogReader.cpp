@@ -0,0 +1,324 @@
+/**
+ * @file CandumpLogReader.cpp
+ * @brief Implementation of the candump -L text log reader.
+ */
+
+#include "CandumpLogReader.h"
+
+#include <sys/types.h>
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <charconv>
+#include <cstring>
+#include <iterator>
+
+namespace devdash {
+
+namespace {
+
+//=============================================================================
+// Parsing
+//=============================================================================
+
+constexpr int HEX_BASE = 16;
+constexpr int DECIMAL_BASE = 10;
+constexpr int BITS_PER_NIBBLE = 4;
+
+/// Digits of the fractional seconds that fit in nanoseconds
+constexpr size_t NANOSECOND_DIGITS = 9;
+constexpr int64_t NS_PER_SECOND = 1000000000;
+
+/// Identifier columns of 11-bit frames; longer identifiers are 29-bit
+constexpr size_t STANDARD_ID_DIGITS = 3;
+constexpr size_t EXTENDED_ID_DIGITS = 8;
+constexpr uint32_t MAX_STANDARD_FRAME_ID = 0x7FF;
+
+/// Largest classic CAN payload (and remote request length)
+constexpr uint8_t CLASSIC_MAX_PAYLOAD = 8;
+
+/// CAN FD flags nibble after "##"
+constexpr int FD_FLAG_BITRATE_SWITCH = 0x1;
+
+constexpr char FRAME_SEPARATOR = '#';
+constexpr char BYTE_SEPARATOR = '.';
+constexpr char LENGTH_CODE_SEPARATOR = '_';
+
+std::string_view trim(std::string_view text) {
+    const size_t first = text.find_first_not_of(" \t\r\n");
+    if (first == std::string_view::npos) {
+        return {};
+    }
+    const size_t last = text.find_last_not_of(" \t\r\n");
+    return text.substr(first, last - first + 1);
+}
+
+/// Splits off the next whitespace-separated column
+std::string_view takeColumn(std::string_view& text) {
+    text = trim(text);
+    const size_t end = std::min(text.find_first_of(" \t"), text.size());
+    const std::string_view column = text.substr(0, end);
+    text.remove_prefix(end);
+    return column;
+}
+
+template <typename T> bool parseNumber(std::string_view text, T& value, int base) {
+    if (text.empty()) {
+        return false;
+    }
+    const char* end = text.data() + text.size();
+    const auto [ptr, error] = std::from_chars(text.data(), end, value, base);
+    return error == std::errc{} && ptr == end;
+}
+
+/// "(seconds.fraction)" to nanoseconds
+bool parseTimestamp(std::string_view text, int64_t& timestampNs) {
+    if (text.size() < 2 || text.front() != '(' || text.back() != ')') {
+        return false;
+    }
+    text = text.substr(1, text.size() - 2);
+    const size_t dot = text.find('.');
+    int64_t seconds = 0;
+    if (!parseNumber(text.substr(0, dot), seconds, DECIMAL_BASE)) {
+        return false;
+    }
+    int64_t fractionNs = 0;
+    if (dot != std::string_view::npos) {
+        const std::string_view fraction = text.substr(dot + 1).substr(0, NANOSECOND_DIGITS);
+        if (!parseNumber(fraction, fractionNs, DECIMAL_BASE)) {
+            return false;
+        }
+        for (size_t i = fraction.size(); i < NANOSECOND_DIGITS; ++i) {
+            fractionNs *= DECIMAL_BASE;
+        }
+    }
+    timestampNs = seconds * NS_PER_SECOND + fractionNs;
+    return true;
+}
+
+int hexDigit(char c) {
+    if (c >= '0' && c <= '9') {
+        return c - '0';
+    }
+    if (c >= 'A' && c <= 'F') {
+        return c - 'A' + DECIMAL_BASE;
+    }
+    if (c >= 'a' && c <= 'f') {
+        return c - 'a' + DECIMAL_BASE;
+    }
+    return -1;
+}
+
+/// Hex payload ("0102..", bytes optionally separated by '.') into the frame
+bool parsePayload(std::string_view text, RawCanFrame& frame, uint8_t maxLength) {
+    text = text.substr(0, text.find(LENGTH_CODE_SEPARATOR));
+    uint8_t length = 0;
+    size_t i = 0;
+    while (i < text.size()) {
+        if (text[i] == BYTE_SEPARATOR) {
+            ++i;
+            continue;
+        }
+        if (i + 1 >= text.size() || length >= maxLength) {
+            return false;
+        }
+        const int high = hexDigit(text[i]);
+        const int low = hexDigit(text[i + 1]);
+        if (high < 0 || low < 0) {
+            return false;
+        }
+        frame.data[length++] = static_cast<uint8_t>((high << BITS_PER_NIBBLE) | low);
+        i += 2;
+    }
+    frame.length = length;
+    return true;
+}
+
+} // anonymous namespace
+
+//=============================================================================
+// Lifecycle
+//=============================================================================
+
+CandumpLogReader::~CandumpLogReader() {
+    close();
+}
+
+bool CandumpLogReader::open(const std::string& path) {
+    close();
+    m_errorString.clear();
+
+    m_file = std::fopen(path.c_str(), "re");
+    if (m_file == nullptr) {
+        m_errorString = "Cannot open " + path + ": " + std::strerror(errno);
+        return false;
+    }
+
+    RawCanFrame frame;
+    uint64_t lineOffset = 0;
+    int64_t nextIndexNs = 0;
+    while (readFrame(frame, lineOffset)) {
+        if (m_index.empty() || frame.timestampNs >= nextIndexNs) {
+            m_index.push_back({frame.timestampNs, lineOffset});
+            nextIndexNs = frame.timestampNs + INDEX_INTERVAL_NS;
+        }
+    }
+    m_invalidLines = m_skippedLines;
+    if (m_index.empty()) {
+        m_errorString = "No candump frames in " + path;
+        close();
+        return false;
+    }
+    rewind();
+    return true;
+}
+
+void CandumpLogReader::close() {
+    if (m_file != nullptr) {
+        std::fclose(m_file);
+        m_file = nullptr;
+    }
+    m_interfaceName.clear();
+    m_index.clear();
+    m_invalidLines = 0;
+    m_skippedLines = 0;
+}
+
+//=============================================================================
+// Reading
+//=============================================================================
+
+bool CandumpLogReader::next(RawCanFrame& frame) {
+    uint64_t lineOffset = 0;
+    return m_file != nullptr && readFrame(frame, lineOffset);
+}
+
+void CandumpLogReader::seek(int64_t timestampNs) {
+    if (m_file == nullptr) {
+        return;
+    }
+
+    // Last index entry at or before the target
+    const auto after = std::upper_bound(
+        m_index.begin(), m_index.end(), timestampNs,
+        [](int64_t value, const CanLogFormat::IndexEntry& entry) {
+            return value < entry.timestampNs;
+        });
+    seekFile(after == m_index.begin() ? 0 : std::prev(after)->offset);
+
+    RawCanFrame frame;
+    uint64_t lineOffset = 0;
+    while (readFrame(frame, lineOffset)) {
+        if (frame.timestampNs >= timestampNs) {
+            seekFile(lineOffset);
+            return;
+        }
+    }
+}
+
+void CandumpLogReader::rewind() {
+    if (m_file != nullptr) {
+        seekFile(0);
+    }
+}
+
+bool CandumpLogReader::parseLine(std::string_view line, RawCanFrame& frame,
+                                 std::string* interfaceName) {
+    int64_t timestampNs = 0;
+    if (!parseTimestamp(takeColumn(line), timestampNs)) {
+        return false;
+    }
+    const std::string_view interfaceColumn = takeColumn(line);
+    // A trailing direction column ("R"/"T", candump -x) is ignored
+    const std::string_view frameColumn = takeColumn(line);
+
+    const size_t separator = frameColumn.find(FRAME_SEPARATOR);
+    if (interfaceColumn.empty() || separator == std::string_view::npos) {
+        return false;
+    }
+    const std::string_view idText = frameColumn.substr(0, separator);
+    uint32_t frameId = 0;
+    if (idText.size() > EXTENDED_ID_DIGITS || !parseNumber(idText, frameId, HEX_BASE)) {
+        return false;
+    }
+    const bool extended = idText.size() > STANDARD_ID_DIGITS;
+    const uint32_t maxFrameId = extended ? CAN_EFF_MASK : MAX_STANDARD_FRAME_ID;
+    if ((frameId & CAN_ERR_FLAG) != 0 || frameId > maxFrameId) {
+        return false;  // Error frames carry no protocol data
+    }
+
+    frame = RawCanFrame{};
+    frame.frameId = frameId;
+    frame.extended = extended;
+    frame.timestampNs = timestampNs;
+
+    std::string_view payload = frameColumn.substr(separator + 1);
+    if (!payload.empty() && payload.front() == FRAME_SEPARATOR) {
+        // CAN FD: "##<flags><data>"
+        const int flags = payload.size() > 1 ? hexDigit(payload[1]) : -1;
+        if (flags < 0) {
+            return false;
+        }
+        frame.flexibleDataRate = true;
+        frame.bitrateSwitch = (flags & FD_FLAG_BITRATE_SWITCH) != 0;
+        payload.remove_prefix(2);
+        if (!parsePayload(payload, frame, RawCanFrame::MAX_PAYLOAD)) {
+            return false;
+        }
+    } else if (!payload.empty() && (payload.front() == 'R' || payload.front() == 'r')) {
+        // Remote request, optionally with its length: "R" or "R<len>"
+        frame.remote = true;
+        payload.remove_prefix(1);
+        uint8_t length = 0;
+        if (!payload.empty() &&
+            (!parseNumber(payload, length, DECIMAL_BASE) || length > CLASSIC_MAX_PAYLOAD)) {
+            return false;
+        }
+        frame.length = length;
+    } else if (!parsePayload(payload, frame, CLASSIC_MAX_PAYLOAD)) {
+        return false;
+    }
+
+    if (interfaceName != nullptr) {
+        interfaceName->assign(interfaceColumn);
+    }
+    return true;
+}
+
+//=============================================================================
+// File Access
+//=============================================================================
+
+bool CandumpLogReader::readFrame(RawCanFrame& frame, uint64_t& lineOffset) {
+    std::array<char, LINE_BUFFER_SIZE> line{};
+    while (true) {
+        lineOffset = static_cast<uint64_t>(ftello(m_file));
+        if (std::fgets(line.data(), static_cast<int>(line.size()), m_file) == nullptr) {
+            return false;
+        }
+        const std::string_view text(line.data());
+        if (!text.empty() && text.back() != '\n' && std::feof(m_file) == 0) {
+            // Too long for any frame: skip the rest of the line
+            int c = 0;
+            while ((c = std::fgetc(m_file)) != EOF && c != '\n') {
+            }
+            ++m_skippedLines;
+            continue;
+        }
+        if (trim(text).empty()) {
+            continue;
+        }
+        std::string* name = m_interfaceName.empty() ? &m_interfaceName : nullptr;
+        if (parseLine(text, frame, name)) {
+            return true;
+        }
+        ++m_skippedLines;
+    }
+}
+
+bool CandumpLogReader::seekFile(uint64_t offset) {
+    return fseeko(m_file, static_cast<off_t>(offset), SEEK_SET) == 0;
+}
+
+} // namespace devdash
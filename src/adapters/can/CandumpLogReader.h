@@ -0,0 +1,117 @@
+#pragma once
+
+#include "CanLogFormat.h"
+#include "ICanLogReader.h"
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace devdash {
+
+/**
+ * @brief Sequential reader with time-based seeking for candump -L text logs
+ *
+ * Reads the log format of can-utils `candump -L` (and CanRecorder's
+ * "candump" copy), one frame per line:
+ *
+ * @code
+ * (1735732800.000000) can0 360#0DAC03E8
+ * (1735732800.000100) can0 18FF0001#0102
+ * (1735732800.000200) can0 360#R
+ * (1735732800.000300) can0 360##10102030405060708090A0B0C
+ * @endcode
+ *
+ * open() scans the file once and builds a time index (one entry per
+ * INDEX_INTERVAL_NS of bus time) so seek() does not rescan from the start.
+ * Frames are read from the file as they are needed, so long sessions do
+ * not have to fit in memory. Error frames and lines that do not parse are
+ * skipped.
+ *
+ * @note Not thread-safe.
+ */
+class CandumpLogReader : public ICanLogReader {
+  public:
+    /// Spacing of the index built on open()
+    static constexpr int64_t INDEX_INTERVAL_NS = 1000000000;
+
+    CandumpLogReader() = default;
+    ~CandumpLogReader() override;
+
+    // Owns a file handle
+    CandumpLogReader(const CandumpLogReader&) = delete;
+    CandumpLogReader& operator=(const CandumpLogReader&) = delete;
+    CandumpLogReader(CandumpLogReader&&) = delete;
+    CandumpLogReader& operator=(CandumpLogReader&&) = delete;
+
+    /**
+     * @brief Open a log and build its index
+     * @return false if the file is missing or holds no candump frame, see errorString()
+     */
+    [[nodiscard]] bool open(const std::string& path);
+
+    void close();
+
+    [[nodiscard]] bool isOpen() const { return m_file != nullptr; }
+
+    [[nodiscard]] const std::string& errorString() const { return m_errorString; }
+
+    /**
+     * @brief Interface named on the first frame line
+     */
+    [[nodiscard]] const std::string& interfaceName() const override { return m_interfaceName; }
+
+    [[nodiscard]] bool next(RawCanFrame& frame) override;
+
+    /**
+     * @brief Position before the first frame at or after @p timestampNs
+     *
+     * Jumps to the nearest index entry and reads forward from there.
+     */
+    void seek(int64_t timestampNs) override;
+
+    void rewind() override;
+
+    [[nodiscard]] int64_t firstTimestampNs() const override {
+        return m_index.empty() ? 0 : m_index.front().timestampNs;
+    }
+
+    /**
+     * @brief Time index built on open(), ascending by timestamp
+     */
+    [[nodiscard]] const std::vector<CanLogFormat::IndexEntry>& index() const { return m_index; }
+
+    /**
+     * @brief Lines skipped on open() because they did not parse
+     */
+    [[nodiscard]] uint64_t invalidLines() const { return m_invalidLines; }
+
+    /**
+     * @brief Parse one candump -L line
+     * @param line Line without trailing newline
+     * @param frame Receives the frame
+     * @param interfaceName If not null, receives the interface column
+     * @return false for malformed lines and error frames
+     */
+    [[nodiscard]] static bool parseLine(std::string_view line, RawCanFrame& frame,
+                                        std::string* interfaceName = nullptr);
+
+  private:
+    /// Longest line accepted: CAN FD frame with a long interface name
+    static constexpr size_t LINE_BUFFER_SIZE = 256;
+
+    /// Reads lines until one parses; @p lineOffset receives its file offset
+    bool readFrame(RawCanFrame& frame, uint64_t& lineOffset);
+    bool seekFile(uint64_t offset);
+
+    std::FILE* m_file{nullptr};
+    std::string m_errorString;
+    std::string m_interfaceName;
+    std::vector<CanLogFormat::IndexEntry> m_index;
+    uint64_t m_invalidLines{0};
+    uint64_t m_skippedLines{0};  ///< Lines skipped so far, rescans included
+};
+
+} // namespace devdash
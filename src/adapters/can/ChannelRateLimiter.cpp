@@ -0,0 +1,76 @@
+/**
+ * @file ChannelRateLimiter.cpp
+ * @brief Implementation of per-channel emission rate caps.
+ */
+
+#include "ChannelRateLimiter.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace devdash {
+
+namespace {
+
+constexpr double MS_PER_SECOND = 1000.0;
+
+} // anonymous namespace
+
+void ChannelRateLimiter::setLimit(const QString& channelName, double maxHz) {
+    if (maxHz <= 0.0) {
+        m_limits.remove(channelName);
+        return;
+    }
+
+    Limit limit;
+    limit.intervalMs = std::max<qint64>(1, std::llround(MS_PER_SECOND / maxHz));
+    m_limits.insert(channelName, limit);
+}
+
+qint64 ChannelRateLimiter::shortestIntervalMs() const {
+    qint64 shortest = 0;
+    for (const auto& limit : m_limits) {
+        if (shortest == 0 || limit.intervalMs < shortest) {
+            shortest = limit.intervalMs;
+        }
+    }
+    return shortest;
+}
+
+bool ChannelRateLimiter::admit(const QString& channelName, const ChannelValue& value,
+                               qint64 nowMs) {
+    auto it = m_limits.find(channelName);
+    if (it == m_limits.end()) {
+        return true;
+    }
+
+    Limit& limit = it.value();
+    if (nowMs < limit.nextAllowedMs) {
+        // Latest wins: a newer value replaces the one held back
+        if (limit.hasPending) {
+            ++m_dropped;
+        }
+        limit.pending = value;
+        limit.hasPending = true;
+        return false;
+    }
+
+    limit.nextAllowedMs = nowMs + limit.intervalMs;
+    limit.hasPending = false;
+    return true;
+}
+
+std::vector<std::pair<QString, ChannelValue>> ChannelRateLimiter::takeDue(qint64 nowMs) {
+    std::vector<std::pair<QString, ChannelValue>> released;
+    for (auto it = m_limits.begin(); it != m_limits.end(); ++it) {
+        Limit& limit = it.value();
+        if (limit.hasPending && nowMs >= limit.nextAllowedMs) {
+            limit.nextAllowedMs = nowMs + limit.intervalMs;
+            limit.hasPending = false;
+            released.emplace_back(it.key(), limit.pending);
+        }
+    }
+    return released;
+}
+
+} // namespace devdash
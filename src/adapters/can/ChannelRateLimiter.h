@@ -0,0 +1,100 @@
+#pragma once
+
+#include "core/interfaces/IProtocolAdapter.h"
+
+#include <QHash>
+#include <QString>
+
+#include <utility>
+#include <vector>
+
+namespace devdash {
+
+/**
+ * @brief Caps how often individual channels are emitted
+ *
+ * A frame usually carries several channels; FrameRouter rate limits apply
+ * to the whole frame. Channel limits cap a single channel instead (e.g. a
+ * slowly-changing temperature broadcast in a fast frame) without touching
+ * the others.
+ *
+ * Values arriving inside a channel's cap interval are held back; only the
+ * newest one is kept ("latest wins") and released by takeDue() once the
+ * interval has elapsed.
+ *
+ * @code
+ * ChannelRateLimiter limiter;
+ * limiter.setLimit("Coolant Temperature", 5.0);
+ *
+ * if (limiter.admit(name, value, nowMs)) {
+ *     emit channelUpdated(name, value);
+ * }
+ * for (const auto& [name, value] : limiter.takeDue(nowMs)) { ... }
+ * @endcode
+ *
+ * @note Not thread-safe; used by the adapter's receive path.
+ */
+class ChannelRateLimiter {
+  public:
+    /**
+     * @brief Cap the emission rate of a channel
+     *
+     * @param channelName Decoded channel name
+     * @param maxHz Maximum emission rate; 0 or less removes the cap
+     */
+    void setLimit(const QString& channelName, double maxHz);
+
+    /**
+     * @brief Remove all caps and held-back values
+     */
+    void clear() { m_limits.clear(); }
+
+    /**
+     * @brief Check whether any channel is capped
+     */
+    [[nodiscard]] bool isEmpty() const { return m_limits.isEmpty(); }
+
+    /**
+     * @brief Shortest configured cap interval in milliseconds (0 if none)
+     */
+    [[nodiscard]] qint64 shortestIntervalMs() const;
+
+    /**
+     * @brief Decide whether a value may be emitted now
+     *
+     * @param channelName Decoded channel name
+     * @param value Decoded value (held back if not admitted)
+     * @param nowMs Monotonic time in milliseconds
+     * @return true to emit the value now, false if it is held back
+     */
+    [[nodiscard]] bool admit(const QString& channelName, const ChannelValue& value, qint64 nowMs);
+
+    /**
+     * @brief Release held-back values whose cap interval has elapsed
+     *
+     * @param nowMs Monotonic time in milliseconds
+     * @return Released (channel name, value) pairs
+     */
+    [[nodiscard]] std::vector<std::pair<QString, ChannelValue>> takeDue(qint64 nowMs);
+
+    /**
+     * @brief Number of values replaced by a newer one before they were emitted
+     */
+    [[nodiscard]] quint64 droppedCount() const { return m_dropped; }
+
+  private:
+    /**
+     * @brief Cap state for one channel
+     */
+    struct Limit {
+        qint64 intervalMs = 0;
+        qint64 nextAllowedMs = 0;  ///< Earliest time the next value may be emitted
+        ChannelValue pending;      ///< Newest value held back by the cap
+        bool hasPending = false;
+    };
+
+    QHash<QString, Limit> m_limits;
+    quint64 m_dropped = 0;
+};
+
+} // namespace devdash
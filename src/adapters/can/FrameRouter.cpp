@@ -0,0 +1,408 @@
+/**
+ * @file FrameRouter.cpp
+ * @brief Implementation of bus-level CAN frame dispatch.
+ */
+
+#include "FrameRouter.h"
+
+#include <QDebug>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <iterator>
+
+namespace devdash {
+
+namespace {
+
+//=============================================================================
+// Rate Limit Constants
+//=============================================================================
+
+constexpr double MS_PER_SECOND = 1000.0;
+
+/// Events per second over a span of milliseconds (0 if the span is empty)
+double measuredRate(quint64 events, qint64 firstMs, qint64 lastMs) {
+    if (events < 2 || lastMs <= firstMs) {
+        return 0.0;
+    }
+    return static_cast<double>(events - 1) * MS_PER_SECOND / static_cast<double>(lastMs - firstMs);
+}
+
+} // anonymous namespace
+
+FrameRouter::FrameRouter() {
+    m_clock.start();
+}
+
+//=============================================================================
+// Registration
+//=============================================================================
+
+int FrameRouter::addDecoder(const IFrameDecoder* decoder) {
+    if (decoder == nullptr) {
+        return 0;
+    }
+
+    int routed = 0;
+    for (const FrameKey& key : decoder->claimedFrames()) {
+        const IFrameDecoder* existing = lookup(key.frameId, key.extended);
+        if (existing == decoder) {
+            continue;
+        }
+        if (existing != nullptr) {
+            qWarning() << "FrameRouter: Frame ID" << Qt::hex << key.frameId
+                       << "already claimed by another decoder - ignoring duplicate";
+            continue;
+        }
+
+        PayloadCacheEntry cacheEntry;
+        cacheEntry.key = key;
+        Route route{decoder, static_cast<int>(m_payloadCache.size())};
+        route.multiplexed = decoder->isMultiplexed(key);
+        m_payloadCache.push_back(cacheEntry);
+
+        if (!key.extended && key.frameId < STANDARD_ID_COUNT) {
+            m_standardRoutes[key.frameId] = route;
+        } else {
+            m_extendedRoutes.insert(key.frameId, route);
+        }
+        ++routed;
+    }
+
+    m_routeCount += routed;
+    qDebug() << "FrameRouter: Routed" << routed << "frame IDs," << m_routeCount << "total";
+    return routed;
+}
+
+void FrameRouter::clear() {
+    m_standardRoutes.fill(Route{});
+    m_extendedRoutes.clear();
+    m_payloadCache.clear();
+    m_payloadCacheHits = 0;
+    m_rateGates.clear();
+    m_activeRateGates = 0;
+    m_standardUnclaimed.fill(0);
+    m_extendedUnclaimed.clear();
+    m_unclaimedTotal = 0;
+    m_routeCount = 0;
+}
+
+std::vector<FrameKey> FrameRouter::routedFrames() const {
+    // One cache slot per route
+    std::vector<FrameKey> frames;
+    frames.reserve(m_payloadCache.size());
+    for (const auto& entry : m_payloadCache) {
+        frames.push_back(entry.key);
+    }
+    return frames;
+}
+
+//=============================================================================
+// Dispatch
+//=============================================================================
+
+const FrameRouter::Route* FrameRouter::findRoute(uint32_t frameId, bool extended) const {
+    if (!extended && frameId < STANDARD_ID_COUNT) {
+        const Route& route = m_standardRoutes[frameId];
+        return route.decoder != nullptr ? &route : nullptr;
+    }
+    auto it = m_extendedRoutes.constFind(frameId);
+    return it != m_extendedRoutes.constEnd() ? &it.value() : nullptr;
+}
+
+FrameRouter::Route* FrameRouter::findRoute(uint32_t frameId, bool extended) {
+    if (!extended && frameId < STANDARD_ID_COUNT) {
+        Route& route = m_standardRoutes[frameId];
+        return route.decoder != nullptr ? &route : nullptr;
+    }
+    auto it = m_extendedRoutes.find(frameId);
+    return it != m_extendedRoutes.end() ? &it.value() : nullptr;
+}
+
+std::vector<std::pair<QString, ChannelValue>> FrameRouter::decode(const QCanBusFrame& frame,
+                                                                  qint64 nowMs) {
+    const uint32_t frameId = frame.frameId();
+    const bool extended = frame.hasExtendedFrameFormat();
+
+    const Route* route = findRoute(frameId, extended);
+    if (route == nullptr) {
+        recordUnclaimed(frameId, extended);
+        return {};
+    }
+
+    const int64_t muxValue = route->multiplexed ? route->decoder->multiplexValue(frame) : 0;
+    if (route->gateSlot >= 0) {
+        RateGate& gate = m_rateGates[static_cast<size_t>(route->gateSlot)];
+        if (gate.limitHz > 0.0) {
+            const qint64 now = resolveNow(nowMs);
+            if (gate.firstReceivedMs < 0) {
+                gate.firstReceivedMs = now;
+            }
+            gate.lastReceivedMs = now;
+            ++gate.received;
+
+            RatePage* page = findPage(gate, muxValue);
+            if (page != nullptr) {
+                if (now < page->nextAllowedMs) {
+                    // Latest wins within a page: a newer frame replaces the one
+                    // held back. The payload may wrap the native receive ring,
+                    // so keep a copy
+                    page->pending = frame;
+                    page->pending.setPayload(
+                        QByteArray(frame.payload().constData(), frame.payload().size()));
+                    page->hasPending = true;
+                    return {};
+                }
+                page->nextAllowedMs = now + gate.intervalMs;
+                page->hasPending = false;
+            }
+
+            if (gate.firstDecodedMs < 0) {
+                gate.firstDecodedMs = now;
+            }
+            gate.lastDecodedMs = now;
+            ++gate.decoded;
+        }
+    }
+
+    return decodeRoute(*route, frame, muxValue);
+}
+
+std::vector<std::pair<QString, ChannelValue>>
+FrameRouter::decodeRoute(const Route& route, const QCanBusFrame& frame, int64_t muxValue) {
+    if (m_payloadCacheEnabled && isUnchangedPayload(route.cacheSlot, muxValue, frame.payload())) {
+        return {};
+    }
+    return route.decoder->decode(frame);
+}
+
+qint64 FrameRouter::resolveNow(qint64 nowMs) const {
+    return nowMs == CLOCK_NOW ? m_clock.elapsed() : nowMs;
+}
+
+//=============================================================================
+// Unchanged-Payload Cache
+//=============================================================================
+
+bool FrameRouter::isUnchangedPayload(int cacheSlot, int64_t muxValue,
+                                     const QByteArray& payload) {
+    PayloadCacheEntry& entry = m_payloadCache[static_cast<size_t>(cacheSlot)];
+    PayloadPage* page = findPayloadPage(entry, muxValue);
+    if (page == nullptr) {
+        ++entry.misses;
+        return false;
+    }
+
+    const int length = static_cast<int>(std::min<qsizetype>(payload.size(), MAX_CACHED_PAYLOAD));
+    const int wordCount = (length + static_cast<int>(sizeof(uint64_t)) - 1) /
+                          static_cast<int>(sizeof(uint64_t));
+
+    // Zero-padded copy so trailing bytes of a partial word compare equal
+    std::array<uint64_t, PAYLOAD_WORDS> incoming{};
+    std::memcpy(incoming.data(), payload.constData(), static_cast<size_t>(length));
+
+    if (length == page->length &&
+        std::equal(incoming.begin(), incoming.begin() + wordCount, page->words.begin())) {
+        ++entry.hits;
+        ++m_payloadCacheHits;
+        return true;
+    }
+
+    std::copy(incoming.begin(), incoming.begin() + wordCount, page->words.begin());
+    page->length = length;
+    ++entry.misses;
+    return false;
+}
+
+FrameRouter::PayloadPage* FrameRouter::findPayloadPage(PayloadCacheEntry& entry,
+                                                       int64_t muxValue) {
+    for (auto& page : entry.pages) {
+        if (page.muxValue == muxValue) {
+            return &page;
+        }
+    }
+    if (entry.pages.size() >= MAX_PAYLOAD_PAGES) {
+        return nullptr;
+    }
+    PayloadPage page;
+    page.muxValue = muxValue;
+    entry.pages.push_back(page);
+    return &entry.pages.back();
+}
+
+void FrameRouter::invalidatePayloadCache() {
+    for (auto& entry : m_payloadCache) {
+        for (auto& page : entry.pages) {
+            page.length = -1;
+        }
+    }
+}
+
+std::vector<FrameRouter::PayloadCacheStats> FrameRouter::payloadCacheStats() const {
+    std::vector<PayloadCacheStats> stats;
+    for (const auto& entry : m_payloadCache) {
+        if (entry.hits + entry.misses > 0) {
+            stats.push_back({entry.key, entry.hits, entry.misses});
+        }
+    }
+    return stats;
+}
+
+//=============================================================================
+// Rate Limits
+//=============================================================================
+
+bool FrameRouter::setFrameRateLimit(const FrameKey& key, double maxHz) {
+    Route* route = findRoute(key.frameId, key.extended);
+    if (route == nullptr) {
+        qWarning() << "FrameRouter: Cannot rate-limit unrouted frame ID" << Qt::hex << key.frameId;
+        return false;
+    }
+
+    const double limitHz = maxHz > 0.0 ? maxHz : 0.0;
+    if (route->gateSlot < 0) {
+        if (limitHz == 0.0) {
+            return true;
+        }
+        route->gateSlot = static_cast<int>(m_rateGates.size());
+        m_rateGates.push_back(RateGate{});
+    }
+
+    RateGate& gate = m_rateGates[static_cast<size_t>(route->gateSlot)];
+    const bool wasActive = gate.limitHz > 0.0;
+    gate = RateGate{};
+    gate.key = key;
+    gate.limitHz = limitHz;
+    gate.declaredHz = route->decoder->declaredRateHz(key);
+    if (limitHz > 0.0) {
+        gate.intervalMs = std::max<qint64>(1, std::llround(MS_PER_SECOND / limitHz));
+    }
+    m_activeRateGates += (limitHz > 0.0 ? 1 : 0) - (wasActive ? 1 : 0);
+
+    if (limitHz > 0.0 && gate.declaredHz > 0.0 && limitHz >= gate.declaredHz) {
+        qWarning() << "FrameRouter: Rate limit" << limitHz << "Hz for frame ID" << Qt::hex
+                   << key.frameId << Qt::dec << "is not below its declared" << gate.declaredHz
+                   << "Hz - no frames will be dropped";
+    }
+    return true;
+}
+
+FrameRouter::RatePage* FrameRouter::findPage(RateGate& gate, int64_t muxValue) {
+    for (auto& page : gate.pages) {
+        if (page.muxValue == muxValue) {
+            return &page;
+        }
+    }
+    if (gate.pages.size() >= MAX_RATE_PAGES) {
+        return nullptr;
+    }
+    RatePage page;
+    page.muxValue = muxValue;
+    gate.pages.push_back(page);
+    return &gate.pages.back();
+}
+
+qint64 FrameRouter::shortestRateLimitIntervalMs() const {
+    qint64 shortest = 0;
+    for (const auto& gate : m_rateGates) {
+        if (gate.limitHz > 0.0 && (shortest == 0 || gate.intervalMs < shortest)) {
+            shortest = gate.intervalMs;
+        }
+    }
+    return shortest;
+}
+
+std::vector<std::pair<QString, ChannelValue>> FrameRouter::flushPending(qint64 nowMs) {
+    std::vector<std::pair<QString, ChannelValue>> results;
+    if (m_activeRateGates == 0) {
+        return results;
+    }
+
+    const qint64 now = resolveNow(nowMs);
+    for (auto& gate : m_rateGates) {
+        for (auto& page : gate.pages) {
+            if (!page.hasPending || now < page.nextAllowedMs) {
+                continue;
+            }
+
+            const Route* route = findRoute(gate.key.frameId, gate.key.extended);
+            page.hasPending = false;
+            page.nextAllowedMs = now + gate.intervalMs;
+            gate.lastDecodedMs = now;
+            ++gate.decoded;
+
+            auto channels = decodeRoute(*route, page.pending, page.muxValue);
+            results.insert(results.end(), std::make_move_iterator(channels.begin()),
+                           std::make_move_iterator(channels.end()));
+        }
+    }
+    return results;
+}
+
+std::vector<FrameRouter::RateLimitStats> FrameRouter::rateLimitStats() const {
+    std::vector<RateLimitStats> stats;
+    for (const auto& gate : m_rateGates) {
+        if (gate.limitHz <= 0.0) {
+            continue;
+        }
+        RateLimitStats entry;
+        entry.key = gate.key;
+        entry.declaredHz = gate.declaredHz;
+        entry.limitHz = gate.limitHz;
+        entry.receivedHz = measuredRate(gate.received, gate.firstReceivedMs, gate.lastReceivedMs);
+        entry.decodedHz = measuredRate(gate.decoded, gate.firstDecodedMs, gate.lastDecodedMs);
+        entry.received = gate.received;
+        entry.decoded = gate.decoded;
+        stats.push_back(entry);
+    }
+    return stats;
+}
+
+//=============================================================================
+// Unclaimed Statistics
+//=============================================================================
+
+void FrameRouter::recordUnclaimed(uint32_t frameId, bool extended) {
+    ++m_unclaimedTotal;
+
+    quint64 count = 0;
+    if (!extended && frameId < STANDARD_ID_COUNT) {
+        count = ++m_standardUnclaimed[frameId];
+    } else {
+        auto it = m_extendedUnclaimed.find(frameId);
+        if (it != m_extendedUnclaimed.end()) {
+            count = ++it.value();
+        } else if (m_extendedUnclaimed.size() < MAX_TRACKED_EXTENDED_IDS) {
+            m_extendedUnclaimed.insert(frameId, 1);
+            count = 1;
+        }
+    }
+
+    if (count == 1) {
+        qDebug() << "FrameRouter: Unclaimed frame ID" << Qt::hex << frameId
+                 << (extended ? "(extended)" : "");
+    }
+}
+
+std::vector<FrameRouter::UnclaimedFrame> FrameRouter::unclaimedFrames() const {
+    std::vector<UnclaimedFrame> frames;
+
+    for (uint32_t frameId = 0; frameId < STANDARD_ID_COUNT; ++frameId) {
+        if (m_standardUnclaimed[frameId] > 0) {
+            frames.push_back({FrameKey{frameId, false}, m_standardUnclaimed[frameId]});
+        }
+    }
+    for (auto it = m_extendedUnclaimed.cbegin(); it != m_extendedUnclaimed.cend(); ++it) {
+        frames.push_back({FrameKey{it.key(), true}, it.value()});
+    }
+
+    std::sort(frames.begin(), frames.end(),
+              [](const UnclaimedFrame& lhs, const UnclaimedFrame& rhs) {
+                  return lhs.count > rhs.count;
+              });
+    return frames;
+}
+
+} // namespace devdash
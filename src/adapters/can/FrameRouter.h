@@ -0,0 +1,357 @@
+#pragma once
+
+#include "IFrameDecoder.h"
+
+#include <QCanBusFrame>
+#include <QElapsedTimer>
+#include <QHash>
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+namespace devdash {
+
+/**
+ * @brief Bus-level dispatch of CAN frames to protocol decoders
+ *
+ * Several protocols share one bus (Haltech ECU broadcast, PD16 modules,
+ * third-party DBC devices). The router maps every claimed frame ID to its
+ * decoder once, at registration time:
+ *
+ * - 11-bit IDs: direct-indexed table of 2048 entries, one array load per frame
+ * - 29-bit IDs: hash lookup
+ *
+ * The per-frame cost is therefore independent of how many protocols are
+ * registered. Frames nobody claimed are counted per ID so unknown traffic on
+ * the bus can be identified.
+ *
+ * ## Unchanged-payload cache
+ *
+ * ECUs repeat identical payloads at full rate while idling. Each route owns
+ * a cache slot holding the last payload (up to 64 bytes, as 64-bit words);
+ * a frame whose payload matches is not decoded at all and decode() returns
+ * an empty result, so nothing is re-emitted. Classic CAN frames compare in a
+ * single word. Multiplexed frames (IFrameDecoder::isMultiplexed()) keep the
+ * last payload of each mux page, so alternating PD16 status pages or DBC mux
+ * groups still hit. Hits and misses are counted per ID.
+ *
+ * ## Rate limits
+ *
+ * A frame ID can be capped to a maximum decode rate. Frames arriving
+ * inside the cap interval are not decoded; the newest one is kept as
+ * pending and decoded by flushPending() once the interval has elapsed
+ * ("latest wins"), so a capped channel is never left showing stale data.
+ * Multiplexed frames are capped per mux page: a PD16 status page never
+ * replaces a held-back page of other IOs.
+ *
+ * @code
+ * FrameRouter router;
+ * router.addDecoder(&haltechProtocol);
+ * router.addDecoder(&pd16Protocol);
+ *
+ * auto channels = router.decode(frame);
+ * @endcode
+ *
+ * @note Not thread-safe; owned and used by the adapter's receive path.
+ */
+class FrameRouter {
+  public:
+    /// Number of 11-bit CAN identifiers
+    static constexpr uint32_t STANDARD_ID_COUNT = 2048;
+
+    /// Largest payload held by the unchanged-payload cache (CAN FD)
+    static constexpr int MAX_CACHED_PAYLOAD = 64;
+
+    /// Pass as nowMs to read the router's monotonic clock only when needed
+    static constexpr qint64 CLOCK_NOW = -1;
+
+    /**
+     * @brief Per-ID count of frames that no decoder claimed
+     */
+    struct UnclaimedFrame {
+        FrameKey key;       ///< Frame identifier
+        quint64 count = 0;  ///< Frames received with this identifier
+    };
+
+    /**
+     * @brief Per-ID unchanged-payload cache statistics
+     */
+    struct PayloadCacheStats {
+        FrameKey key;        ///< Frame identifier
+        quint64 hits = 0;    ///< Frames skipped because the payload was unchanged
+        quint64 misses = 0;  ///< Frames decoded
+
+        /// Fraction of frames skipped (0.0 - 1.0)
+        [[nodiscard]] double hitRate() const {
+            const quint64 total = hits + misses;
+            return total > 0 ? static_cast<double>(hits) / static_cast<double>(total) : 0.0;
+        }
+    };
+
+    /**
+     * @brief Measured rates of a rate-limited frame
+     */
+    struct RateLimitStats {
+        FrameKey key;             ///< Frame identifier
+        double declaredHz = 0.0;  ///< Rate declared by the protocol definition (0 = unknown)
+        double limitHz = 0.0;     ///< Configured cap (per mux page)
+        double receivedHz = 0.0;  ///< Measured arrival rate
+        double decodedHz = 0.0;   ///< Measured decode rate after the cap, all pages
+        quint64 received = 0;     ///< Frames received
+        quint64 decoded = 0;      ///< Frames decoded
+    };
+
+    FrameRouter();
+
+    /**
+     * @brief Register a decoder for all frames it claims
+     *
+     * If a frame is already claimed by an earlier decoder, the earlier
+     * decoder keeps it and a warning is logged.
+     *
+     * @param decoder Decoder to register (must outlive the router)
+     * @return Number of frame IDs routed to this decoder
+     */
+    int addDecoder(const IFrameDecoder* decoder);
+
+    /**
+     * @brief Remove all routes and reset all statistics
+     */
+    void clear();
+
+    /**
+     * @brief Find the decoder for a frame ID
+     * @return Decoder, or nullptr if the ID is unclaimed
+     */
+    [[nodiscard]] const IFrameDecoder* lookup(uint32_t frameId, bool extended) const {
+        if (!extended && frameId < STANDARD_ID_COUNT) {
+            return m_standardRoutes[frameId].decoder;
+        }
+        return m_extendedRoutes.value(frameId).decoder;
+    }
+
+    /**
+     * @brief Decode a frame with its registered decoder
+     *
+     * @param frame The CAN frame to decode
+     * @param nowMs Monotonic time in milliseconds, only used for rate-limited
+     *              frames (CLOCK_NOW reads the router's clock)
+     * @return Decoded channels, or empty if the frame is unclaimed, held back
+     *         by a rate limit, or its payload is unchanged since the last
+     *         decoded frame with this ID
+     */
+    [[nodiscard]] std::vector<std::pair<QString, ChannelValue>>
+    decode(const QCanBusFrame& frame, qint64 nowMs = CLOCK_NOW);
+
+    /**
+     * @brief Check whether any decoder is registered
+     */
+    [[nodiscard]] bool isEmpty() const { return m_routeCount == 0; }
+
+    /**
+     * @brief Number of routed frame IDs
+     */
+    [[nodiscard]] int routeCount() const { return m_routeCount; }
+
+    /**
+     * @brief Every routed frame, in registration order
+     */
+    [[nodiscard]] std::vector<FrameKey> routedFrames() const;
+
+    //=========================================================================
+    // Unchanged-Payload Cache
+    //=========================================================================
+
+    /// Distinct mux pages cached per frame; frames of further pages are always decoded
+    static constexpr size_t MAX_PAYLOAD_PAGES = 256;
+
+    /**
+     * @brief Enable or disable skipping of unchanged payloads (default: enabled)
+     */
+    void setPayloadCacheEnabled(bool enabled) { m_payloadCacheEnabled = enabled; }
+
+    /**
+     * @brief Check whether unchanged payloads are skipped
+     */
+    [[nodiscard]] bool payloadCacheEnabled() const { return m_payloadCacheEnabled; }
+
+    /**
+     * @brief Forget cached payloads so the next frame of every ID is decoded
+     *
+     * Call when the bus (re)connects so consumers receive fresh values.
+     * Hit/miss counters are kept.
+     */
+    void invalidatePayloadCache();
+
+    /**
+     * @brief Per-ID cache statistics for every routed frame that was received
+     */
+    [[nodiscard]] std::vector<PayloadCacheStats> payloadCacheStats() const;
+
+    /**
+     * @brief Total frames skipped by the cache across all IDs
+     */
+    [[nodiscard]] quint64 payloadCacheHits() const { return m_payloadCacheHits; }
+
+    //=========================================================================
+    // Rate Limits
+    //=========================================================================
+
+    /// Distinct mux pages capped per frame; frames of further pages are not capped
+    static constexpr size_t MAX_RATE_PAGES = 256;
+
+    /**
+     * @brief Cap the decode rate of a routed frame (of each of its mux pages)
+     *
+     * @param key Frame to cap (must already be routed)
+     * @param maxHz Maximum decode rate; 0 or less removes the cap
+     * @return false if the frame is not routed
+     */
+    bool setFrameRateLimit(const FrameKey& key, double maxHz);
+
+    /**
+     * @brief Check whether any frame is rate-limited
+     */
+    [[nodiscard]] bool hasRateLimits() const { return m_activeRateGates > 0; }
+
+    /**
+     * @brief Shortest configured cap interval in milliseconds (0 if none)
+     *
+     * Flushing at this period bounds the extra latency of a held-back
+     * frame to one interval.
+     */
+    [[nodiscard]] qint64 shortestRateLimitIntervalMs() const;
+
+    /**
+     * @brief Decode held-back frames whose cap interval has elapsed
+     *
+     * @param nowMs Monotonic time in milliseconds (CLOCK_NOW reads the router's clock)
+     * @return Channels decoded from the released frames
+     */
+    [[nodiscard]] std::vector<std::pair<QString, ChannelValue>>
+    flushPending(qint64 nowMs = CLOCK_NOW);
+
+    /**
+     * @brief Declared vs. measured rates for every rate-limited frame
+     */
+    [[nodiscard]] std::vector<RateLimitStats> rateLimitStats() const;
+
+    //=========================================================================
+    // Unclaimed Frames
+    //=========================================================================
+
+    /**
+     * @brief Total number of frames received that no decoder claimed
+     */
+    [[nodiscard]] quint64 unclaimedFrameCount() const { return m_unclaimedTotal; }
+
+    /**
+     * @brief Per-ID unclaimed frame counts, most frequent first
+     *
+     * @note At most MAX_TRACKED_EXTENDED_IDS distinct 29-bit IDs are tracked;
+     *       further IDs only contribute to unclaimedFrameCount().
+     */
+    [[nodiscard]] std::vector<UnclaimedFrame> unclaimedFrames() const;
+
+    /// Distinct unclaimed 29-bit IDs tracked individually
+    static constexpr int MAX_TRACKED_EXTENDED_IDS = 256;
+
+  private:
+    /// Payload words held per cache slot
+    static constexpr int PAYLOAD_WORDS = MAX_CACHED_PAYLOAD / static_cast<int>(sizeof(uint64_t));
+
+    /**
+     * @brief Dispatch entry for one frame ID
+     */
+    struct Route {
+        const IFrameDecoder* decoder = nullptr; ///< nullptr when unclaimed
+        int cacheSlot = -1;                     ///< Index into m_payloadCache
+        int gateSlot = -1;                      ///< Index into m_rateGates, -1 = uncapped
+        bool multiplexed = false;               ///< Cached and capped per mux page
+    };
+
+    /**
+     * @brief Last payload seen for one mux page of a frame ID
+     */
+    struct PayloadPage {
+        int64_t muxValue = 0;
+        std::array<uint64_t, PAYLOAD_WORDS> words{}; ///< Payload, zero-padded
+        int length = -1;                             ///< Payload length, -1 = empty slot
+    };
+
+    /**
+     * @brief Cached payloads of one routed frame ID
+     */
+    struct PayloadCacheEntry {
+        std::vector<PayloadPage> pages; ///< One per mux value seen (one if not multiplexed)
+        FrameKey key;
+        quint64 hits = 0;
+        quint64 misses = 0;
+    };
+
+    /**
+     * @brief Rate cap state for one mux page of a frame ID
+     */
+    struct RatePage {
+        int64_t muxValue = 0;
+        qint64 nextAllowedMs = 0;    ///< Earliest time the next frame may be decoded
+        QCanBusFrame pending;        ///< Newest frame held back by the cap
+        bool hasPending = false;
+    };
+
+    /**
+     * @brief Rate cap state for one frame ID
+     */
+    struct RateGate {
+        FrameKey key;
+        double limitHz = 0.0;        ///< 0 = cap removed
+        double declaredHz = 0.0;
+        qint64 intervalMs = 0;
+        std::vector<RatePage> pages; ///< One per mux value seen (one if not multiplexed)
+        quint64 received = 0;
+        quint64 decoded = 0;
+        qint64 firstReceivedMs = -1;
+        qint64 lastReceivedMs = -1;
+        qint64 firstDecodedMs = -1;
+        qint64 lastDecodedMs = -1;
+    };
+
+    [[nodiscard]] const Route* findRoute(uint32_t frameId, bool extended) const;
+    [[nodiscard]] Route* findRoute(uint32_t frameId, bool extended);
+    [[nodiscard]] std::vector<std::pair<QString, ChannelValue>>
+    decodeRoute(const Route& route, const QCanBusFrame& frame, int64_t muxValue);
+    [[nodiscard]] bool isUnchangedPayload(int cacheSlot, int64_t muxValue,
+                                          const QByteArray& payload);
+    [[nodiscard]] static PayloadPage* findPayloadPage(PayloadCacheEntry& entry, int64_t muxValue);
+    [[nodiscard]] static RatePage* findPage(RateGate& gate, int64_t muxValue);
+    [[nodiscard]] qint64 resolveNow(qint64 nowMs) const;
+    void recordUnclaimed(uint32_t frameId, bool extended);
+
+    /// 11-bit ID → route
+    std::array<Route, STANDARD_ID_COUNT> m_standardRoutes{};
+
+    /// 29-bit ID → route (also holds extended-format frames with small IDs)
+    QHash<uint32_t, Route> m_extendedRoutes;
+
+    /// Rate cap state, indexed by Route::gateSlot
+    std::vector<RateGate> m_rateGates;
+    int m_activeRateGates = 0;
+    QElapsedTimer m_clock;
+
+    /// One slot per route, indexed by Route::cacheSlot
+    std::vector<PayloadCacheEntry> m_payloadCache;
+    bool m_payloadCacheEnabled = true;
+    quint64 m_payloadCacheHits = 0;
+
+    /// 11-bit ID → unclaimed frame count
+    std::array<quint64, STANDARD_ID_COUNT> m_standardUnclaimed{};
+
+    /// 29-bit ID → unclaimed frame count
+    QHash<uint32_t, quint64> m_extendedUnclaimed;
+
+    quint64 m_unclaimedTotal = 0;
+    int m_routeCount = 0;
+};
+
+} // namespace devdash
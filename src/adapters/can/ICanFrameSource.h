@@ -0,0 +1,125 @@
+#pragma once
+
+#include "RawCanSocket.h"
+
+#include <QJsonObject>
+#include <QObject>
+#include <QString>
+
+#include <cstdint>
+#include <functional>
+#include <utility>
+
+namespace devdash {
+
+/**
+ * @brief Producer of CAN frames that stands in for the bus
+ *
+ * CanAdapter reads frames from a source instead of its CAN interface when
+ * one is set: CanLogPlayer replays a recorded session, FrameGenerator
+ * synthesizes frames from a simulation scenario and VirtualCanEndpoint
+ * receives from an in-process VirtualCanBus. Frames are handed to the
+ * frame handler on the thread the source lives on and take the adapter's
+ * normal decode path.
+ *
+ * Sources are driven by the event loop (timers), never by a thread of
+ * their own, so they follow the adapter onto its I/O thread.
+ */
+class ICanFrameSource : public QObject {
+    Q_OBJECT
+
+  public:
+    using FrameHandler = std::function<void(const RawCanFrame&)>;
+
+    ~ICanFrameSource() override = default;
+
+    // QObject-based classes are not copyable or movable
+    ICanFrameSource(const ICanFrameSource&) = delete;
+    ICanFrameSource& operator=(const ICanFrameSource&) = delete;
+    ICanFrameSource(ICanFrameSource&&) = delete;
+    ICanFrameSource& operator=(ICanFrameSource&&) = delete;
+
+    /**
+     * @brief Set the function that receives each frame
+     */
+    void setFrameHandler(FrameHandler handler) { m_handler = std::move(handler); }
+
+    /**
+     * @brief Short name reported as the adapter backend (e.g. "replay")
+     */
+    [[nodiscard]] virtual QString sourceName() const = 0;
+
+    /**
+     * @brief One-line description for the log (file, scenario, rate)
+     */
+    [[nodiscard]] virtual QString description() const = 0;
+
+    /**
+     * @brief Prepare the source from its current settings
+     * @return false if the source cannot deliver frames, see errorString()
+     */
+    [[nodiscard]] virtual bool open() = 0;
+
+    /**
+     * @brief Start (or resume) delivering frames
+     */
+    virtual void start() = 0;
+
+    /**
+     * @brief Stop delivering frames
+     */
+    virtual void stop() = 0;
+
+    /** @brief Frames handed to the frame handler */
+    [[nodiscard]] virtual uint64_t framesDelivered() const = 0;
+
+    /**
+     * @brief Source-specific state, reported under the source name in the
+     *        adapter's bus diagnostics
+     */
+    [[nodiscard]] virtual QJsonObject diagnostics() const = 0;
+
+    [[nodiscard]] virtual QString errorString() const = 0;
+
+    /**
+     * @brief Check whether frames carry their bus arrival time
+     *
+     * Replayed and generated frames do not: the adapter stamps them on
+     * delivery so recorded times do not show up as bus jitter.
+     */
+    [[nodiscard]] virtual bool hasArrivalTimestamps() const { return false; }
+
+    /**
+     * @brief Check whether writeFrame() can send frames (sources modelling a bus)
+     */
+    [[nodiscard]] virtual bool isWritable() const { return false; }
+
+    /**
+     * @brief Send a frame to the other nodes of the source's bus
+     * @return false if the source cannot send or the frame was rejected
+     */
+    virtual bool writeFrame(const RawCanFrame& /*frame*/) { return false; }
+
+  signals:
+    /**
+     * @brief Emitted when the source has no more frames to deliver
+     */
+    void finished();
+
+  protected:
+    explicit ICanFrameSource(QObject* parent = nullptr) : QObject(parent) {}
+
+    /**
+     * @brief Hand a frame to the frame handler
+     */
+    void deliver(const RawCanFrame& frame) {
+        if (m_handler) {
+            m_handler(frame);
+        }
+    }
+
+  private:
+    FrameHandler m_handler;
+};
+
+} // namespace devdash
@@ -0,0 +1,55 @@
+#pragma once
+
+#include "RawCanSocket.h"
+
+#include <cstdint>
+#include <string>
+
+namespace devdash {
+
+/**
+ * @brief Sequential, seekable source of recorded CAN frames
+ *
+ * Implemented by CanLogReader (binary logs written by CanRecorder) and
+ * CandumpLogReader (can-utils `candump -L` text), so CanLogPlayer replays
+ * either without knowing the file format.
+ */
+class ICanLogReader {
+  public:
+    virtual ~ICanLogReader() = default;
+
+    /**
+     * @brief Read the next frame
+     * @return false at the end of the log
+     */
+    [[nodiscard]] virtual bool next(RawCanFrame& frame) = 0;
+
+    /**
+     * @brief Position before the first frame at or after @p timestampNs
+     */
+    virtual void seek(int64_t timestampNs) = 0;
+
+    /**
+     * @brief Position before the first frame
+     */
+    virtual void rewind() = 0;
+
+    /**
+     * @brief Timestamp of the first frame, 0 for an empty log
+     */
+    [[nodiscard]] virtual int64_t firstTimestampNs() const = 0;
+
+    /**
+     * @brief Interface the log was recorded on (may be empty)
+     */
+    [[nodiscard]] virtual const std::string& interfaceName() const = 0;
+
+  protected:
+    ICanLogReader() = default;
+    ICanLogReader(const ICanLogReader&) = default;
+    ICanLogReader& operator=(const ICanLogReader&) = default;
+    ICanLogReader(ICanLogReader&&) = default;
+    ICanLogReader& operator=(ICanLogReader&&) = default;
+};
+
+} // namespace devdash
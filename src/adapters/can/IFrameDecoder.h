@@ -0,0 +1,109 @@
+#pragma once
+
+#include "core/interfaces/IProtocolAdapter.h"
+
+#include <QCanBusFrame>
+#include <QString>
+#include <QStringList>
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace devdash {
+
+/**
+ * @brief A CAN identifier together with its frame format.
+ *
+ * 0x100 as an 11-bit ID and 0x100 as a 29-bit ID are different frames on
+ * the bus, so routing always keys on both.
+ */
+struct FrameKey {
+    uint32_t frameId = 0;  ///< CAN identifier (11 or 29 bits)
+    bool extended = false; ///< 29-bit (extended) identifier
+};
+
+/**
+ * @brief Interface for protocol decoders that can share a CAN bus
+ *
+ * Each decoder declares the frames it owns up front so FrameRouter can build
+ * its dispatch table once. Decoders never see frames they did not claim.
+ *
+ * Implemented by HaltechProtocol, PD16Protocol and DbcProtocol.
+ */
+class IFrameDecoder {
+  public:
+    virtual ~IFrameDecoder() = default;
+
+    /**
+     * @brief Get the frames this decoder handles
+     * @return Frame keys to route to this decoder
+     */
+    [[nodiscard]] virtual std::vector<FrameKey> claimedFrames() const = 0;
+
+    /**
+     * @brief Decode a claimed frame into channel values
+     * @param frame The CAN frame to decode
+     * @return Vector of (channel name, value) pairs
+     */
+    [[nodiscard]] virtual std::vector<std::pair<QString, ChannelValue>>
+    decode(const QCanBusFrame& frame) const = 0;
+
+    /**
+     * @brief Get the broadcast rate the protocol definition declares for a frame
+     * @param key A frame returned by claimedFrames()
+     * @return Declared rate in Hz, or 0 if the definition does not say
+     */
+    [[nodiscard]] virtual double declaredRateHz(const FrameKey& /*key*/) const { return 0.0; }
+
+    /**
+     * @brief Get the channel names a frame can produce
+     *
+     * Used to leave frames without a mapped channel to the kernel receive
+     * filter (see CanIdFilter).
+     *
+     * @param key A frame returned by claimedFrames()
+     * @return Channel names; empty if unknown (the frame is then always received)
+     */
+    [[nodiscard]] virtual QStringList frameChannels(const FrameKey& /*key*/) const { return {}; }
+
+    /**
+     * @brief Get the multiplexor value (page) of a claimed frame
+     *
+     * Pages sharing one frame ID carry different channels (PD16 status
+     * pages, DBC mux groups), so FrameRouter rate-limits and caches each
+     * page on its own instead of letting one page replace another. Only
+     * asked for frames isMultiplexed() reports.
+     *
+     * @param frame A frame with a key returned by claimedFrames()
+     * @return Page of the frame; 0 for frames that are not multiplexed
+     */
+    [[nodiscard]] virtual int64_t multiplexValue(const QCanBusFrame& /*frame*/) const { return 0; }
+
+    /**
+     * @brief Check whether a claimed frame carries mux pages (see multiplexValue())
+     *
+     * Read once per frame ID when FrameRouter registers the decoder.
+     *
+     * @param key A frame returned by claimedFrames()
+     */
+    [[nodiscard]] virtual bool isMultiplexed(const FrameKey& /*key*/) const { return false; }
+
+    /**
+     * @brief Check whether the profile "channelMappings" names this decoder's channels
+     *
+     * Decoders whose channels the dash reads under their own names (PD16
+     * IOs, generated or named by "pd16ChannelMapping") return false; their
+     * frames always pass the kernel receive filter.
+     */
+    [[nodiscard]] virtual bool channelsMappedByProfile() const { return true; }
+
+  protected:
+    IFrameDecoder() = default;
+    IFrameDecoder(const IFrameDecoder&) = default;
+    IFrameDecoder& operator=(const IFrameDecoder&) = default;
+    IFrameDecoder(IFrameDecoder&&) = default;
+    IFrameDecoder& operator=(IFrameDecoder&&) = default;
+};
+
+} // namespace devdash
@@ -0,0 +1,321 @@
+/**
+ * @file MultiCanAdapter.cpp
+ * @brief Implementation of the multi-interface CAN adapter.
+ */
+
+#include "MultiCanAdapter.h"
+
+#include "ProtocolAdapterFactory.h"
+
+#include <QDebug>
+#include <QJsonArray>
+#include <QMetaObject>
+
+namespace devdash {
+
+namespace {
+
+//=============================================================================
+// Configuration Keys
+//=============================================================================
+
+constexpr const char* CONFIG_KEY_BUSES = "buses";
+constexpr const char* CONFIG_KEY_ADAPTER = "adapter";
+constexpr const char* CONFIG_KEY_NAME = "name";
+constexpr const char* CONFIG_KEY_INTERFACE = "interface";
+constexpr const char* CONFIG_KEY_IO_THREAD = "ioThread";
+
+//=============================================================================
+// Defaults
+//=============================================================================
+
+constexpr const char* ADAPTER_TYPE_MULTI = "multi";
+constexpr const char* DEFAULT_BUS_ADAPTER = "haltech";
+constexpr const char* BUS_THREAD_PREFIX = "devdash-bus";
+
+/**
+ * @brief Bus entry layered over the shared keys of the multi adapter config
+ */
+QJsonObject busConfig(const QJsonObject& shared, const QJsonObject& entry) {
+    QJsonObject merged = shared;
+    merged.remove(CONFIG_KEY_BUSES);
+    for (auto it = entry.begin(); it != entry.end(); ++it) {
+        merged[it.key()] = it.value();
+    }
+    merged.remove(CONFIG_KEY_ADAPTER);
+    merged.remove(CONFIG_KEY_NAME);
+    merged.remove(CONFIG_KEY_IO_THREAD);
+    return merged;
+}
+
+} // anonymous namespace
+
+//=============================================================================
+// Construction / Destruction
+//=============================================================================
+
+MultiCanAdapter::MultiCanAdapter(const QJsonObject& config, QObject* parent)
+    : IProtocolAdapter(parent) {
+    loadBuses(config);
+}
+
+MultiCanAdapter::~MultiCanAdapter() {
+    stop();
+}
+
+void MultiCanAdapter::loadBuses(const QJsonObject& config) {
+    const QJsonArray entries = config[CONFIG_KEY_BUSES].toArray();
+    if (entries.isEmpty()) {
+        m_configError = QStringLiteral("No buses configured");
+        return;
+    }
+
+    for (qsizetype i = 0; i < entries.size(); ++i) {
+        const QJsonObject entry = entries.at(i).toObject();
+        auto bus = std::make_unique<Bus>();
+        bus->type = entry[CONFIG_KEY_ADAPTER].toString(DEFAULT_BUS_ADAPTER);
+        bus->name = entry[CONFIG_KEY_NAME].toString(
+            entry[CONFIG_KEY_INTERFACE].toString(QStringLiteral("bus%1").arg(i)));
+        bus->scheduling = ThreadScheduling::fromJson(entry[CONFIG_KEY_IO_THREAD].toObject());
+
+        if (bus->type != ADAPTER_TYPE_MULTI) {
+            bus->adapter = ProtocolAdapterFactory::create(bus->type, busConfig(config, entry));
+        }
+        if (!bus->adapter) {
+            m_configError = QStringLiteral("Bus %1: cannot create a \"%2\" adapter")
+                                .arg(bus->name, bus->type);
+            qWarning() << "MultiCanAdapter:" << m_configError;
+            m_buses.clear();
+            return;
+        }
+
+        // Parented while stopped so it follows this adapter between threads
+        bus->adapter->setParent(this);
+        connectBus(*bus);
+        m_buses.push_back(std::move(bus));
+    }
+}
+
+void MultiCanAdapter::connectBus(Bus& bus) {
+    // Direct: emitted on the bus thread, so each bus feeds the broker's
+    // lock-free queue as its own producer
+    connect(
+        bus.adapter.get(), &IProtocolAdapter::channelUpdated, this,
+        [this, &bus](const QString& channelName, const ChannelValue& value) {
+            bus.updates.fetch_add(1, std::memory_order_relaxed);
+            emit channelUpdated(channelName, value);
+        },
+        Qt::DirectConnection);
+
+    // Queued to this adapter's thread, which owns the aggregate state
+    connect(bus.adapter.get(), &IProtocolAdapter::connectionStateChanged, this,
+            [this, &bus](bool connected) { onBusConnectionChanged(bus, connected); });
+    connect(bus.adapter.get(), &IProtocolAdapter::errorOccurred, this,
+            [this, &bus](const QString& message) {
+                bus.lastError = message;
+                emit errorOccurred(QStringLiteral("%1: %2").arg(bus.name, message));
+            });
+}
+
+//=============================================================================
+// IProtocolAdapter Interface
+//=============================================================================
+
+bool MultiCanAdapter::start() {
+    if (m_running) {
+        return true;
+    }
+    if (!m_configError.isEmpty()) {
+        qWarning() << "MultiCanAdapter:" << m_configError;
+        emit errorOccurred(m_configError);
+        return false;
+    }
+
+    for (size_t i = 0; i < m_buses.size(); ++i) {
+        if (!startBus(*m_buses[i], static_cast<int>(i))) {
+            qWarning() << "MultiCanAdapter: Bus" << m_buses[i]->name << "failed to start";
+            for (size_t started = 0; started < i; ++started) {
+                stopBus(*m_buses[started]);
+            }
+            return false;
+        }
+    }
+
+    m_running = true;
+    qInfo() << "MultiCanAdapter: Capturing" << m_buses.size() << "buses";
+    return true;
+}
+
+void MultiCanAdapter::stop() {
+    if (!m_running) {
+        return;
+    }
+    for (auto& bus : m_buses) {
+        stopBus(*bus);
+    }
+    m_running = false;
+
+    if (m_connected) {
+        m_connected = false;
+        emit connectionStateChanged(false);
+    }
+}
+
+bool MultiCanAdapter::isRunning() const {
+    return m_running;
+}
+
+std::optional<ChannelValue> MultiCanAdapter::getChannel(const QString& channelName) const {
+    for (const auto& bus : m_buses) {
+        std::optional<ChannelValue> value;
+        runOnBus(*bus, [&bus, &value, &channelName]() {
+            value = bus->adapter->getChannel(channelName);
+        });
+        if (value) {
+            return value;
+        }
+    }
+    return std::nullopt;
+}
+
+QStringList MultiCanAdapter::availableChannels() const {
+    QStringList channels;
+    for (const auto& bus : m_buses) {
+        runOnBus(*bus, [&bus, &channels]() { channels.append(bus->adapter->availableChannels()); });
+    }
+    channels.removeDuplicates();
+    return channels;
+}
+
+QString MultiCanAdapter::adapterName() const {
+    QStringList names;
+    for (const auto& bus : m_buses) {
+        names.append(QStringLiteral("%1 (%2)").arg(bus->adapter->adapterName(), bus->name));
+    }
+    return QStringLiteral("Multi-bus CAN: %1").arg(names.join(QStringLiteral(", ")));
+}
+
+QJsonObject MultiCanAdapter::diagnostics() const {
+    QJsonArray buses;
+    uint64_t totalUpdates = 0;
+    for (const auto& bus : m_buses) {
+        const uint64_t updates = bus->updates.load(std::memory_order_relaxed);
+        totalUpdates += updates;
+
+        QJsonObject entry;
+        entry["name"] = bus->name;
+        entry["adapter"] = bus->type;
+        entry["connected"] = bus->connected;
+        entry["channelUpdates"] = static_cast<qint64>(updates);
+        if (!bus->lastError.isEmpty()) {
+            entry["lastError"] = bus->lastError;
+        }
+        if (bus->thread) {
+            entry["thread"] = bus->thread->objectName();
+            entry["ioThread"] = bus->schedulingResult.toJson();
+        }
+        QJsonObject adapterDiagnostics;
+        runOnBus(*bus, [&bus, &adapterDiagnostics]() {
+            adapterDiagnostics = bus->adapter->diagnostics();
+        });
+        entry["diagnostics"] = adapterDiagnostics;
+        buses.append(entry);
+    }
+
+    QJsonObject result;
+    result["buses"] = buses;
+    result["channelUpdates"] = static_cast<qint64>(totalUpdates);
+    return result;
+}
+
+IProtocolAdapter* MultiCanAdapter::busAdapter(int index) const {
+    if (index < 0 || index >= busCount()) {
+        return nullptr;
+    }
+    return m_buses[static_cast<size_t>(index)]->adapter.get();
+}
+
+//=============================================================================
+// Bus Threads
+//=============================================================================
+
+bool MultiCanAdapter::startBus(Bus& bus, int index) {
+    bus.updates.store(0, std::memory_order_relaxed);
+    bus.lastError.clear();
+
+    bus.thread = std::make_unique<QThread>();
+    bus.thread->setObjectName(QString::fromLatin1(BUS_THREAD_PREFIX) + QString::number(index));
+    bus.thread->start();
+
+    // Objects with a parent cannot change threads
+    bus.adapter->setParent(nullptr);
+    bus.adapter->moveToThread(bus.thread.get());
+
+    // The bus adapter creates its sockets and notifiers in start(), so it
+    // must run on the thread that will service them
+    bool started = false;
+    QMetaObject::invokeMethod(
+        bus.adapter.get(),
+        [&bus, &started]() {
+            started = bus.adapter->start();
+            bus.schedulingResult = ThreadScheduling::applyToCurrentThread(bus.scheduling);
+        },
+        Qt::BlockingQueuedConnection);
+
+    qInfo() << "MultiCanAdapter: Bus" << bus.name << "thread:" << bus.schedulingResult.summary();
+    for (const QString& problem : bus.schedulingResult.problems) {
+        qWarning() << "MultiCanAdapter: Bus" << bus.name << "thread:" << problem;
+    }
+
+    if (!started) {
+        stopBus(bus);
+    }
+    return started;
+}
+
+void MultiCanAdapter::stopBus(Bus& bus) {
+    if (!bus.thread) {
+        return;
+    }
+    QMetaObject::invokeMethod(
+        bus.adapter.get(),
+        [&bus, owner = thread()]() {
+            if (bus.adapter->isRunning()) {
+                bus.adapter->stop();
+            }
+            bus.adapter->moveToThread(owner);
+        },
+        Qt::BlockingQueuedConnection);
+    bus.thread->quit();
+    bus.thread->wait();
+    bus.thread.reset();
+    bus.adapter->setParent(this);
+    bus.connected = false;
+}
+
+void MultiCanAdapter::onBusConnectionChanged(Bus& bus, bool connected) {
+    if (!m_running && connected) {
+        return;  // Late notification from a bus that has been stopped
+    }
+    bus.connected = connected;
+
+    // Connected while any bus is: the others may simply be unplugged
+    bool anyConnected = false;
+    for (const auto& other : m_buses) {
+        anyConnected = anyConnected || other->connected;
+    }
+    if (anyConnected != m_connected) {
+        m_connected = anyConnected;
+        emit connectionStateChanged(m_connected);
+    }
+}
+
+void MultiCanAdapter::runOnBus(const Bus& bus, const std::function<void()>& function) const {
+    if (bus.adapter->thread() == QThread::currentThread()) {
+        function();
+        return;
+    }
+    QMetaObject::invokeMethod(bus.adapter.get(), function, Qt::BlockingQueuedConnection);
+}
+
+} // namespace devdash
@@ -0,0 +1,136 @@
+#pragma once
+
+#include "core/interfaces/IProtocolAdapter.h"
+#include "core/threading/ThreadScheduling.h"
+
+#include <QJsonObject>
+#include <QString>
+#include <QThread>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace devdash {
+
+/**
+ * @brief Captures several CAN interfaces at once, one receive thread per bus
+ *
+ * Cars with a separate powertrain, chassis and PDM bus need all of them on
+ * the dash. Each entry of "buses" becomes its own protocol adapter (created
+ * through ProtocolAdapterFactory, so every bus has its own decoder set,
+ * kernel receive filters, reconnect supervision and recorder) running on
+ * its own QThread ("devdash-bus0", ...). A bus that floods its interface
+ * therefore delays only its own decoding, and capture throughput grows with
+ * the number of buses and cores instead of being capped by one thread.
+ *
+ * Decoded channels are forwarded with a direct connection, so they are
+ * emitted on the bus thread that decoded them. DataBroker enqueues them into
+ * its lock-free ChannelUpdateQueue from there, where each bus thread is a
+ * separate producer with its own sub-queue: buses never contend with each
+ * other or with the UI thread on the way in. Per-bus counters are kept on
+ * separate cache lines for the same reason.
+ *
+ * Keys outside "buses" are shared defaults; each bus entry overrides them
+ * and names its decoder with "adapter" (any adapter type except "multi").
+ * The profile's "channelMappings" reach every bus, so each installs kernel
+ * filters for the channels it can decode.
+ *
+ * @code
+ * "adapter": "multi",
+ * "adapterConfig": {
+ *     "backend": "native",
+ *     "buses": [
+ *         { "adapter": "haltech", "interface": "can0", "protocolFile": "..." },
+ *         { "adapter": "dbc", "interface": "can1", "dbcFile": "chassis.dbc",
+ *           "ioThread": { "priority": 40, "cpus": [3] } }
+ *     ]
+ * }
+ * @endcode
+ *
+ * "ioThread" takes the same keys as the profile-level one (see
+ * ThreadScheduling) and applies to that bus's thread only.
+ *
+ * @note The adapter itself may live on the UI thread or the DataBroker I/O
+ *       thread; only the bus adapters are moved to the bus threads.
+ */
+class MultiCanAdapter : public IProtocolAdapter {
+    Q_OBJECT
+
+  public:
+    explicit MultiCanAdapter(const QJsonObject& config, QObject* parent = nullptr);
+    ~MultiCanAdapter() override;
+
+    // QObject-based classes are not copyable or movable
+    MultiCanAdapter(const MultiCanAdapter&) = delete;
+    MultiCanAdapter& operator=(const MultiCanAdapter&) = delete;
+    MultiCanAdapter(MultiCanAdapter&&) = delete;
+    MultiCanAdapter& operator=(MultiCanAdapter&&) = delete;
+
+    // IProtocolAdapter interface
+    [[nodiscard]] bool start() override;
+    void stop() override;
+    [[nodiscard]] bool isRunning() const override;
+    [[nodiscard]] std::optional<ChannelValue> getChannel(const QString& channelName) const override;
+    [[nodiscard]] QStringList availableChannels() const override;
+    [[nodiscard]] QString adapterName() const override;
+
+    /**
+     * @brief Per-bus statistics and each bus adapter's own diagnostics
+     *
+     * Bus adapter counters are read on their bus thread.
+     */
+    [[nodiscard]] QJsonObject diagnostics() const override;
+
+    /**
+     * @brief Number of configured buses
+     */
+    [[nodiscard]] int busCount() const { return static_cast<int>(m_buses.size()); }
+
+    /**
+     * @brief The adapter decoding bus @p index (owned; lives on the bus thread while running)
+     */
+    [[nodiscard]] IProtocolAdapter* busAdapter(int index) const;
+
+  private:
+    /// Keeps the update counters of different buses off each other's cache lines
+    static constexpr size_t CACHE_LINE = 64;
+
+    /**
+     * @brief One bus: its adapter, thread and statistics
+     */
+    struct Bus {
+        QString name;                               ///< "name", else the interface
+        QString type;                               ///< Adapter type, e.g. "haltech"
+        std::unique_ptr<IProtocolAdapter> adapter;
+        std::unique_ptr<QThread> thread;            ///< Running while the adapter is started
+        ThreadScheduling::Config scheduling;
+        ThreadScheduling::Result schedulingResult;
+        bool connected = false;                     ///< Last connectionStateChanged (our thread)
+        QString lastError;
+
+        /// Channel updates forwarded; written by the bus thread only
+        alignas(CACHE_LINE) std::atomic<uint64_t> updates{0};
+    };
+
+    void loadBuses(const QJsonObject& config);
+    void connectBus(Bus& bus);
+    [[nodiscard]] bool startBus(Bus& bus, int index);
+    void stopBus(Bus& bus);
+    void onBusConnectionChanged(Bus& bus, bool connected);
+
+    /**
+     * @brief Run @p function where the bus adapter lives, blocking until done
+     */
+    void runOnBus(const Bus& bus, const std::function<void()>& function) const;
+
+    std::vector<std::unique_ptr<Bus>> m_buses;
+    QString m_configError;
+    bool m_running{false};
+    bool m_connected{false};
+};
+
+} // namespace devdash
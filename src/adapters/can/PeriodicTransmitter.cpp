@@ -0,0 +1,197 @@
+/**
+ * @file PeriodicTransmitter.cpp
+ * @brief Implementation of the timerfd-driven periodic CAN transmitter.
+ */
+
+#include "PeriodicTransmitter.h"
+
+#include <QDebug>
+#include <QJsonArray>
+
+#include <sys/timerfd.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+#include <ctime>
+
+namespace devdash {
+
+namespace {
+
+//=============================================================================
+// Time Conversion
+//=============================================================================
+
+constexpr int64_t US_PER_SECOND = 1000000;
+constexpr int64_t NS_PER_US = 1000;
+constexpr double US_PER_MS = 1000.0;
+
+} // anonymous namespace
+
+//=============================================================================
+// Construction / Destruction
+//=============================================================================
+
+PeriodicTransmitter::PeriodicTransmitter(QObject* parent) : QObject(parent) {}
+
+PeriodicTransmitter::~PeriodicTransmitter() {
+    stop();
+}
+
+int64_t PeriodicTransmitter::nowUs() {
+    timespec now{};
+    ::clock_gettime(CLOCK_MONOTONIC, &now);
+    return (static_cast<int64_t>(now.tv_sec) * US_PER_SECOND) + (now.tv_nsec / NS_PER_US);
+}
+
+//=============================================================================
+// Schedule
+//=============================================================================
+
+int PeriodicTransmitter::add(const RawCanFrame& frame, int64_t periodUs, int64_t phaseUs) {
+    // The current time, not the last wake-up: the timer is disarmed while nothing is scheduled
+    const int id = m_schedule.add(frame, periodUs, phaseUs, nowUs());
+    if (id >= 0) {
+        m_batch.reserve(m_schedule.size());
+        arm();
+    }
+    return id;
+}
+
+bool PeriodicTransmitter::remove(int id) {
+    if (!m_schedule.remove(id)) {
+        return false;
+    }
+    arm();
+    return true;
+}
+
+//=============================================================================
+// Timer Control
+//=============================================================================
+
+bool PeriodicTransmitter::start() {
+    if (m_timerFd >= 0) {
+        return true;
+    }
+    m_errorString.clear();
+
+    m_timerFd = ::timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+    if (m_timerFd < 0) {
+        m_errorString =
+            QStringLiteral("timerfd_create: ") + QString::fromLocal8Bit(std::strerror(errno));
+        return false;
+    }
+
+    m_notifier = std::make_unique<QSocketNotifier>(m_timerFd, QSocketNotifier::Read);
+    // Parented so it follows the transmitter when it is moved to an I/O thread
+    m_notifier->setParent(this);
+    connect(m_notifier.get(), &QSocketNotifier::activated, this,
+            &PeriodicTransmitter::onTimerExpired);
+
+    m_wakeups = 0;
+    m_schedule.start(nowUs());
+    arm();
+    return true;
+}
+
+void PeriodicTransmitter::stop() {
+    m_schedule.stop();
+    if (m_notifier) {
+        // Deferred: the writer may stop the adapter from inside onTimerExpired()
+        m_notifier->setEnabled(false);
+        m_notifier.release()->deleteLater();
+    }
+    if (m_timerFd >= 0) {
+        ::close(m_timerFd);
+        m_timerFd = -1;
+    }
+}
+
+void PeriodicTransmitter::arm() {
+    if (m_timerFd < 0) {
+        return;
+    }
+
+    // Absolute expiry: waking up late does not push later periods back.
+    // A zero expiry disarms the timer when nothing is scheduled.
+    itimerspec expiry{};
+    const int64_t dueUs = m_schedule.nextDueUs();
+    if (dueUs != TransmitSchedule::NO_EVENT) {
+        expiry.it_value.tv_sec = static_cast<time_t>(dueUs / US_PER_SECOND);
+        expiry.it_value.tv_nsec = static_cast<long>((dueUs % US_PER_SECOND) * NS_PER_US);
+    }
+    if (::timerfd_settime(m_timerFd, TFD_TIMER_ABSTIME, &expiry, nullptr) != 0) {
+        qWarning() << "PeriodicTransmitter: timerfd_settime failed:" << std::strerror(errno);
+    }
+}
+
+//=============================================================================
+// Private Slots
+//=============================================================================
+
+void PeriodicTransmitter::onTimerExpired() {
+    uint64_t expirations = 0;
+    if (::read(m_timerFd, &expirations, sizeof(expirations)) < 0 && errno != EAGAIN) {
+        qWarning() << "PeriodicTransmitter: Timer read failed:" << std::strerror(errno);
+    }
+    ++m_wakeups;
+
+    m_batch.clear();
+    if (m_schedule.collectDue(nowUs(), m_batch) > 0) {
+        m_schedule.completeBatch(m_writer ? m_writer(m_batch) : 0);
+    }
+    arm();
+}
+
+//=============================================================================
+// Diagnostics
+//=============================================================================
+
+QJsonObject PeriodicTransmitter::diagnostics() const {
+    const TransmitSchedule::Stats& stats = m_schedule.stats();
+    QJsonObject transmit;
+    transmit["running"] = isRunning();
+    transmit["wakeups"] = static_cast<qint64>(m_wakeups);
+    transmit["batches"] = static_cast<qint64>(stats.batches);
+    transmit["sent"] = static_cast<qint64>(stats.sent);
+    transmit["deadlineMisses"] = static_cast<qint64>(stats.deadlineMisses);
+    transmit["skipped"] = static_cast<qint64>(stats.skipped);
+    transmit["writeFailures"] = static_cast<qint64>(stats.writeFailures);
+    transmit["toleranceUs"] = static_cast<qint64>(m_schedule.options().toleranceUs);
+    transmit["meanLatenessUs"] = stats.meanLatenessUs;
+    transmit["maxLatenessUs"] = static_cast<qint64>(stats.maxLatenessUs);
+
+    // Sends per lateness bucket; the last bucket has no upper bound
+    QJsonArray histogram;
+    for (size_t i = 0; i < stats.histogram.size(); ++i) {
+        QJsonObject bucket;
+        if (i < TransmitSchedule::JITTER_BUCKET_LIMITS_US.size()) {
+            bucket["belowUs"] = static_cast<qint64>(TransmitSchedule::JITTER_BUCKET_LIMITS_US[i]);
+        }
+        bucket["count"] = static_cast<qint64>(stats.histogram[i]);
+        histogram.append(bucket);
+    }
+    transmit["latenessHistogram"] = histogram;
+
+    QJsonArray frames;
+    for (const auto& frameStats : m_schedule.frameStats()) {
+        QJsonObject frame;
+        frame["id"] = QStringLiteral("0x%1").arg(frameStats.key.frameId, 0, 16);
+        frame["extended"] = frameStats.key.extended;
+        frame["periodMs"] = static_cast<double>(frameStats.periodUs) / US_PER_MS;
+        frame["phaseMs"] = static_cast<double>(frameStats.phaseUs) / US_PER_MS;
+        frame["sent"] = static_cast<qint64>(frameStats.sent);
+        frame["deadlineMisses"] = static_cast<qint64>(frameStats.deadlineMisses);
+        frame["skipped"] = static_cast<qint64>(frameStats.skipped);
+        frame["writeFailures"] = static_cast<qint64>(frameStats.writeFailures);
+        frame["meanLatenessUs"] = frameStats.meanLatenessUs;
+        frame["maxLatenessUs"] = static_cast<qint64>(frameStats.maxLatenessUs);
+        frames.append(frame);
+    }
+    transmit["frames"] = frames;
+    return transmit;
+}
+
+} // namespace devdash
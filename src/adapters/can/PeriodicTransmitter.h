@@ -0,0 +1,135 @@
+#pragma once
+
+#include "TransmitSchedule.h"
+
+#include <QJsonObject>
+#include <QObject>
+#include <QSocketNotifier>
+#include <QString>
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <span>
+#include <utility>
+#include <vector>
+
+namespace devdash {
+
+/**
+ * @brief Sends periodic CAN frames on time from the adapter's I/O thread
+ *
+ * Drives a TransmitSchedule from a timerfd armed at the absolute
+ * CLOCK_MONOTONIC time of the next due frame. The timer is a kernel
+ * hrtimer, so a wake-up is not rounded to the millisecond the way a
+ * QTimer's is, and it cannot drift: every period is measured from the
+ * start, not from the previous wake-up. The fd is watched by a
+ * QSocketNotifier on whatever thread owns the transmitter. That is the
+ * adapter's I/O thread (with its real-time scheduling, see
+ * ThreadScheduling) rather than the GUI thread, whose event loop stalls
+ * while the cluster renders.
+ *
+ * All frames due at a wake-up are handed to the writer as one batch (one
+ * sendmmsg() on the native backend). Lateness against the due time,
+ * deadline misses and overrun periods are measured by the schedule and
+ * reported by diagnostics().
+ *
+ * @code
+ * PeriodicTransmitter transmitter;
+ * transmitter.setWriter([&socket](std::span<const RawCanFrame> frames) {
+ *     return socket.writeBatch(frames);
+ * });
+ * const int keepalive = transmitter.add(frame, 100000);  // 10 Hz
+ * transmitter.start();
+ * transmitter.setPayload(keepalive, payload);            // from the next period on
+ * @endcode
+ *
+ * @note Linux only. Use from the thread that owns the transmitter.
+ */
+class PeriodicTransmitter : public QObject {
+    Q_OBJECT
+
+  public:
+    /**
+     * @brief Sends a batch of frames
+     * @return Frames sent, from the start of the batch
+     */
+    using Writer = std::function<size_t(std::span<const RawCanFrame>)>;
+
+    explicit PeriodicTransmitter(QObject* parent = nullptr);
+    ~PeriodicTransmitter() override;
+
+    // QObject-based classes are not copyable or movable
+    PeriodicTransmitter(const PeriodicTransmitter&) = delete;
+    PeriodicTransmitter& operator=(const PeriodicTransmitter&) = delete;
+    PeriodicTransmitter(PeriodicTransmitter&&) = delete;
+    PeriodicTransmitter& operator=(PeriodicTransmitter&&) = delete;
+
+    void setWriter(Writer writer) { m_writer = std::move(writer); }
+
+    void setOptions(const TransmitSchedule::Options& options) { m_schedule.setOptions(options); }
+
+    /**
+     * @brief Send @p frame every @p periodUs (see TransmitSchedule::add())
+     *
+     * May be called while running; the frame joins at its next due time.
+     */
+    [[nodiscard]] int add(const RawCanFrame& frame, int64_t periodUs,
+                          int64_t phaseUs = TransmitSchedule::AUTO_PHASE);
+
+    /**
+     * @brief Replace a frame's payload from its next occurrence on
+     */
+    bool setPayload(int id, std::span<const uint8_t> payload) {
+        return m_schedule.setPayload(id, payload);
+    }
+
+    /**
+     * @brief Stop sending a frame
+     */
+    bool remove(int id);
+
+    /**
+     * @brief Create the timer and start sending
+     * @return false if the timerfd cannot be created, see errorString()
+     */
+    [[nodiscard]] bool start();
+
+    /**
+     * @brief Stop sending and release the timer (the schedule is kept)
+     */
+    void stop();
+
+    [[nodiscard]] bool isRunning() const { return m_timerFd >= 0; }
+
+    [[nodiscard]] const TransmitSchedule& schedule() const { return m_schedule; }
+
+    [[nodiscard]] QString errorString() const { return m_errorString; }
+
+    /**
+     * @brief Timing statistics: totals, lateness histogram and per-frame figures
+     */
+    [[nodiscard]] QJsonObject diagnostics() const;
+
+    /**
+     * @brief Current CLOCK_MONOTONIC time, the schedule's time base
+     */
+    [[nodiscard]] static int64_t nowUs();
+
+  private slots:
+    void onTimerExpired();
+
+  private:  // NOLINT(readability-redundant-access-specifiers) - Required for MOC
+    /// Arm the timer for the next due frame (disarm when none)
+    void arm();
+
+    TransmitSchedule m_schedule;
+    Writer m_writer;
+    int m_timerFd{-1};
+    std::unique_ptr<QSocketNotifier> m_notifier;
+    std::vector<RawCanFrame> m_batch;  ///< Due frames of one wake-up, reused
+    uint64_t m_wakeups{0};
+    QString m_errorString;
+};
+
+} // namespace devdash
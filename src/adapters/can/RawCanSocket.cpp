@@ -0,0 +1,349 @@
+/**
+ * @file RawCanSocket.cpp
+ * @brief Implementation of the batched raw SocketCAN socket.
+ */
+
+#include "RawCanSocket.h"
+
+#include <linux/can/raw.h>
+#include <linux/errqueue.h>
+#include <linux/net_tstamp.h>
+#include <net/if.h>
+#include <sys/ioctl.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+
+namespace devdash {
+
+namespace {
+
+//=============================================================================
+// Timestamp Options
+//=============================================================================
+
+/// Receive timestamps: kernel software time plus raw controller time if available
+constexpr int TIMESTAMPING_FLAGS = SOF_TIMESTAMPING_RX_SOFTWARE | SOF_TIMESTAMPING_SOFTWARE |
+                                   SOF_TIMESTAMPING_RX_HARDWARE |
+                                   SOF_TIMESTAMPING_RAW_HARDWARE;
+
+/// scm_timestamping::ts entries: software time and raw hardware time
+constexpr size_t TIMESTAMP_SOFTWARE = 0;
+constexpr size_t TIMESTAMP_RAW_HARDWARE = 2;
+
+constexpr int64_t NS_PER_SECOND = 1000000000;
+
+int64_t toNanoseconds(const timespec& time) {
+    return static_cast<int64_t>(time.tv_sec) * NS_PER_SECOND + time.tv_nsec;
+}
+
+//=============================================================================
+// Wire Format
+//=============================================================================
+
+/// Largest classic CAN payload
+constexpr uint8_t CLASSIC_CAN_MAX_PAYLOAD = 8;
+
+int setOption(int fd, int level, int option, int value) {
+    return ::setsockopt(fd, level, option, &value, sizeof(value));
+}
+
+} // anonymous namespace
+
+//=============================================================================
+// Construction / Destruction
+//=============================================================================
+
+RawCanSocket::RawCanSocket()
+    : m_ring(RING_CAPACITY),
+      m_wireFrames(BATCH_SIZE),
+      m_control(BATCH_SIZE),
+      m_iovecs(BATCH_SIZE),
+      m_messages(BATCH_SIZE),
+      m_sendFrames(BATCH_SIZE),
+      m_sendIovecs(BATCH_SIZE),
+      m_sendMessages(BATCH_SIZE) {
+    for (size_t i = 0; i < m_messages.size(); ++i) {
+        m_iovecs[i].iov_base = &m_wireFrames[i];
+        m_iovecs[i].iov_len = sizeof(canfd_frame);
+        m_messages[i].msg_hdr.msg_iov = &m_iovecs[i];
+        m_messages[i].msg_hdr.msg_iovlen = 1;
+        m_messages[i].msg_hdr.msg_control = m_control[i].bytes.data();
+
+        m_sendIovecs[i].iov_base = &m_sendFrames[i];
+        m_sendMessages[i].msg_hdr.msg_iov = &m_sendIovecs[i];
+        m_sendMessages[i].msg_hdr.msg_iovlen = 1;
+    }
+}
+
+RawCanSocket::~RawCanSocket() {
+    close();
+}
+
+//=============================================================================
+// Open / Close
+//=============================================================================
+
+bool RawCanSocket::open(const std::string& interface, bool canFd) {
+    close();
+    m_hasError = false;
+    m_kernelDrops = 0;
+    m_canFd = canFd;
+
+    const unsigned int interfaceIndex = ::if_nametoindex(interface.c_str());
+    if (interfaceIndex == 0) {
+        setError("Unknown CAN interface " + interface, errno);
+        return false;
+    }
+
+    m_fd = ::socket(PF_CAN, SOCK_RAW | SOCK_NONBLOCK | SOCK_CLOEXEC, CAN_RAW);
+    if (m_fd < 0) {
+        setError("Cannot create CAN socket", errno);
+        return false;
+    }
+
+    if (canFd && setOption(m_fd, SOL_CAN_RAW, CAN_RAW_FD_FRAMES, 1) != 0) {
+        setError("CAN FD not supported on " + interface, errno);
+        close();
+        return false;
+    }
+
+    sockaddr_can address{};
+    address.can_family = AF_CAN;
+    address.can_ifindex = static_cast<int>(interfaceIndex);
+    if (::bind(m_fd, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0) {
+        setError("Cannot bind to " + interface, errno);
+        close();
+        return false;
+    }
+
+    enableTimestamps();
+    // Best effort: only the drop counter is lost without it
+    setOption(m_fd, SOL_SOCKET, SO_RXQ_OVFL, 1);
+    return true;
+}
+
+void RawCanSocket::close() {
+    if (m_fd >= 0) {
+        ::close(m_fd);
+        m_fd = -1;
+    }
+    m_timestampSource = TimestampSource::None;
+}
+
+void RawCanSocket::enableTimestamps() {
+    if (setOption(m_fd, SOL_SOCKET, SO_TIMESTAMPING, TIMESTAMPING_FLAGS) == 0) {
+        // Hardware stamps only arrive if the driver supports them; fall back per frame
+        m_timestampSource = TimestampSource::Hardware;
+        return;
+    }
+    if (setOption(m_fd, SOL_SOCKET, SO_TIMESTAMPNS, 1) == 0) {
+        m_timestampSource = TimestampSource::Software;
+        return;
+    }
+    m_timestampSource = TimestampSource::None;
+}
+
+void RawCanSocket::setError(const std::string& what, int error) {
+    m_errorString = what + ": " + std::strerror(error);
+}
+
+//=============================================================================
+// Receive / Send
+//=============================================================================
+
+std::span<const RawCanFrame> RawCanSocket::readBatch() {
+    if (m_fd < 0) {
+        return {};
+    }
+
+    // Never wrap inside a batch, so the returned span is contiguous
+    if (m_ringHead == m_ring.size()) {
+        m_ringHead = 0;
+    }
+    const auto count = static_cast<unsigned int>(
+        std::min<size_t>(m_messages.size(), m_ring.size() - m_ringHead));
+    for (unsigned int i = 0; i < count; ++i) {
+        m_messages[i].msg_hdr.msg_controllen = CONTROL_BUFFER_SIZE;
+        m_messages[i].msg_hdr.msg_flags = 0;
+    }
+
+    const int received = ::recvmmsg(m_fd, m_messages.data(), count, MSG_DONTWAIT, nullptr);
+    if (received < 0) {
+        m_hasError = errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR;
+        if (m_hasError) {
+            setError("CAN receive failed", errno);
+        }
+        return {};
+    }
+    m_hasError = false;
+
+    const auto batchSize = static_cast<size_t>(received);
+    for (size_t i = 0; i < batchSize; ++i) {
+        const canfd_frame& wire = m_wireFrames[i];
+        msghdr& header = m_messages[i].msg_hdr;
+        RawCanFrame& frame = m_ring[m_ringHead + i];
+
+        frame.error = (wire.can_id & CAN_ERR_FLAG) != 0;
+        frame.extended = !frame.error && (wire.can_id & CAN_EFF_FLAG) != 0;
+        frame.remote = !frame.error && (wire.can_id & CAN_RTR_FLAG) != 0;
+        frame.frameId = wire.can_id & (frame.error      ? CAN_ERR_MASK
+                                       : frame.extended ? CAN_EFF_MASK
+                                                        : CAN_SFF_MASK);
+        frame.flexibleDataRate = m_messages[i].msg_len == CANFD_MTU;
+        frame.bitrateSwitch = frame.flexibleDataRate && (wire.flags & CANFD_BRS) != 0;
+        frame.length = std::min<uint8_t>(wire.len, frame.flexibleDataRate
+                                                       ? RawCanFrame::MAX_PAYLOAD
+                                                       : CLASSIC_CAN_MAX_PAYLOAD);
+        std::memcpy(frame.data.data(), wire.data, frame.length);
+        frame.timestampNs = 0;
+
+        for (cmsghdr* message = CMSG_FIRSTHDR(&header); message != nullptr;
+             message = CMSG_NXTHDR(&header, message)) {
+            if (message->cmsg_level != SOL_SOCKET) {
+                continue;
+            }
+            if (message->cmsg_type == SCM_TIMESTAMPING) {
+                scm_timestamping stamps{};
+                std::memcpy(&stamps, CMSG_DATA(message), sizeof(stamps));
+                const int64_t hardware = toNanoseconds(stamps.ts[TIMESTAMP_RAW_HARDWARE]);
+                frame.timestampNs =
+                    hardware != 0 ? hardware : toNanoseconds(stamps.ts[TIMESTAMP_SOFTWARE]);
+            } else if (message->cmsg_type == SCM_TIMESTAMPNS) {
+                timespec stamp{};
+                std::memcpy(&stamp, CMSG_DATA(message), sizeof(stamp));
+                frame.timestampNs = toNanoseconds(stamp);
+            } else if (message->cmsg_type == SO_RXQ_OVFL) {
+                std::memcpy(&m_kernelDrops, CMSG_DATA(message), sizeof(m_kernelDrops));
+            }
+        }
+    }
+
+    const std::span<const RawCanFrame> batch(m_ring.data() + m_ringHead, batchSize);
+    m_ringHead += batchSize;
+    return batch;
+}
+
+bool RawCanSocket::setFilters(std::span<const can_filter> filters) {
+    if (m_fd < 0) {
+        return false;
+    }
+
+    // Match-all filter, the kernel default
+    static constexpr can_filter RECEIVE_ALL{0, 0};
+    const std::span<const can_filter> installed =
+        filters.empty() ? std::span<const can_filter>(&RECEIVE_ALL, 1) : filters;
+    if (::setsockopt(m_fd, SOL_CAN_RAW, CAN_RAW_FILTER, installed.data(),
+                     static_cast<socklen_t>(installed.size_bytes())) != 0) {
+        setError("Cannot set CAN filters", errno);
+        return false;
+    }
+    return true;
+}
+
+bool RawCanSocket::setErrorFilter(uint32_t classes) {
+    if (m_fd < 0) {
+        return false;
+    }
+    const can_err_mask_t mask = classes & CAN_ERR_MASK;
+    if (::setsockopt(m_fd, SOL_CAN_RAW, CAN_RAW_ERR_FILTER, &mask, sizeof(mask)) != 0) {
+        setError("Cannot set CAN error filter", errno);
+        return false;
+    }
+    return true;
+}
+
+bool RawCanSocket::write(const RawCanFrame& frame) {
+    canfd_frame wire{};
+    size_t size = 0;
+    if (m_fd < 0 || !toWire(frame, wire, size)) {
+        return false;
+    }
+    return ::write(m_fd, &wire, size) == static_cast<ssize_t>(size);
+}
+
+size_t RawCanSocket::writeBatch(std::span<const RawCanFrame> frames) {
+    if (m_fd < 0) {
+        return 0;
+    }
+
+    size_t sent = 0;
+    while (sent < frames.size()) {
+        const size_t count = std::min(frames.size() - sent, m_sendMessages.size());
+        size_t prepared = 0;
+        while (prepared < count && toWire(frames[sent + prepared], m_sendFrames[prepared],
+                                          m_sendIovecs[prepared].iov_len)) {
+            ++prepared;
+        }
+        if (prepared == 0) {
+            break;  // Rejected frame
+        }
+
+        const int written = ::sendmmsg(m_fd, m_sendMessages.data(),
+                                       static_cast<unsigned int>(prepared), MSG_DONTWAIT);
+        if (written <= 0) {
+            break;  // Socket buffer full (ENOBUFS / EAGAIN) or interface down
+        }
+        sent += static_cast<size_t>(written);
+        if (static_cast<size_t>(written) < count) {
+            break;
+        }
+    }
+    return sent;
+}
+
+bool RawCanSocket::toWire(const RawCanFrame& frame, canfd_frame& wire, size_t& size) const {
+    const bool flexibleDataRate =
+        frame.flexibleDataRate || frame.length > CLASSIC_CAN_MAX_PAYLOAD;
+    // Error frames are generated by the controller, not sent
+    if ((flexibleDataRate && !m_canFd) || frame.length > RawCanFrame::MAX_PAYLOAD ||
+        frame.error) {
+        return false;
+    }
+
+    wire = canfd_frame{};
+    wire.can_id = frame.frameId;
+    if (frame.extended) {
+        wire.can_id |= CAN_EFF_FLAG;
+    }
+    if (frame.remote) {
+        wire.can_id |= CAN_RTR_FLAG;
+    }
+    wire.len = frame.length;
+    if (flexibleDataRate && frame.bitrateSwitch) {
+        wire.flags = CANFD_BRS;
+    }
+    std::memcpy(wire.data, frame.data.data(), frame.length);
+
+    size = flexibleDataRate ? CANFD_MTU : CAN_MTU;
+    return true;
+}
+
+//=============================================================================
+// Interface State
+//=============================================================================
+
+RawCanSocket::LinkState RawCanSocket::linkState(const std::string& interface) {
+    if (interface.empty() || interface.size() >= IFNAMSIZ ||
+        ::if_nametoindex(interface.c_str()) == 0) {
+        return LinkState::Missing;
+    }
+
+    // Any socket can query interface flags; a datagram socket needs no CAN support
+    const int fd = ::socket(AF_INET, SOCK_DGRAM | SOCK_CLOEXEC, 0);
+    if (fd < 0) {
+        return LinkState::Missing;
+    }
+    ifreq request{};
+    std::memcpy(request.ifr_name, interface.c_str(), interface.size());
+    const int result = ::ioctl(fd, SIOCGIFFLAGS, &request);
+    ::close(fd);
+    if (result != 0) {
+        return LinkState::Missing;
+    }
+    return (request.ifr_flags & IFF_UP) != 0 ? LinkState::Up : LinkState::Down;
+}
+
+} // namespace devdash
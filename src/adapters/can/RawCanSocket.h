@@ -0,0 +1,233 @@
+#pragma once
+
+#include <linux/can.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+
+#include <array>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace devdash {
+
+/**
+ * @brief One received CAN frame in the RawCanSocket ring (plain data, no heap)
+ */
+struct RawCanFrame {
+    /// Largest CAN FD payload
+    static constexpr int MAX_PAYLOAD = 64;
+
+    uint32_t frameId = 0;              ///< Identifier without flag bits
+    bool extended = false;             ///< 29-bit identifier
+    bool remote = false;               ///< Remote transmission request
+    bool error = false;                ///< Error frame: frameId holds the CAN_ERR_* class bits
+    bool flexibleDataRate = false;     ///< CAN FD frame
+    bool bitrateSwitch = false;        ///< CAN FD data phase at the data bitrate
+    uint8_t length = 0;                ///< Payload bytes (0-8, CAN FD up to 64)
+    std::array<uint8_t, MAX_PAYLOAD> data{};
+    int64_t timestampNs = 0;           ///< Receive time (CLOCK_REALTIME), 0 = unknown
+};
+
+/**
+ * @brief Raw SocketCAN socket drained in batches into a preallocated ring
+ *
+ * The native alternative to the QCanBus "socketcan" plugin for the receive
+ * hot path. The plugin reads one frame per read() system call and turns each
+ * into a QCanBusFrame with a heap-allocated payload. RawCanSocket instead:
+ *
+ * - drains up to BATCH_SIZE frames per recvmmsg() call, and sends batches
+ *   with sendmmsg() (writeBatch())
+ * - writes them into a ring of RING_CAPACITY RawCanFrames allocated once
+ *   at construction, so receiving never allocates
+ * - takes the receive timestamp from SO_TIMESTAMPING (hardware when the
+ *   controller provides it, kernel software otherwise), falling back to
+ *   SO_TIMESTAMPNS on kernels without it
+ * - reports frames the kernel dropped because the socket queue overflowed
+ *   (SO_RXQ_OVFL)
+ *
+ * Deliberately free of Qt so it can sit under any event loop: register
+ * fd() with a QSocketNotifier (or poll()) and call readBatch() until it
+ * returns an empty span.
+ *
+ * @code
+ * RawCanSocket socket;
+ * if (!socket.open("can0", false)) {
+ *     qWarning() << socket.errorString().c_str();
+ * }
+ * // when fd() is readable:
+ * for (auto batch = socket.readBatch(); !batch.empty(); batch = socket.readBatch()) {
+ *     for (const RawCanFrame& frame : batch) { ... }
+ * }
+ * @endcode
+ *
+ * @note Linux only. Not thread-safe.
+ */
+class RawCanSocket {
+  public:
+    /// Frames received per recvmmsg() call
+    static constexpr int BATCH_SIZE = 64;
+
+    /// Frames held in the ring; a returned batch stays valid for this many frames
+    static constexpr int RING_CAPACITY = 1024;
+
+    /**
+     * @brief Source of the frame timestamps
+     */
+    enum class TimestampSource {
+        None,      ///< No kernel timestamps (timestampNs is 0)
+        Software,  ///< Kernel receive time
+        Hardware,  ///< CAN controller time, software when a frame has none
+    };
+
+    /**
+     * @brief Administrative state of a network interface
+     */
+    enum class LinkState {
+        Missing,  ///< No such interface (e.g., USB adapter unplugged)
+        Down,     ///< Interface exists but is down
+        Up,       ///< Interface is up
+    };
+
+    RawCanSocket();
+    ~RawCanSocket();
+
+    // Owns a file descriptor
+    RawCanSocket(const RawCanSocket&) = delete;
+    RawCanSocket& operator=(const RawCanSocket&) = delete;
+    RawCanSocket(RawCanSocket&&) = delete;
+    RawCanSocket& operator=(RawCanSocket&&) = delete;
+
+    /**
+     * @brief Open a non-blocking raw socket bound to a CAN interface
+     *
+     * @param interface Interface name (e.g., "can0", "vcan0")
+     * @param canFd Also receive and send CAN FD frames
+     * @return false on failure, see errorString()
+     */
+    [[nodiscard]] bool open(const std::string& interface, bool canFd);
+
+    /**
+     * @brief Close the socket (the ring is kept for the next open())
+     */
+    void close();
+
+    [[nodiscard]] bool isOpen() const { return m_fd >= 0; }
+
+    /**
+     * @brief Socket descriptor for readiness notification, -1 when closed
+     */
+    [[nodiscard]] int fd() const { return m_fd; }
+
+    /**
+     * @brief Description of the last failure
+     */
+    [[nodiscard]] const std::string& errorString() const { return m_errorString; }
+
+    [[nodiscard]] TimestampSource timestampSource() const { return m_timestampSource; }
+
+    /**
+     * @brief Receive the frames queued on the socket, up to BATCH_SIZE
+     *
+     * Never blocks. The span points into the ring and is valid until
+     * RING_CAPACITY further frames have been read.
+     *
+     * @return Received frames; empty when nothing is queued or on error
+     *         (hasError() tells the two apart)
+     */
+    [[nodiscard]] std::span<const RawCanFrame> readBatch();
+
+    /**
+     * @brief Check whether the last readBatch() failed (e.g., interface went down)
+     */
+    [[nodiscard]] bool hasError() const { return m_hasError; }
+
+    /**
+     * @brief Send one frame (CAN FD frames need open() with canFd)
+     *
+     * @return false if the frame was rejected or the socket buffer is full
+     */
+    [[nodiscard]] bool write(const RawCanFrame& frame);
+
+    /**
+     * @brief Send frames with one sendmmsg() call per BATCH_SIZE frames
+     *
+     * Never blocks. Stops at the first frame that is rejected or does not
+     * fit the socket buffer.
+     *
+     * @return Frames sent, from the start of @p frames
+     */
+    [[nodiscard]] size_t writeBatch(std::span<const RawCanFrame> frames);
+
+    /**
+     * @brief Install kernel receive filters (CAN_RAW_FILTER)
+     *
+     * A frame is received when it matches any filter. Frames that match
+     * none are discarded in the kernel without waking the reader.
+     *
+     * @param filters Filters to install; empty restores receiving everything
+     * @return false if the kernel rejected the filters, see errorString()
+     */
+    [[nodiscard]] bool setFilters(std::span<const can_filter> filters);
+
+    /**
+     * @brief Receive error frames of the given classes (CAN_RAW_ERR_FILTER)
+     *
+     * Error frames are returned by readBatch() with error set and the
+     * CAN_ERR_* class bits (e.g., CAN_ERR_BUSOFF) in frameId.
+     *
+     * @param classes CAN_ERR_* class mask; 0 receives no error frames (default)
+     * @return false if the kernel rejected the filter, see errorString()
+     */
+    [[nodiscard]] bool setErrorFilter(uint32_t classes);
+
+    /**
+     * @brief Frames the kernel dropped because the receive queue was full
+     */
+    [[nodiscard]] uint32_t kernelDrops() const { return m_kernelDrops; }
+
+    /**
+     * @brief Check whether @p interface exists and is up
+     *
+     * Binding succeeds on an interface that is down, so this is checked
+     * before opening. Needs no open socket; safe to call from any thread.
+     */
+    [[nodiscard]] static LinkState linkState(const std::string& interface);
+
+  private:
+    /// Room for an SCM_TIMESTAMPING and an SO_RXQ_OVFL control message
+    static constexpr size_t CONTROL_BUFFER_SIZE = 128;
+
+    struct alignas(cmsghdr) ControlBuffer {
+        std::array<char, CONTROL_BUFFER_SIZE> bytes;
+    };
+
+    void enableTimestamps();
+    void setError(const std::string& what, int error);
+    [[nodiscard]] bool toWire(const RawCanFrame& frame, canfd_frame& wire, size_t& size) const;
+
+    int m_fd{-1};
+    bool m_canFd{false};
+    bool m_hasError{false};
+    TimestampSource m_timestampSource{TimestampSource::None};
+    std::string m_errorString;
+
+    std::vector<RawCanFrame> m_ring;
+    size_t m_ringHead{0};
+
+    /// recvmmsg() scratch space, allocated once
+    std::vector<canfd_frame> m_wireFrames;
+    std::vector<ControlBuffer> m_control;
+    std::vector<iovec> m_iovecs;
+    std::vector<mmsghdr> m_messages;
+
+    /// sendmmsg() scratch space, allocated once
+    std::vector<canfd_frame> m_sendFrames;
+    std::vector<iovec> m_sendIovecs;
+    std::vector<mmsghdr> m_sendMessages;
+
+    uint32_t m_kernelDrops{0};
+};
+
+} // namespace devdash
@@ -0,0 +1,134 @@
+/**
+ * @file ReconnectSupervisor.cpp
+ * @brief Implementation of the CAN interface reconnect state machine.
+ */
+
+#include "ReconnectSupervisor.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace devdash {
+
+//=============================================================================
+// Configuration
+//=============================================================================
+
+void ReconnectSupervisor::setOptions(const Options& options) {
+    m_options = options;
+    m_options.initialDelayUs = std::max<int64_t>(options.initialDelayUs, 1);
+    m_options.maxDelayUs = std::max(options.maxDelayUs, m_options.initialDelayUs);
+    m_options.backoffFactor = std::max(options.backoffFactor, 1.0);
+    m_options.busOffRestartUs = std::max<int64_t>(options.busOffRestartUs, 1);
+}
+
+//=============================================================================
+// State Transitions
+//=============================================================================
+
+void ReconnectSupervisor::start(int64_t /*nowUs*/) {
+    m_stats = Stats{};
+    m_state = State::Connecting;
+    m_delayUs = m_options.initialDelayUs;
+    m_nextAttemptUs = NO_ATTEMPT;
+    m_outageStartUs = NO_OUTAGE;
+    m_attemptsSinceConnected = 1;
+    ++m_stats.attempts;
+}
+
+void ReconnectSupervisor::stop() {
+    m_state = State::Stopped;
+    m_nextAttemptUs = NO_ATTEMPT;
+    m_outageStartUs = NO_OUTAGE;
+}
+
+bool ReconnectSupervisor::beginAttempt(int64_t nowUs) {
+    if ((m_state != State::Backoff && m_state != State::BusOff) || nowUs < m_nextAttemptUs) {
+        return false;
+    }
+    m_state = State::Connecting;
+    m_nextAttemptUs = NO_ATTEMPT;
+    ++m_attemptsSinceConnected;
+    ++m_stats.attempts;
+    return true;
+}
+
+int64_t ReconnectSupervisor::onConnected(int64_t nowUs) {
+    if (m_state != State::Connecting && m_state != State::BusOff) {
+        return 0;
+    }
+    m_state = State::Connected;
+    m_nextAttemptUs = NO_ATTEMPT;
+    m_delayUs = m_options.initialDelayUs;
+    m_attemptsSinceConnected = 0;
+    if (m_outageStartUs == NO_OUTAGE) {
+        return 0;
+    }
+
+    const int64_t outage = std::max<int64_t>(nowUs - m_outageStartUs, 0);
+    m_outageStartUs = NO_OUTAGE;
+    ++m_stats.recoveries;
+    m_stats.lastRecoveryUs = outage;
+    m_stats.maxRecoveryUs = std::max(m_stats.maxRecoveryUs, outage);
+    m_stats.totalOutageUs += outage;
+    return outage;
+}
+
+void ReconnectSupervisor::onAttemptFailed(int64_t nowUs) {
+    if (m_state != State::Connecting) {
+        return;
+    }
+    ++m_stats.failedAttempts;
+    m_state = State::Backoff;
+    m_nextAttemptUs = nowUs + m_delayUs;
+    const double grown = static_cast<double>(m_delayUs) * m_options.backoffFactor;
+    m_delayUs = std::min(m_options.maxDelayUs,
+                         std::max(m_delayUs, static_cast<int64_t>(std::llround(grown))));
+}
+
+void ReconnectSupervisor::onLinkLost(int64_t nowUs) {
+    if (m_state != State::Connected && m_state != State::BusOff) {
+        return;
+    }
+    ++m_stats.linkLosses;
+    beginOutage(nowUs);
+    m_state = State::Backoff;
+    m_delayUs = m_options.initialDelayUs;
+    m_nextAttemptUs = nowUs + m_delayUs;
+}
+
+void ReconnectSupervisor::onBusOff(int64_t nowUs) {
+    if (m_state != State::Connected) {
+        return;
+    }
+    ++m_stats.busOffs;
+    beginOutage(nowUs);
+    m_state = State::BusOff;
+    m_delayUs = m_options.initialDelayUs;
+    m_nextAttemptUs = nowUs + m_options.busOffRestartUs;
+}
+
+//=============================================================================
+// Queries
+//=============================================================================
+
+int64_t ReconnectSupervisor::nextAttemptUs() const {
+    return m_state == State::Backoff || m_state == State::BusOff ? m_nextAttemptUs : NO_ATTEMPT;
+}
+
+int64_t ReconnectSupervisor::outageUs(int64_t nowUs) const {
+    return m_outageStartUs == NO_OUTAGE ? 0 : std::max<int64_t>(nowUs - m_outageStartUs, 0);
+}
+
+//=============================================================================
+// Private Methods
+//=============================================================================
+
+void ReconnectSupervisor::beginOutage(int64_t nowUs) {
+    if (m_outageStartUs == NO_OUTAGE) {
+        m_outageStartUs = nowUs;
+    }
+    m_attemptsSinceConnected = 0;
+}
+
+} // namespace devdash
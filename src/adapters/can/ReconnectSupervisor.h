@@ -0,0 +1,183 @@
+#pragma once
+
+#include <cstdint>
+#include <limits>
+
+namespace devdash {
+
+/**
+ * @brief Decides when a lost CAN interface is reopened, and measures the outage
+ *
+ * A loose connector or an interface that is briefly brought down at speed
+ * should cost the dash a few hundred milliseconds of data, not a restart.
+ * The supervisor tracks the connection through these states:
+ *
+ * - Connecting: an open attempt is running (off the UI thread in CanAdapter)
+ * - Connected: frames are flowing
+ * - Backoff: the link was lost or an attempt failed; the next attempt is
+ *   due after a delay that starts at initialDelayUs and doubles with every
+ *   failed attempt up to maxDelayUs, so an unplugged adapter is retried
+ *   quickly at first without spinning for the rest of the drive
+ * - BusOff: the controller went bus-off; the interface stays open for
+ *   busOffRestartUs so the controller (or the kernel's restart-ms) can
+ *   restart it, after which the interface is closed and reopened
+ *
+ * Each outage (link loss or bus-off until connected again) is one recovery;
+ * its duration is the metric the adapter publishes. The connection that
+ * start() begins is not an outage: a dash that boots before its CAN adapter
+ * is plugged in has not lost anything.
+ *
+ * Time is passed in by the caller (microseconds, any monotonic clock), so
+ * the state machine is deterministic under test. Deliberately free of Qt
+ * and of socket I/O; CanAdapter opens the interface and reports back.
+ *
+ * @code
+ * ReconnectSupervisor supervisor;
+ * supervisor.start(now);              // Connecting: open the interface
+ * supervisor.onAttemptFailed(now);    // Backoff
+ * // at supervisor.nextAttemptUs():
+ * if (supervisor.beginAttempt(now)) { open(); }
+ * supervisor.onConnected(now);
+ * @endcode
+ *
+ * @note Not thread-safe; owned and used by the adapter's thread.
+ */
+class ReconnectSupervisor {
+  public:
+    /// Returned by nextAttemptUs() when no attempt is scheduled
+    static constexpr int64_t NO_ATTEMPT = std::numeric_limits<int64_t>::max();
+
+    /**
+     * @brief Connection state
+     */
+    enum class State {
+        Stopped,     ///< Not supervising (before start(), after stop())
+        Connecting,  ///< Open attempt in progress
+        Connected,   ///< Interface open and usable
+        Backoff,     ///< Waiting for the next open attempt
+        BusOff,      ///< Controller bus-off, waiting for it to restart
+    };
+
+    /**
+     * @brief Retry timing
+     */
+    struct Options {
+        int64_t initialDelayUs = 100000;    ///< First retry after a loss or failed open
+        int64_t maxDelayUs = 5000000;       ///< Longest delay between attempts
+        double backoffFactor = 2.0;         ///< Delay growth per failed attempt
+        int64_t busOffRestartUs = 500000;   ///< Bus-off time before the interface is reopened
+    };
+
+    /**
+     * @brief Outage and recovery statistics
+     */
+    struct Stats {
+        uint64_t linkLosses = 0;       ///< Interface lost (down, unplugged, read error)
+        uint64_t busOffs = 0;          ///< Controller bus-off events
+        uint64_t attempts = 0;         ///< Open attempts, including the first
+        uint64_t failedAttempts = 0;   ///< Open attempts that failed
+        uint64_t recoveries = 0;       ///< Outages that ended connected
+        int64_t lastRecoveryUs = 0;    ///< Duration of the last outage
+        int64_t maxRecoveryUs = 0;     ///< Longest outage
+        int64_t totalOutageUs = 0;     ///< Time lost to ended outages
+    };
+
+    ReconnectSupervisor() = default;
+
+    /**
+     * @brief Set the retry timing (delays are clamped to at least 1 us)
+     */
+    void setOptions(const Options& options);
+
+    [[nodiscard]] const Options& options() const { return m_options; }
+
+    /**
+     * @brief Start supervising; the caller opens the interface now (Connecting)
+     *
+     * Resets the statistics.
+     */
+    void start(int64_t nowUs);
+
+    /**
+     * @brief Stop supervising; results of a running attempt are ignored
+     */
+    void stop();
+
+    /**
+     * @brief Start the scheduled attempt if it is due (Backoff or BusOff)
+     *
+     * @return true if the caller should now open the interface (Connecting)
+     */
+    [[nodiscard]] bool beginAttempt(int64_t nowUs);
+
+    /**
+     * @brief The open attempt succeeded, or a bus-off controller restarted
+     *
+     * @return Duration of the outage that ended, 0 if there was none
+     */
+    int64_t onConnected(int64_t nowUs);
+
+    /**
+     * @brief The open attempt failed: retry after the current backoff delay
+     */
+    void onAttemptFailed(int64_t nowUs);
+
+    /**
+     * @brief The open interface failed (went down, disappeared, read error)
+     *
+     * Starts an outage and retries after initialDelayUs. Ignored unless
+     * Connected or BusOff.
+     */
+    void onLinkLost(int64_t nowUs);
+
+    /**
+     * @brief The controller reported bus-off
+     *
+     * Starts an outage; the interface is reopened after busOffRestartUs
+     * unless onConnected() reports the restart first. Ignored unless
+     * Connected.
+     */
+    void onBusOff(int64_t nowUs);
+
+    [[nodiscard]] State state() const { return m_state; }
+
+    [[nodiscard]] bool isConnected() const { return m_state == State::Connected; }
+
+    /**
+     * @brief Time the next attempt is due, NO_ATTEMPT unless in Backoff or BusOff
+     */
+    [[nodiscard]] int64_t nextAttemptUs() const;
+
+    /**
+     * @brief Delay the next failed attempt will wait
+     */
+    [[nodiscard]] int64_t currentDelayUs() const { return m_delayUs; }
+
+    /**
+     * @brief Duration of the current outage, 0 when there is none
+     */
+    [[nodiscard]] int64_t outageUs(int64_t nowUs) const;
+
+    /**
+     * @brief Open attempts since the current outage (or start()) began
+     */
+    [[nodiscard]] int attemptsSinceConnected() const { return m_attemptsSinceConnected; }
+
+    [[nodiscard]] const Stats& stats() const { return m_stats; }
+
+  private:
+    /// Marks "no outage in progress"
+    static constexpr int64_t NO_OUTAGE = -1;
+
+    void beginOutage(int64_t nowUs);
+
+    Options m_options;
+    State m_state{State::Stopped};
+    int64_t m_delayUs{0};
+    int64_t m_nextAttemptUs{NO_ATTEMPT};
+    int64_t m_outageStartUs{NO_OUTAGE};
+    int m_attemptsSinceConnected{0};
+    Stats m_stats;
+};
+
+} // namespace devdash
@@ -0,0 +1,338 @@
+/**
+ * @file SlcanFrameSource.cpp
+ * @brief Implementation of the serial SLCAN frame source.
+ */
+
+#include "SlcanFrameSource.h"
+
+#include <QDebug>
+#include <QJsonObject>
+
+#include <fcntl.h>
+#include <termios.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <utility>
+
+namespace devdash {
+
+namespace {
+
+//=============================================================================
+// Protocol Constants
+//=============================================================================
+
+constexpr const char* SOURCE_NAME = "slcan";
+
+constexpr const char* COMMAND_CLOSE = "C\r";
+constexpr const char* COMMAND_OPEN = "O\r";
+constexpr const char* COMMAND_LISTEN = "L\r";
+
+constexpr int BITS_PER_KBIT = 1000;
+constexpr double NS_PER_SECOND = 1e9;
+constexpr double BYTES_PER_MB = 1e6;
+
+/// S command digit of each bitrate the protocol defines
+constexpr std::array<std::pair<int, int>, 9> BITRATE_CODES = {{
+    {10000, 0},
+    {20000, 1},
+    {50000, 2},
+    {100000, 3},
+    {125000, 4},
+    {250000, 5},
+    {500000, 6},
+    {800000, 7},
+    {1000000, 8},
+}};
+
+/// termios speed of each supported baud rate
+constexpr std::array<std::pair<int, speed_t>, 11> BAUD_RATES = {{
+    {9600, B9600},
+    {19200, B19200},
+    {38400, B38400},
+    {57600, B57600},
+    {115200, B115200},
+    {230400, B230400},
+    {460800, B460800},
+    {921600, B921600},
+    {1000000, B1000000},
+    {2000000, B2000000},
+    {3000000, B3000000},
+}};
+
+int64_t steadyNowNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+
+int64_t realtimeNowNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::system_clock::now().time_since_epoch())
+        .count();
+}
+
+} // anonymous namespace
+
+//=============================================================================
+// Construction / Destruction
+//=============================================================================
+
+SlcanFrameSource::SlcanFrameSource(const Options& options, QObject* parent)
+    : ICanFrameSource(parent), m_options(options), m_readBuffer(READ_CHUNK_SIZE),
+      m_batch(DELIVERY_BATCH) {}
+
+SlcanFrameSource::~SlcanFrameSource() {
+    stop();
+}
+
+int SlcanFrameSource::bitrateCode(int bitrate) {
+    const auto* it = std::find_if(BITRATE_CODES.begin(), BITRATE_CODES.end(),
+                                  [bitrate](const auto& entry) { return entry.first == bitrate; });
+    return it == BITRATE_CODES.end() ? -1 : it->second;
+}
+
+//=============================================================================
+// Source Control
+//=============================================================================
+
+bool SlcanFrameSource::open() {
+    if (m_fd >= 0) {
+        return true;
+    }
+    m_errorString.clear();
+
+    const int code = m_options.bitrate > 0 ? bitrateCode(m_options.bitrate) : -1;
+    if (m_options.bitrate > 0 && code < 0) {
+        m_errorString =
+            QStringLiteral("SLCAN has no command for bitrate %1").arg(m_options.bitrate);
+        return false;
+    }
+
+    m_fd = ::open(m_options.device.toLocal8Bit().constData(),
+                  O_RDWR | O_NOCTTY | O_NONBLOCK | O_CLOEXEC);
+    if (m_fd < 0) {
+        fail(QStringLiteral("open ") + m_options.device, errno);
+        return false;
+    }
+    if (!configureTty()) {
+        closeDevice();
+        return false;
+    }
+
+    // A dongle left open by a previous run rejects S; closing an already
+    // closed channel only costs a BEL reply
+    std::array<char, 4> setBitrate = {'S', static_cast<char>('0' + code), '\r', '\0'};
+    if (!sendCommand(COMMAND_CLOSE) || (code >= 0 && !sendCommand(setBitrate.data()))) {
+        closeDevice();
+        return false;
+    }
+
+    m_parser.reset();
+    m_notifier = std::make_unique<QSocketNotifier>(m_fd, QSocketNotifier::Read);
+    // Parented so it follows the source when it is moved to an I/O thread
+    m_notifier->setParent(this);
+    m_notifier->setEnabled(false);
+    connect(m_notifier.get(), &QSocketNotifier::activated, this, &SlcanFrameSource::onReadable);
+    return true;
+}
+
+void SlcanFrameSource::start() {
+    if (m_running || (m_fd < 0 && !open())) {
+        return;
+    }
+    if (!sendCommand(m_options.listenOnly ? COMMAND_LISTEN : COMMAND_OPEN)) {
+        qWarning() << "SlcanFrameSource:" << m_errorString;
+        return;
+    }
+    m_running = true;
+    m_readCalls = 0;
+    m_parseNs = 0;
+    m_startedNs = steadyNowNs();
+    m_notifier->setEnabled(true);
+}
+
+void SlcanFrameSource::stop() {
+    if (m_fd < 0) {
+        return;
+    }
+    if (m_running) {
+        (void)sendCommand(COMMAND_CLOSE);
+    }
+    m_running = false;
+    closeDevice();
+}
+
+bool SlcanFrameSource::writeFrame(const RawCanFrame& frame) {
+    if (m_fd < 0 || m_options.listenOnly) {
+        return false;
+    }
+    std::array<char, SlcanParser::MAX_ENCODED_LENGTH> line{};
+    const size_t length = SlcanParser::encode(frame, line);
+    if (length == 0) {
+        return false;
+    }
+    return ::write(m_fd, line.data(), length) == static_cast<ssize_t>(length);
+}
+
+//=============================================================================
+// Source Description
+//=============================================================================
+
+QString SlcanFrameSource::sourceName() const {
+    return QString::fromLatin1(SOURCE_NAME);
+}
+
+QString SlcanFrameSource::description() const {
+    const QString bitrate = m_options.bitrate > 0
+                                ? QString::number(m_options.bitrate / BITS_PER_KBIT) + " kbit/s"
+                                : QStringLiteral("dongle bitrate");
+    return m_options.device + " at " + bitrate + (m_options.listenOnly ? " (listen-only)" : "");
+}
+
+QJsonObject SlcanFrameSource::diagnostics() const {
+    const SlcanParser::Stats& stats = m_parser.stats();
+    QJsonObject slcan;
+    slcan["device"] = m_options.device;
+    slcan["bitrate"] = m_options.bitrate;
+    slcan["baudRate"] = m_options.baudRate;
+    slcan["listenOnly"] = m_options.listenOnly;
+    slcan["open"] = m_fd >= 0;
+    slcan["bytes"] = static_cast<qint64>(stats.bytes);
+    slcan["frames"] = static_cast<qint64>(stats.frames);
+    slcan["malformed"] = static_cast<qint64>(stats.malformed);
+    slcan["overflows"] = static_cast<qint64>(stats.overflows);
+    slcan["errorReplies"] = static_cast<qint64>(stats.errors);
+    slcan["transmitAcks"] = static_cast<qint64>(stats.transmitAcks);
+    slcan["reads"] = static_cast<qint64>(m_readCalls);
+
+    // Parse throughput: time in the parser only, decoding excluded
+    if (stats.frames > 0 && m_parseNs > 0) {
+        const auto parseNs = static_cast<double>(m_parseNs);
+        slcan["parseNsPerFrame"] = parseNs / static_cast<double>(stats.frames);
+        slcan["parseMBps"] = static_cast<double>(stats.bytes) / BYTES_PER_MB /
+                             (parseNs / NS_PER_SECOND);
+    }
+    if (m_running && m_readCalls > 0) {
+        const auto elapsedNs = static_cast<double>(steadyNowNs() - m_startedNs);
+        slcan["bytesPerRead"] =
+            static_cast<double>(stats.bytes) / static_cast<double>(m_readCalls);
+        slcan["framesPerSecond"] = static_cast<double>(stats.frames) * NS_PER_SECOND / elapsedNs;
+    }
+    return slcan;
+}
+
+//=============================================================================
+// Private Slots
+//=============================================================================
+
+void SlcanFrameSource::onReadable() {
+    // Frames are collected in batches so the parse time can be measured
+    // without timing every frame
+    size_t batched = 0;
+    int64_t deliverNs = 0;
+    const auto flush = [this, &batched, &deliverNs]() {
+        const int64_t started = steadyNowNs();
+        for (size_t i = 0; i < batched && m_running; ++i) {
+            deliver(m_batch[i]);
+        }
+        batched = 0;
+        deliverNs += steadyNowNs() - started;
+    };
+
+    for (int i = 0; i < MAX_READS_PER_PASS && m_running; ++i) {
+        const ssize_t bytesRead = ::read(m_fd, m_readBuffer.data(), m_readBuffer.size());
+        if (bytesRead < 0 && errno == EINTR) {
+            continue;
+        }
+        if (bytesRead < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+            return;
+        }
+        if (bytesRead <= 0) {
+            // EIO or end of file: the dongle was unplugged (or the pty closed)
+            fail(QStringLiteral("read ") + m_options.device, bytesRead < 0 ? errno : EIO);
+            qWarning() << "SlcanFrameSource:" << m_errorString;
+            m_running = false;
+            m_notifier->setEnabled(false);
+            emit finished();
+            return;
+        }
+
+        ++m_readCalls;
+        const int64_t started = steadyNowNs();
+        deliverNs = 0;
+        m_parser.setReceiveTime(realtimeNowNs());
+        m_parser.feed(std::span<const char>(m_readBuffer.data(), static_cast<size_t>(bytesRead)),
+                      [this, &batched, &flush](const RawCanFrame& frame) {
+                          m_batch[batched++] = frame;
+                          if (batched == m_batch.size()) {
+                              flush();
+                          }
+                      });
+        flush();
+        m_parseNs += steadyNowNs() - started - deliverNs;
+    }
+}
+
+//=============================================================================
+// Private Methods
+//=============================================================================
+
+bool SlcanFrameSource::configureTty() {
+    termios tty{};
+    if (::tcgetattr(m_fd, &tty) != 0) {
+        fail(QStringLiteral("tcgetattr"), errno);
+        return false;
+    }
+    ::cfmakeraw(&tty);
+    tty.c_cflag |= CLOCAL | CREAD;
+
+    const auto* baud =
+        std::find_if(BAUD_RATES.begin(), BAUD_RATES.end(),
+                     [this](const auto& entry) { return entry.first == m_options.baudRate; });
+    if (baud == BAUD_RATES.end()) {
+        m_errorString = QStringLiteral("Unsupported baud rate %1").arg(m_options.baudRate);
+        return false;
+    }
+    ::cfsetispeed(&tty, baud->second);
+    ::cfsetospeed(&tty, baud->second);
+
+    if (::tcsetattr(m_fd, TCSANOW, &tty) != 0) {
+        fail(QStringLiteral("tcsetattr"), errno);
+        return false;
+    }
+    ::tcflush(m_fd, TCIOFLUSH);
+    return true;
+}
+
+bool SlcanFrameSource::sendCommand(const char* command) {
+    const size_t length = std::strlen(command);
+    if (::write(m_fd, command, length) != static_cast<ssize_t>(length)) {
+        fail(QStringLiteral("write ") + m_options.device, errno);
+        return false;
+    }
+    return true;
+}
+
+void SlcanFrameSource::closeDevice() {
+    if (m_notifier) {
+        // Deferred: stop() may be called from a frame handler inside onReadable()
+        m_notifier->setEnabled(false);
+        m_notifier.release()->deleteLater();
+    }
+    if (m_fd >= 0) {
+        ::close(m_fd);
+        m_fd = -1;
+    }
+}
+
+void SlcanFrameSource::fail(const QString& what, int error) {
+    m_errorString = what + ": " + QString::fromLocal8Bit(std::strerror(error));
+}
+
+} // namespace devdash
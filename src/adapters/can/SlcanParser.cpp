@@ -0,0 +1,236 @@
+/**
+ * @file SlcanParser.cpp
+ * @brief Implementation of the table-driven SLCAN line decoder.
+ */
+
+#include "SlcanParser.h"
+
+#include <algorithm>
+
+namespace devdash {
+
+namespace {
+
+//=============================================================================
+// Line Layout
+//=============================================================================
+
+constexpr size_t STANDARD_ID_DIGITS = 3;
+constexpr size_t EXTENDED_ID_DIGITS = 8;
+constexpr size_t TIMESTAMP_DIGITS = 4;
+
+constexpr uint32_t MAX_STANDARD_ID = 0x7FF;
+constexpr uint32_t MAX_EXTENDED_ID = 0x1FFFFFFF;
+constexpr int MAX_CLASSIC_LENGTH = 8;
+
+constexpr int BITS_PER_HEX_DIGIT = 4;
+constexpr uint8_t HEX_DIGIT_MASK = 0x0F;
+
+constexpr char TRANSMIT_ACK_STANDARD = 'z';
+constexpr char TRANSMIT_ACK_EXTENDED = 'Z';
+
+/// Replies to version ('V', 'v'), serial number ('N') and status flag ('F') queries
+constexpr std::string_view REPLY_TYPES = "VvNF";
+
+constexpr std::array<char, 16> HEX_DIGITS = {'0', '1', '2', '3', '4', '5', '6', '7',
+                                             '8', '9', 'A', 'B', 'C', 'D', 'E', 'F'};
+
+/// CAN FD payload length of each DLC code
+constexpr std::array<uint8_t, 16> FD_LENGTHS = {0, 1, 2,  3,  4,  5,  6,  7,
+                                                8, 12, 16, 20, 24, 32, 48, 64};
+
+//=============================================================================
+// Frame Formats
+//=============================================================================
+
+/**
+ * @brief Layout of one frame line type
+ */
+struct FrameFormat {
+    char type;
+    bool extended;
+    bool remote;
+    bool flexibleDataRate;
+    bool bitrateSwitch;
+};
+
+constexpr std::array<FrameFormat, 8> FRAME_FORMATS = {{
+    {'t', false, false, false, false},
+    {'T', true, false, false, false},
+    {'r', false, true, false, false},
+    {'R', true, true, false, false},
+    {'d', false, false, true, false},
+    {'D', true, false, true, false},
+    {'b', false, false, true, true},
+    {'B', true, false, true, true},
+}};
+
+//=============================================================================
+// Hex Decoding
+//=============================================================================
+
+/**
+ * @brief Value of every character as a hex digit, -1 if it is none
+ *
+ * Invalid digits are negative, so OR-ing all digits of a line into one int
+ * and testing its sign validates the line with a single branch.
+ */
+constexpr std::array<int8_t, 256> makeHexTable() {
+    std::array<int8_t, 256> table{};
+    table.fill(-1);
+    for (size_t i = 0; i < HEX_DIGITS.size(); ++i) {
+        const char digit = HEX_DIGITS[i];
+        table[static_cast<uint8_t>(digit)] = static_cast<int8_t>(i);
+        if (digit >= 'A') {
+            // Lowercase a-f as well
+            table[static_cast<uint8_t>(digit - 'A' + 'a')] = static_cast<int8_t>(i);
+        }
+    }
+    return table;
+}
+
+constexpr std::array<int8_t, 256> HEX_VALUES = makeHexTable();
+
+int hexValue(char digit) {
+    return HEX_VALUES[static_cast<uint8_t>(digit)];
+}
+
+const FrameFormat* findFormat(char type) {
+    const auto* it =
+        std::find_if(FRAME_FORMATS.begin(), FRAME_FORMATS.end(),
+                     [type](const FrameFormat& format) { return format.type == type; });
+    return it == FRAME_FORMATS.end() ? nullptr : it;
+}
+
+/**
+ * @brief DLC digit for a payload length, -1 if the length has none
+ */
+int dlcFor(const RawCanFrame& frame) {
+    if (!frame.flexibleDataRate) {
+        return frame.length <= MAX_CLASSIC_LENGTH ? frame.length : -1;
+    }
+    const auto* it = std::find(FD_LENGTHS.begin(), FD_LENGTHS.end(), frame.length);
+    return it == FD_LENGTHS.end() ? -1 : static_cast<int>(it - FD_LENGTHS.begin());
+}
+
+} // anonymous namespace
+
+//=============================================================================
+// Parsing
+//=============================================================================
+
+SlcanParser::LineType SlcanParser::parseLine(std::string_view line, RawCanFrame& frame) {
+    if (line.empty()) {
+        return LineType::Ack;
+    }
+    const FrameFormat* format = findFormat(line[0]);
+    if (format == nullptr) {
+        if (line.size() == 1 &&
+            (line[0] == TRANSMIT_ACK_STANDARD || line[0] == TRANSMIT_ACK_EXTENDED)) {
+            return LineType::TransmitAck;
+        }
+        return REPLY_TYPES.find(line[0]) != std::string_view::npos ? LineType::Reply
+                                                                    : LineType::Malformed;
+    }
+
+    const size_t idDigits = format->extended ? EXTENDED_ID_DIGITS : STANDARD_ID_DIGITS;
+    const size_t headerLength = 1 + idDigits + 1;
+    if (line.size() < headerLength) {
+        return LineType::Malformed;
+    }
+
+    // Negative as soon as any digit is invalid
+    int invalid = 0;
+    uint32_t frameId = 0;
+    for (size_t i = 1; i <= idDigits; ++i) {
+        const int digit = hexValue(line[i]);
+        invalid |= digit;
+        frameId = (frameId << BITS_PER_HEX_DIGIT) | (static_cast<uint32_t>(digit) & HEX_DIGIT_MASK);
+    }
+    const int dlc = hexValue(line[headerLength - 1]);
+    if (dlc < 0 || (!format->flexibleDataRate && dlc > MAX_CLASSIC_LENGTH)) {
+        return LineType::Malformed;
+    }
+    const uint8_t length = format->flexibleDataRate ? FD_LENGTHS[static_cast<size_t>(dlc)]
+                                                    : static_cast<uint8_t>(dlc);
+
+    const size_t dataDigits = format->remote ? 0 : size_t{2} * length;
+    const size_t trailing = line.size() - headerLength;
+    if (trailing != dataDigits && trailing != dataDigits + TIMESTAMP_DIGITS) {
+        return LineType::Malformed;
+    }
+
+    const char* digits = line.data() + headerLength;
+    for (size_t i = 0; i < dataDigits / 2; ++i) {
+        const int high = hexValue(digits[2 * i]);
+        const int low = hexValue(digits[(2 * i) + 1]);
+        invalid |= high | low;
+        frame.data[i] = static_cast<uint8_t>((high << BITS_PER_HEX_DIGIT) | (low & HEX_DIGIT_MASK));
+    }
+    for (size_t i = dataDigits; i < trailing; ++i) {
+        invalid |= hexValue(digits[i]);  // Timestamp: validated, not used
+    }
+
+    const uint32_t maxId = format->extended ? MAX_EXTENDED_ID : MAX_STANDARD_ID;
+    if (invalid < 0 || frameId > maxId) {
+        return LineType::Malformed;
+    }
+
+    frame.frameId = frameId;
+    frame.extended = format->extended;
+    frame.remote = format->remote;
+    frame.error = false;
+    frame.flexibleDataRate = format->flexibleDataRate;
+    frame.bitrateSwitch = format->bitrateSwitch;
+    frame.length = length;
+    frame.timestampNs = 0;
+    return LineType::Frame;
+}
+
+std::string_view SlcanParser::stripErrors(std::string_view line) {
+    const size_t errors = std::min(line.find_first_not_of(BELL), line.size());
+    m_stats.errors += errors;
+    return line.substr(errors);
+}
+
+void SlcanParser::reset() {
+    m_carryLength = 0;
+    m_discarding = false;
+    m_stats = Stats{};
+}
+
+//=============================================================================
+// Encoding
+//=============================================================================
+
+size_t SlcanParser::encode(const RawCanFrame& frame, std::span<char, MAX_ENCODED_LENGTH> out) {
+    const int dlc = dlcFor(frame);
+    const auto* format = std::find_if(
+        FRAME_FORMATS.begin(), FRAME_FORMATS.end(), [&frame](const FrameFormat& candidate) {
+            return candidate.extended == frame.extended && candidate.remote == frame.remote &&
+                   candidate.flexibleDataRate == frame.flexibleDataRate &&
+                   candidate.bitrateSwitch == (frame.flexibleDataRate && frame.bitrateSwitch);
+        });
+    if (frame.error || dlc < 0 || format == FRAME_FORMATS.end()) {
+        return 0;
+    }
+
+    size_t pos = 0;
+    out[pos++] = format->type;
+    const size_t idDigits = frame.extended ? EXTENDED_ID_DIGITS : STANDARD_ID_DIGITS;
+    for (size_t i = idDigits; i > 0; --i) {
+        const auto shift = static_cast<uint32_t>((i - 1) * BITS_PER_HEX_DIGIT);
+        out[pos++] = HEX_DIGITS[(frame.frameId >> shift) & HEX_DIGIT_MASK];
+    }
+    out[pos++] = HEX_DIGITS[static_cast<size_t>(dlc)];
+    if (!frame.remote) {
+        for (size_t i = 0; i < frame.length; ++i) {
+            out[pos++] = HEX_DIGITS[frame.data[i] >> BITS_PER_HEX_DIGIT];
+            out[pos++] = HEX_DIGITS[frame.data[i] & HEX_DIGIT_MASK];
+        }
+    }
+    out[pos++] = LINE_END;
+    return pos;
+}
+
+} // namespace devdash
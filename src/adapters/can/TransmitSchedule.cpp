@@ -0,0 +1,233 @@
+/**
+ * @file TransmitSchedule.cpp
+ * @brief Implementation of the periodic CAN transmit schedule.
+ */
+
+#include "TransmitSchedule.h"
+
+#include <algorithm>
+
+namespace devdash {
+
+namespace {
+
+/// Largest classic CAN payload
+constexpr size_t MAX_CLASSIC_LENGTH = 8;
+
+} // anonymous namespace
+
+//=============================================================================
+// Configuration
+//=============================================================================
+
+void TransmitSchedule::setOptions(const Options& options) {
+    m_options = options;
+    m_options.toleranceUs = std::max<int64_t>(options.toleranceUs, 0);
+}
+
+int TransmitSchedule::add(const RawCanFrame& frame, int64_t periodUs, int64_t phaseUs) {
+    // Without the current time a running schedule cannot place the frame
+    if (m_running) {
+        return -1;
+    }
+    return add(frame, periodUs, phaseUs, 0);
+}
+
+int TransmitSchedule::add(const RawCanFrame& frame, int64_t periodUs, int64_t phaseUs,
+                          int64_t nowUs) {
+    if (periodUs < MIN_PERIOD_US || frame.error) {
+        return -1;
+    }
+
+    Entry entry;
+    entry.frame = frame;
+    entry.frame.timestampNs = 0;
+    entry.periodUs = periodUs;
+    if (phaseUs == AUTO_PHASE) {
+        entry.phaseUs = (m_autoPhased++ * AUTO_PHASE_STEP_US) % periodUs;
+    } else {
+        entry.phaseUs = std::clamp<int64_t>(phaseUs, 0, periodUs - 1);
+    }
+    if (m_running) {
+        entry.dueUs = firstDueAfter(entry, nowUs);
+    }
+    m_entries.push_back(entry);
+    return static_cast<int>(m_entries.size() - 1);
+}
+
+bool TransmitSchedule::setPayload(int id, std::span<const uint8_t> payload) {
+    if (id < 0 || static_cast<size_t>(id) >= m_entries.size() ||
+        payload.size() > RawCanFrame::MAX_PAYLOAD) {
+        return false;
+    }
+    Entry& entry = m_entries[static_cast<size_t>(id)];
+    if (!entry.active || (!entry.frame.flexibleDataRate && payload.size() > MAX_CLASSIC_LENGTH)) {
+        return false;
+    }
+    std::copy(payload.begin(), payload.end(), entry.frame.data.begin());
+    entry.frame.length = static_cast<uint8_t>(payload.size());
+    return true;
+}
+
+bool TransmitSchedule::remove(int id) {
+    if (id < 0 || static_cast<size_t>(id) >= m_entries.size() ||
+        !m_entries[static_cast<size_t>(id)].active) {
+        return false;
+    }
+    m_entries[static_cast<size_t>(id)].active = false;
+    return true;
+}
+
+void TransmitSchedule::clear() {
+    m_entries.clear();
+    m_batchEntries.clear();
+    m_autoPhased = 0;
+}
+
+size_t TransmitSchedule::size() const {
+    return static_cast<size_t>(std::count_if(m_entries.begin(), m_entries.end(),
+                                             [](const Entry& entry) { return entry.active; }));
+}
+
+//=============================================================================
+// Scheduling
+//=============================================================================
+
+void TransmitSchedule::start(int64_t nowUs) {
+    m_running = true;
+    m_startUs = nowUs;
+    m_latenessSumUs = 0;
+    m_stats = Stats{};
+    m_batchEntries.clear();
+    for (Entry& entry : m_entries) {
+        entry.dueUs = nowUs + entry.phaseUs;
+        entry.sent = 0;
+        entry.deadlineMisses = 0;
+        entry.skipped = 0;
+        entry.writeFailures = 0;
+        entry.latenessSumUs = 0;
+        entry.maxLatenessUs = 0;
+    }
+}
+
+size_t TransmitSchedule::collectDue(int64_t nowUs, std::vector<RawCanFrame>& batch) {
+    m_batchEntries.clear();
+    if (!m_running) {
+        return 0;
+    }
+
+    for (size_t i = 0; i < m_entries.size(); ++i) {
+        Entry& entry = m_entries[i];
+        if (!entry.active || entry.dueUs > nowUs) {
+            continue;
+        }
+
+        // Overrun occurrences are dropped, not sent in a burst; the next
+        // one stays on the grid
+        const int64_t latenessUs = nowUs - entry.dueUs;
+        const int64_t overrun = latenessUs / entry.periodUs;
+        entry.skipped += static_cast<uint64_t>(overrun);
+        m_stats.skipped += static_cast<uint64_t>(overrun);
+        entry.dueUs += (overrun + 1) * entry.periodUs;
+
+        entry.latenessSumUs += latenessUs;
+        entry.maxLatenessUs = std::max(entry.maxLatenessUs, latenessUs);
+        m_latenessSumUs += latenessUs;
+        m_stats.maxLatenessUs = std::max(m_stats.maxLatenessUs, latenessUs);
+        ++m_stats.histogram[bucketFor(latenessUs)];
+        if (latenessUs > m_options.toleranceUs) {
+            ++entry.deadlineMisses;
+            ++m_stats.deadlineMisses;
+        }
+
+        batch.push_back(entry.frame);
+        m_batchEntries.push_back(i);
+    }
+
+    if (!m_batchEntries.empty()) {
+        ++m_stats.batches;
+    }
+    return m_batchEntries.size();
+}
+
+void TransmitSchedule::completeBatch(size_t written) {
+    written = std::min(written, m_batchEntries.size());
+    for (size_t i = 0; i < m_batchEntries.size(); ++i) {
+        Entry& entry = m_entries[m_batchEntries[i]];
+        if (i < written) {
+            ++entry.sent;
+        } else {
+            ++entry.writeFailures;
+        }
+    }
+    m_stats.sent += written;
+    m_stats.writeFailures += m_batchEntries.size() - written;
+
+    const uint64_t measured = m_stats.sent + m_stats.writeFailures;
+    if (measured > 0) {
+        m_stats.meanLatenessUs =
+            static_cast<double>(m_latenessSumUs) / static_cast<double>(measured);
+    }
+    m_batchEntries.clear();
+}
+
+int64_t TransmitSchedule::nextDueUs() const {
+    int64_t next = NO_EVENT;
+    if (!m_running) {
+        return next;
+    }
+    for (const Entry& entry : m_entries) {
+        if (entry.active) {
+            next = std::min(next, entry.dueUs);
+        }
+    }
+    return next;
+}
+
+int64_t TransmitSchedule::firstDueAfter(const Entry& entry, int64_t nowUs) const {
+    const int64_t firstUs = m_startUs + entry.phaseUs;
+    if (nowUs <= firstUs) {
+        return firstUs;
+    }
+    const int64_t periods = (nowUs - firstUs + entry.periodUs - 1) / entry.periodUs;
+    return firstUs + (periods * entry.periodUs);
+}
+
+//=============================================================================
+// Statistics
+//=============================================================================
+
+std::vector<TransmitSchedule::FrameStats> TransmitSchedule::frameStats() const {
+    std::vector<FrameStats> result;
+    for (size_t i = 0; i < m_entries.size(); ++i) {
+        const Entry& entry = m_entries[i];
+        if (!entry.active) {
+            continue;
+        }
+        FrameStats stats;
+        stats.id = static_cast<int>(i);
+        stats.key = FrameKey{entry.frame.frameId, entry.frame.extended};
+        stats.periodUs = entry.periodUs;
+        stats.phaseUs = entry.phaseUs;
+        stats.sent = entry.sent;
+        stats.deadlineMisses = entry.deadlineMisses;
+        stats.skipped = entry.skipped;
+        stats.writeFailures = entry.writeFailures;
+        stats.maxLatenessUs = entry.maxLatenessUs;
+        const uint64_t measured = entry.sent + entry.writeFailures;
+        if (measured > 0) {
+            stats.meanLatenessUs =
+                static_cast<double>(entry.latenessSumUs) / static_cast<double>(measured);
+        }
+        result.push_back(stats);
+    }
+    return result;
+}
+
+size_t TransmitSchedule::bucketFor(int64_t latenessUs) {
+    const auto* it = std::upper_bound(JITTER_BUCKET_LIMITS_US.begin(),
+                                      JITTER_BUCKET_LIMITS_US.end(), latenessUs);
+    return static_cast<size_t>(it - JITTER_BUCKET_LIMITS_US.begin());
+}
+
+} // namespace devdash
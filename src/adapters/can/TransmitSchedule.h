@@ -0,0 +1,232 @@
+#pragma once
+
+#include "IFrameDecoder.h"
+#include "RawCanSocket.h"
+
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <vector>
+
+namespace devdash {
+
+/**
+ * @brief Decides which periodic CAN frames are due, and measures how late they went out
+ *
+ * Output control (PD16 outputs), keypad emulation and keepalives all send
+ * the same frames over and over at a fixed period. Each frame gets:
+ *
+ * - a period, and a phase offset within it, so frames with the same period
+ *   do not all hit the bus in the same instant. Without an explicit phase,
+ *   frames are staggered AUTO_PHASE_STEP_US apart (wrapped into their period).
+ * - a fixed time grid: occurrence k is due at start + phase + k * period,
+ *   however late the previous one went out, so lateness never accumulates
+ *   into drift. An occurrence that is a whole period or more late is sent
+ *   once, and the occurrences it overran are counted as skipped rather
+ *   than sent in a burst.
+ *
+ * Every send is measured against its due time: lateness histogram
+ * (JITTER_BUCKET_LIMITS_US), mean and maximum, and deadline misses (sent
+ * more than Options::toleranceUs late), overall and per frame.
+ *
+ * Time is passed in by the caller (microseconds, CLOCK_MONOTONIC), so the
+ * schedule is deterministic under test. Deliberately free of Qt and of CAN
+ * I/O; PeriodicTransmitter wakes up and writes the frames.
+ *
+ * @code
+ * TransmitSchedule schedule;
+ * const int keepalive = schedule.add(frame, 10000, 2000);  // 10 ms, 2 ms phase
+ * schedule.start(now);
+ *
+ * schedule.collectDue(now, batch);
+ * schedule.completeBatch(write(batch));
+ * // wake up again at schedule.nextDueUs()
+ *
+ * // while running, frames are added with the current time
+ * const int keypad = schedule.add(frame, 20000, TransmitSchedule::AUTO_PHASE, now);
+ * @endcode
+ *
+ * @note Not thread-safe; owned and used by the adapter's I/O thread.
+ */
+class TransmitSchedule {
+  public:
+    /// Returned by nextDueUs() when nothing is scheduled
+    static constexpr int64_t NO_EVENT = std::numeric_limits<int64_t>::max();
+
+    /// Pass as the phase to stagger the frame automatically
+    static constexpr int64_t AUTO_PHASE = -1;
+
+    /// Spacing of automatically phased frames
+    static constexpr int64_t AUTO_PHASE_STEP_US = 1000;
+
+    /// Shortest period accepted
+    static constexpr int64_t MIN_PERIOD_US = 1000;
+
+    /// Upper bounds of the lateness histogram buckets; the last bucket takes the rest
+    static constexpr std::array<int64_t, 8> JITTER_BUCKET_LIMITS_US = {50,   100,  250,  500,
+                                                                       1000, 2000, 5000, 10000};
+
+    /// Lateness histogram buckets (one more than limits)
+    static constexpr size_t JITTER_BUCKETS = JITTER_BUCKET_LIMITS_US.size() + 1;
+
+    using Histogram = std::array<uint64_t, JITTER_BUCKETS>;
+
+    /**
+     * @brief Deadline settings
+     */
+    struct Options {
+        int64_t toleranceUs = 1000;  ///< Sent later than this counts as a deadline miss
+    };
+
+    /**
+     * @brief Statistics of one scheduled frame
+     */
+    struct FrameStats {
+        int id = -1;                 ///< Handle from add()
+        FrameKey key;                ///< Frame identifier
+        int64_t periodUs = 0;
+        int64_t phaseUs = 0;
+        uint64_t sent = 0;           ///< Occurrences written
+        uint64_t deadlineMisses = 0; ///< Written later than the tolerance
+        uint64_t skipped = 0;        ///< Occurrences overrun and never written
+        uint64_t writeFailures = 0;  ///< Occurrences the bus refused
+        double meanLatenessUs = 0.0;
+        int64_t maxLatenessUs = 0;
+    };
+
+    /**
+     * @brief Statistics of all frames since start()
+     */
+    struct Stats {
+        uint64_t batches = 0;        ///< collectDue() calls that returned frames
+        uint64_t sent = 0;
+        uint64_t deadlineMisses = 0;
+        uint64_t skipped = 0;
+        uint64_t writeFailures = 0;
+        double meanLatenessUs = 0.0;
+        int64_t maxLatenessUs = 0;
+        Histogram histogram{};       ///< Sends per lateness bucket
+    };
+
+    TransmitSchedule() = default;
+
+    void setOptions(const Options& options);
+
+    [[nodiscard]] const Options& options() const { return m_options; }
+
+    /**
+     * @brief Send @p frame every @p periodUs, @p phaseUs into each period (before start())
+     *
+     * @return Handle for setPayload() / remove(), -1 if the period is below
+     *         MIN_PERIOD_US, the frame is an error frame or the schedule is
+     *         running (use the overload taking the current time)
+     */
+    [[nodiscard]] int add(const RawCanFrame& frame, int64_t periodUs, int64_t phaseUs = AUTO_PHASE);
+
+    /**
+     * @brief Send @p frame every @p periodUs, @p phaseUs into each period, from @p nowUs
+     *
+     * While running, the frame joins the grid at its first due time at or
+     * after @p nowUs, however long the schedule has been idle. Before
+     * start(), @p nowUs is ignored.
+     *
+     * @return Handle for setPayload() / remove(), -1 if the period is below
+     *         MIN_PERIOD_US or the frame is an error frame
+     */
+    [[nodiscard]] int add(const RawCanFrame& frame, int64_t periodUs, int64_t phaseUs,
+                          int64_t nowUs);
+
+    /**
+     * @brief Replace the payload sent from the next occurrence on
+     * @return false for an unknown handle or an oversized payload (over 8
+     *         bytes for a classic frame: the format is fixed by add())
+     */
+    bool setPayload(int id, std::span<const uint8_t> payload);
+
+    /**
+     * @brief Stop sending a frame (its handle is not reused)
+     */
+    bool remove(int id);
+
+    /**
+     * @brief Forget all frames
+     */
+    void clear();
+
+    /**
+     * @brief Start sending: every frame is first due @p nowUs plus its phase
+     *
+     * Resets the statistics.
+     */
+    void start(int64_t nowUs);
+
+    void stop() { m_running = false; }
+
+    [[nodiscard]] bool isRunning() const { return m_running; }
+
+    /**
+     * @brief Append every frame due at @p nowUs to @p batch, and advance them
+     *
+     * Pass how many of them were written to completeBatch() before the next call.
+     *
+     * @return Frames appended
+     */
+    size_t collectDue(int64_t nowUs, std::vector<RawCanFrame>& batch);
+
+    /**
+     * @brief Report that the first @p written frames of the last batch went out
+     *
+     * The rest count as write failures.
+     */
+    void completeBatch(size_t written);
+
+    /**
+     * @brief Earliest due time of any frame
+     * @return NO_EVENT when stopped or empty
+     */
+    [[nodiscard]] int64_t nextDueUs() const;
+
+    [[nodiscard]] const Stats& stats() const { return m_stats; }
+
+    /**
+     * @brief Statistics of every scheduled frame, in the order they were added
+     */
+    [[nodiscard]] std::vector<FrameStats> frameStats() const;
+
+    /** @brief Frames currently scheduled */
+    [[nodiscard]] size_t size() const;
+
+    /**
+     * @brief Histogram bucket of a lateness
+     */
+    [[nodiscard]] static size_t bucketFor(int64_t latenessUs);
+
+  private:
+    struct Entry {
+        RawCanFrame frame;
+        int64_t periodUs = 0;
+        int64_t phaseUs = 0;
+        int64_t dueUs = 0;
+        bool active = true;
+        uint64_t sent = 0;
+        uint64_t deadlineMisses = 0;
+        uint64_t skipped = 0;
+        uint64_t writeFailures = 0;
+        int64_t latenessSumUs = 0;
+        int64_t maxLatenessUs = 0;
+    };
+
+    [[nodiscard]] int64_t firstDueAfter(const Entry& entry, int64_t nowUs) const;
+
+    Options m_options;
+    std::vector<Entry> m_entries;
+    std::vector<size_t> m_batchEntries;  ///< Entry of each frame in the last batch, reused
+    int m_autoPhased{0};
+    bool m_running{false};
+    int64_t m_startUs{0};
+    int64_t m_latenessSumUs{0};
+    Stats m_stats;
+};
+
+} // namespace devdash
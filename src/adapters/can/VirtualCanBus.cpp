@@ -0,0 +1,189 @@
+/**
+ * @file VirtualCanBus.cpp
+ * @brief Implementation of the in-process CAN bus.
+ */
+
+#include "VirtualCanBus.h"
+
+#include "BusMonitor.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <unordered_map>
+
+namespace devdash {
+
+namespace {
+
+//=============================================================================
+// Ring Layout
+//=============================================================================
+
+static_assert((VirtualCanBus::RING_CAPACITY & (VirtualCanBus::RING_CAPACITY - 1)) == 0,
+              "RING_CAPACITY must be a power of two");
+
+constexpr auto RING_SIZE = static_cast<uint64_t>(VirtualCanBus::RING_CAPACITY);
+constexpr uint64_t RING_MASK = RING_SIZE - 1;
+
+constexpr double NS_PER_SECOND = 1e9;
+
+//=============================================================================
+// Bus Registry
+//=============================================================================
+
+std::mutex& registryMutex() {
+    static std::mutex mutex;
+    return mutex;
+}
+
+/// Buses by name; entries expire with the last holder
+std::unordered_map<std::string, std::weak_ptr<VirtualCanBus>>& registry() {
+    static std::unordered_map<std::string, std::weak_ptr<VirtualCanBus>> buses;
+    return buses;
+}
+
+int64_t realtimeNowNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::system_clock::now().time_since_epoch())
+        .count();
+}
+
+} // anonymous namespace
+
+//=============================================================================
+// Construction / Destruction
+//=============================================================================
+
+std::shared_ptr<VirtualCanBus> VirtualCanBus::get(const std::string& name) {
+    const std::scoped_lock lock(registryMutex());
+    auto& entry = registry()[name];
+    std::shared_ptr<VirtualCanBus> bus = entry.lock();
+    if (!bus) {
+        bus = std::make_shared<VirtualCanBus>(name);
+        entry = bus;
+    }
+    return bus;
+}
+
+VirtualCanBus::VirtualCanBus(std::string name)
+    : m_name(std::move(name)), m_ring(RING_CAPACITY),
+      m_realtimeOffsetNs(realtimeNowNs() - nowNs()) {}
+
+VirtualCanBus::~VirtualCanBus() {
+    const std::scoped_lock lock(registryMutex());
+    auto it = registry().find(m_name);
+    if (it != registry().end() && it->second.expired()) {
+        registry().erase(it);
+    }
+}
+
+//=============================================================================
+// Configuration
+//=============================================================================
+
+void VirtualCanBus::setBitrate(int nominalBitrate, int dataBitrate) {
+    const std::scoped_lock lock(m_mutex);
+    m_nominalBitrate = std::max(nominalBitrate, 0);
+    m_dataBitrate = std::max(dataBitrate, 0);
+}
+
+int VirtualCanBus::nominalBitrate() const {
+    const std::scoped_lock lock(m_mutex);
+    return m_nominalBitrate;
+}
+
+int VirtualCanBus::dataBitrate() const {
+    const std::scoped_lock lock(m_mutex);
+    return m_dataBitrate;
+}
+
+//=============================================================================
+// Nodes
+//=============================================================================
+
+uint64_t VirtualCanBus::newNodeId() {
+    const std::scoped_lock lock(m_mutex);
+    return m_nextNodeId++;
+}
+
+std::unique_ptr<VirtualCanBus::Port> VirtualCanBus::attach(uint64_t nodeId,
+                                                           std::function<void()> notify) {
+    std::unique_ptr<Port> port(new Port(nodeId, std::move(notify)));
+    const std::scoped_lock lock(m_mutex);
+    port->m_readSequence.store(m_writeSequence.load(std::memory_order_relaxed),
+                               std::memory_order_relaxed);
+    m_ports.push_back(port.get());
+    return port;
+}
+
+void VirtualCanBus::detach(const Port& port) {
+    const std::scoped_lock lock(m_mutex);
+    m_ports.erase(std::remove(m_ports.begin(), m_ports.end(), &port), m_ports.end());
+}
+
+size_t VirtualCanBus::attachedPorts() const {
+    const std::scoped_lock lock(m_mutex);
+    return m_ports.size();
+}
+
+//=============================================================================
+// Frames
+//=============================================================================
+
+bool VirtualCanBus::send(uint64_t senderId, const RawCanFrame& frame) {
+    const std::scoped_lock lock(m_mutex);
+    // Only this thread (holding the lock) advances the write sequence
+    const uint64_t sequence = m_writeSequence.load(std::memory_order_relaxed);
+    for (const Port* port : m_ports) {
+        const uint64_t backlog =
+            sequence - port->m_readSequence.load(std::memory_order_acquire);
+        if (backlog >= RING_SIZE) {
+            m_sendFailures.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+    }
+
+    const int64_t now = nowNs();
+    int64_t arrival = now;
+    if (m_nominalBitrate > 0) {
+        const double duration = BusMonitor::frameDuration(frame, m_nominalBitrate, m_dataBitrate);
+        arrival = std::max(now, m_busFreeAtNs) + std::llround(duration * NS_PER_SECOND);
+        m_busFreeAtNs = arrival;
+    }
+
+    // Every reader has released this slot (backlog check above)
+    Slot& slot = m_ring[sequence & RING_MASK];
+    slot.frame = frame;
+    slot.frame.timestampNs = arrival + m_realtimeOffsetNs;
+    slot.arrivalNs = arrival;
+    slot.senderId = senderId;
+    m_writeSequence.store(sequence + 1, std::memory_order_release);
+
+    for (const Port* port : m_ports) {
+        if (port->m_notify) {
+            port->m_notify();
+        }
+    }
+    return true;
+}
+
+const VirtualCanBus::Slot* VirtualCanBus::peek(const Port& port) const {
+    const uint64_t sequence = port.m_readSequence.load(std::memory_order_relaxed);
+    if (sequence == m_writeSequence.load(std::memory_order_acquire)) {
+        return nullptr;
+    }
+    return &m_ring[sequence & RING_MASK];
+}
+
+void VirtualCanBus::release(Port& port) {
+    port.m_readSequence.fetch_add(1, std::memory_order_release);
+}
+
+int64_t VirtualCanBus::nowNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+
+} // namespace devdash
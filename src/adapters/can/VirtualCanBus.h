@@ -0,0 +1,189 @@
+#pragma once
+
+#include "RawCanSocket.h"
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace devdash {
+
+/**
+ * @brief In-process CAN bus shared by any number of nodes
+ *
+ * Stands in for a vcan interface in tests and pipeline benchmarks: nodes
+ * (VirtualCanEndpoint, or anything holding a Port) send frames that every
+ * other attached node receives, without sockets, system calls or kernel
+ * queues. Buses are looked up by name, so an adapter configured with
+ * "backend": "virtual" and "interface": "vbus0" shares the bus with a test
+ * or simulated ECU that opens "vbus0".
+ *
+ * - Zero-copy handoff: send() stores the frame once in a ring of
+ *   RING_CAPACITY RawCanFrames allocated with the bus. Receivers read the
+ *   slot in place (peek()) and release it when done; a slot is reused only
+ *   after every attached node has released it, so nothing is copied per
+ *   receiver and nothing is allocated per frame.
+ * - Simulated arrival timing: with a bitrate set, frames occupy the bus
+ *   for their bit time (BusMonitor::frameDuration(), worst-case stuffing)
+ *   one after another, and each frame arrives when its transmission ends.
+ *   Frames are sent in order; arbitration between simultaneous senders is
+ *   not modelled. Without a bitrate frames arrive immediately.
+ * - Flow control: a receiver that falls RING_CAPACITY frames behind makes
+ *   send() fail, like a full transmit queue (ENOBUFS) on a real interface.
+ *   Detach nodes that stop reading.
+ *
+ * Thread-safe: any thread may send, each Port is read by one thread.
+ * Deliberately free of Qt, like RawCanSocket.
+ *
+ * @code
+ * auto bus = VirtualCanBus::get("vbus0");
+ * bus->setBitrate(500000, 0);
+ * auto port = bus->attach(bus->newNodeId(), [] { wake the reader });
+ * bus->send(VirtualCanBus::ANONYMOUS_NODE, frame);
+ * // on the reader's thread:
+ * while (const auto* slot = bus->peek(*port)) {
+ *     use(slot->frame);
+ *     bus->release(*port);
+ * }
+ * @endcode
+ */
+class VirtualCanBus {
+  public:
+    /// Frames held on the bus; the furthest a receiver may fall behind
+    static constexpr int RING_CAPACITY = 4096;
+
+    /// Sender ID of frames injected without a node (send() with 0)
+    static constexpr uint64_t ANONYMOUS_NODE = 0;
+
+    /**
+     * @brief One frame on the bus
+     */
+    struct Slot {
+        RawCanFrame frame;       ///< timestampNs is the arrival time (CLOCK_REALTIME)
+        int64_t arrivalNs = 0;   ///< Arrival time on the steady clock, see nowNs()
+        uint64_t senderId = ANONYMOUS_NODE;
+    };
+
+    /**
+     * @brief Receiving attachment of one node
+     */
+    class Port {
+      public:
+        [[nodiscard]] uint64_t nodeId() const { return m_nodeId; }
+
+      private:
+        friend class VirtualCanBus;
+
+        Port(uint64_t nodeId, std::function<void()> notify)
+            : m_nodeId(nodeId), m_notify(std::move(notify)) {}
+
+        uint64_t m_nodeId;
+        std::function<void()> m_notify;
+        std::atomic<uint64_t> m_readSequence{0};  ///< Next slot to read
+    };
+
+    /**
+     * @brief Get the bus called @p name, creating it on first use
+     *
+     * The bus lives as long as someone holds the returned pointer; a later
+     * get() after the last holder released it creates a fresh bus.
+     */
+    [[nodiscard]] static std::shared_ptr<VirtualCanBus> get(const std::string& name);
+
+    explicit VirtualCanBus(std::string name);
+    ~VirtualCanBus();
+
+    // Shared by pointer; ports refer to the ring
+    VirtualCanBus(const VirtualCanBus&) = delete;
+    VirtualCanBus& operator=(const VirtualCanBus&) = delete;
+    VirtualCanBus(VirtualCanBus&&) = delete;
+    VirtualCanBus& operator=(VirtualCanBus&&) = delete;
+
+    [[nodiscard]] const std::string& name() const { return m_name; }
+
+    /**
+     * @brief Set the bit timing used for arrival times
+     *
+     * @param nominalBitrate Arbitration bitrate in bit/s, 0 = frames arrive immediately
+     * @param dataBitrate CAN FD data-phase bitrate in bit/s, 0 = nominal
+     */
+    void setBitrate(int nominalBitrate, int dataBitrate);
+
+    [[nodiscard]] int nominalBitrate() const;
+    [[nodiscard]] int dataBitrate() const;
+
+    /**
+     * @brief Allocate an ID identifying a node's own frames
+     */
+    [[nodiscard]] uint64_t newNodeId();
+
+    /**
+     * @brief Start receiving frames sent from now on
+     *
+     * @param nodeId The node's ID; frames it sent itself are still queued
+     *               (check Slot::senderId), as with loopback on SocketCAN
+     * @param notify Called on the sending thread after each frame is queued;
+     *               must only wake the reader (e.g. post an event)
+     */
+    [[nodiscard]] std::unique_ptr<Port> attach(uint64_t nodeId, std::function<void()> notify);
+
+    /**
+     * @brief Stop receiving; the port's unread frames no longer hold the ring
+     */
+    void detach(const Port& port);
+
+    /**
+     * @brief Put a frame on the bus
+     *
+     * @param senderId Sending node, ANONYMOUS_NODE for frames injected from outside
+     * @return false if a receiver's backlog fills the ring (frame not sent)
+     */
+    bool send(uint64_t senderId, const RawCanFrame& frame);
+
+    /**
+     * @brief Next frame for @p port, or nullptr when it has read everything
+     *
+     * The slot stays valid until release(). Check Slot::arrivalNs against
+     * nowNs() to honour the simulated arrival time.
+     */
+    [[nodiscard]] const Slot* peek(const Port& port) const;
+
+    /**
+     * @brief Mark the frame returned by peek() as read
+     */
+    void release(Port& port);
+
+    /**
+     * @brief Steady clock of Slot::arrivalNs, in nanoseconds
+     */
+    [[nodiscard]] static int64_t nowNs();
+
+    [[nodiscard]] size_t attachedPorts() const;
+
+    /** @brief Frames put on the bus */
+    [[nodiscard]] uint64_t framesSent() const { return m_writeSequence.load(); }
+
+    /** @brief Frames rejected because a receiver fell RING_CAPACITY behind */
+    [[nodiscard]] uint64_t sendFailures() const { return m_sendFailures.load(); }
+
+  private:
+    const std::string m_name;
+    std::vector<Slot> m_ring;
+    const int64_t m_realtimeOffsetNs;  ///< CLOCK_REALTIME minus steady clock at creation
+
+    mutable std::mutex m_mutex;  ///< Serializes senders, attach() and detach()
+    std::vector<Port*> m_ports;
+    int m_nominalBitrate{0};
+    int m_dataBitrate{0};
+    int64_t m_busFreeAtNs{0};  ///< End of the last frame's transmission
+    uint64_t m_nextNodeId{ANONYMOUS_NODE + 1};
+
+    std::atomic<uint64_t> m_writeSequence{0};  ///< Slots published to readers
+    std::atomic<uint64_t> m_sendFailures{0};
+};
+
+} // namespace devdash
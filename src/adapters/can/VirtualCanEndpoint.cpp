@@ -0,0 +1,156 @@
+/**
+ * @file VirtualCanEndpoint.cpp
+ * @brief Implementation of a VirtualCanBus node as frame source.
+ */
+
+#include "VirtualCanEndpoint.h"
+
+#include <QJsonObject>
+#include <QMetaObject>
+
+#include <utility>
+
+namespace devdash {
+
+namespace {
+
+/// Reported as source name and adapter backend
+constexpr const char* SOURCE_NAME = "virtual";
+
+constexpr int64_t NS_PER_MS = 1000000;
+constexpr int BITS_PER_KBIT = 1000;
+
+} // anonymous namespace
+
+//=============================================================================
+// Construction / Destruction
+//=============================================================================
+
+VirtualCanEndpoint::VirtualCanEndpoint(std::shared_ptr<VirtualCanBus> bus, QObject* parent)
+    : ICanFrameSource(parent), m_bus(std::move(bus)), m_nodeId(m_bus->newNodeId()) {
+    // Parented so it follows the endpoint when it is moved to an I/O thread
+    m_arrivalTimer.setParent(this);
+    m_arrivalTimer.setSingleShot(true);
+    m_arrivalTimer.setTimerType(Qt::PreciseTimer);
+    connect(&m_arrivalTimer, &QTimer::timeout, this, &VirtualCanEndpoint::onFramesPending);
+}
+
+VirtualCanEndpoint::~VirtualCanEndpoint() {
+    stop();
+}
+
+//=============================================================================
+// Endpoint Control
+//=============================================================================
+
+bool VirtualCanEndpoint::open() {
+    if (!m_port) {
+        m_port = m_bus->attach(m_nodeId, [this]() { scheduleDrain(); });
+    }
+    return true;
+}
+
+void VirtualCanEndpoint::start() {
+    if (m_running) {
+        return;
+    }
+    (void)open();
+    m_running = true;
+    scheduleDrain();
+}
+
+void VirtualCanEndpoint::stop() {
+    m_running = false;
+    m_arrivalTimer.stop();
+    if (m_port) {
+        m_bus->detach(*m_port);
+        m_port.reset();
+    }
+    m_drainScheduled.store(false);
+}
+
+bool VirtualCanEndpoint::writeFrame(const RawCanFrame& frame) {
+    if (!m_bus->send(m_nodeId, frame)) {
+        return false;
+    }
+    m_framesSent.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+//=============================================================================
+// Source Description
+//=============================================================================
+
+QString VirtualCanEndpoint::sourceName() const {
+    return QString::fromLatin1(SOURCE_NAME);
+}
+
+QString VirtualCanEndpoint::description() const {
+    const QString bus = "bus \"" + QString::fromStdString(m_bus->name()) + '"';
+    const int bitrate = m_bus->nominalBitrate();
+    return bitrate > 0 ? bus + " at " + QString::number(bitrate / BITS_PER_KBIT) + " kbit/s"
+                       : bus + " without bit timing";
+}
+
+QJsonObject VirtualCanEndpoint::diagnostics() const {
+    QJsonObject endpoint;
+    endpoint["bus"] = QString::fromStdString(m_bus->name());
+    endpoint["bitrate"] = m_bus->nominalBitrate();
+    endpoint["dataBitrate"] = m_bus->dataBitrate();
+    endpoint["endpoints"] = static_cast<qint64>(m_bus->attachedPorts());
+    endpoint["frames"] = static_cast<qint64>(m_framesDelivered);
+    endpoint["sent"] = static_cast<qint64>(framesSent());
+    endpoint["busFrames"] = static_cast<qint64>(m_bus->framesSent());
+    endpoint["sendFailures"] = static_cast<qint64>(m_bus->sendFailures());
+    return endpoint;
+}
+
+//=============================================================================
+// Private Slots
+//=============================================================================
+
+void VirtualCanEndpoint::onFramesPending() {
+    // Cleared before reading, so a frame sent from here on schedules another pass
+    m_drainScheduled.store(false);
+    if (!m_running) {
+        return;
+    }
+
+    const VirtualCanBus::Port* port = m_port.get();
+    const int64_t now = VirtualCanBus::nowNs();
+    for (int i = 0; i < MAX_FRAMES_PER_PASS; ++i) {
+        const VirtualCanBus::Slot* slot = m_bus->peek(*m_port);
+        if (slot == nullptr) {
+            return;
+        }
+        if (slot->arrivalNs > now) {
+            // Still on the wire; frames behind it arrive later still
+            m_drainScheduled.store(true);
+            const int64_t waitNs = slot->arrivalNs - now;
+            m_arrivalTimer.start(static_cast<int>((waitNs + NS_PER_MS - 1) / NS_PER_MS));
+            return;
+        }
+        if (slot->senderId != m_nodeId) {
+            ++m_framesDelivered;
+            deliver(slot->frame);
+            if (!m_running || m_port.get() != port) {
+                return;  // The handler stopped the endpoint
+            }
+        }
+        m_bus->release(*m_port);
+    }
+    scheduleDrain();
+}
+
+//=============================================================================
+// Private Methods
+//=============================================================================
+
+void VirtualCanEndpoint::scheduleDrain() {
+    if (!m_drainScheduled.exchange(true)) {
+        QMetaObject::invokeMethod(this, &VirtualCanEndpoint::onFramesPending,
+                                  Qt::QueuedConnection);
+    }
+}
+
+} // namespace devdash
@@ -0,0 +1,124 @@
+#pragma once
+
+#include "ICanFrameSource.h"
+#include "VirtualCanBus.h"
+
+#include <QString>
+#include <QTimer>
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+
+namespace devdash {
+
+/**
+ * @brief One node on a VirtualCanBus, as a frame source for CanAdapter
+ *
+ * Receives the frames other nodes send and hands them to the frame handler
+ * at their simulated arrival time, on the thread the endpoint lives on;
+ * writeFrame() sends to all other nodes. Handlers get the bus slot itself
+ * (no copy) and the slot is released when the handler returns. Frames
+ * carry their arrival time as receive timestamp, like kernel timestamps on
+ * a real interface.
+ *
+ * Senders wake the endpoint with a queued call, so nothing is polled and
+ * an idle bus costs nothing. Frames sent before open() or after stop()
+ * are not received, and a stopped endpoint no longer holds the bus.
+ *
+ * @code
+ * VirtualCanEndpoint ecu(VirtualCanBus::get("vbus0"));
+ * ecu.writeFrame(frame);  // received by every other open endpoint on vbus0
+ *
+ * VirtualCanEndpoint dash(VirtualCanBus::get("vbus0"));
+ * dash.setFrameHandler([](const RawCanFrame& frame) { ... });
+ * if (dash.open()) {
+ *     dash.start();
+ * }
+ * @endcode
+ */
+class VirtualCanEndpoint : public ICanFrameSource {
+    Q_OBJECT
+
+  public:
+    /// Frames delivered per event loop pass before yielding
+    static constexpr int MAX_FRAMES_PER_PASS = 1024;
+
+    explicit VirtualCanEndpoint(std::shared_ptr<VirtualCanBus> bus, QObject* parent = nullptr);
+    ~VirtualCanEndpoint() override;
+
+    // QObject-based classes are not copyable or movable
+    VirtualCanEndpoint(const VirtualCanEndpoint&) = delete;
+    VirtualCanEndpoint& operator=(const VirtualCanEndpoint&) = delete;
+    VirtualCanEndpoint(VirtualCanEndpoint&&) = delete;
+    VirtualCanEndpoint& operator=(VirtualCanEndpoint&&) = delete;
+
+    [[nodiscard]] VirtualCanBus& bus() const { return *m_bus; }
+
+    /**
+     * @brief Attach to the bus: frames sent from now on are queued for delivery
+     */
+    [[nodiscard]] bool open() override;
+
+    /**
+     * @brief Deliver queued and future frames (attaches first if needed)
+     */
+    void start() override;
+
+    /**
+     * @brief Detach from the bus; unread frames are dropped
+     */
+    void stop() override;
+
+    [[nodiscard]] bool isRunning() const { return m_running; }
+
+    /** @brief "virtual" */
+    [[nodiscard]] QString sourceName() const override;
+
+    /** @brief Bus name and bitrate */
+    [[nodiscard]] QString description() const override;
+
+    /**
+     * @brief Bus name, bitrate, attached nodes, frames received and sent
+     */
+    [[nodiscard]] QJsonObject diagnostics() const override;
+
+    [[nodiscard]] uint64_t framesDelivered() const override { return m_framesDelivered; }
+
+    /** @brief Frames this endpoint put on the bus */
+    [[nodiscard]] uint64_t framesSent() const { return m_framesSent.load(); }
+
+    [[nodiscard]] QString errorString() const override { return m_errorString; }
+
+    [[nodiscard]] bool hasArrivalTimestamps() const override { return true; }
+    [[nodiscard]] bool isWritable() const override { return true; }
+
+    /**
+     * @brief Send a frame to every other endpoint on the bus
+     *
+     * Works without open(); thread-safe.
+     *
+     * @return false if a receiver's backlog fills the bus ring
+     */
+    bool writeFrame(const RawCanFrame& frame) override;
+
+  private slots:
+    void onFramesPending();
+
+  private:  // NOLINT(readability-redundant-access-specifiers) - Required for MOC
+    /// Queue a drain pass unless one is already scheduled (any thread)
+    void scheduleDrain();
+
+    std::shared_ptr<VirtualCanBus> m_bus;
+    const uint64_t m_nodeId;
+    std::unique_ptr<VirtualCanBus::Port> m_port;
+    QString m_errorString;
+
+    QTimer m_arrivalTimer;  ///< Wakes the endpoint when the next frame arrives
+    std::atomic<bool> m_drainScheduled{false};
+    bool m_running{false};
+    uint64_t m_framesDelivered{0};
+    std::atomic<uint64_t> m_framesSent{0};
+};
+
+} // namespace devdash
@@ -0,0 +1,102 @@
+/**
+ * @file DbcAdapter.cpp
+ * @brief Implementation of the DBC-driven CAN bus adapter.
+ */
+
+#include "DbcAdapter.h"
+
+#include <QDebug>
+#include <QHash>
+#include <QJsonArray>
+#include <QSet>
+
+namespace devdash {
+
+namespace {
+
+//=============================================================================
+// Configuration Keys
+//=============================================================================
+
+constexpr const char* CONFIG_KEY_DBC_FILE = "dbcFile";
+constexpr const char* CONFIG_KEY_DBC_FILES = "dbcFiles";
+
+/**
+ * @brief Collect DBC paths from "dbcFile" and "dbcFiles".
+ */
+QStringList dbcPathsFromConfig(const QJsonObject& config) {
+    QStringList paths;
+    const QString single = config[CONFIG_KEY_DBC_FILE].toString();
+    if (!single.isEmpty()) {
+        paths.append(single);
+    }
+    const QJsonArray list = config[CONFIG_KEY_DBC_FILES].toArray();
+    for (const auto& entry : list) {
+        const QString path = entry.toString();
+        if (!path.isEmpty()) {
+            paths.append(path);
+        }
+    }
+    return paths;
+}
+
+} // anonymous namespace
+
+//=============================================================================
+// Construction / Destruction
+//=============================================================================
+
+DbcAdapter::DbcAdapter(const QJsonObject& config, QObject* parent) : CanAdapter(config, parent) {
+    const QStringList paths = dbcPathsFromConfig(config);
+    if (paths.isEmpty()) {
+        qWarning() << "DbcAdapter: No dbcFile/dbcFiles specified, decoding will not work";
+        return;
+    }
+
+    for (const QString& path : paths) {
+        DbcProtocol database;
+        if (!database.loadDefinition(path)) {
+            qCritical() << "DbcAdapter: Failed to load DBC:" << path;
+            continue;
+        }
+        m_databases.push_back(std::move(database));
+    }
+
+    // Signal names reused by several files would all write to one channel
+    QHash<QString, int> channelCounts;
+    for (const auto& database : m_databases) {
+        for (const QString& channel : database.availableChannels()) {
+            ++channelCounts[channel];
+        }
+    }
+    QSet<QString> sharedChannels;
+    for (auto it = channelCounts.constBegin(); it != channelCounts.constEnd(); ++it) {
+        if (it.value() > 1) {
+            sharedChannels.insert(it.key());
+        }
+    }
+    for (auto& database : m_databases) {
+        database.qualifyChannels(sharedChannels);
+    }
+
+    // Register only once the vector is complete - routes hold element pointers
+    for (const auto& database : m_databases) {
+        router().addDecoder(&database);
+    }
+
+    qDebug() << "DbcAdapter: Loaded" << m_databases.size() << "of" << paths.size() << "DBC files";
+}
+
+DbcAdapter::~DbcAdapter() {
+    stop();
+}
+
+//=============================================================================
+// IProtocolAdapter Interface
+//=============================================================================
+
+QString DbcAdapter::adapterName() const {
+    return QStringLiteral("DBC CAN");
+}
+
+} // namespace devdash
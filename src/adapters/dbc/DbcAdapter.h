@@ -0,0 +1,50 @@
+#pragma once
+
+#include "DbcProtocol.h"
+#include "can/CanAdapter.h"
+
+#include <QJsonObject>
+
+#include <vector>
+
+namespace devdash {
+
+/**
+ * @brief Protocol adapter for any CAN device described by Vector DBC files
+ *
+ * Loads one or more DBC files ("dbcFile" or "dbcFiles" in the adapter
+ * config) and registers each with the FrameRouter. If two files define the
+ * same frame ID, the file listed first wins. Signal names become channel
+ * names, so profiles map them with channelMappings exactly like Haltech
+ * channels. A name used by several messages, in one file or across files,
+ * is published as "Message.Signal" instead.
+ *
+ * @code
+ * "adapter": "dbc",
+ * "adapterConfig": {
+ *     "interface": "can0",
+ *     "dbcFiles": ["../dbc/ecu.dbc", "../dbc/abs.dbc"]
+ * }
+ * @endcode
+ */
+class DbcAdapter : public CanAdapter {
+    Q_OBJECT
+
+  public:
+    explicit DbcAdapter(const QJsonObject& config, QObject* parent = nullptr);
+    ~DbcAdapter() override;
+
+    // QObject-based classes are not copyable or movable
+    DbcAdapter(const DbcAdapter&) = delete;
+    DbcAdapter& operator=(const DbcAdapter&) = delete;
+    DbcAdapter(DbcAdapter&&) = delete;
+    DbcAdapter& operator=(DbcAdapter&&) = delete;
+
+    // IProtocolAdapter interface
+    [[nodiscard]] QString adapterName() const override;
+
+  private:
+    std::vector<DbcProtocol> m_databases;
+};
+
+} // namespace devdash
@@ -0,0 +1,537 @@
+/**
+ * @file DbcProtocol.cpp
+ * @brief Implementation of the Vector DBC decoder.
+ */
+
+#include "DbcProtocol.h"
+
+#include <QDebug>
+#include <QFile>
+#include <QRegularExpression>
+
+namespace devdash {
+
+namespace {
+
+//=============================================================================
+// DBC Identifier Layout
+//=============================================================================
+
+/// Bit 31 of a DBC message ID marks a 29-bit (extended) identifier
+constexpr uint32_t DBC_EXTENDED_FLAG = 0x80000000U;
+
+/// Mask for a 29-bit CAN identifier
+constexpr uint32_t EXTENDED_ID_MASK = 0x1FFFFFFFU;
+
+/// Pseudo-message Vector tools use to hold signals not assigned to a frame
+constexpr const char* INDEPENDENT_SIGNALS_MESSAGE = "VECTOR__INDEPENDENT_SIG_MSG";
+
+//=============================================================================
+// SIG_VALTYPE_ Codes
+//=============================================================================
+
+/// SIG_VALTYPE_ code for IEEE float
+constexpr int VALTYPE_FLOAT32 = 1;
+
+/// SIG_VALTYPE_ code for IEEE double
+constexpr int VALTYPE_FLOAT64 = 2;
+
+/// Bit width required for IEEE float signals
+constexpr int FLOAT32_BITS = 32;
+
+/// Bit width required for IEEE double signals
+constexpr int FLOAT64_BITS = 64;
+
+//=============================================================================
+// Statement Keywords
+//=============================================================================
+
+constexpr const char* KEYWORD_MESSAGE = "BO_ ";
+constexpr const char* KEYWORD_SIGNAL = "SG_ ";
+constexpr const char* KEYWORD_VALUE_TABLE = "VAL_ ";
+constexpr const char* KEYWORD_VALUE_TYPE = "SIG_VALTYPE_ ";
+constexpr const char* KEYWORD_COMMENT = "CM_ ";
+
+//=============================================================================
+// Regular Expressions
+//=============================================================================
+
+/// BO_ <id> <name>: <dlc> <transmitter>
+const QRegularExpression MESSAGE_PATTERN(QStringLiteral(R"(^BO_\s+(\d+)\s+(\w+)\s*:\s*(\d+))"));
+
+/// SG_ <name> [M|mN] : <start>|<len>@<order><sign> (<factor>,<offset>) [<min>|<max>] "<unit>"
+const QRegularExpression SIGNAL_PATTERN(QStringLiteral(
+    R"(^SG_\s+(\w+)\s*(M|m\d+M?)?\s*:\s*(\d+)\|(\d+)@([01])([+-])\s*)"
+    R"(\(\s*([^,\s]+)\s*,\s*([^)\s]+)\s*\)\s*\[[^\]]*\]\s*"([^"]*)")"));
+
+/// VAL_ <id> <signal> <value> "<description>" ... ;
+const QRegularExpression VALUE_TABLE_PATTERN(
+    QStringLiteral(R"(^VAL_\s+(\d+)\s+(\w+)\s+(.*);\s*$)"),
+    QRegularExpression::DotMatchesEverythingOption);
+
+/// <value> "<description>" pair inside a VAL_ statement
+const QRegularExpression VALUE_PAIR_PATTERN(QStringLiteral(R"((-?\d+)\s+"([^"]*)")"));
+
+/// SIG_VALTYPE_ <id> <signal> : <type> ;
+const QRegularExpression VALUE_TYPE_PATTERN(
+    QStringLiteral(R"(^SIG_VALTYPE_\s+(\d+)\s+(\w+)\s*:\s*(\d)\s*;)"));
+
+/**
+ * @brief Key of a message in the message table: the DBC message ID.
+ *
+ * 0x100 as an 11-bit and as a 29-bit ID are different messages.
+ */
+uint32_t messageKey(uint32_t frameId, bool extended) {
+    return extended ? (frameId | DBC_EXTENDED_FLAG) : frameId;
+}
+
+/**
+ * @brief Check whether a statement has reached its unquoted ';' terminator.
+ *
+ * CM_ and VAL_ statements may span several lines and contain ';' inside
+ * quoted strings, so a plain endsWith(';') is not enough.
+ */
+bool isStatementTerminated(const QString& statement) {
+    bool inQuotes = false;
+    QChar previous;
+    for (const QChar ch : statement) {
+        if (ch == u'"' && previous != u'\\') {
+            inQuotes = !inQuotes;
+        } else if (ch == u';' && !inQuotes) {
+            return true;
+        }
+        previous = ch;
+    }
+    return false;
+}
+
+/**
+ * @brief Check whether a line opens a ';'-terminated statement we care about.
+ */
+bool isTerminatedStatement(const QString& line) {
+    return line.startsWith(QLatin1String(KEYWORD_VALUE_TABLE)) ||
+           line.startsWith(QLatin1String(KEYWORD_VALUE_TYPE)) ||
+           line.startsWith(QLatin1String(KEYWORD_COMMENT));
+}
+
+/**
+ * @brief Find a signal by name inside a message.
+ */
+DbcSignalDefinition* findSignal(DbcMessageDefinition& message, const QString& name) {
+    for (auto& signalDef : message.signalDefs) {
+        if (signalDef.name == name) {
+            return &signalDef;
+        }
+    }
+    return nullptr;
+}
+
+} // anonymous namespace
+
+//=============================================================================
+// Construction
+//=============================================================================
+
+DbcProtocol::DbcProtocol() = default;
+
+//=============================================================================
+// Loading
+//=============================================================================
+
+bool DbcProtocol::loadDefinition(const QString& path) {
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        qWarning() << "DbcProtocol: Failed to open DBC file:" << path;
+        return false;
+    }
+
+    // DBC files in the wild are either UTF-8 or Windows-1252/Latin-1
+    const QByteArray bytes = file.readAll();
+    const QString content = bytes.isValidUtf8() ? QString::fromUtf8(bytes)
+                                                : QString::fromLatin1(bytes);
+
+    if (!loadFromString(content)) {
+        qWarning() << "DbcProtocol: No usable messages in DBC file:" << path;
+        return false;
+    }
+
+    qDebug() << "DbcProtocol: Loaded" << m_messages.size() << "messages from" << path;
+    return true;
+}
+
+bool DbcProtocol::loadFromString(const QString& content) {
+    m_messages.clear();
+
+    // Parse into a vector first; raw DBC IDs are needed to resolve VAL_ and
+    // SIG_VALTYPE_ statements, which always follow the message blocks.
+    std::vector<std::pair<uint32_t, DbcMessageDefinition>> parsed;
+    QStringList deferredStatements;
+    QString pendingStatement;
+    bool inMessage = false;
+
+    const QStringList lines = content.split(u'\n');
+    for (const QString& rawLine : lines) {
+        const QString line = rawLine.trimmed();
+
+        if (!pendingStatement.isEmpty()) {
+            pendingStatement += QLatin1Char('\n');
+            pendingStatement += line;
+            if (isStatementTerminated(pendingStatement)) {
+                deferredStatements.append(pendingStatement);
+                pendingStatement.clear();
+            }
+            continue;
+        }
+
+        if (line.startsWith(QLatin1String(KEYWORD_SIGNAL))) {
+            if (inMessage) {
+                parseSignal(line, parsed.back().second);
+            }
+            continue;
+        }
+
+        inMessage = false;
+
+        if (line.startsWith(QLatin1String(KEYWORD_MESSAGE))) {
+            uint32_t rawId = 0;
+            DbcMessageDefinition message;
+            if (parseMessage(line, rawId, message)) {
+                parsed.emplace_back(rawId, std::move(message));
+                inMessage = true;
+            }
+        } else if (isTerminatedStatement(line)) {
+            if (isStatementTerminated(line)) {
+                deferredStatements.append(line);
+            } else {
+                pendingStatement = line;
+            }
+        }
+    }
+
+    QHash<uint32_t, DbcMessageDefinition*> messagesByRawId;
+    for (auto& [rawId, message] : parsed) {
+        // The first definition of a message wins, here and in m_messages
+        if (!messagesByRawId.contains(rawId)) {
+            messagesByRawId.insert(rawId, &message);
+        }
+    }
+
+    for (const QString& statement : deferredStatements) {
+        if (statement.startsWith(QLatin1String(KEYWORD_VALUE_TABLE))) {
+            parseValueTable(statement, messagesByRawId);
+        } else if (statement.startsWith(QLatin1String(KEYWORD_VALUE_TYPE))) {
+            parseValueType(statement, messagesByRawId);
+        }
+    }
+
+    for (auto& [rawId, message] : parsed) {
+        if (message.signalDefs.empty()) {
+            continue;
+        }
+
+        bool hasMultiplexedSignals = false;
+        for (size_t i = 0; i < message.signalDefs.size(); ++i) {
+            if (message.signalDefs[i].isMultiplexor) {
+                message.multiplexorIndex = static_cast<int>(i);
+            }
+            hasMultiplexedSignals = hasMultiplexedSignals || message.signalDefs[i].isMultiplexed;
+        }
+        if (hasMultiplexedSignals && message.multiplexorIndex < 0) {
+            qWarning() << "DbcProtocol: Message" << message.name
+                       << "has multiplexed signals but no multiplexor - they will not decode";
+        }
+
+        const uint32_t key = messageKey(message.frameId, message.extended);
+        auto existing = m_messages.constFind(key);
+        if (existing != m_messages.constEnd()) {
+            qWarning() << "DbcProtocol: Duplicate frame ID" << Qt::hex << message.frameId
+                       << "- keeping" << existing->name << "and ignoring" << message.name;
+            continue;
+        }
+        m_messages.insert(key, std::move(message));
+    }
+
+    // Signal names reused across messages would all write to one channel
+    QHash<QString, int> nameCounts;
+    for (const auto& message : std::as_const(m_messages)) {
+        for (const auto& signalDef : message.signalDefs) {
+            ++nameCounts[signalDef.name];
+        }
+    }
+    QSet<QString> reusedNames;
+    for (auto it = nameCounts.constBegin(); it != nameCounts.constEnd(); ++it) {
+        if (it.value() > 1) {
+            reusedNames.insert(it.key());
+        }
+    }
+    qualifyChannels(reusedNames);
+
+    return !m_messages.isEmpty();
+}
+
+bool DbcProtocol::parseMessage(const QString& line, uint32_t& rawId,
+                               DbcMessageDefinition& message) {
+    const auto match = MESSAGE_PATTERN.match(line);
+    if (!match.hasMatch()) {
+        qWarning() << "DbcProtocol: Malformed message line:" << line;
+        return false;
+    }
+
+    bool idOk = false;
+    rawId = match.captured(1).toUInt(&idOk);
+    if (!idOk || match.captured(2) == QLatin1String(INDEPENDENT_SIGNALS_MESSAGE)) {
+        return false;
+    }
+
+    message.extended = (rawId & DBC_EXTENDED_FLAG) != 0;
+    message.frameId = rawId & EXTENDED_ID_MASK;
+    message.name = match.captured(2);
+    message.length = match.captured(3).toInt();
+    return true;
+}
+
+void DbcProtocol::parseSignal(const QString& line, DbcMessageDefinition& message) {
+    const auto match = SIGNAL_PATTERN.match(line);
+    if (!match.hasMatch()) {
+        qWarning() << "DbcProtocol: Malformed signal in" << message.name << ":" << line;
+        return;
+    }
+
+    const QString name = match.captured(1);
+    const QString muxIndicator = match.captured(2);
+    const int startBit = match.captured(3).toInt();
+    const int bitLength = match.captured(4).toInt();
+    const ByteOrder order = (match.captured(5) == QLatin1String("1")) ? ByteOrder::LittleEndian
+                                                                       : ByteOrder::BigEndian;
+    const bool isSigned = (match.captured(6) == QLatin1String("-"));
+
+    auto extractor = SignalExtractor::fromDbc(startBit, bitLength, order, isSigned);
+    if (!extractor) {
+        qWarning() << "DbcProtocol: Unsupported bit layout for" << message.name << "." << name
+                   << "(start" << startBit << "length" << bitLength << ")";
+        return;
+    }
+    extractor->scale = match.captured(7).toDouble();
+    extractor->offset = match.captured(8).toDouble();
+
+    DbcSignalDefinition signalDef;
+    signalDef.name = name;
+    signalDef.channelName = name;
+    signalDef.unit = match.captured(9);
+    signalDef.extractor = *extractor;
+
+    if (muxIndicator == QLatin1String("M")) {
+        signalDef.isMultiplexor = true;
+    } else if (!muxIndicator.isEmpty()) {
+        // "m3" or "m3M" (extended multiplexing, treated as plain multiplexed)
+        QString value = muxIndicator.mid(1);
+        if (value.endsWith(u'M')) {
+            value.chop(1);
+        }
+        signalDef.isMultiplexed = true;
+        signalDef.muxValue = value.toLongLong();
+    }
+
+    message.signalDefs.push_back(std::move(signalDef));
+}
+
+void DbcProtocol::parseValueTable(
+    const QString& statement, const QHash<uint32_t, DbcMessageDefinition*>& messagesByRawId) {
+    const auto match = VALUE_TABLE_PATTERN.match(statement);
+    if (!match.hasMatch()) {
+        return; // Environment variable tables have no message ID - not needed
+    }
+
+    auto* message = messagesByRawId.value(match.captured(1).toUInt(), nullptr);
+    DbcSignalDefinition* signalDef =
+        (message != nullptr) ? findSignal(*message, match.captured(2)) : nullptr;
+    if (signalDef == nullptr) {
+        return;
+    }
+
+    QHash<qint64, QString>& table = signalDef->valueDescriptions;
+    auto pairs = VALUE_PAIR_PATTERN.globalMatch(match.captured(3));
+    while (pairs.hasNext()) {
+        const auto pair = pairs.next();
+        table.insert(pair.captured(1).toLongLong(), pair.captured(2));
+    }
+}
+
+void DbcProtocol::parseValueType(const QString& statement,
+                                 const QHash<uint32_t, DbcMessageDefinition*>& messagesByRawId) {
+    const auto match = VALUE_TYPE_PATTERN.match(statement);
+    if (!match.hasMatch()) {
+        return;
+    }
+
+    auto* message = messagesByRawId.value(match.captured(1).toUInt(), nullptr);
+    DbcSignalDefinition* signalDef =
+        (message != nullptr) ? findSignal(*message, match.captured(2)) : nullptr;
+    if (signalDef == nullptr) {
+        return;
+    }
+
+    const int valueType = match.captured(3).toInt();
+    const int bitLength = signalDef->extractor.bitLength;
+    if (valueType == VALTYPE_FLOAT32 && bitLength == FLOAT32_BITS) {
+        signalDef->extractor.valueType = SignalValueType::Float32;
+    } else if (valueType == VALTYPE_FLOAT64 && bitLength == FLOAT64_BITS) {
+        signalDef->extractor.valueType = SignalValueType::Float64;
+    } else if (valueType != 0) {
+        qWarning() << "DbcProtocol: SIG_VALTYPE_" << valueType << "does not match"
+                   << bitLength << "bit signal" << signalDef->name;
+    }
+}
+
+//=============================================================================
+// Queries
+//=============================================================================
+
+QSet<QString> DbcProtocol::availableChannels() const {
+    QSet<QString> channels;
+    for (const auto& message : m_messages) {
+        for (const auto& signalDef : message.signalDefs) {
+            channels.insert(signalDef.channelName);
+        }
+    }
+    return channels;
+}
+
+QList<uint32_t> DbcProtocol::frameIds() const {
+    QList<uint32_t> frameIds;
+    frameIds.reserve(m_messages.size());
+    for (const auto& definition : m_messages) {
+        frameIds.append(definition.frameId);
+    }
+    return frameIds;
+}
+
+const DbcMessageDefinition* DbcProtocol::findMessage(const FrameKey& key) const {
+    auto it = m_messages.constFind(messageKey(key.frameId, key.extended));
+    return (it != m_messages.constEnd()) ? &it.value() : nullptr;
+}
+
+std::vector<FrameKey> DbcProtocol::claimedFrames() const {
+    std::vector<FrameKey> frames;
+    frames.reserve(static_cast<size_t>(m_messages.size()));
+    for (const auto& definition : m_messages) {
+        frames.push_back(FrameKey{definition.frameId, definition.extended});
+    }
+    return frames;
+}
+
+QStringList DbcProtocol::frameChannels(const FrameKey& key) const {
+    QStringList channels;
+    const DbcMessageDefinition* definition = findMessage(key);
+    if (definition == nullptr) {
+        return channels;
+    }
+    for (const auto& signalDef : definition->signalDefs) {
+        channels.append(signalDef.channelName);
+    }
+    return channels;
+}
+
+QString DbcProtocol::valueDescription(const FrameKey& key, const QString& signalName,
+                                      qint64 rawValue) const {
+    const DbcMessageDefinition* definition = findMessage(key);
+    if (definition == nullptr) {
+        return {};
+    }
+    for (const auto& signalDef : definition->signalDefs) {
+        if (signalDef.name == signalName) {
+            return signalDef.valueDescriptions.value(rawValue);
+        }
+    }
+    return {};
+}
+
+void DbcProtocol::qualifyChannels(const QSet<QString>& channels) {
+    if (channels.isEmpty()) {
+        return;
+    }
+    for (auto& message : m_messages) {
+        for (auto& signalDef : message.signalDefs) {
+            if (!channels.contains(signalDef.channelName)) {
+                continue;
+            }
+            const QString qualified = message.name + u'.' + signalDef.name;
+            qWarning() << "DbcProtocol: Signal name" << signalDef.channelName
+                       << "is used more than once - publishing" << qualified;
+            signalDef.channelName = qualified;
+        }
+    }
+}
+
+//=============================================================================
+// Frame Decoding
+//=============================================================================
+
+int64_t DbcProtocol::multiplexValue(const QCanBusFrame& frame) const {
+    const DbcMessageDefinition* definition =
+        findMessage(FrameKey{frame.frameId(), frame.hasExtendedFrameFormat()});
+    if (definition == nullptr || definition->multiplexorIndex < 0) {
+        return 0;
+    }
+    const auto& multiplexor =
+        definition->signalDefs[static_cast<size_t>(definition->multiplexorIndex)];
+    const QByteArray payload = frame.payload();
+    if (multiplexor.extractor.requiredLength() > static_cast<int>(payload.size())) {
+        return 0;
+    }
+    return multiplexor.extractor.extractRaw(reinterpret_cast<const uint8_t*>(payload.constData()));
+}
+
+bool DbcProtocol::isMultiplexed(const FrameKey& key) const {
+    const DbcMessageDefinition* definition = findMessage(key);
+    return definition != nullptr && definition->multiplexorIndex >= 0;
+}
+
+std::vector<std::pair<QString, ChannelValue>> DbcProtocol::decode(const QCanBusFrame& frame) const {
+    if (!frame.isValid()) {
+        return {};
+    }
+
+    const DbcMessageDefinition* definition =
+        findMessage(FrameKey{frame.frameId(), frame.hasExtendedFrameFormat()});
+    if (definition == nullptr) {
+        return {};
+    }
+
+    const QByteArray payload = frame.payload();
+    const auto* data = reinterpret_cast<const uint8_t*>(payload.constData());
+    const auto size = static_cast<int>(payload.size());
+
+    // Resolve the active mux group once, before walking the signal list
+    int64_t activeMux = -1;
+    bool hasActiveMux = false;
+    if (definition->multiplexorIndex >= 0) {
+        const auto& multiplexor =
+            definition->signalDefs[static_cast<size_t>(definition->multiplexorIndex)];
+        if (multiplexor.extractor.requiredLength() <= size) {
+            activeMux = multiplexor.extractor.extractRaw(data);
+            hasActiveMux = true;
+        }
+    }
+
+    std::vector<std::pair<QString, ChannelValue>> results;
+    results.reserve(definition->signalDefs.size());
+
+    for (const auto& signalDef : definition->signalDefs) {
+        if (signalDef.isMultiplexed && (!hasActiveMux || signalDef.muxValue != activeMux)) {
+            continue;
+        }
+        if (signalDef.extractor.requiredLength() > size) {
+            continue;
+        }
+        ChannelValue value{signalDef.extractor.extract(data), signalDef.unit, true};
+        if (!signalDef.valueDescriptions.isEmpty()) {
+            value.text = signalDef.valueDescriptions.value(signalDef.extractor.extractRaw(data));
+        }
+        results.emplace_back(signalDef.channelName, std::move(value));
+    }
+
+    return results;
+}
+
+} // namespace devdash
@@ -0,0 +1,214 @@
+#pragma once
+
+#include "can/IFrameDecoder.h"
+#include "core/interfaces/IProtocolAdapter.h"
+#include "decode/SignalExtractor.h"
+
+#include <QCanBusFrame>
+#include <QHash>
+#include <QSet>
+#include <QString>
+
+#include <vector>
+
+namespace devdash {
+
+/**
+ * @brief Definition of a single signal compiled from a DBC SG_ line.
+ *
+ * The bit layout is resolved into a SignalExtractor at load time, so
+ * decoding a signal costs the same as decoding a native Haltech channel.
+ */
+struct DbcSignalDefinition {
+    QString name;               ///< Signal name
+    QString channelName;        ///< Published channel: name, or "Message.name" if reused
+    QString unit;               ///< Unit string from the DBC (may be empty)
+    SignalExtractor extractor;  ///< Precomputed shift/mask program
+    bool isMultiplexor = false; ///< "M" - this signal selects the active mux group
+    bool isMultiplexed = false; ///< "mN" - only present when the multiplexor equals muxValue
+    int64_t muxValue = 0;       ///< Multiplexor value this signal belongs to
+    QHash<qint64, QString> valueDescriptions; ///< VAL_ table: raw value to state name
+};
+
+/**
+ * @brief Definition of a CAN message compiled from a DBC BO_ block.
+ */
+struct DbcMessageDefinition {
+    uint32_t frameId = 0;       ///< CAN identifier without the DBC extended flag
+    bool extended = false;      ///< 29-bit identifier
+    QString name;               ///< Message name (e.g., "ABS_WheelSpeeds")
+    int length = 0;             ///< Declared DLC in bytes
+    int multiplexorIndex = -1;  ///< Index of the multiplexor in signalDefs, -1 if none
+    std::vector<DbcSignalDefinition> signalDefs; ///< Signals in this message
+};
+
+/**
+ * @brief Vector DBC decoder.
+ *
+ * Loads a DBC file and compiles every signal (Intel or Motorola, any bit
+ * position and width up to 64 bits, signed, float, multiplexed) into a
+ * SignalExtractor. Value tables (VAL_) are kept per signal of each message
+ * and published as ChannelValue::text, so the UI can show enumerated
+ * states by name.
+ *
+ * Signals are published under their name. Names that several messages use
+ * (Counter, Checksum, ...) would overwrite one channel, so those signals
+ * are published as "Message.Signal" instead, with a warning at load time.
+ *
+ * ## Supported DBC statements
+ *
+ * - `BO_` messages (standard and extended identifiers)
+ * - `SG_` signals, including simple multiplexing (`M` / `mN`)
+ * - `VAL_` value descriptions
+ * - `SIG_VALTYPE_` IEEE float/double signals
+ *
+ * All other statements (comments, attributes, node lists) are skipped.
+ * Extended multiplexing (`SG_MUL_VAL_`) is not supported; signals marked
+ * `mNM` are treated as plain multiplexed signals.
+ *
+ * ## Usage
+ *
+ * @code
+ * DbcProtocol dbc;
+ * if (!dbc.loadDefinition("dbc/abs.dbc")) {
+ *     qCritical() << "Failed to load DBC";
+ *     return;
+ * }
+ *
+ * auto channels = dbc.decode(canFrame);
+ * @endcode
+ *
+ * @note Single Responsibility: Protocol parsing only, no I/O operations.
+ * @see DbcAdapter for CAN bus I/O
+ */
+class DbcProtocol : public IFrameDecoder {
+public:
+    DbcProtocol();
+
+    /**
+     * @brief Load a DBC file.
+     *
+     * @param path Path to the .dbc file (UTF-8 or Latin-1)
+     * @return true if at least one message with signals was loaded
+     *
+     * @note Clears any previously loaded definitions
+     */
+    [[nodiscard]] bool loadDefinition(const QString& path);
+
+    /**
+     * @brief Load DBC content from a string.
+     *
+     * @param content Complete DBC file content
+     * @return true if at least one message with signals was loaded
+     *
+     * @note Clears any previously loaded definitions
+     */
+    [[nodiscard]] bool loadFromString(const QString& content);
+
+    /**
+     * @brief Check if a DBC has been loaded.
+     */
+    [[nodiscard]] bool isLoaded() const { return !m_messages.isEmpty(); }
+
+    /**
+     * @brief Get list of known frame IDs (without the frame format).
+     */
+    [[nodiscard]] QList<uint32_t> frameIds() const;
+
+    /**
+     * @brief Get set of all published channel names in the loaded DBC.
+     */
+    [[nodiscard]] QSet<QString> availableChannels() const;
+
+    /**
+     * @brief Get a compiled message definition.
+     * @return Pointer to the definition, or nullptr if the frame is unknown
+     */
+    [[nodiscard]] const DbcMessageDefinition* findMessage(const FrameKey& key) const;
+
+    /**
+     * @brief Get the frames to route to this decoder.
+     * @return One key per loaded message, with its frame format
+     */
+    [[nodiscard]] std::vector<FrameKey> claimedFrames() const override;
+
+    /**
+     * @brief Get the names of all signals of a message, every mux group included.
+     */
+    [[nodiscard]] QStringList frameChannels(const FrameKey& key) const override;
+
+    /**
+     * @brief Get the raw multiplexor value of a multiplexed message (0 otherwise).
+     */
+    [[nodiscard]] int64_t multiplexValue(const QCanBusFrame& frame) const override;
+
+    /**
+     * @brief Check whether a message has a multiplexor signal.
+     */
+    [[nodiscard]] bool isMultiplexed(const FrameKey& key) const override;
+
+    /**
+     * @brief Decode a CAN frame into channel values.
+     *
+     * For multiplexed messages only the signals of the active mux group
+     * (plus unmultiplexed signals) are returned. Signals that do not fit in
+     * the received payload are skipped. Signals with a VAL_ table carry the
+     * description of their raw value in ChannelValue::text.
+     *
+     * @param frame The CAN frame to decode
+     * @return Vector of (signal name, value) pairs
+     *
+     * @note Returns empty vector for unknown frame IDs (not an error)
+     */
+    [[nodiscard]] std::vector<std::pair<QString, ChannelValue>>
+    decode(const QCanBusFrame& frame) const override;
+
+    /**
+     * @brief Look up the VAL_ description for a raw signal value.
+     *
+     * @param key Frame carrying the signal
+     * @param signalName Signal name
+     * @param rawValue Raw (unscaled) value
+     * @return Description (e.g., "Active"), or empty string if none
+     */
+    [[nodiscard]] QString valueDescription(const FrameKey& key, const QString& signalName,
+                                           qint64 rawValue) const;
+
+    /**
+     * @brief Publish the signals of the given channels as "Message.Signal".
+     *
+     * Used when another decoder on the same bus (another DBC file) publishes
+     * the same channel names.
+     */
+    void qualifyChannels(const QSet<QString>& channels);
+
+private:
+    /// Messages keyed by DBC message ID (frame ID, bit 31 set for extended)
+    QHash<uint32_t, DbcMessageDefinition> m_messages;
+
+    /**
+     * @brief Parse a BO_ line into a new message definition.
+     * @return true if the line was a valid message header
+     */
+    [[nodiscard]] static bool parseMessage(const QString& line, uint32_t& rawId,
+                                           DbcMessageDefinition& message);
+
+    /**
+     * @brief Parse an SG_ line and append it to @p message.
+     */
+    static void parseSignal(const QString& line, DbcMessageDefinition& message);
+
+    /**
+     * @brief Apply a VAL_ statement to the matching signal.
+     */
+    static void parseValueTable(const QString& statement,
+                                const QHash<uint32_t, DbcMessageDefinition*>& messagesByRawId);
+
+    /**
+     * @brief Apply a SIG_VALTYPE_ statement to the matching signal.
+     */
+    static void parseValueType(const QString& statement,
+                               const QHash<uint32_t, DbcMessageDefinition*>& messagesByRawId);
+};
+
+} // namespace devdash
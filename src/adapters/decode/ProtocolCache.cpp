@@ -0,0 +1,230 @@
+/**
+ * @file ProtocolCache.cpp
+ * @brief Implementation of the binary protocol decode-table cache.
+ */
+
+#include "ProtocolCache.h"
+
+#include <QCryptographicHash>
+#include <QDebug>
+#include <QDir>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <QStandardPaths>
+
+#include <algorithm>
+
+namespace devdash {
+
+namespace {
+
+//=============================================================================
+// File Format Constants
+//=============================================================================
+
+constexpr std::array<char, 8> CACHE_MAGIC = {'D', 'D', 'P', 'R', 'O', 'T', 'O', '\0'};
+
+/// Cache bodies are padded to this alignment
+constexpr qsizetype RECORD_ALIGNMENT = 4;
+
+/// Hex digits of the source path digest used in cache file names
+constexpr int PATH_DIGEST_LENGTH = 16;
+
+constexpr const char* CACHE_DIR_ENV = "DEVDASH_PROTOCOL_CACHE_DIR";
+constexpr const char* CACHE_SUBDIRECTORY = "devdash/protocols";
+constexpr const char* CACHE_SUFFIX = ".bin";
+
+/**
+ * @brief Fixed header at the start of every cache file
+ */
+struct CacheHeader {
+    std::array<char, 8> magic{};
+    uint32_t version = 0;
+    uint32_t schema = 0;
+    uint32_t loaderVersion = 0;
+    uint32_t byteOrder = 0;
+    uint32_t bodySize = 0;
+    ProtocolCache::SourceHash sourceHash{};
+};
+
+static_assert(std::is_trivially_copyable_v<CacheHeader>);
+
+} // anonymous namespace
+
+//=============================================================================
+// Paths and Hashing
+//=============================================================================
+
+QString ProtocolCache::defaultDirectory() {
+    const QString fromEnv = qEnvironmentVariable(CACHE_DIR_ENV);
+    if (!fromEnv.isEmpty()) {
+        return fromEnv;
+    }
+    const QString base = QStandardPaths::writableLocation(QStandardPaths::GenericCacheLocation);
+    return base.isEmpty() ? QString() : base + QLatin1Char('/') + QLatin1String(CACHE_SUBDIRECTORY);
+}
+
+ProtocolCache::SourceHash ProtocolCache::hashSource(const QByteArray& source) {
+    const QByteArray digest = QCryptographicHash::hash(source, QCryptographicHash::Sha256);
+    SourceHash hash{};
+    std::memcpy(hash.data(), digest.constData(),
+                std::min<size_t>(hash.size(), static_cast<size_t>(digest.size())));
+    return hash;
+}
+
+QString ProtocolCache::pathFor(const QString& sourcePath, Schema schema) const {
+    const QFileInfo info(sourcePath);
+    const QByteArray pathDigest =
+        QCryptographicHash::hash(info.absoluteFilePath().toUtf8(), QCryptographicHash::Sha256)
+            .toHex()
+            .left(PATH_DIGEST_LENGTH);
+
+    return QStringLiteral("%1/%2-%3.%4%5")
+        .arg(m_directory, info.completeBaseName(), QString::fromLatin1(pathDigest))
+        .arg(static_cast<uint32_t>(schema))
+        .arg(QLatin1String(CACHE_SUFFIX));
+}
+
+//=============================================================================
+// Writing
+//=============================================================================
+
+bool ProtocolCache::write(const QString& cachePath, Schema schema, uint32_t loaderVersion,
+                          const SourceHash& hash, const QByteArray& body) const {
+    if (!isEnabled()) {
+        return false;
+    }
+    if (!QDir().mkpath(m_directory)) {
+        qDebug() << "ProtocolCache: Cannot create cache directory" << m_directory;
+        return false;
+    }
+
+    CacheHeader header;
+    header.magic = CACHE_MAGIC;
+    header.version = FORMAT_VERSION;
+    header.schema = static_cast<uint32_t>(schema);
+    header.loaderVersion = loaderVersion;
+    header.byteOrder = BYTE_ORDER_MARK;
+    header.bodySize = static_cast<uint32_t>(body.size());
+    header.sourceHash = hash;
+
+    // QSaveFile renames into place, so a concurrent reader never maps a partial file
+    QSaveFile file(cachePath);
+    if (!file.open(QIODevice::WriteOnly)) {
+        qDebug() << "ProtocolCache: Cannot write" << cachePath << "-" << file.errorString();
+        return false;
+    }
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file.write(body);
+    if (!file.commit()) {
+        qDebug() << "ProtocolCache: Failed to commit" << cachePath << "-" << file.errorString();
+        return false;
+    }
+
+    qDebug() << "ProtocolCache: Wrote" << body.size() << "byte body to" << cachePath;
+    return true;
+}
+
+void ProtocolCache::Writer::appendPadded(QByteArrayView bytes) {
+    m_data.append(bytes);
+    const qsizetype padding = (RECORD_ALIGNMENT - bytes.size() % RECORD_ALIGNMENT) %
+                              RECORD_ALIGNMENT;
+    m_data.append(padding, '\0');
+}
+
+void ProtocolCache::Writer::appendStrings(const StringTable& strings) {
+    appendArray(strings.records());
+    appendPadded(QByteArrayView(reinterpret_cast<const char*>(strings.data().utf16()),
+                                strings.data().size() * static_cast<qsizetype>(sizeof(char16_t))));
+}
+
+uint32_t ProtocolCache::StringTable::intern(const QString& text) {
+    auto it = m_indices.constFind(text);
+    if (it != m_indices.constEnd()) {
+        return it.value();
+    }
+    const auto index = static_cast<uint32_t>(m_records.size());
+    m_records.push_back({static_cast<uint32_t>(m_data.size()), static_cast<uint32_t>(text.size())});
+    m_data.append(text);
+    m_indices.insert(text, index);
+    return index;
+}
+
+//=============================================================================
+// Reading
+//=============================================================================
+
+bool ProtocolCache::Reader::readStrings(uint32_t count, uint32_t codeUnits,
+                                        std::vector<QString>& strings) {
+    std::vector<StringRecord> records;
+    if (!readArray(records, count)) {
+        return false;
+    }
+
+    const QByteArrayView data = remaining();
+    if (data.size() <
+        static_cast<qsizetype>(codeUnits) * static_cast<qsizetype>(sizeof(char16_t))) {
+        return false;
+    }
+
+    strings.clear();
+    strings.reserve(records.size());
+    for (const auto& record : records) {
+        if (static_cast<uint64_t>(record.offset) + record.length > codeUnits) {
+            return false;
+        }
+        QString value(static_cast<qsizetype>(record.length), Qt::Uninitialized);
+        std::memcpy(value.data(), data.data() + record.offset * sizeof(char16_t),
+                    record.length * sizeof(char16_t));
+        strings.push_back(std::move(value));
+    }
+    m_offset = m_body.size();
+    return true;
+}
+
+//=============================================================================
+// Mapping
+//=============================================================================
+
+ProtocolCache::Mapping::Mapping(const QString& cachePath, Schema schema, uint32_t loaderVersion,
+                                const SourceHash& hash)
+    : m_file(cachePath) {
+    if (cachePath.isEmpty() || !m_file.open(QIODevice::ReadOnly)) {
+        return;
+    }
+
+    const qint64 fileSize = m_file.size();
+    if (fileSize < static_cast<qint64>(sizeof(CacheHeader))) {
+        return;
+    }
+
+    uchar* data = m_file.map(0, fileSize);
+    if (data == nullptr) {
+        return;
+    }
+
+    CacheHeader header;
+    std::memcpy(&header, data, sizeof(header));
+
+    const bool valid = header.magic == CACHE_MAGIC && header.version == FORMAT_VERSION &&
+                       header.schema == static_cast<uint32_t>(schema) &&
+                       header.loaderVersion == loaderVersion &&
+                       header.byteOrder == BYTE_ORDER_MARK && header.sourceHash == hash &&
+                       static_cast<qint64>(sizeof(header)) + header.bodySize == fileSize;
+    if (!valid) {
+        m_file.unmap(data);
+        return;
+    }
+
+    m_data = data;
+    m_body = QByteArrayView(reinterpret_cast<const char*>(data) + sizeof(header),
+                            static_cast<qsizetype>(header.bodySize));
+}
+
+ProtocolCache::Mapping::~Mapping() {
+    if (m_data != nullptr) {
+        m_file.unmap(m_data);
+    }
+}
+
+} // namespace devdash
@@ -0,0 +1,286 @@
+#pragma once
+
+#include <QByteArray>
+#include <QByteArrayView>
+#include <QFile>
+#include <QHash>
+#include <QString>
+
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace devdash {
+
+/**
+ * @brief Versioned binary cache of compiled protocol decode tables
+ *
+ * Parsing protocol JSON with QJsonDocument is on the cold-boot path to the
+ * first valid RPM. Protocols compile their decode tables into a flat binary
+ * image once, keyed by the SHA-256 of the JSON source; later launches map
+ * the image with QFile::map() and deserialize the fixed-size records from
+ * the mapping into the protocol's own tables - no tokenizing, no QJsonValue
+ * tree.
+ *
+ * A cache file is used only if its magic, format version, schema, loader
+ * version, byte order and source hash all match, so editing the JSON (or
+ * upgrading to an incompatible format) regenerates it transparently.
+ *
+ * The loader version belongs to the protocol that owns the schema and
+ * describes how it compiles the JSON (units, conversions, aliases). The
+ * source hash cannot see such changes: the protocol must bump its loader
+ * version together with any change to its loader, or cached tables from
+ * older builds keep being served.
+ *
+ * ## File layout
+ *
+ * | Field       | Size | Notes                                 |
+ * |-------------|------|---------------------------------------|
+ * | magic       | 8    | "DDPROTO\0"                           |
+ * | version     | 4    | FORMAT_VERSION                        |
+ * | schema      | 4    | Schema of the body                    |
+ * | loader      | 4    | Loader version of the schema's owner  |
+ * | byteOrder   | 4    | BYTE_ORDER_MARK as written            |
+ * | bodySize    | 4    | Bytes following the header            |
+ * | sourceHash  | 32   | SHA-256 of the JSON source            |
+ * | body        | n    | Protocol-specific records             |
+ *
+ * @code
+ * ProtocolCache cache(ProtocolCache::defaultDirectory());
+ * const auto hash = ProtocolCache::hashSource(json);
+ * const QString cachePath = cache.pathFor(jsonPath, ProtocolCache::Schema::HaltechFrames);
+ *
+ * ProtocolCache::Mapping mapping(cachePath, ProtocolCache::Schema::HaltechFrames,
+ *                                LOADER_VERSION, hash);
+ * if (mapping.isValid()) {
+ *     ProtocolCache::Reader reader(mapping.body());
+ *     ...
+ * }
+ * @endcode
+ */
+class ProtocolCache {
+  public:
+    /// Bumped whenever the header or any body layout changes
+    static constexpr uint32_t FORMAT_VERSION = 3;
+
+    /// Written in native order; a mismatch means the file came from another host
+    static constexpr uint32_t BYTE_ORDER_MARK = 0x01020304;
+
+    /// SHA-256 digest size in bytes
+    static constexpr int HASH_SIZE = 32;
+
+    using SourceHash = std::array<uint8_t, HASH_SIZE>;
+
+    /**
+     * @brief Body layout stored in a cache file
+     */
+    enum class Schema : uint32_t {
+        HaltechFrames = 1, ///< HaltechProtocol frame and channel definitions
+        PD16Tables = 2     ///< PD16Protocol decode tables
+    };
+
+    /**
+     * @brief Create a cache rooted at a directory
+     * @param directory Cache directory; empty disables caching
+     */
+    explicit ProtocolCache(QString directory) : m_directory(std::move(directory)) {}
+
+    /**
+     * @brief Default cache directory
+     *
+     * $DEVDASH_PROTOCOL_CACHE_DIR if set, otherwise "devdash/protocols"
+     * under the user's generic cache location.
+     */
+    [[nodiscard]] static QString defaultDirectory();
+
+    /**
+     * @brief SHA-256 of a protocol source file
+     */
+    [[nodiscard]] static SourceHash hashSource(const QByteArray& source);
+
+    /**
+     * @brief Check whether caching is enabled
+     */
+    [[nodiscard]] bool isEnabled() const { return !m_directory.isEmpty(); }
+
+    /**
+     * @brief Cache file path for a source file and schema
+     *
+     * The file name combines the source's base name with a digest of its
+     * absolute path, so two protocol files never share a cache entry.
+     */
+    [[nodiscard]] QString pathFor(const QString& sourcePath, Schema schema) const;
+
+    /**
+     * @brief Write a cache file atomically
+     *
+     * @param loaderVersion Version of the loader that compiled @p body
+     * @return false if the directory or file cannot be written (caching is
+     *         best effort; callers continue with their parsed tables)
+     */
+    bool write(const QString& cachePath, Schema schema, uint32_t loaderVersion,
+               const SourceHash& hash, const QByteArray& body) const;
+
+    /**
+     * @brief Read-only memory mapping of a validated cache file
+     *
+     * The body view is valid for the lifetime of the mapping.
+     */
+    class Mapping {
+      public:
+        Mapping(const QString& cachePath, Schema schema, uint32_t loaderVersion,
+                const SourceHash& hash);
+        ~Mapping();
+
+        Mapping(const Mapping&) = delete;
+        Mapping& operator=(const Mapping&) = delete;
+        Mapping(Mapping&&) = delete;
+        Mapping& operator=(Mapping&&) = delete;
+
+        /**
+         * @brief Check whether the file exists and matches schema, loader and hash
+         */
+        [[nodiscard]] bool isValid() const { return m_data != nullptr; }
+
+        /**
+         * @brief Protocol-specific records following the header
+         */
+        [[nodiscard]] QByteArrayView body() const { return m_body; }
+
+      private:
+        QFile m_file;
+        uchar* m_data = nullptr;
+        QByteArrayView m_body;
+    };
+
+    /**
+     * @brief Location of one string in a cache body's string data
+     */
+    struct StringRecord {
+        uint32_t offset = 0; ///< Offset into the string data, in UTF-16 code units
+        uint32_t length = 0; ///< Length in UTF-16 code units
+    };
+
+    /**
+     * @brief Interns strings for a cache body
+     *
+     * Records refer to strings by index; identical strings are stored once.
+     */
+    class StringTable {
+      public:
+        uint32_t intern(const QString& text);
+
+        [[nodiscard]] uint32_t count() const { return static_cast<uint32_t>(m_records.size()); }
+        [[nodiscard]] uint32_t codeUnits() const { return static_cast<uint32_t>(m_data.size()); }
+        [[nodiscard]] const std::vector<StringRecord>& records() const { return m_records; }
+        [[nodiscard]] const QString& data() const { return m_data; }
+
+      private:
+        QHash<QString, uint32_t> m_indices;
+        std::vector<StringRecord> m_records;
+        QString m_data;
+    };
+
+    /**
+     * @brief Appends fixed-size records to a cache body
+     */
+    class Writer {
+      public:
+        template <typename T>
+        void append(const T& record) {
+            static_assert(std::is_trivially_copyable_v<T>,
+                          "cache records must be trivially copyable");
+            m_data.append(QByteArrayView(reinterpret_cast<const char*>(&record), sizeof(T)));
+        }
+
+        template <typename T>
+        void appendArray(const std::vector<T>& records) {
+            for (const T& record : records) {
+                append(record);
+            }
+        }
+
+        /**
+         * @brief Append raw bytes, padded to a 4-byte boundary
+         */
+        void appendPadded(QByteArrayView bytes);
+
+        /**
+         * @brief Append a string table (records, then padded UTF-16 data)
+         *
+         * Must be the last block of a body: Reader::readStrings() consumes
+         * the remainder.
+         */
+        void appendStrings(const StringTable& strings);
+
+        [[nodiscard]] const QByteArray& data() const { return m_data; }
+
+      private:
+        QByteArray m_data;
+    };
+
+    /**
+     * @brief Bounds-checked reads of fixed-size records from a cache body
+     *
+     * Every read fails (returns false) instead of reading past the end, so a
+     * truncated or corrupt file falls back to parsing the JSON.
+     */
+    class Reader {
+      public:
+        explicit Reader(QByteArrayView body) : m_body(body) {}
+
+        template <typename T>
+        [[nodiscard]] bool read(T& record) {
+            static_assert(std::is_trivially_copyable_v<T>,
+                          "cache records must be trivially copyable");
+            if (m_offset + static_cast<qsizetype>(sizeof(T)) > m_body.size()) {
+                return false;
+            }
+            std::memcpy(&record, m_body.data() + m_offset, sizeof(T));
+            m_offset += static_cast<qsizetype>(sizeof(T));
+            return true;
+        }
+
+        template <typename T>
+        [[nodiscard]] bool readArray(std::vector<T>& records, uint32_t count) {
+            if (static_cast<qsizetype>(count) >
+                (m_body.size() - m_offset) / static_cast<qsizetype>(sizeof(T))) {
+                return false;
+            }
+            records.resize(count);
+            for (T& record : records) {
+                (void)read(record);
+            }
+            return true;
+        }
+
+        /**
+         * @brief Read a string table written by Writer::appendStrings()
+         *
+         * Strings are copied out of the body, so they outlive the mapping.
+         *
+         * @param count Number of strings (StringTable::count())
+         * @param codeUnits Size of the string data (StringTable::codeUnits())
+         * @param strings Receives the strings, indexed as interned
+         */
+        [[nodiscard]] bool readStrings(uint32_t count, uint32_t codeUnits,
+                                       std::vector<QString>& strings);
+
+        /**
+         * @brief View of the unread remainder of the body
+         */
+        [[nodiscard]] QByteArrayView remaining() const { return m_body.sliced(m_offset); }
+
+      private:
+        QByteArrayView m_body;
+        qsizetype m_offset = 0;
+    };
+
+  private:
+    QString m_directory;
+};
+
+} // namespace devdash
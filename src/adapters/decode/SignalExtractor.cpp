@@ -0,0 +1,116 @@
+/**
+ * @file SignalExtractor.cpp
+ * @brief Load-time compilation of signal bit layouts into shift/mask programs.
+ */
+
+#include "SignalExtractor.h"
+
+namespace devdash {
+
+namespace {
+
+//=============================================================================
+// Bit Layout Constants
+//=============================================================================
+
+/// Highest bit index inside a byte
+constexpr int MSB_IN_BYTE = 7;
+
+/// Bits per payload byte
+constexpr int BITS_PER_BYTE = SignalExtractor::BITS_PER_BYTE;
+
+/**
+ * @brief Build a mask with the lowest @p bitLength bits set.
+ */
+uint64_t lowBitsMask(int bitLength) {
+    if (bitLength >= SignalExtractor::MAX_BITS) {
+        return ~uint64_t{0};
+    }
+    return (uint64_t{1} << static_cast<unsigned>(bitLength)) - 1U;
+}
+
+/**
+ * @brief Compile a signal given its bit span in byte-major bit order.
+ *
+ * "Linear" positions number bits left to right across the payload with
+ * bit 0 being the MSB of byte 0. Both Intel and Motorola layouts are
+ * reduced to a [first, last] linear range before calling this.
+ *
+ * @param firstByte First byte touched by the signal
+ * @param lastByte Last byte touched by the signal
+ * @param shift Right shift that aligns the signal LSB to bit 0
+ */
+std::optional<SignalExtractor> makeExtractor(int firstByte, int lastByte, int shift,
+                                             int bitLength, ByteOrder order, bool isSigned) {
+    const int byteCount = lastByte - firstByte + 1;
+    if (firstByte < 0 || byteCount <= 0 || byteCount > SignalExtractor::MAX_BYTES ||
+        bitLength <= 0 || bitLength > SignalExtractor::MAX_BITS || shift < 0 ||
+        shift + bitLength > byteCount * BITS_PER_BYTE) {
+        return std::nullopt;
+    }
+
+    SignalExtractor extractor;
+    extractor.firstByte = static_cast<uint16_t>(firstByte);
+    extractor.byteCount = static_cast<uint8_t>(byteCount);
+    extractor.shift = static_cast<uint8_t>(shift);
+    extractor.bitLength = static_cast<uint8_t>(bitLength);
+    extractor.mask = lowBitsMask(bitLength);
+    extractor.order = order;
+    extractor.isSigned = isSigned;
+    return extractor;
+}
+
+/**
+ * @brief Compile a big-endian signal from its linear MSB position.
+ */
+std::optional<SignalExtractor> fromBigEndianLinear(int msbLinear, int bitLength, bool isSigned) {
+    if (msbLinear < 0 || bitLength <= 0) {
+        return std::nullopt;
+    }
+    const int lsbLinear = msbLinear + bitLength - 1;
+    const int shift = MSB_IN_BYTE - (lsbLinear % BITS_PER_BYTE);
+    return makeExtractor(msbLinear / BITS_PER_BYTE, lsbLinear / BITS_PER_BYTE, shift, bitLength,
+                         ByteOrder::BigEndian, isSigned);
+}
+
+} // anonymous namespace
+
+//=============================================================================
+// Factory Functions
+//=============================================================================
+
+std::optional<SignalExtractor> SignalExtractor::fromDbc(int startBit, int bitLength,
+                                                        ByteOrder order, bool isSigned) {
+    if (startBit < 0 || bitLength <= 0) {
+        return std::nullopt;
+    }
+
+    if (order == ByteOrder::LittleEndian) {
+        // Intel: start bit is the LSB, bits grow towards higher byte indices
+        const int lastBit = startBit + bitLength - 1;
+        return makeExtractor(startBit / BITS_PER_BYTE, lastBit / BITS_PER_BYTE,
+                             startBit % BITS_PER_BYTE, bitLength, order, isSigned);
+    }
+
+    // Motorola: start bit is the MSB in sawtooth numbering
+    const int msbLinear =
+        ((startBit / BITS_PER_BYTE) * BITS_PER_BYTE) + (MSB_IN_BYTE - (startBit % BITS_PER_BYTE));
+    return fromBigEndianLinear(msbLinear, bitLength, isSigned);
+}
+
+std::optional<SignalExtractor> SignalExtractor::fromPositions(int msbByte, int msbBit, int lsbByte,
+                                                              int lsbBit, bool isSigned) {
+    if (msbBit < 0 || msbBit > MSB_IN_BYTE || lsbBit < 0 || lsbBit > MSB_IN_BYTE) {
+        return std::nullopt;
+    }
+    const int msbLinear = (msbByte * BITS_PER_BYTE) + (MSB_IN_BYTE - msbBit);
+    const int lsbLinear = (lsbByte * BITS_PER_BYTE) + (MSB_IN_BYTE - lsbBit);
+    return fromBigEndianLinear(msbLinear, lsbLinear - msbLinear + 1, isSigned);
+}
+
+std::optional<SignalExtractor> SignalExtractor::fromBytes(int firstByte, int byteCount,
+                                                          bool isSigned) {
+    return fromBigEndianLinear(firstByte * BITS_PER_BYTE, byteCount * BITS_PER_BYTE, isSigned);
+}
+
+} // namespace devdash
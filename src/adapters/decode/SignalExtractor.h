@@ -0,0 +1,161 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <optional>
+
+namespace devdash {
+
+/**
+ * @brief Bit ordering of a signal inside a CAN payload.
+ *
+ * BigEndian is Motorola ordering (Haltech, PD16, DBC "@0"),
+ * LittleEndian is Intel ordering (DBC "@1").
+ */
+enum class ByteOrder : uint8_t {
+    BigEndian,   ///< Most significant byte first (Motorola)
+    LittleEndian ///< Least significant byte first (Intel)
+};
+
+/**
+ * @brief Interpretation of the extracted raw bits.
+ */
+enum class SignalValueType : uint8_t {
+    Integer, ///< Two's complement or unsigned integer
+    Float32, ///< IEEE 754 single precision (DBC SIG_VALTYPE_ 1)
+    Float64  ///< IEEE 754 double precision (DBC SIG_VALTYPE_ 2)
+};
+
+/**
+ * @brief Precomputed shift/mask program for one signal.
+ *
+ * All bit-position arithmetic (Intel vs Motorola numbering, byte span,
+ * shift and mask) is resolved once at load time. Extraction at runtime is
+ * a bounded byte load into a 64-bit accumulator followed by one shift, one
+ * mask and an optional sign extension - no branches on bit layout, no
+ * allocation, no lookups.
+ *
+ * Signals spanning more than 8 bytes (e.g. an unaligned 64-bit value) are
+ * rejected at compile time by the factory functions.
+ *
+ * @code
+ * // DBC: SG_ EngineSpeed : 24|16@1+ (0.125,0) [0|8031.875] "rpm"
+ * auto ex = SignalExtractor::fromDbc(24, 16, ByteOrder::LittleEndian, false);
+ * ex->scale = 0.125;
+ * double rpm = ex->extract(payload);
+ * @endcode
+ */
+struct SignalExtractor {
+    uint64_t mask = 0;        ///< Mask applied after shifting (bitLength ones)
+    double scale = 1.0;       ///< Physical = raw * scale + offset
+    double offset = 0.0;      ///< Physical = raw * scale + offset
+    uint16_t firstByte = 0;   ///< First payload byte covered by the signal
+    uint8_t byteCount = 0;    ///< Number of payload bytes covered (1-8)
+    uint8_t shift = 0;        ///< Right shift applied to the loaded accumulator
+    uint8_t bitLength = 0;    ///< Signal width in bits (1-64)
+    ByteOrder order = ByteOrder::BigEndian;
+    SignalValueType valueType = SignalValueType::Integer;
+    bool isSigned = false;    ///< Sign-extend the raw value
+
+    /**
+     * @brief Compile a signal from DBC bit numbering.
+     *
+     * For Intel signals @p startBit is the LSB; for Motorola signals it is
+     * the MSB, both in DBC "sawtooth" numbering (byte * 8 + bit, bit 0 = LSB
+     * of the byte).
+     *
+     * @return Extractor, or std::nullopt if the layout is invalid or spans
+     *         more than 8 bytes
+     */
+    [[nodiscard]] static std::optional<SignalExtractor>
+    fromDbc(int startBit, int bitLength, ByteOrder order, bool isSigned);
+
+    /**
+     * @brief Compile a big-endian signal from MSB/LSB byte:bit positions.
+     *
+     * Matches the "2:7-3:0" position notation used by the Haltech JSON
+     * definitions (MSB at byte 2 bit 7, LSB at byte 3 bit 0).
+     *
+     * @return Extractor, or std::nullopt if the layout is invalid
+     */
+    [[nodiscard]] static std::optional<SignalExtractor>
+    fromPositions(int msbByte, int msbBit, int lsbByte, int lsbBit, bool isSigned);
+
+    /**
+     * @brief Compile a whole-byte big-endian field.
+     *
+     * @param firstByte First byte of the field
+     * @param byteCount Width in bytes (1-8)
+     * @param isSigned Whether to sign-extend
+     */
+    [[nodiscard]] static std::optional<SignalExtractor> fromBytes(int firstByte, int byteCount,
+                                                                  bool isSigned);
+
+    /**
+     * @brief Minimum payload length needed to extract this signal.
+     */
+    [[nodiscard]] int requiredLength() const { return firstByte + byteCount; }
+
+    /**
+     * @brief Extract the raw (unscaled) bits.
+     * @pre @p data holds at least requiredLength() bytes
+     */
+    [[nodiscard]] uint64_t extractBits(const uint8_t* data) const {
+        const uint8_t* bytes = data + firstByte;
+        uint64_t accumulator = 0;
+        if (order == ByteOrder::BigEndian) {
+            for (int i = 0; i < byteCount; ++i) {
+                accumulator = (accumulator << BITS_PER_BYTE) | bytes[i];
+            }
+        } else {
+            for (int i = byteCount - 1; i >= 0; --i) {
+                accumulator = (accumulator << BITS_PER_BYTE) | bytes[i];
+            }
+        }
+        return (accumulator >> shift) & mask;
+    }
+
+    /**
+     * @brief Extract the raw value with sign extension applied.
+     * @pre @p data holds at least requiredLength() bytes
+     */
+    [[nodiscard]] int64_t extractRaw(const uint8_t* data) const {
+        uint64_t bits = extractBits(data);
+        if (isSigned && bitLength < MAX_BITS && (bits >> (bitLength - 1U)) != 0) {
+            bits |= ~mask;
+        }
+        return static_cast<int64_t>(bits);
+    }
+
+    /**
+     * @brief Extract the physical value (raw * scale + offset).
+     * @pre @p data holds at least requiredLength() bytes
+     */
+    [[nodiscard]] double extract(const uint8_t* data) const {
+        double raw = 0.0;
+        if (valueType == SignalValueType::Integer) {
+            raw = isSigned ? static_cast<double>(extractRaw(data))
+                           : static_cast<double>(extractBits(data));
+        } else if (valueType == SignalValueType::Float32) {
+            auto bits = static_cast<uint32_t>(extractBits(data));
+            float value = 0.0F;
+            std::memcpy(&value, &bits, sizeof(value));
+            raw = static_cast<double>(value);
+        } else {
+            uint64_t bits = extractBits(data);
+            std::memcpy(&raw, &bits, sizeof(raw));
+        }
+        return (raw * scale) + offset;
+    }
+
+    /// Bits per payload byte
+    static constexpr int BITS_PER_BYTE = 8;
+
+    /// Widest supported signal
+    static constexpr int MAX_BITS = 64;
+
+    /// Widest supported byte span
+    static constexpr int MAX_BYTES = 8;
+};
+
+} // namespace devdash
@@ -6,6 +6,7 @@
 #include "HaltechAdapter.h"
 
 #include <QDebug>
+#include <QJsonArray>
 
 namespace devdash {
 
@@ -15,15 +16,10 @@ namespace {
 // Configuration Keys
 //=============================================================================
 
-constexpr const char* CONFIG_KEY_INTERFACE = "interface";
 constexpr const char* CONFIG_KEY_PROTOCOL_FILE = "protocolFile";
-
-//=============================================================================
-// Default Values
-//=============================================================================
-
-constexpr const char* DEFAULT_CAN_INTERFACE = "vcan0";
-constexpr const char* CAN_PLUGIN_NAME = "socketcan";
+constexpr const char* CONFIG_KEY_PD16_PROTOCOL_FILE = "pd16ProtocolFile";
+constexpr const char* CONFIG_KEY_PD16_DEVICES = "pd16Devices";
+constexpr const char* CONFIG_KEY_PD16_CHANNEL_MAPPING = "pd16ChannelMapping";
 
 } // anonymous namespace
 
@@ -32,9 +28,7 @@ constexpr const char* CAN_PLUGIN_NAME = "socketcan";
 //=============================================================================
 
 HaltechAdapter::HaltechAdapter(const QJsonObject& config, QObject* parent)
-    : IProtocolAdapter(parent) {
-
-    m_interface = config[CONFIG_KEY_INTERFACE].toString(DEFAULT_CAN_INTERFACE);
+    : CanAdapter(config, parent) {
 
     // Load protocol definition from JSON
     QString protocolFile = config[CONFIG_KEY_PROTOCOL_FILE].toString();
@@ -46,6 +40,9 @@ HaltechAdapter::HaltechAdapter(const QJsonObject& config, QObject* parent)
         qDebug() << "HaltechAdapter: Loaded protocol with" << m_protocol.frameIds().size()
                  << "frame definitions";
     }
+    router().addDecoder(&m_protocol);
+
+    loadPD16Devices(config);
 }
 
 HaltechAdapter::~HaltechAdapter() {
@@ -56,130 +53,46 @@ HaltechAdapter::~HaltechAdapter() {
 // IProtocolAdapter Interface
 //=============================================================================
 
-bool HaltechAdapter::start() {
-    if (m_running) {
-        return true;
-    }
-
-    if (!m_protocol.isLoaded()) {
-        qWarning() << "HaltechAdapter: Starting without protocol definition loaded";
-    }
-
-    QString errorString;
-    m_canDevice.reset(
-        QCanBus::instance()->createDevice(CAN_PLUGIN_NAME, m_interface, &errorString));
-
-    if (!m_canDevice) {
-        qCritical() << "HaltechAdapter: Failed to create CAN device:" << errorString;
-        emit errorOccurred(errorString);
-        return false;
-    }
-
-    connect(m_canDevice.get(), &QCanBusDevice::framesReceived, this,
-            &HaltechAdapter::onFramesReceived);
-    connect(m_canDevice.get(), &QCanBusDevice::errorOccurred, this,
-            &HaltechAdapter::onErrorOccurred);
-    connect(m_canDevice.get(), &QCanBusDevice::stateChanged, this, &HaltechAdapter::onStateChanged);
-
-    if (!m_canDevice->connectDevice()) {
-        qCritical() << "HaltechAdapter: Failed to connect CAN device:"
-                    << m_canDevice->errorString();
-        emit errorOccurred(m_canDevice->errorString());
-        m_canDevice.reset();
-        return false;
-    }
-
-    m_running = true;
-    qInfo() << "HaltechAdapter: Started on interface" << m_interface;
-    return true;
-}
-
-void HaltechAdapter::stop() {
-    if (!m_running) {
-        return;
-    }
-
-    if (m_canDevice) {
-        m_canDevice->disconnectDevice();
-        m_canDevice.reset();
-    }
-
-    m_running = false;
-    qInfo() << "HaltechAdapter: Stopped";
-    emit connectionStateChanged(false);
-}
-
-bool HaltechAdapter::isRunning() const {
-    return m_running;
-}
-
-std::optional<ChannelValue> HaltechAdapter::getChannel(const QString& channelName) const {
-    auto it = m_channels.find(channelName);
-    if (it != m_channels.end()) {
-        return it.value();
-    }
-    return std::nullopt;
-}
-
-QStringList HaltechAdapter::availableChannels() const {
-    return m_channels.keys();
-}
-
 QString HaltechAdapter::adapterName() const {
     return QStringLiteral("Haltech CAN");
 }
 
 //=============================================================================
-// Private Slots
+// Private Methods
 //=============================================================================
 
-void HaltechAdapter::onFramesReceived() {
-    qDebug() << "HaltechAdapter: onFramesReceived() called, frames available:"
-             << m_canDevice->framesAvailable();
-    while (m_canDevice->framesAvailable() > 0) {
-        const QCanBusFrame receivedFrame = m_canDevice->readFrame();
-        qDebug() << "HaltechAdapter: Received frame ID:" << Qt::hex << receivedFrame.frameId()
-                 << "valid:" << receivedFrame.isValid();
-        if (receivedFrame.isValid()) {
-            processFrame(receivedFrame);
-        }
+void HaltechAdapter::loadPD16Devices(const QJsonObject& config) {
+    const QJsonArray devices = config[CONFIG_KEY_PD16_DEVICES].toArray();
+    if (devices.isEmpty()) {
+        return;
     }
-}
 
-void HaltechAdapter::onErrorOccurred(QCanBusDevice::CanBusError error) {
-    if (error != QCanBusDevice::NoError && m_canDevice) {
-        qWarning() << "HaltechAdapter: CAN bus error:" << m_canDevice->errorString();
-        emit errorOccurred(m_canDevice->errorString());
+    std::vector<PD16Protocol::DeviceId> deviceIds;
+    for (const auto& entry : devices) {
+        const auto id = PD16Protocol::deviceFromLetter(entry.toString());
+        if (!id) {
+            qWarning() << "HaltechAdapter: Unknown PD16 device" << entry.toString()
+                       << "- expected A, B, C or D";
+            continue;
+        }
+        deviceIds.push_back(*id);
     }
-}
-
-void HaltechAdapter::onStateChanged(QCanBusDevice::CanBusDeviceState state) {
-    bool connected = (state == QCanBusDevice::ConnectedState);
-    emit connectionStateChanged(connected);
-
-    if (connected) {
-        qDebug() << "HaltechAdapter: CAN device connected";
-    } else {
-        qDebug() << "HaltechAdapter: CAN device disconnected";
+    if (deviceIds.empty()) {
+        return;
     }
-}
+    m_pd16.setDevices(deviceIds);
 
-//=============================================================================
-// Private Methods
-//=============================================================================
-
-void HaltechAdapter::processFrame(const QCanBusFrame& frame) {
-    qDebug() << "HaltechAdapter: Processing frame ID:" << Qt::hex << frame.frameId();
-    auto decoded = m_protocol.decode(frame);
-
-    qDebug() << "HaltechAdapter: Decoded" << decoded.size() << "channels from frame" << Qt::hex
-             << frame.frameId();
-    for (const auto& [channelName, value] : decoded) {
-        qDebug() << "HaltechAdapter: Channel:" << channelName << "=" << value.value
-                 << value.unit << "(valid:" << value.valid << ")";
-        m_channels[channelName] = value;
-        emit channelUpdated(channelName, value);
+    const QString protocolFile = config[CONFIG_KEY_PD16_PROTOCOL_FILE].toString();
+    if (!protocolFile.isEmpty() && !m_pd16.loadDefinition(protocolFile)) {
+        qWarning() << "HaltechAdapter: Failed to load PD16 definition:" << protocolFile
+                   << "- using built-in decoders";
     }
+
+    const int aliases =
+        m_pd16.setChannelAliases(config[CONFIG_KEY_PD16_CHANNEL_MAPPING].toObject());
+    router().addDecoder(&m_pd16);
+    qDebug() << "HaltechAdapter: Decoding" << deviceIds.size() << "PD16 devices with" << aliases
+             << "named IOs";
 }
 
-} // namespace devdash
\ No newline at end of file
+} // namespace devdash
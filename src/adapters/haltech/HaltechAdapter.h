@@ -1,23 +1,35 @@
 #pragma once
 
 #include "HaltechProtocol.h"
-#include "core/interfaces/IProtocolAdapter.h"
+#include "PD16Protocol.h"
+#include "can/CanAdapter.h"
 
-#include <QCanBus>
-#include <QCanBusDevice>
 #include <QJsonObject>
 
-#include <memory>
-
 namespace devdash {
 
 /**
  * @brief Protocol adapter for Haltech ECUs over CAN bus
  *
- * Implements IProtocolAdapter to receive data from Haltech ECUs.
- * Single Responsibility: CAN bus communication with Haltech ECUs only.
+ * Implements IProtocolAdapter to receive data from Haltech ECUs and any
+ * PD16 power distribution modules on the same bus. Both protocols are
+ * registered with the FrameRouter, so each frame is dispatched with one
+ * table lookup. A single PD16Protocol decodes every configured PD16; its
+ * IOs can be named with "pd16ChannelMapping" (copied from the profile
+ * root by ProtocolAdapterFactory).
+ *
+ * @code
+ * "adapterConfig": {
+ *     "interface": "can0",
+ *     "protocolFile": "../protocols/haltech/haltech-can-protocol-v2.35.json",
+ *     "pd16ProtocolFile": "../protocols/haltech/haltech-pd16-can-protocol.json",
+ *     "pd16Devices": ["A", "B"]
+ * }
+ * @endcode
+ *
+ * Single Responsibility: Haltech protocol setup only, CAN I/O lives in CanAdapter.
  */
-class HaltechAdapter : public IProtocolAdapter {
+class HaltechAdapter : public CanAdapter {
     Q_OBJECT
 
   public:
@@ -31,26 +43,15 @@ class HaltechAdapter : public IProtocolAdapter {
     HaltechAdapter& operator=(HaltechAdapter&&) = delete;
 
     // IProtocolAdapter interface
-    [[nodiscard]] bool start() override;
-    void stop() override;
-    [[nodiscard]] bool isRunning() const override;
-    [[nodiscard]] std::optional<ChannelValue> getChannel(const QString& channelName) const override;
-    [[nodiscard]] QStringList availableChannels() const override;
     [[nodiscard]] QString adapterName() const override;
 
-  private slots:
-    void onFramesReceived();
-    void onErrorOccurred(QCanBusDevice::CanBusError error);
-    void onStateChanged(QCanBusDevice::CanBusDeviceState state);
+  private:
+    void loadPD16Devices(const QJsonObject& config);
 
-    void processFrame(const QCanBusFrame& frame);
-
-  private:  // NOLINT(readability-redundant-access-specifiers) - Required for MOC
-    QString m_interface;
-    std::unique_ptr<QCanBusDevice> m_canDevice;
     HaltechProtocol m_protocol;
-    QHash<QString, ChannelValue> m_channels;
-    bool m_running{false};
+
+    /// Decodes all configured PD16 devices (A-D) in one pass
+    PD16Protocol m_pd16;
 };
 
 } // namespace devdash
@@ -1,12 +1,14 @@
 #include "HaltechProtocol.h"
 
 #include <QDebug>
+#include <QElapsedTimer>
 #include <QFile>
 #include <QJsonArray>
 #include <QJsonDocument>
 #include <QJsonObject>
 
 #include <algorithm>
+#include <array>
 
 namespace devdash {
 
@@ -36,15 +38,9 @@ constexpr double SCALE_DIVIDE_BY_1000 = 1000.0;
 // Payload Layout Constants
 //=============================================================================
 
-/// Minimum payload size to contain any valid data
-constexpr int MIN_PAYLOAD_SIZE = 2;
-
 /// Size of a 16-bit value in bytes
 constexpr int UINT16_SIZE = 2;
 
-/// Size of an 8-bit value in bytes
-constexpr int UINT8_SIZE = 1;
-
 //=============================================================================
 // Output Unit Strings
 //=============================================================================
@@ -52,27 +48,112 @@ constexpr int UINT8_SIZE = 1;
 /// Celsius temperature unit string
 const QString UNIT_CELSIUS = QString::fromUtf8("°C");
 
+//=============================================================================
+// Binary Cache Records
+//=============================================================================
+
+/// Cache loader version: bump with any change to how parseDefinition()
+/// reads the JSON (units, conversions, scaling), so stale tables are rebuilt
+constexpr uint32_t CACHE_LOADER_VERSION = 1;
+
+/// Most payload bytes a cached channel can reference (classic CAN frame)
+constexpr size_t CACHED_MAX_CHANNEL_BYTES = 8;
+
+/// Largest byte index representable in a cached channel
+constexpr int CACHED_MAX_BYTE_INDEX = 255;
+
+/**
+ * @brief Counts at the start of a HaltechFrames cache body.
+ *
+ * Followed by frameCount CachedFrame and channelCount CachedChannel
+ * records, then the string table.
+ */
+struct CachedTables {
+    uint32_t frameCount = 0;
+    uint32_t channelCount = 0;
+    uint32_t stringCount = 0;
+    uint32_t stringUnits = 0; ///< UTF-16 code units of string data
+};
+
+struct CachedFrame {
+    uint32_t frameId = 0;
+    int32_t rateHz = 0;
+    uint32_t name = 0;         ///< String index
+    uint32_t firstChannel = 0; ///< Index of the first CachedChannel
+    uint32_t channelCount = 0;
+};
+
+struct CachedChannel {
+    uint32_t name = 0;  ///< String index
+    uint32_t units = 0; ///< String index
+    std::array<uint8_t, CACHED_MAX_CHANNEL_BYTES> byteIndices{};
+    uint8_t byteCount = 0;
+    uint8_t isSigned = 0;
+    uint8_t conversion = 0;
+    uint8_t reserved = 0;
+};
+
 } // anonymous namespace
 
 //=============================================================================
 // Construction
 //=============================================================================
 
-HaltechProtocol::HaltechProtocol() = default;
+HaltechProtocol::HaltechProtocol() : m_cacheDirectory(ProtocolCache::defaultDirectory()) {}
 
 //=============================================================================
 // Protocol Loading
 //=============================================================================
 
 bool HaltechProtocol::loadDefinition(const QString& path) {
+    QElapsedTimer loadTimer;
+    loadTimer.start();
+
     QFile file(path);
     if (!file.open(QIODevice::ReadOnly)) {
         qWarning() << "HaltechProtocol: Failed to open protocol definition:" << path;
         return false;
     }
+    const QByteArray source = file.readAll();
+
+    m_frameDefinitions.clear();
+    m_decoders.clear();
+    m_loadedFromCache = false;
+
+    const ProtocolCache cache(m_cacheDirectory);
+    const auto sourceHash = ProtocolCache::hashSource(source);
+    const QString cachePath =
+        cache.isEnabled() ? cache.pathFor(path, ProtocolCache::Schema::HaltechFrames) : QString();
+
+    const ProtocolCache::Mapping mapping(cachePath, ProtocolCache::Schema::HaltechFrames,
+                                         CACHE_LOADER_VERSION, sourceHash);
+    if (mapping.isValid() && loadCachedDefinitions(mapping.body())) {
+        m_loadedFromCache = true;
+    } else {
+        if (!parseDefinition(source)) {
+            return false;
+        }
+        if (cache.isEnabled()) {
+            const QByteArray body = serializeDefinitions();
+            if (!body.isEmpty()) {
+                cache.write(cachePath, ProtocolCache::Schema::HaltechFrames,
+                            CACHE_LOADER_VERSION, sourceHash, body);
+            }
+        }
+    }
 
+    // Build decoder lookup table from loaded definitions
+    buildDecoderTable();
+
+    qDebug() << "HaltechProtocol: Loaded" << m_frameDefinitions.size()
+             << "frame definitions from" << path << (m_loadedFromCache ? "(cached)" : "(JSON)")
+             << "in" << loadTimer.elapsed() << "ms";
+    return !m_frameDefinitions.isEmpty();
+}
+
+bool HaltechProtocol::parseDefinition(const QByteArray& source) {
     QJsonParseError parseError;
-    auto doc = QJsonDocument::fromJson(file.readAll(), &parseError);
+    auto doc = QJsonDocument::fromJson(source, &parseError);
     if (parseError.error != QJsonParseError::NoError) {
         qWarning() << "HaltechProtocol: Failed to parse protocol definition:"
                    << parseError.errorString();
@@ -82,9 +163,6 @@ bool HaltechProtocol::loadDefinition(const QString& path) {
     QJsonObject root = doc.object();
     QJsonObject frames = root["frames"].toObject();
 
-    m_frameDefinitions.clear();
-    m_decoders.clear();
-
     for (auto it = frames.begin(); it != frames.end(); ++it) {
         QString frameIdStr = it.key();
         QJsonObject frameObj = it.value().toObject();
@@ -131,13 +209,120 @@ bool HaltechProtocol::loadDefinition(const QString& path) {
 
         m_frameDefinitions[frameId] = std::move(frameDef);
     }
+    return true;
+}
 
-    // Build decoder lookup table from loaded definitions
-    buildDecoderTable();
+//=============================================================================
+// Binary Cache
+//=============================================================================
 
-    qDebug() << "HaltechProtocol: Loaded" << m_frameDefinitions.size()
-             << "frame definitions from" << path;
-    return !m_frameDefinitions.isEmpty();
+QByteArray HaltechProtocol::serializeDefinitions() const {
+    ProtocolCache::StringTable strings;
+    std::vector<CachedFrame> frames;
+    std::vector<CachedChannel> channels;
+
+    for (const auto& frameDef : m_frameDefinitions) {
+        CachedFrame frame;
+        frame.frameId = frameDef.frameId;
+        frame.rateHz = frameDef.rateHz;
+        frame.name = strings.intern(frameDef.name);
+        frame.firstChannel = static_cast<uint32_t>(channels.size());
+        frame.channelCount = static_cast<uint32_t>(frameDef.channels.size());
+
+        for (const auto& channelDef : frameDef.channels) {
+            if (channelDef.byteIndices.size() > CACHED_MAX_CHANNEL_BYTES) {
+                return {};
+            }
+            CachedChannel channel;
+            channel.name = strings.intern(channelDef.name);
+            channel.units = strings.intern(channelDef.units);
+            channel.byteCount = static_cast<uint8_t>(channelDef.byteIndices.size());
+            for (size_t i = 0; i < channelDef.byteIndices.size(); ++i) {
+                const int index = channelDef.byteIndices[i];
+                if (index < 0 || index > CACHED_MAX_BYTE_INDEX) {
+                    return {};
+                }
+                channel.byteIndices.at(i) = static_cast<uint8_t>(index);
+            }
+            channel.isSigned = channelDef.isSigned ? 1 : 0;
+            channel.conversion = static_cast<uint8_t>(channelDef.conversion);
+            channels.push_back(channel);
+        }
+        frames.push_back(frame);
+    }
+
+    CachedTables tables;
+    tables.frameCount = static_cast<uint32_t>(frames.size());
+    tables.channelCount = static_cast<uint32_t>(channels.size());
+    tables.stringCount = strings.count();
+    tables.stringUnits = strings.codeUnits();
+
+    ProtocolCache::Writer writer;
+    writer.append(tables);
+    writer.appendArray(frames);
+    writer.appendArray(channels);
+    writer.appendStrings(strings);
+    return writer.data();
+}
+
+bool HaltechProtocol::loadCachedDefinitions(QByteArrayView body) {
+    ProtocolCache::Reader reader(body);
+
+    CachedTables tables;
+    std::vector<CachedFrame> frames;
+    std::vector<CachedChannel> channels;
+    std::vector<QString> text;
+    if (!reader.read(tables) || !reader.readArray(frames, tables.frameCount) ||
+        !reader.readArray(channels, tables.channelCount) ||
+        !reader.readStrings(tables.stringCount, tables.stringUnits, text)) {
+        return false;
+    }
+
+    constexpr auto CONVERSION_COUNT = static_cast<uint8_t>(ConversionType::KelvinToCelsius) + 1;
+    for (const auto& frame : frames) {
+        if (frame.name >= text.size() ||
+            static_cast<uint64_t>(frame.firstChannel) + frame.channelCount > channels.size()) {
+            m_frameDefinitions.clear();
+            return false;
+        }
+
+        FrameDefinition frameDef;
+        frameDef.frameId = frame.frameId;
+        frameDef.name = text[frame.name];
+        frameDef.rateHz = frame.rateHz;
+        frameDef.channels.reserve(frame.channelCount);
+
+        for (uint32_t i = 0; i < frame.channelCount; ++i) {
+            const CachedChannel& channel = channels[frame.firstChannel + i];
+            if (channel.name >= text.size() || channel.units >= text.size() ||
+                channel.byteCount > CACHED_MAX_CHANNEL_BYTES ||
+                channel.conversion >= CONVERSION_COUNT) {
+                m_frameDefinitions.clear();
+                return false;
+            }
+
+            ChannelDefinition channelDef;
+            channelDef.name = text[channel.name];
+            channelDef.units = text[channel.units];
+            channelDef.isSigned = channel.isSigned != 0;
+            channelDef.conversion = static_cast<ConversionType>(channel.conversion);
+            channelDef.byteIndices.assign(channel.byteIndices.begin(),
+                                          channel.byteIndices.begin() + channel.byteCount);
+            frameDef.channels.push_back(std::move(channelDef));
+        }
+
+        m_frameDefinitions[frame.frameId] = std::move(frameDef);
+    }
+    return true;
+}
+
+void HaltechProtocol::loadDefinitions(const std::vector<FrameDefinition>& frames) {
+    m_frameDefinitions.clear();
+    m_loadedFromCache = false;
+    for (const auto& frameDef : frames) {
+        m_frameDefinitions[frameDef.frameId] = frameDef;
+    }
+    buildDecoderTable();
 }
 
 void HaltechProtocol::buildDecoderTable() {
@@ -162,32 +347,112 @@ QSet<QString> HaltechProtocol::availableChannels() const {
 }
 
 HaltechProtocol::FrameDecoder
-HaltechProtocol::createFrameDecoder(const FrameDefinition& frameDef) const {
-    // Capture frame definition by value to ensure it outlives the lambda
-    return [this, frameDef](const QByteArray& payload)
+HaltechProtocol::createFrameDecoder(const FrameDefinition& frameDef) {
+    std::vector<CompiledChannel> program;
+    program.reserve(frameDef.channels.size());
+    qsizetype fullLength = 0;
+
+    for (const auto& channelDef : frameDef.channels) {
+        auto compiled = compileChannel(channelDef);
+        if (!compiled.has_value()) {
+            qWarning() << "HaltechProtocol: Unsupported byte layout for channel"
+                       << channelDef.name << "in frame" << Qt::hex << frameDef.frameId;
+            continue;
+        }
+        fullLength = std::max<qsizetype>(fullLength, compiled->extractor.requiredLength());
+        program.push_back(std::move(compiled.value()));
+    }
+
+    return [program = std::move(program), fullLength](const QByteArray& payload)
                -> std::vector<std::pair<QString, ChannelValue>> {
         std::vector<std::pair<QString, ChannelValue>> results;
+        results.reserve(program.size());
 
-        for (const auto& channelDef : frameDef.channels) {
-            auto decoded = decodeChannel(channelDef, payload);
-            if (decoded.has_value()) {
-                // Use the channel name as-is from the protocol definition
-                // Profile mappings should match these exact names
-                results.emplace_back(channelDef.name, std::move(decoded.value()));
+        const auto* data = reinterpret_cast<const uint8_t*>(payload.constData());
+        const qsizetype length = payload.size();
+        const bool complete = length >= fullLength;
+
+        for (const auto& channel : program) {
+            if (!complete && channel.extractor.requiredLength() > length) {
+                continue;
             }
+            // Use the channel name as-is from the protocol definition
+            // Profile mappings should match these exact names
+            const double raw = channel.extractor.extract(data);
+            results.emplace_back(channel.name,
+                                 ChannelValue{applyConversion(channel.conversion, raw),
+                                              channel.unit, true});
         }
 
         return results;
     };
 }
 
+std::optional<HaltechProtocol::CompiledChannel>
+HaltechProtocol::compileChannel(const ChannelDefinition& channelDef) {
+    const auto& bytes = channelDef.byteIndices;
+    if (bytes.empty() || bytes.size() > static_cast<size_t>(SignalExtractor::MAX_BYTES)) {
+        return std::nullopt;
+    }
+    for (size_t i = 1; i < bytes.size(); ++i) {
+        if (bytes[i] != bytes[i - 1] + 1) {
+            return std::nullopt;
+        }
+    }
+
+    auto extractor = SignalExtractor::fromBytes(bytes.front(), static_cast<int>(bytes.size()),
+                                                channelDef.isSigned);
+    if (!extractor.has_value()) {
+        return std::nullopt;
+    }
+
+    CompiledChannel compiled;
+    compiled.extractor = extractor.value();
+    compiled.conversion = channelDef.conversion;
+    compiled.name = channelDef.name;
+    // Determine output unit (convert K to °C for display)
+    compiled.unit = channelDef.conversion == ConversionType::KelvinToCelsius ? UNIT_CELSIUS
+                                                                             : channelDef.units;
+    return compiled;
+}
+
+//=============================================================================
+// Frame Routing
+//=============================================================================
+
+std::vector<FrameKey> HaltechProtocol::claimedFrames() const {
+    std::vector<FrameKey> frames;
+    frames.reserve(static_cast<size_t>(m_frameDefinitions.size()));
+    for (auto it = m_frameDefinitions.cbegin(); it != m_frameDefinitions.cend(); ++it) {
+        frames.push_back(FrameKey{it.key(), false});
+    }
+    return frames;
+}
+
+double HaltechProtocol::declaredRateHz(const FrameKey& key) const {
+    auto it = m_frameDefinitions.constFind(key.frameId);
+    return it != m_frameDefinitions.constEnd() ? static_cast<double>(it.value().rateHz) : 0.0;
+}
+
+QStringList HaltechProtocol::frameChannels(const FrameKey& key) const {
+    QStringList channels;
+    auto it = m_frameDefinitions.constFind(key.frameId);
+    if (key.extended || it == m_frameDefinitions.constEnd()) {
+        return channels;
+    }
+    for (const auto& channelDef : it.value().channels) {
+        channels.append(channelDef.name);
+    }
+    return channels;
+}
+
 //=============================================================================
 // Frame Decoding
 //=============================================================================
 
 std::vector<std::pair<QString, ChannelValue>>
 HaltechProtocol::decode(const QCanBusFrame& frame) const {
-    if (!frame.isValid() || frame.payload().size() < MIN_PAYLOAD_SIZE) {
+    if (!frame.isValid()) {
         return {};
     }
 
@@ -201,58 +466,6 @@ HaltechProtocol::decode(const QCanBusFrame& frame) const {
     return {};
 }
 
-std::optional<ChannelValue> HaltechProtocol::decodeChannel(
-    const ChannelDefinition& channelDef,
-    const QByteArray& payload) const {
-
-    if (channelDef.byteIndices.empty()) {
-        return std::nullopt;
-    }
-
-    // Verify payload contains all required bytes
-    int maxByteIndex =
-        *std::max_element(channelDef.byteIndices.begin(), channelDef.byteIndices.end());
-    if (maxByteIndex >= payload.size()) {
-        return std::nullopt;
-    }
-
-    // Extract raw value based on byte count
-    double rawValue = 0.0;
-    const auto byteCount = channelDef.byteIndices.size();
-
-    if (byteCount == UINT16_SIZE) {
-        // 16-bit value (big-endian)
-        int offset = channelDef.byteIndices[0];
-        if (channelDef.isSigned) {
-            rawValue = static_cast<double>(decodeInt16(payload, offset));
-        } else {
-            rawValue = static_cast<double>(decodeUint16(payload, offset));
-        }
-    } else if (byteCount == UINT8_SIZE) {
-        // 8-bit value
-        int offset = channelDef.byteIndices[0];
-        if (channelDef.isSigned) {
-            rawValue = static_cast<double>(static_cast<int8_t>(payload[offset]));
-        } else {
-            rawValue = static_cast<double>(static_cast<uint8_t>(payload[offset]));
-        }
-    } else {
-        // Unsupported byte count
-        return std::nullopt;
-    }
-
-    // Apply conversion formula
-    double convertedValue = applyConversion(channelDef.conversion, rawValue);
-
-    // Determine output unit (convert K to °C for display)
-    QString outputUnit = channelDef.units;
-    if (channelDef.conversion == ConversionType::KelvinToCelsius) {
-        outputUnit = UNIT_CELSIUS;
-    }
-
-    return ChannelValue{convertedValue, outputUnit, true};
-}
-
 //=============================================================================
 // Conversion Utilities
 //=============================================================================
@@ -315,6 +528,33 @@ double HaltechProtocol::applyConversion(ConversionType type, double rawValue) {
     return rawValue;
 }
 
+double HaltechProtocol::invertConversion(ConversionType type, double value) {
+    // Same table layout as applyConversion(), one inverse per ConversionType
+    struct ConversionOp {
+        std::function<double(double)> invert;
+    };
+
+    static const std::array<ConversionOp, 5> operations = {{
+        // Identity
+        {[](double v) { return v; }},
+        // DivideBy10
+        {[](double v) { return v * SCALE_DIVIDE_BY_10; }},
+        // DivideBy1000
+        {[](double v) { return v * SCALE_DIVIDE_BY_1000; }},
+        // GaugePressure
+        {[](double v) { return (v + ATMOSPHERIC_PRESSURE_KPA) * SCALE_DIVIDE_BY_10; }},
+        // KelvinToCelsius
+        {[](double v) { return (v + KELVIN_TO_CELSIUS_OFFSET) * SCALE_DIVIDE_BY_10; }},
+    }};
+
+    auto index = static_cast<size_t>(type);
+    if (index < operations.size()) {
+        return operations[index].invert(value);
+    }
+
+    return value;
+}
+
 //=============================================================================
 // Low-Level Decoding
 //=============================================================================
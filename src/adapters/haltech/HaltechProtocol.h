@@ -1,6 +1,9 @@
 #pragma once
 
+#include "can/IFrameDecoder.h"
 #include "core/interfaces/IProtocolAdapter.h"
+#include "decode/ProtocolCache.h"
+#include "decode/SignalExtractor.h"
 
 #include <QCanBusFrame>
 #include <QHash>
@@ -34,7 +37,7 @@ enum class ConversionType {
  */
 struct ChannelDefinition {
     QString name;                 ///< Channel name (e.g., "RPM", "Coolant Temperature")
-    std::vector<int> byteIndices; ///< Byte positions in frame (e.g., [0,1] for bytes 0-1)
+    std::vector<int> byteIndices; ///< Consecutive byte positions (e.g., [0,1]), up to 8 bytes
     bool isSigned = false;        ///< Whether to interpret as signed integer
     QString units;                ///< Unit string (e.g., "RPM", "kPa", "K")
     ConversionType conversion = ConversionType::Identity; ///< Conversion to apply
@@ -58,7 +61,16 @@ struct FrameDefinition {
  *
  * Decodes CAN frames according to Haltech protocol specification.
  * Protocol definitions are loaded from JSON files, making this class
- * fully data-driven and extensible without code changes.
+ * fully data-driven and extensible without code changes. The parsed frame
+ * and channel definitions are cached in binary form (see ProtocolCache), so
+ * only the first launch after the JSON changes pays for JSON parsing.
+ *
+ * ## CAN FD
+ *
+ * Fields may sit anywhere in a 64-byte CAN FD payload and span 1-8 bytes.
+ * Each frame is compiled into a flat program of SignalExtractor steps that
+ * extracts every channel in one pass over the payload; per-channel length
+ * checks are only needed when a frame arrives shorter than its definition.
  *
  * ## Design Pattern
  *
@@ -85,7 +97,7 @@ struct FrameDefinition {
  * @note Single Responsibility: Protocol parsing only, no I/O operations.
  * @see HaltechAdapter for CAN bus I/O
  */
-class HaltechProtocol {
+class HaltechProtocol : public IFrameDecoder {
 public:
     /// Decoder function signature for frame handlers
     using FrameDecoder = std::function<std::vector<std::pair<QString, ChannelValue>>(
@@ -103,9 +115,35 @@ public:
      * @return true if loaded successfully, false on parse error or missing file
      *
      * @note Clears any previously loaded definitions
+     * @note Uses the binary cache when its source hash matches the file
      */
     [[nodiscard]] bool loadDefinition(const QString& path);
 
+    /**
+     * @brief Load frame definitions built in code instead of JSON.
+     *
+     * Used where no protocol file is at hand (e.g. the simulator's
+     * built-in frame set). Definitions are not cached.
+     *
+     * @param frames Frame definitions; a later frame with the same ID
+     *        replaces an earlier one
+     *
+     * @note Clears any previously loaded definitions
+     */
+    void loadDefinitions(const std::vector<FrameDefinition>& frames);
+
+    /**
+     * @brief Set the directory for compiled protocol caches.
+     * @param directory Cache directory; empty disables caching
+     *        (default: ProtocolCache::defaultDirectory())
+     */
+    void setCacheDirectory(const QString& directory) { m_cacheDirectory = directory; }
+
+    /**
+     * @brief Check whether the last loadDefinition() was served from the cache.
+     */
+    [[nodiscard]] bool loadedFromCache() const { return m_loadedFromCache; }
+
     /**
      * @brief Check if protocol definition is loaded.
      * @return true if a protocol definition has been successfully loaded
@@ -118,6 +156,30 @@ public:
      */
     [[nodiscard]] QList<uint32_t> frameIds() const { return m_frameDefinitions.keys(); }
 
+    /**
+     * @brief Get the loaded frame definitions, keyed by frame ID.
+     */
+    [[nodiscard]] const QHash<uint32_t, FrameDefinition>& frameDefinitions() const {
+        return m_frameDefinitions;
+    }
+
+    /**
+     * @brief Get the frames to route to this decoder.
+     * @return One standard-format key per loaded frame definition
+     */
+    [[nodiscard]] std::vector<FrameKey> claimedFrames() const override;
+
+    /**
+     * @brief Get the "rate_hz" declared for a frame in the protocol JSON.
+     * @return Declared rate, or 0 if the frame is unknown
+     */
+    [[nodiscard]] double declaredRateHz(const FrameKey& key) const override;
+
+    /**
+     * @brief Get the names of the channels defined for a frame.
+     */
+    [[nodiscard]] QStringList frameChannels(const FrameKey& key) const override;
+
     /**
      * @brief Get set of all available channel names in the protocol.
      *
@@ -150,7 +212,7 @@ public:
      * @note Returns empty vector for unknown frame IDs (not an error)
      */
     [[nodiscard]] std::vector<std::pair<QString, ChannelValue>>
-    decode(const QCanBusFrame& frame) const;
+    decode(const QCanBusFrame& frame) const override;
 
     /**
      * @brief Decode a uint16 value from payload at specified offset.
@@ -228,6 +290,18 @@ public:
      */
     [[nodiscard]] static double applyConversion(ConversionType type, double rawValue);
 
+    /**
+     * @brief Invert a conversion (engineering units back to raw).
+     *
+     * applyConversion(type, invertConversion(type, v)) == v. Used to encode
+     * frames; the result is not rounded to an integer.
+     *
+     * @param type The conversion type to invert
+     * @param value Value in engineering units (°C for KelvinToCelsius)
+     * @return Raw value as carried in the CAN payload
+     */
+    [[nodiscard]] static double invertConversion(ConversionType type, double value);
+
 private:
     /// Frame definitions loaded from JSON, keyed by frame ID
     QHash<uint32_t, FrameDefinition> m_frameDefinitions;
@@ -235,6 +309,31 @@ private:
     /// Decoder lookup table: frame ID → decoder function
     QHash<uint32_t, FrameDecoder> m_decoders;
 
+    /// Directory for compiled protocol caches (empty = disabled)
+    QString m_cacheDirectory;
+
+    /// Whether the current definitions came from the binary cache
+    bool m_loadedFromCache = false;
+
+    /**
+     * @brief Parse frame definitions from protocol JSON.
+     * @param source JSON file contents
+     * @return false on JSON parse error
+     */
+    [[nodiscard]] bool parseDefinition(const QByteArray& source);
+
+    /**
+     * @brief Serialize the loaded definitions into a cache body.
+     * @return Cache body, or empty if a definition cannot be represented
+     */
+    [[nodiscard]] QByteArray serializeDefinitions() const;
+
+    /**
+     * @brief Load definitions from a mapped cache body.
+     * @return false if the body is malformed (definitions are left empty)
+     */
+    [[nodiscard]] bool loadCachedDefinitions(QByteArrayView body);
+
     /**
      * @brief Build decoder lookup table from loaded frame definitions.
      *
@@ -244,24 +343,33 @@ private:
      */
     void buildDecoderTable();
 
+    /**
+     * @brief One compiled extraction step of a frame decode program.
+     */
+    struct CompiledChannel {
+        SignalExtractor extractor;     ///< Byte span and signedness
+        ConversionType conversion = ConversionType::Identity;
+        QString name;                  ///< Channel name as in the protocol JSON
+        QString unit;                  ///< Output unit (K is reported as °C)
+    };
+
     /**
      * @brief Create a decoder function for a specific frame definition.
      *
      * @param frameDef The frame definition to create a decoder for
-     * @return Lambda that decodes frames matching this definition
+     * @return Lambda running the frame's compiled channel program
      */
-    [[nodiscard]] FrameDecoder createFrameDecoder(const FrameDefinition& frameDef) const;
+    [[nodiscard]] static FrameDecoder createFrameDecoder(const FrameDefinition& frameDef);
 
     /**
-     * @brief Decode a single channel from payload.
+     * @brief Compile a channel definition into an extraction step.
      *
      * @param channelDef Channel definition with byte positions and conversion
-     * @param payload Raw CAN payload bytes
-     * @return Decoded channel value, or nullopt if payload too short
+     * @return Compiled step, or nullopt if the bytes are not a consecutive
+     *         run of 1-8 bytes
      */
-    [[nodiscard]] std::optional<ChannelValue> decodeChannel(
-        const ChannelDefinition& channelDef,
-        const QByteArray& payload) const;
+    [[nodiscard]] static std::optional<CompiledChannel>
+    compileChannel(const ChannelDefinition& channelDef);
 
     /**
      * @brief Convert channel name to camelCase.
@@ -0,0 +1,89 @@
+/**
+ * @file PD16Adapter.cpp
+ * @brief Implementation of the standalone PD16 CAN bus adapter.
+ */
+
+#include "PD16Adapter.h"
+
+#include <QDebug>
+#include <QJsonArray>
+
+#include <vector>
+
+namespace devdash {
+
+namespace {
+
+//=============================================================================
+// Configuration Keys
+//=============================================================================
+
+constexpr const char* CONFIG_KEY_PROTOCOL_FILE = "protocolFile";
+constexpr const char* CONFIG_KEY_DEVICES = "devices";
+constexpr const char* CONFIG_KEY_CHANNEL_MAPPING = "pd16ChannelMapping";
+
+/**
+ * @brief Parse "devices", defaulting to all four when absent.
+ */
+std::vector<PD16Protocol::DeviceId> devicesFromConfig(const QJsonObject& config) {
+    std::vector<PD16Protocol::DeviceId> devices;
+    if (!config.contains(CONFIG_KEY_DEVICES)) {
+        for (int device = 0; device < PD16Protocol::DEVICE_COUNT; ++device) {
+            devices.push_back(static_cast<PD16Protocol::DeviceId>(device));
+        }
+        return devices;
+    }
+
+    for (const auto& entry : config[CONFIG_KEY_DEVICES].toArray()) {
+        const auto id = PD16Protocol::deviceFromLetter(entry.toString());
+        if (!id) {
+            qWarning() << "PD16Adapter: Unknown device" << entry.toString()
+                       << "- expected A, B, C or D";
+            continue;
+        }
+        devices.push_back(*id);
+    }
+    return devices;
+}
+
+} // anonymous namespace
+
+//=============================================================================
+// Construction / Destruction
+//=============================================================================
+
+PD16Adapter::PD16Adapter(const QJsonObject& config, QObject* parent)
+    : CanAdapter(config, parent) {
+    const auto devices = devicesFromConfig(config);
+    if (devices.empty()) {
+        qWarning() << "PD16Adapter: No valid devices configured, decoding will not work";
+        return;
+    }
+    m_protocol.setDevices(devices);
+
+    const QString protocolFile = config[CONFIG_KEY_PROTOCOL_FILE].toString();
+    if (!protocolFile.isEmpty() && !m_protocol.loadDefinition(protocolFile)) {
+        qWarning() << "PD16Adapter: Failed to load definition:" << protocolFile
+                   << "- using built-in decoders";
+    }
+
+    const int aliases =
+        m_protocol.setChannelAliases(config[CONFIG_KEY_CHANNEL_MAPPING].toObject());
+    router().addDecoder(&m_protocol);
+    qDebug() << "PD16Adapter: Decoding" << devices.size() << "devices with" << aliases
+             << "named IOs";
+}
+
+PD16Adapter::~PD16Adapter() {
+    stop();
+}
+
+//=============================================================================
+// IProtocolAdapter Interface
+//=============================================================================
+
+QString PD16Adapter::adapterName() const {
+    return QStringLiteral("Haltech PD16 CAN");
+}
+
+} // namespace devdash
@@ -0,0 +1,50 @@
+#pragma once
+
+#include "PD16Protocol.h"
+#include "can/CanAdapter.h"
+
+#include <QJsonObject>
+
+namespace devdash {
+
+/**
+ * @brief Protocol adapter for Haltech PD16 modules without an ECU decoder
+ *
+ * For buses (or bus segments) that carry only PD16 traffic. One
+ * PD16Protocol decodes every configured device in a single pass, using the
+ * built-in layout unless "protocolFile" names the PD16 protocol JSON.
+ * "devices" defaults to all four (A-D).
+ *
+ * @code
+ * "adapter": "pd16",
+ * "adapterConfig": {
+ *     "interface": "can1",
+ *     "protocolFile": "../protocols/haltech/haltech-pd16-can-protocol.json",
+ *     "devices": ["A", "B"]
+ * },
+ * "pd16ChannelMapping": { "fan1": "PD16A_output_25a_0" }
+ * @endcode
+ *
+ * The ECU and PD16s on a shared bus are decoded by HaltechAdapter instead.
+ */
+class PD16Adapter : public CanAdapter {
+    Q_OBJECT
+
+  public:
+    explicit PD16Adapter(const QJsonObject& config, QObject* parent = nullptr);
+    ~PD16Adapter() override;
+
+    // QObject-based classes are not copyable or movable
+    PD16Adapter(const PD16Adapter&) = delete;
+    PD16Adapter& operator=(const PD16Adapter&) = delete;
+    PD16Adapter(PD16Adapter&&) = delete;
+    PD16Adapter& operator=(PD16Adapter&&) = delete;
+
+    // IProtocolAdapter interface
+    [[nodiscard]] QString adapterName() const override;
+
+  private:
+    PD16Protocol m_protocol;
+};
+
+} // namespace devdash
@@ -2,8 +2,15 @@
 
 #include <QDebug>
 #include <QFile>
+#include <QJsonArray>
 #include <QJsonDocument>
-#include <QJsonObject>
+#include <QRegularExpression>
+#include <QSet>
+
+#include <algorithm>
+#include <iterator>
+#include <limits>
+#include <optional>
 
 namespace devdash {
 
@@ -19,22 +26,6 @@ constexpr uint32_t BASE_CAN_ID = 0x6D0;
 /// Offset between device base IDs
 constexpr uint32_t DEVICE_ID_OFFSET = 8;
 
-/// Number of frame offsets per device
-constexpr int FRAMES_PER_DEVICE = 8;
-
-//=============================================================================
-// Frame Offset Constants
-//=============================================================================
-
-/// Frame offset for input status (TX from PD16)
-constexpr int FRAME_OFFSET_INPUT_STATUS = 3;
-
-/// Frame offset for output status (TX from PD16)
-constexpr int FRAME_OFFSET_OUTPUT_STATUS = 4;
-
-/// Frame offset for device status (TX from PD16)
-constexpr int FRAME_OFFSET_DEVICE_STATUS = 5;
-
 //=============================================================================
 // Multiplexer Byte Layout
 //=============================================================================
@@ -48,109 +39,247 @@ constexpr uint8_t MUX_TYPE_MASK = 0x07;
 /// Mask for IO index (bits 3-0)
 constexpr uint8_t MUX_INDEX_MASK = 0x0F;
 
-//=============================================================================
-// Payload Size Requirements
-//=============================================================================
-
-/// Minimum payload for input status frame
-constexpr int INPUT_STATUS_MIN_SIZE = 2;
-
-/// Payload size for speed pulse input (includes duty/freq)
-constexpr int SPEED_PULSE_FULL_SIZE = 8;
-
-/// Minimum payload for output status frame
-constexpr int OUTPUT_STATUS_MIN_SIZE = 2;
-
-/// Minimum payload for device status frame
-constexpr int DEVICE_STATUS_MIN_SIZE = 5;
+/// Every bit of the mux byte (plain "mux_id" variants)
+constexpr uint8_t MUX_FULL_MASK = 0xFF;
 
 //=============================================================================
-// Byte Offset Constants (for payload parsing)
+// Protocol Definition Keys
 //=============================================================================
 
-/// Firmware bugfix version byte offset
-constexpr int FW_BUGFIX_BYTE = 3;
+/// Frames transmitted by the PD16 (ECU → PD16 commands are not decoded)
+constexpr const char* TX_FRAMES_KEY = "pd16_to_ecu";
 
-/// Voltage high byte offset (2-byte uint16)
-constexpr int VOLTAGE_BYTE_OFFSET = 2;
+/// "2:7-3:0" (MSB byte:bit - LSB byte:bit) or a single bit "1:0"
+const QRegularExpression POSITION_PATTERN(QStringLiteral(R"(^(\d+):(\d+)(?:-(\d+):(\d+))?$)"));
 
-/// Minimum size for voltage field (bytes 0-3)
-constexpr int MIN_SIZE_FOR_VOLTAGE = 4;
+/// "y = x", "y = x / 1000", "y = x * 0.2"
+const QRegularExpression CONVERSION_PATTERN(
+    QStringLiteral(R"(^y ?= ?x(?: ?([*/]) ?(\d+(?:\.\d+)?))?$)"));
 
-/// Current/Load low byte offset (2-byte uint16 or 1-byte uint8)
-constexpr int CURRENT_LOW_BYTE_OFFSET = 4;
+/// Word separators when deriving a channel key from a field name
+const QRegularExpression KEY_SEPARATOR_PATTERN(QStringLiteral("[^A-Za-z0-9]+"));
 
-/// Minimum size for low current/load field (bytes 0-5)
-constexpr int MIN_SIZE_FOR_CURRENT_LOW = 6;
+/// "PD16A_output_25a_0" (pd16ChannelMapping IO reference)
+const QRegularExpression IO_REFERENCE_PATTERN(
+    QStringLiteral(R"(^PD16([A-D])_(output|input)_([0-9a-z]+)_(\d+)$)"),
+    QRegularExpression::CaseInsensitiveOption);
 
-/// Current high byte offset (1-byte uint8)
-constexpr int CURRENT_HIGH_BYTE_OFFSET = 6;
+//=============================================================================
+// IO Type Name Lookup Table
+//=============================================================================
 
-/// Minimum size for high current field (bytes 0-6)
-constexpr int MIN_SIZE_FOR_CURRENT_HIGH = 7;
+/// Static table mapping IOType enum to string names
+const std::array<QString, 5> IO_TYPE_NAMES = {
+    QStringLiteral("25A"),  // Output25A
+    QStringLiteral("8A"),   // Output8A
+    QStringLiteral("HBO"),  // HalfBridge
+    QStringLiteral("SPI"),  // SpeedPulse
+    QStringLiteral("AVI")   // AnalogVoltage
+};
 
-/// Status/Retry/Pin state byte offset
-constexpr int STATUS_RETRY_BYTE_OFFSET = 7;
+/// IO types before this index are outputs, the rest inputs
+constexpr size_t FIRST_INPUT_IO_TYPE = 3;
+
+/// Device letters, indexed by DeviceId
+constexpr std::array<char, PD16Protocol::DEVICE_COUNT> DEVICE_LETTERS = {'A', 'B', 'C', 'D'};
+
+//=============================================================================
+// Built-in Layout
+//=============================================================================
+
+/**
+ * @brief Input, output and device status frames, compiled until a protocol
+ *        definition is loaded. Same format as haltech-pd16-can-protocol.json.
+ */
+constexpr const char* BUILTIN_DEFINITION = R"({
+  "frames": { "pd16_to_ecu": {
+    "input_status": { "id_offset": 3, "rate_hz": 20, "variants": {
+      "SPI": { "mux_type": 3, "mux_indices": [0, 1, 2, 3], "channels": [
+        { "name": "Mux ID (IO Type)", "position": "0:7-0:5", "value": 3 },
+        { "name": "Mux ID (IO Index)", "position": "0:3-0:0" },
+        { "name": "State", "position": "1:0" },
+        { "name": "Voltage", "position": "2:7-3:0", "units": "V", "conversion": "y = x / 1000" },
+        { "name": "Duty Cycle", "position": "4:7-5:0", "units": "%", "conversion": "y = x / 10" },
+        { "name": "Frequency", "position": "6:7-7:0", "units": "Hz" } ] },
+      "AVI": { "mux_type": 4, "mux_indices": [0, 1, 2, 3], "channels": [
+        { "name": "Mux ID (IO Type)", "position": "0:7-0:5", "value": 4 },
+        { "name": "Mux ID (IO Index)", "position": "0:3-0:0" },
+        { "name": "State", "position": "1:0" },
+        { "name": "Voltage", "position": "2:7-3:0", "units": "V", "conversion": "y = x / 1000" } ] }
+    } },
+    "output_status": { "id_offset": 4, "rate_hz": 5, "variants": {
+      "25A": { "mux_type": 0, "mux_indices": [0, 1, 2, 3], "channels": [
+        { "name": "Mux ID (IO Type)", "position": "0:7-0:5", "value": 0 },
+        { "name": "Mux ID (IO Index)", "position": "0:3-0:0" },
+        { "name": "Load", "position": "1:7-1:0", "units": "%" },
+        { "name": "Voltage", "position": "2:7-3:0", "units": "V", "conversion": "y = x / 1000" },
+        { "name": "Low Side Current", "key": "currentLow", "position": "4:7-5:0", "units": "A",
+          "conversion": "y = x / 1000" },
+        { "name": "High Side Current", "key": "currentHigh", "position": "6:7-6:0", "units": "A",
+          "conversion": "y = x / 1000" },
+        { "name": "Retry Count", "key": "retries", "position": "7:7-7:4" },
+        { "name": "Pin State", "position": "7:3-7:0" } ] },
+      "8A": { "mux_type": 1, "mux_indices": [0, 1, 2, 3, 4, 5, 6, 7, 8, 9], "channels": [
+        { "name": "Mux ID (IO Type)", "position": "0:7-0:5", "value": 1 },
+        { "name": "Mux ID (IO Index)", "position": "0:3-0:0" },
+        { "name": "Retry Count", "key": "retries", "position": "1:7-1:3" },
+        { "name": "Pin State", "position": "1:2-1:0" },
+        { "name": "Voltage", "position": "2:7-3:0", "units": "V", "conversion": "y = x / 1000" },
+        { "name": "Current", "position": "4:7-5:0", "units": "A", "conversion": "y = x / 1000" },
+        { "name": "Load", "position": "6:7-6:0", "units": "%" } ] }
+    } },
+    "device_status": { "id_offset": 5, "rate_hz": 2,
+      "channels": [ { "name": "Status", "position": "0:7-0:4" } ],
+      "derived_channels": [ { "name": "Firmware Version", "sum_of": [
+        { "position": "1:1-1:0" },
+        { "position": "2:7-2:0", "conversion": "y = x / 100" },
+        { "position": "3:7-3:0", "conversion": "y = x / 10000" } ] } ] }
+  } }
+})";
+
+//=============================================================================
+// Definition Parsing Helpers
+//=============================================================================
+
+/**
+ * @brief Compile a field's "position", "signed" and "conversion".
+ * @return Extractor with the conversion folded into scale, or std::nullopt
+ */
+std::optional<SignalExtractor> parseField(const QJsonObject& field) {
+    const QString position = field["position"].toString();
+    const auto positionMatch = POSITION_PATTERN.match(position);
+    if (!positionMatch.hasMatch()) {
+        qWarning() << "PD16Protocol: Invalid position" << position << "for field"
+                   << field["name"].toString();
+        return std::nullopt;
+    }
 
-/// Minimum size for status/retry field (bytes 0-7)
-constexpr int MIN_SIZE_FOR_STATUS_RETRY = 8;
+    const int msbByte = positionMatch.captured(1).toInt();
+    const int msbBit = positionMatch.captured(2).toInt();
+    const bool isRange = !positionMatch.captured(3).isEmpty();
+    const int lsbByte = isRange ? positionMatch.captured(3).toInt() : msbByte;
+    const int lsbBit = isRange ? positionMatch.captured(4).toInt() : msbBit;
+
+    auto extractor = SignalExtractor::fromPositions(msbByte, msbBit, lsbByte, lsbBit,
+                                                    field["signed"].toBool(false));
+    if (!extractor) {
+        qWarning() << "PD16Protocol: Unsupported position" << position << "for field"
+                   << field["name"].toString();
+        return std::nullopt;
+    }
 
-//=============================================================================
-// Scaling Factors
-//=============================================================================
+    const QString conversion = field["conversion"].toString(QStringLiteral("y = x")).simplified();
+    const auto conversionMatch = CONVERSION_PATTERN.match(conversion);
+    if (!conversionMatch.hasMatch()) {
+        qWarning() << "PD16Protocol: Unsupported conversion" << conversion << "for field"
+                   << field["name"].toString();
+        return std::nullopt;
+    }
+    if (!conversionMatch.captured(1).isEmpty()) {
+        const double factor = conversionMatch.captured(2).toDouble();
+        if (conversionMatch.captured(1) == QLatin1String("/")) {
+            if (factor == 0.0) {
+                qWarning() << "PD16Protocol: Division by zero in conversion for field"
+                           << field["name"].toString();
+                return std::nullopt;
+            }
+            extractor->scale = 1.0 / factor;
+        } else {
+            extractor->scale = factor;
+        }
+    }
+    return extractor;
+}
 
-/// Millivolts to volts conversion
-constexpr double MV_TO_V = 1000.0;
+/**
+ * @brief Channel key of a field: "key" if given, else the camelCase name.
+ *
+ * "Duty Cycle" → dutyCycle, "FW Major Version" → fwMajorVersion.
+ */
+QString channelKey(const QJsonObject& field) {
+    const QString explicitKey = field["key"].toString();
+    if (!explicitKey.isEmpty()) {
+        return explicitKey;
+    }
 
-/// Milliamps to amps conversion
-constexpr double MA_TO_A = 1000.0;
+    QString key;
+    const QStringList words =
+        field["name"].toString().split(KEY_SEPARATOR_PATTERN, Qt::SkipEmptyParts);
+    for (const QString& word : words) {
+        if (key.isEmpty()) {
+            key += word.toLower();
+        } else {
+            key += word.at(0).toUpper();
+            key += word.mid(1);
+        }
+    }
+    return key;
+}
 
-/// Duty cycle resolution (0.1%)
-constexpr double DUTY_CYCLE_SCALE = 10.0;
+/**
+ * @brief Check whether a field lies entirely in the mux byte.
+ */
+bool isSelectorField(const SignalExtractor& extractor) {
+    return extractor.firstByte == 0 && extractor.byteCount == 1;
+}
 
-/// Firmware version scale factors
-constexpr double FW_MINOR_SCALE = 100.0;
-constexpr double FW_BUGFIX_SCALE = 10000.0;
+/**
+ * @brief Bits of the mux byte covered by a selector field.
+ */
+uint8_t selectorMask(const SignalExtractor& extractor) {
+    return static_cast<uint8_t>(extractor.mask << extractor.shift);
+}
 
 //=============================================================================
-// Bit Masks for Status Bytes
+// Binary Cache Records
 //=============================================================================
 
-/// State bit in status byte
-constexpr uint8_t STATE_BIT_MASK = 0x01;
-
-/// Firmware major version mask (bits 1-0 of byte 1)
-constexpr uint8_t FW_MAJOR_MASK = 0x03;
+/// Cache loader version: bump whenever compileDefinition() would turn the
+/// same JSON into different programs or channel names
+constexpr uint32_t CACHE_LOADER_VERSION = 1;
 
-/// Status nibble mask (bits 3-0)
-constexpr uint8_t STATUS_NIBBLE_MASK = 0x0F;
-
-/// Bit shift for status nibble (bits 7-4)
-constexpr int STATUS_NIBBLE_SHIFT = 4;
+/**
+ * @brief Counts at the start of a PD16Tables cache body.
+ *
+ * Followed by FRAMES_PER_DEVICE CachedLayout, programCount CachedProgram
+ * and opCount CachedOp records, then the string table.
+ */
+struct CachedTables {
+    uint32_t programCount = 0;
+    uint32_t opCount = 0;
+    uint32_t stringCount = 0;
+    uint32_t stringUnits = 0; ///< UTF-16 code units of string data
+};
 
-/// 25A retry count mask (bits 7-4 of byte 7)
-constexpr int RETRY_COUNT_25A_SHIFT = 4;
-constexpr uint8_t RETRY_COUNT_25A_MASK = 0x0F;
+struct CachedLayout {
+    int32_t rateHz = 0;
+    int16_t program = -1;
+    uint8_t muxMask = 0;
+    uint8_t reserved = 0;
+    std::array<int16_t, PD16Protocol::MUX_VALUES> programByMux{};
+};
 
-/// 8A retry count mask (bits 7-3 of byte 1)
-constexpr int RETRY_COUNT_8A_SHIFT = 3;
-constexpr uint8_t RETRY_COUNT_8A_MASK = 0x1F;
+struct CachedProgram {
+    uint32_t firstOp = 0; ///< Index of the first CachedOp
+    uint32_t opCount = 0;
+    int32_t channelCount = 0;
+    uint32_t ioName = 0; ///< String index
+};
 
-/// 8A pin state mask (bits 2-0)
-constexpr uint8_t PIN_STATE_8A_MASK = 0x07;
+struct CachedOp {
+    SignalExtractor extractor;
+    int32_t requiredLength = 0;
+    uint32_t key = 0;    ///< String index
+    uint32_t unit = 0;   ///< String index
+    uint8_t kind = 0;
+    std::array<uint8_t, 3> reserved{};
+};
 
-//=============================================================================
-// IO Type Name Lookup Table
-//=============================================================================
+/// One CachedLayout per frame offset
+constexpr auto CACHED_LAYOUT_COUNT = static_cast<uint32_t>(PD16Protocol::FRAMES_PER_DEVICE);
 
-/// Static table mapping IOType enum to string names
-const std::array<QString, 5> IO_TYPE_NAMES = {
-    QStringLiteral("25A"),  // Output25A
-    QStringLiteral("8A"),   // Output8A
-    QStringLiteral("HBO"),  // HalfBridge
-    QStringLiteral("SPI"),  // SpeedPulse
-    QStringLiteral("AVI")   // AnalogVoltage
-};
+/// Largest byte count a cached extractor may load
+constexpr uint8_t CACHED_MAX_EXTRACTOR_BYTES = 8;
 
 } // anonymous namespace
 
@@ -158,35 +287,20 @@ const std::array<QString, 5> IO_TYPE_NAMES = {
 // Construction & Initialization
 //=============================================================================
 
-PD16Protocol::PD16Protocol() {
+PD16Protocol::PD16Protocol() : m_cacheDirectory(ProtocolCache::defaultDirectory()) {
+    compileBuiltinDefinition();
     setDeviceId(DeviceId::A);
-    initializeFallbackDecoders();
 }
 
-void PD16Protocol::initializeFallbackDecoders() {
-    // Frame offset → decoder function mapping (fallback when no JSON loaded)
-    m_frameDecoders[FRAME_OFFSET_INPUT_STATUS] =
-        [this](const QByteArray& payload, const QString& prefix) {
-            return decodeInputStatus(payload, prefix);
-        };
-
-    m_frameDecoders[FRAME_OFFSET_OUTPUT_STATUS] =
-        [this](const QByteArray& payload, const QString& prefix) {
-            return decodeOutputStatus(payload, prefix);
-        };
-
-    m_frameDecoders[FRAME_OFFSET_DEVICE_STATUS] =
-        [this](const QByteArray& payload, const QString& prefix) {
-            return decodeDeviceStatus(payload, prefix);
-        };
-
-    // IO type → output status handler mapping
-    m_outputStatusHandlers[IOType::Output25A] = &PD16Protocol::decodeOutput25AStatus;
-    m_outputStatusHandlers[IOType::Output8A] = &PD16Protocol::decodeOutput8AStatus;
-
-    // IO type → input status handler mapping
-    m_inputStatusHandlers[IOType::SpeedPulse] = &PD16Protocol::decodeSpeedPulseStatus;
-    m_inputStatusHandlers[IOType::AnalogVoltage] = &PD16Protocol::decodeAnalogVoltageStatus;
+void PD16Protocol::compileBuiltinDefinition() {
+    const auto doc = QJsonDocument::fromJson(QByteArray(BUILTIN_DEFINITION));
+    if (!compileDefinition(doc.object())) {
+        qCritical() << "PD16Protocol: Built-in layout failed to compile";
+    }
+}
+
+bool PD16Protocol::FrameLayout::isEmpty() const {
+    return program == NO_PROGRAM && muxMask == 0;
 }
 
 //=============================================================================
@@ -194,334 +308,591 @@ void PD16Protocol::initializeFallbackDecoders() {
 //=============================================================================
 
 void PD16Protocol::setDeviceId(DeviceId id) {
-    m_deviceId = id;
-    m_baseId = BASE_CAN_ID + (static_cast<uint32_t>(id) * DEVICE_ID_OFFSET);
-    m_devicePrefix = QString("pd16_%1").arg(static_cast<char>('A' + static_cast<int>(id)));
+    setDevices({id});
 }
 
-bool PD16Protocol::loadDefinition(const QString& path) {
-    QFile file(path);
-    if (!file.open(QIODevice::ReadOnly)) {
-        qWarning() << "PD16Protocol: Failed to open protocol definition:" << path;
-        return false;
+void PD16Protocol::setDevices(const std::vector<DeviceId>& devices) {
+    if (devices.empty()) {
+        return;
     }
 
-    QJsonParseError parseError;
-    auto doc = QJsonDocument::fromJson(file.readAll(), &parseError);
-    if (parseError.error != QJsonParseError::NoError) {
-        qWarning() << "PD16Protocol: Failed to parse protocol definition:"
-                   << parseError.errorString();
-        return false;
+    m_deviceEnabled.fill(false);
+    for (DeviceId id : devices) {
+        m_deviceEnabled.at(static_cast<size_t>(id)) = true;
     }
 
-    // Parse and build decoder tables from JSON
-    buildDecoderTablesFromJson();
-
-    m_loaded = true;
-    qDebug() << "PD16Protocol: Loaded protocol definition from" << path;
-    return true;
+    const DeviceId primary = devices.front();
+    m_deviceId = primary;
+    m_baseId = BASE_CAN_ID + (static_cast<uint32_t>(primary) * DEVICE_ID_OFFSET);
+    m_devicePrefix =
+        QString("pd16_%1").arg(DEVICE_LETTERS.at(static_cast<size_t>(primary)));
 }
 
-void PD16Protocol::buildDecoderTablesFromJson() {
-    // Clear existing tables
-    m_frameDecoders.clear();
-    m_outputStatusHandlers.clear();
-    m_inputStatusHandlers.clear();
-
-    // TODO: Parse JSON and build tables dynamically
-    // For now, rebuild the same handlers but from a "loaded" state
-    // This structure supports future JSON-driven configuration
-
-    // Frame decoders - these would be built from JSON "frames" section
-    m_frameDecoders[FRAME_OFFSET_INPUT_STATUS] =
-        [this](const QByteArray& payload, const QString& prefix) {
-            return decodeInputStatus(payload, prefix);
-        };
-
-    m_frameDecoders[FRAME_OFFSET_OUTPUT_STATUS] =
-        [this](const QByteArray& payload, const QString& prefix) {
-            return decodeOutputStatus(payload, prefix);
-        };
-
-    m_frameDecoders[FRAME_OFFSET_DEVICE_STATUS] =
-        [this](const QByteArray& payload, const QString& prefix) {
-            return decodeDeviceStatus(payload, prefix);
-        };
-
-    // IO type handlers - these would be built from JSON "io_types" section
-    m_outputStatusHandlers[IOType::Output25A] = &PD16Protocol::decodeOutput25AStatus;
-    m_outputStatusHandlers[IOType::Output8A] = &PD16Protocol::decodeOutput8AStatus;
-    m_inputStatusHandlers[IOType::SpeedPulse] = &PD16Protocol::decodeSpeedPulseStatus;
-    m_inputStatusHandlers[IOType::AnalogVoltage] = &PD16Protocol::decodeAnalogVoltageStatus;
+std::vector<PD16Protocol::DeviceId> PD16Protocol::devices() const {
+    std::vector<DeviceId> enabled;
+    for (size_t device = 0; device < m_deviceEnabled.size(); ++device) {
+        if (m_deviceEnabled[device]) {
+            enabled.push_back(static_cast<DeviceId>(device));
+        }
+    }
+    return enabled;
 }
 
-//=============================================================================
-// Frame Identification
-//=============================================================================
-
-bool PD16Protocol::isDeviceFrame(uint32_t frameId) const {
-    return frameId >= m_baseId && frameId < m_baseId + FRAMES_PER_DEVICE;
+std::optional<PD16Protocol::DeviceId> PD16Protocol::deviceFromLetter(const QString& letter) {
+    if (letter.size() != 1) {
+        return std::nullopt;
+    }
+    const char upper = letter.at(0).toUpper().toLatin1();
+    const auto it = std::find(DEVICE_LETTERS.begin(), DEVICE_LETTERS.end(), upper);
+    if (it == DEVICE_LETTERS.end()) {
+        return std::nullopt;
+    }
+    return static_cast<DeviceId>(std::distance(DEVICE_LETTERS.begin(), it));
 }
 
-int PD16Protocol::getFrameOffset(uint32_t frameId) const {
-    if (!isDeviceFrame(frameId)) {
-        return -1;
+void PD16Protocol::assignChannelNames() {
+    for (auto& program : m_programs) {
+        for (size_t device = 0; device < DEVICE_COUNT; ++device) {
+            // Aliased IOs replace the whole device/IO prefix
+            QString prefix = m_aliases.at(device).value(program.ioName);
+            if (prefix.isEmpty()) {
+                prefix = QStringLiteral("pd16_%1").arg(DEVICE_LETTERS.at(device));
+                if (!program.ioName.isEmpty()) {
+                    prefix += QLatin1Char('_') + program.ioName;
+                }
+            }
+            prefix += QLatin1Char('_');
+
+            for (auto& op : program.ops) {
+                if (op.kind != OpKind::Accumulate) {
+                    op.names.at(device) = prefix + op.key;
+                }
+            }
+        }
     }
-    return static_cast<int>(frameId - m_baseId);
 }
 
 //=============================================================================
-// Main Decode Entry Point
+// Channel Aliases
 //=============================================================================
 
-std::vector<std::pair<QString, ChannelValue>>
-PD16Protocol::decode(const QCanBusFrame& frame) const {
-    if (!frame.isValid() || frame.payload().isEmpty()) {
-        return {};
+int PD16Protocol::setChannelAliases(const QJsonObject& mapping) {
+    QSet<QString> ioNames;
+    for (const auto& program : m_programs) {
+        if (!program.ioName.isEmpty()) {
+            ioNames.insert(program.ioName);
+        }
     }
 
-    // Check if frame belongs to this device
-    if (!isDeviceFrame(frame.frameId())) {
-        return {};
+    std::array<QHash<QString, QString>, DEVICE_COUNT> aliases;
+    int applied = 0;
+    for (auto it = mapping.begin(); it != mapping.end(); ++it) {
+        const QString reference = it.value().toString();
+        const auto match = IO_REFERENCE_PATTERN.match(reference);
+
+        const auto typeIt = std::find_if(
+            IO_TYPE_NAMES.begin(), IO_TYPE_NAMES.end(), [&match](const QString& name) {
+                return name.compare(match.captured(3), Qt::CaseInsensitive) == 0;
+            });
+        const auto typeIndex = static_cast<size_t>(std::distance(IO_TYPE_NAMES.begin(), typeIt));
+        const bool isInput = match.captured(2).compare(QLatin1String("input"),
+                                                       Qt::CaseInsensitive) == 0;
+        const QString ioName =
+            typeIt != IO_TYPE_NAMES.end()
+                ? QStringLiteral("%1_%2").arg(*typeIt).arg(match.captured(4).toInt())
+                : QString();
+
+        if (!match.hasMatch() || typeIt == IO_TYPE_NAMES.end() ||
+            isInput != (typeIndex >= FIRST_INPUT_IO_TYPE) || !ioNames.contains(ioName)) {
+            qWarning() << "PD16Protocol: Ignoring channel mapping" << it.key() << "->"
+                       << reference << "(no such IO)";
+            continue;
+        }
+
+        const auto device = deviceFromLetter(match.captured(1));
+        aliases.at(static_cast<size_t>(*device)).insert(ioName, it.key());
+        ++applied;
     }
 
-    int offset = getFrameOffset(frame.frameId());
-
-    // Lookup decoder for this frame offset
-    auto it = m_frameDecoders.find(offset);
-    if (it != m_frameDecoders.end()) {
-        return it.value()(frame.payload(), m_devicePrefix);
-    }
-
-    // Unhandled frame offset - return empty (not an error)
-    return {};
-}
-
-//=============================================================================
-// Channel Name Building
-//=============================================================================
-
-QString PD16Protocol::buildChannelPrefix(IOType ioType, uint8_t ioIndex) const {
-    return QString("%1_%2_%3")
-        .arg(m_devicePrefix)
-        .arg(getIOTypeName(ioType))
-        .arg(ioIndex);
+    m_aliases = std::move(aliases);
+    assignChannelNames();
+    return applied;
 }
 
 //=============================================================================
-// Frame Decoders
+// Protocol Loading
 //=============================================================================
 
-std::vector<std::pair<QString, ChannelValue>>
-PD16Protocol::decodeInputStatus(const QByteArray& payload,
-                                 const QString& /*devicePrefix*/) const {
-    if (payload.size() < INPUT_STATUS_MIN_SIZE) {
-        return {};
+bool PD16Protocol::loadDefinition(const QString& path) {
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        qWarning() << "PD16Protocol: Failed to open protocol definition:" << path;
+        return false;
     }
 
-    uint8_t muxByte = static_cast<uint8_t>(payload[0]);
-    IOType ioType = getMuxType(muxByte);
-    uint8_t ioIndex = getMuxIndex(muxByte);
-
-    QString channelPrefix = buildChannelPrefix(ioType, ioIndex);
-
-    // Lookup handler for this IO type
-    auto it = m_inputStatusHandlers.find(ioType);
-    if (it != m_inputStatusHandlers.end()) {
-        return it.value()(payload, channelPrefix);
+    const QByteArray source = file.readAll();
+    m_loadedFromCache = false;
+
+    const ProtocolCache cache(m_cacheDirectory);
+    const auto sourceHash = ProtocolCache::hashSource(source);
+    const QString cachePath =
+        cache.isEnabled() ? cache.pathFor(path, ProtocolCache::Schema::PD16Tables) : QString();
+    const ProtocolCache::Mapping mapping(cachePath, ProtocolCache::Schema::PD16Tables,
+                                         CACHE_LOADER_VERSION, sourceHash);
+
+    if (mapping.isValid() && loadCachedPrograms(mapping.body())) {
+        m_loadedFromCache = true;
+    } else {
+        QJsonParseError parseError;
+        auto doc = QJsonDocument::fromJson(source, &parseError);
+        if (parseError.error != QJsonParseError::NoError) {
+            qWarning() << "PD16Protocol: Failed to parse protocol definition:"
+                       << parseError.errorString();
+            return false;
+        }
+        if (!compileDefinition(doc.object())) {
+            qWarning() << "PD16Protocol: No decodable frames in" << path;
+            return false;
+        }
+        if (cache.isEnabled()) {
+            cache.write(cachePath, ProtocolCache::Schema::PD16Tables, CACHE_LOADER_VERSION,
+                        sourceHash, serializePrograms());
+        }
     }
 
-    return {};
+    m_loaded = true;
+    qDebug() << "PD16Protocol: Loaded" << m_programs.size() << "decode programs from" << path
+             << (m_loadedFromCache ? "(cached)" : "(JSON)");
+    return true;
 }
 
-std::vector<std::pair<QString, ChannelValue>>
-PD16Protocol::decodeOutputStatus(const QByteArray& payload,
-                                  const QString& /*devicePrefix*/) const {
-    if (payload.size() < OUTPUT_STATUS_MIN_SIZE) {
-        return {};
+//=============================================================================
+// Definition Compilation
+//=============================================================================
+
+bool PD16Protocol::compileDefinition(const QJsonObject& root) {
+    const QJsonObject frames = root["frames"].toObject().value(TX_FRAMES_KEY).toObject();
+
+    std::array<FrameLayout, FRAMES_PER_DEVICE> layouts{};
+    std::vector<DecodeProgram> programs;
+
+    const auto addProgram = [&programs](DecodeProgram program) -> int16_t {
+        programs.push_back(std::move(program));
+        return static_cast<int16_t>(programs.size() - 1);
+    };
+
+    for (auto frameIt = frames.begin(); frameIt != frames.end(); ++frameIt) {
+        const QJsonObject frameObj = frameIt.value().toObject();
+        const int offset = frameObj["id_offset"].toInt(-1);
+        if (offset < 0 || offset >= FRAMES_PER_DEVICE) {
+            qWarning() << "PD16Protocol: Frame" << frameIt.key() << "has invalid id_offset";
+            return false;
+        }
+
+        FrameLayout& layout = layouts.at(static_cast<size_t>(offset));
+        layout.rateHz = frameObj["rate_hz"].toInt();
+
+        if (!frameObj.contains("variants")) {
+            DecodeProgram program;
+            if (!compileProgram(frameObj, false, program)) {
+                return false;
+            }
+            layout.program = addProgram(std::move(program));
+            continue;
+        }
+
+        const QJsonObject variants = frameObj["variants"].toObject();
+        for (auto variantIt = variants.begin(); variantIt != variants.end(); ++variantIt) {
+            const QJsonObject variant = variantIt.value().toObject();
+
+            DecodeProgram base;
+            if (!compileProgram(variant, true, base)) {
+                return false;
+            }
+
+            // The byte-0 fields select the variant: fixed "value" bits (IO
+            // type or mux ID) plus at most one index field
+            uint8_t muxMask = 0;
+            uint8_t fixedBits = 0;
+            std::optional<SignalExtractor> indexField;
+            for (const auto& channelVal : variant["channels"].toArray()) {
+                const QJsonObject field = channelVal.toObject();
+                const auto extractor = parseField(field);
+                if (!extractor || !isSelectorField(*extractor)) {
+                    continue;
+                }
+                muxMask = static_cast<uint8_t>(muxMask | selectorMask(*extractor));
+                if (field.contains("value")) {
+                    const uint64_t value = static_cast<uint64_t>(field["value"].toInt());
+                    fixedBits = static_cast<uint8_t>(
+                        fixedBits | ((value & extractor->mask) << extractor->shift));
+                } else {
+                    indexField = extractor;
+                }
+            }
+            if (muxMask == 0 && variant.contains("mux_id")) {
+                muxMask = MUX_FULL_MASK;
+                fixedBits = static_cast<uint8_t>(variant["mux_id"].toInt());
+            }
+            if (muxMask == 0 || (layout.muxMask != 0 && layout.muxMask != muxMask)) {
+                qWarning() << "PD16Protocol: Variant" << variantIt.key() << "of frame"
+                           << frameIt.key() << "has no consistent mux selector";
+                return false;
+            }
+            layout.muxMask = muxMask;
+
+            // Channel names of IO variants carry the IO type and index
+            const int muxType = variant["mux_type"].toInt(-1);
+            const bool isIoVariant = muxType >= 0 && indexField.has_value();
+            const QString ioName = isIoVariant && muxType < static_cast<int>(IO_TYPE_NAMES.size())
+                                       ? IO_TYPE_NAMES.at(static_cast<size_t>(muxType))
+                                       : variantIt.key();
+
+            QJsonArray indices = variant["mux_indices"].toArray();
+            if (!indexField) {
+                indices = QJsonArray{0};
+            }
+            for (const auto& indexVal : indices) {
+                const int index = indexVal.toInt();
+                uint8_t muxValue = fixedBits;
+                if (indexField) {
+                    const uint64_t indexBits = static_cast<uint64_t>(index) & indexField->mask;
+                    muxValue = static_cast<uint8_t>(muxValue | (indexBits << indexField->shift));
+                }
+
+                DecodeProgram program = base;
+                if (isIoVariant) {
+                    program.ioName = QStringLiteral("%1_%2").arg(ioName).arg(index);
+                }
+                if (programs.size() >= static_cast<size_t>(std::numeric_limits<int16_t>::max())) {
+                    qWarning() << "PD16Protocol: Too many decode programs";
+                    return false;
+                }
+                layout.programByMux.at(static_cast<size_t>(muxValue & muxMask)) =
+                    addProgram(std::move(program));
+            }
+        }
     }
 
-    uint8_t muxByte = static_cast<uint8_t>(payload[0]);
-    IOType ioType = getMuxType(muxByte);
-    uint8_t ioIndex = getMuxIndex(muxByte);
-
-    QString channelPrefix = buildChannelPrefix(ioType, ioIndex);
-
-    // Lookup handler for this IO type
-    auto it = m_outputStatusHandlers.find(ioType);
-    if (it != m_outputStatusHandlers.end()) {
-        return it.value()(payload, channelPrefix);
+    if (programs.empty()) {
+        return false;
     }
 
-    return {};
+    m_layouts = layouts;
+    m_programs = std::move(programs);
+    assignChannelNames();
+    return true;
 }
 
-std::vector<std::pair<QString, ChannelValue>>
-PD16Protocol::decodeDeviceStatus(const QByteArray& payload,
-                                  const QString& devicePrefix) const {
-    if (payload.size() < DEVICE_STATUS_MIN_SIZE) {
-        return {};
+bool PD16Protocol::compileProgram(const QJsonObject& owner, bool multiplexed,
+                                  DecodeProgram& program) {
+    for (const auto& channelVal : owner["channels"].toArray()) {
+        const QJsonObject field = channelVal.toObject();
+        const auto extractor = parseField(field);
+        if (!extractor) {
+            return false;
+        }
+        if (multiplexed && isSelectorField(*extractor)) {
+            continue;
+        }
+
+        DecodeOp op;
+        op.extractor = *extractor;
+        op.requiredLength = extractor->requiredLength();
+        op.key = channelKey(field);
+        op.unit = field["units"].toString();
+        program.ops.push_back(std::move(op));
+        ++program.channelCount;
     }
 
-    std::vector<std::pair<QString, ChannelValue>> results;
-
-    // Byte 0 bits 7-4: Status
-    uint8_t status = (static_cast<uint8_t>(payload[0]) >> STATUS_NIBBLE_SHIFT) & STATUS_NIBBLE_MASK;
-    results.emplace_back(
-        devicePrefix + "_status",
-        ChannelValue{static_cast<double>(status), "", true});
-
-    // Firmware version from bytes 1-3
-    uint8_t fwMajor = static_cast<uint8_t>(payload[1]) & FW_MAJOR_MASK;
-    uint8_t fwMinor = static_cast<uint8_t>(payload[2]);
-    uint8_t fwBugfix = static_cast<uint8_t>(payload[FW_BUGFIX_BYTE]);
-
-    double fwVersion = fwMajor + (fwMinor / FW_MINOR_SCALE) + (fwBugfix / FW_BUGFIX_SCALE);
-    results.emplace_back(
-        devicePrefix + "_firmwareVersion",
-        ChannelValue{fwVersion, "", true});
-
-    return results;
+    // Derived channels: the sum of several fields, emitted only when all are present
+    for (const auto& derivedVal : owner["derived_channels"].toArray()) {
+        const QJsonObject derived = derivedVal.toObject();
+        const QJsonArray terms = derived["sum_of"].toArray();
+        if (terms.isEmpty()) {
+            qWarning() << "PD16Protocol: Derived channel" << derived["name"].toString()
+                       << "has no terms";
+            return false;
+        }
+
+        const size_t firstTerm = program.ops.size();
+        int requiredLength = 0;
+        for (const auto& termVal : terms) {
+            const auto extractor = parseField(termVal.toObject());
+            if (!extractor) {
+                return false;
+            }
+            DecodeOp op;
+            op.extractor = *extractor;
+            op.kind = OpKind::Accumulate;
+            requiredLength = std::max(requiredLength, extractor->requiredLength());
+            program.ops.push_back(std::move(op));
+        }
+
+        DecodeOp& last = program.ops.back();
+        last.kind = OpKind::EmitSum;
+        last.key = channelKey(derived);
+        last.unit = derived["units"].toString();
+        for (size_t i = firstTerm; i < program.ops.size(); ++i) {
+            program.ops[i].requiredLength = requiredLength;
+        }
+        ++program.channelCount;
+    }
+    return true;
 }
 
 //=============================================================================
-// IO Type Status Handlers
+// Binary Cache
 //=============================================================================
 
-std::vector<std::pair<QString, ChannelValue>>
-PD16Protocol::decodeOutput25AStatus(const QByteArray& payload, const QString& prefix) {
-    std::vector<std::pair<QString, ChannelValue>> results;
+QByteArray PD16Protocol::serializePrograms() const {
+    ProtocolCache::StringTable strings;
+    std::vector<CachedLayout> layouts;
+    std::vector<CachedProgram> programs;
+    std::vector<CachedOp> ops;
 
-    // Byte 1: Load %
-    if (payload.size() >= 2) {
-        uint8_t load = static_cast<uint8_t>(payload[1]);
-        results.emplace_back(prefix + "_load", ChannelValue{static_cast<double>(load), "%", true});
+    for (const auto& layout : m_layouts) {
+        CachedLayout cached;
+        cached.rateHz = layout.rateHz;
+        cached.program = layout.program;
+        cached.muxMask = layout.muxMask;
+        cached.programByMux = layout.programByMux;
+        layouts.push_back(cached);
     }
 
-    // Bytes 2-3: Voltage (mV)
-    if (payload.size() >= MIN_SIZE_FOR_VOLTAGE) {
-        uint16_t voltageRaw = decodeUint16(payload, VOLTAGE_BYTE_OFFSET);
-        double voltage = voltageRaw / MV_TO_V;
-        results.emplace_back(prefix + "_voltage", ChannelValue{voltage, "V", true});
+    for (const auto& program : m_programs) {
+        CachedProgram cached;
+        cached.firstOp = static_cast<uint32_t>(ops.size());
+        cached.opCount = static_cast<uint32_t>(program.ops.size());
+        cached.channelCount = program.channelCount;
+        cached.ioName = strings.intern(program.ioName);
+        programs.push_back(cached);
+
+        for (const auto& op : program.ops) {
+            CachedOp cachedOp;
+            cachedOp.extractor = op.extractor;
+            cachedOp.requiredLength = op.requiredLength;
+            cachedOp.key = strings.intern(op.key);
+            cachedOp.unit = strings.intern(op.unit);
+            cachedOp.kind = static_cast<uint8_t>(op.kind);
+            ops.push_back(cachedOp);
+        }
     }
 
-    // Bytes 4-5: Low side current (mA)
-    if (payload.size() >= MIN_SIZE_FOR_CURRENT_LOW) {
-        uint16_t currentRaw = decodeUint16(payload, CURRENT_LOW_BYTE_OFFSET);
-        double current = currentRaw / MA_TO_A;
-        results.emplace_back(prefix + "_currentLow", ChannelValue{current, "A", true});
-    }
+    CachedTables tables;
+    tables.programCount = static_cast<uint32_t>(programs.size());
+    tables.opCount = static_cast<uint32_t>(ops.size());
+    tables.stringCount = strings.count();
+    tables.stringUnits = strings.codeUnits();
+
+    ProtocolCache::Writer writer;
+    writer.append(tables);
+    writer.appendArray(layouts);
+    writer.appendArray(programs);
+    writer.appendArray(ops);
+    writer.appendStrings(strings);
+    return writer.data();
+}
 
-    // Byte 6: High side current (mA as uint8)
-    if (payload.size() >= MIN_SIZE_FOR_CURRENT_HIGH) {
-        uint8_t currentRaw = static_cast<uint8_t>(payload[CURRENT_HIGH_BYTE_OFFSET]);
-        double current = currentRaw / MA_TO_A;
-        results.emplace_back(prefix + "_currentHigh", ChannelValue{current, "A", true});
+bool PD16Protocol::loadCachedPrograms(QByteArrayView body) {
+    ProtocolCache::Reader reader(body);
+
+    CachedTables tables;
+    std::vector<CachedLayout> cachedLayouts;
+    std::vector<CachedProgram> cachedPrograms;
+    std::vector<CachedOp> cachedOps;
+    std::vector<QString> text;
+    if (!reader.read(tables) || !reader.readArray(cachedLayouts, CACHED_LAYOUT_COUNT) ||
+        !reader.readArray(cachedPrograms, tables.programCount) ||
+        !reader.readArray(cachedOps, tables.opCount) ||
+        !reader.readStrings(tables.stringCount, tables.stringUnits, text)) {
+        return false;
     }
 
-    // Byte 7: Retry count (bits 7-4) and Pin state (bits 3-0)
-    if (payload.size() >= MIN_SIZE_FOR_STATUS_RETRY) {
-        uint8_t statusByte = static_cast<uint8_t>(payload[STATUS_RETRY_BYTE_OFFSET]);
-        uint8_t retryCount = (statusByte >> RETRY_COUNT_25A_SHIFT) & RETRY_COUNT_25A_MASK;
-        uint8_t pinState = statusByte & STATUS_NIBBLE_MASK;
+    const auto isProgramIndex = [&tables](int16_t index) {
+        return index == NO_PROGRAM ||
+               (index >= 0 && static_cast<uint32_t>(index) < tables.programCount);
+    };
+
+    std::array<FrameLayout, FRAMES_PER_DEVICE> layouts{};
+    for (size_t i = 0; i < layouts.size(); ++i) {
+        const CachedLayout& cached = cachedLayouts[i];
+        if (!isProgramIndex(cached.program) ||
+            !std::all_of(cached.programByMux.begin(), cached.programByMux.end(),
+                         isProgramIndex)) {
+            return false;
+        }
+        layouts.at(i).rateHz = cached.rateHz;
+        layouts.at(i).program = cached.program;
+        layouts.at(i).muxMask = cached.muxMask;
+        layouts.at(i).programByMux = cached.programByMux;
+    }
 
-        results.emplace_back(prefix + "_retries",
-                             ChannelValue{static_cast<double>(retryCount), "", true});
-        results.emplace_back(prefix + "_pinState",
-                             ChannelValue{static_cast<double>(pinState), "", true});
+    constexpr auto OP_KIND_COUNT = static_cast<uint8_t>(OpKind::EmitSum) + 1;
+    std::vector<DecodeProgram> programs;
+    programs.reserve(cachedPrograms.size());
+    for (const auto& cached : cachedPrograms) {
+        if (static_cast<uint64_t>(cached.firstOp) + cached.opCount > cachedOps.size() ||
+            cached.ioName >= text.size()) {
+            return false;
+        }
+
+        DecodeProgram program;
+        program.channelCount = cached.channelCount;
+        program.ioName = text[cached.ioName];
+        program.ops.reserve(cached.opCount);
+        for (uint32_t i = 0; i < cached.opCount; ++i) {
+            const CachedOp& cachedOp = cachedOps[cached.firstOp + i];
+            if (cachedOp.key >= text.size() || cachedOp.unit >= text.size() ||
+                cachedOp.kind >= OP_KIND_COUNT || cachedOp.extractor.byteCount == 0 ||
+                cachedOp.extractor.byteCount > CACHED_MAX_EXTRACTOR_BYTES ||
+                cachedOp.requiredLength < cachedOp.extractor.requiredLength()) {
+                return false;
+            }
+
+            DecodeOp op;
+            op.extractor = cachedOp.extractor;
+            op.requiredLength = cachedOp.requiredLength;
+            op.kind = static_cast<OpKind>(cachedOp.kind);
+            op.key = text[cachedOp.key];
+            op.unit = text[cachedOp.unit];
+            program.ops.push_back(std::move(op));
+        }
+        programs.push_back(std::move(program));
     }
 
-    return results;
+    m_layouts = layouts;
+    m_programs = std::move(programs);
+    assignChannelNames();
+    return true;
 }
 
-std::vector<std::pair<QString, ChannelValue>>
-PD16Protocol::decodeOutput8AStatus(const QByteArray& payload, const QString& prefix) {
-    std::vector<std::pair<QString, ChannelValue>> results;
-
-    // Byte 1: Retry count (bits 7-3) and Pin state (bits 2-0)
-    if (payload.size() >= 2) {
-        uint8_t statusByte = static_cast<uint8_t>(payload[1]);
-        uint8_t retryCount = (statusByte >> RETRY_COUNT_8A_SHIFT) & RETRY_COUNT_8A_MASK;
-        uint8_t pinState = statusByte & PIN_STATE_8A_MASK;
+//=============================================================================
+// Frame Identification
+//=============================================================================
 
-        results.emplace_back(prefix + "_retries",
-                             ChannelValue{static_cast<double>(retryCount), "", true});
-        results.emplace_back(prefix + "_pinState",
-                             ChannelValue{static_cast<double>(pinState), "", true});
+int PD16Protocol::getDeviceIndex(uint32_t frameId) const {
+    constexpr uint32_t FRAME_ID_SPAN = DEVICE_ID_OFFSET * DEVICE_COUNT;
+    if (frameId < BASE_CAN_ID || frameId >= BASE_CAN_ID + FRAME_ID_SPAN) {
+        return -1;
     }
+    const auto device = static_cast<size_t>((frameId - BASE_CAN_ID) / DEVICE_ID_OFFSET);
+    return m_deviceEnabled[device] ? static_cast<int>(device) : -1;
+}
 
-    // Bytes 2-3: Voltage (mV)
-    if (payload.size() >= MIN_SIZE_FOR_VOLTAGE) {
-        uint16_t voltageRaw = decodeUint16(payload, VOLTAGE_BYTE_OFFSET);
-        double voltage = voltageRaw / MV_TO_V;
-        results.emplace_back(prefix + "_voltage", ChannelValue{voltage, "V", true});
+std::vector<FrameKey> PD16Protocol::claimedFrames() const {
+    std::vector<FrameKey> frames;
+    for (DeviceId device : devices()) {
+        const uint32_t baseId = BASE_CAN_ID + static_cast<uint32_t>(device) * DEVICE_ID_OFFSET;
+        for (size_t offset = 0; offset < m_layouts.size(); ++offset) {
+            if (!m_layouts[offset].isEmpty()) {
+                frames.push_back(FrameKey{baseId + static_cast<uint32_t>(offset), false});
+            }
+        }
     }
+    return frames;
+}
 
-    // Bytes 4-5: Current (mA)
-    if (payload.size() >= MIN_SIZE_FOR_CURRENT_LOW) {
-        uint16_t currentRaw = decodeUint16(payload, CURRENT_LOW_BYTE_OFFSET);
-        double current = currentRaw / MA_TO_A;
-        results.emplace_back(prefix + "_current", ChannelValue{current, "A", true});
+double PD16Protocol::declaredRateHz(const FrameKey& key) const {
+    if (key.extended || getDeviceIndex(key.frameId) < 0) {
+        return 0.0;
     }
+    const uint32_t offset = (key.frameId - BASE_CAN_ID) % DEVICE_ID_OFFSET;
+    return static_cast<double>(m_layouts.at(offset).rateHz);
+}
 
-    // Byte 6: Load %
-    if (payload.size() >= MIN_SIZE_FOR_CURRENT_HIGH) {
-        uint8_t load = static_cast<uint8_t>(payload[CURRENT_HIGH_BYTE_OFFSET]);
-        results.emplace_back(prefix + "_load", ChannelValue{static_cast<double>(load), "%", true});
+QStringList PD16Protocol::frameChannels(const FrameKey& key) const {
+    QStringList channels;
+    const int device = key.extended ? -1 : getDeviceIndex(key.frameId);
+    if (device < 0) {
+        return channels;
     }
 
-    return results;
+    const FrameLayout& layout = m_layouts.at((key.frameId - BASE_CAN_ID) % DEVICE_ID_OFFSET);
+    std::vector<int16_t> programs(layout.programByMux.begin(), layout.programByMux.end());
+    programs.push_back(layout.program);
+    std::sort(programs.begin(), programs.end());
+    programs.erase(std::unique(programs.begin(), programs.end()), programs.end());
+
+    for (int16_t programIndex : programs) {
+        if (programIndex == NO_PROGRAM) {
+            continue;
+        }
+        for (const DecodeOp& op : m_programs[static_cast<size_t>(programIndex)].ops) {
+            if (op.kind != OpKind::Accumulate) {
+                channels.append(op.names[static_cast<size_t>(device)]);
+            }
+        }
+    }
+    return channels;
 }
 
-std::vector<std::pair<QString, ChannelValue>>
-PD16Protocol::decodeSpeedPulseStatus(const QByteArray& payload, const QString& prefix) {
-    std::vector<std::pair<QString, ChannelValue>> results;
+int64_t PD16Protocol::multiplexValue(const QCanBusFrame& frame) const {
+    const QByteArray payload = frame.payload();
+    const int device = frame.hasExtendedFrameFormat() ? -1 : getDeviceIndex(frame.frameId());
+    if (device < 0 || payload.isEmpty()) {
+        return 0;
+    }
+    const FrameLayout& layout = m_layouts.at((frame.frameId() - BASE_CAN_ID) % DEVICE_ID_OFFSET);
+    return static_cast<uint8_t>(payload[0]) & layout.muxMask;
+}
 
-    // Byte 1 bit 0: State (ON/OFF)
-    if (payload.size() >= 2) {
-        bool state = (payload[1] & STATE_BIT_MASK) != 0;
-        results.emplace_back(prefix + "_state", ChannelValue{state ? 1.0 : 0.0, "", true});
+bool PD16Protocol::isMultiplexed(const FrameKey& key) const {
+    if (key.extended || getDeviceIndex(key.frameId) < 0) {
+        return false;
     }
+    return m_layouts.at((key.frameId - BASE_CAN_ID) % DEVICE_ID_OFFSET).muxMask != 0;
+}
+
+//=============================================================================
+// Main Decode Entry Point
+//=============================================================================
 
-    // Bytes 2-3: Voltage (mV)
-    if (payload.size() >= MIN_SIZE_FOR_VOLTAGE) {
-        uint16_t voltageRaw = decodeUint16(payload, VOLTAGE_BYTE_OFFSET);
-        double voltage = voltageRaw / MV_TO_V;
-        results.emplace_back(prefix + "_voltage", ChannelValue{voltage, "V", true});
+std::vector<std::pair<QString, ChannelValue>>
+PD16Protocol::decode(const QCanBusFrame& frame) const {
+    const QByteArray payload = frame.payload();
+    if (!frame.isValid() || payload.isEmpty()) {
+        return {};
     }
 
-    // Bytes 4-5: Duty cycle (0.1% resolution)
-    if (payload.size() >= MIN_SIZE_FOR_CURRENT_LOW) {
-        uint16_t dutyRaw = decodeUint16(payload, CURRENT_LOW_BYTE_OFFSET);
-        double duty = dutyRaw / DUTY_CYCLE_SCALE;
-        results.emplace_back(prefix + "_dutyCycle", ChannelValue{duty, "%", true});
+    const uint32_t frameId = frame.frameId();
+    const int device = getDeviceIndex(frameId);
+    if (device < 0) {
+        return {};
     }
 
-    // Bytes 6-7: Frequency (Hz)
-    if (payload.size() >= SPEED_PULSE_FULL_SIZE) {
-        uint16_t freq = decodeUint16(payload, CURRENT_HIGH_BYTE_OFFSET);
-        results.emplace_back(prefix + "_frequency",
-                             ChannelValue{static_cast<double>(freq), "Hz", true});
+    // One table lookup selects the program for this frame and mux value
+    const FrameLayout& layout = m_layouts[(frameId - BASE_CAN_ID) % DEVICE_ID_OFFSET];
+    const auto* data = reinterpret_cast<const uint8_t*>(payload.constData());
+    const int16_t programIndex =
+        layout.muxMask != 0 ? layout.programByMux.at(static_cast<size_t>(data[0] & layout.muxMask))
+                            : layout.program;
+    if (programIndex == NO_PROGRAM) {
+        return {};
     }
 
-    return results;
-}
+    const DecodeProgram& program = m_programs[static_cast<size_t>(programIndex)];
+    const auto length = static_cast<int>(payload.size());
 
-std::vector<std::pair<QString, ChannelValue>>
-PD16Protocol::decodeAnalogVoltageStatus(const QByteArray& payload, const QString& prefix) {
     std::vector<std::pair<QString, ChannelValue>> results;
-
-    // Byte 1 bit 0: State (ON/OFF)
-    if (payload.size() >= 2) {
-        bool state = (payload[1] & STATE_BIT_MASK) != 0;
-        results.emplace_back(prefix + "_state", ChannelValue{state ? 1.0 : 0.0, "", true});
-    }
-
-    // Bytes 2-3: Voltage (mV)
-    if (payload.size() >= MIN_SIZE_FOR_VOLTAGE) {
-        uint16_t voltageRaw = decodeUint16(payload, VOLTAGE_BYTE_OFFSET);
-        double voltage = voltageRaw / MV_TO_V;
-        results.emplace_back(prefix + "_voltage", ChannelValue{voltage, "V", true});
+    results.reserve(static_cast<size_t>(program.channelCount));
+
+    double sum = 0.0;
+    for (const DecodeOp& op : program.ops) {
+        if (op.requiredLength > length) {
+            continue;
+        }
+        double value = op.extractor.extract(data);
+        if (op.kind != OpKind::Emit) {
+            sum += value;
+            if (op.kind == OpKind::Accumulate) {
+                continue;
+            }
+            value = sum;
+            sum = 0.0;
+        }
+        results.emplace_back(op.names[static_cast<size_t>(device)],
+                             ChannelValue{value, op.unit, true});
     }
 
     return results;
@@ -558,4 +929,4 @@ uint16_t PD16Protocol::decodeUint16(const QByteArray& payload, int offset) {
         static_cast<uint8_t>(payload[offset + 1]));
 }
 
-} // namespace devdash
\ No newline at end of file
+} // namespace devdash
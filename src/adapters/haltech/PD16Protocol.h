@@ -1,13 +1,18 @@
 #pragma once
 
+#include "can/IFrameDecoder.h"
 #include "core/interfaces/IProtocolAdapter.h"
+#include "decode/ProtocolCache.h"
+#include "decode/SignalExtractor.h"
 
 #include <QCanBusFrame>
 #include <QHash>
+#include <QJsonObject>
 #include <QString>
 
 #include <array>
-#include <functional>
+#include <cstdint>
+#include <optional>
 #include <vector>
 
 namespace devdash {
@@ -20,23 +25,39 @@ namespace devdash {
  * - Bits 3-0: IO Index (0-15)
  *
  * Supports up to 4 PD16 devices (A, B, C, D) on a single CAN bus,
- * each with a unique base CAN ID.
+ * each with a unique base CAN ID. One instance decodes any subset of them
+ * (setDevices()); the channel name of every op is precomputed for all four
+ * devices at load, so the device is just an index derived from the frame ID.
  *
- * ## Design Pattern
+ * ## Decode programs
  *
- * Uses lookup tables instead of switch statements for:
- * - Frame offset → decoder function mapping
- * - IO type → handler function mapping
- * - Device ID → base CAN ID mapping
+ * The "pd16_to_ecu" frames of the protocol JSON are compiled into one
+ * layout per frame offset. A multiplexed layout holds a 256-entry table
+ * indexed by the mux byte (masked to the selector bits declared by the
+ * "Mux ID" fields); each entry points at a program - a flat list of
+ * SignalExtractor ops with the full channel name and unit already built.
+ * Decoding a frame is one table lookup plus a run over that op list: no
+ * std::function calls, no switch on IO type, no QString formatting.
  *
- * This follows the Open/Closed Principle - new frame types or IO types
- * can be added by extending the tables, not modifying decode logic.
+ * New firmware layouts (another IO type, more mux indices, a diagnostics
+ * page) are therefore a JSON change. Channel keys default to the camelCase
+ * JSON name ("Duty Cycle" → dutyCycle) and can be overridden with "key";
+ * "derived_channels" sum several fields into one channel (firmware version).
+ *
+ * Without a loaded definition a built-in layout covering input, output and
+ * device status is compiled, so decoding works out of the box.
+ *
+ * ## Channel aliases
+ *
+ * The profile's "pd16ChannelMapping" names individual IOs
+ * ("fan1": "PD16A_output_25a_0"). An aliased IO emits its channels under the
+ * alias instead of the device/IO prefix (fan1_load, fan1_current, ...).
  *
  * ## Usage
  *
  * @code
  * PD16Protocol pd16;
- * pd16.setDeviceId(PD16Protocol::DeviceId::A);
+ * pd16.setDevices({PD16Protocol::DeviceId::A, PD16Protocol::DeviceId::B});
  *
  * // In frame handler:
  * auto channels = pd16.decode(canFrame);
@@ -47,7 +68,7 @@ namespace devdash {
  *
  * @note Single Responsibility: Protocol parsing only, no I/O operations.
  */
-class PD16Protocol {
+class PD16Protocol : public IFrameDecoder {
 public:
     /**
      * @brief PD16 device ID (determines base CAN address).
@@ -75,18 +96,19 @@ public:
         AnalogVoltage = 4 ///< Analog voltage inputs
     };
 
-    /// Decoder function signature for frame handlers
-    using FrameDecoder = std::function<std::vector<std::pair<QString, ChannelValue>>(
-        const QByteArray& payload, const QString& devicePrefix)>;
+    /// Frame offsets per device (base ID + 0..7)
+    static constexpr int FRAMES_PER_DEVICE = 8;
 
-    /// IO type handler function signature
-    using IOTypeHandler = std::function<std::vector<std::pair<QString, ChannelValue>>(
-        const QByteArray& payload, const QString& channelPrefix)>;
+    /// PD16 devices addressable on one bus (A-D)
+    static constexpr int DEVICE_COUNT = 4;
+
+    /// Distinct values of the mux byte
+    static constexpr int MUX_VALUES = 256;
 
     PD16Protocol();
 
     /**
-     * @brief Set which PD16 device this decoder handles.
+     * @brief Decode a single PD16 device.
      *
      * Updates the base CAN ID and channel name prefix accordingly.
      *
@@ -95,8 +117,29 @@ public:
     void setDeviceId(DeviceId id);
 
     /**
-     * @brief Get current device ID.
-     * @return Currently configured device ID
+     * @brief Decode several PD16 devices from the same frame stream.
+     *
+     * The first device becomes deviceId() (base ID and prefix accessors).
+     * An empty list leaves the configuration unchanged.
+     *
+     * @param devices Devices to decode
+     */
+    void setDevices(const std::vector<DeviceId>& devices);
+
+    /**
+     * @brief Get the decoded devices, in ID order.
+     */
+    [[nodiscard]] std::vector<DeviceId> devices() const;
+
+    /**
+     * @brief Parse a profile device letter ("A"-"D", case-insensitive).
+     * @return Device ID, or std::nullopt for anything else
+     */
+    [[nodiscard]] static std::optional<DeviceId> deviceFromLetter(const QString& letter);
+
+    /**
+     * @brief Get the primary device ID.
+     * @return Device set by setDeviceId(), or the first of setDevices()
      */
     [[nodiscard]] DeviceId deviceId() const { return m_deviceId; }
 
@@ -106,6 +149,19 @@ public:
      */
     [[nodiscard]] uint32_t baseId() const { return m_baseId; }
 
+    /**
+     * @brief Name individual IOs from a profile "pd16ChannelMapping" block.
+     *
+     * Each entry maps an alias to an IO reference of the form
+     * PD16<device>_<output|input>_<type>_<index>, e.g. "PD16A_output_25a_0"
+     * (types: 25a, 8a, hbo, spi, avi). Replaces any previous aliases; the
+     * aliases survive loadDefinition().
+     *
+     * @param mapping Alias → IO reference
+     * @return Number of entries applied (invalid references are logged and skipped)
+     */
+    int setChannelAliases(const QJsonObject& mapping);
+
     /**
      * @brief Get device name prefix for channel naming.
      * @return Prefix string like "pd16_A"
@@ -115,20 +171,32 @@ public:
     /**
      * @brief Load protocol definition from JSON file.
      *
-     * Parses the JSON protocol definition and builds internal lookup
-     * tables for efficient frame decoding. The JSON defines:
-     * - Frame offsets and their meanings
-     * - IO types and their channel layouts
-     * - Byte positions, scaling factors, and units
+     * Compiles the "pd16_to_ecu" frames of the JSON protocol definition
+     * into decode programs, replacing the built-in layout. The JSON defines:
+     * - Frame offsets and their broadcast rates
+     * - Mux variants (IO type and indices, or a plain mux ID) per frame
+     * - Bit positions, conversions, and units of every field
      *
      * @param path Path to PD16 protocol JSON
      * @return true if loaded successfully
      *
-     * @note Clears any previously loaded definitions
-     * @note Must be called before decode() for full functionality
+     * @note Previously compiled programs are kept if loading fails
+     * @note Skips JSON parsing when the binary cache matches the file hash
      */
     [[nodiscard]] bool loadDefinition(const QString& path);
 
+    /**
+     * @brief Set the directory for compiled protocol caches.
+     * @param directory Cache directory; empty disables caching
+     *        (default: ProtocolCache::defaultDirectory())
+     */
+    void setCacheDirectory(const QString& directory) { m_cacheDirectory = directory; }
+
+    /**
+     * @brief Check whether the last loadDefinition() was served from the cache.
+     */
+    [[nodiscard]] bool loadedFromCache() const { return m_loadedFromCache; }
+
     /**
      * @brief Check if protocol definition is loaded.
      * @return true if a protocol definition has been loaded
@@ -136,24 +204,60 @@ public:
     [[nodiscard]] bool isLoaded() const { return m_loaded; }
 
     /**
-     * @brief Check if using hardcoded fallback decoders.
-     * @return true if no JSON loaded and using built-in decoders
+     * @brief Check if using the built-in layout.
+     * @return true if no JSON loaded and using the built-in decode programs
      */
     [[nodiscard]] bool usingFallback() const { return !m_loaded; }
 
     /**
      * @brief Decode a CAN frame into channel values.
      *
-     * Only decodes frames matching the current device's base ID range
-     * (baseId to baseId + 7).
+     * The device index and frame offset follow from the frame ID; channel
+     * names come from the precomputed per-device table.
      *
      * @param frame The CAN frame to decode
      * @return Vector of (channel name, value) pairs
      *
-     * @note Returns empty vector for frames outside this device's ID range
+     * @note Returns empty vector for frames of devices that are not decoded
      */
     [[nodiscard]] std::vector<std::pair<QString, ChannelValue>>
-    decode(const QCanBusFrame& frame) const;
+    decode(const QCanBusFrame& frame) const override;
+
+    /**
+     * @brief Get the frames to route to this decoder.
+     * @return Standard-format keys for every decoded frame offset of every device
+     */
+    [[nodiscard]] std::vector<FrameKey> claimedFrames() const override;
+
+    /**
+     * @brief Get the "rate_hz" declared for a frame offset.
+     */
+    [[nodiscard]] double declaredRateHz(const FrameKey& key) const override;
+
+    /**
+     * @brief Get the channel names of a frame over all mux values, aliases applied.
+     */
+    [[nodiscard]] QStringList frameChannels(const FrameKey& key) const override;
+
+    /**
+     * @brief Get the masked mux byte of a multiplexed frame (0 otherwise).
+     */
+    [[nodiscard]] int64_t multiplexValue(const QCanBusFrame& frame) const override;
+
+    /**
+     * @brief Check whether a frame's layout selects its program by mux byte.
+     */
+    [[nodiscard]] bool isMultiplexed(const FrameKey& key) const override;
+
+    /**
+     * @brief PD16 channels are read by name, not through "channelMappings".
+     */
+    [[nodiscard]] bool channelsMappedByProfile() const override { return false; }
+
+    /**
+     * @brief Number of compiled decode programs (one per mux value per frame).
+     */
+    [[nodiscard]] int programCount() const { return static_cast<int>(m_programs.size()); }
 
     /**
      * @brief Extract IO type from multiplexer byte.
@@ -189,83 +293,124 @@ public:
     [[nodiscard]] static uint16_t decodeUint16(const QByteArray& payload, int offset);
 
 private:
+    /// No program for a frame offset or mux value
+    static constexpr int16_t NO_PROGRAM = -1;
+
+    /**
+     * @brief What a decode op does with its extracted value.
+     */
+    enum class OpKind : uint8_t {
+        Emit,       ///< Emit the value as a channel
+        Accumulate, ///< Add the value to the running sum (derived channels)
+        EmitSum     ///< Add the value, emit the sum as a channel, reset the sum
+    };
+
+    /**
+     * @brief One field extraction of a decode program.
+     */
+    struct DecodeOp {
+        SignalExtractor extractor;  ///< Bit layout and conversion (scale/offset)
+        int requiredLength = 0;     ///< Payload bytes needed (whole group for sums)
+        OpKind kind = OpKind::Emit;
+        QString key;                ///< Channel key ("voltage")
+        QString unit;
+        std::array<QString, DEVICE_COUNT> names; ///< Full channel name per device
+    };
+
+    /**
+     * @brief Ops decoded for one frame offset and mux value.
+     */
+    struct DecodeProgram {
+        std::vector<DecodeOp> ops;
+        int channelCount = 0; ///< Channels emitted when the payload is complete
+        QString ioName;       ///< IO type and index ("25A_0"), empty for non-IO frames
+    };
+
+    /**
+     * @brief Decode layout of one frame offset.
+     */
+    struct FrameLayout {
+        int rateHz = 0;                      ///< Declared broadcast rate (0 = unknown)
+        uint8_t muxMask = 0;                 ///< Selector bits of byte 0 (0 = not multiplexed)
+        int16_t program = NO_PROGRAM;        ///< Program when not multiplexed
+        std::array<int16_t, MUX_VALUES> programByMux{}; ///< Masked mux byte → program
+
+        FrameLayout() { programByMux.fill(NO_PROGRAM); }
+
+        [[nodiscard]] bool isEmpty() const;
+    };
+
     DeviceId m_deviceId = DeviceId::A;
     uint32_t m_baseId = 0;
     QString m_devicePrefix;
+
+    /// Device index → decoded
+    std::array<bool, DEVICE_COUNT> m_deviceEnabled{};
+
+    /// Device index → IO name ("25A_0") → alias
+    std::array<QHash<QString, QString>, DEVICE_COUNT> m_aliases;
     bool m_loaded = false;
+    bool m_loadedFromCache = false;
 
-    /// Frame offset → decoder function lookup table
-    QHash<int, FrameDecoder> m_frameDecoders;
+    /// Directory for compiled protocol caches (empty = disabled)
+    QString m_cacheDirectory;
 
-    /// IO type → status handler lookup table
-    QHash<IOType, IOTypeHandler> m_outputStatusHandlers;
+    /// Frame offset → decode layout
+    std::array<FrameLayout, FRAMES_PER_DEVICE> m_layouts{};
 
-    /// IO type → input handler lookup table
-    QHash<IOType, IOTypeHandler> m_inputStatusHandlers;
+    /// Programs referenced by m_layouts
+    std::vector<DecodeProgram> m_programs;
 
     /**
-     * @brief Initialize decoder lookup tables.
-     *
-     * Called during construction to set up fallback decoders.
-     * These are overwritten if loadDefinition() is called.
+     * @brief Compile the built-in layout used until a definition is loaded.
      */
-    void initializeFallbackDecoders();
+    void compileBuiltinDefinition();
 
     /**
-     * @brief Build decoder tables from loaded JSON definition.
+     * @brief Compile the "pd16_to_ecu" frames of a protocol definition.
      *
-     * Called automatically after successful loadDefinition().
+     * @param root Parsed protocol JSON
+     * @return false (leaving the current programs untouched) if the
+     *         definition contains no decodable frame or a malformed field
      */
-    void buildDecoderTablesFromJson();
+    [[nodiscard]] bool compileDefinition(const QJsonObject& root);
 
     /**
-     * @brief Check if frame belongs to this device.
+     * @brief Compile the fields of one frame or mux variant into a program.
      *
-     * @param frameId CAN frame ID to check
-     * @return true if frameId is in range [baseId, baseId + 7]
+     * @param owner JSON object holding "channels" and optional "derived_channels"
+     * @param multiplexed Skip the byte-0 mux selector fields
+     * @param program Receives the ops
+     * @return false if a field is malformed
      */
-    [[nodiscard]] bool isDeviceFrame(uint32_t frameId) const;
+    [[nodiscard]] static bool compileProgram(const QJsonObject& owner, bool multiplexed,
+                                             DecodeProgram& program);
 
     /**
-     * @brief Get frame offset from base (0-7).
-     *
-     * @param frameId CAN frame ID
-     * @return Offset 0-7, or -1 if not a device frame
+     * @brief Serialize the compiled layouts for the binary cache.
      */
-    [[nodiscard]] int getFrameOffset(uint32_t frameId) const;
+    [[nodiscard]] QByteArray serializePrograms() const;
 
     /**
-     * @brief Build channel name prefix for a specific IO.
-     *
-     * @param ioType The IO type (25A, 8A, etc.)
-     * @param ioIndex The IO index (0-15)
-     * @return Full prefix like "pd16_A_25A_1"
+     * @brief Restore compiled layouts from a PD16Tables cache body.
+     * @return false if the body is truncated or inconsistent
      */
-    [[nodiscard]] QString buildChannelPrefix(IOType ioType, uint8_t ioIndex) const;
+    [[nodiscard]] bool loadCachedPrograms(QByteArrayView body);
 
-    // Frame decoders (one per frame offset)
-    [[nodiscard]] std::vector<std::pair<QString, ChannelValue>>
-    decodeInputStatus(const QByteArray& payload, const QString& devicePrefix) const;
-
-    [[nodiscard]] std::vector<std::pair<QString, ChannelValue>>
-    decodeOutputStatus(const QByteArray& payload, const QString& devicePrefix) const;
-
-    [[nodiscard]] std::vector<std::pair<QString, ChannelValue>>
-    decodeDeviceStatus(const QByteArray& payload, const QString& devicePrefix) const;
-
-    // IO type handlers for output status
-    [[nodiscard]] static std::vector<std::pair<QString, ChannelValue>>
-    decodeOutput25AStatus(const QByteArray& payload, const QString& channelPrefix);
-
-    [[nodiscard]] static std::vector<std::pair<QString, ChannelValue>>
-    decodeOutput8AStatus(const QByteArray& payload, const QString& channelPrefix);
-
-    // IO type handlers for input status
-    [[nodiscard]] static std::vector<std::pair<QString, ChannelValue>>
-    decodeSpeedPulseStatus(const QByteArray& payload, const QString& channelPrefix);
+    /**
+     * @brief Build every op's channel name for all four devices.
+     *
+     * Runs at load and when aliases change - never per frame.
+     */
+    void assignChannelNames();
 
-    [[nodiscard]] static std::vector<std::pair<QString, ChannelValue>>
-    decodeAnalogVoltageStatus(const QByteArray& payload, const QString& channelPrefix);
+    /**
+     * @brief Get the device index of a frame.
+     *
+     * @param frameId CAN frame ID
+     * @return Index 0-3 of an enabled device, or -1 for any other frame
+     */
+    [[nodiscard]] int getDeviceIndex(uint32_t frameId) const;
 };
 
-} // namespace devdash
\ No newline at end of file
+} // namespace devdash
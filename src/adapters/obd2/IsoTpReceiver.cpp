@@ -0,0 +1,164 @@
+/**
+ * @file IsoTpReceiver.cpp
+ * @brief Implementation of ISO-TP message reassembly and segmentation.
+ */
+
+#include "IsoTpReceiver.h"
+
+#include <algorithm>
+
+namespace devdash {
+
+namespace {
+
+//=============================================================================
+// Protocol Control Information
+//=============================================================================
+
+constexpr uint8_t PCI_SINGLE = 0x0;
+constexpr uint8_t PCI_FIRST = 0x1;
+constexpr uint8_t PCI_CONSECUTIVE = 0x2;
+constexpr uint8_t PCI_FLOW_CONTROL = 0x3;
+
+constexpr int PCI_SHIFT = 4;
+constexpr uint8_t LOW_NIBBLE = 0x0F;
+constexpr int BYTE_MASK = 0xFF;
+
+/// First frame: 12-bit length in the low nibble of byte 0 and byte 1
+constexpr int FIRST_FRAME_HEADER = 2;
+constexpr int FIRST_FRAME_CAPACITY = IsoTpReceiver::FRAME_LENGTH - FIRST_FRAME_HEADER;
+constexpr int CONSECUTIVE_FRAME_CAPACITY = IsoTpReceiver::FRAME_LENGTH - 1;
+
+/// Flow status "continue to send", block size 0 (no further flow control), STmin 0
+constexpr uint8_t FLOW_STATUS_CONTINUE = 0x0;
+constexpr uint8_t BLOCK_SIZE_UNLIMITED = 0;
+constexpr uint8_t SEPARATION_TIME_NONE = 0;
+
+} // anonymous namespace
+
+//=============================================================================
+// Reassembly
+//=============================================================================
+
+IsoTpReceiver::Result IsoTpReceiver::feed(std::span<const uint8_t> frame) {
+    if (frame.empty()) {
+        return Result::Error;
+    }
+    const auto pci = static_cast<uint8_t>(frame[0] >> PCI_SHIFT);
+    const int frameLength = static_cast<int>(frame.size());
+
+    if (pci == PCI_SINGLE) {
+        reset();
+        const int length = frame[0] & LOW_NIBBLE;
+        if (length == 0 || length > std::min(SINGLE_FRAME_CAPACITY, frameLength - 1)) {
+            return Result::Error;
+        }
+        std::copy_n(frame.begin() + 1, length, m_buffer.begin());
+        m_length = length;
+        return Result::Complete;
+    }
+
+    if (pci == PCI_FIRST) {
+        reset();
+        if (frameLength < FRAME_LENGTH) {
+            return Result::Error;
+        }
+        const int length = ((frame[0] & LOW_NIBBLE) << 8) | frame[1];
+        if (length <= SINGLE_FRAME_CAPACITY) {
+            return Result::Error;  // Would have fitted a single frame
+        }
+        std::copy_n(frame.begin() + FIRST_FRAME_HEADER, FIRST_FRAME_CAPACITY, m_buffer.begin());
+        m_length = FIRST_FRAME_CAPACITY;
+        m_expected = length;
+        m_nextSequence = 1;
+        return Result::FlowControlNeeded;
+    }
+
+    if (pci == PCI_CONSECUTIVE) {
+        if (m_expected == 0) {
+            return Result::Error;  // No first frame (or it was lost)
+        }
+        if ((frame[0] & LOW_NIBBLE) != m_nextSequence) {
+            reset();
+            return Result::Error;
+        }
+        const int take = std::min({CONSECUTIVE_FRAME_CAPACITY, m_expected - m_length,
+                                   frameLength - 1});
+        std::copy_n(frame.begin() + 1, take, m_buffer.begin() + m_length);
+        m_length += take;
+        m_nextSequence = static_cast<uint8_t>((m_nextSequence + 1) & LOW_NIBBLE);
+        if (m_length < m_expected) {
+            return Result::Incomplete;
+        }
+        m_expected = 0;
+        return Result::Complete;
+    }
+
+    if (pci == PCI_FLOW_CONTROL) {
+        return Result::Incomplete;
+    }
+    return Result::Error;
+}
+
+void IsoTpReceiver::reset() {
+    m_length = 0;
+    m_expected = 0;
+    m_nextSequence = 0;
+}
+
+//=============================================================================
+// Frame Construction
+//=============================================================================
+
+IsoTpReceiver::Frame IsoTpReceiver::flowControlFrame() {
+    Frame frame;
+    frame.fill(PADDING);
+    frame[0] = static_cast<uint8_t>((PCI_FLOW_CONTROL << PCI_SHIFT) | FLOW_STATUS_CONTINUE);
+    frame[1] = BLOCK_SIZE_UNLIMITED;
+    frame[2] = SEPARATION_TIME_NONE;
+    return frame;
+}
+
+bool IsoTpReceiver::singleFrame(std::span<const uint8_t> message, Frame& frame) {
+    const auto length = static_cast<int>(message.size());
+    if (length == 0 || length > SINGLE_FRAME_CAPACITY) {
+        return false;
+    }
+    frame.fill(PADDING);
+    frame[0] = static_cast<uint8_t>((PCI_SINGLE << PCI_SHIFT) | length);
+    std::copy(message.begin(), message.end(), frame.begin() + 1);
+    return true;
+}
+
+std::vector<IsoTpReceiver::Frame> IsoTpReceiver::segment(std::span<const uint8_t> message) {
+    const auto length = static_cast<int>(message.size());
+    std::vector<Frame> frames;
+    if (length == 0 || length > MAX_MESSAGE_LENGTH) {
+        return frames;
+    }
+    Frame frame{};
+    if (singleFrame(message, frame)) {
+        frames.push_back(frame);
+        return frames;
+    }
+
+    frame.fill(PADDING);
+    frame[0] = static_cast<uint8_t>((PCI_FIRST << PCI_SHIFT) | (length >> 8));
+    frame[1] = static_cast<uint8_t>(length & BYTE_MASK);
+    std::copy_n(message.begin(), FIRST_FRAME_CAPACITY, frame.begin() + FIRST_FRAME_HEADER);
+    frames.push_back(frame);
+
+    uint8_t sequence = 1;
+    for (int offset = FIRST_FRAME_CAPACITY; offset < length;
+         offset += CONSECUTIVE_FRAME_CAPACITY) {
+        frame.fill(PADDING);
+        frame[0] = static_cast<uint8_t>((PCI_CONSECUTIVE << PCI_SHIFT) | sequence);
+        const int take = std::min(CONSECUTIVE_FRAME_CAPACITY, length - offset);
+        std::copy_n(message.begin() + offset, take, frame.begin() + 1);
+        frames.push_back(frame);
+        sequence = static_cast<uint8_t>((sequence + 1) & LOW_NIBBLE);
+    }
+    return frames;
+}
+
+} // namespace devdash
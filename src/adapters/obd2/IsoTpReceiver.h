@@ -0,0 +1,120 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace devdash {
+
+/**
+ * @brief Reassembles ISO 15765-2 (ISO-TP) messages from classic CAN frames
+ *
+ * Diagnostic responses longer than seven bytes - an OBD-II answer to a
+ * multi-PID request, for example - arrive segmented: a first frame
+ * announcing the length, then consecutive frames once the receiver has
+ * sent a flow control frame. One receiver follows one sender (one CAN ID).
+ *
+ * | PCI nibble | Frame       | Payload |
+ * |------------|-------------|---------|
+ * | 0          | Single      | length, up to 7 bytes |
+ * | 1          | First       | 12-bit length, first 6 bytes |
+ * | 2          | Consecutive | 4-bit sequence number, up to 7 bytes |
+ * | 3          | Flow control | sent by the receiver (see flowControlFrame()) |
+ *
+ * The message buffer is allocated with the receiver, so reassembly never
+ * allocates. Deliberately free of Qt, like RawCanSocket. CAN FD (escape
+ * sequence lengths) is not supported.
+ *
+ * @code
+ * IsoTpReceiver receiver;
+ * const auto result = receiver.feed(payload);
+ * if (result == IsoTpReceiver::Result::FlowControlNeeded) {
+ *     send(IsoTpReceiver::flowControlFrame());
+ * } else if (result == IsoTpReceiver::Result::Complete) {
+ *     handle(receiver.message());
+ * }
+ * @endcode
+ */
+class IsoTpReceiver {
+  public:
+    /// Largest message a 12-bit first frame length can announce
+    static constexpr int MAX_MESSAGE_LENGTH = 4095;
+
+    /// Classic CAN payload, the size every ISO-TP frame is padded to
+    static constexpr int FRAME_LENGTH = 8;
+
+    /// Message bytes a single frame carries
+    static constexpr int SINGLE_FRAME_CAPACITY = FRAME_LENGTH - 1;
+
+    /// Filler for unused frame bytes
+    static constexpr uint8_t PADDING = 0x00;
+
+    using Frame = std::array<uint8_t, FRAME_LENGTH>;
+
+    /**
+     * @brief Outcome of feeding one frame
+     */
+    enum class Result : uint8_t {
+        Incomplete,         ///< Part of a message, more frames to come
+        Complete,           ///< message() holds a full message
+        FlowControlNeeded,  ///< First frame received; send flowControlFrame() to the sender
+        Error               ///< Malformed or out-of-sequence frame; message discarded
+    };
+
+    IsoTpReceiver() = default;
+
+    /**
+     * @brief Process one received frame
+     *
+     * A single or first frame always starts a new message, abandoning one
+     * in progress. Flow control frames are ignored (Incomplete).
+     */
+    [[nodiscard]] Result feed(std::span<const uint8_t> frame);
+
+    /**
+     * @brief The message completed by the last feed(), valid until the next call
+     */
+    [[nodiscard]] std::span<const uint8_t> message() const {
+        return {m_buffer.data(), static_cast<size_t>(m_length)};
+    }
+
+    /**
+     * @brief Abandon a message in progress
+     */
+    void reset();
+
+    /**
+     * @brief Check whether a segmented message is being received
+     */
+    [[nodiscard]] bool isReceiving() const { return m_expected > 0; }
+
+    /**
+     * @brief Flow control "continue to send": all remaining frames, no gap
+     */
+    [[nodiscard]] static Frame flowControlFrame();
+
+    /**
+     * @brief Build a single frame carrying @p message
+     * @return false if the message does not fit (more than 7 bytes, or empty)
+     */
+    [[nodiscard]] static bool singleFrame(std::span<const uint8_t> message, Frame& frame);
+
+    /**
+     * @brief Split @p message into the frames a sender transmits
+     *
+     * One single frame for up to 7 bytes; otherwise a first frame followed
+     * by consecutive frames, which the sender holds until flow control.
+     *
+     * @return Frames in transmission order, empty if the message is empty or too long
+     */
+    [[nodiscard]] static std::vector<Frame> segment(std::span<const uint8_t> message);
+
+  private:
+    std::array<uint8_t, MAX_MESSAGE_LENGTH> m_buffer{};
+    int m_length{0};          ///< Bytes received of the current message
+    int m_expected{0};        ///< Announced length of a segmented message, 0 = none
+    uint8_t m_nextSequence{0};
+};
+
+} // namespace devdash
@@ -0,0 +1,384 @@
+/**
+ * @file Obd2Adapter.cpp
+ * @brief Implementation of the OBD-II polling adapter.
+ */
+
+#include "Obd2Adapter.h"
+
+#include <QByteArray>
+#include <QDebug>
+#include <QJsonArray>
+
+#include <algorithm>
+
+namespace devdash {
+
+namespace {
+
+//=============================================================================
+// Configuration Keys
+//=============================================================================
+
+constexpr const char* CONFIG_KEY_OBD2 = "obd2";
+constexpr const char* CONFIG_KEY_REQUEST_ID = "requestId";
+constexpr const char* CONFIG_KEY_MAX_IN_FLIGHT = "maxInFlight";
+constexpr const char* CONFIG_KEY_MAX_PIDS_PER_REQUEST = "maxPidsPerRequest";
+constexpr const char* CONFIG_KEY_TIMEOUT_MS = "timeoutMs";
+constexpr const char* CONFIG_KEY_DETECT_SUPPORTED_PIDS = "detectSupportedPids";
+constexpr const char* CONFIG_KEY_PIDS = "pids";
+constexpr const char* CONFIG_KEY_CHANNEL_MAPPINGS = "channelMappings";
+
+//=============================================================================
+// Default Values
+//=============================================================================
+
+constexpr int DEFAULT_TIMEOUT_MS = 100;
+constexpr int STATS_INTERVAL_MS = 1000;
+
+/// Retry delay after a request could not be written
+constexpr int SEND_RETRY_MS = 10;
+
+constexpr int64_t US_PER_MS = 1000;
+constexpr int64_t NS_PER_US = 1000;
+
+/// Highest 11-bit request ID
+constexpr uint32_t MAX_STANDARD_FRAME_ID = 0x7FF;
+
+/**
+ * @brief Parse a CAN ID given as number or string ("0x7E0")
+ */
+uint32_t parseFrameId(const QJsonValue& value, uint32_t fallback) {
+    if (value.isDouble()) {
+        return static_cast<uint32_t>(value.toInt());
+    }
+    bool ok = false;
+    const uint32_t frameId = value.toString().toUInt(&ok, 0);
+    return ok ? frameId : fallback;
+}
+
+/**
+ * @brief Find the PID a "pids" key names: a channel name or a PID number ("0x0C")
+ */
+const Obd2PidDefinition* pidForKey(const QString& key) {
+    if (const Obd2PidDefinition* byChannel = Obd2Protocol::definitionForChannel(key)) {
+        return byChannel;
+    }
+    bool ok = false;
+    const uint32_t pid = key.toUInt(&ok, 0);
+    return ok && pid <= UINT8_MAX ? Obd2Protocol::definition(static_cast<uint8_t>(pid)) : nullptr;
+}
+
+/**
+ * @brief Bitmap of a supported-PID response (bit 31 = first PID after the bitmap PID)
+ */
+uint32_t supportedPidBitmap(const Obd2PidData& data) {
+    uint32_t bitmap = 0;
+    for (int i = 0; i < Obd2PidData::MAX_DATA; ++i) {
+        bitmap = (bitmap << 8) | data.data[static_cast<size_t>(i)];
+    }
+    return bitmap;
+}
+
+/**
+ * @brief Wrap an ISO-TP frame (always 8 bytes, padded) for writeFrame()
+ */
+QCanBusFrame toCanFrame(uint32_t frameId, const IsoTpReceiver::Frame& payload) {
+    return {frameId, QByteArray(reinterpret_cast<const char*>(payload.data()),
+                                IsoTpReceiver::FRAME_LENGTH)};
+}
+
+} // anonymous namespace
+
+//=============================================================================
+// Construction / Destruction
+//=============================================================================
+
+Obd2Adapter::Obd2Adapter(const QJsonObject& config, QObject* parent)
+    : CanAdapter(config, parent), m_requestId(Obd2Protocol::FIRST_REQUEST_ID),
+      m_receivers(Obd2Protocol::ECU_COUNT) {
+    router().addDecoder(&m_protocol);
+
+    const QJsonObject obd2 = config[CONFIG_KEY_OBD2].toObject();
+    m_requestId = parseFrameId(obd2[CONFIG_KEY_REQUEST_ID], Obd2Protocol::FIRST_REQUEST_ID);
+    if (m_requestId > MAX_STANDARD_FRAME_ID) {
+        qWarning() << "Obd2Adapter: Request ID" << Qt::hex << m_requestId
+                   << "is not an 11-bit ID - using" << Obd2Protocol::FIRST_REQUEST_ID;
+        m_requestId = Obd2Protocol::FIRST_REQUEST_ID;
+    }
+
+    Obd2Scheduler::Options options;
+    options.maxInFlight = obd2[CONFIG_KEY_MAX_IN_FLIGHT].toInt(options.maxInFlight);
+    options.maxPidsPerRequest =
+        obd2[CONFIG_KEY_MAX_PIDS_PER_REQUEST].toInt(options.maxPidsPerRequest);
+    options.timeoutUs = obd2[CONFIG_KEY_TIMEOUT_MS].toInt(DEFAULT_TIMEOUT_MS) * US_PER_MS;
+    options.detectSupportedPids =
+        obd2[CONFIG_KEY_DETECT_SUPPORTED_PIDS].toBool(options.detectSupportedPids);
+    m_scheduler.setOptions(options);
+
+    loadPids(obd2[CONFIG_KEY_PIDS].toObject(), config[CONFIG_KEY_CHANNEL_MAPPINGS].toObject());
+
+    m_response.reserve(Obd2Scheduler::MAX_PIDS_PER_REQUEST);
+    m_responsePids.reserve(Obd2Scheduler::MAX_PIDS_PER_REQUEST);
+
+    m_pollTimer.setParent(this);
+    m_pollTimer.setSingleShot(true);
+    m_pollTimer.setTimerType(Qt::PreciseTimer);
+    connect(&m_pollTimer, &QTimer::timeout, this, &Obd2Adapter::onPollTimeout);
+    m_statsTimer.setParent(this);
+    connect(&m_statsTimer, &QTimer::timeout, this, &Obd2Adapter::onStatsTimeout);
+
+    qDebug() << "Obd2Adapter: Polling" << m_scheduler.pidStats().size() << "PIDs via"
+             << Qt::hex << m_requestId;
+}
+
+Obd2Adapter::~Obd2Adapter() {
+    stop();
+}
+
+//=============================================================================
+// IProtocolAdapter Interface
+//=============================================================================
+
+bool Obd2Adapter::start() {
+    if (isRunning()) {
+        return true;
+    }
+    if (!CanAdapter::start()) {
+        return false;
+    }
+
+    for (IsoTpReceiver& receiver : m_receivers) {
+        receiver.reset();
+    }
+    m_clock.start();
+    m_scheduler.start(nowUs());
+    m_loggedDiscovering = m_scheduler.isDiscovering();
+    m_loggedMaxInFlight = m_scheduler.maxInFlight();
+    m_loggedMaxPidsPerRequest = m_scheduler.maxPidsPerRequest();
+    m_statsTimer.start(STATS_INTERVAL_MS);
+    pump();
+    return true;
+}
+
+void Obd2Adapter::stop() {
+    if (isRunning()) {
+        m_pollTimer.stop();
+        m_statsTimer.stop();
+        const Obd2Scheduler::Stats& stats = m_scheduler.stats();
+        qInfo() << "Obd2Adapter: Sent" << stats.requests << "requests, received"
+                << stats.responses << "PID values," << stats.timeouts << "timeouts,"
+                << stats.negativeResponses << "rejected";
+    }
+    CanAdapter::stop();
+}
+
+QString Obd2Adapter::adapterName() const {
+    return QStringLiteral("OBD-II");
+}
+
+QJsonObject Obd2Adapter::diagnostics() const {
+    QJsonObject result = CanAdapter::diagnostics();
+
+    const Obd2Scheduler::Stats& stats = m_scheduler.stats();
+    QJsonObject obd2;
+    obd2["requestId"] = QStringLiteral("0x%1").arg(m_requestId, 0, 16);
+    obd2["discovering"] = m_scheduler.isDiscovering();
+    obd2["inFlight"] = m_scheduler.inFlight();
+    obd2["maxInFlight"] = m_scheduler.maxInFlight();
+    obd2["maxPidsPerRequest"] = m_scheduler.maxPidsPerRequest();
+    obd2["pidsPerSecond"] = stats.pidsPerSecond;
+    obd2["requestsPerSecond"] = stats.requestsPerSecond;
+    obd2["pidsPerRequest"] = stats.pidsPerRequest;
+    obd2["requests"] = static_cast<qint64>(stats.requests);
+    obd2["responses"] = static_cast<qint64>(stats.responses);
+    obd2["timeouts"] = static_cast<qint64>(stats.timeouts);
+    obd2["negativeResponses"] = static_cast<qint64>(stats.negativeResponses);
+    obd2["unexpectedResponses"] = static_cast<qint64>(stats.unexpectedResponses);
+    obd2["framingErrors"] = static_cast<qint64>(m_framingErrors);
+    obd2["sendFailures"] = static_cast<qint64>(m_sendFailures);
+
+    QJsonArray pids;
+    for (const auto& pidStats : m_scheduler.pidStats()) {
+        const Obd2PidDefinition* definition = Obd2Protocol::definition(pidStats.pid);
+        QJsonObject pid;
+        pid["pid"] = QStringLiteral("0x%1").arg(pidStats.pid, 2, 16, QLatin1Char('0'));
+        pid["channel"] = definition != nullptr ? QString::fromUtf8(definition->channel) : "";
+        pid["targetHz"] = pidStats.targetHz;
+        pid["measuredHz"] = pidStats.measuredHz;
+        pid["responses"] = static_cast<qint64>(pidStats.responses);
+        pid["timeouts"] = static_cast<qint64>(pidStats.timeouts);
+        pid["supported"] = pidStats.supported;
+        pids.append(pid);
+    }
+    obd2["pids"] = pids;
+
+    result["obd2"] = obd2;
+    return result;
+}
+
+//=============================================================================
+// Response Handling
+//=============================================================================
+
+bool Obd2Adapter::interceptFrame(const QCanBusFrame& frame) {
+    const uint32_t frameId = frame.frameId();
+    if (frame.hasExtendedFrameFormat() || frameId < Obd2Protocol::FIRST_RESPONSE_ID ||
+        frameId >= Obd2Protocol::FIRST_RESPONSE_ID + Obd2Protocol::ECU_COUNT) {
+        return false;
+    }
+
+    IsoTpReceiver& receiver = m_receivers[frameId - Obd2Protocol::FIRST_RESPONSE_ID];
+    const QByteArray payload = frame.payload();
+    const auto result = receiver.feed({reinterpret_cast<const uint8_t*>(payload.constData()),
+                                       static_cast<size_t>(payload.size())});
+    if (result == IsoTpReceiver::Result::FlowControlNeeded) {
+        // To the responding ECU's physical address, also for functional requests
+        sendFlowControl(frameId - Obd2Protocol::RESPONSE_ID_OFFSET);
+    } else if (result == IsoTpReceiver::Result::Complete) {
+        handleMessage(receiver.message());
+        pump();
+    } else if (result == IsoTpReceiver::Result::Error) {
+        ++m_framingErrors;
+    }
+    return true;
+}
+
+void Obd2Adapter::handleMessage(std::span<const uint8_t> message) {
+    const int64_t now = nowUs();
+    if (Obd2Protocol::isNegativeResponse(message)) {
+        m_scheduler.onNegativeResponse(now);
+        return;
+    }
+    if (!Obd2Protocol::parseResponse(message, m_response)) {
+        return;  // Another service, e.g. a diagnostic tool on the same bus
+    }
+
+    m_responsePids.clear();
+    for (const Obd2PidData& data : m_response) {
+        if (Obd2Scheduler::isSupportedPidsPid(data.pid)) {
+            m_scheduler.onSupportedPids(data.pid, supportedPidBitmap(data));
+        }
+        m_responsePids.push_back(data.pid);
+    }
+    m_scheduler.onResponse(m_responsePids, now);
+    publishDecoded(Obd2Protocol::channelValues(m_response));
+}
+
+//=============================================================================
+// Private Slots
+//=============================================================================
+
+void Obd2Adapter::onPollTimeout() {
+    pump();
+}
+
+void Obd2Adapter::onStatsTimeout() {
+    m_scheduler.closeWindow(nowUs());
+    publishDecoded({
+        {CHANNEL_PID_RATE, ChannelValue{m_scheduler.stats().pidsPerSecond, "Hz", true}},
+    });
+}
+
+//=============================================================================
+// Private Methods
+//=============================================================================
+
+void Obd2Adapter::loadPids(const QJsonObject& pids, const QJsonObject& channelMappings) {
+    if (pids.isEmpty()) {
+        // Default: what the profile displays (everything without mappings)
+        for (const Obd2PidDefinition& definition : Obd2Protocol::definitions()) {
+            const QString channel = QString::fromUtf8(definition.channel);
+            if (channelMappings.isEmpty() || channelMappings.contains(channel)) {
+                m_scheduler.addPid(definition.pid,
+                                   Obd2Protocol::priorityRateHz(definition.priority));
+            }
+        }
+        return;
+    }
+
+    for (auto it = pids.constBegin(); it != pids.constEnd(); ++it) {
+        const Obd2PidDefinition* definition = pidForKey(it.key());
+        if (definition == nullptr) {
+            qWarning() << "Obd2Adapter: Unknown PID" << it.key();
+            continue;
+        }
+        Obd2Priority priority = definition->priority;
+        double rateHz = it.value().toDouble(0.0);
+        if (it.value().isString()) {
+            rateHz = Obd2Protocol::parsePriority(it.value().toString(), priority)
+                         ? Obd2Protocol::priorityRateHz(priority)
+                         : 0.0;
+        }
+        if (rateHz <= 0.0) {
+            qWarning() << "Obd2Adapter: Ignoring invalid rate for" << it.key() << "-"
+                       << "use high, medium, low or a rate in Hz";
+            continue;
+        }
+        m_scheduler.addPid(definition->pid, rateHz);
+    }
+}
+
+void Obd2Adapter::pump() {
+    if (!isRunning()) {
+        return;
+    }
+
+    const int64_t now = nowUs();
+    m_scheduler.expire(now);
+    Obd2Scheduler::Request request;
+    while (m_scheduler.nextRequest(now, request)) {
+        if (!sendRequest(request)) {
+            // Not connected yet or transmit queue full: not the ECU's fault, retry soon
+            m_scheduler.cancel(request);
+            ++m_sendFailures;
+            logSchedulerChanges();
+            m_pollTimer.start(SEND_RETRY_MS);
+            return;
+        }
+    }
+    logSchedulerChanges();
+
+    const int64_t next = m_scheduler.nextEventUs();
+    if (next == Obd2Scheduler::NO_EVENT) {
+        m_pollTimer.stop();
+        return;
+    }
+    const int64_t waitUs = std::max<int64_t>(next - nowUs(), 0);
+    m_pollTimer.start(static_cast<int>((waitUs + US_PER_MS - 1) / US_PER_MS));
+}
+
+bool Obd2Adapter::sendRequest(const Obd2Scheduler::Request& request) {
+    IsoTpReceiver::Frame payload{};
+    return Obd2Protocol::encodeRequest(request.pidList(), payload) &&
+           writeFrame(toCanFrame(m_requestId, payload));
+}
+
+void Obd2Adapter::sendFlowControl(uint32_t frameId) {
+    if (!writeFrame(toCanFrame(frameId, IsoTpReceiver::flowControlFrame()))) {
+        ++m_sendFailures;
+    }
+}
+
+void Obd2Adapter::logSchedulerChanges() {
+    if (m_loggedDiscovering && !m_scheduler.isDiscovering()) {
+        qInfo() << "Obd2Adapter: ECU supports" << m_scheduler.pollablePids() << "of"
+                << m_scheduler.pidStats().size() << "configured PIDs";
+    }
+    if (m_scheduler.maxPidsPerRequest() < m_loggedMaxPidsPerRequest) {
+        qWarning() << "Obd2Adapter: ECU does not answer multi-PID requests -"
+                   << "requesting one PID at a time";
+    }
+    if (m_scheduler.maxInFlight() < m_loggedMaxInFlight) {
+        qWarning() << "Obd2Adapter: Requests timing out - reducing requests in flight to"
+                   << m_scheduler.maxInFlight();
+    }
+    m_loggedDiscovering = m_scheduler.isDiscovering();
+    m_loggedMaxInFlight = m_scheduler.maxInFlight();
+    m_loggedMaxPidsPerRequest = m_scheduler.maxPidsPerRequest();
+}
+
+int64_t Obd2Adapter::nowUs() const {
+    return m_clock.nsecsElapsed() / NS_PER_US;
+}
+
+} // namespace devdash
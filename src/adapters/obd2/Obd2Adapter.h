@@ -0,0 +1,124 @@
+#pragma once
+
+#include "IsoTpReceiver.h"
+#include "Obd2Protocol.h"
+#include "Obd2Scheduler.h"
+#include "can/CanAdapter.h"
+
+#include <QElapsedTimer>
+#include <QJsonObject>
+#include <QTimer>
+
+#include <span>
+#include <vector>
+
+namespace devdash {
+
+/**
+ * @brief Protocol adapter for stock ECUs: polls OBD-II PIDs over CAN (ISO 15765-4)
+ *
+ * Unlike a Haltech ECU, a stock ECU broadcasts nothing the dash can use;
+ * every value has to be requested. Obd2Scheduler decides what to ask for
+ * next (per-PID rates from display priority, several requests in flight,
+ * up to six PIDs per request); this class sends the service 01 requests,
+ * reassembles segmented responses (ISO-TP, with flow control) and
+ * publishes the decoded channels through the normal CanAdapter path.
+ *
+ * Channel names follow Obd2Protocol's PID table and match the Haltech
+ * names where the meaning is the same, so channelMappings carry over.
+ *
+ * @code
+ * "adapter": "obd2",
+ * "adapterConfig": {
+ *     "interface": "can0",
+ *     "obd2": {
+ *         "requestId": "0x7E0",        // engine ECU; "0x7DF" asks every ECU
+ *         "maxInFlight": 2,            // pipelined requests (1-16)
+ *         "maxPidsPerRequest": 6,      // 1 disables multi-PID requests
+ *         "timeoutMs": 100,
+ *         "detectSupportedPids": true, // read the ECU's PID bitmaps first
+ *         "pids": {                    // default: PIDs of the mapped channels
+ *             "RPM": "high",           // high = 20 Hz, medium = 5 Hz, low = 1 Hz
+ *             "Coolant Temperature": "low",
+ *             "0x0B": 10               // PID number and rate in Hz also work
+ *         }
+ *     }
+ * }
+ * @endcode
+ *
+ * Achieved PIDs per second are measured every second, published as the
+ * internal obd2.pidRate channel and listed per PID in diagnostics().
+ */
+class Obd2Adapter : public CanAdapter {
+    Q_OBJECT
+
+  public:
+    /// Internal channel: PID values received per second, updated once per second
+    static constexpr const char* CHANNEL_PID_RATE = "obd2.pidRate";
+
+    explicit Obd2Adapter(const QJsonObject& config, QObject* parent = nullptr);
+    ~Obd2Adapter() override;
+
+    // QObject-based classes are not copyable or movable
+    Obd2Adapter(const Obd2Adapter&) = delete;
+    Obd2Adapter& operator=(const Obd2Adapter&) = delete;
+    Obd2Adapter(Obd2Adapter&&) = delete;
+    Obd2Adapter& operator=(Obd2Adapter&&) = delete;
+
+    // IProtocolAdapter interface
+    [[nodiscard]] bool start() override;
+    void stop() override;
+    [[nodiscard]] QString adapterName() const override;
+
+    /**
+     * @brief CanAdapter diagnostics plus "obd2": poll rates, limits and per-PID statistics
+     */
+    [[nodiscard]] QJsonObject diagnostics() const override;
+
+    /**
+     * @brief The poll scheduler (read-only, for statistics)
+     */
+    [[nodiscard]] const Obd2Scheduler& scheduler() const { return m_scheduler; }
+
+    /** @brief CAN ID requests are sent to */
+    [[nodiscard]] uint32_t requestId() const { return m_requestId; }
+
+  protected:
+    [[nodiscard]] bool interceptFrame(const QCanBusFrame& frame) override;
+
+  private slots:
+    void onPollTimeout();
+    void onStatsTimeout();
+
+  private:  // NOLINT(readability-redundant-access-specifiers) - Required for MOC
+    void loadPids(const QJsonObject& pids, const QJsonObject& channelMappings);
+    /// Time out, send what is due and re-arm the poll timer
+    void pump();
+    [[nodiscard]] bool sendRequest(const Obd2Scheduler::Request& request);
+    void sendFlowControl(uint32_t frameId);
+    void handleMessage(std::span<const uint8_t> message);
+    void logSchedulerChanges();
+    [[nodiscard]] int64_t nowUs() const;
+
+    Obd2Protocol m_protocol;
+    Obd2Scheduler m_scheduler;
+    uint32_t m_requestId;
+
+    /// One per ECU response ID; heap-allocated, each holds a full ISO-TP buffer
+    std::vector<IsoTpReceiver> m_receivers;
+    std::vector<Obd2PidData> m_response;  ///< Parsed response, reused
+    std::vector<uint8_t> m_responsePids;  ///< PIDs of m_response, reused
+    uint64_t m_framingErrors{0};
+    uint64_t m_sendFailures{0};  ///< Requests and flow control frames not written
+
+    QElapsedTimer m_clock;
+    QTimer m_pollTimer;   ///< Fires when the next PID falls due or a request times out
+    QTimer m_statsTimer;  ///< Closes a measurement window and publishes obd2.pidRate
+
+    // Last scheduler state logged, to report discovery and fallbacks once
+    bool m_loggedDiscovering{false};
+    int m_loggedMaxInFlight{0};
+    int m_loggedMaxPidsPerRequest{0};
+};
+
+} // namespace devdash
@@ -0,0 +1,264 @@
+/**
+ * @file Obd2Protocol.cpp
+ * @brief Implementation of OBD-II service 01 encoding and decoding.
+ */
+
+#include "Obd2Protocol.h"
+
+#include "IsoTpReceiver.h"
+#include "Obd2Scheduler.h"
+
+#include <QByteArray>
+#include <QCanBusFrame>
+#include <QHash>
+
+#include <algorithm>
+#include <cmath>
+
+namespace devdash {
+
+namespace {
+
+//=============================================================================
+// PID Table (SAE J1979 Service 01)
+//=============================================================================
+
+constexpr double PERCENT_OF_255 = 100.0 / 255.0;
+constexpr double TEMPERATURE_OFFSET = -40.0;
+constexpr double FUEL_PRESSURE_SCALE = 3.0;
+constexpr double RPM_SCALE = 0.25;
+constexpr double TIMING_SCALE = 0.5;
+constexpr double TIMING_OFFSET = -64.0;
+constexpr double MAF_SCALE = 0.01;
+constexpr double LAMBDA_SCALE = 1.0 / 32768.0;
+constexpr double VOLTAGE_SCALE = 0.001;
+
+constexpr std::array<Obd2PidDefinition, 16> PID_DEFINITIONS = {{
+    {0x04, "Engine Load", 1, 1, PERCENT_OF_255, 0.0, "%", Obd2Priority::Medium},
+    {0x05, "Coolant Temperature", 1, 1, 1.0, TEMPERATURE_OFFSET, "°C", Obd2Priority::Low},
+    {0x0A, "Fuel Pressure", 1, 1, FUEL_PRESSURE_SCALE, 0.0, "kPa", Obd2Priority::Low},
+    {0x0B, "Manifold Pressure", 1, 1, 1.0, 0.0, "kPa", Obd2Priority::Medium},
+    {0x0C, "RPM", 2, 2, RPM_SCALE, 0.0, "RPM", Obd2Priority::High},
+    {0x0D, "Vehicle Speed", 1, 1, 1.0, 0.0, "km/h", Obd2Priority::High},
+    {0x0E, "Ignition Timing", 1, 1, TIMING_SCALE, TIMING_OFFSET, "°", Obd2Priority::Medium},
+    {0x0F, "Air Temperature", 1, 1, 1.0, TEMPERATURE_OFFSET, "°C", Obd2Priority::Low},
+    {0x10, "MAF Air Flow", 2, 2, MAF_SCALE, 0.0, "g/s", Obd2Priority::Medium},
+    {0x11, "Throttle Position", 1, 1, PERCENT_OF_255, 0.0, "%", Obd2Priority::High},
+    {0x24, "Wideband Lambda 1", 4, 2, LAMBDA_SCALE, 0.0, "lambda", Obd2Priority::Medium},
+    {0x2F, "Fuel Level", 1, 1, PERCENT_OF_255, 0.0, "%", Obd2Priority::Low},
+    {0x33, "Barometric Pressure", 1, 1, 1.0, 0.0, "kPa", Obd2Priority::Low},
+    {0x42, "Battery Voltage", 2, 2, VOLTAGE_SCALE, 0.0, "V", Obd2Priority::Low},
+    {0x46, "Ambient Temperature", 1, 1, 1.0, TEMPERATURE_OFFSET, "°C", Obd2Priority::Low},
+    {0x5C, "Oil Temperature", 1, 1, 1.0, TEMPERATURE_OFFSET, "°C", Obd2Priority::Low},
+}};
+
+/// Data bytes of a supported-PID bitmap (PIDs 0x00, 0x20, ...)
+constexpr int BITMAP_BYTES = 4;
+
+//=============================================================================
+// Priorities
+//=============================================================================
+
+struct PriorityInfo {
+    const char* name;
+    double rateHz;
+};
+
+/// Indexed by Obd2Priority
+constexpr std::array<PriorityInfo, 3> PRIORITIES = {{
+    {"high", 20.0},
+    {"medium", 5.0},
+    {"low", 1.0},
+}};
+
+//=============================================================================
+// Request Layout
+//=============================================================================
+
+/// Request message: service byte followed by the PIDs
+constexpr int REQUEST_HEADER = 1;
+
+/**
+ * @brief Data length of a PID in a response, -1 if unknown
+ */
+int pidDataLength(uint8_t pid) {
+    if (Obd2Scheduler::isSupportedPidsPid(pid)) {
+        return BITMAP_BYTES;
+    }
+    const Obd2PidDefinition* definition = Obd2Protocol::definition(pid);
+    return definition != nullptr ? definition->dataBytes : -1;
+}
+
+const QHash<QString, const Obd2PidDefinition*>& definitionsByChannel() {
+    static const QHash<QString, const Obd2PidDefinition*> CHANNELS = [] {
+        QHash<QString, const Obd2PidDefinition*> channels;
+        for (const auto& definition : PID_DEFINITIONS) {
+            channels.insert(QString::fromUtf8(definition.channel), &definition);
+        }
+        return channels;
+    }();
+    return CHANNELS;
+}
+
+} // anonymous namespace
+
+//=============================================================================
+// PID Table
+//=============================================================================
+
+std::span<const Obd2PidDefinition> Obd2Protocol::definitions() {
+    return PID_DEFINITIONS;
+}
+
+const Obd2PidDefinition* Obd2Protocol::definition(uint8_t pid) {
+    const auto it = std::lower_bound(
+        PID_DEFINITIONS.begin(), PID_DEFINITIONS.end(), pid,
+        [](const Obd2PidDefinition& definition, uint8_t key) { return definition.pid < key; });
+    return it != PID_DEFINITIONS.end() && it->pid == pid ? &*it : nullptr;
+}
+
+const Obd2PidDefinition* Obd2Protocol::definitionForChannel(const QString& channel) {
+    return definitionsByChannel().value(channel, nullptr);
+}
+
+bool Obd2Protocol::parsePriority(const QString& name, Obd2Priority& priority) {
+    for (size_t i = 0; i < PRIORITIES.size(); ++i) {
+        if (name.compare(QLatin1String(PRIORITIES[i].name), Qt::CaseInsensitive) == 0) {
+            priority = static_cast<Obd2Priority>(i);
+            return true;
+        }
+    }
+    return false;
+}
+
+double Obd2Protocol::priorityRateHz(Obd2Priority priority) {
+    const auto index = static_cast<size_t>(priority);
+    return index < PRIORITIES.size() ? PRIORITIES[index].rateHz : PRIORITIES.back().rateHz;
+}
+
+//=============================================================================
+// Requests and Responses
+//=============================================================================
+
+bool Obd2Protocol::encodeRequest(std::span<const uint8_t> pids, std::array<uint8_t, 8>& payload) {
+    if (pids.empty() || static_cast<int>(pids.size()) > Obd2Scheduler::MAX_PIDS_PER_REQUEST) {
+        return false;
+    }
+    std::array<uint8_t, REQUEST_HEADER + Obd2Scheduler::MAX_PIDS_PER_REQUEST> message{};
+    message[0] = SERVICE_CURRENT_DATA;
+    std::copy(pids.begin(), pids.end(), message.begin() + REQUEST_HEADER);
+    return IsoTpReceiver::singleFrame({message.data(), pids.size() + REQUEST_HEADER}, payload);
+}
+
+bool Obd2Protocol::parseResponse(std::span<const uint8_t> message,
+                                 std::vector<Obd2PidData>& pids) {
+    pids.clear();
+    if (message.empty() || message[0] != SERVICE_CURRENT_DATA + POSITIVE_RESPONSE_OFFSET) {
+        return false;
+    }
+
+    size_t offset = 1;
+    while (offset < message.size()) {
+        const uint8_t pid = message[offset];
+        const int length = pidDataLength(pid);
+        if (length < 0 || offset + 1 + static_cast<size_t>(length) > message.size()) {
+            break;  // Unknown PID or truncated: the rest cannot be split
+        }
+        Obd2PidData& entry = pids.emplace_back();
+        entry.pid = pid;
+        entry.length = static_cast<uint8_t>(length);
+        std::copy_n(message.begin() + static_cast<std::ptrdiff_t>(offset + 1), length,
+                    entry.data.begin());
+        offset += 1 + static_cast<size_t>(length);
+    }
+    return true;
+}
+
+bool Obd2Protocol::isNegativeResponse(std::span<const uint8_t> message) {
+    return message.size() >= 2 && message[0] == NEGATIVE_RESPONSE &&
+           message[1] == SERVICE_CURRENT_DATA;
+}
+
+//=============================================================================
+// Value Scaling
+//=============================================================================
+
+double Obd2Protocol::decodeValue(const Obd2PidDefinition& definition, const Obd2PidData& data) {
+    uint32_t raw = 0;
+    for (int i = 0; i < definition.valueBytes; ++i) {
+        raw = (raw << 8) | data.data[static_cast<size_t>(i)];
+    }
+    return static_cast<double>(raw) * definition.scale + definition.offset;
+}
+
+Obd2PidData Obd2Protocol::encodeValue(const Obd2PidDefinition& definition, double value) {
+    const double maxRaw = std::ldexp(1.0, 8 * definition.valueBytes) - 1.0;
+    const double raw =
+        std::clamp(std::round((value - definition.offset) / definition.scale), 0.0, maxRaw);
+    auto bits = static_cast<uint32_t>(raw);
+
+    Obd2PidData data;
+    data.pid = definition.pid;
+    data.length = static_cast<uint8_t>(definition.dataBytes);
+    for (int i = definition.valueBytes - 1; i >= 0; --i) {
+        data.data[static_cast<size_t>(i)] = static_cast<uint8_t>(bits);
+        bits >>= 8;
+    }
+    return data;
+}
+
+std::vector<std::pair<QString, ChannelValue>>
+Obd2Protocol::channelValues(std::span<const Obd2PidData> pids) {
+    std::vector<std::pair<QString, ChannelValue>> results;
+    results.reserve(pids.size());
+    for (const Obd2PidData& data : pids) {
+        const Obd2PidDefinition* pidDefinition = definition(data.pid);
+        if (pidDefinition == nullptr) {
+            continue;
+        }
+        results.emplace_back(QString::fromUtf8(pidDefinition->channel),
+                             ChannelValue{decodeValue(*pidDefinition, data),
+                                          QString::fromUtf8(pidDefinition->unit), true});
+    }
+    return results;
+}
+
+//=============================================================================
+// IFrameDecoder Interface
+//=============================================================================
+
+std::vector<FrameKey> Obd2Protocol::claimedFrames() const {
+    std::vector<FrameKey> frames;
+    frames.reserve(ECU_COUNT);
+    for (uint32_t ecu = 0; ecu < ECU_COUNT; ++ecu) {
+        frames.push_back({FIRST_RESPONSE_ID + ecu, false});
+    }
+    return frames;
+}
+
+std::vector<std::pair<QString, ChannelValue>>
+Obd2Protocol::decode(const QCanBusFrame& frame) const {
+    const QByteArray payload = frame.payload();
+    const auto* data = reinterpret_cast<const uint8_t*>(payload.constData());
+    IsoTpReceiver receiver;
+    if (receiver.feed({data, static_cast<size_t>(payload.size())}) !=
+        IsoTpReceiver::Result::Complete) {
+        return {};
+    }
+    std::vector<Obd2PidData> pids;
+    if (!parseResponse(receiver.message(), pids)) {
+        return {};
+    }
+    return channelValues(pids);
+}
+
+QStringList Obd2Protocol::frameChannels(const FrameKey& /*key*/) const {
+    // Any ECU may answer with any PID
+    QStringList channels;
+    for (const auto& definition : PID_DEFINITIONS) {
+        channels.append(QString::fromUtf8(definition.channel));
+    }
+    return channels;
+}
+
+} // namespace devdash
@@ -0,0 +1,193 @@
+#pragma once
+
+#include "can/IFrameDecoder.h"
+
+#include <QString>
+#include <QStringList>
+
+#include <array>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace devdash {
+
+/**
+ * @brief How often a PID is polled by default
+ *
+ * Mapped to a rate in Hz by Obd2Protocol::priorityRateHz().
+ */
+enum class Obd2Priority : uint8_t {
+    High,    ///< Needles that move with the engine: RPM, speed, throttle
+    Medium,  ///< Load-related values: manifold pressure, airflow, lambda
+    Low      ///< Slow values: temperatures, fuel level, voltage
+};
+
+/**
+ * @brief One SAE J1979 service 01 PID and how to scale it
+ *
+ * value = (big-endian unsigned of the first valueBytes data bytes) * scale + offset
+ */
+struct Obd2PidDefinition {
+    uint8_t pid;
+    const char* channel;    ///< Channel name (Haltech names where the meaning matches)
+    int dataBytes;          ///< Data bytes following the PID in a response
+    int valueBytes;         ///< Leading data bytes forming the value
+    double scale;
+    double offset;
+    const char* unit;
+    Obd2Priority priority;  ///< Default poll priority
+};
+
+/**
+ * @brief The value bytes of one PID in a service 01 response
+ */
+struct Obd2PidData {
+    /// Largest PID data length (supported-PID bitmaps, O2 sensors)
+    static constexpr int MAX_DATA = 4;
+
+    uint8_t pid = 0;
+    std::array<uint8_t, MAX_DATA> data{};
+    uint8_t length = 0;
+};
+
+/**
+ * @brief OBD-II over CAN (ISO 15765-4): PID table, request and response encoding
+ *
+ * Knows the service 01 ("show current data") PIDs devdash displays, builds
+ * request payloads and parses responses - including multi-PID responses,
+ * where several PID/data pairs follow one service byte. Channel names match
+ * the Haltech channels where the meaning is the same ("RPM", "Coolant
+ * Temperature", ...), so a profile's channelMappings work with either ECU.
+ *
+ * As an IFrameDecoder it claims the eight ECU response IDs (0x7E8-0x7EF),
+ * which gives Obd2Adapter kernel receive filters and bus monitoring for
+ * free. decode() handles single-frame responses only; Obd2Adapter takes
+ * the response frames before the router to reassemble segmented
+ * responses and match them to its requests.
+ *
+ * | PID  | Channel             | Formula            | Unit | Priority |
+ * |------|---------------------|--------------------|------|----------|
+ * | 0x04 | Engine Load         | A * 100 / 255      | %    | Medium   |
+ * | 0x05 | Coolant Temperature | A - 40             | °C   | Low      |
+ * | 0x0A | Fuel Pressure       | A * 3              | kPa  | Low      |
+ * | 0x0B | Manifold Pressure   | A                  | kPa  | Medium   |
+ * | 0x0C | RPM                 | (256A + B) / 4     | RPM  | High     |
+ * | 0x0D | Vehicle Speed       | A                  | km/h | High     |
+ * | 0x0E | Ignition Timing     | A / 2 - 64         | °    | Medium   |
+ * | 0x0F | Air Temperature     | A - 40             | °C   | Low      |
+ * | 0x10 | MAF Air Flow        | (256A + B) / 100   | g/s  | Medium   |
+ * | 0x11 | Throttle Position   | A * 100 / 255      | %    | High     |
+ * | 0x24 | Wideband Lambda 1   | (256A + B) / 32768 | λ    | Medium   |
+ * | 0x2F | Fuel Level          | A * 100 / 255      | %    | Low      |
+ * | 0x33 | Barometric Pressure | A                  | kPa  | Low      |
+ * | 0x42 | Battery Voltage     | (256A + B) / 1000  | V    | Low      |
+ * | 0x46 | Ambient Temperature | A - 40             | °C   | Low      |
+ * | 0x5C | Oil Temperature     | A - 40             | °C   | Low      |
+ */
+class Obd2Protocol : public IFrameDecoder {
+  public:
+    /// Service 01: show current data
+    static constexpr uint8_t SERVICE_CURRENT_DATA = 0x01;
+
+    /// Added to the service in a positive response (0x41)
+    static constexpr uint8_t POSITIVE_RESPONSE_OFFSET = 0x40;
+
+    /// Service byte of a negative response: 0x7F, service, response code
+    static constexpr uint8_t NEGATIVE_RESPONSE = 0x7F;
+
+    /// Functional (broadcast) request ID: every emissions ECU answers
+    static constexpr uint32_t FUNCTIONAL_REQUEST_ID = 0x7DF;
+
+    /// Physical request ID of ECU #1 (engine); ECU n is at FIRST_REQUEST_ID + n
+    static constexpr uint32_t FIRST_REQUEST_ID = 0x7E0;
+
+    /// Response ID of ECU #1; each ECU answers at its request ID + RESPONSE_ID_OFFSET
+    static constexpr uint32_t FIRST_RESPONSE_ID = 0x7E8;
+    static constexpr uint32_t RESPONSE_ID_OFFSET = 8;
+
+    /// ECUs addressable with 11-bit IDs
+    static constexpr int ECU_COUNT = 8;
+
+    /**
+     * @brief Every PID devdash knows, ordered by PID
+     */
+    [[nodiscard]] static std::span<const Obd2PidDefinition> definitions();
+
+    /**
+     * @brief Look up a PID
+     * @return The definition, or nullptr for PIDs not in the table
+     */
+    [[nodiscard]] static const Obd2PidDefinition* definition(uint8_t pid);
+
+    /**
+     * @brief Look up the PID carrying a channel
+     * @return The definition, or nullptr if no PID has that channel name
+     */
+    [[nodiscard]] static const Obd2PidDefinition* definitionForChannel(const QString& channel);
+
+    /**
+     * @brief Parse a priority name ("high", "medium", "low")
+     * @return false for unknown names
+     */
+    [[nodiscard]] static bool parsePriority(const QString& name, Obd2Priority& priority);
+
+    /**
+     * @brief Default poll rate of a priority in Hz (20, 5 and 1)
+     */
+    [[nodiscard]] static double priorityRateHz(Obd2Priority priority);
+
+    /**
+     * @brief Build the service 01 request for @p pids (1-6), padded to 8 bytes
+     * @return false if the PID count is out of range
+     */
+    [[nodiscard]] static bool encodeRequest(std::span<const uint8_t> pids,
+                                            std::array<uint8_t, 8>& payload);
+
+    /**
+     * @brief Parse a reassembled service 01 positive response
+     *
+     * PIDs are read in order; parsing stops at a PID whose length is not
+     * known (not in the table and not a supported-PID bitmap), since the
+     * rest of the message cannot be split without it.
+     *
+     * @param message Response without ISO-TP framing, starting with 0x41
+     * @param pids Receives the PIDs and their data bytes (cleared first)
+     * @return false if the message is not a service 01 positive response
+     */
+    static bool parseResponse(std::span<const uint8_t> message, std::vector<Obd2PidData>& pids);
+
+    /**
+     * @brief Check whether @p message is a negative response to service 01
+     */
+    [[nodiscard]] static bool isNegativeResponse(std::span<const uint8_t> message);
+
+    /**
+     * @brief Scale a PID's data bytes to its engineering value
+     */
+    [[nodiscard]] static double decodeValue(const Obd2PidDefinition& definition,
+                                            const Obd2PidData& data);
+
+    /**
+     * @brief Inverse of decodeValue(): the data bytes an ECU sends for @p value
+     *
+     * The raw value is rounded and clamped to the field; trailing data
+     * bytes beyond valueBytes are zero.
+     */
+    [[nodiscard]] static Obd2PidData encodeValue(const Obd2PidDefinition& definition,
+                                                 double value);
+
+    /**
+     * @brief Channel values of a parsed response (PIDs not in the table are skipped)
+     */
+    [[nodiscard]] static std::vector<std::pair<QString, ChannelValue>>
+    channelValues(std::span<const Obd2PidData> pids);
+
+    // IFrameDecoder interface
+    [[nodiscard]] std::vector<FrameKey> claimedFrames() const override;
+    [[nodiscard]] std::vector<std::pair<QString, ChannelValue>>
+    decode(const QCanBusFrame& frame) const override;
+    [[nodiscard]] QStringList frameChannels(const FrameKey& key) const override;
+};
+
+} // namespace devdash
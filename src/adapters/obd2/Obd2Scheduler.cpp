@@ -0,0 +1,360 @@
+/**
+ * @file Obd2Scheduler.cpp
+ * @brief Implementation of the OBD-II PID poll scheduler.
+ */
+
+#include "Obd2Scheduler.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace devdash {
+
+namespace {
+
+//=============================================================================
+// Supported-PID Bitmaps
+//=============================================================================
+
+/// PIDs 0x00, 0x20, ... 0xE0 each list the support of the 32 PIDs after them
+constexpr int SUPPORTED_PIDS_STRIDE = 0x20;
+constexpr int LAST_SUPPORTED_PIDS_PID = 0xE0;
+
+/// Bit 0 of a bitmap: the next bitmap PID is supported
+constexpr uint32_t NEXT_BITMAP_BIT = 1U;
+constexpr int BITMAP_TOP_BIT = 31;
+
+constexpr double US_PER_SECOND = 1e6;
+
+} // anonymous namespace
+
+//=============================================================================
+// Configuration
+//=============================================================================
+
+void Obd2Scheduler::setOptions(const Options& options) {
+    m_options = options;
+    m_options.maxInFlight = std::clamp(options.maxInFlight, 1, MAX_IN_FLIGHT);
+    m_options.maxPidsPerRequest = std::clamp(options.maxPidsPerRequest, 1, MAX_PIDS_PER_REQUEST);
+    m_options.timeoutUs = std::max<int64_t>(options.timeoutUs, 1);
+}
+
+void Obd2Scheduler::addPid(uint8_t pid, double rateHz) {
+    if (isSupportedPidsPid(pid) || rateHz <= 0.0) {
+        return;
+    }
+    Entry* entry = find(pid);
+    if (entry == nullptr) {
+        entry = &m_entries.emplace_back();
+        entry->pid = pid;
+    }
+    entry->targetHz = rateHz;
+    entry->intervalUs = std::max<int64_t>(std::llround(US_PER_SECOND / rateHz), 1);
+}
+
+void Obd2Scheduler::clear() {
+    m_entries.clear();
+    m_inFlight.clear();
+}
+
+void Obd2Scheduler::start(int64_t nowUs) {
+    m_maxInFlight = m_options.maxInFlight;
+    m_maxPidsPerRequest = m_options.maxPidsPerRequest;
+    m_multiPidConfirmed = false;
+    m_multiPidFailures = 0;
+    m_consecutiveTimeouts = 0;
+    m_inFlight.clear();
+    m_inFlight.reserve(MAX_IN_FLIGHT);
+    m_candidates.reserve(m_entries.size());
+    for (Entry& entry : m_entries) {
+        entry.dueUs = nowUs;
+        entry.inFlight = false;
+        entry.supported = true;
+        entry.responses = 0;
+        entry.windowResponses = 0;
+        entry.timeouts = 0;
+        entry.measuredHz = 0.0;
+    }
+    m_stats = Stats{};
+    m_windowStartUs = nowUs;
+    m_windowRequests = 0;
+    m_windowResponses = 0;
+    m_answeredRequests = 0;
+    m_discoveryPid = m_options.detectSupportedPids && !m_entries.empty() ? 0 : -1;
+}
+
+//=============================================================================
+// Scheduling
+//=============================================================================
+
+int Obd2Scheduler::expire(int64_t nowUs) {
+    int expired = 0;
+    for (size_t i = 0; i < m_inFlight.size();) {
+        if (nowUs - m_inFlight[i].sentUs < m_options.timeoutUs) {
+            ++i;
+            continue;
+        }
+        ++m_stats.timeouts;
+        ++expired;
+        failRequest(i, false);
+    }
+    return expired;
+}
+
+bool Obd2Scheduler::nextRequest(int64_t nowUs, Request& request) {
+    if (static_cast<int>(m_inFlight.size()) >= m_maxInFlight) {
+        return false;
+    }
+
+    request = Request{};
+    request.sentUs = nowUs;
+    if (isDiscovering()) {
+        // One bitmap at a time: the answer decides whether there is a next one
+        if (!m_inFlight.empty()) {
+            return false;
+        }
+        request.pids[0] = static_cast<uint8_t>(m_discoveryPid);
+        request.count = 1;
+    } else {
+        m_candidates.clear();
+        for (size_t i = 0; i < m_entries.size(); ++i) {
+            const Entry& entry = m_entries[i];
+            if (entry.supported && !entry.inFlight && entry.dueUs <= nowUs) {
+                m_candidates.push_back(i);
+            }
+        }
+        if (m_candidates.empty()) {
+            return false;
+        }
+
+        // Furthest behind first, measured in intervals so rates stay proportional
+        const auto lateness = [this, nowUs](size_t index) {
+            const Entry& entry = m_entries[index];
+            return static_cast<double>(nowUs - entry.dueUs) /
+                   static_cast<double>(entry.intervalUs);
+        };
+        const size_t count =
+            std::min(m_candidates.size(), static_cast<size_t>(m_maxPidsPerRequest));
+        std::partial_sort(m_candidates.begin(),
+                          m_candidates.begin() + static_cast<std::ptrdiff_t>(count),
+                          m_candidates.end(), [&lateness](size_t lhs, size_t rhs) {
+                              return lateness(lhs) > lateness(rhs);
+                          });
+
+        for (size_t i = 0; i < count; ++i) {
+            Entry& entry = m_entries[m_candidates[i]];
+            entry.inFlight = true;
+            entry.dueUs = nowUs + entry.intervalUs;
+            request.pids[i] = entry.pid;
+        }
+        request.count = static_cast<int>(count);
+    }
+
+    m_inFlight.push_back(request);
+    ++m_stats.requests;
+    ++m_windowRequests;
+    return true;
+}
+
+void Obd2Scheduler::cancel(const Request& request) {
+    const auto it =
+        std::find_if(m_inFlight.begin(), m_inFlight.end(), [&request](const Request& candidate) {
+            return candidate.sentUs == request.sentUs && candidate.count == request.count &&
+                   candidate.pids == request.pids;
+        });
+    if (it == m_inFlight.end()) {
+        return;
+    }
+    m_inFlight.erase(it);
+    for (const uint8_t pid : request.pidList()) {
+        if (Entry* entry = find(pid)) {
+            entry->inFlight = false;
+            entry->dueUs = request.sentUs;
+        }
+    }
+    --m_stats.requests;
+    --m_windowRequests;
+}
+
+bool Obd2Scheduler::onResponse(std::span<const uint8_t> pids, int64_t /*nowUs*/) {
+    if (pids.empty()) {
+        return false;
+    }
+    const auto request =
+        std::find_if(m_inFlight.begin(), m_inFlight.end(), [&pids](const Request& candidate) {
+            const auto asked = candidate.pidList();
+            return std::find(asked.begin(), asked.end(), pids.front()) != asked.end();
+        });
+    if (request == m_inFlight.end()) {
+        ++m_stats.unexpectedResponses;
+        return false;
+    }
+
+    for (const uint8_t pid : request->pidList()) {
+        if (Entry* entry = find(pid)) {
+            entry->inFlight = false;
+        }
+    }
+    for (const uint8_t pid : pids) {
+        if (Entry* entry = find(pid)) {
+            ++entry->responses;
+            ++entry->windowResponses;
+            ++m_stats.responses;
+            ++m_windowResponses;
+        }
+    }
+    if (request->count > 1) {
+        m_multiPidConfirmed = true;
+        m_multiPidFailures = 0;
+    }
+    m_inFlight.erase(request);
+    m_consecutiveTimeouts = 0;
+    ++m_answeredRequests;
+    return true;
+}
+
+void Obd2Scheduler::onSupportedPids(uint8_t basePid, uint32_t bitmap) {
+    for (Entry& entry : m_entries) {
+        const int offset = entry.pid - basePid;
+        if (offset >= 1 && offset <= SUPPORTED_PIDS_STRIDE) {
+            entry.supported = ((bitmap >> (BITMAP_TOP_BIT - (offset - 1))) & 1U) != 0;
+        }
+    }
+    if (!isDiscovering() || basePid != m_discoveryPid) {
+        return;
+    }
+
+    const int nextBase = basePid + SUPPORTED_PIDS_STRIDE;
+    const bool wanted =
+        std::any_of(m_entries.begin(), m_entries.end(),
+                    [nextBase](const Entry& entry) { return entry.pid > nextBase; });
+    if ((bitmap & NEXT_BITMAP_BIT) != 0 && wanted && nextBase <= LAST_SUPPORTED_PIDS_PID) {
+        m_discoveryPid = nextBase;
+        return;
+    }
+    // No further bitmap: PIDs beyond the last one read are unsupported
+    for (Entry& entry : m_entries) {
+        if (entry.pid > nextBase) {
+            entry.supported = false;
+        }
+    }
+    finishDiscovery();
+}
+
+void Obd2Scheduler::onNegativeResponse(int64_t /*nowUs*/) {
+    if (m_inFlight.empty()) {
+        ++m_stats.unexpectedResponses;
+        return;
+    }
+    ++m_stats.negativeResponses;
+    failRequest(0, true);
+}
+
+int64_t Obd2Scheduler::nextEventUs() const {
+    int64_t next = NO_EVENT;
+    for (const Request& request : m_inFlight) {
+        next = std::min(next, request.sentUs + m_options.timeoutUs);
+    }
+    if (static_cast<int>(m_inFlight.size()) >= m_maxInFlight) {
+        return next;
+    }
+    if (isDiscovering()) {
+        return next;  // The next bitmap is requested when the previous one arrives
+    }
+    for (const Entry& entry : m_entries) {
+        if (entry.supported && !entry.inFlight) {
+            next = std::min(next, entry.dueUs);
+        }
+    }
+    return next;
+}
+
+//=============================================================================
+// Statistics
+//=============================================================================
+
+void Obd2Scheduler::closeWindow(int64_t nowUs) {
+    const double seconds = static_cast<double>(nowUs - m_windowStartUs) / US_PER_SECOND;
+    if (seconds <= 0.0) {
+        return;
+    }
+    for (Entry& entry : m_entries) {
+        entry.measuredHz = static_cast<double>(entry.windowResponses) / seconds;
+        entry.windowResponses = 0;
+    }
+    m_stats.pidsPerSecond = static_cast<double>(m_windowResponses) / seconds;
+    m_stats.requestsPerSecond = static_cast<double>(m_windowRequests) / seconds;
+    m_stats.pidsPerRequest = m_answeredRequests > 0 ? static_cast<double>(m_stats.responses) /
+                                                          static_cast<double>(m_answeredRequests)
+                                                    : 0.0;
+    m_windowStartUs = nowUs;
+    m_windowRequests = 0;
+    m_windowResponses = 0;
+}
+
+std::vector<Obd2Scheduler::PidStats> Obd2Scheduler::pidStats() const {
+    std::vector<PidStats> result;
+    result.reserve(m_entries.size());
+    for (const Entry& entry : m_entries) {
+        result.push_back({entry.pid, entry.targetHz, entry.measuredHz, entry.responses,
+                          entry.timeouts, entry.supported});
+    }
+    return result;
+}
+
+int Obd2Scheduler::pollablePids() const {
+    return static_cast<int>(std::count_if(m_entries.begin(), m_entries.end(),
+                                          [](const Entry& entry) { return entry.supported; }));
+}
+
+bool Obd2Scheduler::isSupportedPidsPid(uint8_t pid) {
+    return pid % SUPPORTED_PIDS_STRIDE == 0;
+}
+
+//=============================================================================
+// Private Methods
+//=============================================================================
+
+Obd2Scheduler::Entry* Obd2Scheduler::find(uint8_t pid) {
+    const auto it = std::find_if(m_entries.begin(), m_entries.end(),
+                                 [pid](const Entry& entry) { return entry.pid == pid; });
+    return it != m_entries.end() ? &*it : nullptr;
+}
+
+void Obd2Scheduler::finishDiscovery() {
+    m_discoveryPid = -1;
+}
+
+void Obd2Scheduler::failRequest(size_t index, bool rejected) {
+    const Request request = m_inFlight[index];
+    m_inFlight.erase(m_inFlight.begin() + static_cast<std::ptrdiff_t>(index));
+
+    if (isDiscovering() && request.count == 1 &&
+        request.pids[0] == static_cast<uint8_t>(m_discoveryPid)) {
+        // ECU without bitmaps (or not answering yet): poll everything configured
+        finishDiscovery();
+        return;
+    }
+
+    for (const uint8_t pid : request.pidList()) {
+        if (Entry* entry = find(pid)) {
+            entry->inFlight = false;
+            ++entry->timeouts;
+        }
+    }
+
+    if (request.count > 1 && !m_multiPidConfirmed) {
+        // An ECU that rejects multi-PID requests says so; one that ignores them times out
+        ++m_multiPidFailures;
+        if (rejected || m_multiPidFailures >= FALLBACK_FAILURES) {
+            m_maxPidsPerRequest = 1;
+        }
+    }
+    if (!rejected && ++m_consecutiveTimeouts >= FALLBACK_FAILURES && m_maxInFlight > 1) {
+        // Probably dropping requests that arrive while it is busy
+        m_maxInFlight = std::max(m_maxInFlight / 2, 1);
+        m_consecutiveTimeouts = 0;
+    }
+}
+
+} // namespace devdash
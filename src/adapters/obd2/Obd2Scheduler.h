@@ -0,0 +1,264 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <vector>
+
+namespace devdash {
+
+/**
+ * @brief Decides which OBD-II PIDs to request next, and when
+ *
+ * An OBD-II ECU only answers what it is asked, one request at a time, so
+ * the poll schedule decides how fresh every gauge is. The scheduler:
+ *
+ * - Polls every PID at its own target rate (display priority: RPM fast,
+ *   coolant slow). A PID becomes due one interval after it was last
+ *   requested; when the ECU cannot keep up, the PIDs furthest behind
+ *   (in intervals) go first, so achieved rates stay proportional to the
+ *   targets instead of starving the slow PIDs or the fast ones.
+ * - Keeps up to maxInFlight requests outstanding, so the ECU can start on
+ *   the next request while the previous answer is still on the bus.
+ * - Packs up to maxPidsPerRequest due PIDs into one service 01 request
+ *   (SAE J1979 allows six). PIDs that are not due are never added, so
+ *   packing does not distort the rates.
+ * - Learns what the ECU allows: before polling it reads the supported-PID
+ *   bitmaps (PIDs 0x00, 0x20, ...) and drops unsupported PIDs; multi-PID
+ *   requests that are rejected or time out repeatedly fall back to one PID
+ *   per request, and repeated timeouts reduce the requests in flight.
+ * - Measures achieved PIDs per second, overall and per PID.
+ *
+ * Time is passed in by the caller (microseconds, any monotonic clock), so
+ * the schedule is deterministic under test. Deliberately free of Qt and
+ * of CAN I/O; Obd2Adapter sends the requests and reports the responses.
+ *
+ * @code
+ * Obd2Scheduler scheduler;
+ * scheduler.addPid(0x0C, 20.0);  // RPM
+ * scheduler.addPid(0x05, 1.0);   // coolant
+ * scheduler.start(now);
+ *
+ * Obd2Scheduler::Request request;
+ * scheduler.expire(now);
+ * while (scheduler.nextRequest(now, request)) {
+ *     send(request);
+ * }
+ * // wake up again at scheduler.nextEventUs()
+ * @endcode
+ *
+ * @note Not thread-safe; owned and used by the adapter's receive path.
+ */
+class Obd2Scheduler {
+  public:
+    /// PIDs one service 01 request may carry (SAE J1979)
+    static constexpr int MAX_PIDS_PER_REQUEST = 6;
+
+    /// Largest number of requests kept in flight
+    static constexpr int MAX_IN_FLIGHT = 16;
+
+    /// Returned by nextEventUs() when nothing is scheduled
+    static constexpr int64_t NO_EVENT = std::numeric_limits<int64_t>::max();
+
+    /// Consecutive failures before the scheduler backs off (packing, pipelining)
+    static constexpr int FALLBACK_FAILURES = 3;
+
+    /**
+     * @brief Scheduling limits
+     */
+    struct Options {
+        int maxInFlight = 2;                           ///< Requests outstanding at once (1-16)
+        int maxPidsPerRequest = MAX_PIDS_PER_REQUEST;  ///< PIDs packed per request (1-6)
+        int64_t timeoutUs = 100000;                    ///< Request considered lost after this
+        bool detectSupportedPids = true;               ///< Read the supported-PID bitmaps first
+    };
+
+    /**
+     * @brief One service 01 request
+     */
+    struct Request {
+        std::array<uint8_t, MAX_PIDS_PER_REQUEST> pids{};
+        int count = 0;       ///< PIDs used in pids
+        int64_t sentUs = 0;  ///< Time the request was handed out
+
+        [[nodiscard]] std::span<const uint8_t> pidList() const {
+            return {pids.data(), static_cast<size_t>(count)};
+        }
+    };
+
+    /**
+     * @brief Poll statistics of one PID
+     */
+    struct PidStats {
+        uint8_t pid = 0;
+        double targetHz = 0.0;    ///< Configured rate
+        double measuredHz = 0.0;  ///< Responses per second in the last window
+        uint64_t responses = 0;   ///< Values received
+        uint64_t timeouts = 0;    ///< Requests for it that went unanswered
+        bool supported = true;    ///< False if the ECU's bitmap excludes it
+    };
+
+    /**
+     * @brief Overall poll statistics of the last window
+     */
+    struct Stats {
+        double pidsPerSecond = 0.0;      ///< PID values received per second
+        double requestsPerSecond = 0.0;  ///< Requests sent per second
+        double pidsPerRequest = 0.0;     ///< Average PIDs per answered request
+        uint64_t requests = 0;           ///< Requests sent in total
+        uint64_t responses = 0;          ///< PID values received in total
+        uint64_t timeouts = 0;           ///< Requests that went unanswered
+        uint64_t negativeResponses = 0;  ///< Requests the ECU rejected
+        uint64_t unexpectedResponses = 0; ///< Responses matching no request in flight
+    };
+
+    Obd2Scheduler() = default;
+
+    /**
+     * @brief Set the limits (takes effect at the next start())
+     */
+    void setOptions(const Options& options);
+
+    [[nodiscard]] const Options& options() const { return m_options; }
+
+    /**
+     * @brief Poll @p pid at @p rateHz (replaces an earlier rate for the PID)
+     *
+     * Supported-PID bitmap PIDs (0x00, 0x20, ...) are not polled.
+     */
+    void addPid(uint8_t pid, double rateHz);
+
+    /**
+     * @brief Forget all PIDs
+     */
+    void clear();
+
+    /**
+     * @brief Start a poll session: every PID is due now
+     *
+     * Resets the learned limits and counters; with detectSupportedPids the
+     * first requests read the supported-PID bitmaps.
+     */
+    void start(int64_t nowUs);
+
+    /**
+     * @brief Time out requests older than Options::timeoutUs
+     * @return Number of requests that timed out
+     */
+    int expire(int64_t nowUs);
+
+    /**
+     * @brief Get the next request to send, if a slot is free and a PID is due
+     *
+     * The request is in flight from now on; report its answer with
+     * onResponse() or let it time out.
+     */
+    [[nodiscard]] bool nextRequest(int64_t nowUs, Request& request);
+
+    /**
+     * @brief Take back a request from nextRequest() that could not be sent
+     *
+     * Its PIDs are due again immediately; nothing counts against the ECU.
+     */
+    void cancel(const Request& request);
+
+    /**
+     * @brief Report the PIDs of a positive response
+     *
+     * Completes the request in flight that asked for them. PIDs the request
+     * asked for but the response left out become due again as usual.
+     *
+     * @return false if no request in flight asked for these PIDs
+     */
+    bool onResponse(std::span<const uint8_t> pids, int64_t nowUs);
+
+    /**
+     * @brief Report a supported-PID bitmap (response to PID 0x00, 0x20, ...)
+     *
+     * @param basePid The bitmap PID
+     * @param bitmap Bit 31 = basePid + 1 ... bit 0 = basePid + 32
+     */
+    void onSupportedPids(uint8_t basePid, uint32_t bitmap);
+
+    /**
+     * @brief Report a negative response: the oldest request in flight failed
+     */
+    void onNegativeResponse(int64_t nowUs);
+
+    /**
+     * @brief Earliest time something needs doing: a PID falling due or a timeout
+     * @return NO_EVENT when nothing is scheduled
+     */
+    [[nodiscard]] int64_t nextEventUs() const;
+
+    /**
+     * @brief Close the measurement window: compute rates since the last call
+     */
+    void closeWindow(int64_t nowUs);
+
+    [[nodiscard]] const Stats& stats() const { return m_stats; }
+
+    /**
+     * @brief Statistics of every configured PID, in the order they were added
+     */
+    [[nodiscard]] std::vector<PidStats> pidStats() const;
+
+    /** @brief Check whether the supported-PID bitmaps are still being read */
+    [[nodiscard]] bool isDiscovering() const { return m_discoveryPid >= 0; }
+
+    /** @brief Requests currently in flight */
+    [[nodiscard]] int inFlight() const { return static_cast<int>(m_inFlight.size()); }
+
+    /** @brief Requests kept in flight now (reduced after repeated timeouts) */
+    [[nodiscard]] int maxInFlight() const { return m_maxInFlight; }
+
+    /** @brief PIDs packed per request now (1 once the ECU rejected multi-PID requests) */
+    [[nodiscard]] int maxPidsPerRequest() const { return m_maxPidsPerRequest; }
+
+    /** @brief Configured PIDs the ECU supports (all of them without detection) */
+    [[nodiscard]] int pollablePids() const;
+
+    /**
+     * @brief Check whether @p pid is a supported-PID bitmap (0x00, 0x20, ...)
+     */
+    [[nodiscard]] static bool isSupportedPidsPid(uint8_t pid);
+
+  private:
+    struct Entry {
+        uint8_t pid = 0;
+        double targetHz = 0.0;
+        int64_t intervalUs = 0;
+        int64_t dueUs = 0;
+        bool inFlight = false;
+        bool supported = true;
+        uint64_t responses = 0;
+        uint64_t windowResponses = 0;
+        uint64_t timeouts = 0;
+        double measuredHz = 0.0;
+    };
+
+    [[nodiscard]] Entry* find(uint8_t pid);
+    void finishDiscovery();
+    void failRequest(size_t index, bool rejected);
+
+    Options m_options;
+    std::vector<Entry> m_entries;
+    std::vector<Request> m_inFlight;
+    std::vector<size_t> m_candidates;  ///< Scratch for nextRequest(), reused
+
+    int m_maxInFlight{2};
+    int m_maxPidsPerRequest{MAX_PIDS_PER_REQUEST};
+    int m_discoveryPid{-1};             ///< Bitmap PID to read next, -1 = polling
+    bool m_multiPidConfirmed{false};    ///< The ECU answered a multi-PID request
+    int m_multiPidFailures{0};
+    int m_consecutiveTimeouts{0};
+
+    Stats m_stats;
+    int64_t m_windowStartUs{0};
+    uint64_t m_windowRequests{0};
+    uint64_t m_windowResponses{0};
+    uint64_t m_answeredRequests{0};
+};
+
+} // namespace devdash
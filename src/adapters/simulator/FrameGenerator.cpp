@@ -0,0 +1,216 @@
+/**
+ * @file FrameGenerator.cpp
+ * @brief Implementation of scenario-driven frame generation.
+ */
+
+#include "FrameGenerator.h"
+
+#include <QDebug>
+#include <QJsonObject>
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+namespace devdash {
+
+namespace {
+
+//=============================================================================
+// Timing
+//=============================================================================
+
+constexpr double NS_PER_SECOND = 1e9;
+constexpr int64_t NS_PER_MS = 1000000;
+
+/// Reported as source name and adapter backend
+constexpr const char* SOURCE_NAME = "simulator";
+
+/**
+ * @brief Rate a frame is sent at before scaling to Options::frameRate
+ */
+double declaredRateHz(const HaltechFrameEncoder& encoder) {
+    return encoder.rateHz() > 0 ? encoder.rateHz() : FrameGenerator::DEFAULT_FRAME_RATE_HZ;
+}
+
+} // anonymous namespace
+
+//=============================================================================
+// Construction / Destruction
+//=============================================================================
+
+FrameGenerator::FrameGenerator(std::vector<HaltechFrameEncoder> encoders, QObject* parent)
+    : ICanFrameSource(parent) {
+    m_schedule.reserve(encoders.size());
+    for (auto& encoder : encoders) {
+        m_schedule.push_back({std::move(encoder), 0, 0});
+    }
+
+    // Parented so it follows the generator when it is moved to an I/O thread
+    m_timer.setParent(this);
+    m_timer.setSingleShot(true);
+    m_timer.setTimerType(Qt::PreciseTimer);
+    connect(&m_timer, &QTimer::timeout, this, &FrameGenerator::onGenerateTimeout);
+}
+
+FrameGenerator::~FrameGenerator() {
+    stop();
+}
+
+//=============================================================================
+// Generator Control
+//=============================================================================
+
+bool FrameGenerator::open() {
+    stop();
+    m_errorString.clear();
+    m_framesDelivered = 0;
+    m_framesSkipped = 0;
+    m_elapsedBeforeStartNs = 0;
+
+    m_scenario = SimulationScenario::fromName(m_options.scenario);
+    if (!m_scenario) {
+        m_errorString = "Unknown scenario \"" + m_options.scenario + "\" - expected one of " +
+                        SimulationScenario::names().join(", ");
+        return false;
+    }
+    if (m_schedule.empty()) {
+        m_errorString = QStringLiteral("No frame definitions to generate");
+        return false;
+    }
+
+    double declaredRate = 0.0;
+    for (const auto& frame : m_schedule) {
+        declaredRate += declaredRateHz(frame.encoder);
+    }
+    double scale = 1.0;
+    if (m_options.frameRate > 0.0) {
+        const double target = std::clamp(m_options.frameRate, MIN_FRAME_RATE, MAX_FRAME_RATE);
+        if (target != m_options.frameRate) {
+            qWarning() << "FrameGenerator: Frame rate" << m_options.frameRate
+                       << "out of range, using" << target;
+        }
+        scale = target / declaredRate;
+    }
+
+    m_frameRate = 0.0;
+    for (auto& frame : m_schedule) {
+        const double rate = declaredRateHz(frame.encoder) * scale;
+        frame.periodNs = std::max<int64_t>(1, std::llround(NS_PER_SECOND / rate));
+        frame.nextDueNs = 0;
+        m_frameRate += NS_PER_SECOND / static_cast<double>(frame.periodNs);
+    }
+    return true;
+}
+
+void FrameGenerator::start() {
+    if (!m_scenario || m_running) {
+        return;
+    }
+    m_running = true;
+    m_clock.start();
+    m_timer.start(0);
+}
+
+void FrameGenerator::stop() {
+    if (m_running) {
+        m_elapsedBeforeStartNs = nowNs();
+    }
+    m_running = false;
+    m_timer.stop();
+}
+
+double FrameGenerator::scenarioSeconds() const {
+    const double seconds = static_cast<double>(nowNs()) / NS_PER_SECOND;
+    if (!m_scenario) {
+        return seconds;
+    }
+    return m_options.loop ? std::fmod(seconds, m_scenario->durationSeconds())
+                          : std::min(seconds, m_scenario->durationSeconds());
+}
+
+//=============================================================================
+// Source Description
+//=============================================================================
+
+QString FrameGenerator::sourceName() const {
+    return QString::fromLatin1(SOURCE_NAME);
+}
+
+QString FrameGenerator::description() const {
+    return "scenario \"" + m_options.scenario + "\" at " + QString::number(m_frameRate) +
+           " frames/s";
+}
+
+QJsonObject FrameGenerator::diagnostics() const {
+    QJsonObject simulator;
+    simulator["scenario"] = m_options.scenario;
+    simulator["scenarioSeconds"] = scenarioSeconds();
+    simulator["frameRate"] = m_frameRate;
+    simulator["frames"] = static_cast<qint64>(m_framesDelivered);
+    simulator["skipped"] = static_cast<qint64>(m_framesSkipped);
+    simulator["running"] = m_running;
+    return simulator;
+}
+
+//=============================================================================
+// Private Slots
+//=============================================================================
+
+void FrameGenerator::onGenerateTimeout() {
+    const int64_t now = nowNs();
+    const VehicleState state =
+        m_scenario->stateAt(static_cast<double>(now) / NS_PER_SECOND, m_options.loop);
+
+    int delivered = 0;
+    while (m_running && delivered < MAX_FRAMES_PER_PASS) {
+        ScheduledFrame& frame = nextFrame();
+        if (frame.nextDueNs > now) {
+            scheduleNextPass(false);
+            return;
+        }
+        if (now - frame.nextDueNs > MAX_LAG_NS) {
+            // Too late to catch up: drop the backlog instead of bursting it out
+            const int64_t missed = (now - frame.nextDueNs) / frame.periodNs;
+            frame.nextDueNs += missed * frame.periodNs;
+            m_framesSkipped += static_cast<uint64_t>(missed);
+        }
+
+        frame.encoder.encode(state, m_frame);
+        m_frame.timestampNs = 0;
+        frame.nextDueNs += frame.periodNs;
+        ++m_framesDelivered;
+        ++delivered;
+        deliver(m_frame);
+    }
+    if (m_running) {
+        scheduleNextPass(true);
+    }
+}
+
+//=============================================================================
+// Private Methods
+//=============================================================================
+
+int64_t FrameGenerator::nowNs() const {
+    return m_running ? m_elapsedBeforeStartNs + m_clock.nsecsElapsed() : m_elapsedBeforeStartNs;
+}
+
+FrameGenerator::ScheduledFrame& FrameGenerator::nextFrame() {
+    return *std::min_element(m_schedule.begin(), m_schedule.end(),
+                             [](const ScheduledFrame& a, const ScheduledFrame& b) {
+                                 return a.nextDueNs < b.nextDueNs;
+                             });
+}
+
+void FrameGenerator::scheduleNextPass(bool yieldOnly) {
+    if (yieldOnly) {
+        m_timer.start(0);
+        return;
+    }
+    // Wait until the next frame is due, rounded up to whole milliseconds
+    const int64_t waitNs = nextFrame().nextDueNs - nowNs();
+    m_timer.start(static_cast<int>(std::max<int64_t>(0, (waitNs + NS_PER_MS - 1) / NS_PER_MS)));
+}
+
+} // namespace devdash
@@ -0,0 +1,166 @@
+#pragma once
+
+#include "HaltechFrameEncoder.h"
+#include "SimulationScenario.h"
+#include "can/ICanFrameSource.h"
+
+#include <QElapsedTimer>
+#include <QString>
+#include <QTimer>
+
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+namespace devdash {
+
+/**
+ * @brief Synthesizes Haltech frames from a simulation scenario at a set rate
+ *
+ * Every frame definition is sent at its declared rate, or, with
+ * Options::frameRate set, at rates scaled so all frames together reach
+ * that many frames per second (MIN_FRAME_RATE to MAX_FRAME_RATE). The
+ * scenario is evaluated once per pass and each due frame is encoded from
+ * that state (HaltechFrameEncoder).
+ *
+ * Like CanLogPlayer, pacing follows a clock rather than sleeping per
+ * frame: each pass delivers every frame that is due, at most
+ * MAX_FRAMES_PER_PASS, and then sleeps until the next one. Rates above
+ * the 1 ms timer resolution are reached by sending several frames per
+ * pass. When a pass runs more than MAX_LAG_NS late (the consumer could
+ * not keep up), the missed frames are counted in framesSkipped() instead
+ * of being sent in a burst.
+ *
+ * @code
+ * FrameGenerator generator(encoders);
+ * FrameGenerator::Options options;
+ * options.scenario = "track";
+ * options.frameRate = 5000;
+ * generator.setOptions(options);
+ * generator.setFrameHandler([](const RawCanFrame& frame) { ... });
+ * if (generator.open()) {
+ *     generator.start();
+ * }
+ * @endcode
+ */
+class FrameGenerator : public ICanFrameSource {
+    Q_OBJECT
+
+  public:
+    /// Supported range of Options::frameRate, in frames per second
+    static constexpr double MIN_FRAME_RATE = 10.0;
+    static constexpr double MAX_FRAME_RATE = 20000.0;
+
+    /// Rate of frames whose definition declares none
+    static constexpr double DEFAULT_FRAME_RATE_HZ = 10.0;
+
+    /// Frames delivered per event loop pass before yielding
+    static constexpr int MAX_FRAMES_PER_PASS = 1024;
+
+    /// Lateness after which missed frames are skipped rather than sent
+    static constexpr int64_t MAX_LAG_NS = 100000000;
+
+    /**
+     * @brief Generator settings
+     */
+    struct Options {
+        QString scenario = QStringLiteral("idle");  ///< SimulationScenario name
+        double frameRate = 0.0;  ///< Total frames per second, 0 = declared rates
+        bool loop = true;        ///< Restart the scenario at its end, else hold the last state
+    };
+
+    explicit FrameGenerator(std::vector<HaltechFrameEncoder> encoders,
+                            QObject* parent = nullptr);
+    ~FrameGenerator() override;
+
+    // QObject-based classes are not copyable or movable
+    FrameGenerator(const FrameGenerator&) = delete;
+    FrameGenerator& operator=(const FrameGenerator&) = delete;
+    FrameGenerator(FrameGenerator&&) = delete;
+    FrameGenerator& operator=(FrameGenerator&&) = delete;
+
+    /**
+     * @brief Set the options used by open()
+     */
+    void setOptions(const Options& options) { m_options = options; }
+
+    [[nodiscard]] const Options& options() const { return m_options; }
+
+    /**
+     * @brief Look up the scenario and compute the frame schedule
+     * @return false for an unknown scenario or without frames, see errorString()
+     */
+    [[nodiscard]] bool open() override;
+
+    /**
+     * @brief Start (or resume) generating from the current scenario time
+     */
+    void start() override;
+
+    /**
+     * @brief Pause generating; start() resumes at the same scenario time
+     */
+    void stop() override;
+
+    [[nodiscard]] bool isRunning() const { return m_running; }
+
+    /** @brief "simulator" */
+    [[nodiscard]] QString sourceName() const override;
+
+    /** @brief Scenario and frame rate */
+    [[nodiscard]] QString description() const override;
+
+    /**
+     * @brief Scenario, scenario time, frame rate, frames sent and skipped
+     */
+    [[nodiscard]] QJsonObject diagnostics() const override;
+
+    [[nodiscard]] uint64_t framesDelivered() const override { return m_framesDelivered; }
+
+    /** @brief Frames dropped from the schedule because a pass ran late */
+    [[nodiscard]] uint64_t framesSkipped() const { return m_framesSkipped; }
+
+    /** @brief Total frames per second of the schedule computed by open() */
+    [[nodiscard]] double frameRate() const { return m_frameRate; }
+
+    /** @brief Time into the scenario, in seconds */
+    [[nodiscard]] double scenarioSeconds() const;
+
+    [[nodiscard]] QString errorString() const override { return m_errorString; }
+
+  private slots:
+    void onGenerateTimeout();
+
+  private:  // NOLINT(readability-redundant-access-specifiers) - Required for MOC
+    /**
+     * @brief One frame of the schedule
+     */
+    struct ScheduledFrame {
+        HaltechFrameEncoder encoder;
+        int64_t periodNs = 0;
+        int64_t nextDueNs = 0;  ///< Generator time the frame is next due
+    };
+
+    /// Generator time now: paused time excluded
+    [[nodiscard]] int64_t nowNs() const;
+    /// Frame due first
+    [[nodiscard]] ScheduledFrame& nextFrame();
+    void scheduleNextPass(bool yieldOnly);
+
+    Options m_options;
+    std::optional<SimulationScenario> m_scenario;
+    std::vector<ScheduledFrame> m_schedule;
+    double m_frameRate{0.0};
+    QString m_errorString;
+
+    QTimer m_timer;
+    QElapsedTimer m_clock;
+    int64_t m_elapsedBeforeStartNs{0};  ///< Generator time when the clock last started
+
+    RawCanFrame m_frame;  ///< Reused for every generated frame
+    bool m_running{false};
+    uint64_t m_framesDelivered{0};
+    uint64_t m_framesSkipped{0};
+};
+
+} // namespace devdash
@@ -0,0 +1,130 @@
+/**
+ * @file HaltechFrameEncoder.cpp
+ * @brief Implementation of Haltech frame encoding for the simulator.
+ */
+
+#include "HaltechFrameEncoder.h"
+
+#include <QDebug>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <utility>
+
+namespace devdash {
+
+namespace {
+
+//=============================================================================
+// Payload Layout
+//=============================================================================
+
+constexpr int BITS_PER_BYTE = 8;
+constexpr int MAX_FIELD_BYTES = 8;
+constexpr uint64_t BYTE_MASK = 0xFF;
+
+/// Largest integer a double represents exactly (2^53 - 1)
+constexpr double MAX_EXACT_INTEGER = 9007199254740991.0;
+
+/// Classic CAN payload; shorter definitions are padded to it
+constexpr uint8_t CLASSIC_LENGTH = 8;
+
+/// Payload lengths a CAN FD frame can carry above 8 bytes
+constexpr std::array<uint8_t, 7> FD_LENGTHS = {12, 16, 20, 24, 32, 48, 64};
+
+/**
+ * @brief Smallest frame length that holds @p required bytes
+ */
+uint8_t frameLength(int required) {
+    if (required <= CLASSIC_LENGTH) {
+        return CLASSIC_LENGTH;
+    }
+    const auto* length = std::find_if(FD_LENGTHS.begin(), FD_LENGTHS.end(),
+                                      [required](uint8_t fd) { return fd >= required; });
+    return length != FD_LENGTHS.end() ? *length : FD_LENGTHS.back();
+}
+
+/**
+ * @brief Value range of a field of @p byteCount bytes
+ */
+std::pair<double, double> fieldRange(int byteCount, bool isSigned) {
+    if (byteCount >= MAX_FIELD_BYTES) {
+        // Limited to the integers a double holds exactly; far beyond any simulated value
+        return {isSigned ? -MAX_EXACT_INTEGER : 0.0, MAX_EXACT_INTEGER};
+    }
+    const int bits = byteCount * BITS_PER_BYTE;
+    const double half = std::ldexp(1.0, bits - 1);
+    return isSigned ? std::pair{-half, half - 1.0} : std::pair{0.0, std::ldexp(1.0, bits) - 1.0};
+}
+
+} // anonymous namespace
+
+//=============================================================================
+// Construction
+//=============================================================================
+
+HaltechFrameEncoder::HaltechFrameEncoder(const FrameDefinition& frameDef)
+    : m_frameId(frameDef.frameId), m_rateHz(frameDef.rateHz) {
+    int required = 0;
+    m_steps.reserve(frameDef.channels.size());
+    for (const auto& channelDef : frameDef.channels) {
+        const auto& bytes = channelDef.byteIndices;
+        const bool consecutive =
+            std::adjacent_find(bytes.begin(), bytes.end(),
+                               [](int a, int b) { return b != a + 1; }) == bytes.end();
+        if (bytes.empty() || bytes.size() > static_cast<size_t>(MAX_FIELD_BYTES) ||
+            !consecutive || bytes.front() < 0 || bytes.back() >= RawCanFrame::MAX_PAYLOAD) {
+            qWarning() << "HaltechFrameEncoder: Unsupported byte layout for channel"
+                       << channelDef.name << "in frame" << Qt::hex << frameDef.frameId;
+            continue;
+        }
+
+        EncodeStep step;
+        step.firstByte = bytes.front();
+        step.byteCount = static_cast<int>(bytes.size());
+        step.isSigned = channelDef.isSigned;
+        step.conversion = channelDef.conversion;
+        step.field = SimulationScenario::fieldForChannel(channelDef.name);
+        if (step.field != nullptr) {
+            ++m_drivenChannels;
+        }
+        required = std::max(required, step.firstByte + step.byteCount);
+        m_steps.push_back(step);
+    }
+    m_length = frameLength(required);
+}
+
+//=============================================================================
+// Encoding
+//=============================================================================
+
+void HaltechFrameEncoder::encode(const VehicleState& state, RawCanFrame& frame) const {
+    frame.frameId = m_frameId;
+    frame.extended = false;
+    frame.remote = false;
+    frame.flexibleDataRate = m_length > CLASSIC_LENGTH;
+    frame.length = m_length;
+    std::fill_n(frame.data.begin(), m_length, uint8_t{0});
+
+    for (const auto& step : m_steps) {
+        const double value = step.field != nullptr ? state.*step.field : 0.0;
+        writeField(frame.data.data(), step.firstByte, step.byteCount, step.isSigned,
+                   HaltechProtocol::invertConversion(step.conversion, value));
+    }
+}
+
+void HaltechFrameEncoder::writeField(uint8_t* data, int firstByte, int byteCount,
+                                     bool isSigned, double raw) {
+    const auto [low, high] = fieldRange(byteCount, isSigned);
+    const double clamped = std::clamp(std::round(raw), low, high);
+    // Two's complement for negative values; the byte stores keep the low bytes
+    auto bits = isSigned ? static_cast<uint64_t>(static_cast<int64_t>(clamped))
+                         : static_cast<uint64_t>(clamped);
+    for (int i = firstByte + byteCount - 1; i >= firstByte; --i) {
+        data[i] = static_cast<uint8_t>(bits & BYTE_MASK);
+        bits >>= BITS_PER_BYTE;
+    }
+}
+
+} // namespace devdash
@@ -0,0 +1,91 @@
+#pragma once
+
+#include "SimulationScenario.h"
+#include "can/RawCanSocket.h"
+#include "haltech/HaltechProtocol.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace devdash {
+
+/**
+ * @brief Encodes a vehicle state into one Haltech frame
+ *
+ * The inverse of HaltechProtocol's frame decoder: each channel of the
+ * frame definition is looked up in the scenario's state, converted back
+ * to its raw value (HaltechProtocol::invertConversion), rounded, clamped
+ * to the field's width and signedness and written big-endian at the
+ * channel's byte positions. Channels the simulator does not drive are
+ * encoded as 0 in engineering units, so they decode to 0 rather than to
+ * a raw 0 (which would read as -273 °C for temperatures).
+ *
+ * The channel → state mapping is resolved once at construction; encode()
+ * only does arithmetic and byte stores.
+ *
+ * @code
+ * HaltechFrameEncoder encoder(protocol.frameDefinitions().value(0x360));
+ * RawCanFrame frame;
+ * encoder.encode(scenario->stateAt(10.0), frame);
+ * @endcode
+ */
+class HaltechFrameEncoder {
+  public:
+    /**
+     * @brief Compile the encode steps of a frame definition
+     *
+     * Channels whose bytes are not a consecutive run of 1-8 bytes are
+     * skipped with a warning, as in the decoder.
+     */
+    explicit HaltechFrameEncoder(const FrameDefinition& frameDef);
+
+    [[nodiscard]] uint32_t frameId() const { return m_frameId; }
+
+    /** @brief "rate_hz" of the frame definition (0 if not declared) */
+    [[nodiscard]] int rateHz() const { return m_rateHz; }
+
+    /** @brief Payload length: 8 bytes, or the CAN FD length the fields need */
+    [[nodiscard]] uint8_t length() const { return m_length; }
+
+    /** @brief Channels carrying a simulated value (the rest are encoded as 0) */
+    [[nodiscard]] int drivenChannels() const { return m_drivenChannels; }
+
+    /**
+     * @brief Build the frame for @p state
+     *
+     * Sets the ID, length, CAN FD flag and payload of @p frame; the
+     * timestamp is left unchanged.
+     */
+    void encode(const VehicleState& state, RawCanFrame& frame) const;
+
+    /**
+     * @brief Write a raw value big-endian into a payload
+     *
+     * Rounds @p raw to the nearest integer and clamps it to the range of a
+     * @p byteCount byte field.
+     *
+     * @pre @p data holds at least firstByte + byteCount bytes, byteCount 1-8
+     */
+    static void writeField(uint8_t* data, int firstByte, int byteCount, bool isSigned,
+                           double raw);
+
+  private:
+    /**
+     * @brief One channel of the frame: where it goes and what it carries
+     */
+    struct EncodeStep {
+        int firstByte = 0;
+        int byteCount = 0;
+        bool isSigned = false;
+        ConversionType conversion = ConversionType::Identity;
+        SimulationScenario::Field field = nullptr;  ///< nullptr = encoded as 0
+    };
+
+    uint32_t m_frameId = 0;
+    int m_rateHz = 0;
+    uint8_t m_length = 0;
+    int m_drivenChannels = 0;
+    std::vector<EncodeStep> m_steps;
+};
+
+} // namespace devdash
@@ -0,0 +1,274 @@
+/**
+ * @file Obd2EcuSimulator.cpp
+ * @brief Implementation of the simulated OBD-II ECU.
+ */
+
+#include "Obd2EcuSimulator.h"
+
+#include "obd2/Obd2Protocol.h"
+#include "obd2/Obd2Scheduler.h"
+
+#include <QDebug>
+
+#include <algorithm>
+
+namespace devdash {
+
+namespace {
+
+//=============================================================================
+// Protocol Constants
+//=============================================================================
+
+/// Negative response to service 01, code 0x12 "sub-function not supported / invalid format"
+constexpr std::array<uint8_t, 3> NEGATIVE_RESPONSE = {Obd2Protocol::NEGATIVE_RESPONSE,
+                                                      Obd2Protocol::SERVICE_CURRENT_DATA, 0x12};
+
+/// Request single frame: PCI byte, service byte, then the PIDs
+constexpr int REQUEST_HEADER = 2;
+
+/// PCI nibble of a flow control frame
+constexpr uint8_t PCI_FLOW_CONTROL = 0x30;
+constexpr uint8_t PCI_MASK = 0xF0;
+
+/// Bytes of a supported-PID bitmap, most significant first
+constexpr int BITMAP_BYTES = 4;
+
+/// PIDs one bitmap covers
+constexpr int PIDS_PER_BITMAP = 32;
+
+/// Consecutive frames are discarded when flow control does not come in time
+constexpr int FLOW_CONTROL_TIMEOUT_MS = 1000;
+
+constexpr double MS_PER_SECOND = 1000.0;
+
+} // anonymous namespace
+
+//=============================================================================
+// Construction / Destruction
+//=============================================================================
+
+Obd2EcuSimulator::Obd2EcuSimulator(std::shared_ptr<VirtualCanBus> bus, Options options,
+                                   QObject* parent)
+    : QObject(parent), m_endpoint(std::move(bus)), m_options(std::move(options)) {
+    m_options.ecu = std::clamp(m_options.ecu, 0, Obd2Protocol::ECU_COUNT - 1);
+    m_options.maxPidsPerRequest =
+        std::clamp(m_options.maxPidsPerRequest, 1, Obd2Scheduler::MAX_PIDS_PER_REQUEST);
+    m_options.responseDelayMs = std::max(m_options.responseDelayMs, 0);
+    m_options.queueDepth = std::max(m_options.queueDepth, 0);
+    m_requestId = Obd2Protocol::FIRST_REQUEST_ID + static_cast<uint32_t>(m_options.ecu);
+    m_responseId = Obd2Protocol::FIRST_RESPONSE_ID + static_cast<uint32_t>(m_options.ecu);
+
+    for (const Obd2PidDefinition& definition : Obd2Protocol::definitions()) {
+        m_fields[definition.pid] =
+            SimulationScenario::fieldForChannel(QString::fromUtf8(definition.channel));
+        if (m_options.supportedPids.empty() && m_fields[definition.pid] != nullptr) {
+            m_supported[definition.pid] = true;
+        }
+    }
+    for (const uint8_t pid : m_options.supportedPids) {
+        if (!Obd2Scheduler::isSupportedPidsPid(pid) && Obd2Protocol::definition(pid) != nullptr) {
+            m_supported[pid] = true;
+        }
+    }
+
+    // Parented so they follow the simulator when it is moved to another thread
+    m_endpoint.setParent(this);
+    m_endpoint.setFrameHandler([this](const RawCanFrame& frame) { onFrame(frame); });
+    m_timer.setParent(this);
+    m_timer.setSingleShot(true);
+    m_timer.setTimerType(Qt::PreciseTimer);
+    connect(&m_timer, &QTimer::timeout, this, &Obd2EcuSimulator::onTimer);
+}
+
+Obd2EcuSimulator::~Obd2EcuSimulator() {
+    stop();
+}
+
+//=============================================================================
+// Control
+//=============================================================================
+
+bool Obd2EcuSimulator::start() {
+    stop();
+    m_scenario = SimulationScenario::fromName(m_options.scenario);
+    if (!m_scenario) {
+        qWarning() << "Obd2EcuSimulator: Unknown scenario" << m_options.scenario;
+        return false;
+    }
+    m_clock.start();
+    m_endpoint.start();
+    return true;
+}
+
+void Obd2EcuSimulator::stop() {
+    m_endpoint.stop();
+    m_timer.stop();
+    m_queue.clear();
+    m_heldFrames.clear();
+    m_state = State::Idle;
+}
+
+bool Obd2EcuSimulator::supportsPid(uint8_t pid) const {
+    if (!Obd2Scheduler::isSupportedPidsPid(pid)) {
+        return m_supported[pid];
+    }
+    // A bitmap PID is answered if it is the first or the previous bitmap points to it
+    return pid == 0 || std::any_of(m_supported.begin() + pid, m_supported.end(),
+                                   [](bool supported) { return supported; });
+}
+
+//=============================================================================
+// Request Handling
+//=============================================================================
+
+void Obd2EcuSimulator::onFrame(const RawCanFrame& frame) {
+    if (frame.extended || frame.remote || frame.length == 0) {
+        return;
+    }
+
+    if (frame.frameId == m_requestId && (frame.data[0] & PCI_MASK) == PCI_FLOW_CONTROL) {
+        if (m_state != State::AwaitingFlowControl) {
+            return;
+        }
+        m_timer.stop();
+        for (const IsoTpReceiver::Frame& held : m_heldFrames) {
+            sendFrame(held);
+        }
+        m_heldFrames.clear();
+        m_state = State::Idle;
+        processNext();
+        return;
+    }
+
+    if (frame.frameId != m_requestId && frame.frameId != Obd2Protocol::FUNCTIONAL_REQUEST_ID) {
+        return;
+    }
+
+    // Service 01 requests always fit a single frame: PCI length, service, PIDs
+    const int length = frame.data[0];
+    if ((frame.data[0] & PCI_MASK) != 0 || length < REQUEST_HEADER ||
+        length > IsoTpReceiver::SINGLE_FRAME_CAPACITY || length >= frame.length ||
+        frame.data[1] != Obd2Protocol::SERVICE_CURRENT_DATA) {
+        return;
+    }
+
+    ++m_requestsReceived;
+    if (m_state != State::Idle && static_cast<int>(m_queue.size()) >= m_options.queueDepth) {
+        ++m_requestsDropped;
+        return;
+    }
+
+    Request& request = m_queue.emplace_back();
+    request.count = length - 1;
+    std::copy_n(frame.data.begin() + REQUEST_HEADER, request.count, request.pids.begin());
+    processNext();
+    m_maxPending = std::max(m_maxPending, static_cast<int>(m_queue.size()));
+}
+
+void Obd2EcuSimulator::processNext() {
+    if (m_state != State::Idle || m_queue.empty()) {
+        return;
+    }
+    m_current = m_queue.front();
+    m_queue.pop_front();
+    m_state = State::Processing;
+    m_timer.start(m_options.responseDelayMs);
+}
+
+void Obd2EcuSimulator::onTimer() {
+    if (m_state == State::AwaitingFlowControl) {
+        qWarning() << "Obd2EcuSimulator: No flow control within" << FLOW_CONTROL_TIMEOUT_MS
+                   << "ms, response dropped";
+        m_heldFrames.clear();
+    } else if (m_state == State::Processing) {
+        m_state = State::Idle;
+        respond(m_current);
+        if (m_state == State::AwaitingFlowControl) {
+            return;
+        }
+    }
+    m_state = State::Idle;
+    processNext();
+}
+
+void Obd2EcuSimulator::respond(const Request& request) {
+    IsoTpReceiver::Frame frame{};
+
+    if (request.count > m_options.maxPidsPerRequest) {
+        ++m_requestsRejected;
+        if (IsoTpReceiver::singleFrame(NEGATIVE_RESPONSE, frame)) {
+            sendFrame(frame);
+        }
+        return;
+    }
+
+    const double seconds = static_cast<double>(m_clock.elapsed()) / MS_PER_SECOND;
+    const VehicleState state = m_scenario ? m_scenario->stateAt(seconds) : VehicleState{};
+
+    m_message.clear();
+    m_message.push_back(static_cast<uint8_t>(Obd2Protocol::SERVICE_CURRENT_DATA +
+                                             Obd2Protocol::POSITIVE_RESPONSE_OFFSET));
+    for (int i = 0; i < request.count; ++i) {
+        const uint8_t pid = request.pids[static_cast<size_t>(i)];
+        if (!supportsPid(pid)) {
+            continue;
+        }
+        m_message.push_back(pid);
+        if (Obd2Scheduler::isSupportedPidsPid(pid)) {
+            const uint32_t bitmap = supportedPidBitmap(pid);
+            for (int byte = BITMAP_BYTES - 1; byte >= 0; --byte) {
+                m_message.push_back(static_cast<uint8_t>(bitmap >> (8 * byte)));
+            }
+        } else {
+            const Obd2PidDefinition& definition = *Obd2Protocol::definition(pid);
+            const SimulationScenario::Field field = m_fields[pid];
+            const Obd2PidData data =
+                Obd2Protocol::encodeValue(definition, field != nullptr ? state.*field : 0.0);
+            m_message.insert(m_message.end(), data.data.begin(), data.data.begin() + data.length);
+        }
+        ++m_pidsAnswered;
+    }
+    if (m_message.size() == 1) {
+        return;  // Nothing supported: ECUs stay silent rather than answer empty
+    }
+
+    const std::vector<IsoTpReceiver::Frame> frames = IsoTpReceiver::segment(m_message);
+    if (frames.empty()) {
+        return;
+    }
+    sendFrame(frames.front());
+    if (frames.size() > 1) {
+        m_heldFrames.assign(frames.begin() + 1, frames.end());
+        m_state = State::AwaitingFlowControl;
+        m_timer.start(FLOW_CONTROL_TIMEOUT_MS);
+    }
+}
+
+//=============================================================================
+// Helpers
+//=============================================================================
+
+void Obd2EcuSimulator::sendFrame(const IsoTpReceiver::Frame& payload) {
+    RawCanFrame frame;
+    frame.frameId = m_responseId;
+    frame.length = IsoTpReceiver::FRAME_LENGTH;
+    std::copy(payload.begin(), payload.end(), frame.data.begin());
+    if (!m_endpoint.writeFrame(frame)) {
+        qWarning() << "Obd2EcuSimulator: Bus full, response frame dropped";
+    }
+}
+
+uint32_t Obd2EcuSimulator::supportedPidBitmap(uint8_t basePid) const {
+    // Bit 31 = basePid + 1 ... bit 0 = basePid + 32, the next bitmap PID
+    uint32_t bitmap = 0;
+    for (int offset = 1; offset <= PIDS_PER_BITMAP; ++offset) {
+        const int pid = basePid + offset;
+        if (pid < static_cast<int>(m_supported.size()) && supportsPid(static_cast<uint8_t>(pid))) {
+            bitmap |= 1U << (PIDS_PER_BITMAP - offset);
+        }
+    }
+    return bitmap;
+}
+
+} // namespace devdash
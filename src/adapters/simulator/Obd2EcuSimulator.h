@@ -0,0 +1,150 @@
+#pragma once
+
+#include "SimulationScenario.h"
+#include "can/VirtualCanEndpoint.h"
+#include "obd2/IsoTpReceiver.h"
+
+#include <QElapsedTimer>
+#include <QObject>
+#include <QTimer>
+
+#include <array>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <optional>
+#include <vector>
+
+namespace devdash {
+
+/**
+ * @brief In-process OBD-II ECU answering service 01 requests on a VirtualCanBus
+ *
+ * The counterpart of Obd2Adapter for tests and benchmarks: it listens for
+ * requests on the functional ID (0x7DF) and its physical ID (0x7E0 + ecu),
+ * and answers at 0x7E8 + ecu with the values of a SimulationScenario -
+ * segmented (ISO-TP, waiting for flow control) when a multi-PID answer
+ * does not fit one frame.
+ *
+ * It behaves like a real ECU where that matters for polling: requests are
+ * processed one at a time with a configurable processing delay, a few can
+ * queue while it is busy (more are dropped, like a full receive buffer),
+ * requests with more PIDs than it allows are rejected with a negative
+ * response, and PIDs it does not support are left out of the answer and
+ * its supported-PID bitmaps. A request with no supported PID goes
+ * unanswered, as J1979 requires.
+ *
+ * @code
+ * Obd2EcuSimulator::Options options;
+ * options.scenario = "track";
+ * options.responseDelayMs = 2;
+ * Obd2EcuSimulator ecu(VirtualCanBus::get("vbus0"), options);
+ * if (ecu.start()) {
+ *     // an "obd2" adapter with "backend": "virtual", "interface": "vbus0" now gets answers
+ * }
+ * @endcode
+ */
+class Obd2EcuSimulator : public QObject {
+    Q_OBJECT
+
+  public:
+    /**
+     * @brief ECU behaviour
+     */
+    struct Options {
+        QString scenario = QStringLiteral("idle");  ///< SimulationScenario name
+        int ecu = 0;                ///< Requests at 0x7E0 + ecu, answers at 0x7E8 + ecu (0-7)
+        int maxPidsPerRequest = 6;  ///< Requests with more PIDs are rejected; 1 = single-PID ECU
+        int responseDelayMs = 0;    ///< Processing time per request
+        int queueDepth = 8;         ///< Requests held while busy; further ones are dropped
+        /// Empty = every Obd2Protocol PID the scenario drives; others answer 0
+        std::vector<uint8_t> supportedPids;
+    };
+
+    explicit Obd2EcuSimulator(std::shared_ptr<VirtualCanBus> bus, Options options = Options(),
+                              QObject* parent = nullptr);
+    ~Obd2EcuSimulator() override;
+
+    // QObject-based classes are not copyable or movable
+    Obd2EcuSimulator(const Obd2EcuSimulator&) = delete;
+    Obd2EcuSimulator& operator=(const Obd2EcuSimulator&) = delete;
+    Obd2EcuSimulator(Obd2EcuSimulator&&) = delete;
+    Obd2EcuSimulator& operator=(Obd2EcuSimulator&&) = delete;
+
+    /**
+     * @brief Start answering; the scenario clock starts now
+     * @return false for an unknown scenario
+     */
+    [[nodiscard]] bool start();
+
+    /**
+     * @brief Stop answering and forget queued requests
+     */
+    void stop();
+
+    /**
+     * @brief Check whether @p pid is answered
+     */
+    [[nodiscard]] bool supportsPid(uint8_t pid) const;
+
+    /** @brief Service 01 requests received (including dropped and rejected ones) */
+    [[nodiscard]] uint64_t requestsReceived() const { return m_requestsReceived; }
+
+    /** @brief PID values sent */
+    [[nodiscard]] uint64_t pidsAnswered() const { return m_pidsAnswered; }
+
+    /** @brief Requests answered with a negative response */
+    [[nodiscard]] uint64_t requestsRejected() const { return m_requestsRejected; }
+
+    /** @brief Requests dropped because the queue was full */
+    [[nodiscard]] uint64_t requestsDropped() const { return m_requestsDropped; }
+
+    /** @brief Most requests waiting at once while the ECU was busy */
+    [[nodiscard]] int maxPending() const { return m_maxPending; }
+
+  private slots:
+    void onTimer();
+
+  private:  // NOLINT(readability-redundant-access-specifiers) - Required for MOC
+    struct Request {
+        std::array<uint8_t, IsoTpReceiver::SINGLE_FRAME_CAPACITY> pids{};
+        int count = 0;
+    };
+
+    /// What the ECU is doing; one request at a time
+    enum class State : uint8_t {
+        Idle,
+        Processing,          ///< Working on m_current until the timer fires
+        AwaitingFlowControl  ///< First frame sent, consecutive frames held
+    };
+
+    void onFrame(const RawCanFrame& frame);
+    void processNext();
+    void respond(const Request& request);
+    void sendFrame(const IsoTpReceiver::Frame& payload);
+    [[nodiscard]] uint32_t supportedPidBitmap(uint8_t basePid) const;
+
+    VirtualCanEndpoint m_endpoint;
+    Options m_options;
+    std::optional<SimulationScenario> m_scenario;
+    std::array<bool, 256> m_supported{};                   ///< Indexed by PID
+    std::array<SimulationScenario::Field, 256> m_fields{};  ///< Indexed by PID, nullptr = 0
+    uint32_t m_requestId;
+    uint32_t m_responseId;
+
+    QElapsedTimer m_clock;
+    QTimer m_timer;  ///< Ends processing, or gives up waiting for flow control
+    State m_state{State::Idle};
+    Request m_current;
+    std::deque<Request> m_queue;  ///< Requests waiting while busy
+    std::vector<uint8_t> m_message;  ///< Response being built, reused
+    std::vector<IsoTpReceiver::Frame> m_heldFrames;  ///< Consecutive frames awaiting flow control
+
+    uint64_t m_requestsReceived{0};
+    uint64_t m_pidsAnswered{0};
+    uint64_t m_requestsRejected{0};
+    uint64_t m_requestsDropped{0};
+    int m_maxPending{0};
+};
+
+} // namespace devdash
@@ -0,0 +1,390 @@
+/**
+ * @file SimulationScenario.cpp
+ * @brief Scripted vehicle state for the simulator adapter.
+ */
+
+#include "SimulationScenario.h"
+
+#include <QHash>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <numbers>
+#include <utility>
+
+namespace devdash {
+
+namespace {
+
+//=============================================================================
+// Engine Model
+//=============================================================================
+
+constexpr double IDLE_RPM = 850.0;
+constexpr double REDLINE_RPM = 7800.0;
+constexpr double UPSHIFT_RPM = 6900.0;
+
+/// Engine speed per km/h in each gear (index = gear, 0 = neutral)
+constexpr std::array<double, 7> RPM_PER_KMH = {0.0, 118.0, 78.0, 57.0, 45.0, 37.0, 31.0};
+
+/// Manifold pressure at closed throttle and at full boost
+constexpr double VACUUM_MAP_KPA = 30.0;
+constexpr double FULL_BOOST_MAP_KPA = 240.0;
+constexpr double ATMOSPHERIC_KPA = 101.3;
+
+/// Oil pressure model: base + per-RPM rise, gauge kPa
+constexpr double OIL_PRESSURE_BASE_KPA = 100.0;
+constexpr double OIL_PRESSURE_PER_RPM = 0.075;
+
+/// Fuel rail pressure above manifold pressure (1:1 rising-rate regulator)
+constexpr double FUEL_PRESSURE_KPA = 300.0;
+
+/// Cooling system pressure rise per °C above ambient
+constexpr double COOLANT_PRESSURE_PER_DEGREE = 1.2;
+constexpr double AMBIENT_TEMPERATURE = 20.0;
+
+constexpr double CHARGING_VOLTAGE = 14.1;
+constexpr double STOICHIOMETRIC_LAMBDA = 1.0;
+constexpr double POWER_ENRICHMENT_LAMBDA = 0.82;
+constexpr double FULL_THROTTLE = 100.0;
+
+//=============================================================================
+// Warm Engine Temperatures (°C)
+//=============================================================================
+
+constexpr double WARM_COOLANT = 88.0;
+constexpr double WARM_OIL = 95.0;
+constexpr double WARM_AIR = 32.0;
+constexpr double WARM_FUEL = 35.0;
+constexpr double TRACK_COOLANT = 94.0;
+constexpr double TRACK_OIL = 112.0;
+constexpr double TRACK_AIR = 38.0;
+constexpr double TRACK_FUEL = 42.0;
+
+constexpr double FUEL_TANK_LITRES = 45.0;
+
+//=============================================================================
+// Variation
+//=============================================================================
+
+constexpr double TWO_PI = 2.0 * std::numbers::pi;
+
+/**
+ * @brief Sine variation added to a value so it is not perfectly flat
+ */
+struct Ripple {
+    double amplitude;
+    double hz;
+};
+
+constexpr Ripple IDLE_HUNT = {12.0, 0.7};           ///< Idle speed control hunting
+constexpr Ripple IDLE_ROUGHNESS = {5.0, 3.1};       ///< Combustion roughness
+constexpr Ripple IDLE_MAP = {0.6, 0.7};             ///< Follows the idle hunting
+constexpr Ripple CHARGING = {0.05, 0.2};            ///< Alternator regulation
+constexpr Ripple THERMOSTAT = {0.5, 0.02};          ///< Thermostat cycling
+constexpr Ripple CLOSED_LOOP_LAMBDA = {0.02, 1.3};  ///< Closed-loop fuel trim
+
+constexpr double IDLE_THROTTLE = 0.8;
+constexpr double IDLE_MAP_KPA = 32.0;
+
+//=============================================================================
+// Scenario Timing
+//=============================================================================
+
+constexpr double IDLE_DURATION = 60.0;
+constexpr double WARMUP_DURATION = 600.0;
+constexpr double OVERHEAT_DURATION = 240.0;
+constexpr double REDLINE_DURATION = 12.0;
+
+/**
+ * @brief One section of the track lap: speed ramps from start to end
+ */
+struct LapSegment {
+    double seconds;
+    double startKmh;
+    double endKmh;
+    double throttle;
+};
+
+/// Straights, braking zones and corners; the lap ends at the speed it starts with
+constexpr std::array<LapSegment, 9> LAP = {{
+    {8.0, 90.0, 195.0, 100.0},   // Main straight
+    {3.0, 195.0, 85.0, 0.0},     // Turn 1 braking
+    {5.0, 85.0, 95.0, 45.0},     // Turn 1-2
+    {7.0, 95.0, 175.0, 100.0},   // Back straight
+    {3.0, 175.0, 70.0, 0.0},     // Hairpin braking
+    {5.0, 70.0, 80.0, 35.0},     // Hairpin
+    {10.0, 80.0, 225.0, 100.0},  // Long straight
+    {4.0, 225.0, 100.0, 0.0},    // Final corner braking
+    {7.0, 100.0, 90.0, 50.0},    // Final corner onto the main straight
+}};
+
+constexpr double lapDuration() {
+    double seconds = 0.0;
+    for (const auto& segment : LAP) {
+        seconds += segment.seconds;
+    }
+    return seconds;
+}
+
+//=============================================================================
+// Helpers
+//=============================================================================
+
+double ripple(double seconds, const Ripple& shape) {
+    return shape.amplitude * std::sin(TWO_PI * shape.hz * seconds);
+}
+
+/// First-order approach from @p from towards @p to with time constant @p tau
+double approach(double from, double to, double seconds, double tau) {
+    return to + ((from - to) * std::exp(-seconds / tau));
+}
+
+/// Pressures that follow from engine speed, load and temperature
+void derivePressures(VehicleState& state) {
+    state.oilPressure = OIL_PRESSURE_BASE_KPA + (state.rpm * OIL_PRESSURE_PER_RPM);
+    state.fuelPressure =
+        FUEL_PRESSURE_KPA + std::max(0.0, state.manifoldPressure - ATMOSPHERIC_KPA);
+    state.coolantPressure = std::max(
+        0.0, (state.coolantTemperature - AMBIENT_TEMPERATURE) * COOLANT_PRESSURE_PER_DEGREE);
+}
+
+/// Manifold pressure for a throttle opening, spooling with engine speed
+double manifoldPressure(double throttle, double rpm) {
+    constexpr double SPOOL_START_RPM = 2500.0;
+    constexpr double SPOOL_RANGE_RPM = 2500.0;
+    constexpr double MIN_SPOOL = 0.35;
+    const double spool = std::clamp((rpm - SPOOL_START_RPM) / SPOOL_RANGE_RPM, MIN_SPOOL, 1.0);
+    return VACUUM_MAP_KPA +
+           ((throttle / FULL_THROTTLE) * (FULL_BOOST_MAP_KPA - VACUUM_MAP_KPA) * spool);
+}
+
+VehicleState warmIdleState(double seconds) {
+    VehicleState state;
+    state.rpm = IDLE_RPM + ripple(seconds, IDLE_HUNT) + ripple(seconds, IDLE_ROUGHNESS);
+    state.throttle = IDLE_THROTTLE;
+    state.manifoldPressure = IDLE_MAP_KPA + ripple(seconds, IDLE_MAP);
+    state.batteryVoltage = CHARGING_VOLTAGE + ripple(seconds, CHARGING);
+    state.coolantTemperature = WARM_COOLANT + ripple(seconds, THERMOSTAT);
+    state.oilTemperature = WARM_OIL;
+    state.airTemperature = WARM_AIR;
+    state.fuelTemperature = WARM_FUEL;
+    state.lambda = STOICHIOMETRIC_LAMBDA + ripple(seconds, CLOSED_LOOP_LAMBDA);
+    state.fuelLevel = FUEL_TANK_LITRES;
+    derivePressures(state);
+    return state;
+}
+
+//=============================================================================
+// Scenarios
+//=============================================================================
+
+VehicleState idleScenario(double seconds) {
+    return warmIdleState(seconds);
+}
+
+VehicleState warmupScenario(double seconds) {
+    constexpr double COLD = AMBIENT_TEMPERATURE;
+    constexpr double FAST_IDLE_EXTRA_RPM = 450.0;
+    constexpr double FAST_IDLE_EXTRA_MAP_KPA = 6.0;
+    constexpr double FAST_IDLE_TAU = 120.0;
+    constexpr double COOLANT_TAU = 150.0;
+    constexpr double OIL_TAU = 260.0;
+    constexpr double AIR_TAU = 200.0;
+    constexpr double FUEL_TAU = 300.0;
+    constexpr double COLD_ENRICHMENT = 0.1;
+    constexpr double ENRICHMENT_TAU = 90.0;
+    constexpr double RECHARGE_EXTRA_VOLTS = 0.3;
+    constexpr double RECHARGE_TAU = 180.0;
+    constexpr double COLD_OIL_EXTRA_KPA = 250.0;
+
+    VehicleState state = warmIdleState(seconds);
+    const double fastIdle = std::exp(-seconds / FAST_IDLE_TAU);
+    state.rpm += FAST_IDLE_EXTRA_RPM * fastIdle;
+    state.manifoldPressure += FAST_IDLE_EXTRA_MAP_KPA * fastIdle;
+    state.coolantTemperature = approach(COLD, WARM_COOLANT, seconds, COOLANT_TAU);
+    state.oilTemperature = approach(COLD, WARM_OIL, seconds, OIL_TAU);
+    state.airTemperature = approach(COLD, WARM_AIR, seconds, AIR_TAU);
+    state.fuelTemperature = approach(COLD, WARM_FUEL, seconds, FUEL_TAU);
+    state.lambda -= COLD_ENRICHMENT * std::exp(-seconds / ENRICHMENT_TAU);
+    state.batteryVoltage += RECHARGE_EXTRA_VOLTS * std::exp(-seconds / RECHARGE_TAU);
+    derivePressures(state);
+    // Cold oil is thick: pressure starts high and settles as it warms
+    state.oilPressure += COLD_OIL_EXTRA_KPA * std::exp(-seconds / OIL_TAU);
+    return state;
+}
+
+VehicleState trackScenario(double seconds) {
+    constexpr double LITRES_PER_SECOND = 0.02;
+    constexpr Ripple LAP_COOLANT = {2.0, 1.0 / lapDuration()};
+    constexpr Ripple LAP_OIL = {1.5, 1.0 / lapDuration()};
+
+    // Position in the lap
+    double lapTime = std::fmod(seconds, lapDuration());
+    const LapSegment* segment = &LAP.back();
+    for (const auto& candidate : LAP) {
+        if (lapTime < candidate.seconds) {
+            segment = &candidate;
+            break;
+        }
+        lapTime -= candidate.seconds;
+    }
+    const double progress = std::clamp(lapTime / segment->seconds, 0.0, 1.0);
+
+    VehicleState state;
+    state.vehicleSpeed =
+        segment->startKmh + ((segment->endKmh - segment->startKmh) * progress);
+    state.throttle = segment->throttle;
+
+    // Lowest gear that keeps the engine below the shift point
+    size_t gear = 1;
+    while (gear + 1 < RPM_PER_KMH.size() &&
+           state.vehicleSpeed * RPM_PER_KMH[gear] > UPSHIFT_RPM) {
+        ++gear;
+    }
+    state.gear = static_cast<double>(gear);
+    state.rpm = std::max(IDLE_RPM, state.vehicleSpeed * RPM_PER_KMH[gear]);
+
+    state.manifoldPressure = manifoldPressure(state.throttle, state.rpm);
+    state.lambda = state.throttle >= FULL_THROTTLE ? POWER_ENRICHMENT_LAMBDA
+                                                   : STOICHIOMETRIC_LAMBDA;
+    state.batteryVoltage = CHARGING_VOLTAGE + ripple(seconds, CHARGING);
+    state.coolantTemperature = TRACK_COOLANT + ripple(seconds, LAP_COOLANT);
+    state.oilTemperature = TRACK_OIL + ripple(seconds, LAP_OIL);
+    state.airTemperature = TRACK_AIR;
+    state.fuelTemperature = TRACK_FUEL;
+    state.fuelLevel = std::max(0.0, FUEL_TANK_LITRES - (seconds * LITRES_PER_SECOND));
+    derivePressures(state);
+    return state;
+}
+
+VehicleState overheatScenario(double seconds) {
+    constexpr double COOLANT_RISE = 35.0;
+    constexpr double OIL_RISE = 38.0;
+    constexpr double OIL_PRESSURE_LOSS = 0.35;
+
+    const double progress = seconds / OVERHEAT_DURATION;
+    VehicleState state = trackScenario(seconds);
+    state.coolantTemperature = TRACK_COOLANT + (COOLANT_RISE * progress);
+    state.oilTemperature = TRACK_OIL + (OIL_RISE * progress);
+    derivePressures(state);
+    // Thinning oil loses pressure as it overheats
+    state.oilPressure *= 1.0 - (OIL_PRESSURE_LOSS * progress);
+    return state;
+}
+
+VehicleState redlineScenario(double seconds) {
+    constexpr double REV_START = 1.0;
+    constexpr double LIMITER_START = 6.0;
+    constexpr double LIMITER_END = 9.0;
+    constexpr double LIMITER_BOUNCE_RPM = 250.0;
+    constexpr double LIMITER_HZ = 8.0;
+    constexpr double FREE_REV_MAP_RISE = 55.0;
+    constexpr double REV_DROP_TAU = 0.5;
+
+    VehicleState state = warmIdleState(seconds);
+    if (seconds >= REV_START && seconds < LIMITER_START) {
+        const double progress = (seconds - REV_START) / (LIMITER_START - REV_START);
+        state.rpm = IDLE_RPM + ((REDLINE_RPM - IDLE_RPM) * progress * progress);
+        state.throttle = FULL_THROTTLE;
+    } else if (seconds >= LIMITER_START && seconds < LIMITER_END) {
+        // Bouncing off the rev limiter
+        state.rpm = REDLINE_RPM - (LIMITER_BOUNCE_RPM * std::fmod(seconds * LIMITER_HZ, 1.0));
+        state.throttle = FULL_THROTTLE;
+    } else if (seconds >= LIMITER_END) {
+        state.rpm = approach(REDLINE_RPM, IDLE_RPM, seconds - LIMITER_END, REV_DROP_TAU);
+        state.throttle = 0.0;
+    }
+    // Unloaded engine: little manifold pressure even at full throttle
+    state.manifoldPressure =
+        VACUUM_MAP_KPA + ((state.throttle / FULL_THROTTLE) * FREE_REV_MAP_RISE);
+    state.lambda =
+        state.throttle >= FULL_THROTTLE ? POWER_ENRICHMENT_LAMBDA : STOICHIOMETRIC_LAMBDA;
+    derivePressures(state);
+    return state;
+}
+
+//=============================================================================
+// Lookup Tables
+//=============================================================================
+
+struct ScenarioEntry {
+    const char* name;
+    double durationSeconds;
+    SimulationScenario::StateFunction function;
+};
+
+constexpr std::array<ScenarioEntry, 5> SCENARIOS = {{
+    {"idle", IDLE_DURATION, idleScenario},
+    {"warmup", WARMUP_DURATION, warmupScenario},
+    {"track", lapDuration(), trackScenario},
+    {"overheat", OVERHEAT_DURATION, overheatScenario},
+    {"redline", REDLINE_DURATION, redlineScenario},
+}};
+
+/// Haltech channel names (as in the protocol definition) → state member
+const QHash<QString, SimulationScenario::Field>& channelFields() {
+    static const QHash<QString, SimulationScenario::Field> FIELDS = {
+        {QStringLiteral("RPM"), &VehicleState::rpm},
+        {QStringLiteral("Throttle Position"), &VehicleState::throttle},
+        {QStringLiteral("Manifold Pressure"), &VehicleState::manifoldPressure},
+        {QStringLiteral("Coolant Pressure"), &VehicleState::coolantPressure},
+        {QStringLiteral("Fuel Pressure"), &VehicleState::fuelPressure},
+        {QStringLiteral("Oil Pressure"), &VehicleState::oilPressure},
+        {QStringLiteral("Vehicle Speed"), &VehicleState::vehicleSpeed},
+        {QStringLiteral("Current Gear"), &VehicleState::gear},
+        {QStringLiteral("Battery Voltage"), &VehicleState::batteryVoltage},
+        {QStringLiteral("Coolant Temperature"), &VehicleState::coolantTemperature},
+        {QStringLiteral("Air Temperature"), &VehicleState::airTemperature},
+        {QStringLiteral("Fuel Temperature"), &VehicleState::fuelTemperature},
+        {QStringLiteral("Oil Temperature"), &VehicleState::oilTemperature},
+        {QStringLiteral("Wideband Lambda 1"), &VehicleState::lambda},
+        {QStringLiteral("Fuel Level"), &VehicleState::fuelLevel},
+    };
+    return FIELDS;
+}
+
+} // anonymous namespace
+
+//=============================================================================
+// Construction
+//=============================================================================
+
+SimulationScenario::SimulationScenario(QString name, double durationSeconds,
+                                       StateFunction function)
+    : m_name(std::move(name)), m_durationSeconds(durationSeconds), m_function(function) {}
+
+std::optional<SimulationScenario> SimulationScenario::fromName(const QString& name) {
+    for (const auto& entry : SCENARIOS) {
+        if (name == QLatin1String(entry.name)) {
+            return SimulationScenario(name, entry.durationSeconds, entry.function);
+        }
+    }
+    return std::nullopt;
+}
+
+QStringList SimulationScenario::names() {
+    QStringList result;
+    for (const auto& entry : SCENARIOS) {
+        result.append(QString::fromLatin1(entry.name));
+    }
+    return result;
+}
+
+SimulationScenario::Field SimulationScenario::fieldForChannel(const QString& channelName) {
+    return channelFields().value(channelName, nullptr);
+}
+
+//=============================================================================
+// Evaluation
+//=============================================================================
+
+VehicleState SimulationScenario::stateAt(double seconds, bool loop) const {
+    seconds = std::max(seconds, 0.0);
+    seconds = loop ? std::fmod(seconds, m_durationSeconds)
+                   : std::min(seconds, m_durationSeconds);
+    return m_function(seconds);
+}
+
+} // namespace devdash
@@ -0,0 +1,103 @@
+#pragma once
+
+#include <QString>
+#include <QStringList>
+
+#include <optional>
+
+namespace devdash {
+
+/**
+ * @brief Engine and vehicle state driven by a simulation scenario
+ *
+ * Values are in the engineering units the Haltech decoder reports:
+ * °C, kPa (manifold pressure absolute, other pressures gauge), km/h, %,
+ * volts, lambda and litres. Gear 0 is neutral.
+ */
+struct VehicleState {
+    double rpm = 0.0;
+    double throttle = 0.0;            ///< %
+    double manifoldPressure = 0.0;    ///< kPa absolute
+    double coolantPressure = 0.0;     ///< kPa gauge
+    double fuelPressure = 0.0;        ///< kPa gauge
+    double oilPressure = 0.0;         ///< kPa gauge
+    double vehicleSpeed = 0.0;        ///< km/h
+    double gear = 0.0;
+    double batteryVoltage = 0.0;      ///< V
+    double coolantTemperature = 0.0;  ///< °C
+    double airTemperature = 0.0;      ///< °C
+    double fuelTemperature = 0.0;     ///< °C
+    double oilTemperature = 0.0;      ///< °C
+    double lambda = 0.0;
+    double fuelLevel = 0.0;           ///< L
+};
+
+/**
+ * @brief Scripted driving scenario: vehicle state as a function of time
+ *
+ * Scenarios are deterministic, so two runs of the same scenario produce
+ * the same frames - useful for reproducing a dash glitch or comparing
+ * runs under load. Each scenario runs for durationSeconds() and then
+ * either starts over or holds its final state.
+ *
+ * | Scenario | Duration | Drives |
+ * |----------|----------|--------|
+ * | idle     | 60 s     | Warm engine at idle, stationary |
+ * | warmup   | 600 s    | Cold start: fast idle, temperatures rising to operating range |
+ * | track    | 52 s     | One lap: full-throttle straights, braking zones, gear changes |
+ * | overheat | 240 s    | Track driving with coolant and oil temperatures running away |
+ * | redline  | 12 s     | Stationary rev sweep into the limiter and back |
+ *
+ * Scenarios are a lookup table (name → state function), so adding one
+ * does not touch the generator or the encoder.
+ *
+ * @code
+ * auto scenario = SimulationScenario::fromName("track");
+ * VehicleState state = scenario->stateAt(12.5);
+ * @endcode
+ */
+class SimulationScenario {
+  public:
+    /// Vehicle state at a time into the scenario
+    using StateFunction = VehicleState (*)(double seconds);
+
+    /// Pointer to the VehicleState member a protocol channel carries
+    using Field = double VehicleState::*;
+
+    /**
+     * @brief Look up a scenario by name
+     * @return The scenario, or std::nullopt for an unknown name
+     */
+    [[nodiscard]] static std::optional<SimulationScenario> fromName(const QString& name);
+
+    /**
+     * @brief Names of all scenarios
+     */
+    [[nodiscard]] static QStringList names();
+
+    /**
+     * @brief Map a Haltech channel name to the state member it carries
+     * @return The member, or nullptr for channels the simulator does not drive
+     */
+    [[nodiscard]] static Field fieldForChannel(const QString& channelName);
+
+    [[nodiscard]] const QString& name() const { return m_name; }
+
+    [[nodiscard]] double durationSeconds() const { return m_durationSeconds; }
+
+    /**
+     * @brief Vehicle state @p seconds after the scenario started
+     * @param seconds Time into the scenario
+     * @param loop Start over after durationSeconds(); otherwise hold the final state
+     */
+    [[nodiscard]] VehicleState stateAt(double seconds, bool loop = true) const;
+
+  private:
+    SimulationScenario(QString name, double durationSeconds, StateFunction function);
+
+    QString m_name;
+    double m_durationSeconds;
+    StateFunction m_function;
+};
+
+} // namespace devdash
@@ -0,0 +1,165 @@
+/**
+ * @file SimulatorAdapter.cpp
+ * @brief Implementation of the in-process Haltech simulator adapter.
+ */
+
+#include "SimulatorAdapter.h"
+
+#include "FrameGenerator.h"
+#include "HaltechFrameEncoder.h"
+
+#include <QDebug>
+
+#include <array>
+#include <memory>
+#include <numeric>
+
+namespace devdash {
+
+namespace {
+
+//=============================================================================
+// Configuration Keys
+//=============================================================================
+
+constexpr const char* CONFIG_KEY_PROTOCOL_FILE = "protocolFile";
+constexpr const char* CONFIG_KEY_SIMULATOR = "simulator";
+constexpr const char* CONFIG_KEY_SCENARIO = "scenario";
+constexpr const char* CONFIG_KEY_FRAME_RATE = "frameRate";
+constexpr const char* CONFIG_KEY_LOOP = "loop";
+
+//=============================================================================
+// Built-in Frames (Haltech CAN Broadcast Protocol V2.35.0)
+//=============================================================================
+
+struct BuiltInFrame {
+    uint32_t frameId;
+    const char* name;
+    int rateHz;
+};
+
+struct BuiltInChannel {
+    uint32_t frameId;
+    const char* name;
+    int firstByte;
+    int byteCount;
+    bool isSigned;
+    const char* units;
+    ConversionType conversion;
+};
+
+constexpr std::array<BuiltInFrame, 8> BUILT_IN_FRAMES = {{
+    {0x360, "Engine Core 1", 50},
+    {0x361, "Pressures", 50},
+    {0x368, "Wideband 1-4", 20},
+    {0x370, "Vehicle Speed & Cam", 20},
+    {0x372, "Battery & Boost", 10},
+    {0x3E0, "Temperatures 1", 5},
+    {0x3E2, "Fuel Level", 5},
+    {0x470, "Wideband Overall & Gear", 20},
+}};
+
+/// Only the channels a scenario drives; names match the bundled profiles
+constexpr std::array<BuiltInChannel, 15> BUILT_IN_CHANNELS = {{
+    {0x360, "RPM", 0, 2, false, "RPM", ConversionType::Identity},
+    {0x360, "Manifold Pressure", 2, 2, false, "kPa", ConversionType::DivideBy10},
+    {0x360, "Throttle Position", 4, 2, false, "%", ConversionType::DivideBy10},
+    {0x360, "Coolant Pressure", 6, 2, false, "kPa", ConversionType::GaugePressure},
+    {0x361, "Fuel Pressure", 0, 2, false, "kPa", ConversionType::GaugePressure},
+    {0x361, "Oil Pressure", 2, 2, false, "kPa", ConversionType::GaugePressure},
+    {0x368, "Wideband Lambda 1", 0, 2, false, "lambda", ConversionType::DivideBy1000},
+    {0x370, "Vehicle Speed", 0, 2, false, "km/h", ConversionType::DivideBy10},
+    {0x372, "Battery Voltage", 0, 2, false, "V", ConversionType::DivideBy10},
+    {0x3E0, "Coolant Temperature", 0, 2, false, "K", ConversionType::KelvinToCelsius},
+    {0x3E0, "Air Temperature", 2, 2, false, "K", ConversionType::KelvinToCelsius},
+    {0x3E0, "Fuel Temperature", 4, 2, false, "K", ConversionType::KelvinToCelsius},
+    {0x3E0, "Oil Temperature", 6, 2, false, "K", ConversionType::KelvinToCelsius},
+    {0x3E2, "Fuel Level", 0, 2, false, "L", ConversionType::DivideBy10},
+    {0x470, "Current Gear", 7, 1, true, "gear", ConversionType::Identity},
+}};
+
+} // anonymous namespace
+
+//=============================================================================
+// Construction / Destruction
+//=============================================================================
+
+SimulatorAdapter::SimulatorAdapter(const QJsonObject& config, QObject* parent)
+    : CanAdapter(config, parent) {
+
+    const QString protocolFile = config[CONFIG_KEY_PROTOCOL_FILE].toString();
+    if (protocolFile.isEmpty()) {
+        m_protocol.loadDefinitions(builtInFrames());
+    } else if (!m_protocol.loadDefinition(protocolFile)) {
+        qWarning() << "SimulatorAdapter: Failed to load protocol definition:" << protocolFile
+                   << "- using built-in frames";
+        m_protocol.loadDefinitions(builtInFrames());
+    }
+    router().addDecoder(&m_protocol);
+
+    std::vector<HaltechFrameEncoder> encoders;
+    int drivenChannels = 0;
+    for (const auto& frameDef : m_protocol.frameDefinitions()) {
+        HaltechFrameEncoder encoder(frameDef);
+        drivenChannels += encoder.drivenChannels();
+        encoders.push_back(std::move(encoder));
+    }
+
+    const QJsonObject simulator = config[CONFIG_KEY_SIMULATOR].toObject();
+    FrameGenerator::Options options;
+    options.scenario = simulator[CONFIG_KEY_SCENARIO].toString(options.scenario);
+    options.frameRate = simulator[CONFIG_KEY_FRAME_RATE].toDouble(options.frameRate);
+    options.loop = simulator[CONFIG_KEY_LOOP].toBool(options.loop);
+
+    qDebug() << "SimulatorAdapter: Simulating" << encoders.size() << "frames with"
+             << drivenChannels << "scenario-driven channels";
+
+    auto generator = std::make_unique<FrameGenerator>(std::move(encoders));
+    generator->setOptions(options);
+    setFrameSource(std::move(generator));
+}
+
+SimulatorAdapter::~SimulatorAdapter() {
+    stop();
+}
+
+//=============================================================================
+// IProtocolAdapter Interface
+//=============================================================================
+
+QString SimulatorAdapter::adapterName() const {
+    return QStringLiteral("Haltech Simulator");
+}
+
+//=============================================================================
+// Built-in Frames
+//=============================================================================
+
+std::vector<FrameDefinition> SimulatorAdapter::builtInFrames() {
+    std::vector<FrameDefinition> frames;
+    frames.reserve(BUILT_IN_FRAMES.size());
+    for (const auto& frame : BUILT_IN_FRAMES) {
+        FrameDefinition frameDef;
+        frameDef.frameId = frame.frameId;
+        frameDef.name = QString::fromLatin1(frame.name);
+        frameDef.rateHz = frame.rateHz;
+        for (const auto& channel : BUILT_IN_CHANNELS) {
+            if (channel.frameId != frame.frameId) {
+                continue;
+            }
+            ChannelDefinition channelDef;
+            channelDef.name = QString::fromLatin1(channel.name);
+            channelDef.byteIndices.resize(static_cast<size_t>(channel.byteCount));
+            std::iota(channelDef.byteIndices.begin(), channelDef.byteIndices.end(),
+                      channel.firstByte);
+            channelDef.isSigned = channel.isSigned;
+            channelDef.units = QString::fromLatin1(channel.units);
+            channelDef.conversion = channel.conversion;
+            frameDef.channels.push_back(std::move(channelDef));
+        }
+        frames.push_back(std::move(frameDef));
+    }
+    return frames;
+}
+
+} // namespace devdash
@@ -0,0 +1,72 @@
+#pragma once
+
+#include "can/CanAdapter.h"
+#include "haltech/HaltechProtocol.h"
+
+#include <QJsonObject>
+
+#include <vector>
+
+namespace devdash {
+
+/**
+ * @brief In-process Haltech ECU: synthesizes frames instead of reading a bus
+ *
+ * Runs a SimulationScenario (idle, warmup, track, overheat, redline),
+ * encodes the vehicle state into Haltech frames with the inverse of the
+ * protocol definition and feeds them through CanAdapter's normal decode
+ * path - FrameRouter, rate limits, bus monitor and recording all behave as
+ * on a live bus. No vcan interface, mock ECU or CAN hardware is needed, so
+ * it doubles as a load generator for the pipeline on any Linux box,
+ * including CI.
+ *
+ * Frames follow "protocolFile" if given, otherwise the built-in subset of
+ * the Haltech CAN protocol v2.35 in builtInFrames().
+ *
+ * @code
+ * "adapter": "simulator",
+ * "adapterConfig": {
+ *     "simulator": {
+ *         "scenario": "track",  // idle (default), warmup, track, overheat, redline
+ *         "frameRate": 5000,    // total frames/s (10-20000), default: declared rates
+ *         "loop": true          // restart the scenario at its end
+ *     }
+ * }
+ * @endcode
+ *
+ * Single Responsibility: simulator setup only, frame timing lives in
+ * FrameGenerator and CAN I/O in CanAdapter.
+ */
+class SimulatorAdapter : public CanAdapter {
+    Q_OBJECT
+
+  public:
+    explicit SimulatorAdapter(const QJsonObject& config, QObject* parent = nullptr);
+    ~SimulatorAdapter() override;
+
+    // QObject-based classes are not copyable or movable
+    SimulatorAdapter(const SimulatorAdapter&) = delete;
+    SimulatorAdapter& operator=(const SimulatorAdapter&) = delete;
+    SimulatorAdapter(SimulatorAdapter&&) = delete;
+    SimulatorAdapter& operator=(SimulatorAdapter&&) = delete;
+
+    // IProtocolAdapter interface
+    [[nodiscard]] QString adapterName() const override;
+
+    /**
+     * @brief Frames simulated when no "protocolFile" is configured
+     *
+     * The Haltech CAN protocol v2.35 frames carrying the channels of the
+     * bundled profiles, at their specified rates (180 frames/s in total):
+     * engine core (0x360), pressures (0x361), wideband (0x368), vehicle
+     * speed (0x370), battery (0x372), temperatures (0x3E0), fuel level
+     * (0x3E2) and gear (0x470). Only channels a scenario drives are
+     * defined; channel names match profiles/haltech-vcan.json.
+     */
+    [[nodiscard]] static std::vector<FrameDefinition> builtInFrames();
+
+  private:
+    HaltechProtocol m_protocol;
+};
+
+} // namespace devdash
@@ -1,11 +1,13 @@
 #include "DataBroker.h"
 
 #include "core/logging/LogCategories.h"
+#include "core/logging/LogMacros.h"
 
 #include <QDebug>
 #include <QFile>
 #include <QJsonArray>
 #include <QJsonDocument>
+#include <QMetaObject>
 
 namespace devdash {
 
@@ -14,6 +16,18 @@ namespace {
 /// Default maximum forward gear for manual transmissions
 constexpr int DEFAULT_MAX_GEAR = 6;
 
+/// Name of the adapter I/O thread (shown by top -H and in /proc)
+constexpr const char* IO_THREAD_NAME = "devdash-io";
+
+/// Queue batches logged at debug level (one per second at the 60Hz tick)
+constexpr int QUEUE_LOG_SAMPLE = 60;
+
+/// Per-update lines logged per second at debug level
+constexpr int UPDATE_LOG_PER_SECOND = 20;
+
+/// Per-update warnings (failed enqueue, missing handler) logged per second
+constexpr int UPDATE_WARNING_PER_SECOND = 1;
+
 /**
  * @brief Load gear mapping from profile JSON.
  *
@@ -198,6 +212,11 @@ bool DataBroker::loadProfile(const QString& profilePath) {
 bool DataBroker::loadProfileFromJson(const QJsonObject& profile) {
     m_channelMappings.clear();
 
+    const auto ioThreadValue = profile.value("ioThread");
+    if (ioThreadValue.isObject()) {
+        setIoThread(ThreadScheduling::fromJson(ioThreadValue.toObject()));
+    }
+
     const auto mappingsValue = profile.value("channelMappings");
     if (mappingsValue.isUndefined() || mappingsValue.isNull()) {
         qWarning() << "DataBroker: Profile has no channelMappings - using empty mapping";
@@ -248,8 +267,10 @@ void DataBroker::setAdapter(std::unique_ptr<IProtocolAdapter> adapter) {
     m_adapter = std::move(adapter);
 
     if (m_adapter) {
+        // Direct: onChannelUpdated() only enqueues to the lock-free queue and is
+        // safe to call from the adapter I/O thread
         connect(m_adapter.get(), &IProtocolAdapter::channelUpdated, this,
-                &DataBroker::onChannelUpdated);
+                &DataBroker::onChannelUpdated, Qt::DirectConnection);
         connect(m_adapter.get(), &IProtocolAdapter::connectionStateChanged, this,
                 &DataBroker::onConnectionStateChanged);
     }
@@ -268,6 +289,9 @@ bool DataBroker::start() {
     // Start the 60Hz queue processing timer
     m_queueTimer.start();
 
+    if (m_ioThreadEnabled || m_adapter->requiresIoThread()) {
+        return startOnIoThread();
+    }
     return m_adapter->start();
 }
 
@@ -275,11 +299,70 @@ void DataBroker::stop() {
     // Stop queue processing
     m_queueTimer.stop();
 
+    if (m_ioThread) {
+        stopIoThread();
+        return;
+    }
+
     if (m_adapter && m_adapter->isRunning()) {
         m_adapter->stop();
     }
 }
 
+void DataBroker::setIoThread(const ThreadScheduling::Config& config) {
+    m_ioThreadEnabled = true;
+    m_ioThreadConfig = config;
+}
+
+bool DataBroker::startOnIoThread() {
+    if (m_ioThread) {
+        return true;  // Already running on its thread
+    }
+
+    m_ioThread = std::make_unique<QThread>();
+    m_ioThread->setObjectName(IO_THREAD_NAME);
+    m_ioThread->start();
+    m_adapter->moveToThread(m_ioThread.get());
+
+    // The adapter creates its sockets and notifiers in start(), so it must
+    // run on the thread that will service them
+    bool started = false;
+    QMetaObject::invokeMethod(
+        m_adapter.get(),
+        [this, &started]() {
+            started = m_adapter->start();
+            m_ioThreadResult = ThreadScheduling::applyToCurrentThread(m_ioThreadConfig);
+        },
+        Qt::BlockingQueuedConnection);
+
+    qInfo() << "DataBroker: Adapter I/O thread:" << m_ioThreadResult.summary();
+    for (const QString& problem : m_ioThreadResult.problems) {
+        qWarning() << "DataBroker: I/O thread:" << problem;
+    }
+
+    if (!started) {
+        stopIoThread();
+    }
+    return started;
+}
+
+void DataBroker::stopIoThread() {
+    if (m_adapter) {
+        QMetaObject::invokeMethod(
+            m_adapter.get(),
+            [this, owner = thread()]() {
+                if (m_adapter->isRunning()) {
+                    m_adapter->stop();
+                }
+                m_adapter->moveToThread(owner);
+            },
+            Qt::BlockingQueuedConnection);
+    }
+    m_ioThread->quit();
+    m_ioThread->wait();
+    m_ioThread.reset();
+}
+
 std::optional<StandardChannel>
 DataBroker::mapToStandardChannel(const QString& protocolChannelName) const {
     auto it = m_channelMappings.find(protocolChannelName);
@@ -298,12 +381,14 @@ void DataBroker::processQueue() {
         return;  // No updates to process
     }
 
-    qCDebug(logBroker) << "Processing" << dequeued << "updates from queue";
+    DEVDASH_CDEBUG_SAMPLE(logBroker, QUEUE_LOG_SAMPLE)
+        << "Processing" << dequeued << "updates from queue";
 
     // Process all dequeued updates
     for (const auto& update : updates) {
         if (!update.value.valid) {
-            qCDebug(logBroker) << "Skipping invalid value for" << update.channelName;
+            DEVDASH_CDEBUG_RATE(logBroker, UPDATE_LOG_PER_SECOND)
+                << "Skipping invalid value for" << update.channelName;
             continue;  // Skip invalid values
         }
 
@@ -314,42 +399,44 @@ void DataBroker::processQueue() {
             // This is critical - it means protocol is sending data we can't use
             // (Would have caught the toCamelCase bug that turned "RPM" → "rPM")
 
-            // Only warn once per unmapped channel to avoid log spam
+            // Only warn once per unmapped channel to avoid log spam, and list
+            // the mappings only for the first one
             if (!m_warnedUnmappedChannels.contains(update.channelName)) {
                 qCCritical(logBroker) << "UNMAPPED CHANNEL:" << update.channelName
                                       << "- Check profile channelMappings!";
-                qCCritical(logBroker) << "Available mappings:" << m_channelMappings.keys();
-                qCCritical(logBroker)
-                    << "This indicates a mismatch between protocol and profile.";
-                qCCritical(logBroker) << "Expected one of:" << m_channelMappings.keys();
+                if (m_warnedUnmappedChannels.isEmpty()) {
+                    qCCritical(logBroker)
+                        << "This indicates a mismatch between protocol and profile.";
+                    qCCritical(logBroker) << "Expected one of:" << m_channelMappings.keys();
+                }
 
                 m_warnedUnmappedChannels.insert(update.channelName);
             }
             continue;  // Unmapped channel
         }
 
-        qCDebug(logBroker) << "Mapped" << update.channelName
-                           << "to standard channel, calling handler";
+        DEVDASH_CDEBUG_RATE(logBroker, UPDATE_LOG_PER_SECOND)
+            << "Mapped" << update.channelName << "to standard channel, calling handler";
 
         // Find and invoke the handler for this channel
         auto handlerIt = m_channelHandlers.find(standardChannel.value());
         if (handlerIt != m_channelHandlers.end()) {
             handlerIt.value()(update.value.value);
-            qCDebug(logBroker) << "Handler executed for" << update.channelName;
         } else {
-            qCWarning(logBroker) << "No handler found for standard channel";
+            DEVDASH_CWARNING_RATE(logBroker, UPDATE_WARNING_PER_SECOND)
+                << "No handler found for standard channel";
         }
     }
 }
 
 void DataBroker::onChannelUpdated(const QString& channelName, const ChannelValue& value) {
-    qDebug() << "DataBroker: onChannelUpdated:" << channelName << "=" << value.value
-             << value.unit << "(valid:" << value.valid << ")";
+    DEVDASH_CDEBUG_RATE(logBroker, UPDATE_LOG_PER_SECOND)
+        << "onChannelUpdated:" << channelName << "=" << value.value << value.unit
+        << "(valid:" << value.valid << ")";
     // Enqueue update for batch processing by the 60Hz timer
     if (!m_updateQueue.enqueue(channelName, value)) {
-        qWarning() << "DataBroker: Failed to enqueue update for channel:" << channelName;
-    } else {
-        qDebug() << "DataBroker: Enqueued" << channelName;
+        DEVDASH_CWARNING_RATE(logBroker, UPDATE_WARNING_PER_SECOND)
+            << "Failed to enqueue update for channel:" << channelName;
     }
 }
 
@@ -418,4 +505,21 @@ bool DataBroker::isConnected() const {
     return m_isConnected;
 }
 
+QJsonObject DataBroker::adapterDiagnostics() const {
+    if (!m_adapter) {
+        return {};
+    }
+    if (!m_ioThread) {
+        return m_adapter->diagnostics();
+    }
+
+    // Counters are written by the I/O thread; read them there
+    QJsonObject diagnostics;
+    QMetaObject::invokeMethod(
+        m_adapter.get(), [this, &diagnostics]() { diagnostics = m_adapter->diagnostics(); },
+        Qt::BlockingQueuedConnection);
+    diagnostics["ioThread"] = m_ioThreadResult.toJson();
+    return diagnostics;
+}
+
 } // namespace devdash
\ No newline at end of file
@@ -2,12 +2,14 @@
 
 #include "core/channels/ChannelUpdateQueue.h"
 #include "core/interfaces/IProtocolAdapter.h"
+#include "core/threading/ThreadScheduling.h"
 
 #include <QHash>
 #include <QJsonObject>
 #include <QObject>
 #include <QSet>
 #include <QString>
+#include <QThread>
 #include <QTimer>
 
 #include <functional>
@@ -171,6 +173,29 @@ class DataBroker : public QObject {
      */
     void stop();
 
+    /**
+     * @brief Run the adapter on a dedicated I/O thread
+     *
+     * Takes effect on the next start(). The adapter is moved to its own
+     * thread, which then applies @p config (SCHED_FIFO priority, CPU
+     * affinity, memory locking) so frame reception and decoding do not wait
+     * behind rendering. What could be applied is logged and reported under
+     * "ioThread" in adapterDiagnostics().
+     *
+     * Profiles set this with a root "ioThread" object (see ThreadScheduling).
+     * An adapter that requires it (IProtocolAdapter::requiresIoThread())
+     * runs on an I/O thread with default scheduling without this call.
+     */
+    void setIoThread(const ThreadScheduling::Config& config);
+
+    /** @brief Whether the adapter runs on a dedicated I/O thread */
+    [[nodiscard]] bool hasIoThread() const { return m_ioThreadEnabled; }
+
+    /** @brief Scheduling requested for the I/O thread */
+    [[nodiscard]] const ThreadScheduling::Config& ioThreadConfig() const {
+        return m_ioThreadConfig;
+    }
+
     // Property getters (documented inline for brevity)
 
     /** @brief Current engine RPM (0-MAX_RPM) */
@@ -215,6 +240,13 @@ class DataBroker : public QObject {
     /** @brief Whether adapter is connected and receiving data */
     [[nodiscard]] bool isConnected() const;
 
+    /**
+     * @brief Diagnostics of the current adapter (e.g. CAN bus load and frame rates)
+     * @return IProtocolAdapter::diagnostics() plus "ioThread" when the adapter
+     *         runs on its own thread, or an empty object without adapter
+     */
+    [[nodiscard]] QJsonObject adapterDiagnostics() const;
+
 #ifdef BUILD_TESTING
     /**
      * @brief Manually process the update queue (for testing only).
@@ -316,9 +348,25 @@ class DataBroker : public QObject {
      */
     void processQueue();
 
+    /**
+     * @brief Start the adapter on a new I/O thread and apply its scheduling
+     */
+    [[nodiscard]] bool startOnIoThread();
+
+    /**
+     * @brief Stop the adapter on its I/O thread, move it back and join the thread
+     */
+    void stopIoThread();
+
     // Protocol adapter
     std::unique_ptr<IProtocolAdapter> m_adapter;
 
+    // Optional adapter I/O thread (see setIoThread())
+    bool m_ioThreadEnabled = false;
+    ThreadScheduling::Config m_ioThreadConfig;
+    ThreadScheduling::Result m_ioThreadResult;
+    std::unique_ptr<QThread> m_ioThread;
+
     // Queue for batched channel updates (60Hz processing)
     ChannelUpdateQueue m_updateQueue;
 
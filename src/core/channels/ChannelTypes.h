@@ -16,6 +16,7 @@ struct ChannelValue {
     QString unit;           ///< Source unit (e.g., "K", "kPa", "rad")
     bool valid{false};      ///< True if value is valid and should be used
     qint64 timestamp{0};    ///< Timestamp in milliseconds since epoch
+    QString text;           ///< Name of the value's state (e.g., "Drive"), empty if none
 };
 
 } // namespace devdash
@@ -159,10 +159,12 @@ void DevToolsServer::handleRequest(QTcpSocket* socket, const QByteArray& request
         handleWindowsEndpoint(socket);
     } else if (urlPath == "/api/logs") {
         handleLogsEndpoint(socket, url.query());
+    } else if (urlPath == "/api/bus") {
+        handleBusEndpoint(socket);
     } else {
         sendResponse(socket, 404, "Not Found", "text/plain",
                      "Endpoint not found. Available: /api/state, /api/warnings, "
-                     "/api/screenshot?window=<name>, /api/windows, /api/logs");
+                     "/api/screenshot?window=<name>, /api/windows, /api/logs, /api/bus");
     }
 }
 
@@ -293,7 +295,7 @@ void DevToolsServer::handleLogsEndpoint(QTcpSocket* socket, const QString& query
 
     // Parse query parameters
     int count = query.queryItemValue("count").toInt();
-    if (count <= 0 || count > 1000) {
+    if (count <= 0 || count > static_cast<int>(LogRing::DEFAULT_RECORD_CAPACITY)) {
         count = LogManager::DEFAULT_LOG_COUNT;
     }
 
@@ -323,11 +325,29 @@ void DevToolsServer::handleLogsEndpoint(QTcpSocket* socket, const QString& query
     statsObj["total"] = stats.totalMessages;
     statsObj["dropped"] = stats.droppedMessages;
     statsObj["buffer_size"] = stats.bufferSize;
+    statsObj["buffer_bytes"] = stats.bufferBytes;
+    statsObj["overflow"] = stats.overflowMessages;
+    statsObj["queued"] = stats.queuedMessages;
+    statsObj["rotations"] = stats.rotations;
+    statsObj["disk_bytes"] = stats.logDiskBytes;
     response["stats"] = statsObj;
 
     sendJsonResponse(socket, response);
 }
 
+void DevToolsServer::handleBusEndpoint(QTcpSocket* socket) {
+    if (!m_broker) {
+        QJsonObject error;
+        error["error"] = "DataBroker not available";
+        sendJsonResponse(socket, error);
+        return;
+    }
+
+    QJsonObject response = m_broker->adapterDiagnostics();
+    response["timestamp"] = QDateTime::currentMSecsSinceEpoch();
+    sendJsonResponse(socket, response);
+}
+
 //=============================================================================
 // Screenshot Capture
 //=============================================================================
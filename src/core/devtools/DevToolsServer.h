@@ -24,6 +24,7 @@ namespace devdash {
  * - `GET /api/screenshot?window=cluster` - PNG screenshot of window
  * - `GET /api/windows` - List of registered windows
  * - `GET /api/logs?count=100&level=info&category=devdash.broker` - Recent log entries
+ * - `GET /api/bus` - Adapter diagnostics: bus load, per-frame rates, jitter and gaps
  *
  * ## Usage Example
  *
@@ -106,6 +107,7 @@ private:
     void handleScreenshotEndpoint(QTcpSocket* socket, const QString& windowParam);
     void handleWindowsEndpoint(QTcpSocket* socket);
     void handleLogsEndpoint(QTcpSocket* socket, const QString& queryString);
+    void handleBusEndpoint(QTcpSocket* socket);
 
     [[nodiscard]] QImage captureWindow(const QString& windowName);
 
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "core/channels/ChannelTypes.h"
+#include <QJsonObject>
 #include <QObject>
 #include <QString>
 #include <QVariant>
@@ -70,6 +71,21 @@ class IProtocolAdapter : public QObject {
      */
     [[nodiscard]] virtual QString adapterName() const = 0;
 
+    /**
+     * @brief Get adapter-specific diagnostics for developer tools
+     * @return JSON object (empty if the adapter has none)
+     */
+    [[nodiscard]] virtual QJsonObject diagnostics() const { return {}; }
+
+    /**
+     * @brief Check whether the adapter must run off the GUI thread
+     *
+     * True when the adapter (re)opens devices whose calls may block, from
+     * its own thread, while running. DataBroker then starts it on an I/O
+     * thread even if the profile asks for none.
+     */
+    [[nodiscard]] virtual bool requiresIoThread() const { return false; }
+
   signals:
     /**
      * @brief Emitted when channel data is updated
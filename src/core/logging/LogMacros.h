@@ -0,0 +1,180 @@
+/**
+ * @file LogMacros.h
+ * @brief Logging macros for hot paths: level checked first, rate limits and sampling.
+ *
+ * qDebug() / qCDebug() build the whole message before LogManager drops it
+ * for being below the log level. These macros check the LogManager level
+ * and the category first, so a filtered call costs a couple of loads and
+ * nothing after the macro is evaluated:
+ *
+ * @code
+ * #include "core/logging/LogMacros.h"
+ *
+ * DEVDASH_CDEBUG(logBroker) << "Processing" << count << "updates";
+ *
+ * // Per frame: at most 20 lines per second from this call site
+ * DEVDASH_CDEBUG_RATE(logAdapter, 20) << "Channel:" << name << "=" << value;
+ *
+ * // Per tick: one line in every 60 calls
+ * DEVDASH_CDEBUG_SAMPLE(logBroker, 60) << "Queue depth" << depth;
+ * @endcode
+ *
+ * Rate-limited and sampled lines start with "[N suppressed]" when calls
+ * were skipped since the previous line of the same call site.
+ *
+ * Configuring with -DDEVDASH_STRIP_DEBUG_LOGS=ON (the release preset)
+ * compiles the DEVDASH_CDEBUG* macros out entirely; the streamed
+ * expressions are still type-checked but never evaluated.
+ */
+
+#pragma once
+
+#include <QDebug>
+#include <QLoggingCategory>
+#include <QString>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+namespace devdash {
+
+/**
+ * @brief Whether LogManager's level lets a message of @p type through
+ *
+ * Defined in LogManager.cpp.
+ */
+[[nodiscard]] bool logLevelEnabled(QtMsgType type);
+
+/**
+ * @brief State of one rate-limited or sampled logging call site
+ *
+ * One static instance per macro expansion. Thread-safe: call sites on
+ * several threads share the limit (counts are approximate under contention).
+ */
+class LogSite {
+  public:
+    /**
+     * @brief Admit at most @p perSecond calls per one-second window
+     */
+    [[nodiscard]] bool admitRate(int perSecond) noexcept {
+        const int64_t nowMs = std::chrono::duration_cast<std::chrono::milliseconds>(
+                                  std::chrono::steady_clock::now().time_since_epoch())
+                                  .count();
+        int64_t windowStart = m_windowStartMs.load(std::memory_order_relaxed);
+        if (nowMs - windowStart >= MS_PER_WINDOW &&
+            m_windowStartMs.compare_exchange_strong(windowStart, nowMs,
+                                                    std::memory_order_relaxed)) {
+            m_windowCount.store(0, std::memory_order_relaxed);
+        }
+        if (m_windowCount.fetch_add(1, std::memory_order_relaxed) < perSecond) {
+            return true;
+        }
+        m_suppressed.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    /**
+     * @brief Admit the first of every @p everyN calls
+     */
+    [[nodiscard]] bool admitSample(int everyN) noexcept {
+        const auto period = static_cast<uint64_t>(std::max(everyN, 1));
+        if (m_calls.fetch_add(1, std::memory_order_relaxed) % period == 0) {
+            return true;
+        }
+        m_suppressed.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    /**
+     * @brief Calls skipped since the last admitted one, and reset the count
+     */
+    [[nodiscard]] uint64_t takeSuppressed() noexcept {
+        return m_suppressed.exchange(0, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Prefix @p debug with the number of suppressed calls, if any
+     */
+    static QDebug withSuppressed(QDebug debug, uint64_t suppressed) {
+        if (suppressed > 0) {
+            debug.noquote() << QStringLiteral("[%1 suppressed]").arg(suppressed);
+            debug.quote();
+        }
+        return debug;
+    }
+
+  private:
+    static constexpr int64_t MS_PER_WINDOW = 1000;
+
+    std::atomic<int64_t> m_windowStartMs{0};
+    std::atomic<int> m_windowCount{0};
+    std::atomic<uint64_t> m_calls{0};
+    std::atomic<uint64_t> m_suppressed{0};
+};
+
+} // namespace devdash
+
+//=============================================================================
+// Implementation Macros
+//=============================================================================
+
+/// LogManager level first (one atomic load), then the category's own rules
+#define DEVDASH_LOG_ENABLED(category, type)                                                        \
+    (devdash::logLevelEnabled(type) && (category)().isEnabled(type))
+
+/// Logger carrying the call site and category, as qCDebug() and friends use
+#define DEVDASH_LOG_MESSAGE_LOGGER(category)                                                       \
+    QMessageLogger(QT_MESSAGELOG_FILE, QT_MESSAGELOG_LINE, QT_MESSAGELOG_FUNC,                     \
+                   (category)().categoryName())
+
+/// Static per-call-site state: every lambda expression has its own type
+#define DEVDASH_LOG_SITE()                                                                         \
+    []() -> devdash::LogSite& {                                                                    \
+        static devdash::LogSite site;                                                              \
+        return site;                                                                               \
+    }()
+
+#define DEVDASH_LOG_IF(type, method, category)                                                     \
+    if (!DEVDASH_LOG_ENABLED(category, type)) {                                                    \
+    } else                                                                                         \
+        DEVDASH_LOG_MESSAGE_LOGGER(category).method()
+
+#define DEVDASH_LOG_ADMITTED(type, method, category, admit)                                        \
+    if (!DEVDASH_LOG_ENABLED(category, type)) {                                                    \
+    } else if (devdash::LogSite& devdashLogSite = DEVDASH_LOG_SITE(); !devdashLogSite.admit) {    \
+    } else                                                                                         \
+        devdash::LogSite::withSuppressed(DEVDASH_LOG_MESSAGE_LOGGER(category).method(),            \
+                                         devdashLogSite.takeSuppressed())
+
+/// Compiled out: the stream is type-checked but never evaluated
+#define DEVDASH_LOG_STRIPPED()                                                                     \
+    if (true) {                                                                                    \
+    } else                                                                                         \
+        QMessageLogger().noDebug()
+
+//=============================================================================
+// Logging Macros
+//=============================================================================
+
+#ifdef DEVDASH_STRIP_DEBUG_LOGS
+#define DEVDASH_CDEBUG(category) DEVDASH_LOG_STRIPPED()
+#define DEVDASH_CDEBUG_RATE(category, perSecond) DEVDASH_LOG_STRIPPED()
+#define DEVDASH_CDEBUG_SAMPLE(category, everyN) DEVDASH_LOG_STRIPPED()
+#else
+/// qCDebug() that skips building the message below the LogManager level
+#define DEVDASH_CDEBUG(category) DEVDASH_LOG_IF(QtDebugMsg, debug, category)
+
+/// Debug line limited to @p perSecond per second from this call site
+#define DEVDASH_CDEBUG_RATE(category, perSecond)                                                   \
+    DEVDASH_LOG_ADMITTED(QtDebugMsg, debug, category, admitRate(perSecond))
+
+/// Debug line for one in every @p everyN calls of this call site
+#define DEVDASH_CDEBUG_SAMPLE(category, everyN)                                                    \
+    DEVDASH_LOG_ADMITTED(QtDebugMsg, debug, category, admitSample(everyN))
+#endif
+
+/// Warning limited to @p perSecond per second from this call site (never stripped)
+#define DEVDASH_CWARNING_RATE(category, perSecond)                                                 \
+    DEVDASH_LOG_ADMITTED(QtWarningMsg, warning, category, admitRate(perSecond))
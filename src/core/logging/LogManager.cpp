@@ -4,15 +4,21 @@
  */
 
 #include "LogManager.h"
+#include "LogMacros.h"
 
+#include <algorithm>
 #include <array>
+#include <cstdint>
+#include <cstdio>
+#include <utility>
 
 #include <QDateTime>
 #include <QDebug>
 #include <QFile>
+#include <QFileInfo>
 #include <QJsonDocument>
+#include <QMetaMethod>
 #include <QMutexLocker>
-#include <QTextStream>
 
 namespace devdash {
 
@@ -21,6 +27,9 @@ namespace {
 /// Global pointer to LogManager instance for message handler
 LogManager* g_logManager = nullptr;
 
+/// Writer wait for new messages before checking for shutdown
+constexpr std::int64_t WRITER_IDLE_WAIT_US = 100000;
+
 } // anonymous namespace
 
 /**
@@ -57,53 +66,87 @@ LogManager::~LogManager() {
 //=============================================================================
 
 void LogManager::initialize() {
-    QMutexLocker lock(&m_mutex);
-
     // Read environment variables
     QString envLevel = qEnvironmentVariable("DEVDASH_LOG_LEVEL", "info");
     QString envFile = qEnvironmentVariable("DEVDASH_LOG_FILE");
 
     // Set log level from environment
     if (envLevel == "debug") {
-        m_minLevel = QtDebugMsg;
+        setLogLevel(QtDebugMsg);
     } else if (envLevel == "info") {
-        m_minLevel = QtInfoMsg;
+        setLogLevel(QtInfoMsg);
     } else if (envLevel == "warning") {
-        m_minLevel = QtWarningMsg;
+        setLogLevel(QtWarningMsg);
     } else if (envLevel == "critical") {
-        m_minLevel = QtCriticalMsg;
+        setLogLevel(QtCriticalMsg);
     }
 
     // Enable file output if specified
     if (!envFile.isEmpty()) {
-        lock.unlock();
         setFileOutput(envFile);
-        lock.relock();
+    }
+
+    // Start the writer before any message can be queued
+    if (!m_writerRunning.load()) {
+        m_stopRequested.store(false);
+        m_writerRunning.store(true);
+        m_writer = std::thread(&LogManager::writerLoop, this);
     }
 
     // Install message handler
-    g_logManager = this;
-    m_previousHandler = qInstallMessageHandler(devdashMessageHandler);
+    if (g_logManager != this) {
+        g_logManager = this;
+        m_previousHandler = qInstallMessageHandler(devdashMessageHandler);
+    }
 
     // Log initialization (will be processed by our handler)
-    lock.unlock();
-    qInfo() << "LogManager initialized - level:" << levelToString(m_minLevel);
+    qInfo() << "LogManager initialized - level:" << levelToString(m_minLevel.load());
 }
 
 void LogManager::shutdown() {
-    QMutexLocker lock(&m_mutex);
-
     // Restore previous message handler
     if (g_logManager == this) {
         qInstallMessageHandler(m_previousHandler);
         g_logManager = nullptr;
     }
 
-    // Close log file
+    // Stop the writer, then write what was queued after its last pass
+    if (m_writerRunning.load()) {
+        m_stopRequested.store(true);
+        m_writer.join();
+
+        std::vector<LogRecord> batch(WRITE_BATCH_SIZE);
+        size_t count = 0;
+        while ((count = m_queue.try_dequeue_bulk(batch.begin(), batch.size())) > 0) {
+            writeBatch(batch.data(), count);
+        }
+
+        {
+            const std::lock_guard lock(m_flushMutex);
+            m_writerRunning.store(false);
+        }
+        m_flushed.notify_all();
+    }
+
+    // Close log file; compression already under way is finished
+    const std::lock_guard lock(m_fileMutex);
     if (m_logFile) {
         m_logFile->close();
         m_logFile.reset();
     }
+    m_rotator.stop();
+}
+
+void LogManager::flush() {
+    if (!m_writerRunning.load() || std::this_thread::get_id() == m_writer.get_id()) {
+        return;
+    }
+
+    const qint64 target = m_queuedMessages.load();
+    std::unique_lock lock(m_flushMutex);
+    m_flushed.wait(lock, [this, target] {
+        return m_writtenMessages.load() >= target || !m_writerRunning.load();
+    });
 }
 
 //=============================================================================
@@ -111,12 +154,22 @@ void LogManager::shutdown() {
 //=============================================================================
 
 void LogManager::setLogLevel(QtMsgType minLevel) {
-    QMutexLocker lock(&m_mutex);
-    m_minLevel = minLevel;
+    m_minLevel.store(minLevel);
+    m_minSeverity.store(LogRing::severity(minLevel));
+}
+
+bool logLevelEnabled(QtMsgType type) {
+    return LogManager::instance().isEnabled(type);
 }
 
 void LogManager::setFileOutput(const QString& path, qint64 maxSize) {
-    QMutexLocker lock(&m_mutex);
+    LogRotator::Config rotation;
+    rotation.maxFileBytes = maxSize;
+    setFileOutput(path, rotation);
+}
+
+void LogManager::setFileOutput(const QString& path, const LogRotator::Config& rotation) {
+    const std::lock_guard lock(m_fileMutex);
 
     // Close existing file
     if (m_logFile) {
@@ -125,21 +178,29 @@ void LogManager::setFileOutput(const QString& path, qint64 maxSize) {
 
     // Open new file
     m_logFile = std::make_unique<QFile>(path);
-    m_maxFileSize = maxSize;
 
     if (!m_logFile->open(QIODevice::WriteOnly | QIODevice::Append | QIODevice::Text)) {
         qWarning() << "LogManager: Failed to open log file:" << path << "-"
                    << m_logFile->errorString();
         m_logFile.reset();
+        m_rotator.stop();
+        return;
     }
+
+    // An appended file keeps its age across restarts where the filesystem records it
+    const QDateTime created = QFileInfo(path).birthTime();
+    m_fileOpenedMs = created.isValid() ? created.toMSecsSinceEpoch()
+                                       : QDateTime::currentMSecsSinceEpoch();
+    m_rotator.start(path, rotation);
 }
 
 void LogManager::disableFileOutput() {
-    QMutexLocker lock(&m_mutex);
+    const std::lock_guard lock(m_fileMutex);
     if (m_logFile) {
         m_logFile->close();
         m_logFile.reset();
     }
+    m_rotator.stop();
 }
 
 //=============================================================================
@@ -148,52 +209,41 @@ void LogManager::disableFileOutput() {
 
 QJsonArray LogManager::getRecentLogs(int count, QtMsgType minLevel,
                                      const QString& category) const {
-    QMutexLocker lock(&m_mutex);
+    std::vector<LogRecord> records;
+    {
+        QMutexLocker lock(&m_mutex);
+        records = m_ring.query(static_cast<size_t>(std::max(count, 0)), minLevel, category);
+    }
 
+    // Formatted outside the lock: the writer thread is not held up by queries
     QJsonArray result;
-    int added = 0;
-
-    // Iterate buffer in reverse (newest first)
-    for (auto it = m_ringBuffer.rbegin(); it != m_ringBuffer.rend() && added < count; ++it) {
-        const QJsonObject& entry = *it;
-
-        // Filter by level
-        QString levelStr = entry["level"].toString();
-        QtMsgType entryLevel = QtInfoMsg;
-        if (levelStr == "debug")
-            entryLevel = QtDebugMsg;
-        else if (levelStr == "warning")
-            entryLevel = QtWarningMsg;
-        else if (levelStr == "critical")
-            entryLevel = QtCriticalMsg;
-
-        if (entryLevel < minLevel) {
-            continue;
-        }
-
-        // Filter by category
-        if (!category.isEmpty()) {
-            QString entryCategory = entry["category"].toString();
-            if (!entryCategory.contains(category)) {
-                continue;
-            }
-        }
-
-        result.prepend(entry); // Prepend to maintain chronological order
-        ++added;
+    for (const LogRecord& record : records) {
+        result.append(formatJson(record));
     }
-
     return result;
 }
 
 void LogManager::clearLogs() {
     QMutexLocker lock(&m_mutex);
-    m_ringBuffer.clear();
+    m_ring.clear();
 }
 
 LogManager::Stats LogManager::stats() const {
+    Stats stats{};
+    stats.totalMessages = m_totalMessages.load(std::memory_order_relaxed);
+    stats.droppedMessages = m_droppedMessages.load(std::memory_order_relaxed);
+    stats.overflowMessages = m_overflowMessages.load(std::memory_order_relaxed);
+    const qint64 queued = m_queuedMessages.load(std::memory_order_relaxed) -
+                          m_writtenMessages.load(std::memory_order_relaxed);
+    stats.queuedMessages = std::max<qint64>(queued, 0);
+    const LogRotator::Stats rotation = m_rotator.stats();
+    stats.rotations = rotation.rotations;
+    stats.logDiskBytes = rotation.diskBytes;
+
     QMutexLocker lock(&m_mutex);
-    return m_stats;
+    stats.bufferSize = static_cast<qint64>(m_ring.size());
+    stats.bufferBytes = static_cast<qint64>(m_ring.memoryBytes());
+    return stats;
 }
 
 //=============================================================================
@@ -202,97 +252,162 @@ LogManager::Stats LogManager::stats() const {
 
 void LogManager::handleMessage(QtMsgType type, const QMessageLogContext& context,
                                const QString& msg) {
-    QMutexLocker lock(&m_mutex);
-
-    // Update statistics
-    m_stats.totalMessages++;
+    m_totalMessages.fetch_add(1, std::memory_order_relaxed);
 
     // Filter by log level
-    if (type < m_minLevel) {
-        m_stats.droppedMessages++;
+    if (!isEnabled(type)) {
+        m_droppedMessages.fetch_add(1, std::memory_order_relaxed);
         return;
     }
 
-    // Format for console (human-readable)
-    QString consoleMsg = formatConsole(type, context, msg);
+    // Never let a stalled writer grow the queue without bound
+    const qint64 backlog = m_queuedMessages.load(std::memory_order_relaxed) -
+                           m_writtenMessages.load(std::memory_order_relaxed);
+    if (backlog >= MAX_QUEUED_MESSAGES && type != QtFatalMsg) {
+        m_overflowMessages.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
 
-    // Format for ring buffer and file (JSON)
-    QJsonObject jsonEntry = formatJson(type, context, msg);
+    LogRecord record;
+    record.timestampMs = QDateTime::currentMSecsSinceEpoch();
+    record.type = type;
+    record.line = context.line;
+    record.category = context.category;
+    if (context.file) {
+        record.file = QByteArray(context.file);
+    }
+    if (context.function) {
+        record.function = QByteArray(context.function);
+    }
+    record.message = msg;
 
-    // Unlock before I/O operations
-    lock.unlock();
+    m_queuedMessages.fetch_add(1, std::memory_order_relaxed);
+    m_queue.enqueue(std::move(record));
 
-    // Output to console (stderr)
-    QTextStream(stderr) << consoleMsg << "\n";
+    // Qt aborts when the handler returns: get the message out first
+    if (type == QtFatalMsg) {
+        flush();
+    }
+}
 
-    // Re-lock for ring buffer and file operations
-    lock.relock();
+//=============================================================================
+// Writer Thread
+//=============================================================================
 
-    // Add to ring buffer
-    m_ringBuffer.push_back(jsonEntry);
-    if (m_ringBuffer.size() > RING_BUFFER_SIZE) {
-        m_ringBuffer.pop_front();
+void LogManager::writerLoop() {
+    std::vector<LogRecord> batch(WRITE_BATCH_SIZE);
+    for (;;) {
+        const size_t count =
+            m_queue.wait_dequeue_bulk_timed(batch.begin(), batch.size(), WRITER_IDLE_WAIT_US);
+        if (count > 0) {
+            writeBatch(batch.data(), count);
+        } else if (m_stopRequested.load()) {
+            return;
+        }
     }
-    m_stats.bufferSize = static_cast<qint64>(m_ringBuffer.size());
+}
 
-    // Write to file if enabled
-    if (m_logFile && m_logFile->isOpen()) {
-        QByteArray jsonLine = QJsonDocument(jsonEntry).toJson(QJsonDocument::Compact);
-        jsonLine.append('\n');
-        m_logFile->write(jsonLine);
-        m_logFile->flush();
+void LogManager::writeBatch(const LogRecord* records, size_t count) {
+    // Console (stderr is unbuffered: one write for the whole batch)
+    QByteArray console;
+    for (size_t i = 0; i < count; ++i) {
+        console += formatConsole(records[i]).toUtf8();
+        console += '\n';
+    }
+    std::fwrite(console.constData(), 1, static_cast<size_t>(console.size()), stderr);
+
+    // JSON only for the outputs that need it; the ring buffer stores binary records
+    const bool notify = isSignalConnected(QMetaMethod::fromSignal(&LogManager::logAdded));
+    std::vector<QJsonObject> entries;
+    {
+        const std::lock_guard lock(m_fileMutex);
+        const bool toFile = m_logFile && m_logFile->isOpen();
+        if (toFile || notify) {
+            entries.reserve(count);
+            for (size_t i = 0; i < count; ++i) {
+                entries.push_back(formatJson(records[i]));
+            }
+        }
+
+        // File, flushed once per batch
+        if (toFile) {
+            QByteArray lines;
+            for (const QJsonObject& entry : entries) {
+                lines += QJsonDocument(entry).toJson(QJsonDocument::Compact);
+                lines += '\n';
+            }
+            m_logFile->write(lines);
+            m_logFile->flush();
+
+            // Check for rotation (a rename; compression runs on the rotator's thread)
+            const qint64 nowMs = QDateTime::currentMSecsSinceEpoch();
+            if (m_rotator.shouldRotate(m_logFile->size(), m_fileOpenedMs, nowMs)) {
+                rotateLogFile(nowMs);
+            }
+        }
+    }
+
+    // Ring buffer
+    {
+        QMutexLocker lock(&m_mutex);
+        for (size_t i = 0; i < count; ++i) {
+            m_ring.push(records[i]);
+        }
+    }
 
-        // Check for rotation
-        if (m_logFile->size() >= m_maxFileSize) {
-            rotateLogFile();
+    if (notify) {
+        for (const QJsonObject& entry : entries) {
+            emit logAdded(entry);
         }
     }
 
-    // Emit signal (unlock first to avoid deadlock)
-    lock.unlock();
-    emit logAdded(jsonEntry);
+    m_writtenMessages.fetch_add(static_cast<qint64>(count), std::memory_order_relaxed);
+    {
+        // Taken so a flush() checking its condition cannot miss the notification
+        const std::lock_guard lock(m_flushMutex);
+    }
+    m_flushed.notify_all();
 }
 
 //=============================================================================
 // Formatting
 //=============================================================================
 
-QString LogManager::formatConsole(QtMsgType type, const QMessageLogContext& context,
-                                  const QString& msg) const {
+QString LogManager::formatConsole(const LogRecord& record) {
     // Format: [TIMESTAMP] [LEVEL] [CATEGORY] message
-    QString timestamp = QDateTime::currentDateTime().toString("yyyy-MM-dd hh:mm:ss.zzz");
-    QString level = levelToString(type).toUpper();
-    QString category = context.category ? QString::fromUtf8(context.category) : "default";
+    QString timestamp = QDateTime::fromMSecsSinceEpoch(record.timestampMs)
+                            .toString("yyyy-MM-dd hh:mm:ss.zzz");
+    QString level = levelToString(record.type).toUpper();
+    QString category = record.category ? QString::fromUtf8(record.category) : "default";
 
-    return QString("[%1] [%2] [%3] %4").arg(timestamp, level, category, msg);
+    return QString("[%1] [%2] [%3] %4").arg(timestamp, level, category, record.message);
 }
 
-QJsonObject LogManager::formatJson(QtMsgType type, const QMessageLogContext& context,
-                                   const QString& msg) const {
+QJsonObject LogManager::formatJson(const LogRecord& record) {
     QJsonObject entry;
 
     // ISO 8601 timestamp
-    entry["timestamp"] = QDateTime::currentDateTime().toString(Qt::ISODate);
+    entry["timestamp"] = QDateTime::fromMSecsSinceEpoch(record.timestampMs).toString(Qt::ISODate);
 
     // Log level
-    entry["level"] = levelToString(type);
+    entry["level"] = levelToString(record.type);
 
     // Category
-    entry["category"] = context.category ? QString::fromUtf8(context.category) : "default";
+    entry["category"] = record.category ? QString::fromUtf8(record.category) : "default";
 
     // Message
-    entry["message"] = msg;
+    entry["message"] = record.message;
 
     // Source context (file, line, function)
     QJsonObject contextObj;
-    if (context.file) {
-        contextObj["file"] = QString::fromUtf8(context.file);
+    if (!record.file.isEmpty()) {
+        contextObj["file"] = QString::fromUtf8(record.file);
     }
-    if (context.line > 0) {
-        contextObj["line"] = context.line;
+    if (record.line > 0) {
+        contextObj["line"] = record.line;
     }
-    if (context.function) {
-        contextObj["function"] = QString::fromUtf8(context.function);
+    if (!record.function.isEmpty()) {
+        contextObj["function"] = QString::fromUtf8(record.function);
     }
     if (!contextObj.isEmpty()) {
         entry["context"] = contextObj;
@@ -320,7 +435,8 @@ QString LogManager::levelToString(QtMsgType type) {
 // File Rotation
 //=============================================================================
 
-void LogManager::rotateLogFile() {
+void LogManager::rotateLogFile(qint64 nowMs) {
+    // Writer thread, m_fileMutex held
     if (!m_logFile) {
         return;
     }
@@ -330,10 +446,10 @@ void LogManager::rotateLogFile() {
     // Close current file
     m_logFile->close();
 
-    // Rename current file to .1
-    QString rotatedPath = currentPath + ".1";
-    QFile::remove(rotatedPath); // Remove old backup
-    QFile::rename(currentPath, rotatedPath);
+    // Becomes the newest generation; if the rename fails, the file is appended to
+    if (m_rotator.rotate(nowMs)) {
+        m_fileOpenedMs = nowMs;
+    }
 
     // Reopen with original name
     if (!m_logFile->open(QIODevice::WriteOnly | QIODevice::Append | QIODevice::Text)) {
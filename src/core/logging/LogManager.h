@@ -4,17 +4,28 @@
  *
  * Singleton that intercepts Qt log messages and routes them to
  * multiple outputs: console (human-readable), ring buffer (JSON),
- * and optional file output (JSON with rotation).
+ * and optional file output (JSON with multi-generation rotation). Outputs are written
+ * by a dedicated writer thread; logging callers only queue the message.
  */
 
 #pragma once
 
+#include "LogRing.h"
+#include "LogRotator.h"
+
+#include <QByteArray>
 #include <QJsonArray>
 #include <QJsonObject>
 #include <QMutex>
 #include <QObject>
-#include <deque>
+#include <QString>
+#include <atomic>
+#include <blockingconcurrentqueue.h>
+#include <condition_variable>
 #include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
 
 class QFile;
 
@@ -29,8 +40,28 @@ void devdashMessageHandler(QtMsgType type, const QMessageLogContext& context, co
  * Thread-safe singleton that:
  * - Intercepts all Qt log messages via custom message handler
  * - Outputs human-readable format to console (stderr)
- * - Stores JSON-formatted logs in ring buffer for MCP/HTTP access
- * - Optionally writes JSON logs to file with rotation
+ * - Stores recent logs in a binary ring buffer (LogRing) for MCP/HTTP access
+ * - Optionally writes JSON logs to file with rotation (LogRotator)
+ *
+ * The message handler never formats or does I/O: it checks the level,
+ * stamps the time and pushes a compact LogRecord onto a lock-free MPSC
+ * queue (moodycamel::BlockingConcurrentQueue), so a qDebug() on the CAN
+ * path costs an enqueue rather than a disk write. A single writer thread
+ * drains the queue in batches, formats each record once, writes the
+ * console lines in one write(), appends the batch to the log file with
+ * one flush(), adds the batch to the ring buffer and emits logAdded().
+ * JSON is only built for the file and for logAdded() receivers, when
+ * there are any; the ring keeps binary records until getRecentLogs().
+ * Messages keep their order per logging thread.
+ *
+ * If the writer falls behind by MAX_QUEUED_MESSAGES, further messages are
+ * discarded and counted (Stats::overflowMessages) instead of growing the
+ * queue. Fatal messages wait for the queue to be written before the
+ * process aborts.
+ *
+ * The writer checks the log file's size and age after each batch. Rotating
+ * is a rename on the writer thread; compressing the rotated file and
+ * deleting old generations happen on LogRotator's own thread.
  *
  * @example
  * @code
@@ -42,6 +73,9 @@ void devdashMessageHandler(QtMsgType type, const QMessageLogContext& context, co
  * // In other files
  * #include "core/logging/LogCategories.h"
  * qCInfo(logAdapter) << "Adapter started successfully";
+ *
+ * // On hot paths (see LogMacros.h)
+ * DEVDASH_CDEBUG_RATE(logAdapter, 20) << "Channel:" << name << "=" << value;
  * @endcode
  */
 class LogManager : public QObject {
@@ -77,20 +111,49 @@ public:
      */
     void setLogLevel(QtMsgType minLevel);
 
+    /**
+     * @brief Whether a message of @p type passes the log level.
+     *
+     * One atomic load; the LogMacros.h macros check it before building a message.
+     */
+    [[nodiscard]] bool isEnabled(QtMsgType type) const {
+        return LogRing::severity(type) >= m_minSeverity.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Wait until the writer thread has written the messages queued so far.
+     *
+     * Returns immediately when called on the writer thread or when it is not running.
+     */
+    void flush();
+
     /// Default maximum log file size (10MB)
-    static constexpr qint64 DEFAULT_MAX_FILE_SIZE = 10LL * 1024LL * 1024LL;
+    static constexpr qint64 DEFAULT_MAX_FILE_SIZE = LogRotator::DEFAULT_MAX_FILE_BYTES;
 
     /// Default count for log retrieval
     static constexpr int DEFAULT_LOG_COUNT = 100;
 
+    /// Messages waiting for the writer thread before new ones are discarded
+    static constexpr qint64 MAX_QUEUED_MESSAGES = 16384;
+
     /**
      * @brief Enable file output with optional rotation.
      *
+     * Other rotation settings keep their LogRotator::Config defaults.
+     *
      * @param path File path for log output
      * @param maxSize Maximum file size before rotation (default: 10MB)
      */
     void setFileOutput(const QString& path, qint64 maxSize = DEFAULT_MAX_FILE_SIZE);
 
+    /**
+     * @brief Enable file output with rotation by size and/or age.
+     *
+     * @param path File path for log output; rotated generations are kept next to it
+     * @param rotation Rotation limits, generations kept, disk budget and compression
+     */
+    void setFileOutput(const QString& path, const LogRotator::Config& rotation);
+
     /**
      * @brief Disable file output.
      */
@@ -99,6 +162,9 @@ public:
     /**
      * @brief Retrieve recent logs from ring buffer.
      *
+     * Formats only the returned entries; the ring buffer is locked while
+     * they are collected, not while they are formatted.
+     *
      * @param count Maximum number of entries to return (limited by buffer size)
      * @param minLevel Minimum severity to include
      * @param category Filter by category name (empty = all categories)
@@ -120,6 +186,11 @@ public:
         qint64 totalMessages;   ///< Total messages processed since initialization
         qint64 droppedMessages; ///< Messages dropped (below log level)
         qint64 bufferSize;      ///< Current ring buffer size
+        qint64 bufferBytes;     ///< Memory used by the ring buffer
+        qint64 overflowMessages; ///< Messages discarded because the writer fell behind
+        qint64 queuedMessages;  ///< Messages waiting for the writer thread
+        qint64 rotations;       ///< Log file rotations since file output was enabled
+        qint64 logDiskBytes;    ///< Log file and rotated generations on disk
     };
 
     /**
@@ -139,6 +210,9 @@ signals:
     /**
      * @brief Emitted when a new log entry is added.
      *
+     * Emitted from the writer thread; connected slots in other threads
+     * are invoked through queued connections.
+     *
      * @param entry JSON log entry with timestamp, level, category, message
      */
     void logAdded(const QJsonObject& entry);
@@ -152,22 +226,30 @@ private:
     /**
      * @brief Handle Qt log message.
      *
-     * Called by Qt message handler for all log messages.
-     * Routes to console, ring buffer, and optional file output.
+     * Called by Qt message handler for all log messages, on the logging
+     * thread. Filters by level and queues the message for the writer thread.
      */
     void handleMessage(QtMsgType type, const QMessageLogContext& context, const QString& msg);
 
+    /**
+     * @brief Writer thread: drain the queue until shutdown.
+     */
+    void writerLoop();
+
+    /**
+     * @brief Write a batch to all outputs (writer thread, or shutdown once it has exited).
+     */
+    void writeBatch(const LogRecord* records, size_t count);
+
     /**
      * @brief Format message for console output (human-readable).
      */
-    QString formatConsole(QtMsgType type, const QMessageLogContext& context,
-                          const QString& msg) const;
+    static QString formatConsole(const LogRecord& record);
 
     /**
      * @brief Format message as JSON for ring buffer and file.
      */
-    QJsonObject formatJson(QtMsgType type, const QMessageLogContext& context,
-                           const QString& msg) const;
+    static QJsonObject formatJson(const LogRecord& record);
 
     /**
      * @brief Convert QtMsgType to string.
@@ -175,33 +257,56 @@ private:
     static QString levelToString(QtMsgType type);
 
     /**
-     * @brief Rotate log file if it exceeds max size.
+     * @brief Turn the log file into a rotated generation and reopen it (writer thread).
      */
-    void rotateLogFile();
+    void rotateLogFile(qint64 nowMs);
 
-    /// Ring buffer size (1000 entries ~= 100-500KB depending on message size)
-    static constexpr int RING_BUFFER_SIZE = 1000;
+    /// Records the writer drains from the queue per pass
+    static constexpr size_t WRITE_BATCH_SIZE = 256;
 
     /// Previous message handler (to restore on shutdown)
     QtMessageHandler m_previousHandler = nullptr;
 
-    /// Thread safety for ring buffer and file access
+    /// Thread safety for ring buffer access
     mutable QMutex m_mutex;
 
-    /// Ring buffer for recent logs (JSON format)
-    std::deque<QJsonObject> m_ringBuffer;
+    /// Recent logs as binary records, formatted to JSON when queried
+    LogRing m_ring;
+
+    /// Minimum log level, and its severity (read by every logging caller)
+    std::atomic<QtMsgType> m_minLevel{QtInfoMsg};
+    std::atomic<size_t> m_minSeverity{LogRing::severity(QtInfoMsg)};
 
-    /// Minimum log level
-    QtMsgType m_minLevel = QtInfoMsg;
+    /// Messages from logging callers to the writer thread
+    moodycamel::BlockingConcurrentQueue<LogRecord> m_queue;
+
+    /// Writer thread, running between initialize() and shutdown()
+    std::thread m_writer;
+    std::atomic<bool> m_writerRunning{false};
+    std::atomic<bool> m_stopRequested{false};
+
+    /// Signalled by the writer after each batch, for flush()
+    std::mutex m_flushMutex;
+    std::condition_variable m_flushed;
+
+    /// Thread safety for the log file (writer thread vs. setFileOutput())
+    std::mutex m_fileMutex;
 
     /// Optional log file
     std::unique_ptr<QFile> m_logFile;
 
-    /// Maximum file size before rotation
-    qint64 m_maxFileSize = DEFAULT_MAX_FILE_SIZE;
+    /// When the log file was started, for rotation by age
+    qint64 m_fileOpenedMs = 0;
+
+    /// Rotated generations of the log file
+    LogRotator m_rotator;
 
     /// Statistics
-    Stats m_stats{};
+    std::atomic<qint64> m_totalMessages{0};
+    std::atomic<qint64> m_droppedMessages{0};
+    std::atomic<qint64> m_overflowMessages{0};
+    std::atomic<qint64> m_queuedMessages{0};  ///< Ever queued for the writer
+    std::atomic<qint64> m_writtenMessages{0}; ///< Ever written by the writer
 };
 
 } // namespace devdash
@@ -0,0 +1,241 @@
+/**
+ * @file LogRing.cpp
+ * @brief Implementation of the binary log history ring.
+ */
+
+#include "LogRing.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+
+namespace devdash {
+
+namespace {
+
+/// Category of messages logged without one (qDebug() etc.)
+constexpr const char* DEFAULT_CATEGORY_NAME = "default";
+
+/// UTF-8 continuation bytes are 10xxxxxx
+constexpr uint8_t UTF8_CONTINUATION_MASK = 0xC0;
+constexpr uint8_t UTF8_CONTINUATION_BITS = 0x80;
+
+/// Evicted index entries are compacted once at least this many accumulate
+constexpr size_t INDEX_COMPACT_MIN = 64;
+
+} // anonymous namespace
+
+//=============================================================================
+// Construction
+//=============================================================================
+
+LogRing::LogRing(size_t recordCapacity, size_t arenaBytes)
+    : m_records(std::max<size_t>(recordCapacity, 1)), m_arena(std::max<size_t>(arenaBytes, 1)) {
+    // "default" is always category 0
+    m_categoryNames.emplace_back(DEFAULT_CATEGORY_NAME);
+    m_categoryByName.insert(m_categoryNames.front(), DEFAULT_CATEGORY);
+    m_categoryByPointer.emplace(nullptr, DEFAULT_CATEGORY);
+    m_index.emplace_back();
+}
+
+//=============================================================================
+// Adding Messages
+//=============================================================================
+
+void LogRing::push(const LogRecord& record) {
+    const QByteArray text = record.message.toUtf8();
+    const uint64_t arenaSize = m_arena.size();
+
+    size_t length = std::min({static_cast<size_t>(text.size()), MAX_MESSAGE_BYTES,
+                              static_cast<size_t>(arenaSize)});
+    if (length < static_cast<size_t>(text.size())) {
+        // Do not cut a multi-byte character in half
+        while (length > 0 && (static_cast<uint8_t>(text[static_cast<qsizetype>(length)]) &
+                              UTF8_CONTINUATION_MASK) == UTF8_CONTINUATION_BITS) {
+            --length;
+        }
+    }
+
+    // Each text is contiguous: skip the end of the arena if it does not fit
+    uint64_t start = m_arenaHead;
+    if ((start % arenaSize) + length > arenaSize) {
+        start += arenaSize - (start % arenaSize);
+    }
+    const uint64_t end = start + length;
+
+    while (size() > 0 &&
+           (size() == capacity() || end - recordAt(m_firstSequence).textStart > arenaSize)) {
+        evictOldest();
+    }
+
+    if (length > 0) {
+        std::memcpy(&m_arena[static_cast<size_t>(start % arenaSize)], text.constData(), length);
+    }
+    m_arenaHead = end;
+
+    Record& stored = m_records[static_cast<size_t>(m_nextSequence % m_records.size())];
+    stored.timestampMs = record.timestampMs;
+    stored.textStart = start;
+    stored.textLength = static_cast<uint32_t>(length);
+    stored.line = record.line;
+    stored.category = internCategory(record.category);
+    stored.source = internSource(record.file, record.function);
+    stored.type = static_cast<uint8_t>(record.type);
+    stored.level = static_cast<uint8_t>(severity(record.type));
+
+    m_index[stored.category][stored.level].sequences.push_back(m_nextSequence);
+    ++m_nextSequence;
+}
+
+void LogRing::evictOldest() {
+    const Record& oldest = recordAt(m_firstSequence);
+    SequenceList& list = m_index[oldest.category][oldest.level];
+    ++list.head;
+    if (list.head >= INDEX_COMPACT_MIN && list.head * 2 >= list.sequences.size()) {
+        list.sequences.erase(list.sequences.begin(),
+                             list.sequences.begin() + static_cast<std::ptrdiff_t>(list.head));
+        list.head = 0;
+    }
+    ++m_firstSequence;
+}
+
+void LogRing::clear() {
+    m_firstSequence = m_nextSequence;
+    for (auto& levels : m_index) {
+        for (SequenceList& list : levels) {
+            list.sequences.clear();
+            list.head = 0;
+        }
+    }
+}
+
+//=============================================================================
+// Interning
+//=============================================================================
+
+uint16_t LogRing::internCategory(const char* category) {
+    const auto cached = m_categoryByPointer.find(category);
+    if (cached != m_categoryByPointer.end()) {
+        return cached->second;
+    }
+
+    const QByteArray name(category);
+    uint16_t id = DEFAULT_CATEGORY;
+    const auto known = m_categoryByName.constFind(name);
+    if (known != m_categoryByName.cend()) {
+        id = known.value();
+    } else if (m_categoryNames.size() < MAX_INTERNED) {
+        id = static_cast<uint16_t>(m_categoryNames.size());
+        m_categoryNames.push_back(name);
+        m_categoryByName.insert(name, id);
+        m_index.emplace_back();
+    }
+
+    if (m_categoryByPointer.size() < MAX_INTERNED) {
+        m_categoryByPointer.emplace(category, id);
+    }
+    return id;
+}
+
+uint16_t LogRing::internSource(const QByteArray& file, const QByteArray& function) {
+    if (file.isEmpty() && function.isEmpty()) {
+        return NO_SOURCE;
+    }
+
+    const std::pair<QByteArray, QByteArray> key(file, function);
+    const auto known = m_sourceByName.constFind(key);
+    if (known != m_sourceByName.cend()) {
+        return known.value();
+    }
+    if (m_sources.size() >= MAX_INTERNED) {
+        return NO_SOURCE;
+    }
+    const auto id = static_cast<uint16_t>(m_sources.size());
+    m_sources.push_back({file, function});
+    m_sourceByName.insert(key, id);
+    return id;
+}
+
+//=============================================================================
+// Queries
+//=============================================================================
+
+std::vector<LogRecord> LogRing::query(size_t count, QtMsgType minLevel,
+                                      const QString& category) const {
+    // Lists that can match: categories whose name contains the filter, at or above minLevel
+    struct Cursor {
+        const SequenceList* list;
+        size_t position;  ///< One past the next sequence to take
+    };
+    std::vector<Cursor> cursors;
+    for (size_t id = 0; id < m_index.size(); ++id) {
+        if (!category.isEmpty() &&
+            !QString::fromUtf8(m_categoryNames[id]).contains(category)) {
+            continue;
+        }
+        for (size_t level = severity(minLevel); level < LEVELS; ++level) {
+            const SequenceList& list = m_index[id][level];
+            if (!list.empty()) {
+                cursors.push_back({&list, list.sequences.size()});
+            }
+        }
+    }
+
+    // Merge newest first until count is reached
+    std::vector<uint64_t> picked;
+    while (picked.size() < count) {
+        Cursor* newest = nullptr;
+        for (Cursor& cursor : cursors) {
+            if (cursor.position > cursor.list->head &&
+                (!newest || cursor.list->sequences[cursor.position - 1] >
+                                newest->list->sequences[newest->position - 1])) {
+                newest = &cursor;
+            }
+        }
+        if (!newest) {
+            break;
+        }
+        picked.push_back(newest->list->sequences[--newest->position]);
+    }
+
+    std::vector<LogRecord> result;
+    result.reserve(picked.size());
+    for (auto it = picked.rbegin(); it != picked.rend(); ++it) {
+        result.push_back(decode(*it));
+    }
+    return result;
+}
+
+LogRecord LogRing::decode(uint64_t sequence) const {
+    const Record& stored = recordAt(sequence);
+    LogRecord record;
+    record.timestampMs = stored.timestampMs;
+    record.type = static_cast<QtMsgType>(stored.type);
+    record.line = stored.line;
+    record.category = m_categoryNames[stored.category].constData();
+    if (stored.source != NO_SOURCE) {
+        record.file = m_sources[stored.source].file;
+        record.function = m_sources[stored.source].function;
+    }
+    const char* text = &m_arena[static_cast<size_t>(stored.textStart % m_arena.size())];
+    record.message = QString::fromUtf8(text, static_cast<qsizetype>(stored.textLength));
+    return record;
+}
+
+size_t LogRing::memoryBytes() const {
+    size_t bytes = (m_records.size() * sizeof(Record)) + m_arena.size();
+    for (const auto& levels : m_index) {
+        for (const SequenceList& list : levels) {
+            bytes += list.sequences.capacity() * sizeof(uint64_t);
+        }
+    }
+    for (const QByteArray& name : m_categoryNames) {
+        bytes += static_cast<size_t>(name.size());
+    }
+    for (const Source& source : m_sources) {
+        bytes += static_cast<size_t>(source.file.size() + source.function.size());
+    }
+    return bytes;
+}
+
+} // namespace devdash
@@ -0,0 +1,195 @@
+/**
+ * @file LogRing.h
+ * @brief Binary ring buffer holding the recent log history.
+ */
+
+#pragma once
+
+#include <QByteArray>
+#include <QHash>
+#include <QString>
+#include <QtGlobal>
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace devdash {
+
+/**
+ * @brief One log message, as queued by the logging caller and as returned by LogRing
+ *
+ * File and function are copied: QML passes temporaries. Category names
+ * are static (QLoggingCategory requires it) and are kept as pointers.
+ */
+struct LogRecord {
+    qint64 timestampMs = 0;          ///< Milliseconds since the epoch
+    QtMsgType type = QtDebugMsg;
+    int line = 0;
+    const char* category = nullptr;
+    QByteArray file;
+    QByteArray function;
+    QString message;
+};
+
+/**
+ * @brief Recent log history as compact binary records, with indexed queries
+ *
+ * Each message is stored as a fixed-size record (timestamp, level, line,
+ * interned category and call site IDs) plus its UTF-8 text in a circular
+ * string arena. Nothing is formatted when a message is added; JSON is only
+ * built for the records a query returns. When either the record slots or
+ * the arena run out, the oldest messages are evicted.
+ *
+ * Every category/level pair keeps the sequence numbers of its messages, so
+ * query() merges only the lists that can match instead of scanning (and
+ * re-parsing) the whole history. Category filters are substring matches,
+ * resolved once against the interned names.
+ *
+ * @code
+ * LogRing ring;
+ * ring.push(record);
+ * // newest 100 warnings and worse from CAN categories, oldest first
+ * auto records = ring.query(100, QtWarningMsg, "can");
+ * @endcode
+ *
+ * @note Not thread-safe; LogManager serialises access.
+ */
+class LogRing {
+  public:
+    /// Messages kept (32 bytes of record each)
+    static constexpr size_t DEFAULT_RECORD_CAPACITY = 4096;
+
+    /// Message text kept, shared by all records
+    static constexpr size_t DEFAULT_ARENA_BYTES = 256LL * 1024LL;
+
+    /// Longer messages are truncated (at a UTF-8 character boundary)
+    static constexpr size_t MAX_MESSAGE_BYTES = 4096;
+
+    /// Distinct categories and call sites remembered; later ones share a catch-all
+    static constexpr size_t MAX_INTERNED = 4096;
+
+    /// Severity levels: debug, info, warning, critical, fatal
+    static constexpr size_t LEVELS = 5;
+
+    /// Message types from least to most severe
+    static constexpr std::array<QtMsgType, LEVELS> SEVERITY_ORDER = {
+        QtDebugMsg, QtInfoMsg, QtWarningMsg, QtCriticalMsg, QtFatalMsg};
+
+    explicit LogRing(size_t recordCapacity = DEFAULT_RECORD_CAPACITY,
+                     size_t arenaBytes = DEFAULT_ARENA_BYTES);
+
+    /**
+     * @brief Add a message, evicting the oldest ones if needed
+     */
+    void push(const LogRecord& record);
+
+    /**
+     * @brief Newest messages matching the filters
+     *
+     * @param count Maximum number of messages
+     * @param minLevel Minimum severity
+     * @param category Substring of the category name (empty = all categories)
+     * @return Up to @p count messages, oldest first
+     */
+    [[nodiscard]] std::vector<LogRecord> query(size_t count, QtMsgType minLevel = QtDebugMsg,
+                                               const QString& category = QString()) const;
+
+    /**
+     * @brief Forget all messages (interned names are kept)
+     */
+    void clear();
+
+    /** @brief Messages currently held */
+    [[nodiscard]] size_t size() const {
+        return static_cast<size_t>(m_nextSequence - m_firstSequence);
+    }
+
+    /** @brief Record slots */
+    [[nodiscard]] size_t capacity() const { return m_records.size(); }
+
+    /**
+     * @brief Approximate heap memory used (records, arena, indexes, interned names)
+     */
+    [[nodiscard]] size_t memoryBytes() const;
+
+    /**
+     * @brief Severity rank of a message type (debug 0 ... fatal 4)
+     *
+     * QtMsgType values are not ordered by severity (QtInfoMsg is the largest).
+     */
+    [[nodiscard]] static constexpr size_t severity(QtMsgType type) {
+        const auto* it = std::find(SEVERITY_ORDER.begin(), SEVERITY_ORDER.end(), type);
+        return it != SEVERITY_ORDER.end() ? static_cast<size_t>(it - SEVERITY_ORDER.begin())
+                                          : LEVELS - 1;
+    }
+
+  private:
+    /// Call site ID of messages without file and function
+    static constexpr uint16_t NO_SOURCE = std::numeric_limits<uint16_t>::max();
+
+    /// Category ID of "default", also used once MAX_INTERNED is reached
+    static constexpr uint16_t DEFAULT_CATEGORY = 0;
+
+    /**
+     * @brief Stored form of one message
+     */
+    struct Record {
+        qint64 timestampMs = 0;
+        uint64_t textStart = 0;         ///< Logical arena position of the text
+        uint32_t textLength = 0;
+        int32_t line = 0;
+        uint16_t category = DEFAULT_CATEGORY;
+        uint16_t source = NO_SOURCE;
+        uint8_t type = 0;               ///< QtMsgType
+        uint8_t level = 0;              ///< severity()
+    };
+
+    /**
+     * @brief Sequence numbers of one category at one level, oldest first
+     *
+     * Evicted entries are skipped by advancing head and compacted in bulk.
+     */
+    struct SequenceList {
+        std::vector<uint64_t> sequences;
+        size_t head = 0;
+
+        [[nodiscard]] bool empty() const { return head == sequences.size(); }
+    };
+
+    struct Source {
+        QByteArray file;
+        QByteArray function;
+    };
+
+    [[nodiscard]] uint16_t internCategory(const char* category);
+    [[nodiscard]] uint16_t internSource(const QByteArray& file, const QByteArray& function);
+    void evictOldest();
+    [[nodiscard]] LogRecord decode(uint64_t sequence) const;
+
+    [[nodiscard]] const Record& recordAt(uint64_t sequence) const {
+        return m_records[static_cast<size_t>(sequence % m_records.size())];
+    }
+
+    std::vector<Record> m_records;
+    std::vector<char> m_arena;
+    uint64_t m_firstSequence{0};  ///< Oldest message held
+    uint64_t m_nextSequence{0};
+    uint64_t m_arenaHead{0};      ///< Logical arena position of the next text
+
+    /// Sequence numbers by category, then severity
+    std::vector<std::array<SequenceList, LEVELS>> m_index;
+
+    std::vector<QByteArray> m_categoryNames;
+    std::unordered_map<const char*, uint16_t> m_categoryByPointer;
+    QHash<QByteArray, uint16_t> m_categoryByName;
+
+    std::vector<Source> m_sources;
+    QHash<std::pair<QByteArray, QByteArray>, uint16_t> m_sourceByName;
+};
+
+} // namespace devdash
@@ -0,0 +1,367 @@
+/**
+ * @file LogRotator.cpp
+ * @brief Implementation of multi-generation log rotation.
+ */
+
+#include "LogRotator.h"
+
+#include <QDateTime>
+#include <QDebug>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QRegularExpression>
+#include <QTimeZone>
+
+#include <pthread.h>
+#include <sys/resource.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+
+namespace devdash {
+
+namespace {
+
+//=============================================================================
+// Generation Names
+//=============================================================================
+
+/// Appended to the log file name; UTC so names sort by time across DST changes
+constexpr const char* GENERATION_TIME_FORMAT = "yyyyMMdd-hhmmss.zzz";
+
+/// Matches the suffix GENERATION_TIME_FORMAT produces
+constexpr const char* GENERATION_SUFFIX_PATTERN = R"(\.\d{8}-\d{6}\.\d{3})";
+
+constexpr const char* GZIP_SUFFIX = ".gz";
+constexpr const char* PARTIAL_SUFFIX = ".tmp";
+
+/// After a failed rename, rotation is not retried for this long
+constexpr qint64 ROTATE_RETRY_MS = 60000;
+
+//=============================================================================
+// Housekeeping Thread
+//=============================================================================
+
+/// Name of the housekeeping thread (shown by top -H and in /proc)
+constexpr const char* HOUSEKEEPING_THREAD_NAME = "devdash-logrot";
+
+/// Lowest CPU priority: compression only uses otherwise idle time
+constexpr int HOUSEKEEPING_NICE = 19;
+
+//=============================================================================
+// gzip Format (RFC 1952)
+//=============================================================================
+
+constexpr auto GZIP_HEADER = std::to_array<uint8_t>({
+    0x1F, 0x8B,             // magic
+    0x08,                   // deflate
+    0x00,                   // no flags
+    0x00, 0x00, 0x00, 0x00, // no modification time
+    0x00,                   // default compression
+    0x03,                   // Unix
+});
+
+/// qCompress() output: 4-byte length, 2-byte zlib header, deflate data, 4-byte Adler-32
+constexpr qsizetype QCOMPRESS_PREFIX_BYTES = 6;
+constexpr qsizetype QCOMPRESS_SUFFIX_BYTES = 4;
+
+/// A single empty final deflate block (qCompress() has no stream for empty input)
+constexpr std::array<uint8_t, 2> EMPTY_DEFLATE = {0x03, 0x00};
+
+constexpr uint32_t CRC32_POLYNOMIAL = 0xEDB88320U;
+constexpr uint32_t BYTE_MASK = 0xFFU;
+constexpr size_t BYTE_VALUES = 256;
+
+constexpr std::array<uint32_t, BYTE_VALUES> CRC32_TABLE = [] {
+    std::array<uint32_t, BYTE_VALUES> table{};
+    for (uint32_t i = 0; i < BYTE_VALUES; ++i) {
+        uint32_t crc = i;
+        for (int bit = 0; bit < 8; ++bit) {
+            crc = (crc & 1U) ? (crc >> 1U) ^ CRC32_POLYNOMIAL : crc >> 1U;
+        }
+        table[i] = crc;
+    }
+    return table;
+}();
+
+uint32_t crc32(const QByteArray& data) {
+    uint32_t crc = ~0U;
+    for (const char byte : data) {
+        crc = CRC32_TABLE[(crc ^ static_cast<uint8_t>(byte)) & BYTE_MASK] ^ (crc >> 8U);
+    }
+    return ~crc;
+}
+
+void appendLittleEndian32(QByteArray& out, uint32_t value) {
+    for (uint32_t shift = 0; shift < 32; shift += 8) {
+        out.append(static_cast<char>((value >> shift) & BYTE_MASK));
+    }
+}
+
+//=============================================================================
+// Helpers
+//=============================================================================
+
+/**
+ * @brief Names of generations of @p fileName, ending in @p extension (a pattern)
+ */
+QRegularExpression generationPattern(const QString& fileName, const QString& extension) {
+    return QRegularExpression(QStringLiteral("^%1%2%3$").arg(
+        QRegularExpression::escape(fileName), QString::fromLatin1(GENERATION_SUFFIX_PATTERN),
+        extension));
+}
+
+qint64 fileSize(const QString& path) {
+    const QFileInfo info(path);
+    return info.exists() ? info.size() : 0;
+}
+
+} // anonymous namespace
+
+//=============================================================================
+// Lifecycle
+//=============================================================================
+
+LogRotator::~LogRotator() {
+    stop();
+}
+
+void LogRotator::start(const QString& path, const Config& config) {
+    stop();
+
+    m_path = path;
+    m_config = config;
+    m_retryAfterMs = 0;
+    m_rotations.store(0, std::memory_order_relaxed);
+    m_compressedFiles.store(0, std::memory_order_relaxed);
+    m_deletedFiles.store(0, std::memory_order_relaxed);
+
+    {
+        const std::lock_guard lock(m_mutex);
+        m_stopRequested = false;
+        m_workPending = true;  // Tidy up what a previous run left behind
+    }
+    m_thread = std::thread(&LogRotator::housekeepingLoop, this);
+}
+
+void LogRotator::stop() {
+    if (!m_thread.joinable()) {
+        return;
+    }
+    {
+        const std::lock_guard lock(m_mutex);
+        m_stopRequested = true;
+    }
+    m_wake.notify_one();
+    m_thread.join();
+}
+
+void LogRotator::waitIdle() {
+    std::unique_lock lock(m_mutex);
+    m_idle.wait(lock, [this] { return !m_workPending && !m_busy; });
+}
+
+LogRotator::Stats LogRotator::stats() const {
+    Stats stats;
+    stats.rotations = m_rotations.load(std::memory_order_relaxed);
+    stats.compressedFiles = m_compressedFiles.load(std::memory_order_relaxed);
+    stats.deletedFiles = m_deletedFiles.load(std::memory_order_relaxed);
+    stats.diskBytes = m_diskBytes.load(std::memory_order_relaxed);
+    stats.generations = m_generations.load(std::memory_order_relaxed);
+    return stats;
+}
+
+//=============================================================================
+// Rotation (writer thread)
+//=============================================================================
+
+bool LogRotator::shouldRotate(qint64 fileBytes, qint64 openedMs, qint64 nowMs) const {
+    if (m_path.isEmpty() || nowMs < m_retryAfterMs) {
+        return false;
+    }
+    const bool tooLarge = m_config.maxFileBytes > 0 && fileBytes >= m_config.maxFileBytes;
+    // An empty file is not worth a generation, however old
+    const bool tooOld = m_config.maxAgeMs > 0 && fileBytes > 0 &&
+                        nowMs - openedMs >= m_config.maxAgeMs;
+    return tooLarge || tooOld;
+}
+
+bool LogRotator::rotate(qint64 nowMs) {
+    // Unique name even if two rotations fall in the same millisecond
+    // Qt::UTC is deprecated since Qt 6.9; QTimeZone::UTC needs Qt 6.5
+#if QT_VERSION >= QT_VERSION_CHECK(6, 5, 0)
+    const QTimeZone utc(QTimeZone::UTC);
+#else
+    const QTimeZone utc = QTimeZone::utc();
+#endif
+    QString target;
+    qint64 stampMs = nowMs;
+    do {
+        target = m_path + '.' +
+                 QDateTime::fromMSecsSinceEpoch(stampMs, utc).toString(GENERATION_TIME_FORMAT);
+        ++stampMs;
+    } while (QFile::exists(target) || QFile::exists(target + GZIP_SUFFIX));
+
+    if (!QFile::rename(m_path, target)) {
+        // Not retried on every batch: the warning would itself trigger the next attempt
+        m_retryAfterMs = nowMs + ROTATE_RETRY_MS;
+        qWarning() << "LogRotator: Failed to rotate" << m_path << "to" << target;
+        return false;
+    }
+    m_rotations.fetch_add(1, std::memory_order_relaxed);
+
+    {
+        const std::lock_guard lock(m_mutex);
+        m_workPending = true;
+    }
+    m_wake.notify_one();
+    return true;
+}
+
+//=============================================================================
+// Housekeeping Thread
+//=============================================================================
+
+void LogRotator::housekeepingLoop() {
+    pthread_setname_np(pthread_self(), HOUSEKEEPING_THREAD_NAME);
+    // Per-thread on Linux: only this thread runs at idle priority
+    if (setpriority(PRIO_PROCESS, static_cast<id_t>(gettid()), HOUSEKEEPING_NICE) != 0) {
+        qDebug() << "LogRotator: Could not lower housekeeping thread priority";
+    }
+
+    for (;;) {
+        {
+            std::unique_lock lock(m_mutex);
+            m_wake.wait(lock, [this] { return m_workPending || m_stopRequested; });
+            if (!m_workPending) {
+                return;  // Stop requested and nothing left to do
+            }
+            m_workPending = false;
+            m_busy = true;
+        }
+
+        housekeep();
+
+        {
+            const std::lock_guard lock(m_mutex);
+            m_busy = false;
+        }
+        m_idle.notify_all();
+    }
+}
+
+void LogRotator::housekeep() {
+    const QFileInfo logInfo(m_path);
+    const QDir dir = logInfo.absoluteDir();
+
+    // Partial output of an interrupted compression
+    const QRegularExpression partial = generationPattern(
+        logInfo.fileName(), QRegularExpression::escape(QString(GZIP_SUFFIX) + PARTIAL_SUFFIX));
+    for (const QString& name : dir.entryList(QDir::Files)) {
+        if (partial.match(name).hasMatch()) {
+            QFile::remove(dir.filePath(name));
+        }
+    }
+
+    if (m_config.compress) {
+        for (const QString& generation : generationFiles(m_path)) {
+            if (generation.endsWith(GZIP_SUFFIX) || fileSize(generation) > MAX_COMPRESS_BYTES) {
+                continue;
+            }
+            const QString compressed = generation + GZIP_SUFFIX;
+            if (QFile::exists(compressed)) {
+                // Interrupted after the compressed copy was complete
+                QFile::remove(generation);
+                continue;
+            }
+            const QString temporary = compressed + PARTIAL_SUFFIX;
+            if (!gzipFile(generation, temporary) || !QFile::rename(temporary, compressed)) {
+                qWarning() << "LogRotator: Failed to compress" << generation;
+                QFile::remove(temporary);
+                continue;
+            }
+            QFile::remove(generation);
+            m_compressedFiles.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    // Oldest first: delete from the front until the count and the budget are met
+    QStringList generations = generationFiles(m_path);
+    qint64 totalBytes = fileSize(m_path);
+    for (const QString& generation : generations) {
+        totalBytes += fileSize(generation);
+    }
+    const auto keep = static_cast<qsizetype>(std::max(m_config.generations, 0));
+    while (!generations.isEmpty() &&
+           (generations.size() > keep ||
+            (m_config.maxTotalBytes > 0 && totalBytes > m_config.maxTotalBytes))) {
+        const QString oldest = generations.takeFirst();
+        totalBytes -= fileSize(oldest);
+        if (QFile::remove(oldest)) {
+            m_deletedFiles.fetch_add(1, std::memory_order_relaxed);
+        } else {
+            qWarning() << "LogRotator: Failed to delete" << oldest;
+        }
+    }
+
+    m_diskBytes.store(totalBytes, std::memory_order_relaxed);
+    m_generations.store(static_cast<int>(generations.size()), std::memory_order_relaxed);
+}
+
+//=============================================================================
+// Files
+//=============================================================================
+
+QStringList LogRotator::generationFiles(const QString& path) {
+    const QFileInfo logInfo(path);
+    const QDir dir = logInfo.absoluteDir();
+    const QRegularExpression pattern = generationPattern(
+        logInfo.fileName(), QStringLiteral("(%1)?").arg(QRegularExpression::escape(GZIP_SUFFIX)));
+
+    QStringList generations;
+    // Sorted by name, which is by rotation time
+    for (const QString& name : dir.entryList(QDir::Files, QDir::Name)) {
+        if (pattern.match(name).hasMatch()) {
+            generations.append(dir.filePath(name));
+        }
+    }
+    return generations;
+}
+
+bool LogRotator::gzipFile(const QString& source, const QString& target) {
+    QFile input(source);
+    if (!input.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+    const QByteArray data = input.readAll();
+    input.close();
+
+    // qCompress() wraps raw deflate data in zlib framing; gzip needs its own
+    QByteArray gzip(reinterpret_cast<const char*>(GZIP_HEADER.data()),
+                    static_cast<qsizetype>(GZIP_HEADER.size()));
+    const QByteArray zlib = qCompress(data);
+    if (zlib.size() > QCOMPRESS_PREFIX_BYTES + QCOMPRESS_SUFFIX_BYTES) {
+        gzip.append(zlib.constData() + QCOMPRESS_PREFIX_BYTES,
+                    zlib.size() - QCOMPRESS_PREFIX_BYTES - QCOMPRESS_SUFFIX_BYTES);
+    } else {
+        gzip.append(reinterpret_cast<const char*>(EMPTY_DEFLATE.data()),
+                    static_cast<qsizetype>(EMPTY_DEFLATE.size()));
+    }
+    appendLittleEndian32(gzip, crc32(data));
+    appendLittleEndian32(gzip, static_cast<uint32_t>(data.size()));
+
+    QFile output(target);
+    if (!output.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        return false;
+    }
+    const bool written = output.write(gzip) == gzip.size() && output.flush();
+    // On disk before the uncompressed generation is deleted
+    const bool synced = written && ::fdatasync(output.handle()) == 0;
+    output.close();
+    return synced;
+}
+
+} // namespace devdash
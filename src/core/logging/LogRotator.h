@@ -0,0 +1,166 @@
+/**
+ * @file LogRotator.h
+ * @brief Multi-generation log file rotation with background compression.
+ */
+
+#pragma once
+
+#include <QString>
+#include <QStringList>
+#include <QtGlobal>
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+namespace devdash {
+
+/**
+ * @brief Rotates the log file into timestamped generations, compressed off the writer thread
+ *
+ * When the log file reaches its size or age limit, LogManager's writer
+ * thread closes it and calls rotate(), which only renames it to a new
+ * generation ("devdash.log.20250101-120000.000") and wakes the
+ * housekeeping thread. That thread, at idle CPU priority, gzips the new
+ * generation ("....000.gz"), then deletes the oldest generations beyond
+ * Config::generations and until the log file and its generations fit in
+ * Config::maxTotalBytes. A slow SD card therefore never holds up the
+ * writer, let alone a logging caller, and history is kept for as many
+ * generations as the budget allows instead of a single ".1" backup.
+ *
+ * Generation names sort by time, so nothing is renamed once rotated.
+ * Leftovers from an interrupted run (uncompressed generations, partial
+ * ".gz.tmp" files) are handled when the rotator starts.
+ *
+ * @code
+ * LogRotator rotator;
+ * rotator.start("/var/log/devdash.log", LogRotator::Config{});
+ * // writer thread, log file closed:
+ * if (rotator.shouldRotate(file.size(), openedMs, nowMs)) {
+ *     rotator.rotate(nowMs);
+ * }
+ * @endcode
+ *
+ * @note start(), stop(), shouldRotate() and rotate() must not be called
+ *       concurrently; LogManager serialises them with its file mutex.
+ */
+class LogRotator {
+  public:
+    /// Default size at which the log file is rotated (10MB)
+    static constexpr qint64 DEFAULT_MAX_FILE_BYTES = 10LL * 1024LL * 1024LL;
+
+    /// Default number of rotated generations kept
+    static constexpr int DEFAULT_GENERATIONS = 5;
+
+    /// Default disk budget for the log file and its generations (50MB)
+    static constexpr qint64 DEFAULT_MAX_TOTAL_BYTES = 50LL * 1024LL * 1024LL;
+
+    /// Larger generations are kept uncompressed (compression reads the whole file)
+    static constexpr qint64 MAX_COMPRESS_BYTES = 256LL * 1024LL * 1024LL;
+
+    /**
+     * @brief Rotation settings
+     */
+    struct Config {
+        qint64 maxFileBytes = DEFAULT_MAX_FILE_BYTES;   ///< Rotate at this size, 0 = no limit
+        qint64 maxAgeMs = 0;                            ///< Rotate at this age, 0 = no limit
+        int generations = DEFAULT_GENERATIONS;          ///< Rotated files kept
+        qint64 maxTotalBytes = DEFAULT_MAX_TOTAL_BYTES; ///< Log file + generations, 0 = no limit
+        bool compress = true;                           ///< gzip rotated generations
+    };
+
+    /**
+     * @brief Rotation counters
+     */
+    struct Stats {
+        qint64 rotations = 0;       ///< Files rotated since start()
+        qint64 compressedFiles = 0; ///< Generations compressed since start()
+        qint64 deletedFiles = 0;    ///< Generations deleted by the count or disk budget
+        qint64 diskBytes = 0;       ///< Log file and generations, as of the last housekeeping
+        int generations = 0;        ///< Generations on disk, as of the last housekeeping
+    };
+
+    LogRotator() = default;
+    ~LogRotator();
+
+    LogRotator(const LogRotator&) = delete;
+    LogRotator& operator=(const LogRotator&) = delete;
+    LogRotator(LogRotator&&) = delete;
+    LogRotator& operator=(LogRotator&&) = delete;
+
+    /**
+     * @brief Rotate @p path from now on, and tidy up generations already on disk
+     *
+     * Starts the housekeeping thread (stopping a previous one first).
+     */
+    void start(const QString& path, const Config& config);
+
+    /**
+     * @brief Stop the housekeeping thread once its pending work is done
+     */
+    void stop();
+
+    /**
+     * @brief Whether a log file of @p fileBytes, opened at @p openedMs, is due for rotation
+     */
+    [[nodiscard]] bool shouldRotate(qint64 fileBytes, qint64 openedMs, qint64 nowMs) const;
+
+    /**
+     * @brief Turn the closed log file into a new generation
+     *
+     * One rename; compression and deletion happen on the housekeeping thread.
+     *
+     * @return false if the file could not be renamed
+     */
+    bool rotate(qint64 nowMs);
+
+    /**
+     * @brief Wait until the housekeeping thread has no work left (between start() and stop())
+     */
+    void waitIdle();
+
+    /** @brief Rotation counters */
+    [[nodiscard]] Stats stats() const;
+
+    /**
+     * @brief Generations of @p path on disk, oldest first
+     */
+    [[nodiscard]] static QStringList generationFiles(const QString& path);
+
+    /**
+     * @brief Write @p source to @p target in gzip format (readable by zcat)
+     */
+    [[nodiscard]] static bool gzipFile(const QString& source, const QString& target);
+
+  private:
+    /**
+     * @brief Housekeeping thread: compress and prune whenever woken
+     */
+    void housekeepingLoop();
+
+    /**
+     * @brief One pass: remove partial output, compress, enforce count and budget
+     */
+    void housekeep();
+
+    QString m_path;
+    Config m_config;
+    qint64 m_retryAfterMs = 0;  ///< Writer thread only
+
+    std::thread m_thread;
+    std::mutex m_mutex;
+    std::condition_variable m_wake;
+    std::condition_variable m_idle;
+    bool m_workPending = false;  ///< Guarded by m_mutex
+    bool m_busy = false;         ///< Guarded by m_mutex
+    bool m_stopRequested = false; ///< Guarded by m_mutex
+
+    std::atomic<qint64> m_rotations{0};
+    std::atomic<qint64> m_compressedFiles{0};
+    std::atomic<qint64> m_deletedFiles{0};
+    std::atomic<qint64> m_diskBytes{0};
+    std::atomic<int> m_generations{0};
+};
+
+} // namespace devdash
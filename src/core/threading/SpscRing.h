@@ -0,0 +1,109 @@
+#pragma once
+
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <memory>
+
+namespace devdash {
+
+/**
+ * @brief Bounded lock-free ring for exactly one producer and one consumer thread
+ *
+ * All slots are allocated in the constructor; tryPush() and popBulk() never
+ * allocate, lock or make system calls. When the ring is full tryPush()
+ * returns false instead of waiting, so a slow consumer can never stall the
+ * producer (callers count such drops).
+ *
+ * Each side's index sits on its own cache line together with that side's
+ * cached copy of the other index, so the shared atomics are only read when
+ * the cached view says the ring is full (producer) or empty (consumer).
+ *
+ * @code
+ * SpscRing<RawCanFrame> ring(8192);
+ * // producer thread
+ * if (!ring.tryPush(frame)) { ++dropped; }
+ * // consumer thread
+ * std::array<RawCanFrame, 256> batch;
+ * const size_t count = ring.popBulk(batch.data(), batch.size());
+ * @endcode
+ *
+ * @tparam T Trivially copyable slot type
+ */
+template <typename T> class SpscRing {
+  public:
+    /**
+     * @param capacity Slots to allocate, rounded up to a power of two
+     */
+    explicit SpscRing(size_t capacity)
+        : m_capacity(std::bit_ceil(capacity < 2 ? size_t{2} : capacity)),
+          m_mask(m_capacity - 1), m_slots(std::make_unique<T[]>(m_capacity)) {}
+
+    // Shared between two threads by reference
+    SpscRing(const SpscRing&) = delete;
+    SpscRing& operator=(const SpscRing&) = delete;
+    SpscRing(SpscRing&&) = delete;
+    SpscRing& operator=(SpscRing&&) = delete;
+    ~SpscRing() = default;
+
+    [[nodiscard]] size_t capacity() const { return m_capacity; }
+
+    /**
+     * @brief Append one element (producer thread only)
+     * @return false if the ring is full; the element is not stored
+     */
+    [[nodiscard]] bool tryPush(const T& value) noexcept {
+        const size_t tail = m_tail.load(std::memory_order_relaxed);
+        if (tail - m_cachedHead == m_capacity) {
+            m_cachedHead = m_head.load(std::memory_order_acquire);
+            if (tail - m_cachedHead == m_capacity) {
+                return false;
+            }
+        }
+        m_slots[tail & m_mask] = value;
+        m_tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Move up to @p maxCount elements into @p out (consumer thread only)
+     * @return Number of elements written to out
+     */
+    size_t popBulk(T* out, size_t maxCount) noexcept {
+        const size_t head = m_head.load(std::memory_order_relaxed);
+        if (m_cachedTail - head < maxCount) {
+            m_cachedTail = m_tail.load(std::memory_order_acquire);
+        }
+        const size_t available = m_cachedTail - head;
+        const size_t count = available < maxCount ? available : maxCount;
+        for (size_t i = 0; i < count; ++i) {
+            out[i] = m_slots[(head + i) & m_mask];
+        }
+        m_head.store(head + count, std::memory_order_release);
+        return count;
+    }
+
+    /**
+     * @brief Elements currently queued (approximate while both sides run)
+     */
+    [[nodiscard]] size_t size() const {
+        return m_tail.load(std::memory_order_acquire) - m_head.load(std::memory_order_acquire);
+    }
+
+  private:
+    static constexpr size_t CACHE_LINE = 64;
+
+    const size_t m_capacity;
+    const size_t m_mask;
+    std::unique_ptr<T[]> m_slots;
+
+    // Consumer side
+    alignas(CACHE_LINE) std::atomic<size_t> m_head{0};
+    size_t m_cachedTail{0};  ///< Consumer's last seen tail
+
+    // Producer side
+    alignas(CACHE_LINE) std::atomic<size_t> m_tail{0};
+    size_t m_cachedHead{0};  ///< Producer's last seen head
+};
+
+} // namespace devdash
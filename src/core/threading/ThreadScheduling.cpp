@@ -0,0 +1,190 @@
+/**
+ * @file ThreadScheduling.cpp
+ * @brief Implementation of real-time thread scheduling and affinity.
+ */
+
+#include "ThreadScheduling.h"
+
+#include <QJsonArray>
+
+#include <pthread.h>
+#include <sched.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+
+namespace devdash {
+
+namespace {
+
+//=============================================================================
+// Configuration Keys
+//=============================================================================
+
+constexpr const char* CONFIG_KEY_PRIORITY = "priority";
+constexpr const char* CONFIG_KEY_CPUS = "cpus";
+constexpr const char* CONFIG_KEY_LOCK_MEMORY = "lockMemory";
+
+//=============================================================================
+// Memory Locking
+//=============================================================================
+
+/// Stack touched after locking so the thread never faults on stack growth
+constexpr size_t STACK_PREFAULT_BYTES = 256 * 1024;
+
+void prefaultStack() {
+    // volatile: the compiler must not elide the writes
+    volatile char stack[STACK_PREFAULT_BYTES];
+    const auto pageSize = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    for (size_t i = 0; i < STACK_PREFAULT_BYTES; i += pageSize) {
+        stack[i] = 0;
+    }
+}
+
+QString errorText(int error) {
+    return QString::fromLocal8Bit(std::strerror(error));
+}
+
+QString joinCpus(const QList<int>& cpus) {
+    QStringList parts;
+    for (int cpu : cpus) {
+        parts.append(QString::number(cpu));
+    }
+    return parts.join(',');
+}
+
+} // anonymous namespace
+
+//=============================================================================
+// Configuration
+//=============================================================================
+
+ThreadScheduling::Config ThreadScheduling::fromJson(const QJsonObject& object) {
+    Config config;
+    const int priority = object[CONFIG_KEY_PRIORITY].toInt(0);
+    config.fifoPriority = priority > 0 ? std::clamp(priority, MIN_FIFO_PRIORITY, MAX_FIFO_PRIORITY)
+                                       : 0;
+    for (const auto& cpu : object[CONFIG_KEY_CPUS].toArray()) {
+        if (cpu.toInt(-1) >= 0) {
+            config.cpus.append(cpu.toInt());
+        }
+    }
+    config.lockMemory = object[CONFIG_KEY_LOCK_MEMORY].toBool(false);
+    return config;
+}
+
+QList<int> ThreadScheduling::parseCpuList(const QString& text) {
+    QList<int> cpus;
+    for (const QString& part : text.split(',', Qt::SkipEmptyParts)) {
+        const QStringList range = part.trimmed().split('-');
+        bool firstOk = false;
+        bool lastOk = false;
+        const int first = range.first().toInt(&firstOk);
+        const int last = range.size() == 2 ? range.last().toInt(&lastOk) : first;
+        if (!firstOk || (range.size() == 2 && !lastOk) || range.size() > 2 || first < 0 ||
+            last < first) {
+            return {};
+        }
+        for (int cpu = first; cpu <= last; ++cpu) {
+            if (!cpus.contains(cpu)) {
+                cpus.append(cpu);
+            }
+        }
+    }
+    return cpus;
+}
+
+//=============================================================================
+// Applying
+//=============================================================================
+
+ThreadScheduling::Result ThreadScheduling::applyToCurrentThread(const Config& config) {
+    Result result;
+
+    if (!config.cpus.isEmpty()) {
+        const long cpuCount = sysconf(_SC_NPROCESSORS_CONF);
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        QList<int> usable;
+        for (int cpu : config.cpus) {
+            if (cpu < cpuCount && cpu < CPU_SETSIZE) {
+                CPU_SET(static_cast<size_t>(cpu), &set);
+                usable.append(cpu);
+            } else {
+                result.problems.append(QStringLiteral("CPU %1 does not exist").arg(cpu));
+            }
+        }
+        if (!usable.isEmpty()) {
+            const int error = pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+            if (error == 0) {
+                result.cpus = usable;
+            } else {
+                result.problems.append("CPU affinity: " + errorText(error));
+            }
+        }
+    }
+
+    if (config.fifoPriority > 0) {
+        sched_param param{};
+        param.sched_priority = config.fifoPriority;
+        const int error = pthread_setschedparam(pthread_self(), SCHED_FIFO, &param);
+        if (error == 0) {
+            result.fifoApplied = true;
+            result.fifoPriority = config.fifoPriority;
+        } else if (error == EPERM) {
+            result.problems.append(
+                "SCHED_FIFO not permitted (needs CAP_SYS_NICE or an rtprio limit)");
+        } else {
+            result.problems.append("SCHED_FIFO: " + errorText(error));
+        }
+    }
+
+    if (config.lockMemory) {
+        // MCL_CURRENT only: MCL_FUTURE would make every later allocation of
+        // the GUI and GPU driver count against RLIMIT_MEMLOCK and fail
+        if (mlockall(MCL_CURRENT) == 0) {
+            result.memoryLocked = true;
+            prefaultStack();
+        } else if (errno == EPERM || errno == ENOMEM) {
+            result.problems.append(
+                "Memory lock not permitted (needs CAP_IPC_LOCK or a higher memlock limit)");
+        } else {
+            result.problems.append("Memory lock: " + errorText(errno));
+        }
+    }
+
+    return result;
+}
+
+//=============================================================================
+// Reporting
+//=============================================================================
+
+QString ThreadScheduling::Result::summary() const {
+    QStringList parts;
+    parts.append(fifoApplied ? QStringLiteral("SCHED_FIFO priority %1").arg(fifoPriority)
+                             : QStringLiteral("normal scheduling"));
+    parts.append(cpus.isEmpty() ? QStringLiteral("any CPU") : "CPUs " + joinCpus(cpus));
+    parts.append(memoryLocked ? QStringLiteral("memory locked")
+                              : QStringLiteral("memory not locked"));
+    return parts.join(", ");
+}
+
+QJsonObject ThreadScheduling::Result::toJson() const {
+    QJsonArray cpuArray;
+    for (int cpu : cpus) {
+        cpuArray.append(cpu);
+    }
+    QJsonObject json;
+    json["fifo"] = fifoApplied;
+    json["priority"] = fifoPriority;
+    json["cpus"] = cpuArray;
+    json["memoryLocked"] = memoryLocked;
+    json["problems"] = QJsonArray::fromStringList(problems);
+    return json;
+}
+
+} // namespace devdash
@@ -0,0 +1,88 @@
+#pragma once
+
+#include <QJsonObject>
+#include <QList>
+#include <QString>
+#include <QStringList>
+
+namespace devdash {
+
+/**
+ * @brief Real-time scheduling, CPU affinity and memory locking for a thread
+ *
+ * Used for the adapter I/O thread so CAN reception does not queue behind the
+ * render and GUI threads. Everything is best effort: without CAP_SYS_NICE /
+ * CAP_IPC_LOCK (or matching `ulimit -r` / `ulimit -l`) the thread keeps
+ * normal scheduling and the Result says what was and was not applied.
+ *
+ * Profile syntax (all keys optional):
+ * @code
+ * "ioThread": {
+ *     "priority": 50,      // SCHED_FIFO priority 1-99, 0 = normal scheduling
+ *     "cpus": [3],         // pin to these CPU indices
+ *     "lockMemory": true   // lock mapped pages in RAM (no page faults later)
+ * }
+ * @endcode
+ *
+ * @note Linux only.
+ */
+class ThreadScheduling {
+  public:
+    /// SCHED_FIFO priority range
+    static constexpr int MIN_FIFO_PRIORITY = 1;
+    static constexpr int MAX_FIFO_PRIORITY = 99;
+
+    /**
+     * @brief Requested scheduling for a thread
+     */
+    struct Config {
+        int fifoPriority = 0;     ///< SCHED_FIFO priority, 0 = keep normal scheduling
+        QList<int> cpus;          ///< CPUs the thread may run on, empty = any
+        bool lockMemory = false;  ///< mlockall(MCL_CURRENT) and prefault the thread stack
+    };
+
+    /**
+     * @brief What applyToCurrentThread() actually achieved
+     */
+    struct Result {
+        bool fifoApplied = false;    ///< Running under SCHED_FIFO at fifoPriority
+        int fifoPriority = 0;
+        QList<int> cpus;             ///< CPUs pinned to (empty = not pinned)
+        bool memoryLocked = false;
+        QStringList problems;        ///< Requested settings that could not be applied
+
+        /**
+         * @brief One-line description for the log
+         */
+        [[nodiscard]] QString summary() const;
+
+        /**
+         * @brief Result as JSON (for diagnostics endpoints)
+         */
+        [[nodiscard]] QJsonObject toJson() const;
+    };
+
+    /**
+     * @brief Parse a profile "ioThread" object
+     *
+     * Out-of-range priorities are clamped, negative CPU indices dropped.
+     */
+    [[nodiscard]] static Config fromJson(const QJsonObject& object);
+
+    /**
+     * @brief Parse a CPU list such as "2,3" or "0-1,4"
+     *
+     * @return CPU indices, empty if the text is not a valid list
+     */
+    [[nodiscard]] static QList<int> parseCpuList(const QString& text);
+
+    /**
+     * @brief Apply a configuration to the calling thread
+     *
+     * Never fails: settings the process is not allowed to make are skipped
+     * and listed in Result::problems.
+     */
+    [[nodiscard]] static Result applyToCurrentThread(const Config& config);
+};
+
+} // namespace devdash
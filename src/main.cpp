@@ -20,6 +20,13 @@
  *
  * # Run both displays on specific screens
  * ./devdash --profile profiles/haltech-vcan.json --cluster-screen 0 --headunit-screen 1
+ *
+ * # CAN I/O on its own real-time thread, pinned to CPU 3
+ * ./devdash --profile profiles/haltech-vcan.json --io-priority 50 --io-cpus 3 --io-lock-memory
+ *
+ * # Daily log files, 14 compressed generations, at most 100MB on the SD card
+ * ./devdash --profile profiles/haltech-vcan.json --log-file /var/log/devdash/devdash.log \
+ *     --log-max-age 24 --log-generations 14 --log-max-total 100
  * @endcode
  */
 
@@ -35,6 +42,7 @@
 #include <QCommandLineParser>
 #include <QGuiApplication>
 
+#include <array>
 #include <memory>
 
 namespace {
@@ -65,6 +73,17 @@ constexpr int EXIT_INVALID_ARGS = 2;
 /// Default screen index (-1 = auto-select)
 constexpr const char* DEFAULT_SCREEN_INDEX = "-1";
 
+//=============================================================================
+// Log Rotation Options
+//=============================================================================
+
+constexpr qint64 BYTES_PER_MEGABYTE = 1024LL * 1024LL;
+constexpr qint64 MS_PER_HOUR = 60LL * 60LL * 1000LL;
+
+/// Options that take a whole number >= 0
+constexpr std::array LOG_ROTATION_NUMBER_OPTIONS = {
+    "log-max-size", "log-max-age", "log-generations", "log-max-total"};
+
 //=============================================================================
 // Command Line Setup
 //=============================================================================
@@ -97,6 +116,28 @@ void setupCommandLineOptions(QCommandLineParser& parser) {
                       "info"});
 
     parser.addOption({"log-file", "Enable file logging to specified path", "path"});
+
+    parser.addOption({"log-max-size", "Rotate the log file at this size in MB (0 = no limit)",
+                      "mb"});
+
+    parser.addOption({"log-max-age", "Rotate the log file after this many hours (0 = no limit)",
+                      "hours"});
+
+    parser.addOption({"log-generations", "Rotated log files to keep", "count"});
+
+    parser.addOption({"log-max-total",
+                      "Disk budget for the log file and rotated files in MB (0 = no limit)",
+                      "mb"});
+
+    parser.addOption({"log-no-compress", "Keep rotated log files uncompressed"});
+
+    // Adapter I/O thread options (override the profile "ioThread" object)
+    parser.addOption({"io-priority", "Run adapter I/O on a SCHED_FIFO thread (priority 1-99)",
+                      "priority"});
+
+    parser.addOption({"io-cpus", "Pin the adapter I/O thread to CPUs (e.g. 3 or 2-3)", "cpus"});
+
+    parser.addOption({"io-lock-memory", "Lock process memory in RAM for the adapter I/O thread"});
 }
 
 /**
@@ -109,9 +150,83 @@ bool validateArguments(const QCommandLineParser& parser) {
         qCritical() << "Cannot specify both --cluster-only and --headunit-only";
         return false;
     }
+    if (parser.isSet("io-priority")) {
+        bool ok = false;
+        const int priority = parser.value("io-priority").toInt(&ok);
+        if (!ok || priority < devdash::ThreadScheduling::MIN_FIFO_PRIORITY ||
+            priority > devdash::ThreadScheduling::MAX_FIFO_PRIORITY) {
+            qCritical() << "--io-priority must be between"
+                        << devdash::ThreadScheduling::MIN_FIFO_PRIORITY << "and"
+                        << devdash::ThreadScheduling::MAX_FIFO_PRIORITY;
+            return false;
+        }
+    }
+    if (parser.isSet("io-cpus") &&
+        devdash::ThreadScheduling::parseCpuList(parser.value("io-cpus")).isEmpty()) {
+        qCritical() << "Invalid --io-cpus list:" << parser.value("io-cpus");
+        return false;
+    }
+    for (const char* option : LOG_ROTATION_NUMBER_OPTIONS) {
+        if (!parser.isSet(option)) {
+            continue;
+        }
+        bool ok = false;
+        const qint64 value = parser.value(option).toLongLong(&ok);
+        if (!ok || value < 0) {
+            qCritical().noquote() << QStringLiteral("--%1 must be a whole number >= 0").arg(option);
+            return false;
+        }
+    }
     return true;
 }
 
+/**
+ * @brief Log rotation settings from the --log-* options.
+ * @param parser The parsed (and validated) command line
+ * @return LogRotator defaults overridden by the options given
+ */
+devdash::LogRotator::Config logRotationOptions(const QCommandLineParser& parser) {
+    devdash::LogRotator::Config rotation;
+    if (parser.isSet("log-max-size")) {
+        rotation.maxFileBytes = parser.value("log-max-size").toLongLong() * BYTES_PER_MEGABYTE;
+    }
+    if (parser.isSet("log-max-age")) {
+        rotation.maxAgeMs = parser.value("log-max-age").toLongLong() * MS_PER_HOUR;
+    }
+    if (parser.isSet("log-generations")) {
+        rotation.generations = parser.value("log-generations").toInt();
+    }
+    if (parser.isSet("log-max-total")) {
+        rotation.maxTotalBytes = parser.value("log-max-total").toLongLong() * BYTES_PER_MEGABYTE;
+    }
+    rotation.compress = !parser.isSet("log-no-compress");
+    return rotation;
+}
+
+/**
+ * @brief Apply --io-* options on top of the profile's I/O thread settings.
+ * @param parser The parsed (and validated) command line
+ * @param dataBroker Broker whose adapter thread is configured
+ */
+void applyIoThreadOptions(const QCommandLineParser& parser, devdash::DataBroker& dataBroker) {
+    if (!parser.isSet("io-priority") && !parser.isSet("io-cpus") &&
+        !parser.isSet("io-lock-memory")) {
+        return;
+    }
+
+    devdash::ThreadScheduling::Config config = dataBroker.ioThreadConfig();
+    if (parser.isSet("io-priority")) {
+        config.fifoPriority = parser.value("io-priority").toInt();
+    }
+    if (parser.isSet("io-cpus")) {
+        config.cpus = devdash::ThreadScheduling::parseCpuList(parser.value("io-cpus"));
+    }
+    if (parser.isSet("io-lock-memory")) {
+        config.lockMemory = true;
+    }
+    dataBroker.setIoThread(config);
+}
+
 //=============================================================================
 // Adapter Creation
 //=============================================================================
@@ -196,7 +311,8 @@ int main(int argc, char* argv[]) {
     }
 
     if (parser.isSet("log-file")) {
-        devdash::LogManager::instance().setFileOutput(parser.value("log-file"));
+        devdash::LogManager::instance().setFileOutput(parser.value("log-file"),
+                                                      logRotationOptions(parser));
     }
 
     qCInfo(devdash::logApp) << "DevDash starting - version" << APP_VERSION;
@@ -210,6 +326,7 @@ int main(int argc, char* argv[]) {
         qCritical() << "Failed to load profile into DataBroker:" << profilePath;
         return EXIT_ADAPTER_FAILED;
     }
+    applyIoThreadOptions(parser, *dataBroker);
 
     auto adapter = createAdapter(parser);
     if (!adapter) {
@@ -0,0 +1,178 @@
+/**
+ * @file test_bus_monitor.cpp
+ * @brief Unit tests for BusMonitor arrival statistics and bus-load estimation.
+ *
+ * Tests cover:
+ * - Frame bit time for classic, extended and CAN FD frames
+ * - Bus load and frame rate per sampling window
+ * - Jitter and gaps against a declared rate
+ * - Gaps against the measured mean for frames without a declared rate
+ * - Declared frames that never arrive
+ */
+
+#include "adapters/can/BusMonitor.h"
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+
+using Catch::Matchers::WithinAbs;
+using Catch::Matchers::WithinRel;
+
+namespace {
+
+//=============================================================================
+// Test Constants
+//=============================================================================
+
+constexpr int BITRATE_500K = 500000;
+constexpr int DATA_BITRATE_2M = 2000000;
+
+/// 8-byte 11-bit frame: 47 overhead + 64 payload + 24 worst-case stuff bits
+constexpr double CLASSIC_STANDARD_8_BYTE_BITS = 135.0;
+
+/// 8-byte 29-bit frame: 67 overhead + 64 payload + 29 worst-case stuff bits
+constexpr double CLASSIC_EXTENDED_8_BYTE_BITS = 160.0;
+
+constexpr uint32_t RPM_FRAME_ID = 0x360;
+constexpr uint32_t OTHER_FRAME_ID = 0x361;
+constexpr uint32_t SILENT_FRAME_ID = 0x3E0;
+
+/// Declared 50 Hz → 20 ms interval
+constexpr double RPM_RATE_HZ = 50.0;
+constexpr qint64 RPM_INTERVAL_US = 20000;
+
+constexpr qint64 ONE_SECOND_US = 1000000;
+constexpr double TOLERANCE = 0.001;
+
+QCanBusFrame makeFrame(uint32_t frameId, int payloadBytes = 8) {
+    return QCanBusFrame(frameId, QByteArray(payloadBytes, '\0'));
+}
+
+} // anonymous namespace
+
+TEST_CASE("BusMonitor estimates frame bit time", "[can][busmonitor]") {
+    SECTION("classic 11-bit frame") {
+        const double duration =
+            devdash::BusMonitor::frameDuration(makeFrame(RPM_FRAME_ID), BITRATE_500K, 0);
+        REQUIRE_THAT(duration, WithinRel(CLASSIC_STANDARD_8_BYTE_BITS / BITRATE_500K));
+    }
+
+    SECTION("classic 29-bit frame") {
+        QCanBusFrame frame = makeFrame(0x18FF0001);
+        frame.setExtendedFrameFormat(true);
+        const double duration = devdash::BusMonitor::frameDuration(frame, BITRATE_500K, 0);
+        REQUIRE_THAT(duration, WithinRel(CLASSIC_EXTENDED_8_BYTE_BITS / BITRATE_500K));
+    }
+
+    SECTION("CAN FD data phase runs at the data bitrate with bit-rate switch") {
+        QCanBusFrame frame = makeFrame(RPM_FRAME_ID, 64);
+        frame.setFlexibleDataRateFormat(true);
+        const double nominal = devdash::BusMonitor::frameDuration(frame, BITRATE_500K, 0);
+
+        frame.setBitrateSwitch(true);
+        const double switched =
+            devdash::BusMonitor::frameDuration(frame, BITRATE_500K, DATA_BITRATE_2M);
+        REQUIRE(switched < nominal);
+        REQUIRE(nominal > 64 * 8.0 / BITRATE_500K);
+    }
+}
+
+TEST_CASE("BusMonitor measures load per window", "[can][busmonitor]") {
+    devdash::BusMonitor monitor;
+    monitor.setBitrate(BITRATE_500K, 0);
+
+    // 1000 frames in one second
+    constexpr int FRAME_COUNT = 1000;
+    for (int i = 0; i < FRAME_COUNT; ++i) {
+        monitor.recordFrame(makeFrame(RPM_FRAME_ID), i * 1000);
+    }
+
+    auto stats = monitor.sample(ONE_SECOND_US);
+    REQUIRE(stats.frames == FRAME_COUNT);
+    REQUIRE_THAT(stats.framesPerSecond, WithinRel(1000.0));
+    REQUIRE_THAT(stats.load, WithinRel(FRAME_COUNT * CLASSIC_STANDARD_8_BYTE_BITS / BITRATE_500K));
+
+    SECTION("window counters restart after sampling") {
+        auto next = monitor.sample(ONE_SECOND_US);
+        REQUIRE(next.frames == 0);
+        REQUIRE(next.load == 0.0);
+        REQUIRE(monitor.totalFrames() == FRAME_COUNT);
+    }
+}
+
+TEST_CASE("BusMonitor checks arrivals against the declared rate", "[can][busmonitor]") {
+    devdash::BusMonitor monitor;
+    monitor.setExpectedRate({RPM_FRAME_ID, false}, RPM_RATE_HZ);
+
+    qint64 now = 0;
+    monitor.recordFrame(makeFrame(RPM_FRAME_ID), now);
+    now += RPM_INTERVAL_US;
+    monitor.recordFrame(makeFrame(RPM_FRAME_ID), now);
+
+    SECTION("on-time frames have no jitter") {
+        auto frames = monitor.frameStats();
+        REQUIRE(frames.size() == 1);
+        REQUIRE(frames[0].count == 2);
+        REQUIRE(frames[0].declaredHz == RPM_RATE_HZ);
+        REQUIRE_THAT(frames[0].measuredHz, WithinRel(RPM_RATE_HZ));
+        REQUIRE(frames[0].maxJitterMs == 0.0);
+        REQUIRE(frames[0].gaps == 0);
+    }
+
+    SECTION("late frames raise jitter") {
+        now += RPM_INTERVAL_US + 2000;
+        monitor.recordFrame(makeFrame(RPM_FRAME_ID), now);
+
+        auto frames = monitor.frameStats();
+        REQUIRE_THAT(frames[0].maxJitterMs, WithinAbs(2.0, TOLERANCE));
+        REQUIRE(frames[0].jitterMs > 0.0);
+        REQUIRE(frames[0].jitterMs < frames[0].maxJitterMs);
+    }
+
+    SECTION("a missing frame is a gap, not jitter") {
+        now += 5 * RPM_INTERVAL_US;
+        monitor.recordFrame(makeFrame(RPM_FRAME_ID), now);
+
+        auto frames = monitor.frameStats();
+        REQUIRE(frames[0].gaps == 1);
+        REQUIRE_THAT(frames[0].longestGapMs, WithinAbs(100.0, TOLERANCE));
+        REQUIRE(frames[0].maxJitterMs == 0.0);
+        REQUIRE(monitor.sample(ONE_SECOND_US).gaps == 1);
+    }
+}
+
+TEST_CASE("BusMonitor detects gaps without a declared rate", "[can][busmonitor]") {
+    devdash::BusMonitor monitor;
+
+    qint64 now = 0;
+    for (int i = 0; i < 10; ++i) {
+        monitor.recordFrame(makeFrame(OTHER_FRAME_ID), now);
+        now += RPM_INTERVAL_US;
+    }
+    REQUIRE(monitor.frameStats()[0].gaps == 0);
+
+    now += 4 * RPM_INTERVAL_US;
+    monitor.recordFrame(makeFrame(OTHER_FRAME_ID), now);
+    REQUIRE(monitor.frameStats()[0].gaps == 1);
+    REQUIRE(monitor.frameStats()[0].declaredHz == 0.0);
+}
+
+TEST_CASE("BusMonitor reports declared frames that never arrive", "[can][busmonitor]") {
+    devdash::BusMonitor monitor;
+    monitor.setExpectedRate({SILENT_FRAME_ID, false}, RPM_RATE_HZ);
+    monitor.recordFrame(makeFrame(RPM_FRAME_ID), 0);
+
+    auto frames = monitor.frameStats();
+    REQUIRE(frames.size() == 2);
+    REQUIRE(frames[0].key.frameId == RPM_FRAME_ID);
+    REQUIRE(frames[1].key.frameId == SILENT_FRAME_ID);
+    REQUIRE(frames[1].count == 0);
+
+    SECTION("reset keeps declared rates") {
+        monitor.reset();
+        frames = monitor.frameStats();
+        REQUIRE(frames.size() == 1);
+        REQUIRE(frames[0].key.frameId == SILENT_FRAME_ID);
+        REQUIRE(monitor.totalFrames() == 0);
+    }
+}
@@ -0,0 +1,158 @@
+/**
+ * @file test_can_id_filter.cpp
+ * @brief Unit tests for kernel receive filter compression.
+ *
+ * Tests cover:
+ * - Exact filters for scattered IDs
+ * - Free merges of neighbouring IDs
+ * - Filter limit with every requested frame still passing
+ * - Standard and extended IDs kept apart
+ * - Filters of a Haltech + PD16 profile passing the PD16 frames, whose
+ *   channels the profile does not map
+ */
+
+#include "adapters/ProtocolAdapterFactory.h"
+#include "adapters/can/CanAdapter.h"
+#include "adapters/can/CanIdFilter.h"
+
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <memory>
+#include <vector>
+
+namespace {
+
+//=============================================================================
+// Test Constants
+//=============================================================================
+
+constexpr uint32_t STANDARD_EXACT_MASK = 0x7FF;
+constexpr uint32_t EXTENDED_EXACT_MASK = 0x1FFFFFFF;
+
+constexpr uint32_t RPM_FRAME_ID = 0x360;
+constexpr uint32_t PRESSURE_FRAME_ID = 0x361;
+constexpr uint32_t EXTENDED_FRAME_ID = 0x18FF0001;
+
+/// PD16 device A: frame offsets 0..7 from its base ID
+constexpr uint32_t PD16_A_FIRST_FRAME_ID = 0x6D0;
+constexpr uint32_t PD16_A_END_FRAME_ID = 0x6D8;
+
+/**
+ * @brief The Haltech + PD16 development profile, with its protocol files
+ *        resolved against the source tree
+ */
+QJsonObject loadHaltechPd16Profile() {
+    QFile file(QString(SOURCE_DIR) + "/profiles/haltech-vcan.json");
+    REQUIRE(file.open(QIODevice::ReadOnly));
+    QJsonObject profile = QJsonDocument::fromJson(file.readAll()).object();
+    QJsonObject adapterConfig = profile["adapterConfig"].toObject();
+    REQUIRE(adapterConfig["pd16Devices"].toArray().size() == 1);
+    adapterConfig["protocolFile"] =
+        QString(SOURCE_DIR) + "/protocols/haltech/haltech-can-protocol-v2.35.json";
+    adapterConfig["pd16ProtocolFile"] =
+        QString(SOURCE_DIR) + "/protocols/haltech/haltech-pd16-can-protocol.json";
+    profile["adapterConfig"] = adapterConfig;
+    return profile;
+}
+
+bool anyMatches(const std::vector<devdash::CanIdFilter>& filters, const devdash::FrameKey& key) {
+    for (const auto& filter : filters) {
+        if (filter.matches(key)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+} // anonymous namespace
+
+TEST_CASE("CanIdFilter keeps scattered IDs exact", "[can][filter]") {
+    auto filters = devdash::CanIdFilter::compress({{0x100, false}, {0x2A5, false}, {0x6F0, false}});
+
+    REQUIRE(filters.size() == 3);
+    for (const auto& filter : filters) {
+        REQUIRE(filter.mask == STANDARD_EXACT_MASK);
+        REQUIRE(filter.coveredIdCount() == 1);
+    }
+    REQUIRE(filters[0].frameId == 0x100);
+    REQUIRE_FALSE(anyMatches(filters, {0x101, false}));
+}
+
+TEST_CASE("CanIdFilter merges neighbouring IDs without extra IDs", "[can][filter]") {
+    auto filters = devdash::CanIdFilter::compress(
+        {{PRESSURE_FRAME_ID, false}, {RPM_FRAME_ID, false}, {RPM_FRAME_ID, false}});
+
+    REQUIRE(filters.size() == 1);
+    REQUIRE(filters[0].frameId == RPM_FRAME_ID);
+    REQUIRE(filters[0].mask == 0x7FE);
+    REQUIRE(filters[0].coveredIdCount() == 2);
+}
+
+TEST_CASE("CanIdFilter stays within the filter limit", "[can][filter]") {
+    // Haltech-like layout: most IDs between 0x360 and 0x3EA, a few outliers
+    std::vector<devdash::FrameKey> frames;
+    for (uint32_t frameId = 0x360; frameId <= 0x3EA; frameId += 3) {
+        frames.push_back({frameId, false});
+    }
+    frames.push_back({0x6F0, false});
+    frames.push_back({0x0A0, false});
+
+    constexpr int MAX_FILTERS = 4;
+    auto filters = devdash::CanIdFilter::compress(frames, MAX_FILTERS);
+
+    REQUIRE(filters.size() <= MAX_FILTERS);
+    for (const auto& key : frames) {
+        REQUIRE(anyMatches(filters, key));
+    }
+
+    SECTION("outliers do not widen the main range") {
+        uint64_t covered = 0;
+        for (const auto& filter : filters) {
+            covered += filter.coveredIdCount();
+        }
+        REQUIRE(covered < 0x800 / 4);
+    }
+}
+
+TEST_CASE("CanIdFilter never mixes frame formats", "[can][filter]") {
+    auto filters = devdash::CanIdFilter::compress(
+        {{EXTENDED_FRAME_ID, true}, {RPM_FRAME_ID, false}, {EXTENDED_FRAME_ID + 1, true}}, 1);
+
+    REQUIRE(filters.size() == 2);
+    REQUIRE_FALSE(filters[0].extended);
+    REQUIRE(filters[1].extended);
+    REQUIRE(filters[1].mask == (EXTENDED_EXACT_MASK & ~0x3U));
+    REQUIRE(anyMatches(filters, {EXTENDED_FRAME_ID, true}));
+    REQUIRE_FALSE(anyMatches(filters, {RPM_FRAME_ID, true}));
+    REQUIRE_FALSE(anyMatches(filters, {EXTENDED_FRAME_ID & STANDARD_EXACT_MASK, false}));
+
+    SECTION("no frames, no filters") {
+        REQUIRE(devdash::CanIdFilter::compress({}).empty());
+    }
+}
+
+TEST_CASE("CanAdapter kernel filter passes unmapped PD16 frames", "[can][filter][pd16]") {
+    auto adapter = devdash::ProtocolAdapterFactory::createFromConfig(loadHaltechPd16Profile());
+    auto* canAdapter = dynamic_cast<devdash::CanAdapter*>(adapter.get());
+    REQUIRE(canAdapter != nullptr);
+
+    canAdapter->buildReceiveFilters();
+    const auto& filters = canAdapter->receiveFilters();
+    REQUIRE_FALSE(filters.empty());  // The mapped Haltech channels do filter
+    REQUIRE(anyMatches(filters, {RPM_FRAME_ID, false}));
+
+    int pd16Frames = 0;
+    for (const auto& key : canAdapter->router().routedFrames()) {
+        if (!key.extended && key.frameId >= PD16_A_FIRST_FRAME_ID &&
+            key.frameId < PD16_A_END_FRAME_ID) {
+            REQUIRE(anyMatches(filters, key));
+            ++pd16Frames;
+        }
+    }
+    REQUIRE(pd16Frames > 0);
+}
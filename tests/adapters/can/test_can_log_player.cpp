@@ -0,0 +1,303 @@
+/**
+ * @file test_can_log_player.cpp
+ * @brief Tests for replaying recorded CAN logs.
+ *
+ * Tests cover:
+ * - candump -L line parsing (classic, 29-bit, remote, CAN FD, error frames)
+ * - Playback of candump text and binary logs as fast as possible
+ * - Looping and seeking with the time index
+ * - Real-time pacing at a scaled speed
+ * - The "replay" adapter type decoding a session through HaltechAdapter
+ */
+
+#include "adapters/ProtocolAdapterFactory.h"
+#include "adapters/can/CanAdapter.h"
+#include "adapters/can/CanLogPlayer.h"
+#include "adapters/can/CanRecorder.h"
+#include "adapters/can/CandumpLogReader.h"
+
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QJsonObject>
+#include <QSignalSpy>
+#include <QTemporaryDir>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <functional>
+#include <vector>
+
+namespace {
+
+//=============================================================================
+// Test Constants
+//=============================================================================
+
+constexpr uint32_t RPM_FRAME_ID = 0x360;
+constexpr uint32_t EXTENDED_FRAME_ID = 0x18FF0001;
+
+/// 2025-01-01 12:00:00 UTC
+constexpr int64_t SESSION_START_SECONDS = 1735732800LL;
+constexpr int64_t NS_PER_SECOND = 1000000000LL;
+constexpr int64_t NS_PER_MS = 1000000;
+constexpr int64_t US_PER_SECOND = 1000000;
+constexpr int64_t US_PER_MS = 1000;
+
+constexpr int FRAME_PERIOD_MS = 100;
+constexpr int SESSION_FRAMES = 50;  // five seconds
+
+/// 3500 RPM, as in the Haltech protocol tests
+constexpr const char* RPM_PAYLOAD = "0DAC03F501F40000";
+constexpr double TEST_RPM_VALUE = 3500.0;
+
+constexpr int SPIN_TIMEOUT_MS = 5000;
+
+/// Writes a candump -L log of SESSION_FRAMES RPM frames, FRAME_PERIOD_MS apart
+QString writeCandumpSession(const QTemporaryDir& dir, int periodMs = FRAME_PERIOD_MS,
+                            int frames = SESSION_FRAMES) {
+    const QString path = dir.filePath("session.log");
+    QFile file(path);
+    REQUIRE(file.open(QIODevice::WriteOnly));
+    for (int i = 0; i < frames; ++i) {
+        const int64_t offsetUs = static_cast<int64_t>(i) * periodMs * US_PER_MS;
+        file.write(QStringLiteral("(%1.%2) vcan0 360#%3\n")
+                       .arg(SESSION_START_SECONDS + offsetUs / US_PER_SECOND)
+                       .arg(offsetUs % US_PER_SECOND, 6, 10, QChar('0'))
+                       .arg(RPM_PAYLOAD)
+                       .toLatin1());
+    }
+    return path;
+}
+
+bool spinUntil(const std::function<bool()>& done) {
+    QElapsedTimer timer;
+    timer.start();
+    while (!done()) {
+        if (timer.elapsed() > SPIN_TIMEOUT_MS) {
+            return false;
+        }
+        QCoreApplication::processEvents(QEventLoop::AllEvents, 10);
+    }
+    return true;
+}
+
+devdash::CanLogPlayer::Options maxSpeed(const QString& path) {
+    devdash::CanLogPlayer::Options options;
+    options.path = path;
+    options.speed = 0.0;
+    return options;
+}
+
+} // anonymous namespace
+
+TEST_CASE("CandumpLogReader parses candump -L lines", "[can][replay]") {
+    devdash::RawCanFrame frame;
+    std::string interfaceName;
+
+    SECTION("classic frame") {
+        REQUIRE(devdash::CandumpLogReader::parseLine(
+            "(1735732800.000001) vcan0 360#0102030405060708", frame, &interfaceName));
+        REQUIRE(interfaceName == "vcan0");
+        REQUIRE(frame.frameId == RPM_FRAME_ID);
+        REQUIRE_FALSE(frame.extended);
+        REQUIRE(frame.length == 8);
+        REQUIRE(frame.data[7] == 8);
+        REQUIRE(frame.timestampNs == SESSION_START_SECONDS * NS_PER_SECOND + 1000);
+    }
+
+    SECTION("29-bit frame") {
+        REQUIRE(devdash::CandumpLogReader::parseLine("(1.5) can1 18FF0001#0102", frame));
+        REQUIRE(frame.extended);
+        REQUIRE(frame.frameId == EXTENDED_FRAME_ID);
+        REQUIRE(frame.timestampNs == NS_PER_SECOND + NS_PER_SECOND / 2);
+    }
+
+    SECTION("remote request") {
+        REQUIRE(devdash::CandumpLogReader::parseLine("(1.0) can0 360#R", frame));
+        REQUIRE(frame.remote);
+        REQUIRE(devdash::CandumpLogReader::parseLine("(1.0) can0 360#R4", frame));
+        REQUIRE(frame.length == 4);
+    }
+
+    SECTION("CAN FD frame") {
+        REQUIRE(devdash::CandumpLogReader::parseLine(
+            "(1.0) can0 360##10102030405060708090A0B0C", frame));
+        REQUIRE(frame.flexibleDataRate);
+        REQUIRE(frame.bitrateSwitch);
+        REQUIRE(frame.length == 12);
+        REQUIRE(frame.data[11] == 0x0C);
+    }
+
+    SECTION("error frames and malformed lines") {
+        REQUIRE_FALSE(devdash::CandumpLogReader::parseLine("(1.0) can0 20000004#0000", frame));
+        REQUIRE_FALSE(devdash::CandumpLogReader::parseLine("(1.0) can0 800#00", frame));
+        REQUIRE_FALSE(devdash::CandumpLogReader::parseLine("(1.0) can0 360#010", frame));
+        REQUIRE_FALSE(
+            devdash::CandumpLogReader::parseLine("(1.0) can0 360#010203040506070809", frame));
+        REQUIRE_FALSE(devdash::CandumpLogReader::parseLine("can0 360#01", frame));
+    }
+}
+
+TEST_CASE("CanLogPlayer plays logs as fast as possible", "[can][replay]") {
+    QTemporaryDir dir;
+    REQUIRE(dir.isValid());
+
+    QString path;
+    SECTION("candump text") {
+        path = writeCandumpSession(dir);
+    }
+    SECTION("binary log") {
+        devdash::CanRecorder recorder;
+        devdash::CanRecorder::Options options;
+        options.path = dir.filePath("session.ddcan").toStdString();
+        options.interfaceName = "vcan0";
+        REQUIRE(recorder.start(options));
+        for (int i = 0; i < SESSION_FRAMES; ++i) {
+            devdash::RawCanFrame frame;
+            frame.frameId = RPM_FRAME_ID;
+            frame.length = 8;
+            frame.timestampNs =
+                SESSION_START_SECONDS * NS_PER_SECOND + i * FRAME_PERIOD_MS * NS_PER_MS;
+            REQUIRE(recorder.record(frame));
+        }
+        recorder.stop();
+        path = QString::fromStdString(options.path);
+    }
+
+    devdash::CanLogPlayer player;
+    std::vector<int64_t> timestamps;
+    player.setFrameHandler([&timestamps](const devdash::RawCanFrame& frame) {
+        timestamps.push_back(frame.timestampNs);
+    });
+    REQUIRE(player.open(maxSpeed(path)));
+
+    QSignalSpy finished(&player, &devdash::CanLogPlayer::finished);
+    player.start();
+    REQUIRE(spinUntil([&finished]() { return finished.count() > 0; }));
+
+    REQUIRE_FALSE(player.isPlaying());
+    REQUIRE(player.framesPlayed() == SESSION_FRAMES);
+    REQUIRE(timestamps.size() == SESSION_FRAMES);
+    REQUIRE(std::is_sorted(timestamps.begin(), timestamps.end()));
+    REQUIRE(timestamps.front() == SESSION_START_SECONDS * NS_PER_SECOND);
+}
+
+TEST_CASE("CanLogPlayer loops and seeks", "[can][replay]") {
+    QTemporaryDir dir;
+    auto options = maxSpeed(writeCandumpSession(dir));
+
+    devdash::CanLogPlayer player;
+    std::vector<int64_t> timestamps;
+    player.setFrameHandler([&timestamps](const devdash::RawCanFrame& frame) {
+        timestamps.push_back(frame.timestampNs);
+    });
+
+    SECTION("start offset") {
+        options.startSeconds = 2.0;
+        REQUIRE(player.open(options));
+        REQUIRE(player.positionSeconds() == 2.0);
+        player.start();
+        REQUIRE(spinUntil([&player]() { return !player.isPlaying(); }));
+
+        REQUIRE(timestamps.size() == SESSION_FRAMES - 2 * 1000 / FRAME_PERIOD_MS);
+        REQUIRE(timestamps.front() == (SESSION_START_SECONDS + 2) * NS_PER_SECOND);
+    }
+
+    SECTION("looping") {
+        options.loop = true;
+        REQUIRE(player.open(options));
+        player.start();
+        REQUIRE(spinUntil([&player]() { return player.loopCount() >= 2; }));
+        player.stop();
+
+        REQUIRE(player.framesPlayed() >= 2 * SESSION_FRAMES);
+        REQUIRE(timestamps[SESSION_FRAMES] == timestamps.front());
+    }
+
+    SECTION("seek while stopped") {
+        REQUIRE(player.open(options));
+        player.seek(4.05);
+        player.start();
+        REQUIRE(spinUntil([&player]() { return !player.isPlaying(); }));
+
+        REQUIRE(timestamps.size() == 9);
+        REQUIRE(timestamps.front() == (SESSION_START_SECONDS + 4) * NS_PER_SECOND +
+                                          FRAME_PERIOD_MS * NS_PER_MS);
+    }
+}
+
+TEST_CASE("CanLogPlayer paces playback by the recorded timestamps", "[can][replay]") {
+    constexpr int PERIOD_MS = 20;
+    constexpr int FRAMES = 10;
+    constexpr double SPEED = 2.0;
+    // Last frame is due (FRAMES - 1) * PERIOD_MS / SPEED after the first
+    constexpr auto MIN_DURATION_MS = static_cast<qint64>((FRAMES - 1) * PERIOD_MS / SPEED);
+
+    QTemporaryDir dir;
+    devdash::CanLogPlayer::Options options;
+    options.path = writeCandumpSession(dir, PERIOD_MS, FRAMES);
+    options.speed = SPEED;
+
+    devdash::CanLogPlayer player;
+    REQUIRE(player.open(options));
+    QElapsedTimer elapsed;
+    elapsed.start();
+    player.start();
+    REQUIRE(spinUntil([&player]() { return !player.isPlaying(); }));
+
+    REQUIRE(player.framesPlayed() == FRAMES);
+    REQUIRE(elapsed.elapsed() >= MIN_DURATION_MS);
+}
+
+TEST_CASE("Replay adapter decodes a recorded session", "[can][replay][factory]") {
+    const QString protocolPath =
+        QString(SOURCE_DIR) + "/protocols/haltech/haltech-can-protocol-v2.35.json";
+    if (!QFile::exists(protocolPath)) {
+        SKIP("Protocol file not found");
+    }
+    QTemporaryDir dir;
+
+    QJsonObject replay;
+    replay["file"] = writeCandumpSession(dir);
+    replay["speed"] = "max";
+    QJsonObject config;
+    config["protocol"] = "haltech";
+    config["protocolFile"] = protocolPath;
+    config["replay"] = replay;
+
+    SECTION("frames take the normal decode path") {
+        auto adapter = devdash::ProtocolAdapterFactory::create("replay", config);
+        REQUIRE(adapter != nullptr);
+        auto* canAdapter = qobject_cast<devdash::CanAdapter*>(adapter.get());
+        REQUIRE(canAdapter != nullptr);
+        REQUIRE(canAdapter->isReplaying());
+
+        REQUIRE(adapter->start());
+        REQUIRE(spinUntil([&adapter]() { return adapter->getChannel("RPM").has_value(); }));
+        REQUIRE(adapter->getChannel("RPM")->value == TEST_RPM_VALUE);
+        REQUIRE(adapter->diagnostics()["bus"].toObject()["backend"].toString() == "replay");
+        REQUIRE(canAdapter->seekReplay(1.0));
+        adapter->stop();
+        REQUIRE_FALSE(canAdapter->seekReplay(1.0));
+    }
+
+    SECTION("missing log file fails to start") {
+        replay["file"] = dir.filePath("missing.ddcan");
+        config["replay"] = replay;
+        auto adapter = devdash::ProtocolAdapterFactory::create("replay", config);
+        REQUIRE(adapter != nullptr);
+        REQUIRE_FALSE(adapter->start());
+    }
+
+    SECTION("protocol and log file are required") {
+        QJsonObject unknownProtocol = config;
+        unknownProtocol["protocol"] = "replay";
+        REQUIRE(devdash::ProtocolAdapterFactory::create("replay", unknownProtocol) == nullptr);
+
+        QJsonObject noFile = config;
+        noFile.remove("replay");
+        REQUIRE(devdash::ProtocolAdapterFactory::create("replay", noFile) == nullptr);
+    }
+}
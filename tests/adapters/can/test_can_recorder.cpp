@@ -0,0 +1,340 @@
+/**
+ * @file test_can_recorder.cpp
+ * @brief Tests for binary CAN log recording and reading.
+ *
+ * Tests cover:
+ * - Round trip of classic, 29-bit, remote and CAN FD frames
+ * - Time index and seeking
+ * - candump -L text export
+ * - Frames dropped (not blocked) when the ring is full
+ * - Logs cut short without index footer
+ * - Write failures: log cut back to the last complete write, index kept
+ * - Cost of record() on the receive path (hidden benchmark)
+ *
+ * Run the benchmark with:
+ *
+ *     ./build/debug/tests/devdash_tests "[benchmark]"
+ */
+
+#include "adapters/can/CanLogReader.h"
+#include "adapters/can/CanRecorder.h"
+
+#include <QFile>
+#include <QFileInfo>
+#include <QTemporaryDir>
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <sys/resource.h>
+
+#include <csignal>
+#include <vector>
+
+namespace {
+
+//=============================================================================
+// Test Constants
+//=============================================================================
+
+constexpr const char* TEST_INTERFACE = "vcan0";
+
+constexpr uint32_t RPM_FRAME_ID = 0x360;
+constexpr uint32_t EXTENDED_FRAME_ID = 0x18FF0001;
+
+/// 2025-01-01 12:00:00 UTC
+constexpr int64_t SESSION_START_NS = 1735732800LL * 1000000000LL;
+constexpr int64_t NS_PER_MS = 1000000;
+
+constexpr int FRAME_PERIOD_MS = 100;
+constexpr int SESSION_FRAMES = 50;  // five seconds
+constexpr int INDEX_INTERVAL_MS = 1000;
+
+/// Enough classic frames for several full writer buffers
+constexpr int BULK_FRAMES = 6000;
+/// File size limit that lets the first buffer through and cuts the second one short
+constexpr rlim_t WRITE_LIMIT_BYTES = 96 * 1024;
+
+/// Makes writes past @p bytes fail with EFBIG while in scope
+class FileSizeLimit {
+  public:
+    explicit FileSizeLimit(rlim_t bytes) {
+        getrlimit(RLIMIT_FSIZE, &m_saved);
+        m_savedHandler = std::signal(SIGXFSZ, SIG_IGN);
+        rlimit limit = m_saved;
+        limit.rlim_cur = bytes;
+        setrlimit(RLIMIT_FSIZE, &limit);
+    }
+    ~FileSizeLimit() {
+        setrlimit(RLIMIT_FSIZE, &m_saved);
+        std::signal(SIGXFSZ, m_savedHandler);
+    }
+    FileSizeLimit(const FileSizeLimit&) = delete;
+    FileSizeLimit& operator=(const FileSizeLimit&) = delete;
+
+  private:
+    rlimit m_saved{};
+    void (*m_savedHandler)(int) = SIG_DFL;
+};
+
+devdash::RawCanFrame makeFrame(uint32_t frameId, int64_t timestampNs, uint8_t length = 8) {
+    devdash::RawCanFrame frame;
+    frame.frameId = frameId;
+    frame.timestampNs = timestampNs;
+    frame.length = length;
+    for (uint8_t i = 0; i < length; ++i) {
+        frame.data[i] = static_cast<uint8_t>(i + 1);
+    }
+    return frame;
+}
+
+devdash::CanRecorder::Options makeOptions(const QTemporaryDir& dir) {
+    devdash::CanRecorder::Options options;
+    options.path = dir.filePath("session.ddcan").toStdString();
+    options.interfaceName = TEST_INTERFACE;
+    options.indexIntervalMs = INDEX_INTERVAL_MS;
+    return options;
+}
+
+/// Records SESSION_FRAMES frames, FRAME_PERIOD_MS apart
+void recordSession(devdash::CanRecorder& recorder) {
+    for (int i = 0; i < SESSION_FRAMES; ++i) {
+        REQUIRE(recorder.record(
+            makeFrame(RPM_FRAME_ID, SESSION_START_NS + i * FRAME_PERIOD_MS * NS_PER_MS)));
+    }
+}
+
+std::vector<devdash::RawCanFrame> readAll(devdash::CanLogReader& reader) {
+    std::vector<devdash::RawCanFrame> frames;
+    devdash::RawCanFrame frame;
+    while (reader.next(frame)) {
+        frames.push_back(frame);
+    }
+    return frames;
+}
+
+} // anonymous namespace
+
+TEST_CASE("CanRecorder round trip", "[can][recorder]") {
+    QTemporaryDir dir;
+    REQUIRE(dir.isValid());
+
+    devdash::RawCanFrame extended = makeFrame(EXTENDED_FRAME_ID, SESSION_START_NS + 1);
+    extended.extended = true;
+    devdash::RawCanFrame remote = makeFrame(RPM_FRAME_ID, SESSION_START_NS + 2, 0);
+    remote.remote = true;
+    devdash::RawCanFrame flexible = makeFrame(RPM_FRAME_ID, SESSION_START_NS + 3, 64);
+    flexible.flexibleDataRate = true;
+    flexible.bitrateSwitch = true;
+
+    devdash::CanRecorder recorder;
+    REQUIRE(recorder.start(makeOptions(dir)));
+    REQUIRE(recorder.record(makeFrame(RPM_FRAME_ID, SESSION_START_NS)));
+    REQUIRE(recorder.record(extended));
+    REQUIRE(recorder.record(remote));
+    REQUIRE(recorder.record(flexible));
+    recorder.stop();
+
+    REQUIRE(recorder.recordedFrames() == 4);
+    REQUIRE(recorder.droppedFrames() == 0);
+    REQUIRE_FALSE(recorder.hasWriteError());
+
+    devdash::CanLogReader reader;
+    REQUIRE(reader.open(recorder.path()));
+    REQUIRE(reader.interfaceName() == TEST_INTERFACE);
+    REQUIRE(reader.hasStoredIndex());
+
+    const auto frames = readAll(reader);
+    REQUIRE(frames.size() == 4);
+    REQUIRE(frames[0].frameId == RPM_FRAME_ID);
+    REQUIRE(frames[0].timestampNs == SESSION_START_NS);
+    REQUIRE(frames[0].length == 8);
+    REQUIRE(frames[0].data[7] == 8);
+    REQUIRE(frames[1].extended);
+    REQUIRE(frames[1].frameId == EXTENDED_FRAME_ID);
+    REQUIRE(frames[2].remote);
+    REQUIRE(frames[2].length == 0);
+    REQUIRE(frames[3].flexibleDataRate);
+    REQUIRE(frames[3].bitrateSwitch);
+    REQUIRE(frames[3].length == 64);
+    REQUIRE(frames[3].data[63] == 64);
+
+    SECTION("frames without timestamp are stamped") {
+        REQUIRE(recorder.start(makeOptions(dir)));
+        REQUIRE(recorder.record(makeFrame(RPM_FRAME_ID, 0)));
+        recorder.stop();
+
+        REQUIRE(reader.open(recorder.path()));
+        devdash::RawCanFrame frame;
+        REQUIRE(reader.next(frame));
+        REQUIRE(frame.timestampNs > SESSION_START_NS);
+    }
+
+    SECTION("other files are rejected") {
+        QFile other(dir.filePath("other.bin"));
+        REQUIRE(other.open(QIODevice::WriteOnly));
+        other.write("candump text is not a binary log");
+        other.close();
+
+        REQUIRE_FALSE(reader.open(other.fileName().toStdString()));
+        REQUIRE_FALSE(reader.errorString().empty());
+    }
+}
+
+TEST_CASE("CanLogReader seeks with the time index", "[can][recorder]") {
+    QTemporaryDir dir;
+    devdash::CanRecorder recorder;
+    REQUIRE(recorder.start(makeOptions(dir)));
+    recordSession(recorder);
+    recorder.stop();
+
+    devdash::CanLogReader reader;
+    REQUIRE(reader.open(recorder.path()));
+    REQUIRE(reader.index().size() == SESSION_FRAMES * FRAME_PERIOD_MS / INDEX_INTERVAL_MS);
+    REQUIRE(reader.firstTimestampNs() == SESSION_START_NS);
+
+    devdash::RawCanFrame frame;
+    SECTION("between two frames") {
+        reader.seek(SESSION_START_NS + 2350 * NS_PER_MS);
+        REQUIRE(reader.next(frame));
+        REQUIRE(frame.timestampNs == SESSION_START_NS + 2400 * NS_PER_MS);
+    }
+
+    SECTION("before the start") {
+        reader.seek(0);
+        REQUIRE(reader.next(frame));
+        REQUIRE(frame.timestampNs == SESSION_START_NS);
+    }
+
+    SECTION("past the end") {
+        reader.seek(SESSION_START_NS + 3600LL * 1000 * NS_PER_MS);
+        REQUIRE_FALSE(reader.next(frame));
+
+        reader.rewind();
+        REQUIRE(readAll(reader).size() == SESSION_FRAMES);
+    }
+}
+
+TEST_CASE("CanRecorder writes candump text", "[can][recorder]") {
+    QTemporaryDir dir;
+    auto options = makeOptions(dir);
+    options.candump = true;
+
+    devdash::RawCanFrame extended = makeFrame(EXTENDED_FRAME_ID, SESSION_START_NS + 1000, 2);
+    extended.extended = true;
+    devdash::RawCanFrame remote = makeFrame(RPM_FRAME_ID, SESSION_START_NS + 2000, 0);
+    remote.remote = true;
+    devdash::RawCanFrame flexible = makeFrame(RPM_FRAME_ID, SESSION_START_NS + 3000, 12);
+    flexible.flexibleDataRate = true;
+    flexible.bitrateSwitch = true;
+
+    devdash::CanRecorder recorder;
+    REQUIRE(recorder.start(options));
+    REQUIRE(recorder.record(makeFrame(RPM_FRAME_ID, SESSION_START_NS)));
+    REQUIRE(recorder.record(extended));
+    REQUIRE(recorder.record(remote));
+    REQUIRE(recorder.record(flexible));
+    recorder.stop();
+
+    QFile text(QString::fromStdString(options.path + ".log"));
+    REQUIRE(text.open(QIODevice::ReadOnly));
+    const QStringList lines = QString::fromLatin1(text.readAll()).split('\n', Qt::SkipEmptyParts);
+    REQUIRE(lines.size() == 4);
+    REQUIRE(lines[0] == "(1735732800.000000) vcan0 360#0102030405060708");
+    REQUIRE(lines[1] == "(1735732800.000001) vcan0 18FF0001#0102");
+    REQUIRE(lines[2] == "(1735732800.000002) vcan0 360#R");
+    REQUIRE(lines[3] == "(1735732800.000003) vcan0 360##10102030405060708090A0B0C");
+}
+
+TEST_CASE("CanRecorder drops frames instead of blocking", "[can][recorder]") {
+    QTemporaryDir dir;
+    auto options = makeOptions(dir);
+    options.ringCapacity = 4;
+    options.flushIntervalMs = 60000;  // writer only drains on stop()
+
+    devdash::CanRecorder recorder;
+    REQUIRE(recorder.start(options));
+    int queued = 0;
+    for (int i = 0; i < 10; ++i) {
+        queued += recorder.record(makeFrame(RPM_FRAME_ID, SESSION_START_NS + i)) ? 1 : 0;
+    }
+    recorder.stop();
+
+    REQUIRE(queued == 4);
+    REQUIRE(recorder.droppedFrames() == 6);
+    REQUIRE(recorder.recordedFrames() == 4);
+}
+
+TEST_CASE("CanLogReader reads logs cut short", "[can][recorder]") {
+    QTemporaryDir dir;
+    devdash::CanRecorder recorder;
+    REQUIRE(recorder.start(makeOptions(dir)));
+    recordSession(recorder);
+    recorder.stop();
+
+    // Drop the index, the footer and half of the last record, as after a power cut
+    constexpr auto RECORD_SIZE = static_cast<qint64>(devdash::CanLogFormat::RECORD_HEADER_SIZE + 8);
+    QFile log(QString::fromStdString(recorder.path()));
+    const qint64 recordsEnd =
+        static_cast<qint64>(devdash::CanLogFormat::FILE_HEADER_SIZE) + SESSION_FRAMES * RECORD_SIZE;
+    REQUIRE(log.resize(recordsEnd - RECORD_SIZE / 2));
+
+    devdash::CanLogReader reader;
+    REQUIRE(reader.open(recorder.path()));
+    REQUIRE_FALSE(reader.hasStoredIndex());
+    REQUIRE(reader.index().size() == SESSION_FRAMES * FRAME_PERIOD_MS / INDEX_INTERVAL_MS);
+    REQUIRE(readAll(reader).size() == SESSION_FRAMES - 1);
+
+    devdash::RawCanFrame frame;
+    reader.seek(SESSION_START_NS + 1000 * NS_PER_MS);
+    REQUIRE(reader.next(frame));
+    REQUIRE(frame.timestampNs == SESSION_START_NS + 1000 * NS_PER_MS);
+}
+
+TEST_CASE("CanRecorder stops at a write failure and keeps the log seekable", "[can][recorder]") {
+    QTemporaryDir dir;
+    auto options = makeOptions(dir);
+    options.flushIntervalMs = 60000;  // writer only drains on stop()
+
+    devdash::CanRecorder recorder;
+    REQUIRE(recorder.start(options));
+    for (int i = 0; i < BULK_FRAMES; ++i) {
+        REQUIRE(recorder.record(makeFrame(RPM_FRAME_ID, SESSION_START_NS + i * NS_PER_MS)));
+    }
+    {
+        const FileSizeLimit limit(WRITE_LIMIT_BYTES);
+        recorder.stop();
+    }
+
+    REQUIRE(recorder.hasWriteError());
+    REQUIRE(recorder.recordedFrames() > 0);
+    REQUIRE(recorder.lostFrames() > 0);
+    REQUIRE(recorder.recordedFrames() + recorder.lostFrames() == BULK_FRAMES);
+    REQUIRE(QFileInfo(QString::fromStdString(recorder.path())).size() ==
+            static_cast<qint64>(recorder.bytesWritten()));
+
+    devdash::CanLogReader reader;
+    REQUIRE(reader.open(recorder.path()));
+    REQUIRE(reader.hasStoredIndex());
+    REQUIRE(readAll(reader).size() == recorder.recordedFrames());
+
+    devdash::RawCanFrame frame;
+    reader.seek(SESSION_START_NS + INDEX_INTERVAL_MS * NS_PER_MS);
+    REQUIRE(reader.next(frame));
+    REQUIRE(frame.timestampNs == SESSION_START_NS + INDEX_INTERVAL_MS * NS_PER_MS);
+}
+
+TEST_CASE("CanRecorder record() on the receive path", "[.benchmark][recorder]") {
+    QTemporaryDir dir;
+    auto options = makeOptions(dir);
+    options.flushIntervalMs = 1;
+
+    devdash::CanRecorder recorder;
+    REQUIRE(recorder.start(options));
+    const devdash::RawCanFrame frame = makeFrame(RPM_FRAME_ID, SESSION_START_NS);
+
+    BENCHMARK("record one frame") {
+        return recorder.record(frame);
+    };
+    recorder.stop();
+}
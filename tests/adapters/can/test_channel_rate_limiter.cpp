@@ -0,0 +1,77 @@
+/**
+ * @file test_channel_rate_limiter.cpp
+ * @brief Unit tests for ChannelRateLimiter per-channel emission caps.
+ *
+ * Tests cover:
+ * - Uncapped channels always pass
+ * - Values inside the cap interval are held back
+ * - Latest value wins when several are held back
+ * - Held-back values are released once the interval elapses
+ */
+
+#include "adapters/can/ChannelRateLimiter.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+namespace {
+
+//=============================================================================
+// Test Constants
+//=============================================================================
+
+const QString CHANNEL_COOLANT = QStringLiteral("Coolant Temperature");
+const QString CHANNEL_RPM = QStringLiteral("RPM");
+
+/// 5 Hz cap → 200 ms interval
+constexpr double COOLANT_LIMIT_HZ = 5.0;
+constexpr qint64 COOLANT_INTERVAL_MS = 200;
+
+devdash::ChannelValue makeValue(double value) {
+    return devdash::ChannelValue{value, "C", true};
+}
+
+} // anonymous namespace
+
+TEST_CASE("ChannelRateLimiter caps channel emission", "[can][ratelimit]") {
+    devdash::ChannelRateLimiter limiter;
+    REQUIRE(limiter.isEmpty());
+
+    limiter.setLimit(CHANNEL_COOLANT, COOLANT_LIMIT_HZ);
+    REQUIRE_FALSE(limiter.isEmpty());
+    REQUIRE(limiter.shortestIntervalMs() == COOLANT_INTERVAL_MS);
+
+    SECTION("uncapped channels always pass") {
+        REQUIRE(limiter.admit(CHANNEL_RPM, makeValue(1.0), 0));
+        REQUIRE(limiter.admit(CHANNEL_RPM, makeValue(2.0), 1));
+    }
+
+    SECTION("values inside the interval are held back") {
+        REQUIRE(limiter.admit(CHANNEL_COOLANT, makeValue(80.0), 0));
+        REQUIRE_FALSE(limiter.admit(CHANNEL_COOLANT, makeValue(81.0), 50));
+        REQUIRE(limiter.takeDue(100).empty());
+        REQUIRE(limiter.admit(CHANNEL_COOLANT, makeValue(82.0), COOLANT_INTERVAL_MS));
+    }
+
+    SECTION("latest held-back value wins") {
+        REQUIRE(limiter.admit(CHANNEL_COOLANT, makeValue(80.0), 0));
+        REQUIRE_FALSE(limiter.admit(CHANNEL_COOLANT, makeValue(81.0), 50));
+        REQUIRE_FALSE(limiter.admit(CHANNEL_COOLANT, makeValue(82.0), 100));
+
+        auto released = limiter.takeDue(COOLANT_INTERVAL_MS);
+        REQUIRE(released.size() == 1);
+        REQUIRE(released[0].first == CHANNEL_COOLANT);
+        REQUIRE(released[0].second.value == 82.0);
+        REQUIRE(limiter.droppedCount() == 1);
+
+        // Release restarts the interval
+        REQUIRE_FALSE(limiter.admit(CHANNEL_COOLANT, makeValue(83.0), COOLANT_INTERVAL_MS + 1));
+        REQUIRE(limiter.takeDue(COOLANT_INTERVAL_MS + 1).empty());
+    }
+
+    SECTION("removing the cap lets every value through") {
+        limiter.setLimit(CHANNEL_COOLANT, 0.0);
+        REQUIRE(limiter.isEmpty());
+        REQUIRE(limiter.admit(CHANNEL_COOLANT, makeValue(80.0), 0));
+        REQUIRE(limiter.admit(CHANNEL_COOLANT, makeValue(81.0), 1));
+    }
+}
@@ -0,0 +1,404 @@
+/**
+ * @file test_frame_router.cpp
+ * @brief Unit tests for FrameRouter bus-level frame dispatch.
+ *
+ * Tests cover:
+ * - Routing 11-bit and 29-bit identifiers to registered decoders
+ * - First-registered decoder wins on conflicting claims
+ * - Unclaimed frame counting per ID
+ * - Unchanged-payload cache (skip, hit counters, invalidation, CAN FD length),
+ *   kept per mux page of multiplexed frames
+ * - Per-frame rate limits (latest wins, flush, declared vs. measured rates),
+ *   applied per mux page of multiplexed frames
+ * - Haltech ECU and PD16 decoders sharing one router
+ */
+
+#include "adapters/can/FrameRouter.h"
+#include "adapters/haltech/PD16Protocol.h"
+
+#include <QCanBusFrame>
+
+#include <catch2/catch_test_macros.hpp>
+
+namespace {
+
+//=============================================================================
+// Test Constants - CAN Frame IDs
+//=============================================================================
+
+constexpr uint32_t FRAME_ID_ECU = 0x360;
+constexpr uint32_t FRAME_ID_OTHER = 0x361;
+constexpr uint32_t FRAME_ID_EXTENDED = 0x18FEF100;
+constexpr uint32_t FRAME_ID_UNCLAIMED = 0x123;
+
+/// PD16 device B device status frame (base 0x6D8 + offset 5)
+constexpr uint32_t FRAME_ID_PD16_B_STATUS = 0x6DD;
+
+//=============================================================================
+// Test Constants - Rates
+//=============================================================================
+
+/// Haltech 0x360 broadcasts at 50 Hz (20 ms)
+constexpr double ECU_DECLARED_HZ = 50.0;
+constexpr qint64 ECU_PERIOD_MS = 20;
+
+/// 10 Hz cap → 100 ms interval
+constexpr double ECU_LIMIT_HZ = 10.0;
+constexpr qint64 ECU_LIMIT_INTERVAL_MS = 100;
+
+//=============================================================================
+// Test Helpers
+//=============================================================================
+
+/**
+ * @brief Decoder stub that claims a fixed set of frames and emits one channel.
+ */
+class StubDecoder : public devdash::IFrameDecoder {
+  public:
+    StubDecoder(QString channel, std::vector<devdash::FrameKey> frames, double declaredHz = 0.0)
+        : m_channel(std::move(channel)), m_frames(std::move(frames)), m_declaredHz(declaredHz) {}
+
+    [[nodiscard]] std::vector<devdash::FrameKey> claimedFrames() const override {
+        return m_frames;
+    }
+
+    [[nodiscard]] std::vector<std::pair<QString, devdash::ChannelValue>>
+    decode(const QCanBusFrame& frame) const override {
+        ++m_decodeCount;
+        return {{m_channel, devdash::ChannelValue{static_cast<double>(frame.frameId()), "", true}}};
+    }
+
+    [[nodiscard]] double declaredRateHz(const devdash::FrameKey& /*key*/) const override {
+        return m_declaredHz;
+    }
+
+    [[nodiscard]] int decodeCount() const { return m_decodeCount; }
+
+  private:
+    QString m_channel;
+    std::vector<devdash::FrameKey> m_frames;
+    double m_declaredHz;
+    mutable int m_decodeCount = 0;
+};
+
+/**
+ * @brief Stub decoder whose frames are multiplexed by their first byte (like PD16 status pages).
+ */
+class MuxStubDecoder : public StubDecoder {
+  public:
+    using StubDecoder::StubDecoder;
+
+    [[nodiscard]] int64_t multiplexValue(const QCanBusFrame& frame) const override {
+        return frame.payload().isEmpty() ? 0 : static_cast<uint8_t>(frame.payload()[0]);
+    }
+
+    [[nodiscard]] bool isMultiplexed(const devdash::FrameKey& /*key*/) const override {
+        return true;
+    }
+};
+
+QCanBusFrame makeFrame(uint32_t frameId, const char* hexPayload, bool extended = false) {
+    QCanBusFrame frame(frameId, QByteArray::fromHex(hexPayload));
+    frame.setExtendedFrameFormat(extended);
+    return frame;
+}
+
+} // anonymous namespace
+
+//=============================================================================
+// Routing Tests
+//=============================================================================
+
+TEST_CASE("FrameRouter dispatches frames to claiming decoders", "[can][router]") {
+    StubDecoder ecu("ecu", {{FRAME_ID_ECU, false}, {FRAME_ID_OTHER, false}});
+    StubDecoder extended("j1939", {{FRAME_ID_EXTENDED, true}});
+
+    devdash::FrameRouter router;
+    REQUIRE(router.isEmpty());
+    REQUIRE(router.addDecoder(&ecu) == 2);
+    REQUIRE(router.addDecoder(&extended) == 1);
+    REQUIRE(router.routeCount() == 3);
+
+    SECTION("11-bit frame goes to its decoder") {
+        auto results = router.decode(makeFrame(FRAME_ID_ECU, "00"));
+        REQUIRE(results.size() == 1);
+        REQUIRE(results[0].first == "ecu");
+    }
+
+    SECTION("29-bit frame goes to its decoder") {
+        auto results = router.decode(makeFrame(FRAME_ID_EXTENDED, "00", true));
+        REQUIRE(results.size() == 1);
+        REQUIRE(results[0].first == "j1939");
+    }
+
+    SECTION("frame format is part of the key") {
+        REQUIRE(router.lookup(FRAME_ID_ECU, false) == &ecu);
+        REQUIRE(router.lookup(FRAME_ID_ECU, true) == nullptr);
+    }
+
+    SECTION("first registered decoder keeps a conflicting ID") {
+        StubDecoder late("late", {{FRAME_ID_ECU, false}});
+        REQUIRE(router.addDecoder(&late) == 0);
+        REQUIRE(router.lookup(FRAME_ID_ECU, false) == &ecu);
+    }
+
+    SECTION("clear removes all routes") {
+        router.clear();
+        REQUIRE(router.isEmpty());
+        REQUIRE(router.decode(makeFrame(FRAME_ID_ECU, "00")).empty());
+    }
+}
+
+TEST_CASE("FrameRouter counts unclaimed frames", "[can][router]") {
+    StubDecoder ecu("ecu", {{FRAME_ID_ECU, false}});
+    devdash::FrameRouter router;
+    router.addDecoder(&ecu);
+
+    for (int i = 0; i < 3; ++i) {
+        REQUIRE(router.decode(makeFrame(FRAME_ID_UNCLAIMED, "00")).empty());
+    }
+    REQUIRE(router.decode(makeFrame(FRAME_ID_EXTENDED, "00", true)).empty());
+    REQUIRE_FALSE(router.decode(makeFrame(FRAME_ID_ECU, "00")).empty());
+
+    REQUIRE(router.unclaimedFrameCount() == 4);
+
+    auto unclaimed = router.unclaimedFrames();
+    REQUIRE(unclaimed.size() == 2);
+    REQUIRE(unclaimed[0].key.frameId == FRAME_ID_UNCLAIMED);
+    REQUIRE_FALSE(unclaimed[0].key.extended);
+    REQUIRE(unclaimed[0].count == 3);
+    REQUIRE(unclaimed[1].key.frameId == FRAME_ID_EXTENDED);
+    REQUIRE(unclaimed[1].key.extended);
+}
+
+TEST_CASE("FrameRouter shares a bus between ECU and PD16 decoders", "[can][router][pd16]") {
+    StubDecoder ecu("ecu", {{FRAME_ID_ECU, false}});
+    devdash::PD16Protocol pd16;
+    pd16.setDeviceId(devdash::PD16Protocol::DeviceId::B);
+
+    devdash::FrameRouter router;
+    router.addDecoder(&ecu);
+    REQUIRE(router.addDecoder(&pd16) > 0);
+
+    REQUIRE(router.lookup(FRAME_ID_PD16_B_STATUS, false) == &pd16);
+
+    // Device status: in_firmware, FW 2.15.3
+    auto results = router.decode(makeFrame(FRAME_ID_PD16_B_STATUS, "10020F0300000000"));
+    REQUIRE_FALSE(results.empty());
+    REQUIRE(results[0].first.startsWith("pd16_B"));
+
+    REQUIRE(router.decode(makeFrame(FRAME_ID_ECU, "00"))[0].first == "ecu");
+}
+
+//=============================================================================
+// Unchanged-Payload Cache Tests
+//=============================================================================
+
+TEST_CASE("FrameRouter skips unchanged payloads", "[can][router][cache]") {
+    StubDecoder ecu("ecu", {{FRAME_ID_ECU, false}, {FRAME_ID_OTHER, false}});
+    devdash::FrameRouter router;
+    router.addDecoder(&ecu);
+
+    SECTION("repeated payload is decoded once") {
+        REQUIRE_FALSE(router.decode(makeFrame(FRAME_ID_ECU, "0DAC03F501F40000")).empty());
+        REQUIRE(router.decode(makeFrame(FRAME_ID_ECU, "0DAC03F501F40000")).empty());
+        REQUIRE(router.decode(makeFrame(FRAME_ID_ECU, "0DAC03F501F40000")).empty());
+        REQUIRE(ecu.decodeCount() == 1);
+        REQUIRE(router.payloadCacheHits() == 2);
+    }
+
+    SECTION("changed payload is decoded") {
+        REQUIRE_FALSE(router.decode(makeFrame(FRAME_ID_ECU, "0DAC03F501F40000")).empty());
+        REQUIRE_FALSE(router.decode(makeFrame(FRAME_ID_ECU, "0DAD03F501F40000")).empty());
+        REQUIRE(ecu.decodeCount() == 2);
+    }
+
+    SECTION("payload length is part of the comparison") {
+        REQUIRE_FALSE(router.decode(makeFrame(FRAME_ID_ECU, "0DAC")).empty());
+        REQUIRE_FALSE(router.decode(makeFrame(FRAME_ID_ECU, "0DAC00")).empty());
+        REQUIRE(ecu.decodeCount() == 2);
+    }
+
+    SECTION("cache is per frame ID") {
+        REQUIRE_FALSE(router.decode(makeFrame(FRAME_ID_ECU, "01")).empty());
+        REQUIRE_FALSE(router.decode(makeFrame(FRAME_ID_OTHER, "01")).empty());
+        REQUIRE(ecu.decodeCount() == 2);
+    }
+
+    SECTION("64-byte CAN FD payloads compare every word") {
+        QByteArray payload(devdash::FrameRouter::MAX_CACHED_PAYLOAD, '\x11');
+        QCanBusFrame frame(FRAME_ID_ECU, payload);
+        frame.setFlexibleDataRateFormat(true);
+        REQUIRE_FALSE(router.decode(frame).empty());
+        REQUIRE(router.decode(frame).empty());
+
+        payload[devdash::FrameRouter::MAX_CACHED_PAYLOAD - 1] = '\x22';
+        frame.setPayload(payload);
+        REQUIRE_FALSE(router.decode(frame).empty());
+        REQUIRE(ecu.decodeCount() == 2);
+    }
+
+    SECTION("invalidation forces the next frame to decode") {
+        REQUIRE_FALSE(router.decode(makeFrame(FRAME_ID_ECU, "01")).empty());
+        router.invalidatePayloadCache();
+        REQUIRE_FALSE(router.decode(makeFrame(FRAME_ID_ECU, "01")).empty());
+        REQUIRE(ecu.decodeCount() == 2);
+    }
+
+    SECTION("disabled cache decodes every frame") {
+        router.setPayloadCacheEnabled(false);
+        REQUIRE_FALSE(router.decode(makeFrame(FRAME_ID_ECU, "01")).empty());
+        REQUIRE_FALSE(router.decode(makeFrame(FRAME_ID_ECU, "01")).empty());
+        REQUIRE(ecu.decodeCount() == 2);
+    }
+
+    SECTION("reports per-ID hit rate") {
+        for (int i = 0; i < 4; ++i) {
+            (void)router.decode(makeFrame(FRAME_ID_ECU, "01"));
+        }
+        auto stats = router.payloadCacheStats();
+        REQUIRE(stats.size() == 1);
+        REQUIRE(stats[0].key.frameId == FRAME_ID_ECU);
+        REQUIRE(stats[0].hits == 3);
+        REQUIRE(stats[0].misses == 1);
+        REQUIRE(stats[0].hitRate() == 0.75);
+    }
+}
+
+TEST_CASE("FrameRouter caches multiplexed payloads per mux page", "[can][router][cache]") {
+    MuxStubDecoder pd16("pd16", {{FRAME_ID_PD16_B_STATUS, false}});
+    devdash::FrameRouter router;
+    router.addDecoder(&pd16);
+
+    SECTION("alternating unchanged pages are decoded once each") {
+        for (int i = 0; i < 3; ++i) {
+            (void)router.decode(makeFrame(FRAME_ID_PD16_B_STATUS, "0001"));
+            (void)router.decode(makeFrame(FRAME_ID_PD16_B_STATUS, "1001"));
+        }
+        REQUIRE(pd16.decodeCount() == 2);
+
+        auto stats = router.payloadCacheStats();
+        REQUIRE(stats.size() == 1);
+        REQUIRE(stats[0].hits == 4);
+        REQUIRE(stats[0].misses == 2);
+    }
+
+    SECTION("a changed page does not affect the other page") {
+        (void)router.decode(makeFrame(FRAME_ID_PD16_B_STATUS, "0001"));
+        (void)router.decode(makeFrame(FRAME_ID_PD16_B_STATUS, "1001"));
+        REQUIRE_FALSE(router.decode(makeFrame(FRAME_ID_PD16_B_STATUS, "0002")).empty());
+        REQUIRE(router.decode(makeFrame(FRAME_ID_PD16_B_STATUS, "1001")).empty());
+        REQUIRE(pd16.decodeCount() == 3);
+    }
+
+    SECTION("invalidation clears every page") {
+        (void)router.decode(makeFrame(FRAME_ID_PD16_B_STATUS, "0001"));
+        (void)router.decode(makeFrame(FRAME_ID_PD16_B_STATUS, "1001"));
+        router.invalidatePayloadCache();
+        REQUIRE_FALSE(router.decode(makeFrame(FRAME_ID_PD16_B_STATUS, "0001")).empty());
+        REQUIRE_FALSE(router.decode(makeFrame(FRAME_ID_PD16_B_STATUS, "1001")).empty());
+        REQUIRE(pd16.decodeCount() == 4);
+    }
+}
+
+//=============================================================================
+// Rate Limit Tests
+//=============================================================================
+
+TEST_CASE("FrameRouter caps frame decode rate", "[can][router][ratelimit]") {
+    StubDecoder ecu("ecu", {{FRAME_ID_ECU, false}, {FRAME_ID_OTHER, false}}, ECU_DECLARED_HZ);
+    devdash::FrameRouter router;
+    router.addDecoder(&ecu);
+    router.setPayloadCacheEnabled(false);
+
+    REQUIRE_FALSE(router.hasRateLimits());
+    REQUIRE(router.setFrameRateLimit({FRAME_ID_ECU, false}, ECU_LIMIT_HZ));
+    REQUIRE(router.hasRateLimits());
+    REQUIRE(router.shortestRateLimitIntervalMs() == ECU_LIMIT_INTERVAL_MS);
+
+    SECTION("unrouted frames cannot be capped") {
+        REQUIRE_FALSE(router.setFrameRateLimit({FRAME_ID_UNCLAIMED, false}, ECU_LIMIT_HZ));
+    }
+
+    SECTION("frames inside the interval are not decoded") {
+        REQUIRE_FALSE(router.decode(makeFrame(FRAME_ID_ECU, "01"), 0).empty());
+        REQUIRE(router.decode(makeFrame(FRAME_ID_ECU, "02"), ECU_PERIOD_MS).empty());
+        REQUIRE(router.decode(makeFrame(FRAME_ID_ECU, "03"), 2 * ECU_PERIOD_MS).empty());
+        REQUIRE(ecu.decodeCount() == 1);
+
+        // Uncapped IDs are unaffected
+        REQUIRE_FALSE(router.decode(makeFrame(FRAME_ID_OTHER, "01"), 0).empty());
+    }
+
+    SECTION("latest held-back frame is decoded on flush") {
+        REQUIRE_FALSE(router.decode(makeFrame(FRAME_ID_ECU, "01"), 0).empty());
+        REQUIRE(router.decode(makeFrame(FRAME_ID_ECU, "02"), ECU_PERIOD_MS).empty());
+        REQUIRE(router.decode(makeFrame(FRAME_ID_ECU, "03"), 2 * ECU_PERIOD_MS).empty());
+
+        REQUIRE(router.flushPending(ECU_LIMIT_INTERVAL_MS - 1).empty());
+        REQUIRE(router.flushPending(ECU_LIMIT_INTERVAL_MS).size() == 1);
+        REQUIRE(ecu.decodeCount() == 2);
+        REQUIRE(router.flushPending(ECU_LIMIT_INTERVAL_MS).empty());
+    }
+
+    SECTION("frame after the interval is decoded directly") {
+        REQUIRE_FALSE(router.decode(makeFrame(FRAME_ID_ECU, "01"), 0).empty());
+        REQUIRE(router.decode(makeFrame(FRAME_ID_ECU, "02"), ECU_PERIOD_MS).empty());
+        REQUIRE_FALSE(router.decode(makeFrame(FRAME_ID_ECU, "03"), ECU_LIMIT_INTERVAL_MS).empty());
+        REQUIRE(router.flushPending(ECU_LIMIT_INTERVAL_MS).empty());
+        REQUIRE(ecu.decodeCount() == 2);
+    }
+
+    SECTION("reports rates against the declared rate") {
+        // One second of traffic at the declared 50 Hz
+        constexpr qint64 DURATION_MS = 1000;
+        for (qint64 now = 0; now <= DURATION_MS; now += ECU_PERIOD_MS) {
+            (void)router.decode(makeFrame(FRAME_ID_ECU, "01"), now);
+            (void)router.flushPending(now);
+        }
+
+        auto stats = router.rateLimitStats();
+        REQUIRE(stats.size() == 1);
+        REQUIRE(stats[0].key.frameId == FRAME_ID_ECU);
+        REQUIRE(stats[0].declaredHz == ECU_DECLARED_HZ);
+        REQUIRE(stats[0].limitHz == ECU_LIMIT_HZ);
+        REQUIRE(stats[0].receivedHz == ECU_DECLARED_HZ);
+        REQUIRE(stats[0].decodedHz == ECU_LIMIT_HZ);
+    }
+
+    SECTION("removing the cap decodes every frame") {
+        REQUIRE(router.setFrameRateLimit({FRAME_ID_ECU, false}, 0.0));
+        REQUIRE_FALSE(router.hasRateLimits());
+        REQUIRE_FALSE(router.decode(makeFrame(FRAME_ID_ECU, "01"), 0).empty());
+        REQUIRE_FALSE(router.decode(makeFrame(FRAME_ID_ECU, "02"), 1).empty());
+    }
+}
+
+TEST_CASE("FrameRouter caps multiplexed frames per mux page", "[can][router][ratelimit]") {
+    MuxStubDecoder pd16("pd16", {{FRAME_ID_PD16_B_STATUS, false}}, ECU_DECLARED_HZ);
+    devdash::FrameRouter router;
+    router.addDecoder(&pd16);
+    router.setPayloadCacheEnabled(false);
+    REQUIRE(router.setFrameRateLimit({FRAME_ID_PD16_B_STATUS, false}, ECU_LIMIT_HZ));
+
+    SECTION("each page is decoded once per interval") {
+        REQUIRE_FALSE(router.decode(makeFrame(FRAME_ID_PD16_B_STATUS, "0001"), 0).empty());
+        REQUIRE_FALSE(router.decode(makeFrame(FRAME_ID_PD16_B_STATUS, "1001"), 1).empty());
+        REQUIRE(router.decode(makeFrame(FRAME_ID_PD16_B_STATUS, "0002"), ECU_PERIOD_MS).empty());
+        REQUIRE(pd16.decodeCount() == 2);
+    }
+
+    SECTION("a held-back page is not replaced by another page") {
+        (void)router.decode(makeFrame(FRAME_ID_PD16_B_STATUS, "0001"), 0);
+        (void)router.decode(makeFrame(FRAME_ID_PD16_B_STATUS, "1001"), 0);
+        REQUIRE(router.decode(makeFrame(FRAME_ID_PD16_B_STATUS, "0002"), ECU_PERIOD_MS).empty());
+        REQUIRE(router.decode(makeFrame(FRAME_ID_PD16_B_STATUS, "1002"), ECU_PERIOD_MS).empty());
+        REQUIRE(router.decode(makeFrame(FRAME_ID_PD16_B_STATUS, "0003"), 2 * ECU_PERIOD_MS)
+                    .empty());
+
+        // The latest frame of both pages is released
+        REQUIRE(router.flushPending(ECU_LIMIT_INTERVAL_MS).size() == 2);
+        REQUIRE(pd16.decodeCount() == 4);
+        REQUIRE(router.rateLimitStats()[0].decoded == 4);
+    }
+}
@@ -0,0 +1,422 @@
+/**
+ * @file test_periodic_transmitter.cpp
+ * @brief Tests for the periodic CAN transmit schedule and its timerfd driver.
+ *
+ * Tests cover:
+ * - Due times on a fixed grid of period and phase offset, staggered phases
+ * - Overrun periods skipped (not sent in a burst), deadline misses and the
+ *   lateness histogram
+ * - Write failures, payload updates and frames added or removed while running,
+ *   including after an idle gap with nothing scheduled
+ * - Real timing: a 10 ms frame sent from the timerfd without drift
+ * - "transmit" frames sent by a CanAdapter on a virtual bus, with
+ *   diagnostics, and not sent once the adapter stops
+ *
+ * The schedule tests run against a synthetic clock, so they are deterministic.
+ */
+
+#include "adapters/ProtocolAdapterFactory.h"
+#include "adapters/can/PeriodicTransmitter.h"
+#include "adapters/can/TransmitSchedule.h"
+#include "adapters/can/VirtualCanBus.h"
+#include "adapters/can/VirtualCanEndpoint.h"
+
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonObject>
+#include <QTemporaryDir>
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <span>
+#include <vector>
+
+using Catch::Matchers::WithinAbs;
+using devdash::PeriodicTransmitter;
+using devdash::RawCanFrame;
+using devdash::TransmitSchedule;
+using devdash::VirtualCanBus;
+using devdash::VirtualCanEndpoint;
+
+namespace {
+
+//=============================================================================
+// Test Constants
+//=============================================================================
+
+constexpr int SPIN_TIMEOUT_MS = 5000;
+
+constexpr uint32_t KEEPALIVE_FRAME_ID = 0x6D0;
+constexpr uint32_t KEYPAD_FRAME_ID = 0x18FF0010;
+constexpr uint32_t STATUS_FRAME_ID = 0x123;
+
+constexpr int64_t PERIOD_10MS_US = 10000;
+constexpr int64_t PERIOD_20MS_US = 20000;
+constexpr int64_t PHASE_2MS_US = 2000;
+
+/// Time the schedule sat idle, with nothing scheduled
+constexpr int64_t IDLE_GAP_US = 60000000;
+
+/// Real-time run: 10 ms frames, sent this many times
+constexpr size_t TIMED_FRAMES = 30;
+
+/// Allowed deviation of the mean period from 10 ms on a loaded test machine
+constexpr double PERIOD_TOLERANCE_US = 500.0;
+
+const char* const TRANSMIT_DBC = R"(VERSION ""
+
+NS_ :
+
+BS_:
+
+BU_: ECU DASH
+
+BO_ 256 EngineData: 8 ECU
+ SG_ EngineSpeed : 0|16@1+ (1,0) [0|16000] "rpm" DASH
+)";
+
+bool spinUntil(const std::function<bool()>& condition, int timeoutMs = SPIN_TIMEOUT_MS) {
+    QElapsedTimer timer;
+    timer.start();
+    while (!condition()) {
+        if (timer.elapsed() > timeoutMs) {
+            return false;
+        }
+        QCoreApplication::processEvents(QEventLoop::AllEvents, 1);
+    }
+    return true;
+}
+
+RawCanFrame makeFrame(uint32_t frameId, uint8_t firstByte = 1) {
+    RawCanFrame frame;
+    frame.frameId = frameId;
+    frame.extended = frameId > 0x7FF;
+    frame.length = 2;
+    frame.data[0] = firstByte;
+    return frame;
+}
+
+/// Run one wake-up at @p nowUs, writing the first @p writable frames
+std::vector<RawCanFrame> wake(TransmitSchedule& schedule, int64_t nowUs,
+                              size_t writable = SIZE_MAX) {
+    std::vector<RawCanFrame> batch;
+    schedule.collectDue(nowUs, batch);
+    schedule.completeBatch(std::min(writable, batch.size()));
+    return batch;
+}
+
+} // anonymous namespace
+
+//=============================================================================
+// Schedule Tests
+//=============================================================================
+
+TEST_CASE("TransmitSchedule sends on a grid of period and phase", "[can][transmit]") {
+    TransmitSchedule schedule;
+    const int keepalive =
+        schedule.add(makeFrame(KEEPALIVE_FRAME_ID), PERIOD_10MS_US, PHASE_2MS_US);
+    const int keypad = schedule.add(makeFrame(KEYPAD_FRAME_ID), PERIOD_20MS_US, 0);
+    REQUIRE(keepalive >= 0);
+    REQUIRE(keypad >= 0);
+    REQUIRE(schedule.nextDueUs() == TransmitSchedule::NO_EVENT);  // Not started
+
+    schedule.start(0);
+
+    SECTION("each frame is due at its phase, then every period") {
+        REQUIRE(schedule.nextDueUs() == 0);
+        auto batch = wake(schedule, 0);
+        REQUIRE(batch.size() == 1);
+        REQUIRE(batch[0].frameId == KEYPAD_FRAME_ID);
+
+        REQUIRE(schedule.nextDueUs() == PHASE_2MS_US);
+        batch = wake(schedule, PHASE_2MS_US);
+        REQUIRE(batch.size() == 1);
+        REQUIRE(batch[0].frameId == KEEPALIVE_FRAME_ID);
+        REQUIRE(schedule.nextDueUs() == PHASE_2MS_US + PERIOD_10MS_US);
+    }
+
+    SECTION("waking up late does not move the grid") {
+        (void)wake(schedule, 0);
+        (void)wake(schedule, PHASE_2MS_US + 300);
+        REQUIRE(schedule.nextDueUs() == PHASE_2MS_US + PERIOD_10MS_US);
+        REQUIRE(schedule.stats().maxLatenessUs == 300);
+    }
+
+    SECTION("frames due at once go out in one batch") {
+        const auto batch = wake(schedule, PERIOD_20MS_US + PHASE_2MS_US);
+        REQUIRE(batch.size() == 2);
+        REQUIRE(schedule.stats().batches == 1);
+    }
+
+    SECTION("nothing is due before its time") {
+        (void)wake(schedule, 0);
+        REQUIRE(wake(schedule, PHASE_2MS_US - 1).empty());
+    }
+
+    SECTION("stopping clears the next due time") {
+        schedule.stop();
+        REQUIRE(schedule.nextDueUs() == TransmitSchedule::NO_EVENT);
+        REQUIRE(wake(schedule, PERIOD_20MS_US).empty());
+    }
+}
+
+TEST_CASE("TransmitSchedule staggers frames without a phase", "[can][transmit]") {
+    TransmitSchedule schedule;
+    for (int i = 0; i < 3; ++i) {
+        REQUIRE(schedule.add(makeFrame(KEEPALIVE_FRAME_ID), PERIOD_10MS_US) == i);
+    }
+
+    const auto stats = schedule.frameStats();
+    REQUIRE(stats.size() == 3);
+    REQUIRE(stats[0].phaseUs == 0);
+    REQUIRE(stats[1].phaseUs == TransmitSchedule::AUTO_PHASE_STEP_US);
+    REQUIRE(stats[2].phaseUs == 2 * TransmitSchedule::AUTO_PHASE_STEP_US);
+
+    SECTION("phases wrap into short periods") {
+        TransmitSchedule fast;
+        (void)fast.add(makeFrame(KEEPALIVE_FRAME_ID), TransmitSchedule::MIN_PERIOD_US);
+        (void)fast.add(makeFrame(KEEPALIVE_FRAME_ID), TransmitSchedule::MIN_PERIOD_US);
+        REQUIRE(fast.frameStats()[1].phaseUs == 0);
+    }
+
+    SECTION("periods below the minimum and error frames are rejected") {
+        REQUIRE(schedule.add(makeFrame(KEEPALIVE_FRAME_ID), TransmitSchedule::MIN_PERIOD_US - 1) ==
+                -1);
+        RawCanFrame error = makeFrame(KEEPALIVE_FRAME_ID);
+        error.error = true;
+        REQUIRE(schedule.add(error, PERIOD_10MS_US) == -1);
+    }
+}
+
+TEST_CASE("TransmitSchedule measures lateness and skips overrun periods", "[can][transmit]") {
+    TransmitSchedule schedule;
+    TransmitSchedule::Options options;
+    options.toleranceUs = 1000;
+    schedule.setOptions(options);
+    (void)schedule.add(makeFrame(KEEPALIVE_FRAME_ID), PERIOD_10MS_US, 0);
+    schedule.start(0);
+
+    (void)wake(schedule, 20);                      // On time
+    (void)wake(schedule, PERIOD_10MS_US + 1500);   // Deadline miss
+    // 3.5 periods late: sent once, three occurrences skipped
+    (void)wake(schedule, (2 * PERIOD_10MS_US) + 35000);
+
+    const TransmitSchedule::Stats& stats = schedule.stats();
+    REQUIRE(stats.sent == 3);
+    REQUIRE(stats.deadlineMisses == 2);
+    REQUIRE(stats.skipped == 3);
+    REQUIRE(stats.maxLatenessUs == 35000);
+    REQUIRE_THAT(stats.meanLatenessUs, WithinAbs((20.0 + 1500.0 + 35000.0) / 3.0, 0.01));
+    REQUIRE(schedule.nextDueUs() == 6 * PERIOD_10MS_US);
+
+    SECTION("histogram buckets") {
+        REQUIRE(stats.histogram[TransmitSchedule::bucketFor(20)] == 1);
+        REQUIRE(stats.histogram[TransmitSchedule::bucketFor(1500)] == 1);
+        REQUIRE(stats.histogram[TransmitSchedule::JITTER_BUCKETS - 1] == 1);
+        REQUIRE(TransmitSchedule::bucketFor(0) == 0);
+        REQUIRE(TransmitSchedule::bucketFor(TransmitSchedule::JITTER_BUCKET_LIMITS_US[0]) == 1);
+    }
+
+    SECTION("per-frame figures match the totals") {
+        const auto frames = schedule.frameStats();
+        REQUIRE(frames.size() == 1);
+        REQUIRE(frames[0].sent == 3);
+        REQUIRE(frames[0].deadlineMisses == 2);
+        REQUIRE(frames[0].skipped == 3);
+        REQUIRE(frames[0].key.frameId == KEEPALIVE_FRAME_ID);
+    }
+
+    SECTION("start() resets the statistics") {
+        schedule.start(0);
+        REQUIRE(schedule.stats().sent == 0);
+        REQUIRE(schedule.frameStats()[0].skipped == 0);
+    }
+}
+
+TEST_CASE("TransmitSchedule handles failures and changes while running", "[can][transmit]") {
+    TransmitSchedule schedule;
+    const int keepalive = schedule.add(makeFrame(KEEPALIVE_FRAME_ID), PERIOD_10MS_US, 0);
+    const int keypad = schedule.add(makeFrame(KEYPAD_FRAME_ID), PERIOD_10MS_US, 0);
+    schedule.start(0);
+
+    SECTION("frames the bus refused count as write failures") {
+        (void)wake(schedule, 0, 1);
+        REQUIRE(schedule.stats().sent == 1);
+        REQUIRE(schedule.stats().writeFailures == 1);
+        REQUIRE(schedule.frameStats()[1].writeFailures == 1);
+    }
+
+    SECTION("payload updates apply from the next occurrence") {
+        (void)wake(schedule, 0);
+        const std::array<uint8_t, 3> payload = {0xAA, 0xBB, 0xCC};
+        REQUIRE(schedule.setPayload(keepalive, payload));
+        const auto batch = wake(schedule, PERIOD_10MS_US);
+        REQUIRE(batch[0].length == 3);
+        REQUIRE(batch[0].data[2] == 0xCC);
+
+        const std::array<uint8_t, 12> tooLong{};
+        REQUIRE_FALSE(schedule.setPayload(keepalive, tooLong));  // Classic frame
+        REQUIRE_FALSE(schedule.setPayload(99, payload));
+    }
+
+    SECTION("removed frames are no longer sent") {
+        REQUIRE(schedule.remove(keypad));
+        REQUIRE_FALSE(schedule.remove(keypad));
+        REQUIRE(wake(schedule, 0).size() == 1);
+        REQUIRE(schedule.size() == 1);
+    }
+
+    SECTION("frames added while running join at their next grid point") {
+        (void)wake(schedule, 0);
+        REQUIRE(schedule.add(makeFrame(STATUS_FRAME_ID), PERIOD_10MS_US, 1000, 4000) >= 0);
+        REQUIRE(wake(schedule, 5000).empty());  // Its phase in this period has passed
+        REQUIRE(schedule.nextDueUs() == PERIOD_10MS_US);
+        const auto batch = wake(schedule, 11000);
+        REQUIRE(batch.size() == 3);
+    }
+
+    SECTION("frames added after an idle gap are due from the time they were added") {
+        (void)wake(schedule, 0);
+        REQUIRE(schedule.remove(keepalive));
+        REQUIRE(schedule.remove(keypad));
+        REQUIRE(schedule.nextDueUs() == TransmitSchedule::NO_EVENT);
+
+        // Nothing scheduled, so nothing woke the schedule for a minute
+        REQUIRE(schedule.add(makeFrame(STATUS_FRAME_ID), PERIOD_10MS_US, 1000, IDLE_GAP_US) >= 0);
+        REQUIRE(schedule.nextDueUs() == IDLE_GAP_US + 1000);
+        REQUIRE(wake(schedule, IDLE_GAP_US + 1000).size() == 1);
+        REQUIRE(schedule.stats().skipped == 0);
+        REQUIRE(schedule.stats().deadlineMisses == 0);
+        REQUIRE(schedule.stats().maxLatenessUs == 0);
+    }
+
+    SECTION("frames cannot be added while running without the current time") {
+        REQUIRE(schedule.add(makeFrame(STATUS_FRAME_ID), PERIOD_10MS_US) == -1);
+    }
+}
+
+//=============================================================================
+// Timer Tests
+//=============================================================================
+
+TEST_CASE("PeriodicTransmitter sends on time from the timerfd", "[can][transmit]") {
+    std::vector<int64_t> sentUs;
+    PeriodicTransmitter transmitter;
+    transmitter.setWriter([&sentUs](std::span<const RawCanFrame> frames) {
+        sentUs.push_back(PeriodicTransmitter::nowUs());
+        return frames.size();
+    });
+    const int keepalive = transmitter.add(makeFrame(KEEPALIVE_FRAME_ID), PERIOD_10MS_US);
+    REQUIRE(keepalive >= 0);
+    REQUIRE(transmitter.start());
+    REQUIRE(transmitter.isRunning());
+
+    REQUIRE(spinUntil([&sentUs]() { return sentUs.size() >= TIMED_FRAMES; }));
+    transmitter.stop();
+    REQUIRE_FALSE(transmitter.isRunning());
+
+    // The grid does not drift: the mean period is the configured one
+    const double meanPeriodUs = static_cast<double>(sentUs.back() - sentUs.front()) /
+                                static_cast<double>(sentUs.size() - 1);
+    REQUIRE_THAT(meanPeriodUs, WithinAbs(static_cast<double>(PERIOD_10MS_US),
+                                         PERIOD_TOLERANCE_US));
+
+    const QJsonObject diagnostics = transmitter.diagnostics();
+    REQUIRE(diagnostics["sent"].toInteger() >= static_cast<qint64>(TIMED_FRAMES));
+    REQUIRE(diagnostics["latenessHistogram"].toArray().size() ==
+            static_cast<qsizetype>(TransmitSchedule::JITTER_BUCKETS));
+    REQUIRE(diagnostics["frames"].toArray()[0].toObject()["id"].toString() == "0x6d0");
+
+    SECTION("nothing is sent after stop()") {
+        const size_t sent = sentUs.size();
+        spinUntil([]() { return false; }, 3 * static_cast<int>(PERIOD_10MS_US / 1000));
+        REQUIRE(sentUs.size() == sent);
+    }
+}
+
+//=============================================================================
+// Adapter Tests
+//=============================================================================
+
+TEST_CASE("CanAdapter sends configured frames periodically", "[can][transmit][virtual]") {
+    QTemporaryDir dir;
+    const QString dbcPath = dir.filePath("transmit.dbc");
+    {
+        QFile file(dbcPath);
+        REQUIRE(file.open(QIODevice::WriteOnly));
+        file.write(TRANSMIT_DBC);
+    }
+
+    QJsonObject keepalive;
+    keepalive["id"] = "0x6D0";
+    keepalive["periodMs"] = 10;
+    keepalive["phaseMs"] = 2;
+    keepalive["data"] = "0102";
+    QJsonObject keypad;
+    keypad["id"] = "0x18FF0010";
+    keypad["periodMs"] = 20;
+    keypad["data"] = "AA";
+    QJsonObject transmit;
+    transmit["frames"] = QJsonArray{keepalive, keypad};
+
+    QJsonObject adapterConfig;
+    adapterConfig["interface"] = "test-transmit";
+    adapterConfig["backend"] = "virtual";
+    adapterConfig["dbcFile"] = dbcPath;
+    adapterConfig["transmit"] = transmit;
+    QJsonObject profile;
+    profile["adapter"] = "dbc";
+    profile["adapterConfig"] = adapterConfig;
+
+    std::vector<RawCanFrame> received;
+    VirtualCanEndpoint device(VirtualCanBus::get("test-transmit"));
+    device.setFrameHandler([&received](const RawCanFrame& frame) { received.push_back(frame); });
+    REQUIRE(device.open());
+    device.start();
+
+    auto adapter = devdash::ProtocolAdapterFactory::createFromConfig(profile);
+    REQUIRE(adapter != nullptr);
+    REQUIRE(adapter->start());
+
+    const auto countOf = [&received](uint32_t frameId) {
+        return std::count_if(received.begin(), received.end(),
+                             [frameId](const RawCanFrame& frame) {
+                                 return frame.frameId == frameId;
+                             });
+    };
+    REQUIRE(spinUntil([&countOf]() { return countOf(KEYPAD_FRAME_ID) >= 4; }));
+    REQUIRE(countOf(KEEPALIVE_FRAME_ID) >= 5);
+
+    const auto first = std::find_if(received.begin(), received.end(), [](const auto& frame) {
+        return frame.frameId == KEEPALIVE_FRAME_ID;
+    });
+    REQUIRE(first->length == 2);
+    REQUIRE(first->data[1] == 0x02);
+    const auto keypadFrame = std::find_if(received.begin(), received.end(), [](const auto& frame) {
+        return frame.frameId == KEYPAD_FRAME_ID;
+    });
+    REQUIRE(keypadFrame->extended);
+
+    const QJsonObject diagnostics = adapter->diagnostics()["transmit"].toObject();
+    REQUIRE(diagnostics["frames"].toArray().size() == 2);
+    REQUIRE(diagnostics["sent"].toInteger() > 0);
+    REQUIRE(diagnostics["writeFailures"].toInteger() == 0);
+
+    SECTION("stopping the adapter stops sending") {
+        adapter->stop();
+        QCoreApplication::processEvents();
+        const size_t sent = received.size();
+        spinUntil([]() { return false; }, 3 * static_cast<int>(PERIOD_20MS_US / 1000));
+        REQUIRE(received.size() == sent);
+    }
+
+    adapter->stop();
+    device.stop();
+}
@@ -0,0 +1,211 @@
+/**
+ * @file test_raw_can_socket.cpp
+ * @brief Tests and receive benchmark for the native SocketCAN backend.
+ *
+ * Tests cover:
+ * - Error reporting for unknown interfaces
+ * - Round trip of classic and 29-bit frames with kernel timestamps (vcan0)
+ * - Batched sends, stopping at the first rejected frame (vcan0)
+ * - Benchmark against the QCanBus socketcan plugin at 1 Mbit/s (hidden)
+ *
+ * Tests that need vcan0 are skipped when it is missing
+ * (create it with scripts/setup-vcan.sh). Run the benchmark with:
+ *
+ *     ./build/debug/tests/devdash_tests "[benchmark]"
+ */
+
+#include "adapters/can/RawCanSocket.h"
+
+#include <QCanBus>
+#include <QCanBusDevice>
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <poll.h>
+
+#include <chrono>
+#include <memory>
+#include <vector>
+
+namespace {
+
+//=============================================================================
+// Test Constants
+//=============================================================================
+
+constexpr const char* VCAN_INTERFACE = "vcan0";
+constexpr int RECEIVE_TIMEOUT_MS = 1000;
+
+constexpr uint32_t RPM_FRAME_ID = 0x360;
+constexpr uint32_t EXTENDED_FRAME_ID = 0x18FF0001;
+
+/// One second of a fully loaded 1 Mbit/s bus: 8-byte 11-bit frames of 135 bits
+constexpr int FRAMES_PER_SECOND_AT_1MBIT = 1000000 / 135;
+
+/// Frames sent before draining, well inside the default socket receive buffer
+constexpr int BURST_SIZE = devdash::RawCanSocket::BATCH_SIZE;
+
+devdash::RawCanFrame makeFrame(uint32_t frameId, bool extended = false) {
+    devdash::RawCanFrame frame;
+    frame.frameId = frameId;
+    frame.extended = extended;
+    frame.length = 8;
+    for (uint8_t i = 0; i < frame.length; ++i) {
+        frame.data[i] = static_cast<uint8_t>(i + 1);
+    }
+    return frame;
+}
+
+bool waitReadable(int fd) {
+    pollfd request{fd, POLLIN, 0};
+    return ::poll(&request, 1, RECEIVE_TIMEOUT_MS) > 0;
+}
+
+/// Receive until `expected` frames arrived; returns the number received
+int drainNative(devdash::RawCanSocket& socket, int expected) {
+    int received = 0;
+    while (received < expected && waitReadable(socket.fd())) {
+        for (auto batch = socket.readBatch(); !batch.empty(); batch = socket.readBatch()) {
+            received += static_cast<int>(batch.size());
+        }
+    }
+    return received;
+}
+
+int drainQt(QCanBusDevice& device, int expected) {
+    int received = 0;
+    while (received < expected) {
+        if (device.framesAvailable() == 0 && !device.waitForFramesReceived(RECEIVE_TIMEOUT_MS)) {
+            break;
+        }
+        while (device.framesAvailable() > 0) {
+            const QCanBusFrame frame = device.readFrame();
+            received += frame.isValid() ? 1 : 0;
+        }
+    }
+    return received;
+}
+
+} // anonymous namespace
+
+TEST_CASE("RawCanSocket reports unknown interfaces", "[can][socketcan]") {
+    devdash::RawCanSocket socket;
+    REQUIRE_FALSE(socket.open("nosuchcan0", false));
+    REQUIRE_FALSE(socket.isOpen());
+    REQUIRE_FALSE(socket.errorString().empty());
+    REQUIRE(socket.readBatch().empty());
+}
+
+TEST_CASE("RawCanSocket receives frames in batches", "[can][socketcan]") {
+    devdash::RawCanSocket receiver;
+    devdash::RawCanSocket sender;
+    if (!receiver.open(VCAN_INTERFACE, false) || !sender.open(VCAN_INTERFACE, false)) {
+        SKIP("vcan0 not available - run scripts/setup-vcan.sh");
+    }
+
+    const auto before = std::chrono::system_clock::now();
+    REQUIRE(sender.write(makeFrame(RPM_FRAME_ID)));
+    REQUIRE(sender.write(makeFrame(EXTENDED_FRAME_ID, true)));
+
+    REQUIRE(waitReadable(receiver.fd()));
+    auto batch = receiver.readBatch();
+    if (batch.size() < 2) {
+        REQUIRE(waitReadable(receiver.fd()));
+        const auto rest = receiver.readBatch();
+        REQUIRE(rest.data() == batch.data() + batch.size());
+        batch = std::span(batch.data(), batch.size() + rest.size());
+    }
+    REQUIRE(batch.size() == 2);
+
+    SECTION("identifiers and payload") {
+        REQUIRE(batch[0].frameId == RPM_FRAME_ID);
+        REQUIRE_FALSE(batch[0].extended);
+        REQUIRE(batch[1].frameId == EXTENDED_FRAME_ID);
+        REQUIRE(batch[1].extended);
+        REQUIRE(batch[0].length == 8);
+        REQUIRE(batch[0].data[0] == 1);
+        REQUIRE(batch[0].data[7] == 8);
+        REQUIRE_FALSE(batch[0].flexibleDataRate);
+    }
+
+    SECTION("kernel receive timestamps") {
+        REQUIRE(receiver.timestampSource() != devdash::RawCanSocket::TimestampSource::None);
+        const auto sentNs = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                before.time_since_epoch())
+                                .count();
+        REQUIRE(batch[0].timestampNs >= sentNs);
+        REQUIRE(batch[1].timestampNs >= batch[0].timestampNs);
+    }
+
+    SECTION("nothing left to read") {
+        REQUIRE(receiver.readBatch().empty());
+        REQUIRE_FALSE(receiver.hasError());
+        REQUIRE(receiver.kernelDrops() == 0);
+    }
+}
+
+TEST_CASE("RawCanSocket sends frames in batches", "[can][socketcan]") {
+    devdash::RawCanSocket receiver;
+    devdash::RawCanSocket sender;
+    if (!receiver.open(VCAN_INTERFACE, false) || !sender.open(VCAN_INTERFACE, false)) {
+        SKIP("vcan0 not available - run scripts/setup-vcan.sh");
+    }
+
+    std::vector<devdash::RawCanFrame> frames(static_cast<size_t>(BURST_SIZE),
+                                             makeFrame(RPM_FRAME_ID));
+
+    SECTION("one call sends the whole batch") {
+        REQUIRE(sender.writeBatch(frames) == frames.size());
+        REQUIRE(drainNative(receiver, BURST_SIZE) == BURST_SIZE);
+    }
+
+    SECTION("a rejected frame ends the batch") {
+        frames[2].error = true;  // Error frames cannot be sent
+        REQUIRE(sender.writeBatch(frames) == 2);
+        REQUIRE(drainNative(receiver, 2) == 2);
+    }
+
+    SECTION("closed sockets send nothing") {
+        sender.close();
+        REQUIRE(sender.writeBatch(frames) == 0);
+    }
+}
+
+TEST_CASE("RawCanSocket vs QCanBus receive at 1 Mbit/s", "[.benchmark][socketcan]") {
+    devdash::RawCanSocket sender;
+    devdash::RawCanSocket receiver;
+    std::unique_ptr<QCanBusDevice> device(
+        QCanBus::instance()->createDevice("socketcan", VCAN_INTERFACE));
+    if (!sender.open(VCAN_INTERFACE, false) || !device || !device->connectDevice()) {
+        SKIP("vcan0 not available - run scripts/setup-vcan.sh");
+    }
+
+    // One receiver at a time, so each benchmark pays for its own path only
+    const devdash::RawCanFrame frame = makeFrame(RPM_FRAME_ID);
+    const auto sendBurst = [&sender, &frame]() {
+        for (int i = 0; i < BURST_SIZE; ++i) {
+            (void)sender.write(frame);
+        }
+    };
+
+    BENCHMARK("QCanBus readFrame, one second of frames") {
+        int received = 0;
+        for (int sent = 0; sent < FRAMES_PER_SECOND_AT_1MBIT; sent += BURST_SIZE) {
+            sendBurst();
+            received += drainQt(*device, BURST_SIZE);
+        }
+        return received;
+    };
+    device->disconnectDevice();
+    REQUIRE(receiver.open(VCAN_INTERFACE, false));
+
+    BENCHMARK("RawCanSocket recvmmsg, one second of frames") {
+        int received = 0;
+        for (int sent = 0; sent < FRAMES_PER_SECOND_AT_1MBIT; sent += BURST_SIZE) {
+            sendBurst();
+            received += drainNative(receiver, BURST_SIZE);
+        }
+        return received;
+    };
+}
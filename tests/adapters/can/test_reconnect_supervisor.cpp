@@ -0,0 +1,296 @@
+/**
+ * @file test_reconnect_supervisor.cpp
+ * @brief Tests for CAN interface reconnect and bus-off recovery.
+ *
+ * Tests cover:
+ * - Exponential backoff between failed open attempts, capped and reset on connect
+ * - Recovery time of link losses and bus-off, but not of the first connection
+ * - Bus-off recovered by a controller restart or by reopening the interface
+ * - Link state of existing and missing interfaces
+ * - CanAdapter retrying a missing interface without failing start(), and
+ *   failing it with "reconnect": false
+ * - A supervised "qt" backend asking for an I/O thread
+ */
+
+#include "adapters/ProtocolAdapterFactory.h"
+#include "adapters/can/RawCanSocket.h"
+#include "adapters/can/ReconnectSupervisor.h"
+
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QJsonObject>
+#include <QSignalSpy>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <functional>
+
+using devdash::RawCanSocket;
+using devdash::ReconnectSupervisor;
+
+namespace {
+
+//=============================================================================
+// Test Constants
+//=============================================================================
+
+constexpr int64_t INITIAL_DELAY_US = 100000;
+constexpr int64_t MAX_DELAY_US = 1000000;
+constexpr int64_t BUS_OFF_RESTART_US = 500000;
+
+/// Failed retries until the delay has reached MAX_DELAY_US
+constexpr int BACKOFF_RETRIES = 8;
+
+/// Outage lengths for the recovery measurements
+constexpr int64_t SHORT_OUTAGE_US = 150000;
+constexpr int64_t LONG_OUTAGE_US = 2500000;
+
+/// Far from the start of the synthetic clock
+constexpr int64_t LOSS_TIME_US = 60000000;
+
+/// No interface has this name
+constexpr const char* MISSING_INTERFACE = "ddnone0";
+
+/// Adapter retry timing, fast so the test sees several attempts
+constexpr int ADAPTER_INITIAL_DELAY_MS = 5;
+constexpr int ADAPTER_MAX_DELAY_MS = 20;
+constexpr int ADAPTER_FAILED_ATTEMPTS = 3;
+
+constexpr int SPIN_TIMEOUT_MS = 5000;
+
+ReconnectSupervisor makeSupervisor() {
+    ReconnectSupervisor supervisor;
+    ReconnectSupervisor::Options options;
+    options.initialDelayUs = INITIAL_DELAY_US;
+    options.maxDelayUs = MAX_DELAY_US;
+    options.busOffRestartUs = BUS_OFF_RESTART_US;
+    supervisor.setOptions(options);
+    return supervisor;
+}
+
+/// Fails attempts until @p untilUs, then connects; returns the connect time
+int64_t failUntil(ReconnectSupervisor& supervisor, int64_t untilUs) {
+    int64_t now = supervisor.nextAttemptUs();
+    while (true) {
+        REQUIRE(supervisor.beginAttempt(now));
+        if (now >= untilUs) {
+            return now;
+        }
+        supervisor.onAttemptFailed(now);
+        now = supervisor.nextAttemptUs();
+    }
+}
+
+bool spinUntil(const std::function<bool()>& condition) {
+    QElapsedTimer timer;
+    timer.start();
+    while (!condition()) {
+        if (timer.elapsed() > SPIN_TIMEOUT_MS) {
+            return false;
+        }
+        QCoreApplication::processEvents(QEventLoop::AllEvents, 1);
+    }
+    return true;
+}
+
+QJsonObject missingInterfaceConfig() {
+    QJsonObject config;
+    config["interface"] = MISSING_INTERFACE;
+    config["backend"] = "native";
+    config["protocolFile"] =
+        QString(SOURCE_DIR) + "/protocols/haltech/haltech-can-protocol-v2.35.json";
+    return config;
+}
+
+} // anonymous namespace
+
+//=============================================================================
+// ReconnectSupervisor Tests
+//=============================================================================
+
+TEST_CASE("ReconnectSupervisor backs off exponentially", "[can][reconnect]") {
+    ReconnectSupervisor supervisor = makeSupervisor();
+    supervisor.start(0);
+    REQUIRE(supervisor.state() == ReconnectSupervisor::State::Connecting);
+    REQUIRE(supervisor.nextAttemptUs() == ReconnectSupervisor::NO_ATTEMPT);
+
+    SECTION("delays double up to the maximum") {
+        supervisor.onAttemptFailed(0);
+        REQUIRE(supervisor.state() == ReconnectSupervisor::State::Backoff);
+
+        int64_t now = 0;
+        int64_t expectedDelay = INITIAL_DELAY_US;
+        for (int i = 0; i < BACKOFF_RETRIES; ++i) {
+            REQUIRE(supervisor.nextAttemptUs() == now + expectedDelay);
+            REQUIRE_FALSE(supervisor.beginAttempt(supervisor.nextAttemptUs() - 1));
+            now = supervisor.nextAttemptUs();
+            REQUIRE(supervisor.beginAttempt(now));
+            supervisor.onAttemptFailed(now);
+            expectedDelay = std::min(expectedDelay * 2, MAX_DELAY_US);
+        }
+        REQUIRE(supervisor.currentDelayUs() == MAX_DELAY_US);
+        // The first attempt is start()'s
+        REQUIRE(supervisor.stats().attempts == static_cast<uint64_t>(BACKOFF_RETRIES + 1));
+        REQUIRE(supervisor.stats().failedAttempts == static_cast<uint64_t>(BACKOFF_RETRIES + 1));
+    }
+
+    SECTION("connecting resets the delay and is not a recovery") {
+        supervisor.onAttemptFailed(0);
+        const int64_t connectedAt = failUntil(supervisor, LONG_OUTAGE_US);
+        REQUIRE(supervisor.onConnected(connectedAt) == 0);
+        REQUIRE(supervisor.isConnected());
+        REQUIRE(supervisor.currentDelayUs() == INITIAL_DELAY_US);
+        REQUIRE(supervisor.stats().recoveries == 0);
+        REQUIRE(supervisor.outageUs(connectedAt) == 0);
+    }
+
+    SECTION("stop ignores a late result") {
+        supervisor.stop();
+        REQUIRE(supervisor.onConnected(0) == 0);
+        REQUIRE(supervisor.state() == ReconnectSupervisor::State::Stopped);
+    }
+}
+
+TEST_CASE("ReconnectSupervisor measures recovery from a link loss", "[can][reconnect]") {
+    ReconnectSupervisor supervisor = makeSupervisor();
+    supervisor.start(0);
+    REQUIRE(supervisor.onConnected(0) == 0);
+
+    supervisor.onLinkLost(LOSS_TIME_US);
+    REQUIRE(supervisor.state() == ReconnectSupervisor::State::Backoff);
+    REQUIRE(supervisor.nextAttemptUs() == LOSS_TIME_US + INITIAL_DELAY_US);
+    REQUIRE(supervisor.outageUs(LOSS_TIME_US + SHORT_OUTAGE_US) == SHORT_OUTAGE_US);
+
+    SECTION("first retry succeeds") {
+        REQUIRE(supervisor.beginAttempt(LOSS_TIME_US + INITIAL_DELAY_US));
+        REQUIRE(supervisor.onConnected(LOSS_TIME_US + SHORT_OUTAGE_US) == SHORT_OUTAGE_US);
+        REQUIRE(supervisor.stats().recoveries == 1);
+        REQUIRE(supervisor.stats().lastRecoveryUs == SHORT_OUTAGE_US);
+    }
+
+    SECTION("outage spans the failed retries") {
+        const int64_t connectedAt = failUntil(supervisor, LOSS_TIME_US + LONG_OUTAGE_US);
+        const int64_t outage = supervisor.onConnected(connectedAt);
+        REQUIRE(outage == connectedAt - LOSS_TIME_US);
+        REQUIRE(outage >= LONG_OUTAGE_US);
+        REQUIRE(supervisor.stats().maxRecoveryUs == outage);
+        REQUIRE(supervisor.stats().totalOutageUs == outage);
+        REQUIRE(supervisor.stats().linkLosses == 1);
+
+        // A second loss starts over at the initial delay
+        supervisor.onLinkLost(connectedAt);
+        REQUIRE(supervisor.nextAttemptUs() == connectedAt + INITIAL_DELAY_US);
+    }
+
+    SECTION("losses while reconnecting are ignored") {
+        supervisor.onLinkLost(LOSS_TIME_US + SHORT_OUTAGE_US);
+        REQUIRE(supervisor.stats().linkLosses == 1);
+        REQUIRE(supervisor.nextAttemptUs() == LOSS_TIME_US + INITIAL_DELAY_US);
+    }
+}
+
+TEST_CASE("ReconnectSupervisor recovers from bus-off", "[can][reconnect]") {
+    ReconnectSupervisor supervisor = makeSupervisor();
+    supervisor.start(0);
+    REQUIRE(supervisor.onConnected(0) == 0);
+
+    supervisor.onBusOff(LOSS_TIME_US);
+    REQUIRE(supervisor.state() == ReconnectSupervisor::State::BusOff);
+    REQUIRE_FALSE(supervisor.isConnected());
+    REQUIRE(supervisor.nextAttemptUs() == LOSS_TIME_US + BUS_OFF_RESTART_US);
+    REQUIRE(supervisor.stats().busOffs == 1);
+
+    SECTION("controller restart ends the outage") {
+        REQUIRE(supervisor.onConnected(LOSS_TIME_US + SHORT_OUTAGE_US) == SHORT_OUTAGE_US);
+        REQUIRE(supervisor.isConnected());
+        REQUIRE(supervisor.stats().attempts == 1);
+    }
+
+    SECTION("interface is reopened after the restart time") {
+        REQUIRE_FALSE(supervisor.beginAttempt(LOSS_TIME_US + SHORT_OUTAGE_US));
+        REQUIRE(supervisor.beginAttempt(LOSS_TIME_US + BUS_OFF_RESTART_US));
+        supervisor.onAttemptFailed(LOSS_TIME_US + BUS_OFF_RESTART_US);
+        const int64_t connectedAt = failUntil(supervisor, LOSS_TIME_US + LONG_OUTAGE_US);
+        REQUIRE(supervisor.onConnected(connectedAt) == connectedAt - LOSS_TIME_US);
+        REQUIRE(supervisor.stats().recoveries == 1);
+    }
+
+    SECTION("link loss during bus-off continues the outage") {
+        supervisor.onLinkLost(LOSS_TIME_US + SHORT_OUTAGE_US);
+        REQUIRE(supervisor.state() == ReconnectSupervisor::State::Backoff);
+        REQUIRE(supervisor.beginAttempt(supervisor.nextAttemptUs()));
+        REQUIRE(supervisor.onConnected(LOSS_TIME_US + LONG_OUTAGE_US) == LONG_OUTAGE_US);
+    }
+}
+
+//=============================================================================
+// Link State Tests
+//=============================================================================
+
+TEST_CASE("RawCanSocket reports interface link state", "[can][reconnect]") {
+    REQUIRE(RawCanSocket::linkState("lo") == RawCanSocket::LinkState::Up);
+    REQUIRE(RawCanSocket::linkState(MISSING_INTERFACE) == RawCanSocket::LinkState::Missing);
+    REQUIRE(RawCanSocket::linkState("") == RawCanSocket::LinkState::Missing);
+}
+
+//=============================================================================
+// Adapter Tests
+//=============================================================================
+
+TEST_CASE("CanAdapter keeps retrying a missing interface", "[can][reconnect]") {
+    QJsonObject config = missingInterfaceConfig();
+
+    SECTION("start succeeds and attempts back off") {
+        QJsonObject reconnect;
+        reconnect["initialDelayMs"] = ADAPTER_INITIAL_DELAY_MS;
+        reconnect["maxDelayMs"] = ADAPTER_MAX_DELAY_MS;
+        config["reconnect"] = reconnect;
+        auto adapter = devdash::ProtocolAdapterFactory::create("haltech", config);
+        REQUIRE(adapter != nullptr);
+        QSignalSpy connections(adapter.get(), &devdash::IProtocolAdapter::connectionStateChanged);
+
+        REQUIRE(adapter->start());
+        REQUIRE(adapter->isRunning());
+        REQUIRE(spinUntil([&adapter]() {
+            const QJsonObject stats = adapter->diagnostics()["reconnect"].toObject();
+            return stats["failedAttempts"].toInteger() >= ADAPTER_FAILED_ATTEMPTS;
+        }));
+        const QJsonObject reconnectStats = adapter->diagnostics()["reconnect"].toObject();
+        REQUIRE(reconnectStats["recoveries"].toInteger() == 0);
+        REQUIRE(reconnectStats["state"].toString() != "connected");
+        REQUIRE(connections.isEmpty());
+
+        adapter->stop();
+        REQUIRE_FALSE(adapter->isRunning());
+        REQUIRE_FALSE(adapter->diagnostics().contains("reconnect"));
+    }
+
+    SECTION("without reconnect start fails") {
+        config["reconnect"] = false;
+        auto adapter = devdash::ProtocolAdapterFactory::create("haltech", config);
+        REQUIRE(adapter != nullptr);
+        REQUIRE_FALSE(adapter->start());
+    }
+}
+
+TEST_CASE("CanAdapter asks for an I/O thread to reopen a Qt device", "[can][reconnect]") {
+    QJsonObject config = missingInterfaceConfig();
+
+    SECTION("qt backend with reconnect") {
+        config["backend"] = "qt";
+        REQUIRE(devdash::ProtocolAdapterFactory::create("haltech", config)->requiresIoThread());
+    }
+
+    SECTION("qt backend without reconnect") {
+        config["backend"] = "qt";
+        config["reconnect"] = false;
+        REQUIRE_FALSE(
+            devdash::ProtocolAdapterFactory::create("haltech", config)->requiresIoThread());
+    }
+
+    SECTION("native backend opens on the worker thread") {
+        REQUIRE_FALSE(
+            devdash::ProtocolAdapterFactory::create("haltech", config)->requiresIoThread());
+    }
+}
@@ -0,0 +1,363 @@
+/**
+ * @file test_slcan.cpp
+ * @brief Tests and parser benchmark for the SLCAN serial CAN backend.
+ *
+ * Tests cover:
+ * - Decoding standard, extended, remote and CAN FD lines, with and without
+ *   the Z1 timestamp, in upper- and lowercase hex
+ * - Rejecting bad digits, wrong lengths and out-of-range identifiers
+ * - Lines split across reads at every position, command replies and BEL
+ *   errors, overlong lines
+ * - Encoding transmit commands (round trip through the parser)
+ * - CanAdapter with "backend": "slcan" against a pseudo-terminal standing
+ *   in for the dongle: setup commands, decoding, transmitting, unplugging
+ * - Parser throughput (hidden)
+ *
+ * Run the benchmark with:
+ *
+ *     ./build/debug/tests/devdash_tests "[benchmark]"
+ */
+
+#include "adapters/ProtocolAdapterFactory.h"
+#include "adapters/can/CanAdapter.h"
+#include "adapters/can/SlcanFrameSource.h"
+#include "adapters/can/SlcanParser.h"
+
+#include <QCanBusFrame>
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QJsonObject>
+#include <QSignalSpy>
+#include <QTemporaryDir>
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <array>
+#include <cstdlib>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+using devdash::RawCanFrame;
+using devdash::SlcanParser;
+
+namespace {
+
+//=============================================================================
+// Test Constants
+//=============================================================================
+
+constexpr int SPIN_TIMEOUT_MS = 5000;
+
+constexpr int TEST_BITRATE = 500000;
+constexpr int TEST_RPM = 3000;
+
+constexpr size_t READ_BUFFER_SIZE = 256;
+constexpr int BENCHMARK_FRAMES = 10000;
+constexpr size_t BENCHMARK_CHUNK = 4096;
+
+/// Decoded by the test DBC: EngineSpeed 1 rpm/bit
+const char* const SLCAN_DBC = R"(VERSION ""
+
+NS_ :
+
+BS_:
+
+BU_: ECU DASH
+
+BO_ 256 EngineData: 8 ECU
+ SG_ EngineSpeed : 0|16@1+ (1,0) [0|16000] "rpm" DASH
+)";
+
+bool spinUntil(const std::function<bool()>& condition, int timeoutMs = SPIN_TIMEOUT_MS) {
+    QElapsedTimer timer;
+    timer.start();
+    while (!condition()) {
+        if (timer.elapsed() > timeoutMs) {
+            return false;
+        }
+        QCoreApplication::processEvents(QEventLoop::AllEvents, 1);
+    }
+    return true;
+}
+
+/// Feed @p text to @p parser and collect the decoded frames
+std::vector<RawCanFrame> feed(SlcanParser& parser, std::string_view text) {
+    std::vector<RawCanFrame> frames;
+    parser.feed(std::span<const char>(text.data(), text.size()),
+                [&frames](const RawCanFrame& frame) { frames.push_back(frame); });
+    return frames;
+}
+
+SlcanParser::LineType parse(std::string_view line, RawCanFrame& frame) {
+    return SlcanParser::parseLine(line, frame);
+}
+
+/// Master side of a pseudo-terminal: the test plays the SLCAN dongle
+struct FakeDongle {
+    int master = -1;
+    QString device;
+
+    FakeDongle() {
+        master = ::posix_openpt(O_RDWR | O_NOCTTY | O_NONBLOCK);
+        REQUIRE(master >= 0);
+        REQUIRE(::grantpt(master) == 0);
+        REQUIRE(::unlockpt(master) == 0);
+        device = QString::fromLocal8Bit(::ptsname(master));
+    }
+
+    ~FakeDongle() { unplug(); }
+
+    FakeDongle(const FakeDongle&) = delete;
+    FakeDongle& operator=(const FakeDongle&) = delete;
+    FakeDongle(FakeDongle&&) = delete;
+    FakeDongle& operator=(FakeDongle&&) = delete;
+
+    void send(std::string_view text) const {
+        REQUIRE(::write(master, text.data(), text.size()) == static_cast<ssize_t>(text.size()));
+    }
+
+    /// Everything the adapter wrote so far
+    std::string received() const {
+        std::string text;
+        std::array<char, READ_BUFFER_SIZE> buffer{};
+        ssize_t count = 0;
+        while ((count = ::read(master, buffer.data(), buffer.size())) > 0) {
+            text.append(buffer.data(), static_cast<size_t>(count));
+        }
+        return text;
+    }
+
+    void unplug() {
+        if (master >= 0) {
+            ::close(master);
+            master = -1;
+        }
+    }
+};
+
+} // anonymous namespace
+
+//=============================================================================
+// Parser Tests
+//=============================================================================
+
+TEST_CASE("SlcanParser decodes frame lines", "[can][slcan]") {
+    RawCanFrame frame;
+
+    SECTION("standard data frame") {
+        REQUIRE(parse("t1232AABB", frame) == SlcanParser::LineType::Frame);
+        REQUIRE(frame.frameId == 0x123);
+        REQUIRE_FALSE(frame.extended);
+        REQUIRE(frame.length == 2);
+        REQUIRE(frame.data[0] == 0xAA);
+        REQUIRE(frame.data[1] == 0xBB);
+    }
+
+    SECTION("extended data frame with timestamp, lowercase hex") {
+        REQUIRE(parse("T1abcdef03010203ea60", frame) == SlcanParser::LineType::Frame);
+        REQUIRE(frame.frameId == 0x1ABCDEF0);
+        REQUIRE(frame.extended);
+        REQUIRE(frame.length == 3);
+        REQUIRE(frame.data[2] == 0x03);
+    }
+
+    SECTION("remote frames carry no data digits") {
+        REQUIRE(parse("r7FF8", frame) == SlcanParser::LineType::Frame);
+        REQUIRE(frame.remote);
+        REQUIRE(frame.length == 8);
+        REQUIRE(parse("R000001234", frame) == SlcanParser::LineType::Frame);
+        REQUIRE(frame.extended);
+    }
+
+    SECTION("CAN FD frames use the FD length codes") {
+        const std::string line = "b1239" + std::string(24, 'F');
+        REQUIRE(parse(line, frame) == SlcanParser::LineType::Frame);
+        REQUIRE(frame.flexibleDataRate);
+        REQUIRE(frame.bitrateSwitch);
+        REQUIRE(frame.length == 12);
+        REQUIRE(frame.data[11] == 0xFF);
+    }
+
+    SECTION("invalid lines are rejected") {
+        REQUIRE(parse("t12G2AABB", frame) == SlcanParser::LineType::Malformed);
+        REQUIRE(parse("t1232AAB", frame) == SlcanParser::LineType::Malformed);
+        REQUIRE(parse("t8001AA", frame) == SlcanParser::LineType::Malformed);
+        REQUIRE(parse("t1239", frame) == SlcanParser::LineType::Malformed);
+        REQUIRE(parse("t12", frame) == SlcanParser::LineType::Malformed);
+        REQUIRE(parse("x", frame) == SlcanParser::LineType::Malformed);
+    }
+
+    SECTION("command replies") {
+        REQUIRE(parse("", frame) == SlcanParser::LineType::Ack);
+        REQUIRE(parse("z", frame) == SlcanParser::LineType::TransmitAck);
+        REQUIRE(parse("V1013", frame) == SlcanParser::LineType::Reply);
+    }
+}
+
+TEST_CASE("SlcanParser handles the serial stream", "[can][slcan]") {
+    SlcanParser parser;
+
+    SECTION("lines split across reads at any position") {
+        const std::string stream = "t1232AABB\rT1234567830102030\r";
+        for (size_t split = 0; split <= stream.size(); ++split) {
+            parser.reset();
+            auto frames = feed(parser, std::string_view(stream).substr(0, split));
+            const auto rest = feed(parser, std::string_view(stream).substr(split));
+            frames.insert(frames.end(), rest.begin(), rest.end());
+            REQUIRE(frames.size() == 2);
+            REQUIRE(frames[1].frameId == 0x12345678);
+            REQUIRE(parser.stats().malformed == 0);
+        }
+    }
+
+    SECTION("replies and errors are counted, not decoded") {
+        const auto frames = feed(parser, "\r\r\az\rV1013\rt1000\r\ax\r");
+        REQUIRE(frames.size() == 1);
+        REQUIRE(parser.stats().acks == 2);
+        REQUIRE(parser.stats().errors == 2);
+        REQUIRE(parser.stats().transmitAcks == 1);
+        REQUIRE(parser.stats().replies == 1);
+        REQUIRE(parser.stats().malformed == 1);
+    }
+
+    SECTION("frames carry the receive time") {
+        constexpr int64_t RECEIVE_TIME_NS = 1700000000000000000;
+        parser.setReceiveTime(RECEIVE_TIME_NS);
+        REQUIRE(feed(parser, "t1000\r")[0].timestampNs == RECEIVE_TIME_NS);
+    }
+
+    SECTION("overlong lines are discarded up to their end") {
+        const std::string junk(SlcanParser::MAX_LINE_LENGTH + 1, '0');
+        REQUIRE(feed(parser, junk).empty());
+        REQUIRE(feed(parser, "00\rt1000\r").size() == 1);
+        REQUIRE(parser.stats().overflows == 1);
+    }
+}
+
+TEST_CASE("SlcanParser encodes transmit commands", "[can][slcan]") {
+    std::array<char, SlcanParser::MAX_ENCODED_LENGTH> out{};
+    RawCanFrame frame;
+    frame.frameId = 0x18FEF100;
+    frame.extended = true;
+    frame.length = 2;
+    frame.data[0] = 0x12;
+    frame.data[1] = 0xAB;
+
+    const size_t length = SlcanParser::encode(frame, out);
+    REQUIRE(std::string_view(out.data(), length) == "T18FEF100212AB\r");
+
+    SlcanParser parser;
+    const auto decoded = feed(parser, std::string_view(out.data(), length));
+    REQUIRE(decoded.size() == 1);
+    REQUIRE(decoded[0].frameId == frame.frameId);
+    REQUIRE(decoded[0].data[1] == 0xAB);
+
+    SECTION("frames without a command are refused") {
+        frame.error = true;
+        REQUIRE(SlcanParser::encode(frame, out) == 0);
+        frame.error = false;
+        frame.flexibleDataRate = true;
+        frame.length = 9;  // No CAN FD DLC
+        REQUIRE(SlcanParser::encode(frame, out) == 0);
+    }
+}
+
+//=============================================================================
+// Adapter Tests
+//=============================================================================
+
+TEST_CASE("CanAdapter reads an SLCAN dongle on a pseudo-terminal", "[can][slcan]") {
+    QTemporaryDir dir;
+    const QString dbcPath = dir.filePath("slcan.dbc");
+    QFile dbc(dbcPath);
+    REQUIRE(dbc.open(QIODevice::WriteOnly));
+    dbc.write(SLCAN_DBC);
+    dbc.close();
+
+    FakeDongle dongle;
+    QJsonObject config;
+    config["backend"] = "slcan";
+    config["interface"] = dongle.device;
+    config["bitrate"] = TEST_BITRATE;
+    config["dbcFile"] = dbcPath;
+    auto adapter = devdash::ProtocolAdapterFactory::create("dbc", config);
+    REQUIRE(adapter != nullptr);
+    auto* canAdapter = qobject_cast<devdash::CanAdapter*>(adapter.get());
+    REQUIRE(canAdapter != nullptr);
+
+    REQUIRE(adapter->start());
+    REQUIRE(dongle.received() == "C\rS6\rO\r");
+
+    SECTION("received frames are decoded") {
+        dongle.send("\rt1002B80B\r");  // 3000 rpm, little-endian
+        REQUIRE(spinUntil([&adapter]() { return adapter->getChannel("EngineSpeed").has_value(); }));
+        REQUIRE(adapter->getChannel("EngineSpeed")->value == TEST_RPM);
+
+        const QJsonObject slcan =
+            adapter->diagnostics()["bus"].toObject()["slcan"].toObject();
+        REQUIRE(slcan["frames"].toInteger() == 1);
+        REQUIRE(slcan["reads"].toInteger() >= 1);
+        REQUIRE(slcan.contains("parseNsPerFrame"));
+    }
+
+    SECTION("frames are transmitted as commands") {
+        REQUIRE(canAdapter->writeFrame(QCanBusFrame(0x123, QByteArray::fromHex("0102"))));
+        REQUIRE(dongle.received() == "t12320102\r");
+    }
+
+    SECTION("unplugging ends the source") {
+        auto* source = qobject_cast<devdash::SlcanFrameSource*>(canAdapter->frameSource());
+        REQUIRE(source != nullptr);
+        QSignalSpy finished(source, &devdash::ICanFrameSource::finished);
+        dongle.unplug();
+        REQUIRE(spinUntil([&finished]() { return finished.count() == 1; }));
+        REQUIRE_FALSE(source->errorString().isEmpty());
+    }
+
+    adapter->stop();
+}
+
+TEST_CASE("SlcanFrameSource rejects bitrates without an S command", "[can][slcan]") {
+    devdash::SlcanFrameSource::Options options;
+    options.device = "/dev/null";
+    options.bitrate = TEST_BITRATE + 1;
+    devdash::SlcanFrameSource source(options);
+    REQUIRE_FALSE(source.open());
+    REQUIRE(devdash::SlcanFrameSource::bitrateCode(TEST_BITRATE) == 6);
+}
+
+//=============================================================================
+// Benchmarks
+//=============================================================================
+
+TEST_CASE("SlcanParser throughput", "[.benchmark][slcan]") {
+    // A saturated 1 Mbit/s bus carries about 8,000 such frames per second
+    std::string stream;
+    std::array<char, SlcanParser::MAX_ENCODED_LENGTH> line{};
+    RawCanFrame frame;
+    frame.frameId = 0x360;
+    frame.length = 8;
+    for (int i = 0; i < BENCHMARK_FRAMES; ++i) {
+        frame.data[0] = static_cast<uint8_t>(i);
+        stream.append(line.data(), SlcanParser::encode(frame, line));
+    }
+
+    SlcanParser parser;
+    BENCHMARK("10000 frames in 4 KiB reads") {
+        uint64_t frames = 0;
+        for (size_t offset = 0; offset < stream.size(); offset += BENCHMARK_CHUNK) {
+            const size_t length = std::min(BENCHMARK_CHUNK, stream.size() - offset);
+            parser.feed(std::span<const char>(stream.data() + offset, length),
+                        [&frames](const RawCanFrame& /*frame*/) { ++frames; });
+        }
+        return frames;
+    };
+}
@@ -0,0 +1,386 @@
+/**
+ * @file test_virtual_can_bus.cpp
+ * @brief Tests and pipeline benchmark for the in-process virtual CAN bus.
+ *
+ * Tests cover:
+ * - Delivery to every other endpoint, sharing one bus slot (zero-copy)
+ * - Bus lookup by name
+ * - Simulated arrival timing from the bitrate
+ * - Flow control when a receiver falls a full ring behind
+ * - The full pipeline: ECU endpoint → DbcAdapter ("backend": "virtual")
+ *   → DataBroker → QML binding, in one process without vcan
+ * - Per-ID unchanged-payload cache hit rate in the adapter's diagnostics()
+ * - Channel reads from the GUI thread while the adapter runs on the I/O thread
+ * - Pipeline throughput benchmark (hidden)
+ *
+ * Run the benchmark with:
+ *
+ *     ./build/debug/tests/devdash_tests "[benchmark]"
+ */
+
+#include "adapters/ProtocolAdapterFactory.h"
+#include "adapters/can/BusMonitor.h"
+#include "adapters/can/VirtualCanBus.h"
+#include "adapters/can/VirtualCanEndpoint.h"
+#include "core/broker/DataBroker.h"
+
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonObject>
+#include <QQmlComponent>
+#include <QQmlContext>
+#include <QQmlEngine>
+#include <QTemporaryDir>
+#include <QThread>
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <cmath>
+#include <functional>
+#include <memory>
+#include <vector>
+
+using devdash::RawCanFrame;
+using devdash::VirtualCanBus;
+using devdash::VirtualCanEndpoint;
+
+namespace {
+
+//=============================================================================
+// Test Constants
+//=============================================================================
+
+constexpr int SPIN_TIMEOUT_MS = 5000;
+
+constexpr uint32_t ENGINE_FRAME_ID = 0x100;
+
+/// Slow enough that a frame (about 1 ms) outlasts sending the next one
+constexpr int TIMING_BITRATE = 125000;
+constexpr size_t TIMING_FRAMES = 20;
+constexpr double NS_PER_SECOND = 1e9;
+
+/// Decoded by the test DBC: EngineSpeed 1 rpm/bit, CoolantTemp 1 °C/bit - 40
+constexpr int TEST_RPM = 3000;
+constexpr int TEST_COOLANT_RAW = 130;
+constexpr double TEST_COOLANT_CELSIUS = 90.0;
+
+/// An unchanged frame repeated this often after the first one is skipped each time
+constexpr int REPEATED_FRAMES = 3;
+constexpr double REPEATED_HIT_RATE = 0.75;
+
+constexpr int BENCHMARK_FRAMES = 2000;
+
+const char* const PIPELINE_DBC = R"(VERSION ""
+
+NS_ :
+
+BS_:
+
+BU_: ECU DASH
+
+BO_ 256 EngineData: 8 ECU
+ SG_ EngineSpeed : 0|16@1+ (1,0) [0|16000] "rpm" DASH
+ SG_ CoolantTemp : 16|8@1+ (1,-40) [-40|215] "degC" DASH
+)";
+
+bool spinUntil(const std::function<bool()>& condition, int timeoutMs = SPIN_TIMEOUT_MS) {
+    QElapsedTimer timer;
+    timer.start();
+    while (!condition()) {
+        if (timer.elapsed() > timeoutMs) {
+            return false;
+        }
+        QCoreApplication::processEvents(QEventLoop::AllEvents, 1);
+    }
+    return true;
+}
+
+/// EngineData frame (little-endian signals, as in the test DBC)
+RawCanFrame engineFrame(int rpm, int coolantRaw = TEST_COOLANT_RAW) {
+    RawCanFrame frame;
+    frame.frameId = ENGINE_FRAME_ID;
+    frame.length = 8;
+    frame.data[0] = static_cast<uint8_t>(rpm & 0xFF);
+    frame.data[1] = static_cast<uint8_t>(rpm >> 8);
+    frame.data[2] = static_cast<uint8_t>(coolantRaw);
+    return frame;
+}
+
+/// Collects delivered frames and the address each handler call received
+struct Receiver {
+    std::vector<RawCanFrame> frames;
+    std::vector<const RawCanFrame*> addresses;
+
+    void attach(VirtualCanEndpoint& endpoint) {
+        endpoint.setFrameHandler([this](const RawCanFrame& frame) {
+            frames.push_back(frame);
+            addresses.push_back(&frame);
+        });
+        REQUIRE(endpoint.open());
+        endpoint.start();
+    }
+};
+
+/// Profile running a DbcAdapter on a virtual bus
+QJsonObject pipelineProfile(const QString& dbcPath, const QString& busName) {
+    QJsonObject adapterConfig;
+    adapterConfig["interface"] = busName;
+    adapterConfig["backend"] = "virtual";
+    adapterConfig["dbcFile"] = dbcPath;
+
+    QJsonObject mappings;
+    mappings["EngineSpeed"] = "rpm";
+    mappings["CoolantTemp"] = "coolantTemperature";
+
+    QJsonObject profile;
+    profile["adapter"] = "dbc";
+    profile["adapterConfig"] = adapterConfig;
+    profile["channelMappings"] = mappings;
+    return profile;
+}
+
+QString writeDbc(const QTemporaryDir& dir) {
+    const QString path = dir.filePath("pipeline.dbc");
+    QFile file(path);
+    REQUIRE(file.open(QIODevice::WriteOnly));
+    file.write(PIPELINE_DBC);
+    return path;
+}
+
+} // anonymous namespace
+
+//=============================================================================
+// Bus Tests
+//=============================================================================
+
+TEST_CASE("VirtualCanBus delivers to every other endpoint", "[can][virtual]") {
+    auto bus = VirtualCanBus::get("test-delivery");
+    VirtualCanEndpoint ecu(bus);
+    VirtualCanEndpoint dash(bus);
+    VirtualCanEndpoint logger(bus);
+    Receiver dashFrames;
+    Receiver loggerFrames;
+    dashFrames.attach(dash);
+    loggerFrames.attach(logger);
+
+    SECTION("all receivers share one bus slot") {
+        REQUIRE(ecu.writeFrame(engineFrame(TEST_RPM)));
+        REQUIRE(spinUntil([&]() {
+            return dashFrames.frames.size() == 1 && loggerFrames.frames.size() == 1;
+        }));
+        REQUIRE(dashFrames.frames[0].frameId == ENGINE_FRAME_ID);
+        REQUIRE(dashFrames.frames[0].data[0] == (TEST_RPM & 0xFF));
+        REQUIRE(dashFrames.frames[0].timestampNs > 0);
+        REQUIRE(dashFrames.addresses[0] == loggerFrames.addresses[0]);
+        REQUIRE(ecu.framesSent() == 1);
+    }
+
+    SECTION("senders do not receive their own frames") {
+        REQUIRE(dash.writeFrame(engineFrame(TEST_RPM)));
+        REQUIRE(spinUntil([&]() { return loggerFrames.frames.size() == 1; }));
+        QCoreApplication::processEvents();
+        REQUIRE(dashFrames.frames.empty());
+    }
+
+    SECTION("stopped endpoints receive nothing") {
+        logger.stop();
+        REQUIRE(ecu.writeFrame(engineFrame(TEST_RPM)));
+        REQUIRE(spinUntil([&]() { return dashFrames.frames.size() == 1; }));
+        QCoreApplication::processEvents();
+        REQUIRE(loggerFrames.frames.empty());
+        REQUIRE(bus->attachedPorts() == 1);
+    }
+
+    SECTION("buses are shared by name") {
+        REQUIRE(VirtualCanBus::get("test-delivery") == bus);
+        REQUIRE(VirtualCanBus::get("test-other") != bus);
+    }
+}
+
+TEST_CASE("VirtualCanBus simulates arrival timing", "[can][virtual]") {
+    auto bus = VirtualCanBus::get("test-timing");
+    VirtualCanEndpoint ecu(bus);
+    VirtualCanEndpoint dash(bus);
+    Receiver received;
+    received.attach(dash);
+
+    SECTION("frames arrive one bit time apart") {
+        bus->setBitrate(TIMING_BITRATE, 0);
+        const RawCanFrame frame = engineFrame(TEST_RPM);
+        const auto frameNs = std::llround(
+            devdash::BusMonitor::frameDuration(frame, TIMING_BITRATE, 0) * NS_PER_SECOND);
+
+        QElapsedTimer elapsed;
+        elapsed.start();
+        for (size_t i = 0; i < TIMING_FRAMES; ++i) {
+            REQUIRE(ecu.writeFrame(frame));
+        }
+        REQUIRE(spinUntil([&]() { return received.frames.size() == TIMING_FRAMES; }));
+
+        // The bus is busy from the first frame on, so arrivals are back to back
+        for (size_t i = 1; i < received.frames.size(); ++i) {
+            REQUIRE(received.frames[i].timestampNs - received.frames[i - 1].timestampNs ==
+                    frameNs);
+        }
+        REQUIRE(elapsed.nsecsElapsed() >= static_cast<qint64>(TIMING_FRAMES - 1) * frameNs);
+    }
+
+    SECTION("without a bitrate frames arrive immediately") {
+        bus->setBitrate(0, 0);
+        for (size_t i = 0; i < TIMING_FRAMES; ++i) {
+            REQUIRE(ecu.writeFrame(engineFrame(static_cast<int>(i))));
+        }
+        REQUIRE(spinUntil([&]() { return received.frames.size() == TIMING_FRAMES; }));
+        REQUIRE(received.frames.back().data[0] == TIMING_FRAMES - 1);
+
+        // Sent within microseconds; at TIMING_BITRATE they would span 19 frame times
+        const double timedSpreadNs = static_cast<double>(TIMING_FRAMES - 1) * NS_PER_SECOND *
+                                     devdash::BusMonitor::frameDuration(
+                                         received.frames.front(), TIMING_BITRATE, 0);
+        const auto spreadNs =
+            received.frames.back().timestampNs - received.frames.front().timestampNs;
+        REQUIRE(static_cast<double>(spreadNs) < timedSpreadNs);
+    }
+}
+
+TEST_CASE("VirtualCanBus blocks senders when a receiver falls behind", "[can][virtual]") {
+    auto bus = VirtualCanBus::get("test-flow-control");
+    auto port = bus->attach(bus->newNodeId(), nullptr);
+    const RawCanFrame frame = engineFrame(TEST_RPM);
+
+    for (int i = 0; i < VirtualCanBus::RING_CAPACITY; ++i) {
+        REQUIRE(bus->send(VirtualCanBus::ANONYMOUS_NODE, frame));
+    }
+    REQUIRE_FALSE(bus->send(VirtualCanBus::ANONYMOUS_NODE, frame));
+    REQUIRE(bus->sendFailures() == 1);
+
+    SECTION("reading frees a slot") {
+        REQUIRE(bus->peek(*port) != nullptr);
+        bus->release(*port);
+        REQUIRE(bus->send(VirtualCanBus::ANONYMOUS_NODE, frame));
+    }
+
+    SECTION("detached ports no longer hold the ring") {
+        bus->detach(*port);
+        REQUIRE(bus->send(VirtualCanBus::ANONYMOUS_NODE, frame));
+    }
+}
+
+//=============================================================================
+// Pipeline Tests
+//=============================================================================
+
+TEST_CASE("Virtual bus drives the adapter, broker and QML pipeline", "[can][virtual][pipeline]") {
+    QTemporaryDir dir;
+    const QJsonObject profile = pipelineProfile(writeDbc(dir), "test-pipeline");
+
+    devdash::DataBroker broker;
+    REQUIRE(broker.loadProfileFromJson(profile));
+    auto adapter = devdash::ProtocolAdapterFactory::createFromConfig(profile);
+    REQUIRE(adapter != nullptr);
+    auto* rawAdapter = adapter.get();
+    broker.setAdapter(std::move(adapter));
+    REQUIRE(broker.start());
+    REQUIRE(rawAdapter->diagnostics()["bus"].toObject()["backend"].toString() == "virtual");
+
+    QQmlEngine engine;
+    engine.rootContext()->setContextProperty("dataBroker", &broker);
+    QQmlComponent component(&engine);
+    component.setData("import QtQml\n"
+                      "QtObject {\n"
+                      "    property real rpm: dataBroker.rpm\n"
+                      "    property real coolant: dataBroker.coolantTemperature\n"
+                      "}\n",
+                      QUrl());
+    std::unique_ptr<QObject> gauges(component.create());
+    REQUIRE(gauges != nullptr);
+
+    VirtualCanEndpoint ecu(VirtualCanBus::get("test-pipeline"));
+    REQUIRE(ecu.writeFrame(engineFrame(TEST_RPM)));
+
+    REQUIRE(spinUntil([&gauges]() { return gauges->property("rpm").toDouble() == TEST_RPM; }));
+    REQUIRE(gauges->property("coolant").toDouble() == TEST_COOLANT_CELSIUS);
+    REQUIRE(broker.isConnected());
+
+    broker.stop();
+}
+
+TEST_CASE("Adapter diagnostics report the payload cache hit rate per ID", "[can][virtual]") {
+    QTemporaryDir dir;
+    const QJsonObject profile = pipelineProfile(writeDbc(dir), "test-payload-cache");
+    auto adapter = devdash::ProtocolAdapterFactory::createFromConfig(profile);
+    REQUIRE(adapter != nullptr);
+    REQUIRE(adapter->start());
+
+    const auto cacheEntry = [&adapter]() {
+        return adapter->diagnostics()["payloadCache"].toArray().first().toObject();
+    };
+    REQUIRE_FALSE(adapter->diagnostics().contains("payloadCache"));
+
+    VirtualCanEndpoint ecu(VirtualCanBus::get("test-payload-cache"));
+    for (int i = 0; i <= REPEATED_FRAMES; ++i) {
+        REQUIRE(ecu.writeFrame(engineFrame(TEST_RPM)));
+    }
+    REQUIRE(spinUntil(
+        [&cacheEntry]() { return cacheEntry()["hits"].toInteger() == REPEATED_FRAMES; }));
+
+    const QJsonObject entry = cacheEntry();
+    CHECK(entry["id"].toString() == "0x100");
+    CHECK_FALSE(entry["extended"].toBool());
+    CHECK(entry["misses"].toInteger() == 1);
+    CHECK(entry["hitRate"].toDouble() == REPEATED_HIT_RATE);
+
+    adapter->stop();
+}
+
+TEST_CASE("CanAdapter channels are readable from another thread", "[can][virtual][threading]") {
+    QTemporaryDir dir;
+    QJsonObject profile = pipelineProfile(writeDbc(dir), "test-cross-thread");
+    profile["ioThread"] = QJsonObject{};
+
+    devdash::DataBroker broker;
+    REQUIRE(broker.loadProfileFromJson(profile));
+    auto adapter = devdash::ProtocolAdapterFactory::createFromConfig(profile);
+    REQUIRE(adapter != nullptr);
+    auto* rawAdapter = adapter.get();
+    broker.setAdapter(std::move(adapter));
+    REQUIRE(broker.start());
+    REQUIRE(rawAdapter->thread() != QThread::currentThread());
+
+    VirtualCanEndpoint ecu(VirtualCanBus::get("test-cross-thread"));
+    REQUIRE(ecu.writeFrame(engineFrame(TEST_RPM)));
+
+    REQUIRE(spinUntil(
+        [rawAdapter]() { return rawAdapter->getChannel("EngineSpeed").has_value(); }));
+    REQUIRE(rawAdapter->getChannel("EngineSpeed")->value == TEST_RPM);
+    REQUIRE(rawAdapter->availableChannels().contains("CoolantTemp"));
+    REQUIRE_FALSE(rawAdapter->getChannel("NotDecoded").has_value());
+
+    broker.stop();
+}
+
+TEST_CASE("Virtual bus pipeline throughput", "[.benchmark][virtual]") {
+    QTemporaryDir dir;
+    const QJsonObject profile = pipelineProfile(writeDbc(dir), "bench-pipeline");
+    auto adapter = devdash::ProtocolAdapterFactory::createFromConfig(profile);
+    REQUIRE(adapter != nullptr);
+    REQUIRE(adapter->start());
+
+    VirtualCanEndpoint ecu(VirtualCanBus::get("bench-pipeline"));
+    const auto delivered = [&adapter]() {
+        return adapter->diagnostics()["bus"].toObject()["virtual"].toObject()["frames"].toInteger();
+    };
+
+    BENCHMARK("ECU to decoded channels, 2000 frames") {
+        const qint64 target = delivered() + BENCHMARK_FRAMES;
+        for (int i = 0; i < BENCHMARK_FRAMES; ++i) {
+            // Changing payloads, so the unchanged-payload cache does not skip them
+            (void)ecu.writeFrame(engineFrame(i));
+        }
+        return spinUntil([&]() { return delivered() >= target; });
+    };
+    adapter->stop();
+}
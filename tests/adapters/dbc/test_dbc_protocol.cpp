@@ -0,0 +1,396 @@
+/**
+ * @file test_dbc_protocol.cpp
+ * @brief Unit tests for DbcProtocol DBC import and decoding.
+ *
+ * Tests cover:
+ * - DBC parsing (messages, signals, multi-line statements)
+ * - Intel and Motorola signal decoding, signed and scaled
+ * - Multiplexed messages
+ * - VAL_ value descriptions (per message, published with the value) and
+ *   SIG_VALTYPE_ float signals
+ * - Extended identifiers, duplicate messages and unknown frames
+ * - Signal names shared by several messages (or files) published as
+ *   "Message.Signal"
+ */
+
+#include "adapters/dbc/DbcProtocol.h"
+
+#include <QCanBusFrame>
+#include <QTemporaryFile>
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+
+using Catch::Matchers::WithinAbs;
+
+namespace {
+
+//=============================================================================
+// Test Constants - CAN Frame IDs
+//=============================================================================
+
+/// Intel-ordered message
+constexpr uint32_t FRAME_ID_ENGINE = 0x100;
+
+/// Motorola-ordered message
+constexpr uint32_t FRAME_ID_MOTOROLA = 0x200;
+
+/// Multiplexed message
+constexpr uint32_t FRAME_ID_MUX = 0x300;
+
+/// 29-bit message (DBC ID 2566844926 = 0x80000000 | 0x18FEF1FE)
+constexpr uint32_t FRAME_ID_EXTENDED = 0x18FEF1FE;
+
+/// Sent as both an 11-bit and a 29-bit message (CLASHING_DBC)
+constexpr uint32_t FRAME_ID_STATUS = 0x100;
+
+/// Defined twice (CLASHING_DBC)
+constexpr uint32_t FRAME_ID_DUPLICATE = 0x200;
+
+/// Both carry a "Counter" signal (SHARED_NAMES_DBC)
+constexpr uint32_t FRAME_ID_ENGINE_COUNTER = 0x101;
+constexpr uint32_t FRAME_ID_BRAKE_COUNTER = 0x102;
+
+/// Unknown frame ID for negative testing
+constexpr uint32_t FRAME_ID_UNKNOWN = 0x999;
+
+//=============================================================================
+// Test Constants - Tolerances
+//=============================================================================
+
+constexpr double VALUE_TOLERANCE = 0.001;
+
+//=============================================================================
+// Test DBC
+//=============================================================================
+
+const char* const TEST_DBC = R"(VERSION ""
+
+NS_ :
+    NS_DESC_
+    CM_
+    BA_DEF_
+
+BS_:
+
+BU_: ECU ABS
+
+BO_ 256 EngineData: 8 ECU
+ SG_ EngineSpeed : 0|16@1+ (0.25,0) [0|16383.75] "rpm" ABS
+ SG_ CoolantTemp : 16|8@1+ (1,-40) [-40|215] "degC" ABS
+ SG_ Torque : 24|12@1- (0.5,0) [-1024|1023.5] "Nm" ABS
+ SG_ GearState : 36|4@1+ (1,0) [0|15] "" ABS
+
+BO_ 512 MotorolaData: 8 ECU
+ SG_ Pressure : 7|16@0+ (0.1,0) [0|6553.5] "kPa" ABS
+ SG_ Offset12 : 19|12@0- (1,0) [-2048|2047] "" ABS
+
+BO_ 768 MuxData: 8 ECU
+ SG_ MuxId M : 0|8@1+ (1,0) [0|255] "" ABS
+ SG_ WheelFL m0 : 8|16@1+ (0.01,0) [0|655.35] "km/h" ABS
+ SG_ WheelRR m1 : 8|16@1+ (0.01,0) [0|655.35] "km/h" ABS
+
+BO_ 2566844926 ExtendedData: 8 ECU
+ SG_ FloatValue : 0|32@1- (1,0) [0|0] "bar" ABS
+
+CM_ SG_ 256 EngineSpeed "Crank speed; comment spans
+BO_ 1 NotAMessage: 8 ECU
+two lines";
+VAL_ 256 GearState 0 "Park" 1 "Reverse" 2 "Neutral" 3 "Drive" ;
+SIG_VALTYPE_ 2566844926 FloatValue : 1;
+)";
+
+/// Two messages with same-named signals, 0x100 as both 11-bit and 29-bit,
+/// and a duplicate definition of 0x200
+const char* const CLASHING_DBC = R"(VERSION ""
+
+BO_ 256 StandardStatus: 8 ECU
+ SG_ Mode : 0|8@1+ (1,0) [0|255] "" ABS
+
+BO_ 2147483904 ExtendedStatus: 8 ECU
+ SG_ Mode : 0|8@1+ (1,0) [0|255] "" ABS
+
+BO_ 512 FirstDefinition: 8 ECU
+ SG_ Counter : 0|8@1+ (1,0) [0|255] "" ABS
+
+BO_ 512 SecondDefinition: 8 ECU
+ SG_ Checksum : 0|8@1+ (1,0) [0|255] "" ABS
+
+VAL_ 256 Mode 1 "Sport" ;
+VAL_ 2147483904 Mode 1 "Limp" ;
+)";
+
+/// "Counter" in two messages; the second message also reuses a name of TEST_DBC
+const char* const SHARED_NAMES_DBC = R"(VERSION ""
+
+BS_:
+
+BU_: ECU ABS
+
+BO_ 257 EngineCounter: 8 ECU
+ SG_ Counter : 0|8@1+ (1,0) [0|255] "" ABS
+ SG_ Lambda : 8|8@1+ (0.01,0) [0|2.55] "" ABS
+
+BO_ 258 BrakeCounter: 8 ABS
+ SG_ Counter : 0|8@1+ (1,0) [0|255] "" ECU
+ SG_ CoolantTemp : 8|8@1+ (1,-40) [-40|215] "degC" ECU
+
+VAL_ 258 Counter 7 "Wrapped" ;
+)";
+
+//=============================================================================
+// Test Helpers
+//=============================================================================
+
+QCanBusFrame makeFrame(uint32_t frameId, const char* hexPayload) {
+    return QCanBusFrame(frameId, QByteArray::fromHex(hexPayload));
+}
+
+const devdash::ChannelValue*
+findChannel(const std::vector<std::pair<QString, devdash::ChannelValue>>& results,
+            const QString& name) {
+    for (const auto& [channelName, value] : results) {
+        if (channelName == name) {
+            return &value;
+        }
+    }
+    return nullptr;
+}
+
+} // anonymous namespace
+
+//=============================================================================
+// Loading Tests
+//=============================================================================
+
+TEST_CASE("DbcProtocol loads DBC definitions", "[dbc][protocol]") {
+    devdash::DbcProtocol dbc;
+
+    SECTION("loads messages from string") {
+        REQUIRE(dbc.loadFromString(QString::fromUtf8(TEST_DBC)));
+        REQUIRE(dbc.isLoaded());
+        REQUIRE(dbc.frameIds().size() == 4);
+    }
+
+    SECTION("message inside a multi-line comment is ignored") {
+        REQUIRE(dbc.loadFromString(QString::fromUtf8(TEST_DBC)));
+        REQUIRE(dbc.findMessage({1, false}) == nullptr);
+    }
+
+    SECTION("compiles message layout") {
+        REQUIRE(dbc.loadFromString(QString::fromUtf8(TEST_DBC)));
+        const auto* mux = dbc.findMessage({FRAME_ID_MUX, false});
+        REQUIRE(mux != nullptr);
+        REQUIRE(mux->name == "MuxData");
+        REQUIRE(mux->signalDefs.size() == 3);
+        REQUIRE(mux->multiplexorIndex == 0);
+
+        const auto* extended = dbc.findMessage({FRAME_ID_EXTENDED, true});
+        REQUIRE(extended != nullptr);
+        REQUIRE(extended->extended);
+        REQUIRE(dbc.findMessage({FRAME_ID_EXTENDED, false}) == nullptr);
+    }
+
+    SECTION("exposes signal names as channels") {
+        REQUIRE(dbc.loadFromString(QString::fromUtf8(TEST_DBC)));
+        const auto channels = dbc.availableChannels();
+        REQUIRE(channels.contains("EngineSpeed"));
+        REQUIRE(channels.contains("WheelRR"));
+        REQUIRE(channels.contains("FloatValue"));
+    }
+
+    SECTION("lists the signals of each frame") {
+        REQUIRE(dbc.loadFromString(QString::fromUtf8(TEST_DBC)));
+        const auto channels = dbc.frameChannels({FRAME_ID_MUX, false});
+        REQUIRE(channels.size() == 3);
+        REQUIRE(dbc.frameChannels({FRAME_ID_EXTENDED, false}).isEmpty());
+        REQUIRE_FALSE(dbc.frameChannels({FRAME_ID_EXTENDED, true}).isEmpty());
+    }
+
+    SECTION("loads from file") {
+        QTemporaryFile tempFile;
+        REQUIRE(tempFile.open());
+        tempFile.write(TEST_DBC);
+        tempFile.close();
+
+        REQUIRE(dbc.loadDefinition(tempFile.fileName()));
+        REQUIRE(dbc.frameIds().size() == 4);
+    }
+
+    SECTION("fails gracefully on missing file") {
+        REQUIRE_FALSE(dbc.loadDefinition("/nonexistent/path.dbc"));
+        REQUIRE_FALSE(dbc.isLoaded());
+    }
+
+    SECTION("fails on content without messages") {
+        REQUIRE_FALSE(dbc.loadFromString("VERSION \"\"\nBU_: ECU\n"));
+    }
+}
+
+//=============================================================================
+// Decoding Tests
+//=============================================================================
+
+TEST_CASE("DbcProtocol decodes frames", "[dbc][protocol]") {
+    devdash::DbcProtocol dbc;
+    REQUIRE(dbc.loadFromString(QString::fromUtf8(TEST_DBC)));
+
+    SECTION("decodes Intel signals with scale, offset and sign") {
+        // EngineSpeed 12000 * 0.25, CoolantTemp 130 - 40, Torque -200 * 0.5, Gear 3
+        auto results = dbc.decode(makeFrame(FRAME_ID_ENGINE, "E02E82383F000000"));
+        REQUIRE(results.size() == 4);
+
+        const auto* rpm = findChannel(results, "EngineSpeed");
+        REQUIRE(rpm != nullptr);
+        REQUIRE_THAT(rpm->value, WithinAbs(3000.0, VALUE_TOLERANCE));
+        REQUIRE(rpm->unit == "rpm");
+
+        const auto* coolant = findChannel(results, "CoolantTemp");
+        REQUIRE(coolant != nullptr);
+        REQUIRE_THAT(coolant->value, WithinAbs(90.0, VALUE_TOLERANCE));
+
+        const auto* torque = findChannel(results, "Torque");
+        REQUIRE(torque != nullptr);
+        REQUIRE_THAT(torque->value, WithinAbs(-100.0, VALUE_TOLERANCE));
+
+        const auto* gear = findChannel(results, "GearState");
+        REQUIRE(gear != nullptr);
+        REQUIRE_THAT(gear->value, WithinAbs(3.0, VALUE_TOLERANCE));
+    }
+
+    SECTION("decodes Motorola signals across byte boundaries") {
+        auto results = dbc.decode(makeFrame(FRAME_ID_MOTOROLA, "03F5AFFB00000000"));
+
+        const auto* pressure = findChannel(results, "Pressure");
+        REQUIRE(pressure != nullptr);
+        REQUIRE_THAT(pressure->value, WithinAbs(101.3, VALUE_TOLERANCE));
+
+        const auto* offset = findChannel(results, "Offset12");
+        REQUIRE(offset != nullptr);
+        REQUIRE_THAT(offset->value, WithinAbs(-5.0, VALUE_TOLERANCE));
+    }
+
+    SECTION("decodes only the active mux group") {
+        auto results = dbc.decode(makeFrame(FRAME_ID_MUX, "0110270000000000"));
+        REQUIRE(results.size() == 2);
+        REQUIRE(findChannel(results, "WheelFL") == nullptr);
+
+        const auto* wheel = findChannel(results, "WheelRR");
+        REQUIRE(wheel != nullptr);
+        REQUIRE_THAT(wheel->value, WithinAbs(100.0, VALUE_TOLERANCE));
+    }
+
+    SECTION("decodes IEEE float signals") {
+        QCanBusFrame frame = makeFrame(FRAME_ID_EXTENDED, "0000484100000000");
+        frame.setExtendedFrameFormat(true);
+        auto results = dbc.decode(frame);
+
+        const auto* value = findChannel(results, "FloatValue");
+        REQUIRE(value != nullptr);
+        REQUIRE_THAT(value->value, WithinAbs(12.5, VALUE_TOLERANCE));
+    }
+
+    SECTION("skips signals beyond a short payload") {
+        auto results = dbc.decode(makeFrame(FRAME_ID_ENGINE, "E02E"));
+        REQUIRE(results.size() == 1);
+        REQUIRE(findChannel(results, "EngineSpeed") != nullptr);
+    }
+
+    SECTION("unknown frame ID returns empty") {
+        REQUIRE(dbc.decode(makeFrame(FRAME_ID_UNKNOWN, "0000000000000000")).empty());
+    }
+
+    SECTION("invalid frame returns empty") {
+        REQUIRE(dbc.decode(QCanBusFrame(QCanBusFrame::InvalidFrame)).empty());
+    }
+}
+
+TEST_CASE("DbcProtocol resolves value descriptions", "[dbc][protocol]") {
+    devdash::DbcProtocol dbc;
+    REQUIRE(dbc.loadFromString(QString::fromUtf8(TEST_DBC)));
+
+    const devdash::FrameKey engine{FRAME_ID_ENGINE, false};
+    REQUIRE(dbc.valueDescription(engine, "GearState", 3) == "Drive");
+    REQUIRE(dbc.valueDescription(engine, "GearState", 0) == "Park");
+    REQUIRE(dbc.valueDescription(engine, "GearState", 9).isEmpty());
+    REQUIRE(dbc.valueDescription(engine, "EngineSpeed", 0).isEmpty());
+    REQUIRE(dbc.valueDescription({FRAME_ID_MOTOROLA, false}, "GearState", 3).isEmpty());
+
+    SECTION("decoded values carry their description") {
+        auto results = dbc.decode(makeFrame(FRAME_ID_ENGINE, "E02E82383F000000"));
+        const auto* gear = findChannel(results, "GearState");
+        REQUIRE(gear != nullptr);
+        REQUIRE(gear->text == "Drive");
+        REQUIRE(findChannel(results, "EngineSpeed")->text.isEmpty());
+    }
+}
+
+TEST_CASE("DbcProtocol keeps messages and value tables apart", "[dbc][protocol]") {
+    devdash::DbcProtocol dbc;
+    REQUIRE(dbc.loadFromString(QString::fromUtf8(CLASHING_DBC)));
+
+    SECTION("standard and extended frames with the same ID are different messages") {
+        REQUIRE(dbc.claimedFrames().size() == 3);
+        REQUIRE(dbc.findMessage({FRAME_ID_STATUS, false})->name == "StandardStatus");
+        REQUIRE(dbc.findMessage({FRAME_ID_STATUS, true})->name == "ExtendedStatus");
+    }
+
+    SECTION("value tables of same-named signals do not collide") {
+        REQUIRE(dbc.valueDescription({FRAME_ID_STATUS, false}, "Mode", 1) == "Sport");
+        REQUIRE(dbc.valueDescription({FRAME_ID_STATUS, true}, "Mode", 1) == "Limp");
+
+        QCanBusFrame frame = makeFrame(FRAME_ID_STATUS, "01");
+        REQUIRE(findChannel(dbc.decode(frame), "StandardStatus.Mode")->text == "Sport");
+        frame.setExtendedFrameFormat(true);
+        REQUIRE(findChannel(dbc.decode(frame), "ExtendedStatus.Mode")->text == "Limp");
+    }
+
+    SECTION("the first definition of a duplicate message is kept") {
+        const auto* message = dbc.findMessage({FRAME_ID_DUPLICATE, false});
+        REQUIRE(message != nullptr);
+        REQUIRE(message->name == "FirstDefinition");
+        REQUIRE(findChannel(dbc.decode(makeFrame(FRAME_ID_DUPLICATE, "05")), "Counter") !=
+                nullptr);
+    }
+}
+
+TEST_CASE("DbcProtocol qualifies signal names shared by several messages", "[dbc][protocol]") {
+    devdash::DbcProtocol dbc;
+    REQUIRE(dbc.loadFromString(QString::fromUtf8(SHARED_NAMES_DBC)));
+
+    const QSet<QString> channels = dbc.availableChannels();
+    REQUIRE(channels.contains("EngineCounter.Counter"));
+    REQUIRE(channels.contains("BrakeCounter.Counter"));
+    REQUIRE_FALSE(channels.contains("Counter"));
+    REQUIRE(channels.contains("Lambda"));
+    REQUIRE(dbc.frameChannels({FRAME_ID_BRAKE_COUNTER, false}) ==
+            QStringList{"BrakeCounter.Counter", "CoolantTemp"});
+
+    SECTION("each message publishes its own channel") {
+        const auto engine = dbc.decode(makeFrame(FRAME_ID_ENGINE_COUNTER, "0500"));
+        const auto brake = dbc.decode(makeFrame(FRAME_ID_BRAKE_COUNTER, "0700"));
+        REQUIRE(findChannel(engine, "EngineCounter.Counter")->value == 5.0);
+        REQUIRE(findChannel(brake, "BrakeCounter.Counter")->value == 7.0);
+        REQUIRE(findChannel(brake, "BrakeCounter.Counter")->text == "Wrapped");
+        REQUIRE(findChannel(brake, "Counter") == nullptr);
+    }
+
+    SECTION("value descriptions are still looked up by signal name") {
+        REQUIRE(dbc.valueDescription({FRAME_ID_BRAKE_COUNTER, false}, "Counter", 7) ==
+                "Wrapped");
+    }
+
+    SECTION("names shared with another file are qualified on request") {
+        devdash::DbcProtocol other;
+        REQUIRE(other.loadFromString(QString::fromUtf8(TEST_DBC)));
+        const QSet<QString> shared = channels & other.availableChannels();
+        REQUIRE(shared == QSet<QString>{"CoolantTemp"});
+
+        dbc.qualifyChannels(shared);
+        other.qualifyChannels(shared);
+        REQUIRE(dbc.availableChannels().contains("BrakeCounter.CoolantTemp"));
+        REQUIRE(other.availableChannels().contains("EngineData.CoolantTemp"));
+        REQUIRE(findChannel(other.decode(makeFrame(FRAME_ID_ENGINE, "E02E82383F000000")),
+                            "EngineData.CoolantTemp") != nullptr);
+    }
+}
@@ -0,0 +1,255 @@
+/**
+ * @file test_protocol_cache.cpp
+ * @brief Unit tests for the binary protocol decode-table cache.
+ *
+ * Tests cover:
+ * - Cache files are only accepted for a matching schema, loader version and
+ *   source hash
+ * - HaltechProtocol round-trips its definitions through the cache
+ * - Editing the JSON regenerates the cache transparently
+ * - Truncated cache files and bounded reads are rejected
+ * - String tables round-trip by index
+ */
+
+#include "adapters/decode/ProtocolCache.h"
+#include "adapters/haltech/HaltechProtocol.h"
+
+#include <QCanBusFrame>
+#include <QFile>
+#include <QTemporaryDir>
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+
+using Catch::Matchers::WithinAbs;
+using devdash::ProtocolCache;
+
+namespace {
+
+//=============================================================================
+// Test Constants
+//=============================================================================
+
+constexpr uint32_t FRAME_ID_ENGINE_CORE_1 = 0x360;
+constexpr uint32_t FRAME_ID_TEMPS_1 = 0x3E0;
+
+/// 0x0DAC = 3500 RPM, 0x03F5 = 101.3 kPa
+constexpr double TEST_RPM_VALUE = 3500.0;
+constexpr double TEST_MAP_VALUE = 101.3;
+
+/// 0x0E30 = 3632 → 363.2 K → 90.05 °C
+constexpr double TEST_TEMP_CELSIUS = 90.05;
+
+constexpr double VALUE_TOLERANCE = 0.01;
+
+/// Loader version of the entries written by the tests
+constexpr uint32_t LOADER_VERSION = 7;
+
+/// Minimal Haltech protocol definition with two frames
+constexpr const char* HALTECH_JSON = R"({
+  "frames": {
+    "0x360": {
+      "name": "Engine Core 1",
+      "rate_hz": 50,
+      "channels": [
+        {"name": "RPM", "bytes": [0, 1], "signed": false, "units": "RPM", "conversion": "x"},
+        {"name": "Manifold Pressure", "bytes": [2, 3], "signed": false, "units": "kPa",
+         "conversion": "x / 10"}
+      ]
+    },
+    "0x3E0": {
+      "name": "Temps 1",
+      "rate_hz": 5,
+      "channels": [
+        {"name": "Coolant Temperature", "bytes": [0, 1], "signed": false, "units": "K",
+         "conversion": "x / 10"}
+      ]
+    }
+  }
+})";
+
+//=============================================================================
+// Test Helpers
+//=============================================================================
+
+QString writeFile(const QString& path, const QByteArray& contents) {
+    QFile file(path);
+    REQUIRE(file.open(QIODevice::WriteOnly | QIODevice::Truncate));
+    file.write(contents);
+    return path;
+}
+
+double channelValue(const std::vector<std::pair<QString, devdash::ChannelValue>>& results,
+                    const QString& name) {
+    for (const auto& [channelName, value] : results) {
+        if (channelName == name) {
+            return value.value;
+        }
+    }
+    FAIL("channel not decoded: " << name.toStdString());
+    return 0.0;
+}
+
+} // anonymous namespace
+
+//=============================================================================
+// ProtocolCache Tests
+//=============================================================================
+
+TEST_CASE("ProtocolCache validates schema, loader version and source hash",
+          "[decode][cache]") {
+    QTemporaryDir cacheDir;
+    REQUIRE(cacheDir.isValid());
+    const ProtocolCache cache(cacheDir.path());
+
+    const auto hash = ProtocolCache::hashSource("source v1");
+    const QString path = cache.pathFor("/tmp/protocol.json", ProtocolCache::Schema::HaltechFrames);
+    REQUIRE(
+        cache.write(path, ProtocolCache::Schema::HaltechFrames, LOADER_VERSION, hash, "body"));
+
+    SECTION("matching entry maps its body") {
+        const ProtocolCache::Mapping mapping(path, ProtocolCache::Schema::HaltechFrames,
+                                             LOADER_VERSION, hash);
+        REQUIRE(mapping.isValid());
+        REQUIRE(mapping.body().toByteArray() == "body");
+    }
+
+    SECTION("changed source is rejected") {
+        const ProtocolCache::Mapping mapping(path, ProtocolCache::Schema::HaltechFrames,
+                                             LOADER_VERSION,
+                                             ProtocolCache::hashSource("source v2"));
+        REQUIRE_FALSE(mapping.isValid());
+    }
+
+    SECTION("other schema is rejected") {
+        const ProtocolCache::Mapping mapping(path, ProtocolCache::Schema::PD16Tables,
+                                             LOADER_VERSION, hash);
+        REQUIRE_FALSE(mapping.isValid());
+    }
+
+    SECTION("other loader version is rejected") {
+        const ProtocolCache::Mapping mapping(path, ProtocolCache::Schema::HaltechFrames,
+                                             LOADER_VERSION + 1, hash);
+        REQUIRE_FALSE(mapping.isValid());
+    }
+
+    SECTION("truncated file is rejected") {
+        QFile file(path);
+        REQUIRE(file.resize(file.size() - 1));
+        const ProtocolCache::Mapping mapping(path, ProtocolCache::Schema::HaltechFrames,
+                                             LOADER_VERSION, hash);
+        REQUIRE_FALSE(mapping.isValid());
+    }
+
+    SECTION("different sources get different cache files") {
+        REQUIRE(cache.pathFor("/a/protocol.json", ProtocolCache::Schema::HaltechFrames) !=
+                cache.pathFor("/b/protocol.json", ProtocolCache::Schema::HaltechFrames));
+    }
+}
+
+TEST_CASE("ProtocolCache reader never reads past the body", "[decode][cache]") {
+    ProtocolCache::Writer writer;
+    writer.append(uint32_t{7});
+    writer.appendPadded("abc");
+    REQUIRE(writer.data().size() == 8);
+
+    ProtocolCache::Reader reader(writer.data());
+    uint32_t value = 0;
+    REQUIRE(reader.read(value));
+    REQUIRE(value == 7);
+
+    std::vector<uint32_t> values;
+    REQUIRE(reader.readArray(values, 1));
+    REQUIRE_FALSE(reader.readArray(values, 1));
+    REQUIRE_FALSE(reader.read(value));
+}
+
+TEST_CASE("ProtocolCache string tables round-trip", "[decode][cache]") {
+    ProtocolCache::StringTable strings;
+    const uint32_t rpm = strings.intern("RPM");
+    const uint32_t celsius = strings.intern(QString::fromUtf8("°C"));
+    REQUIRE(strings.intern("RPM") == rpm);
+    REQUIRE(strings.count() == 2);
+
+    ProtocolCache::Writer writer;
+    writer.appendStrings(strings);
+
+    SECTION("strings are restored by index") {
+        ProtocolCache::Reader reader(writer.data());
+        std::vector<QString> text;
+        REQUIRE(reader.readStrings(strings.count(), strings.codeUnits(), text));
+        REQUIRE(text.size() == 2);
+        REQUIRE(text[rpm] == "RPM");
+        REQUIRE(text[celsius] == QString::fromUtf8("°C"));
+    }
+
+    SECTION("string data longer than the body is rejected") {
+        ProtocolCache::Reader reader(writer.data());
+        std::vector<QString> text;
+        REQUIRE_FALSE(reader.readStrings(strings.count(), strings.codeUnits() + 8, text));
+    }
+}
+
+//=============================================================================
+// HaltechProtocol Cache Tests
+//=============================================================================
+
+TEST_CASE("HaltechProtocol loads definitions through the binary cache", "[decode][cache]") {
+    QTemporaryDir sourceDir;
+    QTemporaryDir cacheDir;
+    REQUIRE(sourceDir.isValid());
+    REQUIRE(cacheDir.isValid());
+    const QString jsonPath = writeFile(sourceDir.filePath("haltech.json"), HALTECH_JSON);
+
+    devdash::HaltechProtocol first;
+    first.setCacheDirectory(cacheDir.path());
+    REQUIRE(first.loadDefinition(jsonPath));
+    REQUIRE_FALSE(first.loadedFromCache());
+
+    devdash::HaltechProtocol cached;
+    cached.setCacheDirectory(cacheDir.path());
+    REQUIRE(cached.loadDefinition(jsonPath));
+    REQUIRE(cached.loadedFromCache());
+
+    SECTION("cached definitions decode identically") {
+        REQUIRE(cached.frameIds().size() == first.frameIds().size());
+        REQUIRE(cached.availableChannels() == first.availableChannels());
+        REQUIRE(cached.declaredRateHz({FRAME_ID_ENGINE_CORE_1, false}) == 50.0);
+
+        auto results = cached.decode(
+            QCanBusFrame(FRAME_ID_ENGINE_CORE_1, QByteArray::fromHex("0DAC03F501F40000")));
+        REQUIRE(channelValue(results, "RPM") == TEST_RPM_VALUE);
+        REQUIRE_THAT(channelValue(results, "Manifold Pressure"),
+                     WithinAbs(TEST_MAP_VALUE, VALUE_TOLERANCE));
+
+        auto temps =
+            cached.decode(QCanBusFrame(FRAME_ID_TEMPS_1, QByteArray::fromHex("0E30000000000000")));
+        REQUIRE_THAT(channelValue(temps, "Coolant Temperature"),
+                     WithinAbs(TEST_TEMP_CELSIUS, VALUE_TOLERANCE));
+        REQUIRE(temps[0].second.unit == QString::fromUtf8("°C"));
+    }
+
+    SECTION("editing the JSON regenerates the cache") {
+        QByteArray edited(HALTECH_JSON);
+        edited.replace("\"rate_hz\": 50", "\"rate_hz\": 100");
+        writeFile(jsonPath, edited);
+
+        devdash::HaltechProtocol reparsed;
+        reparsed.setCacheDirectory(cacheDir.path());
+        REQUIRE(reparsed.loadDefinition(jsonPath));
+        REQUIRE_FALSE(reparsed.loadedFromCache());
+        REQUIRE(reparsed.declaredRateHz({FRAME_ID_ENGINE_CORE_1, false}) == 100.0);
+
+        devdash::HaltechProtocol recached;
+        recached.setCacheDirectory(cacheDir.path());
+        REQUIRE(recached.loadDefinition(jsonPath));
+        REQUIRE(recached.loadedFromCache());
+    }
+
+    SECTION("empty cache directory disables caching") {
+        devdash::HaltechProtocol uncached;
+        uncached.setCacheDirectory(QString());
+        REQUIRE(uncached.loadDefinition(jsonPath));
+        REQUIRE_FALSE(uncached.loadedFromCache());
+    }
+}
@@ -0,0 +1,124 @@
+/**
+ * @file test_signal_extractor.cpp
+ * @brief Unit tests for the precompiled SignalExtractor bit programs.
+ *
+ * Tests cover:
+ * - Whole-byte big-endian fields (Haltech layout)
+ * - DBC Intel and Motorola bit numbering, including byte-crossing signals
+ * - Haltech "byte:bit-byte:bit" position notation (PD16 layout)
+ * - Sign extension, float reinterpretation and layout validation
+ */
+
+#include "adapters/decode/SignalExtractor.h"
+
+#include <array>
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+
+using Catch::Matchers::WithinAbs;
+using devdash::ByteOrder;
+using devdash::SignalExtractor;
+
+namespace {
+
+/// Shared payload: 0x0DAC = 3500, 0x03F5 = 1013, 0xFF80 = -128
+constexpr std::array<uint8_t, 8> PAYLOAD = {0x0D, 0xAC, 0x03, 0xF5, 0x01, 0xF4, 0xFF, 0x80};
+
+constexpr double VALUE_TOLERANCE = 0.0001;
+
+} // anonymous namespace
+
+TEST_CASE("SignalExtractor decodes whole-byte fields", "[decode][extractor]") {
+    SECTION("unsigned big-endian uint16") {
+        auto extractor = SignalExtractor::fromBytes(0, 2, false);
+        REQUIRE(extractor.has_value());
+        REQUIRE(extractor->extractBits(PAYLOAD.data()) == 3500);
+        REQUIRE(extractor->requiredLength() == 2);
+    }
+
+    SECTION("signed big-endian int16") {
+        auto extractor = SignalExtractor::fromBytes(6, 2, true);
+        REQUIRE(extractor.has_value());
+        REQUIRE(extractor->extractRaw(PAYLOAD.data()) == -128);
+    }
+
+    SECTION("scale and offset") {
+        auto extractor = SignalExtractor::fromBytes(2, 2, false);
+        REQUIRE(extractor.has_value());
+        extractor->scale = 0.1;
+        extractor->offset = -101.3;
+        REQUIRE_THAT(extractor->extract(PAYLOAD.data()), WithinAbs(0.0, VALUE_TOLERANCE));
+    }
+}
+
+TEST_CASE("SignalExtractor follows DBC bit numbering", "[decode][extractor]") {
+    SECTION("Intel 16-bit") {
+        auto extractor = SignalExtractor::fromDbc(0, 16, ByteOrder::LittleEndian, false);
+        REQUIRE(extractor.has_value());
+        REQUIRE(extractor->extractBits(PAYLOAD.data()) == 0xAC0D);
+    }
+
+    SECTION("Motorola 16-bit") {
+        auto extractor = SignalExtractor::fromDbc(7, 16, ByteOrder::BigEndian, false);
+        REQUIRE(extractor.has_value());
+        REQUIRE(extractor->extractBits(PAYLOAD.data()) == 0x0DAC);
+    }
+
+    SECTION("Intel signed nibble") {
+        auto extractor = SignalExtractor::fromDbc(12, 4, ByteOrder::LittleEndian, true);
+        REQUIRE(extractor.has_value());
+        REQUIRE(extractor->extractRaw(PAYLOAD.data()) == -6);
+    }
+
+    SECTION("Motorola byte-crossing") {
+        auto extractor = SignalExtractor::fromDbc(3, 8, ByteOrder::BigEndian, false);
+        REQUIRE(extractor.has_value());
+        REQUIRE(extractor->extractBits(PAYLOAD.data()) == 0xDA);
+    }
+
+    SECTION("Intel byte-crossing") {
+        auto extractor = SignalExtractor::fromDbc(4, 8, ByteOrder::LittleEndian, false);
+        REQUIRE(extractor.has_value());
+        REQUIRE(extractor->extractBits(PAYLOAD.data()) == 0xC0);
+    }
+
+    SECTION("full 64-bit signal") {
+        auto extractor = SignalExtractor::fromDbc(0, 64, ByteOrder::LittleEndian, false);
+        REQUIRE(extractor.has_value());
+        REQUIRE(extractor->byteCount == 8);
+    }
+
+    SECTION("rejects signals spanning more than 8 bytes") {
+        REQUIRE_FALSE(SignalExtractor::fromDbc(1, 64, ByteOrder::LittleEndian, false));
+        REQUIRE_FALSE(SignalExtractor::fromDbc(0, 0, ByteOrder::LittleEndian, false));
+    }
+}
+
+TEST_CASE("SignalExtractor follows Haltech position notation", "[decode][extractor]") {
+    SECTION("2:7-3:0 is a big-endian uint16 at byte 2") {
+        auto extractor = SignalExtractor::fromPositions(2, 7, 3, 0, false);
+        REQUIRE(extractor.has_value());
+        REQUIRE(extractor->extractBits(PAYLOAD.data()) == 0x03F5);
+    }
+
+    SECTION("7:7-7:4 is the high nibble of byte 7") {
+        auto extractor = SignalExtractor::fromPositions(7, 7, 7, 4, false);
+        REQUIRE(extractor.has_value());
+        REQUIRE(extractor->extractBits(PAYLOAD.data()) == 8);
+    }
+
+    SECTION("rejects invalid bit numbers") {
+        REQUIRE_FALSE(SignalExtractor::fromPositions(0, 8, 0, 0, false));
+    }
+}
+
+TEST_CASE("SignalExtractor reinterprets IEEE floats", "[decode][extractor]") {
+    // 1.5f = 0x3FC00000, little-endian in the payload
+    constexpr std::array<uint8_t, 4> FLOAT_PAYLOAD = {0x00, 0x00, 0xC0, 0x3F};
+
+    auto extractor = SignalExtractor::fromDbc(0, 32, ByteOrder::LittleEndian, false);
+    REQUIRE(extractor.has_value());
+    extractor->valueType = devdash::SignalValueType::Float32;
+    REQUIRE_THAT(extractor->extract(FLOAT_PAYLOAD.data()), WithinAbs(1.5, VALUE_TOLERANCE));
+}
@@ -8,6 +8,7 @@
  * - Conversion formula parsing and application
  * - JSON protocol loading
  * - Full frame decoding with JSON definitions
+ * - CAN FD frames with wide payloads and multi-byte fields
  */
 
 #include "adapters/haltech/HaltechProtocol.h"
@@ -460,4 +461,66 @@ TEST_CASE("HaltechProtocol decodes with JSON definition", "[haltech][protocol][j
         auto results = protocol.decode(frame);
         REQUIRE(results.empty());
     }
-}
\ No newline at end of file
+}
+
+//=============================================================================
+// CAN FD Decoding
+//=============================================================================
+
+TEST_CASE("HaltechProtocol decodes CAN FD frames", "[haltech][protocol][canfd]") {
+    // 64-byte frame: RPM at the start, a 32-bit counter mid-frame and a
+    // signed field in the last two bytes
+    constexpr uint32_t FRAME_ID_FD = 0x500;
+    constexpr const char* FD_PROTOCOL_JSON = R"({
+      "frames": {
+        "0x500": {
+          "name": "FD Engine",
+          "rate_hz": 100,
+          "channels": [
+            {"name": "RPM", "bytes": [0, 1], "signed": false, "units": "RPM", "conversion": "x"},
+            {"name": "Counter", "bytes": [20, 21, 22, 23], "signed": false, "units": "",
+             "conversion": "x"},
+            {"name": "Trim", "bytes": [62, 63], "signed": true, "units": "%",
+             "conversion": "x / 10"}
+          ]
+        }
+      }
+    })";
+
+    QTemporaryFile protocolFile;
+    REQUIRE(protocolFile.open());
+    protocolFile.write(FD_PROTOCOL_JSON);
+    protocolFile.close();
+
+    devdash::HaltechProtocol protocol;
+    protocol.setCacheDirectory(QString());
+    REQUIRE(protocol.loadDefinition(protocolFile.fileName()));
+
+    constexpr int FD_PAYLOAD_SIZE = 64;
+    QByteArray payload(FD_PAYLOAD_SIZE, '\0');
+    payload[0] = '\x0D';
+    payload[1] = '\xAC';
+    payload[20] = '\x00';
+    payload[21] = '\x01';
+    payload[22] = '\x00';
+    payload[23] = '\x02';
+    payload[62] = '\xFF';
+    payload[63] = '\x9C';
+
+    SECTION("extracts fields across the whole 64-byte payload") {
+        QCanBusFrame frame(FRAME_ID_FD, payload);
+        REQUIRE(frame.hasFlexibleDataRateFormat());
+
+        auto results = protocol.decode(frame);
+        REQUIRE(results.size() == 3);
+        REQUIRE(findChannel(results, "rpm")->value == TEST_RPM_VALUE);
+        REQUIRE(findChannel(results, "counter")->value == 65538.0);
+        REQUIRE_THAT(findChannel(results, "trim")->value, WithinAbs(-10.0, VOLTAGE_TOLERANCE));
+    }
+
+    SECTION("short frame decodes only the fields it contains") {
+        auto results = protocol.decode(QCanBusFrame(FRAME_ID_FD, payload.left(24)));
+        REQUIRE(results.size() == 2);
+        REQUIRE(findChannel(results, "trim") == nullptr);
+    }
+}
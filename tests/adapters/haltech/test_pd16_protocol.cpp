@@ -10,15 +10,22 @@
  * - Output status decoding (25A, 8A channels)
  * - Device status decoding (firmware version)
  * - IO type name lookup
+ * - Decode programs compiled from the bundled protocol JSON
+ * - Several devices in one instance, pd16ChannelMapping aliases
  */
 
 #include "adapters/haltech/PD16Protocol.h"
 
 #include <QCanBusFrame>
+#include <QFile>
+#include <QJsonObject>
+#include <QTemporaryDir>
 
 #include <catch2/catch_test_macros.hpp>
 #include <catch2/matchers/catch_matchers_floating_point.hpp>
 
+#include <algorithm>
+
 using Catch::Matchers::WithinAbs;
 
 namespace {
@@ -128,10 +135,50 @@ constexpr double FW_VERSION_TOLERANCE = 0.0001;
 /// ECU frame ID (for negative testing - should be ignored by PD16)
 constexpr uint32_t ECU_FRAME_ID = 0x360;
 
+/// Diagnostics frame offset from base (only defined by the JSON)
+constexpr int FRAME_OFFSET_DIAGNOSTICS = 6;
+
+/// Declared output status rate
+constexpr double OUTPUT_STATUS_RATE_HZ = 5.0;
+
 //=============================================================================
 // Test Helpers
 //=============================================================================
 
+/**
+ * @brief Find the bundled PD16 protocol file relative to the test directory.
+ * @return Path to protocol JSON, or empty string if not found
+ */
+QString findProtocolFile() {
+    QStringList paths = {
+        "protocols/haltech/haltech-pd16-can-protocol.json",
+        "../protocols/haltech/haltech-pd16-can-protocol.json",
+        "../../protocols/haltech/haltech-pd16-can-protocol.json",
+        "../../../protocols/haltech/haltech-pd16-can-protocol.json",
+    };
+
+    for (const auto& path : paths) {
+        if (QFile::exists(path)) {
+            return path;
+        }
+    }
+    return QString();
+}
+
+/**
+ * @brief Find a channel by exact name in decode results.
+ */
+const devdash::ChannelValue* findExact(
+    const std::vector<std::pair<QString, devdash::ChannelValue>>& results,
+    const QString& name) {
+    for (const auto& [channelName, value] : results) {
+        if (channelName == name) {
+            return &value;
+        }
+    }
+    return nullptr;
+}
+
 /**
  * @brief Create a valid CAN frame with given ID and hex payload.
  */
@@ -475,4 +522,248 @@ TEST_CASE("PD16Protocol handles edge cases", "[pd16][protocol]") {
         auto results = protocol.decode(frame);
         REQUIRE(!results.empty());
     }
-}
\ No newline at end of file
+}
+
+//=============================================================================
+// JSON-Compiled Decode Programs
+//=============================================================================
+
+TEST_CASE("PD16Protocol compiles decode programs from the protocol JSON", "[pd16][protocol]") {
+    QString protocolPath = findProtocolFile();
+    if (protocolPath.isEmpty()) {
+        SKIP("Protocol file not found");
+    }
+
+    devdash::PD16Protocol protocol;
+    protocol.setCacheDirectory(QString());
+    REQUIRE(protocol.loadDefinition(protocolPath));
+    REQUIRE(protocol.isLoaded());
+    REQUIRE_FALSE(protocol.usingFallback());
+
+    SECTION("keeps the channel names of the built-in layout") {
+        uint32_t frameId = BASE_ID_DEVICE_A + FRAME_OFFSET_OUTPUT_STATUS;
+        auto results = protocol.decode(makeFrame(frameId, "00502EE03A983200"));
+
+        auto* load = findExact(results, "pd16_A_25A_0_load");
+        REQUIRE(load != nullptr);
+        REQUIRE(load->value == TEST_LOAD_PERCENT);
+        REQUIRE(load->unit == "%");
+
+        auto* currentLow = findExact(results, "pd16_A_25A_0_currentLow");
+        REQUIRE(currentLow != nullptr);
+        REQUIRE_THAT(currentLow->value, WithinAbs(TEST_CURRENT_A, VOLTAGE_TOLERANCE));
+        REQUIRE(findExact(results, "pd16_A_25A_0_retries") != nullptr);
+        REQUIRE(findExact(results, "pd16_A_25A_0_pinState") != nullptr);
+    }
+
+    SECTION("decodes IO types only the JSON defines") {
+        // Half bridge (type 2), index 1 → 0x41; voltage 12000 mV
+        uint32_t frameId = BASE_ID_DEVICE_A + FRAME_OFFSET_OUTPUT_STATUS;
+        auto results = protocol.decode(makeFrame(frameId, "41002EE000000000"));
+
+        auto* voltage = findExact(results, "pd16_A_HBO_1_voltage");
+        REQUIRE(voltage != nullptr);
+        REQUIRE_THAT(voltage->value, WithinAbs(TEST_12V_VOLTAGE, VOLTAGE_TOLERANCE));
+    }
+
+    SECTION("decodes mux-ID diagnostics pages") {
+        // Mux ID 0: main rail voltage 12000 mV in bytes 2-3
+        uint32_t frameId = BASE_ID_DEVICE_A + FRAME_OFFSET_DIAGNOSTICS;
+        auto results = protocol.decode(makeFrame(frameId, "00002EE000000000"));
+
+        auto* mainRail = findExact(results, "pd16_A_mainRailVoltage");
+        REQUIRE(mainRail != nullptr);
+        REQUIRE_THAT(mainRail->value, WithinAbs(TEST_12V_VOLTAGE, VOLTAGE_TOLERANCE));
+        REQUIRE(mainRail->unit == "V");
+    }
+
+    SECTION("derives the firmware version from its fields") {
+        protocol.setDeviceId(devdash::PD16Protocol::DeviceId::B);
+        uint32_t frameId = BASE_ID_DEVICE_B + FRAME_OFFSET_DEVICE_STATUS;
+        auto results = protocol.decode(makeFrame(frameId, "10020F0300000000"));
+
+        auto* version = findExact(results, "pd16_B_firmwareVersion");
+        REQUIRE(version != nullptr);
+        REQUIRE_THAT(version->value, WithinAbs(TEST_FW_VERSION, FW_VERSION_TOLERANCE));
+        REQUIRE(findExact(results, "pd16_B_fwMinorVersion") != nullptr);
+    }
+
+    SECTION("ignores mux indices the JSON does not list") {
+        // 25A outputs only have indices 0-3
+        uint32_t frameId = BASE_ID_DEVICE_A + FRAME_OFFSET_OUTPUT_STATUS;
+        auto results = protocol.decode(makeFrame(frameId, "05502EE03A983200"));
+        REQUIRE(results.empty());
+    }
+
+    SECTION("claims the frames and rates the JSON declares") {
+        auto frames = protocol.claimedFrames();
+        REQUIRE(std::any_of(frames.begin(), frames.end(), [](const devdash::FrameKey& key) {
+            return key.frameId == BASE_ID_DEVICE_A + FRAME_OFFSET_DIAGNOSTICS;
+        }));
+        REQUIRE(protocol.declaredRateHz(
+                    {BASE_ID_DEVICE_A + FRAME_OFFSET_OUTPUT_STATUS, false}) ==
+                OUTPUT_STATUS_RATE_HZ);
+    }
+}
+
+TEST_CASE("PD16Protocol loads decode programs through the binary cache", "[pd16][protocol]") {
+    QString protocolPath = findProtocolFile();
+    if (protocolPath.isEmpty()) {
+        SKIP("Protocol file not found");
+    }
+
+    QTemporaryDir cacheDir;
+    REQUIRE(cacheDir.isValid());
+
+    devdash::PD16Protocol parsed;
+    parsed.setCacheDirectory(cacheDir.path());
+    REQUIRE(parsed.loadDefinition(protocolPath));
+    REQUIRE_FALSE(parsed.loadedFromCache());
+
+    devdash::PD16Protocol cached;
+    cached.setCacheDirectory(cacheDir.path());
+    cached.setDeviceId(devdash::PD16Protocol::DeviceId::C);
+    REQUIRE(cached.loadDefinition(protocolPath));
+    REQUIRE(cached.loadedFromCache());
+    REQUIRE(cached.programCount() == parsed.programCount());
+
+    parsed.setDeviceId(devdash::PD16Protocol::DeviceId::C);
+    uint32_t frameId = BASE_ID_DEVICE_C + FRAME_OFFSET_INPUT_STATUS;
+    QCanBusFrame frame = makeFrame(frameId, "6101138802EE03E8");
+
+    auto expected = parsed.decode(frame);
+    auto actual = cached.decode(frame);
+    REQUIRE(!actual.empty());
+    REQUIRE(actual.size() == expected.size());
+    for (size_t i = 0; i < actual.size(); ++i) {
+        REQUIRE(actual[i].first == expected[i].first);
+        REQUIRE(actual[i].second.value == expected[i].second.value);
+        REQUIRE(actual[i].second.unit == expected[i].second.unit);
+    }
+    REQUIRE(findExact(actual, "pd16_C_SPI_1_dutyCycle") != nullptr);
+}
+
+TEST_CASE("PD16Protocol keeps its programs when a definition is malformed", "[pd16][protocol]") {
+    QTemporaryDir dir;
+    REQUIRE(dir.isValid());
+
+    const QString path = dir.filePath("pd16-bad.json");
+    QFile file(path);
+    REQUIRE(file.open(QIODevice::WriteOnly));
+    file.write(R"({"frames": {"pd16_to_ecu": {"device_status": {"id_offset": 5,
+        "channels": [{"name": "Status", "position": "0:9-0:4"}]}}}})");
+    file.close();
+
+    devdash::PD16Protocol protocol;
+    protocol.setCacheDirectory(QString());
+    REQUIRE_FALSE(protocol.loadDefinition(path));
+    REQUIRE(protocol.usingFallback());
+
+    uint32_t frameId = BASE_ID_DEVICE_A + FRAME_OFFSET_INPUT_STATUS;
+    REQUIRE(!protocol.decode(makeFrame(frameId, "6101138802EE03E8")).empty());
+}
+
+//=============================================================================
+// Multi-Device Decoding Tests
+//=============================================================================
+
+TEST_CASE("PD16Protocol decodes several devices in one instance", "[pd16][protocol]") {
+    using DeviceId = devdash::PD16Protocol::DeviceId;
+
+    devdash::PD16Protocol protocol;
+    protocol.setDevices({DeviceId::B, DeviceId::D});
+
+    SECTION("first device is the primary device") {
+        REQUIRE(protocol.deviceId() == DeviceId::B);
+        REQUIRE(protocol.baseId() == BASE_ID_DEVICE_B);
+        REQUIRE(protocol.devices() == std::vector<DeviceId>{DeviceId::B, DeviceId::D});
+    }
+
+    SECTION("names channels after the device that sent the frame") {
+        auto deviceB = protocol.decode(
+            makeFrame(BASE_ID_DEVICE_B + FRAME_OFFSET_INPUT_STATUS, "6101138802EE03E8"));
+        auto deviceD = protocol.decode(
+            makeFrame(BASE_ID_DEVICE_D + FRAME_OFFSET_INPUT_STATUS, "6101138802EE03E8"));
+
+        REQUIRE(findExact(deviceB, "pd16_B_SPI_1_voltage") != nullptr);
+        REQUIRE(findExact(deviceD, "pd16_D_SPI_1_voltage") != nullptr);
+    }
+
+    SECTION("ignores devices that are not configured") {
+        auto results = protocol.decode(
+            makeFrame(BASE_ID_DEVICE_C + FRAME_OFFSET_INPUT_STATUS, "6101138802EE03E8"));
+        REQUIRE(results.empty());
+    }
+
+    SECTION("claims the frames of every configured device") {
+        protocol.setDevices({DeviceId::A, DeviceId::B, DeviceId::C, DeviceId::D});
+
+        // Built-in layout: input, output and device status per device
+        constexpr size_t BUILTIN_FRAMES_PER_DEVICE = 3;
+        auto frames = protocol.claimedFrames();
+        REQUIRE(frames.size() == BUILTIN_FRAMES_PER_DEVICE * devdash::PD16Protocol::DEVICE_COUNT);
+        REQUIRE(protocol.declaredRateHz(
+                    {BASE_ID_DEVICE_D + FRAME_OFFSET_OUTPUT_STATUS, false}) ==
+                OUTPUT_STATUS_RATE_HZ);
+    }
+
+    SECTION("parses profile device letters") {
+        REQUIRE(devdash::PD16Protocol::deviceFromLetter("c") == DeviceId::C);
+        REQUIRE_FALSE(devdash::PD16Protocol::deviceFromLetter("E").has_value());
+        REQUIRE_FALSE(devdash::PD16Protocol::deviceFromLetter("AB").has_value());
+    }
+}
+
+TEST_CASE("PD16Protocol applies pd16ChannelMapping aliases", "[pd16][protocol]") {
+    devdash::PD16Protocol protocol;
+    protocol.setDevices({devdash::PD16Protocol::DeviceId::A, devdash::PD16Protocol::DeviceId::B});
+
+    QJsonObject mapping{
+        {"fan1", "PD16A_output_25a_0"},
+        {"horn", "PD16B_output_8A_5"},
+    };
+    REQUIRE(protocol.setChannelAliases(mapping) == 2);
+
+    SECTION("aliased IOs are named after the alias") {
+        auto results = protocol.decode(
+            makeFrame(BASE_ID_DEVICE_A + FRAME_OFFSET_OUTPUT_STATUS, "00502EE03A983200"));
+        auto* load = findExact(results, "fan1_load");
+        REQUIRE(load != nullptr);
+        REQUIRE(load->value == TEST_LOAD_PERCENT);
+        REQUIRE(findExact(results, "pd16_A_25A_0_load") == nullptr);
+
+        auto horn = protocol.decode(
+            makeFrame(BASE_ID_DEVICE_B + FRAME_OFFSET_OUTPUT_STATUS, "25002EE03A985000"));
+        REQUIRE(findExact(horn, "horn_current") != nullptr);
+    }
+
+    SECTION("frame channel lists use the aliases") {
+        auto channels =
+            protocol.frameChannels({BASE_ID_DEVICE_A + FRAME_OFFSET_OUTPUT_STATUS, false});
+        REQUIRE(channels.contains("fan1_load"));
+        REQUIRE(channels.contains("pd16_A_25A_1_load"));
+        REQUIRE_FALSE(channels.contains("pd16_A_25A_0_load"));
+        REQUIRE(protocol.frameChannels({BASE_ID_DEVICE_D + FRAME_OFFSET_OUTPUT_STATUS, false})
+                    .isEmpty());
+    }
+
+    SECTION("aliases apply to one device only") {
+        auto results = protocol.decode(
+            makeFrame(BASE_ID_DEVICE_B + FRAME_OFFSET_OUTPUT_STATUS, "00502EE03A983200"));
+        REQUIRE(findExact(results, "pd16_B_25A_0_load") != nullptr);
+    }
+
+    SECTION("invalid references are skipped") {
+        QJsonObject invalid{
+            {"missingIndex", "PD16A_output_25a_12"},
+            {"wrongDirection", "PD16A_input_25a_0"},
+            {"unknownType", "PD16A_output_40a_0"},
+            {"noDevice", "PD16E_output_25a_0"},
+        };
+        REQUIRE(protocol.setChannelAliases(invalid) == 0);
+
+        auto results = protocol.decode(
+            makeFrame(BASE_ID_DEVICE_A + FRAME_OFFSET_OUTPUT_STATUS, "00502EE03A983200"));
+        REQUIRE(findExact(results, "pd16_A_25A_0_load") != nullptr);
+    }
+}
@@ -0,0 +1,258 @@
+/**
+ * @file test_obd2_adapter.cpp
+ * @brief Tests and polling benchmark for the OBD-II adapter against a simulated ECU.
+ *
+ * Tests cover:
+ * - The "obd2" adapter type polling Obd2EcuSimulator over a virtual bus,
+ *   with segmented (multi-frame) multi-PID responses
+ * - Supported-PID discovery excluding PIDs the ECU does not answer
+ * - Fallback to single-PID requests when the ECU rejects multi-PID ones
+ * - Requests in flight staying within maxInFlight
+ * - Achieved PID rate versus requests in flight (hidden benchmark)
+ *
+ * Run the benchmark with:
+ *
+ *     ./build/debug/tests/devdash_tests "[benchmark][obd2]"
+ */
+
+#include "adapters/ProtocolAdapterFactory.h"
+#include "adapters/can/VirtualCanBus.h"
+#include "adapters/obd2/Obd2Adapter.h"
+#include "adapters/simulator/Obd2EcuSimulator.h"
+#include "adapters/simulator/SimulationScenario.h"
+
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QHash>
+#include <QJsonArray>
+#include <QJsonObject>
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+
+#include <functional>
+#include <memory>
+
+using Catch::Matchers::WithinAbs;
+using devdash::ChannelValue;
+using devdash::Obd2Adapter;
+using devdash::Obd2EcuSimulator;
+using devdash::SimulationScenario;
+using devdash::VirtualCanBus;
+
+namespace {
+
+//=============================================================================
+// Test Constants
+//=============================================================================
+
+constexpr int SPIN_TIMEOUT_MS = 5000;
+
+/// PIDs of Obd2Protocol the idle scenario drives (the simulator's default support)
+constexpr int SCENARIO_PIDS = 11;
+
+/// Engine Load: in the PID table, not driven by the scenario
+constexpr const char* UNSUPPORTED_CHANNEL = "Engine Load";
+
+constexpr double RPM_TOLERANCE = 50.0;
+constexpr double TEMPERATURE_TOLERANCE = 1.0;
+
+constexpr int INFLIGHT_RESPONSE_DELAY_MS = 5;
+constexpr uint64_t INFLIGHT_PID_VALUES = 100;
+
+constexpr int BENCHMARK_BITRATE = 500000;
+constexpr int BENCHMARK_RESPONSE_DELAY_MS = 2;
+constexpr int BENCHMARK_PID_VALUES = 500;
+constexpr double BENCHMARK_RATE_HZ = 1000.0;
+
+bool spinUntil(const std::function<bool()>& condition, int timeoutMs = SPIN_TIMEOUT_MS) {
+    QElapsedTimer timer;
+    timer.start();
+    while (!condition()) {
+        if (timer.elapsed() > timeoutMs) {
+            return false;
+        }
+        QCoreApplication::processEvents(QEventLoop::AllEvents, 1);
+    }
+    return true;
+}
+
+/// Profile polling every PID in the table over a virtual bus
+QJsonObject obd2Profile(const QString& busName, const QJsonObject& obd2 = QJsonObject()) {
+    QJsonObject adapterConfig;
+    adapterConfig["interface"] = busName;
+    adapterConfig["backend"] = "virtual";
+    adapterConfig["obd2"] = obd2;
+
+    QJsonObject profile;
+    profile["adapter"] = "obd2";
+    profile["adapterConfig"] = adapterConfig;
+    return profile;
+}
+
+std::unique_ptr<Obd2Adapter> createAdapter(const QJsonObject& profile) {
+    auto adapter = devdash::ProtocolAdapterFactory::createFromConfig(profile);
+    REQUIRE(adapter != nullptr);
+    auto* obd2 = dynamic_cast<Obd2Adapter*>(adapter.get());
+    REQUIRE(obd2 != nullptr);
+    (void)adapter.release();
+    return std::unique_ptr<Obd2Adapter>(obd2);
+}
+
+/// Latest value of every PID channel the adapter published
+struct ChannelRecorder {
+    QHash<QString, ChannelValue> values;
+
+    void attach(Obd2Adapter& adapter) {
+        QObject::connect(&adapter, &Obd2Adapter::channelUpdated,
+                         [this](const QString& channel, const ChannelValue& value) {
+                             if (channel != Obd2Adapter::CHANNEL_PID_RATE) {
+                                 values.insert(channel, value);
+                             }
+                         });
+    }
+};
+
+bool pidSupported(const Obd2Adapter& adapter, const QString& channel) {
+    const QJsonArray pids = adapter.diagnostics()["obd2"].toObject()["pids"].toArray();
+    for (const auto& pid : pids) {
+        if (pid.toObject()["channel"].toString() == channel) {
+            return pid.toObject()["supported"].toBool();
+        }
+    }
+    return false;
+}
+
+} // anonymous namespace
+
+//=============================================================================
+// Adapter Tests
+//=============================================================================
+
+TEST_CASE("Obd2Adapter polls a simulated ECU over the virtual bus", "[obd2][virtual]") {
+    auto bus = VirtualCanBus::get("test-obd2-poll");
+    Obd2EcuSimulator ecu(bus);
+    REQUIRE(ecu.start());
+
+    auto adapter = createAdapter(obd2Profile("test-obd2-poll"));
+    ChannelRecorder recorder;
+    recorder.attach(*adapter);
+    REQUIRE(adapter->start());
+
+    REQUIRE(spinUntil([&recorder]() {
+        return recorder.values.contains("RPM") && recorder.values.contains("Oil Temperature");
+    }));
+    const auto idle = SimulationScenario::fromName("idle")->stateAt(0.0);
+    REQUIRE_THAT(recorder.values["RPM"].value, WithinAbs(idle.rpm, RPM_TOLERANCE));
+    REQUIRE(recorder.values["RPM"].unit == "RPM");
+    REQUIRE_THAT(recorder.values["Oil Temperature"].value,
+                 WithinAbs(idle.oilTemperature, TEMPERATURE_TOLERANCE));
+
+    // Discovery dropped what the ECU does not support
+    const auto& scheduler = adapter->scheduler();
+    REQUIRE_FALSE(scheduler.isDiscovering());
+    REQUIRE(scheduler.pollablePids() == SCENARIO_PIDS);
+    REQUIRE_FALSE(pidSupported(*adapter, UNSUPPORTED_CHANNEL));
+    REQUIRE(pidSupported(*adapter, "RPM"));
+
+    // Six PIDs per request need segmented responses with flow control
+    REQUIRE(spinUntil([&recorder]() { return recorder.values.size() >= SCENARIO_PIDS; }));
+    REQUIRE_FALSE(recorder.values.contains(UNSUPPORTED_CHANNEL));
+    REQUIRE(scheduler.maxPidsPerRequest() == devdash::Obd2Scheduler::MAX_PIDS_PER_REQUEST);
+    REQUIRE(ecu.requestsRejected() == 0);
+    REQUIRE(adapter->diagnostics()["obd2"].toObject()["framingErrors"].toInteger() == 0);
+    REQUIRE(scheduler.stats().timeouts == 0);
+
+    adapter->stop();
+}
+
+TEST_CASE("Obd2Adapter falls back to single-PID requests", "[obd2][virtual]") {
+    auto bus = VirtualCanBus::get("test-obd2-single");
+    Obd2EcuSimulator::Options options;
+    options.maxPidsPerRequest = 1;
+    Obd2EcuSimulator ecu(bus, options);
+    REQUIRE(ecu.start());
+
+    auto adapter = createAdapter(obd2Profile("test-obd2-single"));
+    ChannelRecorder recorder;
+    recorder.attach(*adapter);
+    REQUIRE(adapter->start());
+
+    REQUIRE(spinUntil([&adapter]() { return adapter->scheduler().maxPidsPerRequest() == 1; }));
+    REQUIRE(ecu.requestsRejected() >= 1);
+
+    // Still polling everything, one PID at a time; only the first requests were rejected
+    recorder.values.clear();
+    REQUIRE(spinUntil([&recorder]() { return recorder.values.size() >= SCENARIO_PIDS; }));
+    REQUIRE(static_cast<int>(ecu.requestsRejected()) <=
+            adapter->scheduler().options().maxInFlight);
+
+    adapter->stop();
+}
+
+TEST_CASE("Obd2Adapter keeps at most maxInFlight requests outstanding", "[obd2][virtual]") {
+    for (const int maxInFlight : {1, 3}) {
+        const QString busName = QStringLiteral("test-obd2-inflight-%1").arg(maxInFlight);
+        auto bus = VirtualCanBus::get(busName.toStdString());
+        Obd2EcuSimulator::Options options;
+        options.responseDelayMs = INFLIGHT_RESPONSE_DELAY_MS;
+        Obd2EcuSimulator ecu(bus, options);
+        REQUIRE(ecu.start());
+
+        QJsonObject obd2;
+        obd2["maxInFlight"] = maxInFlight;
+        obd2["maxPidsPerRequest"] = 1;  // Many requests, so the ECU is always busy
+        auto adapter = createAdapter(obd2Profile(busName, obd2));
+        REQUIRE(adapter->start());
+
+        REQUIRE(spinUntil([&ecu]() { return ecu.pidsAnswered() >= INFLIGHT_PID_VALUES; }));
+        // One request is processed, the others wait in the ECU's queue
+        REQUIRE(ecu.maxPending() == maxInFlight - 1);
+        REQUIRE(ecu.requestsDropped() == 0);
+        REQUIRE(adapter->scheduler().stats().timeouts == 0);
+
+        adapter->stop();
+    }
+}
+
+TEST_CASE("Obd2Adapter PID rate by requests in flight", "[.benchmark][obd2]") {
+    const auto run = [](const QString& busName, int maxInFlight, int maxPidsPerRequest) {
+        auto bus = VirtualCanBus::get(busName.toStdString());
+        bus->setBitrate(BENCHMARK_BITRATE, 0);
+        Obd2EcuSimulator::Options options;
+        options.responseDelayMs = BENCHMARK_RESPONSE_DELAY_MS;
+        Obd2EcuSimulator ecu(bus, options);
+        REQUIRE(ecu.start());
+
+        QJsonObject obd2;
+        obd2["maxInFlight"] = maxInFlight;
+        obd2["maxPidsPerRequest"] = maxPidsPerRequest;
+        QJsonObject pids;
+        for (const char* channel : {"RPM", "Vehicle Speed", "Throttle Position",
+                                    "Manifold Pressure", "Coolant Temperature",
+                                    "Oil Temperature"}) {
+            pids[channel] = BENCHMARK_RATE_HZ;  // More than the ECU delivers
+        }
+        obd2["pids"] = pids;
+        auto adapter = createAdapter(obd2Profile(busName, obd2));
+        REQUIRE(adapter->start());
+        REQUIRE(spinUntil([&adapter]() { return !adapter->scheduler().isDiscovering(); }));
+
+        const uint64_t target = adapter->scheduler().stats().responses + BENCHMARK_PID_VALUES;
+        const bool done = spinUntil(
+            [&adapter, target]() { return adapter->scheduler().stats().responses >= target; });
+        adapter->stop();
+        return done;
+    };
+
+    BENCHMARK("500 PID values, 1 in flight, 1 PID per request") {
+        return run("bench-obd2-1x1", 1, 1);
+    };
+    BENCHMARK("500 PID values, 4 in flight, 1 PID per request") {
+        return run("bench-obd2-4x1", 4, 1);
+    };
+    BENCHMARK("500 PID values, 2 in flight, 6 PIDs per request") {
+        return run("bench-obd2-2x6", 2, 6);
+    };
+}
@@ -0,0 +1,423 @@
+/**
+ * @file test_obd2_scheduler.cpp
+ * @brief Tests for ISO-TP reassembly, OBD-II encoding and the PID poll scheduler.
+ *
+ * Tests cover:
+ * - Single frame, segmented and out-of-sequence ISO-TP reception
+ * - Service 01 request encoding, multi-PID response parsing and value scaling
+ * - Packing of due PIDs into multi-PID requests, bounded requests in flight,
+ *   and the throughput packing gains
+ * - Achieved rates proportional to the targets, with and without saturation
+ * - Supported-PID discovery across several bitmaps
+ * - Falling back to single-PID requests and fewer requests in flight
+ *
+ * The scheduler runs against a synthetic clock and a modelled ECU, so the
+ * rate tests are deterministic.
+ */
+
+#include "adapters/obd2/IsoTpReceiver.h"
+#include "adapters/obd2/Obd2Protocol.h"
+#include "adapters/obd2/Obd2Scheduler.h"
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+
+#include <algorithm>
+#include <array>
+#include <deque>
+#include <vector>
+
+using Catch::Matchers::WithinAbs;
+using Catch::Matchers::WithinRel;
+using devdash::IsoTpReceiver;
+using devdash::Obd2PidData;
+using devdash::Obd2Protocol;
+using devdash::Obd2Scheduler;
+
+namespace {
+
+//=============================================================================
+// Test Constants
+//=============================================================================
+
+constexpr uint8_t PID_COOLANT = 0x05;
+constexpr uint8_t PID_MAP = 0x0B;
+constexpr uint8_t PID_RPM = 0x0C;
+constexpr uint8_t PID_SPEED = 0x0D;
+constexpr uint8_t PID_AMBIENT = 0x46;
+constexpr uint8_t PID_OIL = 0x5C;
+
+constexpr int64_t US_PER_SECOND = 1000000;
+constexpr int64_t US_PER_MS = 1000;
+
+/// Simulated poll session length
+constexpr int64_t SESSION_US = 10 * US_PER_SECOND;
+
+//=============================================================================
+// Modelled ECU
+//=============================================================================
+
+/**
+ * @brief ECU that answers every request after a fixed processing time,
+ *        one request at a time, like a real engine ECU
+ */
+struct ModelEcu {
+    int64_t processingUs = 0;
+    int maxPidsPerRequest = Obd2Scheduler::MAX_PIDS_PER_REQUEST;
+
+    struct Answer {
+        int64_t atUs;
+        Obd2Scheduler::Request request;
+    };
+    std::deque<Answer> answers;
+    int64_t busyUntilUs = 0;
+    size_t maxQueued = 0;
+
+    void receive(const Obd2Scheduler::Request& request, int64_t nowUs) {
+        busyUntilUs = std::max(busyUntilUs, nowUs) + processingUs;
+        answers.push_back({busyUntilUs, request});
+        maxQueued = std::max(maxQueued, answers.size());
+    }
+};
+
+/**
+ * @brief Run a poll session: send what the scheduler hands out, answer it
+ *        with @p ecu, close one measurement window at the end
+ */
+void runSession(Obd2Scheduler& scheduler, ModelEcu& ecu, int64_t durationUs = SESSION_US) {
+    scheduler.start(0);
+    int64_t now = 0;
+    while (now < durationUs) {
+        while (!ecu.answers.empty() && ecu.answers.front().atUs <= now) {
+            const auto& request = ecu.answers.front().request;
+            if (request.count > ecu.maxPidsPerRequest) {
+                scheduler.onNegativeResponse(now);
+            } else {
+                (void)scheduler.onResponse(request.pidList(), now);
+            }
+            ecu.answers.pop_front();
+        }
+        scheduler.expire(now);
+        Obd2Scheduler::Request request;
+        while (scheduler.nextRequest(now, request)) {
+            ecu.receive(request, now);
+        }
+
+        int64_t next = scheduler.nextEventUs();
+        if (!ecu.answers.empty()) {
+            next = std::min(next, ecu.answers.front().atUs);
+        }
+        if (next == Obd2Scheduler::NO_EVENT) {
+            break;
+        }
+        now = std::max(next, now + 1);
+    }
+    scheduler.closeWindow(durationUs);
+}
+
+double measuredHz(const Obd2Scheduler& scheduler, uint8_t pid) {
+    for (const auto& stats : scheduler.pidStats()) {
+        if (stats.pid == pid) {
+            return stats.measuredHz;
+        }
+    }
+    return 0.0;
+}
+
+Obd2Scheduler::Options pollingOptions(int maxInFlight, int maxPidsPerRequest) {
+    Obd2Scheduler::Options options;
+    options.maxInFlight = maxInFlight;
+    options.maxPidsPerRequest = maxPidsPerRequest;
+    options.detectSupportedPids = false;
+    return options;
+}
+
+/// Bit of @p pid in the supported-PID bitmap starting at @p basePid
+uint32_t bitmapBit(uint8_t basePid, uint8_t pid) {
+    return 1U << (32 - (pid - basePid));
+}
+
+} // anonymous namespace
+
+//=============================================================================
+// ISO-TP Tests
+//=============================================================================
+
+TEST_CASE("IsoTpReceiver reassembles single and segmented messages", "[obd2][isotp]") {
+    IsoTpReceiver receiver;
+
+    SECTION("Single frame") {
+        const std::array<uint8_t, 8> frame = {0x04, 0x41, 0x0C, 0x1A, 0xF8, 0, 0, 0};
+        REQUIRE(receiver.feed(frame) == IsoTpReceiver::Result::Complete);
+        const std::vector<uint8_t> message(receiver.message().begin(), receiver.message().end());
+        REQUIRE(message == std::vector<uint8_t>{0x41, 0x0C, 0x1A, 0xF8});
+    }
+
+    SECTION("Segmented message round trip") {
+        std::vector<uint8_t> message(20);
+        for (size_t i = 0; i < message.size(); ++i) {
+            message[i] = static_cast<uint8_t>(i + 1);
+        }
+        const auto frames = IsoTpReceiver::segment(message);
+        REQUIRE(frames.size() == 3);
+
+        REQUIRE(receiver.feed(frames[0]) == IsoTpReceiver::Result::FlowControlNeeded);
+        REQUIRE(receiver.isReceiving());
+        REQUIRE(receiver.feed(frames[1]) == IsoTpReceiver::Result::Incomplete);
+        REQUIRE(receiver.feed(frames[2]) == IsoTpReceiver::Result::Complete);
+        const std::vector<uint8_t> received(receiver.message().begin(),
+                                            receiver.message().end());
+        REQUIRE(received == message);
+    }
+
+    SECTION("Out-of-sequence consecutive frame discards the message") {
+        const std::vector<uint8_t> message(20, 0xAA);
+        const auto frames = IsoTpReceiver::segment(message);
+        REQUIRE(receiver.feed(frames[0]) == IsoTpReceiver::Result::FlowControlNeeded);
+        REQUIRE(receiver.feed(frames[2]) == IsoTpReceiver::Result::Error);
+        REQUIRE_FALSE(receiver.isReceiving());
+    }
+
+    SECTION("Flow control frames are ignored") {
+        REQUIRE(receiver.feed(IsoTpReceiver::flowControlFrame()) ==
+                IsoTpReceiver::Result::Incomplete);
+    }
+}
+
+//=============================================================================
+// Protocol Tests
+//=============================================================================
+
+TEST_CASE("Obd2Protocol encodes requests and decodes multi-PID responses", "[obd2]") {
+    SECTION("Request carries the service and the PIDs") {
+        const std::array<uint8_t, 3> pids = {PID_RPM, PID_SPEED, PID_COOLANT};
+        std::array<uint8_t, 8> payload{};
+        REQUIRE(Obd2Protocol::encodeRequest(pids, payload));
+        REQUIRE(payload == std::array<uint8_t, 8>{0x04, 0x01, PID_RPM, PID_SPEED, PID_COOLANT,
+                                                  0, 0, 0});
+
+        const std::array<uint8_t, 7> tooMany = {1, 2, 3, 4, 5, 6, 7};
+        REQUIRE_FALSE(Obd2Protocol::encodeRequest(tooMany, payload));
+    }
+
+    SECTION("Response splits into PIDs and scales values") {
+        // RPM 0x1AF8 / 4 = 1726, speed 60 km/h, coolant 130 - 40 = 90 °C
+        const std::vector<uint8_t> message = {0x41, PID_RPM, 0x1A, 0xF8, PID_SPEED, 60,
+                                              PID_COOLANT, 130};
+        std::vector<Obd2PidData> pids;
+        REQUIRE(Obd2Protocol::parseResponse(message, pids));
+        REQUIRE(pids.size() == 3);
+
+        const auto values = Obd2Protocol::channelValues(pids);
+        REQUIRE(values.size() == 3);
+        REQUIRE(values[0].first == "RPM");
+        REQUIRE_THAT(values[0].second.value, WithinAbs(1726.0, 0.01));
+        REQUIRE(values[0].second.unit == "RPM");
+        REQUIRE(values[1].first == "Vehicle Speed");
+        REQUIRE_THAT(values[1].second.value, WithinAbs(60.0, 0.01));
+        REQUIRE(values[2].first == "Coolant Temperature");
+        REQUIRE_THAT(values[2].second.value, WithinAbs(90.0, 0.01));
+    }
+
+    SECTION("Values survive an encode/decode round trip") {
+        for (const auto& definition : Obd2Protocol::definitions()) {
+            const double value = definition.offset + definition.scale * 100.0;
+            const Obd2PidData data = Obd2Protocol::encodeValue(definition, value);
+            REQUIRE(data.length == definition.dataBytes);
+            REQUIRE_THAT(Obd2Protocol::decodeValue(definition, data),
+                         WithinAbs(value, definition.scale));
+        }
+    }
+
+    SECTION("Negative response is recognised") {
+        const std::vector<uint8_t> negative = {0x7F, 0x01, 0x12};
+        REQUIRE(Obd2Protocol::isNegativeResponse(negative));
+        std::vector<Obd2PidData> pids;
+        REQUIRE_FALSE(Obd2Protocol::parseResponse(negative, pids));
+    }
+}
+
+//=============================================================================
+// Scheduler Tests
+//=============================================================================
+
+TEST_CASE("Obd2Scheduler packs due PIDs and bounds requests in flight", "[obd2][scheduler]") {
+    Obd2Scheduler scheduler;
+    scheduler.setOptions(pollingOptions(2, 6));
+    const std::array<uint8_t, 8> pids = {0x04, 0x05, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F};
+    for (const uint8_t pid : pids) {
+        scheduler.addPid(pid, 10.0);
+    }
+    scheduler.start(0);
+
+    Obd2Scheduler::Request first;
+    Obd2Scheduler::Request second;
+    Obd2Scheduler::Request third;
+    REQUIRE(scheduler.nextRequest(0, first));
+    REQUIRE(first.count == 6);
+    REQUIRE(scheduler.nextRequest(0, second));
+    REQUIRE(second.count == 2);
+    REQUIRE_FALSE(scheduler.nextRequest(0, third));
+    REQUIRE(scheduler.inFlight() == 2);
+
+    SECTION("Answered PIDs are due again one interval later") {
+        REQUIRE(scheduler.onResponse(first.pidList(), US_PER_MS));
+        REQUIRE(scheduler.onResponse(second.pidList(), US_PER_MS));
+        REQUIRE_FALSE(scheduler.nextRequest(US_PER_MS, third));
+        REQUIRE(scheduler.nextEventUs() == 100 * US_PER_MS);
+        REQUIRE(scheduler.stats().responses == 8);
+    }
+
+    SECTION("Cancelled requests are due again and not counted") {
+        scheduler.cancel(second);
+        REQUIRE(scheduler.stats().requests == 1);
+        REQUIRE(scheduler.nextRequest(0, third));
+        REQUIRE(third.pidList().size() == 2);
+        REQUIRE(third.pids == second.pids);
+    }
+}
+
+TEST_CASE("Obd2Scheduler achieves rates proportional to the targets", "[obd2][scheduler]") {
+    Obd2Scheduler scheduler;
+    scheduler.setOptions(pollingOptions(1, 1));
+    scheduler.addPid(PID_RPM, 20.0);
+    scheduler.addPid(PID_MAP, 5.0);
+    scheduler.addPid(PID_COOLANT, 1.0);
+
+    SECTION("ECU keeps up: every PID at its target") {
+        ModelEcu ecu;
+        ecu.processingUs = 5 * US_PER_MS;  // 200 requests/s, 26 needed
+        runSession(scheduler, ecu);
+        REQUIRE_THAT(measuredHz(scheduler, PID_RPM), WithinRel(20.0, 0.05));
+        REQUIRE_THAT(measuredHz(scheduler, PID_MAP), WithinRel(5.0, 0.05));
+        REQUIRE_THAT(measuredHz(scheduler, PID_COOLANT), WithinRel(1.0, 0.15));
+    }
+
+    SECTION("Saturated ECU: rates shrink together, none starves") {
+        ModelEcu ecu;
+        ecu.processingUs = 77 * US_PER_MS;  // 13 requests/s, half of what is asked
+        runSession(scheduler, ecu);
+        const double rpm = measuredHz(scheduler, PID_RPM);
+        const double map = measuredHz(scheduler, PID_MAP);
+        const double coolant = measuredHz(scheduler, PID_COOLANT);
+        REQUIRE(coolant > 0.0);
+        REQUIRE_THAT(rpm / map, WithinRel(4.0, 0.2));
+        REQUIRE_THAT(rpm / coolant, WithinRel(20.0, 0.3));
+        REQUIRE_THAT(scheduler.stats().pidsPerSecond, WithinRel(13.0, 0.05));
+    }
+}
+
+TEST_CASE("Obd2Scheduler gains throughput from multi-PID requests", "[obd2][scheduler]") {
+    const std::array<uint8_t, 6> pids = {0x04, 0x05, 0x0B, 0x0C, 0x0D, 0x11};
+    const auto throughput = [&pids](int maxInFlight, int maxPidsPerRequest) {
+        Obd2Scheduler scheduler;
+        scheduler.setOptions(pollingOptions(maxInFlight, maxPidsPerRequest));
+        for (const uint8_t pid : pids) {
+            scheduler.addPid(pid, 100.0);  // More than any ECU delivers
+        }
+        ModelEcu ecu;
+        ecu.processingUs = 10 * US_PER_MS;
+        runSession(scheduler, ecu);
+        REQUIRE(static_cast<int>(ecu.maxQueued) <= maxInFlight);
+        return scheduler.stats().pidsPerSecond;
+    };
+
+    const double single = throughput(1, 1);
+    REQUIRE_THAT(single, WithinRel(100.0, 0.05));
+    REQUIRE(throughput(1, 6) > 5.0 * single);
+}
+
+TEST_CASE("Obd2Scheduler reads the supported-PID bitmaps before polling", "[obd2][scheduler]") {
+    Obd2Scheduler scheduler;
+    Obd2Scheduler::Options options;
+    options.maxInFlight = 4;
+    scheduler.setOptions(options);
+    scheduler.addPid(PID_RPM, 20.0);
+    scheduler.addPid(PID_SPEED, 20.0);
+    scheduler.addPid(PID_AMBIENT, 1.0);
+    scheduler.addPid(PID_OIL, 1.0);
+    scheduler.start(0);
+    REQUIRE(scheduler.isDiscovering());
+
+    Obd2Scheduler::Request request;
+    REQUIRE(scheduler.nextRequest(0, request));
+    REQUIRE(request.count == 1);
+    REQUIRE(request.pids[0] == 0x00);
+    REQUIRE_FALSE(scheduler.nextRequest(0, request));  // One bitmap at a time
+
+    // 0x00: RPM supported, speed not, 0x20 follows
+    scheduler.onSupportedPids(0x00, bitmapBit(0x00, PID_RPM) | 1U);
+    REQUIRE(scheduler.onResponse(std::array<uint8_t, 1>{0x00}, 1));
+    REQUIRE(scheduler.nextRequest(1, request));
+    REQUIRE(request.pids[0] == 0x20);
+
+    // 0x20: nothing, 0x40 follows
+    scheduler.onSupportedPids(0x20, 1U);
+    REQUIRE(scheduler.onResponse(std::array<uint8_t, 1>{0x20}, 2));
+    REQUIRE(scheduler.nextRequest(2, request));
+    REQUIRE(request.pids[0] == 0x40);
+
+    // 0x40: ambient supported, no further bitmap, so oil (0x5C) is not
+    scheduler.onSupportedPids(0x40, bitmapBit(0x40, PID_AMBIENT));
+    REQUIRE(scheduler.onResponse(std::array<uint8_t, 1>{0x40}, 3));
+    REQUIRE_FALSE(scheduler.isDiscovering());
+    REQUIRE(scheduler.pollablePids() == 2);
+
+    REQUIRE(scheduler.nextRequest(3, request));
+    const auto polled = request.pidList();
+    REQUIRE(std::find(polled.begin(), polled.end(), PID_RPM) != polled.end());
+    REQUIRE(std::find(polled.begin(), polled.end(), PID_AMBIENT) != polled.end());
+    REQUIRE(request.count == 2);
+
+    SECTION("ECU without bitmaps: discovery times out, everything is polled") {
+        scheduler.start(0);
+        REQUIRE(scheduler.nextRequest(0, request));
+        REQUIRE(scheduler.expire(options.timeoutUs) == 1);
+        REQUIRE_FALSE(scheduler.isDiscovering());
+        REQUIRE(scheduler.pollablePids() == 4);
+    }
+}
+
+TEST_CASE("Obd2Scheduler falls back when the ECU cannot keep up", "[obd2][scheduler]") {
+    Obd2Scheduler scheduler;
+    scheduler.setOptions(pollingOptions(4, 6));
+    for (const uint8_t pid : {PID_COOLANT, PID_MAP, PID_RPM, PID_SPEED}) {
+        scheduler.addPid(pid, 10.0);
+    }
+
+    SECTION("Rejected multi-PID request: one PID per request") {
+        ModelEcu ecu;
+        ecu.processingUs = 5 * US_PER_MS;
+        ecu.maxPidsPerRequest = 1;
+        runSession(scheduler, ecu, US_PER_SECOND);
+        REQUIRE(scheduler.maxPidsPerRequest() == 1);
+        REQUIRE(scheduler.stats().negativeResponses == 1);
+        REQUIRE_THAT(measuredHz(scheduler, PID_RPM), WithinRel(10.0, 0.15));
+    }
+
+    SECTION("Ignored multi-PID requests: one PID per request after repeated timeouts") {
+        scheduler.setOptions(pollingOptions(1, 6));
+        scheduler.start(0);
+        Obd2Scheduler::Request request;
+        int64_t now = 0;
+        for (int i = 0; i < Obd2Scheduler::FALLBACK_FAILURES; ++i) {
+            REQUIRE(scheduler.nextRequest(now, request));
+            REQUIRE(request.count > 1);
+            now += scheduler.options().timeoutUs;
+            REQUIRE(scheduler.expire(now) == 1);
+        }
+        REQUIRE(scheduler.maxPidsPerRequest() == 1);
+    }
+
+    SECTION("Repeated timeouts: fewer requests in flight") {
+        scheduler.setOptions(pollingOptions(4, 1));
+        scheduler.start(0);
+        Obd2Scheduler::Request request;
+        for (int i = 0; i < Obd2Scheduler::FALLBACK_FAILURES; ++i) {
+            REQUIRE(scheduler.nextRequest(0, request));
+        }
+        REQUIRE(scheduler.expire(scheduler.options().timeoutUs) ==
+                Obd2Scheduler::FALLBACK_FAILURES);
+        REQUIRE(scheduler.maxInFlight() == 2);
+    }
+}
@@ -0,0 +1,326 @@
+/**
+ * @file test_simulator_adapter.cpp
+ * @brief Tests for the built-in Haltech simulator.
+ *
+ * Tests cover:
+ * - invertConversion as the inverse of applyConversion
+ * - Big-endian field encoding with clamping and two's complement
+ * - Encoded frames decoding back to the scenario state
+ * - Scenario lookup, looping and plausible vehicle behaviour
+ * - FrameGenerator pacing at a configured frame rate
+ * - The "simulator" adapter type publishing decoded channels
+ */
+
+#include "adapters/ProtocolAdapterFactory.h"
+#include "adapters/haltech/HaltechProtocol.h"
+#include "adapters/simulator/FrameGenerator.h"
+#include "adapters/simulator/HaltechFrameEncoder.h"
+#include "adapters/simulator/SimulationScenario.h"
+#include "adapters/simulator/SimulatorAdapter.h"
+
+#include <QCanBusFrame>
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QJsonObject>
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+
+#include <algorithm>
+#include <array>
+#include <functional>
+#include <vector>
+
+using Catch::Matchers::WithinAbs;
+using devdash::ConversionType;
+using devdash::HaltechFrameEncoder;
+using devdash::HaltechProtocol;
+using devdash::SimulationScenario;
+
+namespace {
+
+//=============================================================================
+// Test Constants
+//=============================================================================
+
+constexpr int SPIN_TIMEOUT_MS = 5000;
+constexpr int GENERATE_DURATION_MS = 500;
+constexpr double GENERATOR_FRAME_RATE = 2000.0;
+constexpr double MS_PER_SECOND = 1000.0;
+
+/// Built-in frames and their summed declared rates
+constexpr size_t BUILT_IN_FRAME_COUNT = 8;
+constexpr double BUILT_IN_FRAME_RATE = 180.0;
+
+/// Half a raw step of the coarsest conversion (x / 10), plus rounding slack
+constexpr double DECODE_TOLERANCE = 0.051;
+constexpr double GEAR_TOLERANCE = 0.5;
+
+constexpr double CONVERSION_TOLERANCE = 1e-9;
+constexpr std::array<double, 5> PHYSICAL_VALUES = {-40.0, 0.0, 12.5, 101.3, 6500.0};
+
+constexpr double REDLINE_RPM = 7500.0;
+constexpr double OVERHEAT_COOLANT_C = 115.0;
+constexpr double MAX_GEAR = 6.0;
+constexpr double SAMPLE_STEP_SECONDS = 0.1;
+
+/// Sampled scenario times, in seconds
+constexpr std::array<double, 6> SAMPLE_TIMES = {0.0, 3.7, 11.0, 25.5, 48.0, 130.0};
+
+bool spinUntil(const std::function<bool()>& condition, int timeoutMs = SPIN_TIMEOUT_MS) {
+    QElapsedTimer timer;
+    timer.start();
+    while (!condition()) {
+        if (timer.elapsed() > timeoutMs) {
+            return false;
+        }
+        QCoreApplication::processEvents(QEventLoop::AllEvents, 1);
+    }
+    return true;
+}
+
+std::vector<HaltechFrameEncoder> builtInEncoders() {
+    std::vector<HaltechFrameEncoder> encoders;
+    for (const auto& frameDef : devdash::SimulatorAdapter::builtInFrames()) {
+        encoders.emplace_back(frameDef);
+    }
+    return encoders;
+}
+
+QCanBusFrame toCanBusFrame(const devdash::RawCanFrame& raw) {
+    return QCanBusFrame(raw.frameId, QByteArray(reinterpret_cast<const char*>(raw.data.data()),
+                                                raw.length));
+}
+
+} // anonymous namespace
+
+//=============================================================================
+// Encoding Tests
+//=============================================================================
+
+TEST_CASE("invertConversion inverts applyConversion", "[simulator][encoder]") {
+    constexpr std::array<ConversionType, 5> TYPES = {
+        ConversionType::Identity, ConversionType::DivideBy10, ConversionType::DivideBy1000,
+        ConversionType::GaugePressure, ConversionType::KelvinToCelsius};
+
+    for (const auto type : TYPES) {
+        for (const double value : PHYSICAL_VALUES) {
+            const double raw = HaltechProtocol::invertConversion(type, value);
+            REQUIRE_THAT(HaltechProtocol::applyConversion(type, raw),
+                         WithinAbs(value, CONVERSION_TOLERANCE));
+        }
+    }
+}
+
+TEST_CASE("HaltechFrameEncoder writes big-endian fields", "[simulator][encoder]") {
+    std::array<uint8_t, 8> data{};
+
+    SECTION("unsigned values are rounded") {
+        HaltechFrameEncoder::writeField(data.data(), 0, 2, false, 3499.6);
+        REQUIRE(data[0] == 0x0D);
+        REQUIRE(data[1] == 0xAC);
+    }
+
+    SECTION("values are clamped to the field range") {
+        HaltechFrameEncoder::writeField(data.data(), 2, 2, false, 70000.0);
+        REQUIRE(data[2] == 0xFF);
+        REQUIRE(data[3] == 0xFF);
+
+        HaltechFrameEncoder::writeField(data.data(), 4, 1, false, -5.0);
+        REQUIRE(data[4] == 0x00);
+
+        HaltechFrameEncoder::writeField(data.data(), 5, 1, true, 200.0);
+        REQUIRE(data[5] == 0x7F);
+    }
+
+    SECTION("signed values use two's complement") {
+        HaltechFrameEncoder::writeField(data.data(), 7, 1, true, -1.0);
+        REQUIRE(data[7] == 0xFF);
+
+        HaltechFrameEncoder::writeField(data.data(), 0, 2, true, -2.0);
+        REQUIRE(data[0] == 0xFF);
+        REQUIRE(data[1] == 0xFE);
+    }
+
+    SECTION("neighbouring bytes are untouched") {
+        HaltechFrameEncoder::writeField(data.data(), 3, 2, false, 0xFFFF);
+        REQUIRE(data[2] == 0x00);
+        REQUIRE(data[5] == 0x00);
+    }
+}
+
+TEST_CASE("Simulated frames decode to the scenario state", "[simulator][encoder]") {
+    HaltechProtocol protocol;
+    protocol.loadDefinitions(devdash::SimulatorAdapter::builtInFrames());
+    REQUIRE(protocol.frameDefinitions().size() == BUILT_IN_FRAME_COUNT);
+
+    const auto encoders = builtInEncoders();
+    for (const QString& name : SimulationScenario::names()) {
+        const auto scenario = SimulationScenario::fromName(name);
+        REQUIRE(scenario.has_value());
+
+        for (const double seconds : SAMPLE_TIMES) {
+            const devdash::VehicleState state = scenario->stateAt(seconds);
+            for (const auto& encoder : encoders) {
+                devdash::RawCanFrame raw;
+                encoder.encode(state, raw);
+                REQUIRE(raw.frameId == encoder.frameId());
+                REQUIRE(raw.length == encoder.length());
+
+                for (const auto& [channel, value] : protocol.decode(toCanBusFrame(raw))) {
+                    const auto field = SimulationScenario::fieldForChannel(channel);
+                    REQUIRE(field != nullptr);
+                    const double tolerance =
+                        channel == "Current Gear" ? GEAR_TOLERANCE : DECODE_TOLERANCE;
+                    INFO(name.toStdString() << " at " << seconds << "s: "
+                                            << channel.toStdString());
+                    REQUIRE_THAT(value.value, WithinAbs(state.*field, tolerance));
+                }
+            }
+        }
+    }
+}
+
+//=============================================================================
+// Scenario Tests
+//=============================================================================
+
+TEST_CASE("SimulationScenario looks up scenarios by name", "[simulator][scenario]") {
+    const QStringList names = SimulationScenario::names();
+    REQUIRE(names.size() == 5);
+    REQUIRE(names.contains("idle"));
+    REQUIRE(names.contains("track"));
+
+    REQUIRE(SimulationScenario::fromName("track")->name() == "track");
+    REQUIRE_FALSE(SimulationScenario::fromName("drag").has_value());
+
+    REQUIRE(SimulationScenario::fieldForChannel("RPM") == &devdash::VehicleState::rpm);
+    REQUIRE(SimulationScenario::fieldForChannel("Knock Level 1") == nullptr);
+}
+
+TEST_CASE("SimulationScenario produces plausible behaviour", "[simulator][scenario]") {
+    SECTION("warmup heats the coolant") {
+        const auto warmup = SimulationScenario::fromName("warmup");
+        REQUIRE(warmup->stateAt(warmup->durationSeconds() / 2).coolantTemperature >
+                warmup->stateAt(0.0).coolantTemperature);
+    }
+
+    SECTION("redline reaches the limiter") {
+        const auto redline = SimulationScenario::fromName("redline");
+        double peak = 0.0;
+        for (double t = 0.0; t < redline->durationSeconds(); t += SAMPLE_STEP_SECONDS) {
+            peak = std::max(peak, redline->stateAt(t).rpm);
+        }
+        REQUIRE(peak >= REDLINE_RPM);
+    }
+
+    SECTION("overheat ends hot") {
+        const auto overheat = SimulationScenario::fromName("overheat");
+        REQUIRE(overheat->stateAt(overheat->durationSeconds(), false).coolantTemperature >
+                OVERHEAT_COOLANT_C);
+    }
+
+    SECTION("track stays in the gearbox") {
+        const auto track = SimulationScenario::fromName("track");
+        for (double t = 0.0; t < track->durationSeconds(); t += SAMPLE_STEP_SECONDS) {
+            const auto state = track->stateAt(t);
+            REQUIRE(state.gear >= 1.0);
+            REQUIRE(state.gear <= MAX_GEAR);
+        }
+    }
+
+    SECTION("looping restarts, holding keeps the last state") {
+        const auto warmup = SimulationScenario::fromName("warmup");
+        const double past = warmup->durationSeconds() + 1.0;
+        REQUIRE_THAT(warmup->stateAt(past).coolantTemperature,
+                     WithinAbs(warmup->stateAt(1.0).coolantTemperature, CONVERSION_TOLERANCE));
+        REQUIRE_THAT(warmup->stateAt(past, false).coolantTemperature,
+                     WithinAbs(warmup->stateAt(warmup->durationSeconds(), false)
+                                   .coolantTemperature,
+                               CONVERSION_TOLERANCE));
+    }
+}
+
+//=============================================================================
+// Generator Tests
+//=============================================================================
+
+TEST_CASE("FrameGenerator paces frames at the configured rate", "[simulator][generator]") {
+    devdash::FrameGenerator generator(builtInEncoders());
+    uint64_t received = 0;
+    generator.setFrameHandler([&received](const devdash::RawCanFrame&) { ++received; });
+
+    SECTION("declared rates are used by default") {
+        REQUIRE(generator.open());
+        REQUIRE_THAT(generator.frameRate(), WithinAbs(BUILT_IN_FRAME_RATE, 1.0));
+    }
+
+    SECTION("frames follow the scaled schedule") {
+        devdash::FrameGenerator::Options options;
+        options.scenario = "track";
+        options.frameRate = GENERATOR_FRAME_RATE;
+        generator.setOptions(options);
+        REQUIRE(generator.open());
+        REQUIRE_THAT(generator.frameRate(), WithinAbs(GENERATOR_FRAME_RATE, 1.0));
+
+        QElapsedTimer elapsed;
+        elapsed.start();
+        generator.start();
+        spinUntil([]() { return false; }, GENERATE_DURATION_MS);
+        generator.stop();
+        const double seconds = static_cast<double>(elapsed.elapsed()) / MS_PER_SECOND;
+
+        // Loose bounds: never ahead of the schedule, not starved on a busy machine
+        const double expected = GENERATOR_FRAME_RATE * seconds;
+        REQUIRE(received == generator.framesDelivered());
+        REQUIRE(static_cast<double>(received) <= expected + BUILT_IN_FRAME_COUNT);
+        REQUIRE(static_cast<double>(received + generator.framesSkipped()) >= expected / 2);
+    }
+
+    SECTION("out-of-range rates are clamped") {
+        devdash::FrameGenerator::Options options;
+        options.frameRate = 1.0;
+        generator.setOptions(options);
+        REQUIRE(generator.open());
+        REQUIRE_THAT(generator.frameRate(),
+                     WithinAbs(devdash::FrameGenerator::MIN_FRAME_RATE, 1.0));
+    }
+
+    SECTION("unknown scenario fails to open") {
+        devdash::FrameGenerator::Options options;
+        options.scenario = "drag";
+        generator.setOptions(options);
+        REQUIRE_FALSE(generator.open());
+        REQUIRE(generator.errorString().contains("track"));
+    }
+}
+
+//=============================================================================
+// Adapter Tests
+//=============================================================================
+
+TEST_CASE("Simulator adapter publishes decoded channels", "[simulator][adapter]") {
+    QJsonObject simulator;
+    simulator["scenario"] = "redline";
+    simulator["frameRate"] = GENERATOR_FRAME_RATE;
+    QJsonObject config;
+    config["simulator"] = simulator;
+
+    auto adapter = devdash::ProtocolAdapterFactory::create("simulator", config);
+    REQUIRE(adapter != nullptr);
+    REQUIRE(adapter->adapterName().contains("Simulator"));
+
+    REQUIRE(adapter->start());
+    REQUIRE(spinUntil([&adapter]() {
+        return adapter->getChannel("RPM").has_value() &&
+               adapter->getChannel("Coolant Temperature").has_value() &&
+               adapter->getChannel("Current Gear").has_value();
+    }));
+
+    const QJsonObject bus = adapter->diagnostics()["bus"].toObject();
+    REQUIRE(bus["backend"].toString() == "simulator");
+    REQUIRE(bus["simulator"].toObject()["scenario"].toString() == "redline");
+
+    adapter->stop();
+    REQUIRE_FALSE(adapter->isRunning());
+}
@@ -3,9 +3,11 @@
 #include "core/interfaces/IProtocolAdapter.h"
 
 #include <QFile>
+#include <QJsonArray>
 #include <QJsonDocument>
 #include <QJsonObject>
 #include <QSignalSpy>
+#include <QThread>
 
 #include <catch2/catch_test_macros.hpp>
 #include <catch2/matchers/catch_matchers_floating_point.hpp>
@@ -32,6 +34,7 @@ public:
     explicit MockAdapter(QObject* parent = nullptr) : devdash::IProtocolAdapter(parent) {}
 
     [[nodiscard]] bool start() override {
+        m_startThread = QThread::currentThread();
         m_running = true;
         emit connectionStateChanged(true);
         return true;
@@ -57,6 +60,14 @@ public:
 
     [[nodiscard]] QString adapterName() const override { return QStringLiteral("Mock"); }
 
+    [[nodiscard]] bool requiresIoThread() const override { return m_requiresIoThread; }
+
+    /** @brief Make the adapter ask for an I/O thread */
+    void setRequiresIoThread(bool required) { m_requiresIoThread = required; }
+
+    /** @brief Thread the last start() ran on */
+    [[nodiscard]] QThread* startThread() const { return m_startThread; }
+
     /**
      * @brief Emit a channel update for testing.
      * @param name Channel name as it would come from the protocol
@@ -71,6 +82,8 @@ public:
 
 private:
     bool m_running{false};
+    bool m_requiresIoThread{false};
+    QThread* m_startThread{nullptr};
     QHash<QString, devdash::ChannelValue> m_channels;
 };
 
@@ -369,6 +382,67 @@ TEST_CASE("DataBroker adapter replacement", "[core][databroker]") {
     }
 }
 
+TEST_CASE("DataBroker adapter I/O thread", "[core][databroker][threading]") {
+    devdash::DataBroker broker;
+
+    auto profile = createMinimalTestProfile();
+    // Empty object: own thread, default scheduling (works without privileges)
+    profile["ioThread"] = QJsonObject{};
+    REQUIRE(broker.loadProfileFromJson(profile));
+    REQUIRE(broker.hasIoThread());
+    REQUIRE(broker.ioThreadConfig().fifoPriority == 0);
+
+    auto* mockAdapter = new MockAdapter();
+    broker.setAdapter(std::unique_ptr<devdash::IProtocolAdapter>(mockAdapter));
+    QSignalSpy connectedSpy(&broker, &devdash::DataBroker::isConnectedChanged);
+    REQUIRE(broker.start());
+
+    SECTION("adapter starts on its own thread") {
+        REQUIRE(mockAdapter->startThread() != nullptr);
+        REQUIRE(mockAdapter->startThread() != QThread::currentThread());
+        REQUIRE(mockAdapter->thread() == mockAdapter->startThread());
+        REQUIRE(connectedSpy.wait());
+        REQUIRE(broker.isConnected());
+    }
+
+    SECTION("updates from the adapter reach the properties") {
+        mockAdapter->emitChannelUpdate("rpm", TEST_RPM_VALUE, "RPM");
+        broker.processQueueForTesting();
+        REQUIRE(broker.rpm() == TEST_RPM_VALUE);
+    }
+
+    SECTION("diagnostics report the applied scheduling") {
+        const auto ioThread = broker.adapterDiagnostics()["ioThread"].toObject();
+        REQUIRE(ioThread.contains("problems"));
+        REQUIRE(ioThread["problems"].toArray().isEmpty());
+        REQUIRE_FALSE(ioThread["fifo"].toBool());
+    }
+
+    SECTION("stop moves the adapter back") {
+        broker.stop();
+        REQUIRE(mockAdapter->thread() == QThread::currentThread());
+        REQUIRE_FALSE(mockAdapter->isRunning());
+    }
+}
+
+TEST_CASE("DataBroker starts adapters that require it on an I/O thread",
+          "[core][databroker][threading]") {
+    devdash::DataBroker broker;
+    REQUIRE(broker.loadProfileFromJson(createMinimalTestProfile()));
+    REQUIRE_FALSE(broker.hasIoThread());
+
+    auto* mockAdapter = new MockAdapter();
+    mockAdapter->setRequiresIoThread(true);
+    broker.setAdapter(std::unique_ptr<devdash::IProtocolAdapter>(mockAdapter));
+    REQUIRE(broker.start());
+
+    REQUIRE(mockAdapter->startThread() != nullptr);
+    REQUIRE(mockAdapter->startThread() != QThread::currentThread());
+
+    broker.stop();
+    REQUIRE(mockAdapter->thread() == QThread::currentThread());
+}
+
 TEST_CASE("DataBroker invalid channel values", "[core][databroker]") {
     devdash::DataBroker broker;
 
@@ -0,0 +1,164 @@
+/**
+ * @file test_log_macros.cpp
+ * @brief Tests for the hot-path logging macros.
+ *
+ * Tests cover:
+ * - Stream not evaluated below the LogManager level
+ * - Rate limit per call site with "[N suppressed]" prefix
+ * - One-in-N sampling per call site
+ * - LogSite admission and suppressed counts
+ * - Cost of a filtered and a rate-limited call (hidden benchmark)
+ *
+ * Run the benchmark with:
+ *
+ *     ./build/debug/tests/devdash_tests "[benchmark]"
+ */
+
+#include "core/logging/LogMacros.h"
+#include "core/logging/LogManager.h"
+
+#include <QLoggingCategory>
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+namespace {
+
+Q_LOGGING_CATEGORY(logTest, "devdash.test")
+
+//=============================================================================
+// Test Constants
+//=============================================================================
+
+constexpr const char* TEST_CATEGORY = "devdash.test";
+
+constexpr int CALLS = 100;
+constexpr int RATE_PER_SECOND = 5;
+constexpr int SAMPLE_EVERY = 10;
+constexpr int ALL_LOGS = 1000;
+
+/**
+ * @brief Starts the LogManager for one test and shuts it down afterwards
+ */
+class LoggingSession {
+  public:
+    explicit LoggingSession(QtMsgType level) {
+        devdash::LogManager::instance().initialize();
+        devdash::LogManager::instance().setLogLevel(level);
+        devdash::LogManager::instance().clearLogs();
+    }
+    ~LoggingSession() { devdash::LogManager::instance().shutdown(); }
+
+    LoggingSession(const LoggingSession&) = delete;
+    LoggingSession& operator=(const LoggingSession&) = delete;
+    LoggingSession(LoggingSession&&) = delete;
+    LoggingSession& operator=(LoggingSession&&) = delete;
+};
+
+int countEvaluation(int& evaluations) {
+    ++evaluations;
+    return evaluations;
+}
+
+} // anonymous namespace
+
+TEST_CASE("DEVDASH_CDEBUG skips the stream below the level", "[core][logging]") {
+    LoggingSession session(QtInfoMsg);
+    auto& logs = devdash::LogManager::instance();
+    const qint64 droppedBefore = logs.stats().droppedMessages;
+    int evaluations = 0;
+
+    DEVDASH_CDEBUG(logTest) << "filtered" << countEvaluation(evaluations);
+    DEVDASH_CDEBUG_RATE(logTest, RATE_PER_SECOND) << countEvaluation(evaluations);
+    DEVDASH_CDEBUG_SAMPLE(logTest, SAMPLE_EVERY) << countEvaluation(evaluations);
+    logs.flush();
+
+    REQUIRE(evaluations == 0);
+    // Never reached the message handler, so not even counted as dropped
+    REQUIRE(logs.stats().droppedMessages == droppedBefore);
+    REQUIRE(logs.getRecentLogs(ALL_LOGS, QtDebugMsg, TEST_CATEGORY).isEmpty());
+
+    SECTION("warnings still pass at info level") {
+        DEVDASH_CWARNING_RATE(logTest, RATE_PER_SECOND) << countEvaluation(evaluations);
+        logs.flush();
+        REQUIRE(evaluations == 1);
+        REQUIRE(logs.getRecentLogs(ALL_LOGS, QtDebugMsg, TEST_CATEGORY).size() == 1);
+    }
+}
+
+TEST_CASE("DEVDASH_CDEBUG_RATE limits one call site", "[core][logging]") {
+    LoggingSession session(QtDebugMsg);
+    auto& logs = devdash::LogManager::instance();
+
+    for (int i = 0; i < CALLS; ++i) {
+        DEVDASH_CDEBUG_RATE(logTest, RATE_PER_SECOND) << "frame" << i;
+    }
+    logs.flush();
+
+    const QJsonArray entries = logs.getRecentLogs(ALL_LOGS, QtDebugMsg, TEST_CATEGORY);
+    REQUIRE(entries.size() == RATE_PER_SECOND);
+    for (const auto& entry : entries) {
+        REQUIRE_FALSE(entry.toObject()["message"].toString().contains("suppressed"));
+    }
+}
+
+TEST_CASE("DEVDASH_CDEBUG_SAMPLE logs one in N calls", "[core][logging]") {
+    LoggingSession session(QtDebugMsg);
+    auto& logs = devdash::LogManager::instance();
+
+    for (int i = 0; i < CALLS; ++i) {
+        DEVDASH_CDEBUG_SAMPLE(logTest, SAMPLE_EVERY).noquote() << QStringLiteral("tick %1").arg(i);
+    }
+    logs.flush();
+
+    const QJsonArray entries = logs.getRecentLogs(ALL_LOGS, QtDebugMsg, TEST_CATEGORY);
+    REQUIRE(entries.size() == CALLS / SAMPLE_EVERY);
+    REQUIRE(entries[0].toObject()["message"] == "tick 0");
+    // Later lines report the calls skipped since the previous one
+    REQUIRE(entries[1].toObject()["message"] ==
+            QStringLiteral("[%1 suppressed] tick %2").arg(SAMPLE_EVERY - 1).arg(SAMPLE_EVERY));
+}
+
+TEST_CASE("LogSite counts suppressed calls", "[core][logging]") {
+    devdash::LogSite site;
+
+    SECTION("rate limit") {
+        int admitted = 0;
+        for (int i = 0; i < CALLS; ++i) {
+            admitted += site.admitRate(RATE_PER_SECOND) ? 1 : 0;
+        }
+        REQUIRE(admitted == RATE_PER_SECOND);
+        REQUIRE(site.takeSuppressed() == CALLS - RATE_PER_SECOND);
+        REQUIRE(site.takeSuppressed() == 0);
+    }
+
+    SECTION("sampling") {
+        int admitted = 0;
+        for (int i = 0; i < CALLS; ++i) {
+            admitted += site.admitSample(SAMPLE_EVERY) ? 1 : 0;
+        }
+        REQUIRE(admitted == CALLS / SAMPLE_EVERY);
+        REQUIRE(site.takeSuppressed() == CALLS - (CALLS / SAMPLE_EVERY));
+    }
+
+    SECTION("sampling every call or fewer admits everything") {
+        REQUIRE(site.admitSample(0));
+        REQUIRE(site.admitSample(0));
+        REQUIRE(site.takeSuppressed() == 0);
+    }
+}
+
+TEST_CASE("Logging macro cost for the caller", "[.benchmark][logging]") {
+    LoggingSession session(QtInfoMsg);
+
+    BENCHMARK("qCDebug below the level") {
+        qCDebug(logTest) << "frame" << 0x360;
+    };
+    BENCHMARK("DEVDASH_CDEBUG below the level") {
+        DEVDASH_CDEBUG(logTest) << "frame" << 0x360;
+    };
+    BENCHMARK("DEVDASH_CWARNING_RATE over the limit") {
+        DEVDASH_CWARNING_RATE(logTest, 1) << "frame" << 0x360;
+    };
+    devdash::LogManager::instance().flush();
+}
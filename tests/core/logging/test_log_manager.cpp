@@ -0,0 +1,228 @@
+/**
+ * @file test_log_manager.cpp
+ * @brief Tests for the asynchronous logging manager.
+ *
+ * Tests cover:
+ * - Messages from several threads all written, in order per thread
+ * - Level filtering by severity (warnings kept at info level)
+ * - JSON lines appended to the log file
+ * - Log file rotated into generations on the writer thread
+ * - logAdded emitted from the writer thread
+ * - Cost of a filtered and a queued message for the caller (hidden benchmark)
+ *
+ * Run the benchmark with:
+ *
+ *     ./build/debug/tests/devdash_tests "[benchmark]"
+ */
+
+#include "core/logging/LogManager.h"
+
+#include <QFile>
+#include <QJsonDocument>
+#include <QLoggingCategory>
+#include <QTemporaryDir>
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+namespace {
+
+Q_LOGGING_CATEGORY(logTest, "devdash.test")
+
+//=============================================================================
+// Test Constants
+//=============================================================================
+
+constexpr const char* TEST_CATEGORY = "devdash.test";
+
+constexpr int PRODUCER_THREADS = 4;
+constexpr int MESSAGES_PER_THREAD = 50;
+constexpr int FILE_MESSAGES = 20;
+constexpr int ROTATED_MESSAGES = 200;
+constexpr qint64 ROTATE_BYTES = 4096;
+constexpr int ALL_LOGS = 1000;
+
+/**
+ * @brief Starts the LogManager for one test and shuts it down afterwards
+ */
+class LoggingSession {
+  public:
+    explicit LoggingSession(QtMsgType level) {
+        devdash::LogManager::instance().initialize();
+        devdash::LogManager::instance().setLogLevel(level);
+        devdash::LogManager::instance().clearLogs();
+    }
+    ~LoggingSession() { devdash::LogManager::instance().shutdown(); }
+
+    LoggingSession(const LoggingSession&) = delete;
+    LoggingSession& operator=(const LoggingSession&) = delete;
+    LoggingSession(LoggingSession&&) = delete;
+    LoggingSession& operator=(LoggingSession&&) = delete;
+};
+
+} // anonymous namespace
+
+TEST_CASE("LogManager writes messages from many threads", "[core][logging]") {
+    LoggingSession session(QtDebugMsg);
+    auto& logs = devdash::LogManager::instance();
+
+    std::vector<std::thread> producers;
+    for (int thread = 0; thread < PRODUCER_THREADS; ++thread) {
+        producers.emplace_back([thread]() {
+            for (int i = 0; i < MESSAGES_PER_THREAD; ++i) {
+                qCDebug(logTest).noquote() << QStringLiteral("%1:%2").arg(thread).arg(i);
+            }
+        });
+    }
+    for (auto& producer : producers) {
+        producer.join();
+    }
+    logs.flush();
+
+    const QJsonArray entries = logs.getRecentLogs(ALL_LOGS, QtDebugMsg, TEST_CATEGORY);
+    REQUIRE(entries.size() == PRODUCER_THREADS * MESSAGES_PER_THREAD);
+
+    // Each thread's messages keep their order
+    std::vector<int> next(PRODUCER_THREADS, 0);
+    for (const auto& value : entries) {
+        const QStringList parts = value.toObject()["message"].toString().split(':');
+        REQUIRE(parts.size() == 2);
+        const int thread = parts[0].toInt();
+        REQUIRE(parts[1].toInt() == next[static_cast<size_t>(thread)]);
+        ++next[static_cast<size_t>(thread)];
+    }
+    REQUIRE(logs.stats().queuedMessages == 0);
+    REQUIRE(logs.stats().overflowMessages == 0);
+}
+
+TEST_CASE("LogManager filters by severity", "[core][logging]") {
+    LoggingSession session(QtInfoMsg);
+    auto& logs = devdash::LogManager::instance();
+    const qint64 droppedBefore = logs.stats().droppedMessages;
+
+    qCDebug(logTest) << "below the level";
+    qCInfo(logTest) << "info";
+    qCWarning(logTest) << "warning";
+    qCCritical(logTest) << "critical";
+    logs.flush();
+
+    REQUIRE(logs.stats().droppedMessages == droppedBefore + 1);
+    const QJsonArray all = logs.getRecentLogs(ALL_LOGS, QtDebugMsg, TEST_CATEGORY);
+    REQUIRE(all.size() == 3);
+    REQUIRE(all[0].toObject()["level"] == "info");
+    REQUIRE(all[1].toObject()["level"] == "warning");
+    REQUIRE(all[2].toObject()["level"] == "critical");
+
+    SECTION("queries rank levels the same way") {
+        const QJsonArray warnings = logs.getRecentLogs(ALL_LOGS, QtWarningMsg, TEST_CATEGORY);
+        REQUIRE(warnings.size() == 2);
+        REQUIRE(warnings[0].toObject()["level"] == "warning");
+    }
+}
+
+TEST_CASE("LogManager appends JSON lines to the log file", "[core][logging]") {
+    QTemporaryDir dir;
+    const QString path = dir.filePath("devdash.log");
+    {
+        LoggingSession session(QtInfoMsg);
+        devdash::LogManager::instance().setFileOutput(path);
+        for (int i = 0; i < FILE_MESSAGES; ++i) {
+            qCInfo(logTest) << "line" << i;
+        }
+        devdash::LogManager::instance().flush();
+    }
+
+    QFile file(path);
+    REQUIRE(file.open(QIODevice::ReadOnly | QIODevice::Text));
+    int testLines = 0;
+    while (!file.atEnd()) {
+        const QJsonObject entry = QJsonDocument::fromJson(file.readLine()).object();
+        REQUIRE_FALSE(entry.isEmpty());
+        if (entry["category"] == TEST_CATEGORY) {
+            REQUIRE(entry["message"] == QStringLiteral("line %1").arg(testLines));
+            ++testLines;
+        }
+    }
+    REQUIRE(testLines == FILE_MESSAGES);
+}
+
+TEST_CASE("LogManager rotates the log file on the writer thread", "[core][logging]") {
+    QTemporaryDir dir;
+    const QString path = dir.filePath("devdash.log");
+    devdash::LogRotator::Config rotation;
+    rotation.maxFileBytes = ROTATE_BYTES;
+    rotation.generations = ROTATED_MESSAGES;  // Enough that nothing is deleted
+    rotation.maxTotalBytes = 0;
+    rotation.compress = false;
+    {
+        LoggingSession session(QtInfoMsg);
+        auto& logs = devdash::LogManager::instance();
+        logs.setFileOutput(path, rotation);
+        for (int i = 0; i < ROTATED_MESSAGES; ++i) {
+            qCInfo(logTest) << "line" << i;
+        }
+        logs.flush();
+        REQUIRE(logs.stats().rotations > 0);
+    }
+
+    // Every line is in the current file or a generation; none was lost to rotation
+    QStringList files = devdash::LogRotator::generationFiles(path);
+    REQUIRE(files.size() > 0);
+    REQUIRE(files.size() <= rotation.generations);
+    files.append(path);
+    int testLines = 0;
+    for (const QString& name : files) {
+        QFile file(name);
+        REQUIRE(file.open(QIODevice::ReadOnly | QIODevice::Text));
+        while (!file.atEnd()) {
+            const QJsonObject entry = QJsonDocument::fromJson(file.readLine()).object();
+            if (entry["category"] == TEST_CATEGORY) {
+                ++testLines;
+            }
+        }
+    }
+    REQUIRE(testLines == ROTATED_MESSAGES);
+}
+
+TEST_CASE("LogManager emits logAdded from the writer thread", "[core][logging]") {
+    LoggingSession session(QtInfoMsg);
+    auto& logs = devdash::LogManager::instance();
+
+    std::atomic<int> emitted{0};
+    std::atomic<bool> onCallerThread{false};
+    const auto caller = std::this_thread::get_id();
+    const auto connection = QObject::connect(
+        &logs, &devdash::LogManager::logAdded, &logs,
+        [&](const QJsonObject& entry) {
+            if (entry["category"] == TEST_CATEGORY) {
+                onCallerThread = onCallerThread || std::this_thread::get_id() == caller;
+                ++emitted;
+            }
+        },
+        Qt::DirectConnection);
+
+    qCInfo(logTest) << "signalled";
+    logs.flush();
+    QObject::disconnect(connection);
+
+    REQUIRE(emitted == 1);
+    REQUIRE_FALSE(onCallerThread);
+}
+
+TEST_CASE("LogManager cost for the logging caller", "[.benchmark][logging]") {
+    QTemporaryDir dir;
+    LoggingSession session(QtInfoMsg);
+    devdash::LogManager::instance().setFileOutput(dir.filePath("devdash.log"));
+
+    BENCHMARK("filtered debug message") {
+        qCDebug(logTest) << "frame" << 0x360;
+    };
+    BENCHMARK("queued info message") {
+        qCInfo(logTest) << "frame" << 0x360;
+    };
+    devdash::LogManager::instance().flush();
+}
@@ -0,0 +1,167 @@
+/**
+ * @file test_log_ring.cpp
+ * @brief Unit tests for the binary log history ring.
+ *
+ * Tests cover:
+ * - Round trip of message, level, category and call site
+ * - Eviction when the record slots or the text arena run out
+ * - Level and category filters, newest-first count limit
+ * - Truncation of overlong messages at a character boundary
+ * - Query cost on a full ring (hidden benchmark)
+ *
+ * Run the benchmark with:
+ *
+ *     ./build/debug/tests/devdash_tests "[benchmark]"
+ */
+
+#include "core/logging/LogRing.h"
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <vector>
+
+namespace {
+
+//=============================================================================
+// Test Constants
+//=============================================================================
+
+constexpr const char* CAN_CATEGORY = "devdash.can";
+constexpr const char* BROKER_CATEGORY = "devdash.broker";
+
+constexpr size_t SMALL_CAPACITY = 8;
+constexpr size_t SMALL_ARENA = 100;
+constexpr int MESSAGE_LENGTH = 30;
+
+devdash::LogRecord makeRecord(qint64 timestampMs, QtMsgType type, const char* category,
+                              const QString& message = QString()) {
+    devdash::LogRecord record;
+    record.timestampMs = timestampMs;
+    record.type = type;
+    record.category = category;
+    record.file = "CanAdapter.cpp";
+    record.function = "void devdash::CanAdapter::start()";
+    record.line = static_cast<int>(timestampMs);
+    record.message = message.isEmpty() ? QStringLiteral("message %1").arg(timestampMs) : message;
+    return record;
+}
+
+} // anonymous namespace
+
+TEST_CASE("LogRing returns what was pushed", "[core][logging]") {
+    devdash::LogRing ring;
+    ring.push(makeRecord(1, QtWarningMsg, CAN_CATEGORY, QStringLiteral("bus-off on can0")));
+    ring.push(makeRecord(2, QtInfoMsg, nullptr));
+
+    const auto records = ring.query(10);
+    REQUIRE(records.size() == 2);
+    REQUIRE(records[0].timestampMs == 1);
+    REQUIRE(records[0].type == QtWarningMsg);
+    REQUIRE(QString::fromUtf8(records[0].category) == CAN_CATEGORY);
+    REQUIRE(records[0].message == "bus-off on can0");
+    REQUIRE(records[0].file == "CanAdapter.cpp");
+    REQUIRE(records[0].function == "void devdash::CanAdapter::start()");
+    REQUIRE(records[0].line == 1);
+    REQUIRE(QString::fromUtf8(records[1].category) == "default");
+
+    SECTION("clear forgets the messages") {
+        ring.clear();
+        REQUIRE(ring.size() == 0);
+        REQUIRE(ring.query(10).empty());
+    }
+}
+
+TEST_CASE("LogRing evicts the oldest messages", "[core][logging]") {
+    SECTION("when the record slots are full") {
+        devdash::LogRing ring(SMALL_CAPACITY);
+        for (int i = 0; i < 20; ++i) {
+            ring.push(makeRecord(i, QtInfoMsg, CAN_CATEGORY));
+        }
+        REQUIRE(ring.size() == SMALL_CAPACITY);
+        const auto records = ring.query(100);
+        REQUIRE(records.front().timestampMs == 12);
+        REQUIRE(records.back().timestampMs == 19);
+    }
+
+    SECTION("when the text arena is full") {
+        devdash::LogRing ring(devdash::LogRing::DEFAULT_RECORD_CAPACITY, SMALL_ARENA);
+        for (int i = 0; i < 50; ++i) {
+            ring.push(makeRecord(i, QtInfoMsg, CAN_CATEGORY,
+                                 QString(MESSAGE_LENGTH, QChar('a' + (i % 26)))));
+        }
+        // Three 30-byte texts fit in 100 bytes
+        REQUIRE(ring.size() == 3);
+        for (const auto& record : ring.query(10)) {
+            const auto letter = static_cast<int>('a' + (record.timestampMs % 26));
+            REQUIRE(record.message == QString(MESSAGE_LENGTH, QChar(letter)));
+        }
+    }
+}
+
+TEST_CASE("LogRing filters by level and category", "[core][logging]") {
+    devdash::LogRing ring;
+    for (int i = 0; i < 20; ++i) {
+        ring.push(makeRecord(i, (i % 3 == 0) ? QtWarningMsg : QtDebugMsg,
+                             (i % 2 == 0) ? BROKER_CATEGORY : CAN_CATEGORY));
+    }
+
+    const auto warnings = ring.query(100, QtWarningMsg);
+    REQUIRE(warnings.size() == 7);
+    for (const auto& record : warnings) {
+        REQUIRE(record.type == QtWarningMsg);
+    }
+
+    // Warnings rank above info even though QtWarningMsg < QtInfoMsg
+    REQUIRE(ring.query(100, QtInfoMsg).size() == 7);
+
+    SECTION("category is a substring match") {
+        const auto can = ring.query(100, QtDebugMsg, QStringLiteral("can"));
+        REQUIRE(can.size() == 10);
+        for (const auto& record : can) {
+            REQUIRE(record.timestampMs % 2 == 1);
+        }
+        REQUIRE(ring.query(100, QtDebugMsg, QStringLiteral("devdash")).size() == 20);
+        REQUIRE(ring.query(100, QtDebugMsg, QStringLiteral("cluster")).empty());
+    }
+
+    SECTION("count keeps the newest, oldest first") {
+        const auto newest = ring.query(3, QtDebugMsg, QStringLiteral("broker"));
+        REQUIRE(newest.size() == 3);
+        REQUIRE(newest[0].timestampMs == 14);
+        REQUIRE(newest[1].timestampMs == 16);
+        REQUIRE(newest[2].timestampMs == 18);
+    }
+}
+
+TEST_CASE("LogRing truncates overlong messages", "[core][logging]") {
+    devdash::LogRing ring;
+    // Two UTF-8 bytes per character
+    const QString message(static_cast<qsizetype>(devdash::LogRing::MAX_MESSAGE_BYTES),
+                          QChar(0x00E9));
+    ring.push(makeRecord(1, QtInfoMsg, CAN_CATEGORY, message));
+
+    const auto records = ring.query(1);
+    REQUIRE(records.size() == 1);
+    REQUIRE(records[0].message.toUtf8().size() ==
+            static_cast<qsizetype>(devdash::LogRing::MAX_MESSAGE_BYTES));
+    REQUIRE(records[0].message == QString(records[0].message.size(), QChar(0x00E9)));
+}
+
+TEST_CASE("LogRing query on a full ring", "[.benchmark][logging]") {
+    devdash::LogRing ring;
+    for (size_t i = 0; i < devdash::LogRing::DEFAULT_RECORD_CAPACITY; ++i) {
+        ring.push(makeRecord(static_cast<qint64>(i), (i % 16 == 0) ? QtWarningMsg : QtDebugMsg,
+                             (i % 2 == 0) ? BROKER_CATEGORY : CAN_CATEGORY));
+    }
+
+    BENCHMARK("100 newest of all levels") {
+        return ring.query(100);
+    };
+    BENCHMARK("100 newest warnings") {
+        return ring.query(100, QtWarningMsg);
+    };
+    BENCHMARK("100 newest CAN debug messages") {
+        return ring.query(100, QtDebugMsg, QStringLiteral("can"));
+    };
+}
@@ -0,0 +1,213 @@
+/**
+ * @file test_log_rotator.cpp
+ * @brief Unit tests for multi-generation log rotation.
+ *
+ * Tests cover:
+ * - Rotation by size and by age
+ * - Background gzip compression of rotated generations
+ * - Generation count and disk budget, oldest deleted first
+ * - Leftovers of an interrupted run tidied up at start
+ */
+
+#include "core/logging/LogRotator.h"
+
+#include <QFile>
+#include <QTemporaryDir>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <array>
+#include <cstdint>
+
+namespace {
+
+//=============================================================================
+// Test Constants
+//=============================================================================
+
+constexpr qint64 MAX_FILE_BYTES = 100;
+constexpr qint64 MAX_AGE_MS = 1000;
+constexpr qint64 BASE_MS = 1735732800000;  // 2025-01-01 12:00:00 UTC
+constexpr int KEPT_GENERATIONS = 3;
+constexpr int ROTATIONS = 6;
+constexpr qsizetype GENERATION_BYTES = 1000;
+constexpr int LINES = 200;
+
+/// gzip framing around the deflate data: 10-byte header, CRC-32 and size trailer
+constexpr qsizetype GZIP_HEADER_BYTES = 10;
+constexpr qsizetype GZIP_TRAILER_BYTES = 8;
+constexpr std::array<char, 2> ZLIB_HEADER = {0x78, static_cast<char>(0x9C)};
+constexpr uint32_t ADLER_MODULUS = 65521;
+constexpr uint32_t BYTE_MASK = 0xFF;
+
+void writeFile(const QString& path, const QByteArray& content) {
+    QFile file(path);
+    REQUIRE(file.open(QIODevice::WriteOnly | QIODevice::Truncate));
+    file.write(content);
+}
+
+QByteArray readFile(const QString& path) {
+    QFile file(path);
+    REQUIRE(file.open(QIODevice::ReadOnly));
+    return file.readAll();
+}
+
+void appendBigEndian32(QByteArray& out, uint32_t value) {
+    for (int shift = 32 - 8; shift >= 0; shift -= 8) {
+        out.append(static_cast<char>((value >> static_cast<uint32_t>(shift)) & BYTE_MASK));
+    }
+}
+
+/**
+ * @brief Whether @p gzip decompresses to @p expected
+ *
+ * Rewraps the deflate data as the zlib stream qUncompress() takes; zlib
+ * rejects it unless the data inflates to exactly @p expected.
+ */
+bool isGzipOf(const QByteArray& gzip, const QByteArray& expected) {
+    REQUIRE(gzip.size() > GZIP_HEADER_BYTES + GZIP_TRAILER_BYTES);
+    REQUIRE(static_cast<uint8_t>(gzip[0]) == 0x1F);
+    REQUIRE(static_cast<uint8_t>(gzip[1]) == 0x8B);
+    if (expected.isEmpty()) {
+        return gzip.size() == GZIP_HEADER_BYTES + 2 + GZIP_TRAILER_BYTES;
+    }
+
+    uint32_t a = 1;
+    uint32_t b = 0;
+    for (const char byte : expected) {
+        a = (a + static_cast<uint8_t>(byte)) % ADLER_MODULUS;
+        b = (b + a) % ADLER_MODULUS;
+    }
+
+    // qUncompress() input: big-endian size, zlib header, deflate data, Adler-32
+    QByteArray zlib;
+    appendBigEndian32(zlib, static_cast<uint32_t>(expected.size()));
+    zlib.append(ZLIB_HEADER.data(), static_cast<qsizetype>(ZLIB_HEADER.size()));
+    zlib.append(gzip.mid(GZIP_HEADER_BYTES,
+                         gzip.size() - GZIP_HEADER_BYTES - GZIP_TRAILER_BYTES));
+    appendBigEndian32(zlib, (b << 16U) | a);
+    return qUncompress(zlib) == expected;
+}
+
+} // anonymous namespace
+
+TEST_CASE("LogRotator rotates by size and by age", "[core][logging]") {
+    QTemporaryDir dir;
+    devdash::LogRotator rotator;
+    devdash::LogRotator::Config config;
+    config.maxFileBytes = MAX_FILE_BYTES;
+    config.maxAgeMs = MAX_AGE_MS;
+    rotator.start(dir.filePath("devdash.log"), config);
+
+    REQUIRE_FALSE(rotator.shouldRotate(MAX_FILE_BYTES - 1, BASE_MS, BASE_MS));
+    REQUIRE(rotator.shouldRotate(MAX_FILE_BYTES, BASE_MS, BASE_MS));
+    REQUIRE(rotator.shouldRotate(1, BASE_MS, BASE_MS + MAX_AGE_MS));
+    // Empty files are not rotated however old
+    REQUIRE_FALSE(rotator.shouldRotate(0, BASE_MS, BASE_MS + MAX_AGE_MS));
+
+    SECTION("0 disables a limit") {
+        config.maxFileBytes = 0;
+        config.maxAgeMs = 0;
+        rotator.start(dir.filePath("devdash.log"), config);
+        REQUIRE_FALSE(rotator.shouldRotate(MAX_FILE_BYTES, BASE_MS, BASE_MS + MAX_AGE_MS));
+    }
+}
+
+TEST_CASE("LogRotator compresses rotated files in the background", "[core][logging]") {
+    QTemporaryDir dir;
+    const QString path = dir.filePath("devdash.log");
+    QByteArray content;
+    for (int i = 0; i < LINES; ++i) {
+        content += QStringLiteral("{\"message\":\"line %1\"}\n").arg(i).toUtf8();
+    }
+    writeFile(path, content);
+
+    devdash::LogRotator rotator;
+    rotator.start(path, devdash::LogRotator::Config{});
+    REQUIRE(rotator.rotate(BASE_MS));
+    rotator.waitIdle();
+
+    REQUIRE_FALSE(QFile::exists(path));
+    const QStringList generations = devdash::LogRotator::generationFiles(path);
+    REQUIRE(generations == QStringList{path + ".20250101-120000.000.gz"});
+    const QByteArray compressed = readFile(generations.front());
+    REQUIRE(compressed.size() < content.size());
+    REQUIRE(isGzipOf(compressed, content));
+    REQUIRE(rotator.stats().rotations == 1);
+    REQUIRE(rotator.stats().compressedFiles == 1);
+
+    SECTION("empty files compress too") {
+        const QString empty = dir.filePath("empty");
+        writeFile(empty, QByteArray());
+        REQUIRE(devdash::LogRotator::gzipFile(empty, empty + ".gz"));
+        REQUIRE(isGzipOf(readFile(empty + ".gz"), QByteArray()));
+    }
+}
+
+TEST_CASE("LogRotator deletes the oldest generations", "[core][logging]") {
+    QTemporaryDir dir;
+    const QString path = dir.filePath("devdash.log");
+    devdash::LogRotator rotator;
+    devdash::LogRotator::Config config;
+    config.compress = false;
+
+    SECTION("beyond the generation count") {
+        config.generations = KEPT_GENERATIONS;
+        rotator.start(path, config);
+        for (int i = 0; i < ROTATIONS; ++i) {
+            writeFile(path, QByteArray::number(i));
+            REQUIRE(rotator.rotate(BASE_MS + i));
+        }
+        rotator.waitIdle();
+
+        const QStringList generations = devdash::LogRotator::generationFiles(path);
+        REQUIRE(generations.size() == KEPT_GENERATIONS);
+        for (int i = 0; i < KEPT_GENERATIONS; ++i) {
+            REQUIRE(readFile(generations[i]) ==
+                    QByteArray::number(ROTATIONS - KEPT_GENERATIONS + i));
+        }
+        REQUIRE(rotator.stats().deletedFiles == ROTATIONS - KEPT_GENERATIONS);
+    }
+
+    SECTION("beyond the disk budget, counting the current file") {
+        config.generations = ROTATIONS;
+        config.maxTotalBytes = KEPT_GENERATIONS * GENERATION_BYTES;
+        rotator.start(path, config);
+        for (int i = 0; i < ROTATIONS; ++i) {
+            writeFile(path, QByteArray(GENERATION_BYTES, static_cast<char>('a' + i)));
+            REQUIRE(rotator.rotate(BASE_MS + i));
+        }
+        rotator.waitIdle();
+        REQUIRE(devdash::LogRotator::generationFiles(path).size() == KEPT_GENERATIONS);
+
+        // Restarting re-checks the budget, now with a current file
+        writeFile(path, QByteArray(1, 'x'));
+        rotator.start(path, config);
+        rotator.waitIdle();
+
+        const QStringList generations = devdash::LogRotator::generationFiles(path);
+        REQUIRE(generations.size() == KEPT_GENERATIONS - 1);
+        REQUIRE(readFile(generations.back()) ==
+                QByteArray(GENERATION_BYTES, static_cast<char>('a' + ROTATIONS - 1)));
+        REQUIRE(rotator.stats().diskBytes <= config.maxTotalBytes);
+    }
+}
+
+TEST_CASE("LogRotator tidies up after an interrupted run", "[core][logging]") {
+    QTemporaryDir dir;
+    const QString path = dir.filePath("devdash.log");
+    const QString uncompressed = path + ".20250101-120000.000";
+    const QString partial = path + ".20250101-110000.000.gz.tmp";
+    writeFile(uncompressed, "left over\n");
+    writeFile(partial, "partial");
+    writeFile(dir.filePath("devdash.log.old"), "not a generation");
+
+    devdash::LogRotator rotator;
+    rotator.start(path, devdash::LogRotator::Config{});
+    rotator.waitIdle();
+
+    REQUIRE_FALSE(QFile::exists(partial));
+    REQUIRE(devdash::LogRotator::generationFiles(path) == QStringList{uncompressed + ".gz"});
+    REQUIRE(isGzipOf(readFile(uncompressed + ".gz"), "left over\n"));
+    REQUIRE(QFile::exists(dir.filePath("devdash.log.old")));
+}
@@ -0,0 +1,87 @@
+/**
+ * @file test_spsc_ring.cpp
+ * @brief Unit tests for the single-producer single-consumer ring.
+ *
+ * Tests cover:
+ * - Capacity rounding, full and empty ring
+ * - Wrap-around in bulk pops
+ * - Order and completeness across two threads
+ */
+
+#include "core/threading/SpscRing.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <array>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+namespace {
+
+//=============================================================================
+// Test Constants
+//=============================================================================
+
+constexpr size_t SMALL_CAPACITY = 4;
+constexpr uint64_t THREADED_ITEMS = 200000;
+
+} // anonymous namespace
+
+TEST_CASE("SpscRing holds up to its capacity", "[core][threading]") {
+    devdash::SpscRing<int> ring(3);
+    REQUIRE(ring.capacity() == SMALL_CAPACITY);
+
+    for (int i = 0; i < static_cast<int>(SMALL_CAPACITY); ++i) {
+        REQUIRE(ring.tryPush(i));
+    }
+    REQUIRE_FALSE(ring.tryPush(99));
+    REQUIRE(ring.size() == SMALL_CAPACITY);
+
+    std::array<int, 8> out{};
+    REQUIRE(ring.popBulk(out.data(), 2) == 2);
+    REQUIRE(out[0] == 0);
+    REQUIRE(out[1] == 1);
+
+    SECTION("freed slots are reused across the wrap") {
+        REQUIRE(ring.tryPush(4));
+        REQUIRE(ring.tryPush(5));
+        REQUIRE(ring.popBulk(out.data(), out.size()) == SMALL_CAPACITY);
+        REQUIRE(out[0] == 2);
+        REQUIRE(out[3] == 5);
+    }
+
+    SECTION("empty ring pops nothing") {
+        REQUIRE(ring.popBulk(out.data(), out.size()) == 2);
+        REQUIRE(ring.popBulk(out.data(), out.size()) == 0);
+        REQUIRE(ring.size() == 0);
+    }
+}
+
+TEST_CASE("SpscRing passes items between threads in order", "[core][threading]") {
+    devdash::SpscRing<uint64_t> ring(64);
+
+    std::thread producer([&ring]() {
+        for (uint64_t i = 0; i < THREADED_ITEMS; ++i) {
+            while (!ring.tryPush(i)) {
+                std::this_thread::yield();
+            }
+        }
+    });
+
+    std::vector<uint64_t> received;
+    received.reserve(THREADED_ITEMS);
+    std::array<uint64_t, 16> batch{};
+    while (received.size() < THREADED_ITEMS) {
+        const size_t count = ring.popBulk(batch.data(), batch.size());
+        received.insert(received.end(), batch.begin(),
+                        batch.begin() + static_cast<std::ptrdiff_t>(count));
+    }
+    producer.join();
+
+    bool inOrder = true;
+    for (uint64_t i = 0; i < THREADED_ITEMS; ++i) {
+        inOrder = inOrder && received[i] == i;
+    }
+    REQUIRE(inOrder);
+}
@@ -0,0 +1,133 @@
+/**
+ * @file test_thread_scheduling.cpp
+ * @brief Unit tests for I/O thread scheduling configuration.
+ *
+ * Tests cover:
+ * - Profile "ioThread" parsing and clamping
+ * - CPU list parsing for the command line
+ * - Applying affinity and SCHED_FIFO on a scratch thread
+ * - Unavailable settings reported instead of failing
+ */
+
+#include "core/threading/ThreadScheduling.h"
+
+#include <QJsonArray>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <sched.h>
+
+#include <thread>
+
+namespace {
+
+//=============================================================================
+// Test Constants
+//=============================================================================
+
+constexpr int TEST_FIFO_PRIORITY = 10;
+constexpr int NONEXISTENT_CPU = 4095;
+
+/**
+ * @brief Apply a configuration on a throwaway thread
+ *
+ * Keeps the test runner's own thread at normal scheduling and affinity.
+ */
+devdash::ThreadScheduling::Result applyOnScratchThread(
+    const devdash::ThreadScheduling::Config& config) {
+    devdash::ThreadScheduling::Result result;
+    std::thread worker(
+        [&result, &config]() { result = devdash::ThreadScheduling::applyToCurrentThread(config); });
+    worker.join();
+    return result;
+}
+
+} // anonymous namespace
+
+TEST_CASE("ThreadScheduling reads the profile ioThread object", "[core][threading]") {
+    SECTION("all keys") {
+        const QJsonObject object{
+            {"priority", 50}, {"cpus", QJsonArray{2, 3}}, {"lockMemory", true}};
+        const auto config = devdash::ThreadScheduling::fromJson(object);
+
+        REQUIRE(config.fifoPriority == 50);
+        REQUIRE(config.cpus == QList<int>{2, 3});
+        REQUIRE(config.lockMemory);
+    }
+
+    SECTION("empty object keeps normal scheduling") {
+        const auto config = devdash::ThreadScheduling::fromJson({});
+
+        REQUIRE(config.fifoPriority == 0);
+        REQUIRE(config.cpus.isEmpty());
+        REQUIRE_FALSE(config.lockMemory);
+    }
+
+    SECTION("out-of-range values are clamped or dropped") {
+        const QJsonObject object{{"priority", 500}, {"cpus", QJsonArray{-1, 1}}};
+        const auto config = devdash::ThreadScheduling::fromJson(object);
+
+        REQUIRE(config.fifoPriority == devdash::ThreadScheduling::MAX_FIFO_PRIORITY);
+        REQUIRE(config.cpus == QList<int>{1});
+    }
+}
+
+TEST_CASE("ThreadScheduling parses CPU lists", "[core][threading]") {
+    REQUIRE(devdash::ThreadScheduling::parseCpuList("3") == QList<int>{3});
+    REQUIRE(devdash::ThreadScheduling::parseCpuList("0-1,4") == QList<int>{0, 1, 4});
+    REQUIRE(devdash::ThreadScheduling::parseCpuList("2, 2-3") == QList<int>{2, 3});
+
+    SECTION("invalid lists are rejected") {
+        REQUIRE(devdash::ThreadScheduling::parseCpuList("").isEmpty());
+        REQUIRE(devdash::ThreadScheduling::parseCpuList("a").isEmpty());
+        REQUIRE(devdash::ThreadScheduling::parseCpuList("3-1").isEmpty());
+        REQUIRE(devdash::ThreadScheduling::parseCpuList("1-2-3").isEmpty());
+    }
+}
+
+TEST_CASE("ThreadScheduling applies what the process may change", "[core][threading]") {
+    SECTION("empty config changes nothing") {
+        const auto result = applyOnScratchThread({});
+
+        REQUIRE_FALSE(result.fifoApplied);
+        REQUIRE(result.cpus.isEmpty());
+        REQUIRE_FALSE(result.memoryLocked);
+        REQUIRE(result.problems.isEmpty());
+    }
+
+    SECTION("pins to a CPU the process runs on") {
+        const int cpu = sched_getcpu();
+        REQUIRE(cpu >= 0);
+
+        devdash::ThreadScheduling::Config config;
+        config.cpus = {cpu};
+        const auto result = applyOnScratchThread(config);
+
+        REQUIRE(result.problems.isEmpty());
+        REQUIRE(result.cpus == QList<int>{cpu});
+        REQUIRE(result.summary().contains(QString::number(cpu)));
+    }
+
+    SECTION("unknown CPUs are reported") {
+        devdash::ThreadScheduling::Config config;
+        config.cpus = {NONEXISTENT_CPU};
+        const auto result = applyOnScratchThread(config);
+
+        REQUIRE(result.cpus.isEmpty());
+        REQUIRE(result.problems.size() == 1);
+    }
+
+    SECTION("SCHED_FIFO is applied or reported") {
+        devdash::ThreadScheduling::Config config;
+        config.fifoPriority = TEST_FIFO_PRIORITY;
+        const auto result = applyOnScratchThread(config);
+
+        if (result.fifoApplied) {
+            REQUIRE(result.fifoPriority == TEST_FIFO_PRIORITY);
+            REQUIRE(result.problems.isEmpty());
+        } else {
+            REQUIRE(result.problems.size() == 1);
+        }
+        REQUIRE(result.toJson()["fifo"].toBool() == result.fifoApplied);
+    }
+}
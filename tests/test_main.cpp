@@ -9,11 +9,16 @@
  * - Access Qt resources or plugins
  * - Load QML components (requires QGuiApplication for font/rendering)
  *
+ * Compiled protocol caches (ProtocolCache) go to a temporary directory
+ * removed after the run, so tests neither write to the user's cache nor
+ * skip the JSON parsing path because of an earlier run.
+ *
  * @note Uses QGuiApplication instead of QCoreApplication to support
  *       QML component loading tests that need GUI subsystems.
  */
 
 #include <QGuiApplication>
+#include <QTemporaryDir>
 
 #include <catch2/catch_session.hpp>
 
@@ -22,12 +27,21 @@ namespace {
 /// Test application name for Qt identification
 constexpr const char* TEST_APP_NAME = "devdash_tests";
 
+/// Read by ProtocolCache::defaultDirectory()
+constexpr const char* PROTOCOL_CACHE_DIR_ENV = "DEVDASH_PROTOCOL_CACHE_DIR";
+
 } // anonymous namespace
 
 int main(int argc, char* argv[]) {
     // Set platform to offscreen to avoid needing a display
     qputenv("QT_QPA_PLATFORM", "offscreen");
 
+    // Keep protocol caches of this run out of ~/.cache
+    const QTemporaryDir protocolCacheDir;
+    if (protocolCacheDir.isValid()) {
+        qputenv(PROTOCOL_CACHE_DIR_ENV, protocolCacheDir.path().toLocal8Bit());
+    }
+
     // Initialize Qt GUI application before any tests run
     // Required for QML tests that need font database, rendering, etc.
     QGuiApplication app(argc, argv);